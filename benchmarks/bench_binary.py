@@ -0,0 +1,27 @@
+from ulab import numpy as np
+import harness
+
+harness.header()
+
+for dtype, tag in ((np.uint8, 'uint8'), (np.int16, 'int16'), (np.float, 'float')):
+    for n in (64, 1024):
+        a = np.array(range(n), dtype=dtype)
+        b = np.ones(n, dtype=dtype)
+        harness.bench('binary.add.%s.%d' % (tag, n), lambda: a + b, n)
+        harness.bench('binary.multiply.%s.%d' % (tag, n), lambda: a * b, n)
+        harness.bench('binary.scalar.%s.%d' % (tag, n), lambda: a * 3, n)
+        harness.bench('binary.strided.%s.%d' % (tag, n), lambda: a[::2] + b[::2], n // 2)
+        harness.bench('binary.less.%s.%d' % (tag, n), lambda: a < b, n)
+
+n = 32
+a = np.ones((n, n))
+b = np.ones(n)
+harness.bench('binary.broadcast.float.%dx%d' % (n, n), lambda: a + b, n * n)
+
+try:
+    c = np.ones(1024, dtype=np.complex)
+    d = np.ones(1024, dtype=np.complex)
+    harness.bench('binary.multiply.complex.1024', lambda: c * d, 1024)
+except (AttributeError, TypeError):
+    # the firmware was compiled without complex support
+    pass
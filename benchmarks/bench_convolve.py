@@ -0,0 +1,17 @@
+from ulab import numpy as np
+import harness
+
+harness.header()
+
+# the last two cases are above ULAB_NUMPY_CONVOLVE_FFT_THRESHOLD, and take the FFT path
+for n, m in ((256, 16), (1024, 16), (1024, 64), (4096, 64), (4096, 255)):
+    try:
+        a = np.array(harness.data(n))
+        k = np.array(harness.data(m, seed=2))
+    except MemoryError:
+        continue
+    harness.bench('convolve.float.%dx%d' % (n, m), lambda: np.convolve(a, k), n + m - 1)
+    ai = np.array(range(n), dtype=np.int16)
+    ki = np.ones(m, dtype=np.int16)
+    harness.bench('convolve.int16.%dx%d' % (n, m), lambda: np.convolve(ai, ki), n + m - 1)
+    a = k = ai = ki = None
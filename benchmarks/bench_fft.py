@@ -0,0 +1,21 @@
+from ulab import numpy as np
+import harness
+
+harness.header()
+
+for n in (64, 256, 1024, 4096, 1000):
+    try:
+        x = np.array(harness.data(n))
+    except MemoryError:
+        continue
+    harness.bench('fft.fft.%d' % n, lambda: np.fft.fft(x), n)
+    harness.bench('fft.ifft.%d' % n, lambda: np.fft.ifft(x), n)
+    if (n & (n - 1)) == 0:
+        plan = np.fft.plan(n)
+        harness.bench('fft.fft.plan.%d' % n, lambda: np.fft.fft(x, plan=plan), n)
+        harness.bench('fft.rfft.%d' % n, lambda: np.fft.rfft(x), n)
+        if hasattr(np.fft, 'fft_inplace'):
+            re = x.copy()
+            im = np.zeros(n)
+            harness.bench('fft.fft_inplace.%d' % n, lambda: np.fft.fft_inplace(re, im, plan=plan), n)
+    x = None
@@ -0,0 +1,21 @@
+import os
+from ulab import numpy as np
+import harness
+
+harness.header()
+
+FILENAME = 'bench.npy'
+
+for n in (256, 4096):
+    try:
+        a = np.array(harness.data(n))
+    except MemoryError:
+        continue
+    harness.bench('io.save.float.%d' % n, lambda: np.save(FILENAME, a), n)
+    harness.bench('io.load.float.%d' % n, lambda: np.load(FILENAME), n)
+    a = None
+
+try:
+    os.remove(FILENAME)
+except OSError:
+    pass
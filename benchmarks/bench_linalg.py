@@ -0,0 +1,13 @@
+from ulab import numpy as np
+import harness
+
+harness.header()
+
+for n in (4, 8, 16, 32):
+    # a diagonally dominant matrix is safely invertible
+    a = np.array(harness.data(n * n)).reshape((n, n)) + n * np.eye(n)
+    b = np.array(harness.data(n * n, seed=2)).reshape((n, n))
+    v = np.array(harness.data(n, seed=3))
+    harness.bench('dot.matrix.%d' % n, lambda: np.dot(a, b), n * n)
+    harness.bench('dot.vector.%d' % n, lambda: np.dot(a, v), n * n)
+    harness.bench('inv.%d' % n, lambda: np.linalg.inv(a), n * n)
@@ -0,0 +1,17 @@
+from ulab import numpy as np
+import harness
+
+harness.header()
+
+for n in (64, 1024, 4096):
+    try:
+        a = np.array(harness.data(n))
+        b = np.array(harness.data(n), dtype=np.float) * 30000
+        b = np.array(b, dtype=np.int16)
+    except MemoryError:
+        continue
+    harness.bench('sort.float.%d' % n, lambda: np.sort(a), n)
+    harness.bench('sort.int16.%d' % n, lambda: np.sort(b), n)
+    harness.bench('argsort.float.%d' % n, lambda: np.argsort(a), n)
+    harness.bench('median.float.%d' % n, lambda: np.median(a), n)
+    a = b = None
@@ -0,0 +1,117 @@
+# Timing harness of the ulab benchmarks
+#
+# Each benchmark is a function of no arguments, which is called repeatedly, until at least
+# MIN_TIME_US microseconds have elapsed. The results are printed as one JSON object per line,
+# so that run-benchmarks can collect them from the unix port, and from boards alike.
+
+import gc
+import sys
+import time
+
+try:
+    import json
+except ImportError:
+    import ujson as json
+
+from ulab import __version__
+
+MIN_TIME_US = 200000
+MAX_REPEAT = 100000
+
+
+def _dwt_counter():
+    # the DWT cycle counter of Cortex-M3, M4, and M7 cores; the M0+ of the rp2 has no such unit,
+    # therefore, the registers are touched only on ports that are known to have it
+    if sys.platform not in ('pyboard', 'mimxrt'):
+        return None
+    try:
+        import machine
+    except ImportError:
+        return None
+    DEMCR = 0xE000EDFC
+    DWT_CTRL = 0xE0001000
+    DWT_CYCCNT = 0xE0001004
+    machine.mem32[DEMCR] |= 1 << 24
+    machine.mem32[DWT_CYCCNT] = 0
+    machine.mem32[DWT_CTRL] |= 1
+    return lambda: machine.mem32[DWT_CYCCNT] & 0xFFFFFFFF
+
+
+def _counter():
+    # returns the name, and the reader of the finest counter of the port
+    dwt = _dwt_counter()
+    if dwt is not None:
+        return 'dwt_cycles', dwt
+    if hasattr(time, 'ticks_cpu'):
+        # on the esp32, this is the cycle counter of the core, elsewhere, it might be microseconds
+        return 'ticks_cpu', time.ticks_cpu
+    return 'ticks_us', time.ticks_us
+
+
+COUNTER, _read_counter = _counter()
+
+
+def _diff(end, start):
+    if COUNTER == 'dwt_cycles':
+        return (end - start) & 0xFFFFFFFF
+    return time.ticks_diff(end, start)
+
+
+def header():
+    record = {
+        'platform': sys.platform,
+        'implementation': sys.implementation.name,
+        'ulab': __version__,
+        'counter': COUNTER,
+    }
+    print(json.dumps(record))
+
+
+def data(n, seed=1):
+    # deterministic pseudo-random floats in [0, 1); the random module is not available on every port
+    values = []
+    x = seed
+    for _ in range(n):
+        x = (1103515245 * x + 12345) & 0x7FFFFFFF
+        values.append(x / 2147483648)
+    return values
+
+
+def _allocated(func):
+    # the number of bytes allocated by a single call; the collector must not run in the meantime
+    gc.collect()
+    gc.disable()
+    try:
+        start = gc.mem_alloc()
+        func()
+        return gc.mem_alloc() - start
+    finally:
+        gc.enable()
+
+
+def bench(name, func, n):
+    # times func, which processes n elements in each call, and prints the results
+    record = {'name': name, 'n': n}
+    try:
+        func()
+        record['bytes'] = _allocated(func)
+
+        gc.collect()
+        repeat = 0
+        start_us = time.ticks_us()
+        start = _read_counter()
+        while True:
+            func()
+            repeat += 1
+            elapsed_us = time.ticks_diff(time.ticks_us(), start_us)
+            if (elapsed_us >= MIN_TIME_US) or (repeat >= MAX_REPEAT):
+                break
+        counts = _diff(_read_counter(), start)
+
+        record['repeat'] = repeat
+        record['ns_per_element'] = elapsed_us * 1000 / (repeat * max(1, n))
+        record['counts_per_call'] = counts / repeat
+    except MemoryError:
+        record['error'] = 'MemoryError'
+    gc.collect()
+    print(json.dumps(record))
@@ -59,6 +59,42 @@ fi
 
 bash test-common.sh "${dims}" "$PROG"
 
+# Build with the optional int32, uint32, and float16 dtypes; these change the promotion of scalars,
+# hence, only the tests of the generic kernels are run, the others are skipped in the build above.
+make -C micropython/ports/unix -j${NPROC} USER_C_MODULES="${HERE}" DEBUG=1 STRIP=: MICROPY_PY_FFI=0 MICROPY_PY_BTREE=0 CFLAGS_EXTRA=-DULAB_MAX_DIMS=$dims CFLAGS_EXTRA+=-DULAB_SUPPORTS_INT32=1 CFLAGS_EXTRA+=-DULAB_SUPPORTS_FLOAT16=1 CFLAGS_EXTRA+=-DULAB_HASH=$GIT_HASH BUILD=build-generic-$dims PROG=micropython-generic-$dims
+
+if [ -f tests/"${dims}"d/numpy/generic_dtypes.py ]; then
+  env MICROPY_MICROPYTHON="micropython/ports/unix/build-generic-$dims/micropython-generic-$dims" ./run-tests tests/"${dims}"d/numpy/generic_dtypes.py
+fi
+
+# Build with the user module, whose functions exercise the C interface of ulab_api.h.
+make -C micropython/ports/unix -j${NPROC} USER_C_MODULES="${HERE}" DEBUG=1 STRIP=: MICROPY_PY_FFI=0 MICROPY_PY_BTREE=0 CFLAGS_EXTRA=-DULAB_MAX_DIMS=$dims CFLAGS_EXTRA+=-DULAB_HAS_USER_MODULE=1 CFLAGS_EXTRA+=-DULAB_HASH=$GIT_HASH BUILD=build-user-$dims PROG=micropython-user-$dims
+
+if [ -f tests/"${dims}"d/utils/user_api.py ]; then
+  env MICROPY_MICROPYTHON="micropython/ports/unix/build-user-$dims/micropython-user-$dims" ./run-tests tests/"${dims}"d/utils/user_api.py
+fi
+
+# Build without the int8 and int16 dtypes, and check the fallbacks of the promotion, of arange, and of argmin/argmax.
+make -C micropython/ports/unix -j${NPROC} USER_C_MODULES="${HERE}" DEBUG=1 STRIP=: MICROPY_PY_FFI=0 MICROPY_PY_BTREE=0 CFLAGS_EXTRA=-DULAB_MAX_DIMS=$dims CFLAGS_EXTRA+=-DULAB_SUPPORTS_INT8=0 CFLAGS_EXTRA+=-DULAB_SUPPORTS_INT16=0 CFLAGS_EXTRA+=-DULAB_HASH=$GIT_HASH BUILD=build-noint-$dims PROG=micropython-noint-$dims
+
+if [ -f tests/"${dims}"d/numpy/no_int8_int16.py ]; then
+  env MICROPY_MICROPYTHON="micropython/ports/unix/build-noint-$dims/micropython-noint-$dims" ./run-tests tests/"${dims}"d/numpy/no_int8_int16.py
+fi
+
+# Build with the statistics of ulab.stats.
+make -C micropython/ports/unix -j${NPROC} USER_C_MODULES="${HERE}" DEBUG=1 STRIP=: MICROPY_PY_FFI=0 MICROPY_PY_BTREE=0 CFLAGS_EXTRA=-DULAB_MAX_DIMS=$dims CFLAGS_EXTRA+=-DULAB_HAS_PROFILING=1 CFLAGS_EXTRA+=-DULAB_HASH=$GIT_HASH BUILD=build-profiling-$dims PROG=micropython-profiling-$dims
+
+if [ -f tests/"${dims}"d/utils/profiling.py ]; then
+  env MICROPY_MICROPYTHON="micropython/ports/unix/build-profiling-$dims/micropython-profiling-$dims" ./run-tests tests/"${dims}"d/utils/profiling.py
+fi
+
+# Build with the polynomial approximations of exp, log, sin, and cos, which require single-precision floats.
+make -C micropython/ports/unix -j${NPROC} USER_C_MODULES="${HERE}" DEBUG=1 STRIP=: MICROPY_PY_FFI=0 MICROPY_PY_BTREE=0 CFLAGS_EXTRA=-DMICROPY_FLOAT_IMPL=MICROPY_FLOAT_IMPL_FLOAT CFLAGS_EXTRA+=-DULAB_MAX_DIMS=$dims CFLAGS_EXTRA+=-DULAB_VECTOR_FAST_MATH=1 CFLAGS_EXTRA+=-DULAB_HASH=$GIT_HASH BUILD=build-fastmath-$dims PROG=micropython-fastmath-$dims
+
+if [ -f tests/"${dims}"d/numpy/fast_math.py ]; then
+  env MICROPY_MICROPYTHON="micropython/ports/unix/build-fastmath-$dims/micropython-fastmath-$dims" ./run-tests tests/"${dims}"d/numpy/fast_math.py
+fi
+
 # Build with single-precision float.
 make -C micropython/ports/unix -j${NPROC} USER_C_MODULES="${HERE}" DEBUG=1 STRIP=: MICROPY_PY_FFI=0 MICROPY_PY_BTREE=0 CFLAGS_EXTRA=-DMICROPY_FLOAT_IMPL=MICROPY_FLOAT_IMPL_FLOAT CFLAGS_EXTRA+=-DULAB_MAX_DIMS=$dims CFLAGS_EXTRA+=-DULAB_HASH=$GIT_HASH BUILD=build-nanbox-$dims PROG=micropython-nanbox-$dims
 
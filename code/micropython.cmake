@@ -14,5 +14,27 @@ target_compile_definitions(usermod_ulab INTERFACE
     MODULE_ULAB_ENABLED=1
 )
 
+# The hot kernels can be routed to a vendor DSP library with -DULAB_DSP_BACKEND=cmsis, or
+# -DULAB_DSP_BACKEND=espdsp. For CMSIS-DSP, CMSIS_DSP_DIR must point to its root, and
+# CMSIS_DSP_LIB to the pre-built library, while esp-dsp must be a component of the
+# ESP-IDF project, e.g., after `idf.py add-dependency espressif/esp-dsp`.
+if(ULAB_DSP_BACKEND STREQUAL "cmsis")
+    target_compile_definitions(usermod_ulab INTERFACE
+        ULAB_DSP_BACKEND=ULAB_DSP_BACKEND_CMSIS
+    )
+    target_include_directories(usermod_ulab INTERFACE
+        ${CMSIS_DSP_DIR}/Include
+        ${CMSIS_DSP_DIR}/PrivateInclude
+    )
+    if(CMSIS_DSP_LIB)
+        target_link_libraries(usermod_ulab INTERFACE ${CMSIS_DSP_LIB})
+    endif()
+elseif(ULAB_DSP_BACKEND STREQUAL "espdsp")
+    target_compile_definitions(usermod_ulab INTERFACE
+        ULAB_DSP_BACKEND=ULAB_DSP_BACKEND_ESPDSP
+    )
+    target_link_libraries(usermod_ulab INTERFACE idf::espressif__esp-dsp)
+endif()
+
 target_link_libraries(usermod INTERFACE usermod_ulab)
 
@@ -2,12 +2,20 @@
 USERMODULES_DIR := $(USERMOD_DIR)
 
 # Add all C files to SRC_USERMOD.
+SRC_USERMOD += $(USERMODULES_DIR)/scipy/integrate/integrate.c
 SRC_USERMOD += $(USERMODULES_DIR)/scipy/linalg/linalg.c
 SRC_USERMOD += $(USERMODULES_DIR)/scipy/optimize/optimize.c
 SRC_USERMOD += $(USERMODULES_DIR)/scipy/signal/signal.c
 SRC_USERMOD += $(USERMODULES_DIR)/scipy/special/special.c
 SRC_USERMOD += $(USERMODULES_DIR)/ndarray_operators.c
 SRC_USERMOD += $(USERMODULES_DIR)/ulab_tools.c
+SRC_USERMOD += $(USERMODULES_DIR)/ulab_dsp.c
+SRC_USERMOD += $(USERMODULES_DIR)/ulab_simd.c
+SRC_USERMOD += $(USERMODULES_DIR)/ulab_memory.c
+SRC_USERMOD += $(USERMODULES_DIR)/ulab_profile.c
+SRC_USERMOD += $(USERMODULES_DIR)/ulab_parallel.c
+SRC_USERMOD += $(USERMODULES_DIR)/ulab_job.c
+SRC_USERMOD += $(USERMODULES_DIR)/ulab_api.c
 SRC_USERMOD += $(USERMODULES_DIR)/ndarray.c
 SRC_USERMOD += $(USERMODULES_DIR)/numpy/ndarray/ndarray_iter.c
 SRC_USERMOD += $(USERMODULES_DIR)/ndarray_properties.c
@@ -21,10 +29,12 @@ SRC_USERMOD += $(USERMODULES_DIR)/numpy/fft/fft.c
 SRC_USERMOD += $(USERMODULES_DIR)/numpy/fft/fft_tools.c
 SRC_USERMOD += $(USERMODULES_DIR)/numpy/filter.c
 SRC_USERMOD += $(USERMODULES_DIR)/numpy/io/io.c
+SRC_USERMOD += $(USERMODULES_DIR)/numpy/lazy.c
 SRC_USERMOD += $(USERMODULES_DIR)/numpy/linalg/linalg.c
 SRC_USERMOD += $(USERMODULES_DIR)/numpy/linalg/linalg_tools.c
 SRC_USERMOD += $(USERMODULES_DIR)/numpy/numerical.c
 SRC_USERMOD += $(USERMODULES_DIR)/numpy/poly.c
+SRC_USERMOD += $(USERMODULES_DIR)/numpy/sort/sort_tools.c
 SRC_USERMOD += $(USERMODULES_DIR)/numpy/stats.c
 SRC_USERMOD += $(USERMODULES_DIR)/numpy/transform.c
 SRC_USERMOD += $(USERMODULES_DIR)/numpy/vector.c
@@ -37,4 +47,14 @@ SRC_USERMOD += $(USERMODULES_DIR)/ulab.c
 
 CFLAGS_USERMOD += -I$(USERMODULES_DIR)
 
+# The hot kernels can be routed to CMSIS-DSP by passing ULAB_DSP_BACKEND=cmsis to make.
+# CMSIS_DSP_DIR must point to the root of CMSIS-DSP, and CMSIS_DSP_LIB to the pre-built
+# library (e.g., libCMSISDSP.a), unless the port compiles the sources of CMSIS-DSP itself.
+ifeq ($(ULAB_DSP_BACKEND),cmsis)
+CFLAGS_USERMOD += -DULAB_DSP_BACKEND=ULAB_DSP_BACKEND_CMSIS -I$(CMSIS_DSP_DIR)/Include -I$(CMSIS_DSP_DIR)/PrivateInclude
+ifneq ($(CMSIS_DSP_LIB),)
+LDFLAGS_USERMOD += $(CMSIS_DSP_LIB)
+endif
+endif
+
 override CFLAGS_EXTRA += -DMODULE_ULAB_ENABLED=1
@@ -13,6 +13,7 @@
 
 #include <unistd.h>
 #include <math.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -21,12 +22,16 @@
 #include "py/obj.h"
 #include "py/objtuple.h"
 #include "py/objint.h"
+#include "py/builtin.h"
+#include "py/stream.h"
 
 #include "ulab_tools.h"
+#include "ulab_profile.h"
 #include "ndarray.h"
 #include "ndarray_operators.h"
 #include "numpy/carray/carray.h"
 #include "numpy/carray/carray_tools.h"
+#include "numpy/lazy.h"
 
 mp_uint_t ndarray_print_threshold = NDARRAY_PRINT_THRESHOLD;
 mp_uint_t ndarray_print_edgeitems = NDARRAY_PRINT_EDGEITEMS;
@@ -152,12 +157,18 @@ void ndarray_dtype_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kin
         mp_print_str(print, "bool')");
     } else if(self->dtype == NDARRAY_UINT8) {
         mp_print_str(print, "uint8')");
-    } else if(self->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(self->dtype, INT8)) {
         mp_print_str(print, "int8')");
     } else if(self->dtype == NDARRAY_UINT16) {
         mp_print_str(print, "uint16')");
-    } else if(self->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(self->dtype, INT16)) {
         mp_print_str(print, "int16')");
+    } else if(ULAB_DTYPE_IS(self->dtype, INT32)) {
+        mp_print_str(print, "int32')");
+    } else if(ULAB_DTYPE_IS(self->dtype, UINT32)) {
+        mp_print_str(print, "uint32')");
+    } else if(ULAB_DTYPE_IS(self->dtype, FLOAT16)) {
+        mp_print_str(print, "float16')");
     }
     #if ULAB_SUPPORTS_COMPLEX
     else if(self->dtype == NDARRAY_COMPLEX) {
@@ -198,7 +209,9 @@ mp_obj_t ndarray_dtype_make_new(const mp_obj_type_t *type, size_t n_args, size_t
             _dtype = mp_obj_get_int(_args[0].u_obj);
             if((_dtype != NDARRAY_BOOL) && (_dtype != NDARRAY_UINT8)
                 && (_dtype != NDARRAY_INT8) && (_dtype != NDARRAY_UINT16)
-                && (_dtype != NDARRAY_INT16) && (_dtype != NDARRAY_FLOAT)) {
+                && (_dtype != NDARRAY_INT16) && (_dtype != NDARRAY_FLOAT)
+                && (_dtype != NDARRAY_INT32) && (_dtype != NDARRAY_UINT32)
+                && (_dtype != NDARRAY_FLOAT16)) {
                 mp_raise_TypeError(MP_ERROR_TEXT("data type not understood"));
             }
         } else {
@@ -211,6 +224,12 @@ mp_obj_t ndarray_dtype_make_new(const mp_obj_type_t *type, size_t n_args, size_t
                 _dtype = NDARRAY_UINT16;
             } else if(memcmp(_dtype_, "int16", 5) == 0) {
                 _dtype = NDARRAY_INT16;
+            } else if(memcmp(_dtype_, "uint32", 6) == 0) {
+                _dtype = NDARRAY_UINT32;
+            } else if(memcmp(_dtype_, "int32", 5) == 0) {
+                _dtype = NDARRAY_INT32;
+            } else if(memcmp(_dtype_, "float16", 7) == 0) {
+                _dtype = NDARRAY_FLOAT16;
             } else if(memcmp(_dtype_, "float", 5) == 0) {
                 _dtype = NDARRAY_FLOAT;
             }
@@ -223,6 +242,9 @@ mp_obj_t ndarray_dtype_make_new(const mp_obj_type_t *type, size_t n_args, size_t
                 mp_raise_TypeError(MP_ERROR_TEXT("data type not understood"));
             }
         }
+        if(!ULAB_DTYPE_IS_SUPPORTED(_dtype)) {
+            mp_raise_TypeError(MP_ERROR_TEXT("data type not understood"));
+        }
         dtype->dtype = _dtype;
     }
     return MP_OBJ_FROM_PTR(dtype);
@@ -248,6 +270,8 @@ mp_obj_t ndarray_dtype(mp_obj_t self_in) {
         if((len != 1) || ((*_dtype != NDARRAY_BOOL) && (*_dtype != NDARRAY_UINT8)
             && (*_dtype != NDARRAY_INT8) && (*_dtype != NDARRAY_UINT16)
             && (*_dtype != NDARRAY_INT16) && (*_dtype != NDARRAY_FLOAT)
+            && !ULAB_DTYPE_IS(*_dtype, INT32) && !ULAB_DTYPE_IS(*_dtype, UINT32)
+            && !ULAB_DTYPE_IS(*_dtype, FLOAT16)
             #if ULAB_SUPPORTS_COMPLEX
                 && (*_dtype != NDARRAY_COMPLEX)
             #endif
@@ -291,6 +315,25 @@ mp_obj_t ndarray_get_printoptions(void) {
 MP_DEFINE_CONST_FUN_OBJ_0(ndarray_get_printoptions_obj, ndarray_get_printoptions);
 #endif
 
+#if ULAB_SUPPORTS_FLOAT16
+mp_obj_t ndarray_get_value(char dtype, void *array, size_t index) {
+    // returns the item at index as a micropython object
+    if(dtype == NDARRAY_FLOAT16) {
+        return mp_obj_new_float(ulab_float16_to_float(((uint16_t *)array)[index]));
+    }
+    return mp_binary_get_val_array(dtype, array, index);
+}
+
+void ndarray_set_value(char dtype, void *array, size_t index, mp_obj_t value) {
+    // writes a micropython object into the array at index
+    if(dtype == NDARRAY_FLOAT16) {
+        ((uint16_t *)array)[index] = ulab_float_to_float16(mp_obj_get_float(value));
+    } else {
+        mp_binary_set_val_array(dtype, array, index, value);
+    }
+}
+#endif
+
 mp_obj_t ndarray_get_item(ndarray_obj_t *ndarray, void *array) {
     // returns a proper micropython object from an array
     if(!ndarray->boolean) {
@@ -302,7 +345,7 @@ mp_obj_t ndarray_get_item(ndarray_obj_t *ndarray, void *array) {
             return mp_obj_new_complex(real, imag);
         }
         #endif
-        return mp_binary_get_val_array(ndarray->dtype, array, 0);
+        return ndarray_get_value(ndarray->dtype, array, 0);
     } else {
         if(*(uint8_t *)array) {
             return mp_const_true;
@@ -438,12 +481,18 @@ void ndarray_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t ki
         mp_print_str(print, "bool)");
     } else if(self->dtype == NDARRAY_UINT8) {
         mp_print_str(print, "uint8)");
-    } else if(self->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(self->dtype, INT8)) {
         mp_print_str(print, "int8)");
     } else if(self->dtype == NDARRAY_UINT16) {
         mp_print_str(print, "uint16)");
-    } else if(self->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(self->dtype, INT16)) {
         mp_print_str(print, "int16)");
+    } else if(ULAB_DTYPE_IS(self->dtype, INT32)) {
+        mp_print_str(print, "int32)");
+    } else if(ULAB_DTYPE_IS(self->dtype, UINT32)) {
+        mp_print_str(print, "uint32)");
+    } else if(ULAB_DTYPE_IS(self->dtype, FLOAT16)) {
+        mp_print_str(print, "float16)");
     }
     #if ULAB_SUPPORTS_COMPLEX
     else if(self->dtype == NDARRAY_COMPLEX) {
@@ -501,6 +550,19 @@ bool ndarray_is_dense(ndarray_obj_t *ndarray) {
     return stride == ndarray->strides[ULAB_MAX_DIMS-ndarray->ndim] ? true : false;
 }
 
+bool ndarray_is_contiguous(ndarray_obj_t *ndarray) {
+    // returns true, if the items are laid out in C order without gaps; as opposed to
+    // ndarray_is_dense, this checks all strides, so that, e.g., a[:, ::-1] is rejected
+    int32_t stride = ndarray->itemsize;
+    for(uint8_t i = ULAB_MAX_DIMS; i > ULAB_MAX_DIMS - ndarray->ndim; i--) {
+        if((ndarray->shape[i - 1] > 1) && (ndarray->strides[i - 1] != stride)) {
+            return false;
+        }
+        stride *= ndarray->shape[i - 1];
+    }
+    return true;
+}
+
 static size_t multiply_size(size_t a, size_t b) {
     size_t result;
     if (__builtin_mul_overflow(a, b, &result)) {
@@ -509,8 +571,12 @@ static size_t multiply_size(size_t a, size_t b) {
     return result;
 }
 
-ndarray_obj_t *ndarray_new_ndarray(uint8_t ndim, size_t *shape, int32_t *strides, uint8_t dtype) {
+ndarray_obj_t *ndarray_new_ndarray_with_memory(uint8_t ndim, size_t *shape, int32_t *strides, uint8_t dtype, uint8_t memory) {
     // Creates the base ndarray with shape, and initialises the values to straight 0s
+    // The payload is placed according to the memory policy, while the header is always on the heap
+    if(!ULAB_DTYPE_IS_SUPPORTED(dtype)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("data type not understood"));
+    }
     ndarray_obj_t *ndarray = m_new_obj(ndarray_obj_t);
     ndarray->base.type = &ulab_ndarray_type;
     ndarray->dtype = dtype == NDARRAY_BOOL ? NDARRAY_UINT8 : dtype;
@@ -536,14 +602,17 @@ ndarray_obj_t *ndarray_new_ndarray(uint8_t ndim, size_t *shape, int32_t *strides
 
     // if the length is 0, still allocate a single item, so that contractions can be handled
     size_t len = multiply_size(ndarray->itemsize, MAX(1, ndarray->len));
-    uint8_t *array = m_new0(byte, len);
     // this should set all elements to 0, irrespective of the of the dtype (all bits are zero)
     // we could, perhaps, leave this step out, and initialise the array only, when needed
-    ndarray->array = array;
-    ndarray->origin = array;
+    ndarray->array = ulab_memory_calloc(len, memory, &ndarray->origin);
+    ULAB_PROFILE_ALLOC(sizeof(ndarray_obj_t) + len);
     return ndarray;
 }
 
+ndarray_obj_t *ndarray_new_ndarray(uint8_t ndim, size_t *shape, int32_t *strides, uint8_t dtype) {
+    return ndarray_new_ndarray_with_memory(ndim, shape, strides, dtype, ULAB_MEMORY_AUTO);
+}
+
 ndarray_obj_t *ndarray_new_dense_ndarray(uint8_t ndim, size_t *shape, uint8_t dtype) {
     // creates a dense array, i.e., one, where the strides are derived directly from the shapes
     // the function should work in the general n-dimensional case
@@ -621,27 +690,89 @@ void ndarray_copy_array(ndarray_obj_t *source, ndarray_obj_t *target, uint8_t sh
     #endif
 }
 
-ndarray_obj_t *ndarray_new_view(ndarray_obj_t *source, uint8_t ndim, size_t *shape, int32_t *strides, int32_t offset) {
-    // creates a new view from the input arguments
-    ndarray_obj_t *ndarray = m_new_obj(ndarray_obj_t);
+static void ndarray_fill_view(ndarray_obj_t *ndarray, ndarray_obj_t *source, uint8_t ndim, size_t *shape, int32_t *strides, int32_t offset) {
+    // initialises the header of a view, which can also reside on the stack, if it is not returned
     ndarray->base.type = &ulab_ndarray_type;
     ndarray->boolean = source->boolean;
     ndarray->dtype = source->dtype;
     ndarray->ndim = ndim;
     ndarray->itemsize = source->itemsize;
     ndarray->len = ndim == 0 ? 0 : 1;
-    for(uint8_t i=ULAB_MAX_DIMS; i > ULAB_MAX_DIMS-ndim; i--) {
-        ndarray->shape[i-1] = shape[i-1];
-        ndarray->strides[i-1] = strides[i-1];
-        ndarray->len *= shape[i-1];
+    for(uint8_t i=ULAB_MAX_DIMS; i > 0; i--) {
+        if(i > ULAB_MAX_DIMS - ndim) {
+            ndarray->shape[i-1] = shape[i-1];
+            ndarray->strides[i-1] = strides[i-1];
+            ndarray->len *= shape[i-1];
+        } else {
+            // the loops over the leading axes expect zeros here
+            ndarray->shape[i-1] = 0;
+            ndarray->strides[i-1] = 0;
+        }
     }
     uint8_t *pointer = (uint8_t *)source->array;
     pointer += offset;
     ndarray->array = pointer;
     ndarray->origin = source->origin;
+}
+
+ndarray_obj_t *ndarray_new_view(ndarray_obj_t *source, uint8_t ndim, size_t *shape, int32_t *strides, int32_t offset) {
+    // creates a new view from the input arguments
+    ndarray_obj_t *ndarray = m_new_obj(ndarray_obj_t);
+    ndarray_fill_view(ndarray, source, ndim, shape, strides, offset);
     return ndarray;
 }
 
+bool ndarray_view_strides(ndarray_obj_t *source, uint8_t ndim, size_t *shape, int32_t *strides) {
+    // Attempts to find the strides, with which the data of source can be viewed with the new shape
+    // (stored right-aligned in shape) without copying. Returns false, if no such strides exist.
+    // The axes of length 1 are irrelevant; the rest of the axes of source are split into groups
+    // whose lengths multiply to the lengths of groups of the new axes, and each group of source
+    // must be contiguous in itself, while the groups can be separated by arbitrary strides.
+    if(source->len == 0) {
+        return false;
+    }
+    size_t oshape[ULAB_MAX_DIMS];
+    int32_t ostrides[ULAB_MAX_DIMS];
+    uint8_t ondim = 0;
+    for(uint8_t i = ULAB_MAX_DIMS - source->ndim; i < ULAB_MAX_DIMS; i++) {
+        if(source->shape[i] != 1) {
+            oshape[ondim] = source->shape[i];
+            ostrides[ondim] = source->strides[i];
+            ondim++;
+        }
+    }
+
+    uint8_t start = ULAB_MAX_DIMS - ndim;
+    uint8_t ni = 0, nj = 1, oi = 0, oj = 1;
+    while((ni < ndim) && (oi < ondim)) {
+        size_t nlen = shape[start + ni];
+        size_t olen = oshape[oi];
+        while(nlen != olen) {
+            if(nlen < olen) {
+                nlen *= shape[start + nj++];
+            } else {
+                olen *= oshape[oj++];
+            }
+        }
+        for(uint8_t k = oi; k < oj - 1; k++) {
+            if(ostrides[k] != (int32_t)oshape[k + 1] * ostrides[k + 1]) {
+                return false;
+            }
+        }
+        strides[start + nj - 1] = ostrides[oj - 1];
+        for(uint8_t k = nj - 1; k > ni; k--) {
+            strides[start + k - 1] = strides[start + k] * (int32_t)shape[start + k];
+        }
+        ni = nj++;
+        oi = oj++;
+    }
+    // trailing axes of length 1
+    for(; ni < ndim; ni++) {
+        strides[start + ni] = source->itemsize;
+    }
+    return true;
+}
+
 ndarray_obj_t *ndarray_copy_view(ndarray_obj_t *source) {
     // creates a one-to-one deep copy of the input ndarray or its view
     // the function should work in the general n-dimensional case
@@ -696,12 +827,12 @@ ndarray_obj_t *ndarray_copy_view_convert_type(ndarray_obj_t *source, uint8_t dty
                         }
                     } else {
                     #endif
-                        if((source->dtype == NDARRAY_FLOAT) && (dtype != NDARRAY_FLOAT)) {
+                        if(ULAB_DTYPE_IS_FLOAT(source->dtype) && !ULAB_DTYPE_IS_FLOAT(dtype)) {
                             // floats must be treated separately, because they can't directly be converted to integer types
                             mp_float_t f = ndarray_get_float_value(sarray, source->dtype);
                             item = mp_obj_new_int((int32_t)MICROPY_FLOAT_C_FUN(round)(f));
                         } else {
-                            item = mp_binary_get_val_array(source->dtype, sarray, 0);
+                            item = ndarray_get_value(source->dtype, sarray, 0);
                         }
                     #if ULAB_SUPPORTS_COMPLEX
                         if(dtype == NDARRAY_COMPLEX) {
@@ -757,7 +888,7 @@ mp_obj_t ndarray_byteswap(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
     } else {
         ndarray = ndarray_new_view(self, self->ndim, self->shape, self->strides, 0);
     }
-    if((self->dtype == NDARRAY_BOOL) || (self->dtype == NDARRAY_UINT8) || (self->dtype == NDARRAY_INT8)) {
+    if((self->dtype == NDARRAY_BOOL) || (self->dtype == NDARRAY_UINT8) || ULAB_DTYPE_IS(self->dtype, INT8)) {
         return MP_OBJ_FROM_PTR(ndarray);
     } else {
         uint8_t *array = (uint8_t *)ndarray->array;
@@ -785,6 +916,9 @@ mp_obj_t ndarray_byteswap(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
                             SWAP(uint8_t, array[2], array[5]);
                             SWAP(uint8_t, array[3], array[4]);
                             #endif
+                        } else if(ULAB_DTYPE_IS(self->dtype, INT32) || ULAB_DTYPE_IS(self->dtype, UINT32)) {
+                            SWAP(uint8_t, array[0], array[3]);
+                            SWAP(uint8_t, array[1], array[2]);
                         } else {
                             SWAP(uint8_t, array[0], array[1]);
                         }
@@ -1027,6 +1161,321 @@ bool ndarray_can_broadcast_inplace(ndarray_obj_t *lhs, ndarray_obj_t *rhs, int32
 }
 #endif
 
+#if NDARRAY_IS_SLICEABLE || ULAB_NUMPY_HAS_TAKE || ULAB_NUMPY_HAS_PUT
+// integer-array indexing: the indices are first converted to a vector of non-negative
+// positions, so that the gather/scatter loops below are free of any checks
+
+static size_t ndarray_normalise_index(mp_int_t index, size_t len, uint8_t mode) {
+    mp_int_t n = (mp_int_t)len;
+    if(n == 0) {
+        mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("cannot index an empty axis"));
+    }
+    if(mode == NDARRAY_INDEX_CLIP) {
+        return index < 0 ? 0 : (index >= n ? (size_t)(n - 1) : (size_t)index);
+    } else if(mode == NDARRAY_INDEX_WRAP) {
+        index %= n;
+        return index < 0 ? (size_t)(index + n) : (size_t)index;
+    }
+    if(index < 0) {
+        index += n;
+    }
+    if((index < 0) || (index >= n)) {
+        mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("index is out of bounds"));
+    }
+    return (size_t)index;
+}
+
+#define NDARRAY_INDEX_VECTOR_LOOP(type, nindex, indices, len, mode)\
+    type *iarray = (type *)(nindex)->array;\
+    for(size_t i = 0; i < (nindex)->len; i++) {\
+        (indices)[i] = ndarray_normalise_index((mp_int_t)iarray[i], (len), (mode));\
+    }
+
+static size_t *ndarray_index_vector(mp_obj_t index, size_t len, uint8_t mode, uint8_t *ndim, size_t *shape, size_t *count) {
+    // converts an integer, an iterable of integers, or an integer ndarray to a vector of positions
+    // along an axis of length len; the shape of the index is returned in ndim, and shape
+    // the vector is on the heap, because the conversion can raise an exception at any point
+    size_t *indices;
+    memset(shape, 0, ULAB_MAX_DIMS * sizeof(size_t));
+    if(mp_obj_is_int(index)) {
+        *ndim = 0;
+        *count = 1;
+        indices = m_new(size_t, 1);
+        indices[0] = ndarray_normalise_index(mp_obj_get_int(index), len, mode);
+    } else if(mp_obj_is_type(index, &ulab_ndarray_type)) {
+        ndarray_obj_t *nindex = MP_OBJ_TO_PTR(index);
+        if(ULAB_DTYPE_IS_FLOAT(nindex->dtype)) {
+            mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("arrays used as indices must be of integer type"));
+        }
+        #if ULAB_SUPPORTS_COMPLEX
+        if(nindex->dtype == NDARRAY_COMPLEX) {
+            mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("arrays used as indices must be of integer type"));
+        }
+        #endif
+        *ndim = nindex->ndim;
+        memcpy(shape, nindex->shape, ULAB_MAX_DIMS * sizeof(size_t));
+        *count = nindex->len;
+        if(!ndarray_is_contiguous(nindex)) {
+            nindex = ndarray_copy_view(nindex);
+        }
+        indices = m_new(size_t, nindex->len);
+        if(nindex->dtype == NDARRAY_UINT8) {
+            NDARRAY_INDEX_VECTOR_LOOP(uint8_t, nindex, indices, len, mode);
+        } else if(ULAB_DTYPE_IS(nindex->dtype, INT8)) {
+            NDARRAY_INDEX_VECTOR_LOOP(int8_t, nindex, indices, len, mode);
+        } else if(nindex->dtype == NDARRAY_UINT16) {
+            NDARRAY_INDEX_VECTOR_LOOP(uint16_t, nindex, indices, len, mode);
+        } else if(ULAB_DTYPE_IS(nindex->dtype, INT32)) {
+            NDARRAY_INDEX_VECTOR_LOOP(int32_t, nindex, indices, len, mode);
+        } else if(ULAB_DTYPE_IS(nindex->dtype, UINT32)) {
+            NDARRAY_INDEX_VECTOR_LOOP(uint32_t, nindex, indices, len, mode);
+        } else {
+            NDARRAY_INDEX_VECTOR_LOOP(int16_t, nindex, indices, len, mode);
+        }
+    } else {
+        *ndim = 1;
+        *count = (size_t)mp_obj_get_int(mp_obj_len(index));
+        shape[ULAB_MAX_DIMS - 1] = *count;
+        indices = m_new(size_t, *count);
+        mp_obj_iter_buf_t iter_buf;
+        mp_obj_t item, iterable = mp_getiter(index, &iter_buf);
+        for(size_t i = 0; i < *count; i++) {
+            item = mp_iternext(iterable);
+            if(!mp_obj_is_int(item)) {
+                mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("indices must be integers"));
+            }
+            indices[i] = ndarray_normalise_index(mp_obj_get_int(item), len, mode);
+        }
+    }
+    return indices;
+}
+
+#if NDARRAY_IS_SLICEABLE || ULAB_NUMPY_HAS_TAKE
+#define NDARRAY_GATHER_LOOP(type, rarray, rstride, array, stride, indices, count)\
+    for(size_t k = 0; k < (count); k++) {\
+        *((type *)(rarray)) = *((type *)((array) + (ptrdiff_t)(indices)[k] * (stride)));\
+        (rarray) += (rstride);\
+    }
+
+static void ndarray_gather(uint8_t *rarray, int32_t rstride, uint8_t *array, int32_t stride, size_t *indices, size_t count, uint8_t itemsize) {
+    // copies the items at array + indices[k] * stride to rarray + k * rstride; the items are
+    // moved as unsigned integers of the same width, so that there is no need for a dtype dispatch
+    if(itemsize == 1) {
+        NDARRAY_GATHER_LOOP(uint8_t, rarray, rstride, array, stride, indices, count);
+    } else if(itemsize == 2) {
+        NDARRAY_GATHER_LOOP(uint16_t, rarray, rstride, array, stride, indices, count);
+    } else if(itemsize == 4) {
+        NDARRAY_GATHER_LOOP(uint32_t, rarray, rstride, array, stride, indices, count);
+    } else if(itemsize == 8) {
+        NDARRAY_GATHER_LOOP(uint64_t, rarray, rstride, array, stride, indices, count);
+    } else {
+        for(size_t k = 0; k < count; k++) {
+            memcpy(rarray, array + (ptrdiff_t)indices[k] * stride, itemsize);
+            rarray += rstride;
+        }
+    }
+}
+
+mp_obj_t ndarray_take(ndarray_obj_t *source, mp_obj_t index, mp_obj_t axis, uint8_t mode) {
+    // takes the items at the positions given by index along axis, or from the flattened
+    // array, if axis is None; the shape of the index replaces the axis in the result
+    ndarray_obj_t *ndarray = source;
+    uint8_t ndim = ndarray->ndim;
+    size_t shape[ULAB_MAX_DIMS];
+    int32_t strides[ULAB_MAX_DIMS];
+    if(axis == mp_const_none) {
+        if(!ndarray_is_contiguous(ndarray)) {
+            ndarray = ndarray_copy_view(ndarray);
+        }
+        ndim = 1;
+        memset(shape, 0, ULAB_MAX_DIMS * sizeof(size_t));
+        memset(strides, 0, ULAB_MAX_DIMS * sizeof(int32_t));
+        shape[ULAB_MAX_DIMS - 1] = ndarray->len;
+        strides[ULAB_MAX_DIMS - 1] = ndarray->itemsize;
+        axis = MP_OBJ_NEW_SMALL_INT(0);
+    } else {
+        memcpy(shape, ndarray->shape, ULAB_MAX_DIMS * sizeof(size_t));
+        memcpy(strides, ndarray->strides, ULAB_MAX_DIMS * sizeof(int32_t));
+    }
+    int8_t ax = tools_get_axis(axis, ndim);
+    uint8_t shift_ax = ULAB_MAX_DIMS - ndim + ax;
+    uint8_t *array = (uint8_t *)ndarray->array;
+
+    uint8_t indim;
+    size_t ishape[ULAB_MAX_DIMS];
+    size_t count;
+    size_t *indices = ndarray_index_vector(index, shape[shift_ax], mode, &indim, ishape, &count);
+
+    if(ndim - 1 + indim == 0) {
+        // a single integer taken from a one-dimensional array
+        mp_obj_t item = ndarray_get_item(ndarray, array + (ptrdiff_t)indices[0] * strides[ULAB_MAX_DIMS - 1]);
+        m_del(size_t, indices, 1);
+        return item;
+    }
+    uint8_t rndim = ndim - 1 + indim;
+    if(rndim > ULAB_MAX_DIMS) {
+        mp_raise_ValueError(MP_ERROR_TEXT("maximum number of dimensions is " MP_STRINGIFY(ULAB_MAX_DIMS)));
+    }
+
+    // the shape of the result is shape[:ax] + ishape + shape[ax+1:]; since the shapes are
+    // right-aligned, the trailing axes of the result, and of the source are at the same position
+    size_t rshape[ULAB_MAX_DIMS] = { 0 };
+    for(uint8_t i = 0; i < ax; i++) {
+        rshape[ULAB_MAX_DIMS - rndim + i] = shape[ULAB_MAX_DIMS - ndim + i];
+    }
+    for(uint8_t i = 0; i < indim; i++) {
+        rshape[ULAB_MAX_DIMS - rndim + ax + i] = ishape[ULAB_MAX_DIMS - indim + i];
+    }
+    for(uint8_t i = shift_ax + 1; i < ULAB_MAX_DIMS; i++) {
+        rshape[i] = shape[i];
+    }
+    ndarray_obj_t *results = ndarray_new_dense_ndarray(rndim, rshape, ndarray->dtype);
+    if(results->len == 0) {
+        m_del(size_t, indices, count);
+        return MP_OBJ_FROM_PTR(results);
+    }
+
+    // the strides of the result, if the index is flattened into a single axis at shift_ax
+    int32_t rstrides[ULAB_MAX_DIMS] = { 0 };
+    for(uint8_t i = 0; i < ax; i++) {
+        rstrides[ULAB_MAX_DIMS - ndim + i] = results->strides[ULAB_MAX_DIMS - rndim + i];
+    }
+    for(uint8_t i = shift_ax; i < ULAB_MAX_DIMS; i++) {
+        rstrides[i] = results->strides[i];
+    }
+    uint8_t *rarray = (uint8_t *)results->array;
+
+    // if the index runs along the first axis, and the items behind it are contiguous,
+    // the selected sub-arrays are copied as blocks
+    bool blocks = (ax == 0) && (ndim > 1);
+    size_t block = ndarray->itemsize;
+    for(uint8_t i = ULAB_MAX_DIMS; blocks && (i > shift_ax + 1); i--) {
+        if((shape[i - 1] > 1) && (strides[i - 1] != (int32_t)block)) {
+            blocks = false;
+        }
+        block *= shape[i - 1];
+    }
+    if(blocks) {
+        for(size_t k = 0; k < count; k++) {
+            memcpy(rarray, array + (ptrdiff_t)indices[k] * strides[shift_ax], block);
+            rarray += block;
+        }
+        m_del(size_t, indices, count);
+        return MP_OBJ_FROM_PTR(results);
+    }
+
+    // otherwise, the axis is moved to the end, and the items are gathered row by row
+    SWAP(size_t, shape[shift_ax], shape[ULAB_MAX_DIMS - 1]);
+    SWAP(int32_t, strides[shift_ax], strides[ULAB_MAX_DIMS - 1]);
+    SWAP(int32_t, rstrides[shift_ax], rstrides[ULAB_MAX_DIMS - 1]);
+
+    #if ULAB_MAX_DIMS > 3
+    size_t i = 0;
+    do {
+    #endif
+        #if ULAB_MAX_DIMS > 2
+        size_t j = 0;
+        do {
+        #endif
+            #if ULAB_MAX_DIMS > 1
+            size_t l = 0;
+            do {
+            #endif
+                ndarray_gather(rarray, rstrides[ULAB_MAX_DIMS - 1], array, strides[ULAB_MAX_DIMS - 1], indices, count, ndarray->itemsize);
+            #if ULAB_MAX_DIMS > 1
+                array += strides[ULAB_MAX_DIMS - 2];
+                rarray += rstrides[ULAB_MAX_DIMS - 2];
+                l++;
+            } while(l < shape[ULAB_MAX_DIMS - 2]);
+            #endif
+        #if ULAB_MAX_DIMS > 2
+            array -= strides[ULAB_MAX_DIMS - 2] * shape[ULAB_MAX_DIMS - 2];
+            array += strides[ULAB_MAX_DIMS - 3];
+            rarray -= rstrides[ULAB_MAX_DIMS - 2] * shape[ULAB_MAX_DIMS - 2];
+            rarray += rstrides[ULAB_MAX_DIMS - 3];
+            j++;
+        } while(j < shape[ULAB_MAX_DIMS - 3]);
+        #endif
+    #if ULAB_MAX_DIMS > 3
+        array -= strides[ULAB_MAX_DIMS - 3] * shape[ULAB_MAX_DIMS - 3];
+        array += strides[ULAB_MAX_DIMS - 4];
+        rarray -= rstrides[ULAB_MAX_DIMS - 3] * shape[ULAB_MAX_DIMS - 3];
+        rarray += rstrides[ULAB_MAX_DIMS - 4];
+        i++;
+    } while(i < shape[ULAB_MAX_DIMS - 4]);
+    #endif
+
+    m_del(size_t, indices, count);
+    return MP_OBJ_FROM_PTR(results);
+}
+#endif /* NDARRAY_IS_SLICEABLE || ULAB_NUMPY_HAS_TAKE */
+
+#if NDARRAY_IS_SLICEABLE || ULAB_NUMPY_HAS_PUT
+#define NDARRAY_SCATTER_LOOP(type, array, stride, indices, count, varray, vlen)\
+    type *values = (type *)(varray);\
+    for(size_t k = 0, v = 0; k < (count); k++) {\
+        *((type *)((array) + (ptrdiff_t)(indices)[k] * (stride))) = values[v];\
+        if(++v == (vlen)) {\
+            v = 0;\
+        }\
+    }
+
+static void ndarray_scatter(uint8_t *array, int32_t stride, size_t *indices, size_t count, uint8_t *varray, size_t vlen, uint8_t itemsize) {
+    // copies the dense values to array + indices[k] * stride; the values are repeated, if there
+    // are fewer of them than indices, and the last one wins, if an index occurs more than once
+    if(itemsize == 1) {
+        NDARRAY_SCATTER_LOOP(uint8_t, array, stride, indices, count, varray, vlen);
+    } else if(itemsize == 2) {
+        NDARRAY_SCATTER_LOOP(uint16_t, array, stride, indices, count, varray, vlen);
+    } else if(itemsize == 4) {
+        NDARRAY_SCATTER_LOOP(uint32_t, array, stride, indices, count, varray, vlen);
+    } else if(itemsize == 8) {
+        NDARRAY_SCATTER_LOOP(uint64_t, array, stride, indices, count, varray, vlen);
+    } else {
+        for(size_t k = 0, v = 0; k < count; k++) {
+            memcpy(array + (ptrdiff_t)indices[k] * stride, varray + v * itemsize, itemsize);
+            if(++v == vlen) {
+                v = 0;
+            }
+        }
+    }
+}
+#endif /* NDARRAY_IS_SLICEABLE || ULAB_NUMPY_HAS_PUT */
+
+#if ULAB_NUMPY_HAS_PUT
+void ndarray_put(ndarray_obj_t *ndarray, mp_obj_t index, mp_obj_t values_in, uint8_t mode) {
+    // replaces the items of the flattened array at the positions given by index with values
+    uint8_t indim;
+    size_t ishape[ULAB_MAX_DIMS];
+    size_t count;
+    size_t *indices = ndarray_index_vector(index, ndarray->len, mode, &indim, ishape, &count);
+    // the copy is dense, and of the same dtype as the target
+    ndarray_obj_t *values = ndarray_copy_view_convert_type(ndarray_from_mp_obj(values_in, 0), ndarray->dtype);
+    if((values->len == 0) || (count == 0)) {
+        m_del(size_t, indices, count);
+        return;
+    }
+    uint8_t *array = (uint8_t *)ndarray->array;
+    uint8_t *varray = (uint8_t *)values->array;
+    if(ndarray_is_contiguous(ndarray)) {
+        ndarray_scatter(array, ndarray->itemsize, indices, count, varray, values->len, ndarray->itemsize);
+    } else {
+        for(size_t k = 0; k < count; k++) {
+            // unravel the flat index
+            size_t flat = indices[k];
+            uint8_t *target = array;
+            for(uint8_t i = ULAB_MAX_DIMS; i > ULAB_MAX_DIMS - ndarray->ndim; i--) {
+                target += (ptrdiff_t)(flat % ndarray->shape[i - 1]) * ndarray->strides[i - 1];
+                flat /= ndarray->shape[i - 1];
+            }
+            memcpy(target, varray + (k % values->len) * ndarray->itemsize, ndarray->itemsize);
+        }
+    }
+    m_del(size_t, indices, count);
+}
+#endif /* ULAB_NUMPY_HAS_PUT */
+#endif /* NDARRAY_IS_SLICEABLE || ULAB_NUMPY_HAS_TAKE || ULAB_NUMPY_HAS_PUT */
+
 #if NDARRAY_IS_SLICEABLE
 static size_t slice_length(mp_bound_slice_t slice) {
     ssize_t len, correction = 1;
@@ -1057,9 +1506,11 @@ static mp_bound_slice_t generate_slice(mp_int_t n, mp_obj_t index) {
     return slice;
 }
 
-static ndarray_obj_t *ndarray_view_from_slices(ndarray_obj_t *ndarray, mp_obj_tuple_t *tuple) {
-    size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
-    int32_t *strides = m_new0(int32_t, ULAB_MAX_DIMS);
+static void ndarray_view_from_slices(ndarray_obj_t *view, ndarray_obj_t *ndarray, size_t nindex, const mp_obj_t *index) {
+    // fills in the header of the view selected by the nindex integers, or slices in index;
+    // only the header of a view that is returned to the interpreter has to be on the heap
+    size_t shape[ULAB_MAX_DIMS] = { 0 };
+    int32_t strides[ULAB_MAX_DIMS] = { 0 };
 
     uint8_t ndim = ndarray->ndim;
 
@@ -1069,11 +1520,11 @@ static ndarray_obj_t *ndarray_view_from_slices(ndarray_obj_t *ndarray, mp_obj_tu
         strides[ULAB_MAX_DIMS - 1 - i] = ndarray->strides[ULAB_MAX_DIMS  - 1 - i];
     }
     int32_t offset = 0;
-    for(uint8_t i=0; i  < tuple->len; i++) {
-        if(mp_obj_is_int(tuple->items[i])) {
+    for(uint8_t i=0; i  < nindex; i++) {
+        if(mp_obj_is_int(index[i])) {
             // if item is an int, the dimension will first be reduced ...
             ndim--;
-            int32_t k = mp_obj_get_int(tuple->items[i]);
+            int32_t k = mp_obj_get_int(index[i]);
             if(k < 0) {
                 k += ndarray->shape[ULAB_MAX_DIMS - ndarray->ndim + i];
             }
@@ -1087,13 +1538,13 @@ static ndarray_obj_t *ndarray_view_from_slices(ndarray_obj_t *ndarray, mp_obj_tu
                 strides[ULAB_MAX_DIMS - ndarray->ndim + i - j] = strides[ULAB_MAX_DIMS - ndarray->ndim + i - j - 1];
             }
         } else {
-            mp_bound_slice_t slice = generate_slice(shape[ULAB_MAX_DIMS - ndarray->ndim + i], tuple->items[i]);
+            mp_bound_slice_t slice = generate_slice(shape[ULAB_MAX_DIMS - ndarray->ndim + i], index[i]);
             shape[ULAB_MAX_DIMS - ndarray->ndim + i] = slice_length(slice);
             offset += ndarray->strides[ULAB_MAX_DIMS - ndarray->ndim + i] * (int32_t)slice.start;
             strides[ULAB_MAX_DIMS - ndarray->ndim + i] = (int32_t)slice.step * ndarray->strides[ULAB_MAX_DIMS - ndarray->ndim + i];
         }
     }
-    return ndarray_new_view(ndarray, ndim, shape, strides, offset);
+    ndarray_fill_view(view, ndarray, ndim, shape, strides, offset);
 }
 
 void ndarray_assign_view(ndarray_obj_t *view, ndarray_obj_t *values) {
@@ -1101,9 +1552,9 @@ void ndarray_assign_view(ndarray_obj_t *view, ndarray_obj_t *values) {
         return;
     }
     uint8_t ndim = 0;
-    size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
-    int32_t *lstrides = m_new0(int32_t, ULAB_MAX_DIMS);
-    int32_t *rstrides = m_new0(int32_t, ULAB_MAX_DIMS);
+    size_t shape[ULAB_MAX_DIMS] = { 0 };
+    int32_t lstrides[ULAB_MAX_DIMS] = { 0 };
+    int32_t rstrides[ULAB_MAX_DIMS] = { 0 };
     if(!ndarray_can_broadcast(view, values, &ndim, shape, lstrides, rstrides)) {
         mp_raise_ValueError(MP_ERROR_TEXT("operands could not be broadcast together"));
     } else {
@@ -1160,12 +1611,6 @@ void ndarray_assign_view(ndarray_obj_t *view, ndarray_obj_t *values) {
         } while(i <  view->shape[ULAB_MAX_DIMS - 4]);
         #endif
     }
-
-    m_del(size_t, shape, ULAB_MAX_DIMS);
-    m_del(int32_t, lstrides, ULAB_MAX_DIMS);
-    m_del(int32_t, rstrides, ULAB_MAX_DIMS);
-
-    return;
 }
 
 static mp_obj_t ndarray_from_boolean_index(ndarray_obj_t *ndarray, ndarray_obj_t *index) {
@@ -1174,25 +1619,16 @@ static mp_obj_t ndarray_from_boolean_index(ndarray_obj_t *ndarray, ndarray_obj_t
         mp_raise_ValueError(MP_ERROR_TEXT("array and index length must be equal"));
     }
     uint8_t *iarray = (uint8_t *)index->array;
+    int32_t istride = index->strides[ULAB_MAX_DIMS - 1];
     // first we have to find out how many trues there are
-    size_t count = 0;
-    for(size_t i=0; i < index->len; i++) {
-        count += *iarray;
-        iarray += index->strides[ULAB_MAX_DIMS - 1];
-    }
+    size_t count = tools_count_true(iarray, istride, index->len);
     ndarray_obj_t *results = ndarray_new_linear_array(count, ndarray->dtype);
     uint8_t *rarray = (uint8_t *)results->array;
     uint8_t *array = (uint8_t *)ndarray->array;
-    // re-wind the index array
-    iarray = index->array;
-    for(size_t i=0; i < index->len; i++) {
-        if(*iarray) {
-            memcpy(rarray, array, results->itemsize);
-            rarray += results->itemsize;
-            count++;
-        }
-        array += ndarray->strides[ULAB_MAX_DIMS - 1];
-        iarray += index->strides[ULAB_MAX_DIMS - 1];
+    int32_t stride = ndarray->strides[ULAB_MAX_DIMS - 1];
+    for(size_t i = tools_next_true(iarray, istride, 0, index->len); i < index->len; i = tools_next_true(iarray, istride, i + 1, index->len)) {
+        memcpy(rarray, array + (ptrdiff_t)i * stride, results->itemsize);
+        rarray += results->itemsize;
     }
     return MP_OBJ_FROM_PTR(results);
 }
@@ -1201,14 +1637,8 @@ static mp_obj_t ndarray_assign_from_boolean_index(ndarray_obj_t *ndarray, ndarra
     // assigns values to a Boolean-indexed array
     // first we have to find out how many trues there are
     uint8_t *iarray = (uint8_t *)index->array;
-    size_t istride = index->strides[ULAB_MAX_DIMS - 1];
-    size_t count = 0;
-    for(size_t i=0; i < index->len; i++) {
-        count += *iarray;
-        iarray += istride;
-    }
-    // re-wind the index array
-    iarray = index->array;
+    int32_t istride = index->strides[ULAB_MAX_DIMS - 1];
+    size_t count = tools_count_true(iarray, istride, index->len);
     uint8_t *varray = (uint8_t *)values->array;
     size_t vstride;
 
@@ -1226,41 +1656,54 @@ static mp_obj_t ndarray_assign_from_boolean_index(ndarray_obj_t *ndarray, ndarra
             mp_raise_TypeError(MP_ERROR_TEXT("cannot convert complex to dtype"));
         } else {
             uint8_t *array = (uint8_t *)ndarray->array;
-            for(size_t i = 0; i < ndarray->len; i++) {
-                if(*iarray) {
-                    memcpy(array, varray, ndarray->itemsize);
-                    varray += vstride;
-                }
-                array += ndarray->strides[ULAB_MAX_DIMS - 1];
-                iarray += istride;
-            } while(0);
+            int32_t stride = ndarray->strides[ULAB_MAX_DIMS - 1];
+            for(size_t i = tools_next_true(iarray, istride, 0, ndarray->len); i < ndarray->len; i = tools_next_true(iarray, istride, i + 1, ndarray->len)) {
+                memcpy(array + (ptrdiff_t)i * stride, varray, ndarray->itemsize);
+                varray += vstride;
+            }
             return MP_OBJ_FROM_PTR(ndarray);
         }
     }
     #endif
 
+    #if ULAB_HAS_GENERIC_DTYPES
+    if(ULAB_DTYPE_IS_GENERIC(ndarray->dtype) || ULAB_DTYPE_IS_GENERIC(values->dtype)) {
+        // the values are converted to the dtype of the target, and can then be copied
+        values = ndarray_copy_view_convert_type(values, ndarray->dtype);
+        varray = (uint8_t *)values->array;
+        vstride = vstride ? ndarray->itemsize : 0;
+        uint8_t *array = (uint8_t *)ndarray->array;
+        int32_t stride = ndarray->strides[ULAB_MAX_DIMS - 1];
+        for(size_t i = tools_next_true(iarray, istride, 0, ndarray->len); i < ndarray->len; i = tools_next_true(iarray, istride, i + 1, ndarray->len)) {
+            memcpy(array + (ptrdiff_t)i * stride, varray, ndarray->itemsize);
+            varray += vstride;
+        }
+        return MP_OBJ_FROM_PTR(ndarray);
+    }
+    #endif
+
     int32_t lstrides = ndarray->strides[ULAB_MAX_DIMS - 1] / ndarray->itemsize;
 
     if(ndarray->dtype == NDARRAY_UINT8) {
         if(values->dtype == NDARRAY_UINT8) {
             BOOLEAN_ASSIGNMENT_LOOP(uint8_t, uint8_t, ndarray, lstrides, iarray, istride, varray, vstride);
-        } else if(values->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(values->dtype, INT8)) {
             BOOLEAN_ASSIGNMENT_LOOP(uint8_t, int8_t, ndarray, lstrides, iarray, istride, varray, vstride);
         } else if(values->dtype == NDARRAY_UINT16) {
             BOOLEAN_ASSIGNMENT_LOOP(uint8_t, uint16_t, ndarray, lstrides, iarray, istride, varray, vstride);
-        } else if(values->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(values->dtype, INT16)) {
             BOOLEAN_ASSIGNMENT_LOOP(uint8_t, int16_t, ndarray, lstrides, iarray, istride, varray, vstride);
         } else if(values->dtype == NDARRAY_FLOAT) {
             BOOLEAN_ASSIGNMENT_LOOP(uint8_t, mp_float_t, ndarray, lstrides, iarray, istride, varray, vstride);
         }
-    } else if(ndarray->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(ndarray->dtype, INT8)) {
         if(values->dtype == NDARRAY_UINT8) {
             BOOLEAN_ASSIGNMENT_LOOP(int8_t, uint8_t, ndarray, lstrides, iarray, istride, varray, vstride);
-        } else if(values->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(values->dtype, INT8)) {
             BOOLEAN_ASSIGNMENT_LOOP(int8_t, int8_t, ndarray, lstrides, iarray, istride, varray, vstride);
         } else if(values->dtype == NDARRAY_UINT16) {
             BOOLEAN_ASSIGNMENT_LOOP(int8_t, uint16_t, ndarray, lstrides, iarray, istride, varray, vstride);
-        } else if(values->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(values->dtype, INT16)) {
             BOOLEAN_ASSIGNMENT_LOOP(int8_t, int16_t, ndarray, lstrides, iarray, istride, varray, vstride);
         } else if(values->dtype == NDARRAY_FLOAT) {
             BOOLEAN_ASSIGNMENT_LOOP(int8_t, mp_float_t, ndarray, lstrides, iarray, istride, varray, vstride);
@@ -1268,23 +1711,23 @@ static mp_obj_t ndarray_assign_from_boolean_index(ndarray_obj_t *ndarray, ndarra
     } else if(ndarray->dtype == NDARRAY_UINT16) {
         if(values->dtype == NDARRAY_UINT8) {
             BOOLEAN_ASSIGNMENT_LOOP(uint16_t, uint8_t, ndarray, lstrides, iarray, istride, varray, vstride);
-        } else if(values->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(values->dtype, INT8)) {
             BOOLEAN_ASSIGNMENT_LOOP(uint16_t, int8_t, ndarray, lstrides, iarray, istride, varray, vstride);
         } else if(values->dtype == NDARRAY_UINT16) {
             BOOLEAN_ASSIGNMENT_LOOP(uint16_t, uint16_t, ndarray, lstrides, iarray, istride, varray, vstride);
-        } else if(values->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(values->dtype, INT16)) {
             BOOLEAN_ASSIGNMENT_LOOP(uint16_t, int16_t, ndarray, lstrides, iarray, istride, varray, vstride);
         } else if(values->dtype == NDARRAY_FLOAT) {
             BOOLEAN_ASSIGNMENT_LOOP(uint16_t, mp_float_t, ndarray, lstrides, iarray, istride, varray, vstride);
         }
-    } else if(ndarray->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(ndarray->dtype, INT16)) {
         if(values->dtype == NDARRAY_UINT8) {
             BOOLEAN_ASSIGNMENT_LOOP(int16_t, uint8_t, ndarray, lstrides, iarray, istride, varray, vstride);
-        } else if(values->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(values->dtype, INT8)) {
             BOOLEAN_ASSIGNMENT_LOOP(int16_t, int8_t, ndarray, lstrides, iarray, istride, varray, vstride);
         } else if(values->dtype == NDARRAY_UINT16) {
             BOOLEAN_ASSIGNMENT_LOOP(int16_t, uint16_t, ndarray, lstrides, iarray, istride, varray, vstride);
-        } else if(values->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(values->dtype, INT16)) {
             BOOLEAN_ASSIGNMENT_LOOP(int16_t, int16_t, ndarray, lstrides, iarray, istride, varray, vstride);
         } else if(values->dtype == NDARRAY_FLOAT) {
             BOOLEAN_ASSIGNMENT_LOOP(int16_t, mp_float_t, ndarray, lstrides, iarray, istride, varray, vstride);
@@ -1297,11 +1740,11 @@ static mp_obj_t ndarray_assign_from_boolean_index(ndarray_obj_t *ndarray, ndarra
         #endif
         if(values->dtype == NDARRAY_UINT8) {
             BOOLEAN_ASSIGNMENT_LOOP(mp_float_t, uint8_t, ndarray, lstrides, iarray, istride, varray, vstride);
-        } else if(values->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(values->dtype, INT8)) {
             BOOLEAN_ASSIGNMENT_LOOP(mp_float_t, int8_t, ndarray, lstrides, iarray, istride, varray, vstride);
         } else if(values->dtype == NDARRAY_UINT16) {
             BOOLEAN_ASSIGNMENT_LOOP(mp_float_t, uint16_t, ndarray, lstrides, iarray, istride, varray, vstride);
-        } else if(values->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(values->dtype, INT16)) {
             BOOLEAN_ASSIGNMENT_LOOP(mp_float_t, int16_t, ndarray, lstrides, iarray, istride, varray, vstride);
         } else if(values->dtype == NDARRAY_FLOAT) {
             BOOLEAN_ASSIGNMENT_LOOP(mp_float_t, mp_float_t, ndarray, lstrides, iarray, istride, varray, vstride);
@@ -1310,40 +1753,86 @@ static mp_obj_t ndarray_assign_from_boolean_index(ndarray_obj_t *ndarray, ndarra
     return MP_OBJ_FROM_PTR(ndarray);
 }
 
+static void ndarray_assign_from_integer_index(ndarray_obj_t *ndarray, mp_obj_t index, ndarray_obj_t *values) {
+    // assigns values to the sub-arrays selected by the integers in index along the first axis
+    uint8_t indim;
+    size_t ishape[ULAB_MAX_DIMS];
+    size_t count;
+    size_t *indices = ndarray_index_vector(index, ndarray->shape[ULAB_MAX_DIMS - ndarray->ndim], NDARRAY_INDEX_RAISE, &indim, ishape, &count);
+
+    if(ndarray->ndim == 1) {
+        if((values->len != 1) && (values->len != count)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("operands could not be broadcast together"));
+        }
+        ndarray_obj_t *dense = ndarray_copy_view_convert_type(values, ndarray->dtype);
+        ndarray_scatter((uint8_t *)ndarray->array, ndarray->strides[ULAB_MAX_DIMS - 1], indices, count,
+                        (uint8_t *)dense->array, dense->len, ndarray->itemsize);
+    } else {
+        // the selected sub-arrays are assigned one by one as views, either from the
+        // corresponding sub-array of values, or from the whole of values, which is then broadcast
+        bool by_row = (indim == 1) && (values->ndim == ndarray->ndim) && (values->shape[ULAB_MAX_DIMS - values->ndim] == count) && (count > 1);
+        ndarray_obj_t view, vrow;
+        for(size_t k = 0; k < count; k++) {
+            ndarray_fill_view(&view, ndarray, ndarray->ndim - 1, ndarray->shape, ndarray->strides,
+                                (int32_t)indices[k] * ndarray->strides[ULAB_MAX_DIMS - ndarray->ndim]);
+            if(by_row) {
+                ndarray_fill_view(&vrow, values, values->ndim - 1, values->shape, values->strides,
+                                    (int32_t)k * values->strides[ULAB_MAX_DIMS - values->ndim]);
+                ndarray_assign_view(&view, &vrow);
+            } else {
+                ndarray_assign_view(&view, values);
+            }
+        }
+    }
+    m_del(size_t, indices, count);
+}
+
 static mp_obj_t ndarray_get_slice(ndarray_obj_t *ndarray, mp_obj_t index, ndarray_obj_t *values) {
-    if(mp_obj_is_type(index, &ulab_ndarray_type)) {
+    if(mp_obj_is_type(index, &ulab_ndarray_type) && ((ndarray_obj_t *)MP_OBJ_TO_PTR(index))->boolean) {
         ndarray_obj_t *nindex = MP_OBJ_TO_PTR(index);
-        if((nindex->ndim > 1) || (nindex->boolean == false)) {
+        if(nindex->ndim > 1) {
             mp_raise_NotImplementedError(MP_ERROR_TEXT("operation is implemented for 1D Boolean arrays only"));
         }
         if(values == NULL) { // return value(s)
             return ndarray_from_boolean_index(ndarray, nindex);
         } else { // assign value(s)
             ndarray_assign_from_boolean_index(ndarray, nindex, values);
+            return mp_const_none;
+        }
+    }
+    if(mp_obj_is_type(index, &ulab_ndarray_type) || mp_obj_is_type(index, &mp_type_list)) {
+        // integer-array indexing along the first axis
+        if(values == NULL) {
+            return ndarray_take(ndarray, index, MP_OBJ_NEW_SMALL_INT(0), NDARRAY_INDEX_RAISE);
+        } else {
+            ndarray_assign_from_integer_index(ndarray, index, values);
         }
     }
     if(mp_obj_is_type(index, &mp_type_tuple) || mp_obj_is_int(index) || mp_obj_is_type(index, &mp_type_slice)) {
-        mp_obj_tuple_t *tuple;
+        size_t nindex = 1;
+        const mp_obj_t *items = &index;
         if(mp_obj_is_type(index, &mp_type_tuple)) {
-            tuple = MP_OBJ_TO_PTR(index);
+            mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(index);
             if(tuple->len > ndarray->ndim) {
                 mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("too many indices"));
             }
-        } else {
-            mp_obj_t *items = m_new(mp_obj_t, 1);
-            items[0] = index;
-            tuple = MP_OBJ_TO_PTR(mp_obj_new_tuple(1, items));
+            nindex = tuple->len;
+            items = tuple->items;
         }
-        ndarray_obj_t *view = ndarray_view_from_slices(ndarray, tuple);
+        // the view is copied to the heap only, if it is returned as an array
+        ndarray_obj_t view;
+        ndarray_view_from_slices(&view, ndarray, nindex, items);
         if(values == NULL) { // return value(s)
             // if the view has been reduced to nothing, return a single value
-            if(view->ndim == 0) {
-                return ndarray_get_item(view, view->array);
+            if(view.ndim == 0) {
+                return ndarray_get_item(&view, view.array);
             } else {
-                return MP_OBJ_FROM_PTR(view);
+                ndarray_obj_t *result = m_new_obj(ndarray_obj_t);
+                *result = view;
+                return MP_OBJ_FROM_PTR(result);
             }
         } else { // assign value(s)
-            ndarray_assign_view(view, values);
+            ndarray_assign_view(&view, values);
         }
     }
     return mp_const_none;
@@ -1519,6 +2008,36 @@ mp_obj_t ndarray_flatten(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_a
 MP_DEFINE_CONST_FUN_OBJ_KW(ndarray_flatten_obj, 1, ndarray_flatten);
 #endif
 
+#if NDARRAY_HAS_RAVEL
+mp_obj_t ndarray_ravel(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    // same as flatten, but returns a view, whenever the strides allow it
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_order, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_QSTR(MP_QSTR_C)} },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    ndarray_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    GET_STR_DATA_LEN(args[0].u_obj, order, len);
+    if((len != 1) || ((memcmp(order, "C", 1) != 0) && (memcmp(order, "F", 1) != 0))) {
+        mp_raise_ValueError(MP_ERROR_TEXT("flattening order must be either 'C', or 'F'"));
+    }
+
+    size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
+    int32_t *strides = m_new0(int32_t, ULAB_MAX_DIMS);
+    shape[ULAB_MAX_DIMS - 1] = self->len;
+    // in Fortran order, only one-dimensional arrays can be viewed
+    if(((memcmp(order, "C", 1) == 0) || (self->ndim == 1)) && ndarray_view_strides(self, 1, shape, strides)) {
+        return MP_OBJ_FROM_PTR(ndarray_new_view(self, 1, shape, strides, 0));
+    }
+    m_del(size_t, shape, ULAB_MAX_DIMS);
+    m_del(int32_t, strides, ULAB_MAX_DIMS);
+    return ndarray_flatten(n_args, pos_args, kw_args);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(ndarray_ravel_obj, 1, ndarray_ravel);
+#endif
+
 #if NDARRAY_HAS_ITEMSIZE
 mp_obj_t ndarray_itemsize(mp_obj_t self_in) {
     ndarray_obj_t *self = MP_OBJ_TO_PTR(self_in);
@@ -1560,10 +2079,100 @@ mp_obj_t ndarray_strides(mp_obj_t self_in) {
 }
 #endif
 
+#if NDARRAY_HAS_TOBYTES || NDARRAY_HAS_TOFILE
+static void ndarray_export_rows(ndarray_obj_t *self, uint8_t *dest, mp_obj_t stream) {
+    // copies the payload of self in C order into dest, or, if dest is NULL, writes it to stream;
+    // dense arrays are written in a single call, otherwise, each row along the last axis is
+    // written directly, if it is contiguous, and gathered into a row-sized buffer first, if not
+    int error = 0;
+    size_t nbytes = self->itemsize * self->len;
+    if(nbytes == 0) {
+        return;
+    }
+    // ndarray_is_dense checks the first stride only, which is not enough here,
+    // because, e.g., a[:, ::-1] must not be written in a single block
+    if(ndarray_is_contiguous(self)) {
+        if(dest != NULL) {
+            memcpy(dest, self->array, nbytes);
+        } else if(mp_stream_write_exactly(stream, self->array, nbytes, &error) != nbytes) {
+            mp_raise_OSError(error);
+        }
+        return;
+    }
+
+    size_t shape = self->shape[ULAB_MAX_DIMS - 1];
+    int32_t stride = self->strides[ULAB_MAX_DIMS - 1];
+    size_t row_size = self->itemsize * shape;
+    bool contiguous = stride == self->itemsize;
+    uint8_t *row = NULL;
+    if(!contiguous && (dest == NULL)) {
+        row = ulab_scratch_new(uint8_t, row_size);
+    }
+
+    #if ULAB_MAX_DIMS > 1
+    size_t coords[ULAB_MAX_DIMS] = { 0 };
+    #endif
+    for(size_t r = 0; r < self->len / shape; r++) {
+        uint8_t *array = (uint8_t *)self->array;
+        #if ULAB_MAX_DIMS > 1
+        for(uint8_t i = ULAB_MAX_DIMS - self->ndim; i < ULAB_MAX_DIMS - 1; i++) {
+            array += coords[i] * self->strides[i];
+        }
+        #endif
+        uint8_t *source = array;
+        if(!contiguous) {
+            source = dest != NULL ? dest : row;
+            uint8_t *target = source;
+            for(size_t l = 0; l < shape; l++) {
+                memcpy(target, array, self->itemsize);
+                target += self->itemsize;
+                array += stride;
+            }
+        }
+        if(dest != NULL) {
+            if(contiguous) {
+                memcpy(dest, source, row_size);
+            }
+            dest += row_size;
+        } else if(mp_stream_write_exactly(stream, source, row_size, &error) != row_size) {
+            mp_raise_OSError(error);
+        }
+        #if ULAB_MAX_DIMS > 1
+        // move on to the next row
+        for(uint8_t i = ULAB_MAX_DIMS - 1; i > ULAB_MAX_DIMS - self->ndim; i--) {
+            if(++coords[i - 1] < self->shape[i - 1]) {
+                break;
+            }
+            coords[i - 1] = 0;
+        }
+        #endif
+    }
+
+    if(row != NULL) {
+        ulab_scratch_del(uint8_t, row, row_size);
+    }
+}
+#endif /* NDARRAY_HAS_TOBYTES || NDARRAY_HAS_TOFILE */
+
 #if NDARRAY_HAS_TOBYTES
-mp_obj_t ndarray_tobytes(mp_obj_t self_in) {
+mp_obj_t ndarray_tobytes(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_copy, MP_ARG_KW_ONLY | MP_ARG_BOOL, { .u_bool = false } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    ndarray_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+
+    if(args[0].u_bool) {
+        // a bytes object with a copy of the payload in C order, as in numpy;
+        // this works for arrays of any layout
+        vstr_t vstr;
+        vstr_init_len(&vstr, self->itemsize * self->len);
+        ndarray_export_rows(self, (uint8_t *)vstr.buf, mp_const_none);
+        return mp_obj_new_bytes_from_vstr(&vstr);
+    }
     // As opposed to numpy, this function returns a bytearray object with the data pointer (i.e., not a copy)
-    ndarray_obj_t *self = MP_OBJ_TO_PTR(self_in);
     // Piping into a bytearray makes sense for dense arrays only,
     // so bail out, if that is not the case
     if(!ndarray_is_dense(self)) {
@@ -1572,7 +2181,32 @@ mp_obj_t ndarray_tobytes(mp_obj_t self_in) {
     return mp_obj_new_bytearray_by_ref(self->itemsize * self->len, self->array);
 }
 
-MP_DEFINE_CONST_FUN_OBJ_1(ndarray_tobytes_obj, ndarray_tobytes);
+MP_DEFINE_CONST_FUN_OBJ_KW(ndarray_tobytes_obj, 1, ndarray_tobytes);
+#endif
+
+#if NDARRAY_HAS_TOFILE
+mp_obj_t ndarray_tofile(mp_obj_t self_in, mp_obj_t file) {
+    // writes the payload in C order to a stream, or to a file given by its name; as in
+    // numpy, there is no header, the data can be read back with frombuffer
+    ndarray_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if(mp_obj_is_str(file)) {
+        mp_obj_t open_args[2] = {
+            file,
+            MP_OBJ_NEW_QSTR(MP_QSTR_wb)
+        };
+        mp_obj_t stream = mp_builtin_open_obj.fun.kw(2, open_args, (mp_map_t *)&mp_const_empty_map);
+        const mp_stream_p_t *stream_p = mp_get_stream(stream);
+        int error;
+        ndarray_export_rows(self, NULL, stream);
+        stream_p->ioctl(stream, MP_STREAM_CLOSE, 0, &error);
+    } else {
+        mp_get_stream_raise(file, MP_STREAM_OP_WRITE);
+        ndarray_export_rows(self, NULL, file);
+    }
+    return mp_const_none;
+}
+
+MP_DEFINE_CONST_FUN_OBJ_2(ndarray_tofile_obj, ndarray_tofile);
 #endif
 
 #if NDARRAY_HAS_TOLIST
@@ -1602,6 +2236,34 @@ MP_DEFINE_CONST_FUN_OBJ_1(ndarray_tolist_obj, ndarray_tolist);
 #endif
 
 // Binary operations
+static uint8_t ndarray_scalar_int_dtype(int32_t ivalue, uint8_t other_type) {
+    // returns the smallest integer type that can accommodate ivalue, or NDARRAY_FLOAT,
+    // if the value does not fit any of the integer types
+    if((ivalue < -32767) || (ivalue > 32767)) {
+        // the integer value clearly does not fit the 16-bit integer types, so move on to int32, or float
+        return ULAB_SUPPORTS_INT32 ? NDARRAY_INT32 : NDARRAY_FLOAT;
+    }
+    // without the signed integer types, negative values are promoted to the next supported type
+    if(ivalue < 0) {
+        if(ULAB_SUPPORTS_INT8 && (ivalue > -128)) {
+            return NDARRAY_INT8;
+        }
+        return ULAB_SUPPORTS_INT16 ? NDARRAY_INT16 : NDARRAY_FLOAT;
+    }
+    // ivalue >= 0
+    if(ULAB_DTYPE_IS(other_type, INT8) || ULAB_DTYPE_IS(other_type, INT16)) {
+        if(ULAB_SUPPORTS_INT8 && (ivalue < 128)) {
+            return NDARRAY_INT8;
+        }
+        return NDARRAY_INT16;
+    }
+    // other_type = 0 is also included here
+    if(ivalue < 256) {
+        return NDARRAY_UINT8;
+    }
+    return NDARRAY_UINT16;
+}
+
 ndarray_obj_t *ndarray_from_mp_obj(mp_obj_t obj, uint8_t other_type) {
     // creates an ndarray from a micropython int or float
     // if the input is an ndarray, it is returned
@@ -1610,34 +2272,12 @@ ndarray_obj_t *ndarray_from_mp_obj(mp_obj_t obj, uint8_t other_type) {
 
     if(mp_obj_is_int(obj)) {
         int32_t ivalue = mp_obj_get_int(obj);
-        if((ivalue < -32767) || (ivalue > 32767)) {
-            // the integer value clearly does not fit the ulab integer types, so move on to float
+        uint8_t dtype = ndarray_scalar_int_dtype(ivalue, other_type);
+        if(dtype == NDARRAY_FLOAT) {
             ndarray = ndarray_new_linear_array(1, NDARRAY_FLOAT);
             mp_float_t *array = (mp_float_t *)ndarray->array;
             array[0] = (mp_float_t)ivalue;
         } else {
-            uint8_t dtype;
-            if(ivalue < 0) {
-                if(ivalue > -128) {
-                    dtype = NDARRAY_INT8;
-                } else {
-                    dtype = NDARRAY_INT16;
-                }
-            } else { // ivalue >= 0
-                if((other_type == NDARRAY_INT8) || (other_type == NDARRAY_INT16)) {
-                    if(ivalue < 128) {
-                        dtype = NDARRAY_INT8;
-                    } else {
-                        dtype = NDARRAY_INT16;
-                    }
-                } else { // other_type = 0 is also included here
-                    if(ivalue < 256) {
-                        dtype = NDARRAY_UINT8;
-                    } else {
-                        dtype = NDARRAY_UINT16;
-                    }
-                }
-            }
             ndarray = ndarray_new_linear_array(1, dtype);
             ndarray_set_value(dtype, ndarray->array, 0, obj);
         }
@@ -1668,21 +2308,123 @@ ndarray_obj_t *ndarray_from_mp_obj(mp_obj_t obj, uint8_t other_type) {
     return ndarray;
 }
 
+
 #if NDARRAY_HAS_BINARY_OPS || NDARRAY_HAS_INPLACE_OPS
+static bool ndarray_scalar_on_stack(ndarray_obj_t *ndarray, mp_float_t *buffer, mp_obj_t obj, uint8_t other_type) {
+    // wraps a micropython int, float, bool, or complex in a single-element ndarray,
+    // whose header and data are supplied by the caller (typically, on the stack),
+    // so that binary operators with a scalar operand don't have to allocate a temporary
+    // the dtype rules are identical to those of ndarray_from_mp_obj
+    // returns false, if obj is not a scalar
+    uint8_t dtype;
+    if(mp_obj_is_int(obj)) {
+        int32_t ivalue = mp_obj_get_int(obj);
+        dtype = ndarray_scalar_int_dtype(ivalue, other_type);
+        if(dtype == NDARRAY_FLOAT) {
+            buffer[0] = (mp_float_t)ivalue;
+        } else {
+            ndarray_set_value(dtype, buffer, 0, obj);
+        }
+    } else if(mp_obj_is_float(obj)) {
+        dtype = NDARRAY_FLOAT;
+        buffer[0] = mp_obj_get_float(obj);
+    } else if(mp_obj_is_bool(obj)) {
+        dtype = NDARRAY_BOOL;
+        *((uint8_t *)buffer) = obj == mp_const_true ? 1 : 0;
+    }
+    #if ULAB_SUPPORTS_COMPLEX
+    else if(mp_obj_is_type(obj, &mp_type_complex)) {
+        dtype = NDARRAY_COMPLEX;
+        mp_obj_get_complex(obj, &buffer[0], &buffer[1]);
+    }
+    #endif
+    else {
+        return false;
+    }
+    ndarray->base.type = &ulab_ndarray_type;
+    ndarray->dtype = dtype == NDARRAY_BOOL ? NDARRAY_UINT8 : dtype;
+    ndarray->boolean = dtype == NDARRAY_BOOL ? NDARRAY_BOOLEAN : NDARRAY_NUMERIC;
+    ndarray->itemsize = ulab_binary_get_size(dtype);
+    ndarray->ndim = 1;
+    ndarray->len = 1;
+    for(uint8_t i = 0; i < ULAB_MAX_DIMS; i++) {
+        ndarray->shape[i] = 0;
+        ndarray->strides[i] = 0;
+    }
+    ndarray->shape[ULAB_MAX_DIMS - 1] = 1;
+    ndarray->strides[ULAB_MAX_DIMS - 1] = ndarray->itemsize;
+    ndarray->array = buffer;
+    ndarray->origin = buffer;
+    return true;
+}
+
+static ndarray_obj_t *ndarray_binary_operand(mp_obj_t obj, uint8_t other_type, ndarray_obj_t *scalar, mp_float_t *buffer) {
+    // returns the operand of a binary operator as an ndarray
+    // scalars are placed in the header supplied by the caller, and are not allocated on the heap
+    if(ndarray_scalar_on_stack(scalar, buffer, obj, other_type)) {
+        return scalar;
+    }
+    return ndarray_from_mp_obj(obj, other_type);
+}
+
+#if NDARRAY_BINARY_HAS_DENSE_LOOP
+static void ndarray_binary_scalar_to_dtype(ndarray_obj_t *scalar, ndarray_obj_t *other) {
+    // converts a numeric scalar to the dtype of the other operand in place, if the upcasting rules
+    // would yield that dtype anyway, so that the operator can be evaluated in the dense loop
+    if(scalar->boolean || (scalar->dtype == other->dtype)) {
+        return;
+    }
+    bool narrow_int = (scalar->dtype == NDARRAY_UINT8) || ULAB_DTYPE_IS(scalar->dtype, INT8);
+    mp_float_t value = ndarray_get_float_value(scalar->array, scalar->dtype);
+    if(other->dtype == NDARRAY_FLOAT) {
+        if(!narrow_int && !ULAB_DTYPE_IS(scalar->dtype, INT16) && (scalar->dtype != NDARRAY_UINT16)) {
+            return;
+        }
+        *((mp_float_t *)scalar->array) = value;
+    } else if(ULAB_DTYPE_IS(other->dtype, INT16) && narrow_int) {
+        *((int16_t *)scalar->array) = (int16_t)value;
+    } else if((other->dtype == NDARRAY_UINT16) && (scalar->dtype == NDARRAY_UINT8)) {
+        *((uint16_t *)scalar->array) = (uint16_t)value;
+    } else {
+        return;
+    }
+    scalar->dtype = other->dtype;
+    scalar->itemsize = other->itemsize;
+    scalar->strides[ULAB_MAX_DIMS - 1] = other->itemsize;
+}
+#endif /* NDARRAY_BINARY_HAS_DENSE_LOOP */
+
 mp_obj_t ndarray_binary_op(mp_binary_op_t _op, mp_obj_t lobj, mp_obj_t robj) {
     // TODO: implement in-place operators
+    #if ULAB_NUMPY_HAS_LAZY
+    if(mp_obj_is_type(robj, &lazy_type)) {
+        // returning MP_OBJ_NULL delegates the operation to the reverse operator of the lazy object
+        return MP_OBJ_NULL;
+    }
+    #endif
     // if the ndarray stands on the right hand side of the expression, simply swap the operands
     ndarray_obj_t *lhs, *rhs;
+    // scalar operands are wrapped in these headers, so that they don't end up on the heap
+    ndarray_obj_t lscalar, rscalar;
+    // large enough for a single complex number
+    mp_float_t lbuffer[2], rbuffer[2];
     mp_binary_op_t op = _op;
     if((op == MP_BINARY_OP_REVERSE_ADD) || (op == MP_BINARY_OP_REVERSE_MULTIPLY) ||
         (op == MP_BINARY_OP_REVERSE_POWER) || (op == MP_BINARY_OP_REVERSE_SUBTRACT) ||
         (op == MP_BINARY_OP_REVERSE_TRUE_DIVIDE)) {
-        lhs = ndarray_from_mp_obj(robj, 0);
-        rhs = ndarray_from_mp_obj(lobj, lhs->dtype);
+        lhs = ndarray_binary_operand(robj, 0, &lscalar, lbuffer);
+        rhs = ndarray_binary_operand(lobj, lhs->dtype, &rscalar, rbuffer);
     } else {
-        lhs = ndarray_from_mp_obj(lobj, 0);
-        rhs = ndarray_from_mp_obj(robj, lhs->dtype);
+        lhs = ndarray_binary_operand(lobj, 0, &lscalar, lbuffer);
+        rhs = ndarray_binary_operand(robj, lhs->dtype, &rscalar, rbuffer);
     }
+    #if NDARRAY_BINARY_HAS_DENSE_LOOP
+    if(lhs == &lscalar) {
+        ndarray_binary_scalar_to_dtype(lhs, rhs);
+    } else if(rhs == &rscalar) {
+        ndarray_binary_scalar_to_dtype(rhs, lhs);
+    }
+    #endif
     if(op == MP_BINARY_OP_REVERSE_ADD) {
         op = MP_BINARY_OP_ADD;
     } else if(op == MP_BINARY_OP_REVERSE_MULTIPLY) {
@@ -1696,9 +2438,9 @@ mp_obj_t ndarray_binary_op(mp_binary_op_t _op, mp_obj_t lobj, mp_obj_t robj) {
     }
 
     uint8_t ndim = 0;
-    size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
-    int32_t *lstrides = m_new0(int32_t, ULAB_MAX_DIMS);
-    int32_t *rstrides = m_new0(int32_t, ULAB_MAX_DIMS);
+    size_t shape[ULAB_MAX_DIMS] = { 0 };
+    int32_t lstrides[ULAB_MAX_DIMS] = { 0 };
+    int32_t rstrides[ULAB_MAX_DIMS] = { 0 };
     uint8_t broadcastable;
     if((op == MP_BINARY_OP_INPLACE_ADD) || (op == MP_BINARY_OP_INPLACE_MULTIPLY) || (op == MP_BINARY_OP_INPLACE_POWER) ||
         (op == MP_BINARY_OP_INPLACE_SUBTRACT) || (op == MP_BINARY_OP_INPLACE_TRUE_DIVIDE)) {
@@ -1708,12 +2450,8 @@ mp_obj_t ndarray_binary_op(mp_binary_op_t _op, mp_obj_t lobj, mp_obj_t robj) {
     }
     if(!broadcastable) {
         mp_raise_ValueError(MP_ERROR_TEXT("operands could not be broadcast together"));
-        m_del(size_t, shape, ULAB_MAX_DIMS);
-        m_del(int32_t, lstrides, ULAB_MAX_DIMS);
-        m_del(int32_t, rstrides, ULAB_MAX_DIMS);
     }
     // the empty arrays have to be treated separately
-    uint8_t dtype = NDARRAY_INT16;
     ndarray_obj_t *nd;
     if((lhs->len == 0) || (rhs->len == 0)) {
         switch(op) {
@@ -1723,19 +2461,7 @@ mp_obj_t ndarray_binary_op(mp_binary_op_t _op, mp_obj_t lobj, mp_obj_t robj) {
             case MP_BINARY_OP_ADD:
             case MP_BINARY_OP_MULTIPLY:
             case MP_BINARY_OP_SUBTRACT:
-                // here we don't have to list those cases that result in an int16,
-                // because dtype is initialised with that NDARRAY_INT16
-                if(lhs->dtype == rhs->dtype) {
-                    dtype = rhs->dtype;
-                } else if((lhs->dtype == NDARRAY_FLOAT) || (rhs->dtype == NDARRAY_FLOAT)) {
-                    dtype = NDARRAY_FLOAT;
-                } else if(((lhs->dtype == NDARRAY_UINT8) && (rhs->dtype == NDARRAY_UINT16)) ||
-                            ((lhs->dtype == NDARRAY_INT8) && (rhs->dtype == NDARRAY_UINT16)) ||
-                            ((rhs->dtype == NDARRAY_UINT8) && (lhs->dtype == NDARRAY_UINT16)) ||
-                            ((rhs->dtype == NDARRAY_INT8) && (lhs->dtype == NDARRAY_UINT16))) {
-                    dtype = NDARRAY_UINT16;
-                }
-                return MP_OBJ_FROM_PTR(ndarray_new_linear_array(0, dtype));
+                return MP_OBJ_FROM_PTR(ndarray_new_linear_array(0, ndarray_upcast_dtype(lhs->dtype, rhs->dtype)));
                 break;
 
             case MP_BINARY_OP_INPLACE_POWER:
@@ -1761,6 +2487,96 @@ mp_obj_t ndarray_binary_op(mp_binary_op_t _op, mp_obj_t lobj, mp_obj_t robj) {
         }
     }
 
+    #if ULAB_HAS_GENERIC_DTYPES
+    if(ULAB_DTYPE_IS_GENERIC(lhs->dtype) || ULAB_DTYPE_IS_GENERIC(rhs->dtype)) {
+        // the operators are subject to the same switches, as in the case of the other dtypes
+        switch(op) {
+            #if NDARRAY_HAS_INPLACE_ADD
+            case MP_BINARY_OP_INPLACE_ADD:
+                return ndarray_inplace_generic(lhs, rhs, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_INPLACE_MULTIPLY
+            case MP_BINARY_OP_INPLACE_MULTIPLY:
+                return ndarray_inplace_generic(lhs, rhs, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_INPLACE_POWER
+            case MP_BINARY_OP_INPLACE_POWER:
+                return ndarray_inplace_generic(lhs, rhs, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_INPLACE_SUBTRACT
+            case MP_BINARY_OP_INPLACE_SUBTRACT:
+                return ndarray_inplace_generic(lhs, rhs, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_INPLACE_TRUE_DIVIDE
+            case MP_BINARY_OP_INPLACE_TRUE_DIVIDE:
+                return ndarray_inplace_generic(lhs, rhs, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_BINARY_OP_LESS
+            case MP_BINARY_OP_LESS:
+                return ndarray_binary_generic(lhs, rhs, ndim, shape, lstrides, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_BINARY_OP_LESS_EQUAL
+            case MP_BINARY_OP_LESS_EQUAL:
+                return ndarray_binary_generic(lhs, rhs, ndim, shape, lstrides, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_BINARY_OP_MORE
+            case MP_BINARY_OP_MORE:
+                return ndarray_binary_generic(lhs, rhs, ndim, shape, lstrides, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_BINARY_OP_MORE_EQUAL
+            case MP_BINARY_OP_MORE_EQUAL:
+                return ndarray_binary_generic(lhs, rhs, ndim, shape, lstrides, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_BINARY_OP_EQUAL
+            case MP_BINARY_OP_EQUAL:
+                return ndarray_binary_generic(lhs, rhs, ndim, shape, lstrides, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_BINARY_OP_NOT_EQUAL
+            case MP_BINARY_OP_NOT_EQUAL:
+                return ndarray_binary_generic(lhs, rhs, ndim, shape, lstrides, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_BINARY_OP_ADD
+            case MP_BINARY_OP_ADD:
+                return ndarray_binary_generic(lhs, rhs, ndim, shape, lstrides, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_BINARY_OP_MULTIPLY
+            case MP_BINARY_OP_MULTIPLY:
+                return ndarray_binary_generic(lhs, rhs, ndim, shape, lstrides, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_BINARY_OP_SUBTRACT
+            case MP_BINARY_OP_SUBTRACT:
+                return ndarray_binary_generic(lhs, rhs, ndim, shape, lstrides, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_BINARY_OP_TRUE_DIVIDE
+            case MP_BINARY_OP_TRUE_DIVIDE:
+                return ndarray_binary_generic(lhs, rhs, ndim, shape, lstrides, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_BINARY_OP_POWER
+            case MP_BINARY_OP_POWER:
+                return ndarray_binary_generic(lhs, rhs, ndim, shape, lstrides, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_BINARY_OP_OR
+            case MP_BINARY_OP_OR:
+                return ndarray_binary_generic(lhs, rhs, ndim, shape, lstrides, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_BINARY_OP_XOR
+            case MP_BINARY_OP_XOR:
+                return ndarray_binary_generic(lhs, rhs, ndim, shape, lstrides, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_BINARY_OP_AND
+            case MP_BINARY_OP_AND:
+                return ndarray_binary_generic(lhs, rhs, ndim, shape, lstrides, rstrides, op);
+            #endif
+            #if NDARRAY_HAS_BINARY_OP_FLOOR_DIVIDE
+            case MP_BINARY_OP_FLOOR_DIVIDE:
+                return ndarray_binary_generic(lhs, rhs, ndim, shape, lstrides, rstrides, op);
+            #endif
+            default:
+                return MP_OBJ_NULL; // op not supported
+        }
+    }
+    #endif
+
     switch(op) {
         // first the in-place operators
         #if NDARRAY_HAS_INPLACE_ADD
@@ -1893,18 +2709,27 @@ mp_obj_t ndarray_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
             } else {
             #endif
                 ndarray = ndarray_copy_view(self);
-                // if Boolean, NDARRAY_UINT8, or NDARRAY_UINT16, there is nothing to do
-                if(self->dtype == NDARRAY_INT8) {
+                // if Boolean, or of one of the unsigned types, there is nothing to do
+                if(ULAB_DTYPE_IS(self->dtype, INT8)) {
                     int8_t *array = (int8_t *)ndarray->array;
                     for(size_t i=0; i < self->len; i++, array++) {
                         if(*array < 0) *array = -(*array);
                     }
-                } else if(self->dtype == NDARRAY_INT16) {
+                } else if(ULAB_DTYPE_IS(self->dtype, INT16)) {
                     int16_t *array = (int16_t *)ndarray->array;
                     for(size_t i=0; i < self->len; i++, array++) {
                         if(*array < 0) *array = -(*array);
                     }
-                } else {
+                } else if(ULAB_DTYPE_IS(self->dtype, INT32)) {
+                    int32_t *array = (int32_t *)ndarray->array;
+                    for(size_t i=0; i < self->len; i++, array++) {
+                        if(*array < 0) *array = (int32_t)(0U - (uint32_t)*array);
+                    }
+                } else if(ULAB_DTYPE_IS(self->dtype, FLOAT16)) {
+                    // clear the sign bit
+                    uint16_t *array = (uint16_t *)ndarray->array;
+                    for(size_t i=0; i < self->len; i++, array++) *array &= 0x7fff;
+                } else if(self->dtype == NDARRAY_FLOAT) {
                     mp_float_t *array = (mp_float_t *)ndarray->array;
                     for(size_t i=0; i < self->len; i++, array++) {
                         if(*array < 0) *array = -(*array);
@@ -1919,9 +2744,9 @@ mp_obj_t ndarray_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
         #if NDARRAY_HAS_UNARY_OP_INVERT
         case MP_UNARY_OP_INVERT:
             #if ULAB_SUPPORTS_COMPLEX
-            if(self->dtype == NDARRAY_FLOAT || self->dtype == NDARRAY_COMPLEX) {
+            if(ULAB_DTYPE_IS_FLOAT(self->dtype) || self->dtype == NDARRAY_COMPLEX) {
             #else
-            if(self->dtype == NDARRAY_FLOAT) {
+            if(ULAB_DTYPE_IS_FLOAT(self->dtype)) {
             #endif
                 mp_raise_ValueError(MP_ERROR_TEXT("operation is not supported for given type"));
             }
@@ -1948,15 +2773,22 @@ mp_obj_t ndarray_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
             if(self->dtype == NDARRAY_UINT8) {
                 uint8_t *array = (uint8_t *)ndarray->array;
                 for(size_t i=0; i < self->len; i++, array++) *array = -(*array);
-            } else if(self->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(self->dtype, INT8)) {
                 int8_t *array = (int8_t *)ndarray->array;
                 for(size_t i=0; i < self->len; i++, array++) *array = -(*array);
             } else if(self->dtype == NDARRAY_UINT16) {
                 uint16_t *array = (uint16_t *)ndarray->array;
                 for(size_t i=0; i < self->len; i++, array++) *array = -(*array);
-            } else if(self->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(self->dtype, INT16)) {
                 int16_t *array = (int16_t *)ndarray->array;
                 for(size_t i=0; i < self->len; i++, array++) *array = -(*array);
+            } else if(ULAB_DTYPE_IS(self->dtype, INT32) || ULAB_DTYPE_IS(self->dtype, UINT32)) {
+                uint32_t *array = (uint32_t *)ndarray->array;
+                for(size_t i=0; i < self->len; i++, array++) *array = 0U - *array;
+            } else if(ULAB_DTYPE_IS(self->dtype, FLOAT16)) {
+                // flip the sign bit
+                uint16_t *array = (uint16_t *)ndarray->array;
+                for(size_t i=0; i < self->len; i++, array++) *array ^= 0x8000;
             } else {
                 mp_float_t *array = (mp_float_t *)ndarray->array;
                 size_t len = self->len;
@@ -1992,14 +2824,13 @@ mp_obj_t ndarray_transpose(mp_obj_t self_in) {
     if(self->ndim == 1) {
         return self_in;
     }
-    size_t *shape = m_new(size_t, self->ndim);
-    int32_t *strides = m_new(int32_t, self->ndim);
+    size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
+    int32_t *strides = m_new0(int32_t, ULAB_MAX_DIMS);
     for(uint8_t i=0; i < self->ndim; i++) {
         shape[ULAB_MAX_DIMS - 1 - i] = self->shape[ULAB_MAX_DIMS - self->ndim + i];
         strides[ULAB_MAX_DIMS - 1 - i] = self->strides[ULAB_MAX_DIMS - self->ndim + i];
     }
-    // TODO: I am not sure ndarray_new_view is OK here...
-    // should be deep copy...
+    // the transpose is always a view: only the order of shape and strides is reversed
     ndarray_obj_t *ndarray = ndarray_new_view(self, self->ndim, shape, strides, 0);
     return MP_OBJ_FROM_PTR(ndarray);
 }
@@ -2060,6 +2891,7 @@ mp_obj_t ndarray_reshape_core(mp_obj_t oin, mp_obj_t _shape, bool inplace) {
     if(ndarray_is_dense(source)) {
         int32_t *new_strides = strides_from_shape(new_shape, source->dtype);
         if(inplace) {
+            source->ndim = shape->len;
             for(uint8_t i = 0; i < ULAB_MAX_DIMS; i++) {
                 source->shape[i] = new_shape[i];
                 source->strides[i] = new_strides[i];
@@ -2069,6 +2901,21 @@ mp_obj_t ndarray_reshape_core(mp_obj_t oin, mp_obj_t _shape, bool inplace) {
             ndarray = ndarray_new_view(source, shape->len, new_shape, new_strides, 0);
         }
     } else {
+        // a view is still possible, if the sliced axes are not merged with others,
+        // e.g., if only the leading axis is sliced, or a contiguous axis is split
+        int32_t *new_strides = m_new0(int32_t, ULAB_MAX_DIMS);
+        if(ndarray_view_strides(source, shape->len, new_shape, new_strides)) {
+            if(inplace) {
+                source->ndim = shape->len;
+                for(uint8_t i = 0; i < ULAB_MAX_DIMS; i++) {
+                    source->shape[i] = new_shape[i];
+                    source->strides[i] = new_strides[i];
+                }
+                return MP_OBJ_FROM_PTR(oin);
+            }
+            return MP_OBJ_FROM_PTR(ndarray_new_view(source, shape->len, new_shape, new_strides, 0));
+        }
+        m_del(int32_t, new_strides, ULAB_MAX_DIMS);
         if(inplace) {
             mp_raise_ValueError(MP_ERROR_TEXT("cannot assign new shape"));
         }
@@ -2120,12 +2967,18 @@ mp_obj_t ndarray_info(mp_obj_t obj_in) {
         mp_printf(MP_PYTHON_PRINTER, "bool\n");
     } else if(ndarray->dtype == NDARRAY_UINT8) {
         mp_printf(MP_PYTHON_PRINTER, "uint8\n");
-    } else if(ndarray->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(ndarray->dtype, INT8)) {
         mp_printf(MP_PYTHON_PRINTER, "int8\n");
     } else if(ndarray->dtype == NDARRAY_UINT16) {
         mp_printf(MP_PYTHON_PRINTER, "uint16\n");
-    } else if(ndarray->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(ndarray->dtype, INT16)) {
         mp_printf(MP_PYTHON_PRINTER, "int16\n");
+    } else if(ULAB_DTYPE_IS(ndarray->dtype, INT32)) {
+        mp_printf(MP_PYTHON_PRINTER, "int32\n");
+    } else if(ULAB_DTYPE_IS(ndarray->dtype, UINT32)) {
+        mp_printf(MP_PYTHON_PRINTER, "uint32\n");
+    } else if(ULAB_DTYPE_IS(ndarray->dtype, FLOAT16)) {
+        mp_printf(MP_PYTHON_PRINTER, "float16\n");
     } else if(ndarray->dtype == NDARRAY_FLOAT) {
         mp_printf(MP_PYTHON_PRINTER, "float\n");
     }
@@ -19,6 +19,7 @@
 #include "py/objlist.h"
 
 #include "ulab.h"
+#include "ulab_memory.h"
 
 #ifndef MP_PI
 #define MP_PI MICROPY_FLOAT_CONST(3.14159265358979323846)
@@ -111,7 +112,14 @@ typedef struct _mp_obj_slice_t {
 #endif
 #endif
 
+#if ULAB_SUPPORTS_FLOAT16
+// mp_binary_get_val_array, and mp_binary_set_val_array don't know about half-precision floats
+mp_obj_t ndarray_get_value(char , void *, size_t );
+void ndarray_set_value(char , void *, size_t , mp_obj_t );
+#else
+#define ndarray_get_value(a, b, c) mp_binary_get_val_array(a, b, c)
 #define ndarray_set_value(a, b, c, d) mp_binary_set_val_array(a, b, c, d)
+#endif
 void ndarray_set_complex_value(void *, size_t , mp_obj_t );
 
 #define NDARRAY_NUMERIC   0
@@ -128,12 +136,42 @@ enum NDARRAY_TYPE {
     NDARRAY_INT8 = 'b',
     NDARRAY_UINT16 = 'H',
     NDARRAY_INT16 = 'h',
+    NDARRAY_INT32 = 'i',
+    NDARRAY_UINT32 = 'I',
+    NDARRAY_FLOAT16 = 'e',
     #if ULAB_SUPPORTS_COMPLEX
         NDARRAY_COMPLEX = 'c',
     #endif
     NDARRAY_FLOAT = FLOAT_TYPECODE,
 };
 
+// Compares the dtype to one of the optional types. The comparison is false at compile time,
+// if the type has been excluded from the firmware, so that the branch is eliminated.
+#define ULAB_DTYPE_IS(dtype, type)          (ULAB_SUPPORTS_##type && ((dtype) == NDARRAY_##type))
+
+// the dtype of integer sequences, e.g., of arange with integer arguments
+#define NDARRAY_INT_DEFAULT                 (ULAB_SUPPORTS_INT16 ? NDARRAY_INT16 : NDARRAY_FLOAT)
+
+// false for the dtypes that have been excluded from the firmware
+#define ULAB_DTYPE_IS_SUPPORTED(dtype)      ((ULAB_SUPPORTS_INT8 || ((dtype) != NDARRAY_INT8)) &&\
+                                            (ULAB_SUPPORTS_INT16 || ((dtype) != NDARRAY_INT16)) &&\
+                                            (ULAB_SUPPORTS_INT32 || (((dtype) != NDARRAY_INT32) && ((dtype) != NDARRAY_UINT32))) &&\
+                                            (ULAB_SUPPORTS_FLOAT16 || ((dtype) != NDARRAY_FLOAT16)))
+
+// the dtypes that the operators handle in the generic kernels in ndarray_operators.c
+#define ULAB_DTYPE_IS_GENERIC(dtype)        (ULAB_DTYPE_IS(dtype, INT32) || ULAB_DTYPE_IS(dtype, UINT32) ||\
+                                            ULAB_DTYPE_IS(dtype, FLOAT16))
+
+// the real floating point dtypes
+#define ULAB_DTYPE_IS_FLOAT(dtype)          (((dtype) == NDARRAY_FLOAT) || ULAB_DTYPE_IS(dtype, FLOAT16))
+
+// raises a TypeError in the functions that have not been taught the generic dtypes
+#if ULAB_HAS_GENERIC_DTYPES
+#define GENERIC_DTYPE_NOT_IMPLEMENTED(dtype)    if(ULAB_DTYPE_IS_GENERIC(dtype)) mp_raise_TypeError(MP_ERROR_TEXT("function is not implemented for this dtype"));
+#else
+#define GENERIC_DTYPE_NOT_IMPLEMENTED(dtype)    // do nothing
+#endif
+
 typedef struct _ndarray_obj_t {
     mp_obj_base_t base;
     uint8_t dtype;
@@ -188,10 +226,13 @@ int32_t *ndarray_contract_strides(ndarray_obj_t *, uint8_t );
 ndarray_obj_t *ndarray_from_iterable(mp_obj_t , uint8_t );
 ndarray_obj_t *ndarray_new_dense_ndarray(uint8_t , size_t *, uint8_t );
 ndarray_obj_t *ndarray_new_ndarray_from_tuple(mp_obj_tuple_t *, uint8_t );
+ndarray_obj_t *ndarray_new_ndarray_with_memory(uint8_t , size_t *, int32_t *, uint8_t , uint8_t );
 ndarray_obj_t *ndarray_new_ndarray(uint8_t , size_t *, int32_t *, uint8_t );
 ndarray_obj_t *ndarray_new_linear_array(size_t , uint8_t );
 ndarray_obj_t *ndarray_new_view(ndarray_obj_t *, uint8_t , size_t *, int32_t *, int32_t );
+bool ndarray_view_strides(ndarray_obj_t *, uint8_t , size_t *, int32_t *);
 bool ndarray_is_dense(ndarray_obj_t *);
+bool ndarray_is_contiguous(ndarray_obj_t *);
 ndarray_obj_t *ndarray_copy_view(ndarray_obj_t *);
 ndarray_obj_t *ndarray_copy_view_convert_type(ndarray_obj_t *, uint8_t );
 void ndarray_copy_array(ndarray_obj_t *, ndarray_obj_t *, uint8_t );
@@ -199,6 +240,20 @@ void ndarray_copy_array(ndarray_obj_t *, ndarray_obj_t *, uint8_t );
 MP_DECLARE_CONST_FUN_OBJ_KW(ndarray_array_constructor_obj);
 mp_obj_t ndarray_make_new(const mp_obj_type_t *, size_t , size_t , const mp_obj_t *);
 mp_obj_t ndarray_subscr(mp_obj_t , mp_obj_t , mp_obj_t );
+
+// out-of-range integer indices raise an IndexError, wrap around, or are clipped to the axis
+enum NDARRAY_INDEX_MODE {
+    NDARRAY_INDEX_RAISE,
+    NDARRAY_INDEX_WRAP,
+    NDARRAY_INDEX_CLIP,
+};
+
+#if NDARRAY_IS_SLICEABLE || ULAB_NUMPY_HAS_TAKE
+mp_obj_t ndarray_take(ndarray_obj_t *, mp_obj_t , mp_obj_t , uint8_t );
+#endif
+#if ULAB_NUMPY_HAS_PUT
+void ndarray_put(ndarray_obj_t *, mp_obj_t , mp_obj_t , uint8_t );
+#endif
 mp_obj_t ndarray_getiter(mp_obj_t , mp_obj_iter_buf_t *);
 bool ndarray_can_broadcast(ndarray_obj_t *, ndarray_obj_t *, uint8_t *, size_t *, int32_t *, int32_t *);
 bool ndarray_can_broadcast_inplace(ndarray_obj_t *, ndarray_obj_t *, int32_t *);
@@ -224,6 +279,11 @@ mp_obj_t ndarray_flatten(size_t , const mp_obj_t *, mp_map_t *);
 MP_DECLARE_CONST_FUN_OBJ_KW(ndarray_flatten_obj);
 #endif
 
+#if NDARRAY_HAS_RAVEL
+mp_obj_t ndarray_ravel(size_t , const mp_obj_t *, mp_map_t *);
+MP_DECLARE_CONST_FUN_OBJ_KW(ndarray_ravel_obj);
+#endif
+
 #if NDARRAY_HAS_DTYPE
 mp_obj_t ndarray_dtype(mp_obj_t );
 #endif
@@ -251,8 +311,13 @@ MP_DECLARE_CONST_FUN_OBJ_2(ndarray_reshape_obj);
 #endif
 
 #if NDARRAY_HAS_TOBYTES
-mp_obj_t ndarray_tobytes(mp_obj_t );
-MP_DECLARE_CONST_FUN_OBJ_1(ndarray_tobytes_obj);
+mp_obj_t ndarray_tobytes(size_t , const mp_obj_t *, mp_map_t *);
+MP_DECLARE_CONST_FUN_OBJ_KW(ndarray_tobytes_obj);
+#endif
+
+#if NDARRAY_HAS_TOFILE
+mp_obj_t ndarray_tofile(mp_obj_t , mp_obj_t );
+MP_DECLARE_CONST_FUN_OBJ_2(ndarray_tofile_obj);
 #endif
 
 #if NDARRAY_HAS_TOLIST
@@ -278,13 +343,10 @@ ndarray_obj_t *ndarray_from_mp_obj(mp_obj_t , uint8_t );
 
 #define BOOLEAN_ASSIGNMENT_LOOP(type_left, type_right, ndarray, lstrides, iarray, istride, varray, vstride)\
     type_left *array = (type_left *)(ndarray)->array;\
-    for(size_t i=0; i < (ndarray)->len; i++) {\
-        if(*(iarray)) {\
-            *array = (type_left)(*((type_right *)(varray)));\
-            (varray) += (vstride);\
-        }\
-        array += (lstrides);\
-        (iarray) += (istride);\
+    for(size_t i = tools_next_true((iarray), (istride), 0, (ndarray)->len); i < (ndarray)->len;\
+        i = tools_next_true((iarray), (istride), i + 1, (ndarray)->len)) {\
+        array[(ptrdiff_t)i * (lstrides)] = (type_left)(*((type_right *)(varray)));\
+        (varray) += (vstride);\
     } while(0)
 
 #if ULAB_HAS_FUNCTION_ITERATOR
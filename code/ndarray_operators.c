@@ -17,6 +17,8 @@
 #include "ndarray_operators.h"
 #include "ulab.h"
 #include "ulab_tools.h"
+#include "ulab_simd.h"
+#include "ulab_parallel.h"
 #include "numpy/carray/carray.h"
 
 /*
@@ -35,8 +37,189 @@
     int8 + int16 => int16
     int8 + uint16 => uint16
     uint16 + int16 => float
+
+    The int32, uint32, and float16 dtypes are handled by the generic kernels at the end of the file.
 */
 
+static bool ndarray_binary_operand_is_dense(ndarray_obj_t *ndarray, uint8_t ndim, size_t *shape) {
+    // returns true, if the operand is a single-element array (i.e., a scalar),
+    // or if it is contiguous, and has the shape of the result; ndarray_is_dense checks
+    // the first stride only, and would accept, e.g., a[:, ::-1]
+    if(ndarray->len == 1) {
+        return true;
+    }
+    if(ndarray->ndim != ndim) {
+        return false;
+    }
+    for(uint8_t i = ULAB_MAX_DIMS; i > ULAB_MAX_DIMS - ndim; i--) {
+        if(ndarray->shape[i - 1] != shape[i - 1]) {
+            return false;
+        }
+    }
+    return ndarray_is_contiguous(ndarray);
+}
+
+bool ndarray_binary_operands_are_dense(ndarray_obj_t *lhs, ndarray_obj_t *rhs, uint8_t ndim, size_t *shape) {
+    // returns true, if the operands are of the same type, and the binary operator
+    // can be evaluated in a single flat loop without broadcasting
+    if(lhs->dtype != rhs->dtype) {
+        return false;
+    }
+    return ndarray_binary_operand_is_dense(lhs, ndim, shape) && ndarray_binary_operand_is_dense(rhs, ndim, shape);
+}
+
+#if ULAB_HAS_SIMD & (NDARRAY_HAS_BINARY_OP_EQUAL | NDARRAY_HAS_BINARY_OP_NOT_EQUAL | NDARRAY_HAS_BINARY_OP_MORE |\
+    NDARRAY_HAS_BINARY_OP_MORE_EQUAL | NDARRAY_HAS_BINARY_OP_LESS | NDARRAY_HAS_BINARY_OP_LESS_EQUAL)
+static mp_obj_t ndarray_binary_simd_comparison(ndarray_obj_t *lhs, ndarray_obj_t *rhs, uint8_t ndim, size_t *shape, uint8_t op) {
+    // returns the Boolean results of the comparison, if the operands can be handed to
+    // the vector kernels, and MP_OBJ_NULL otherwise
+    if(!ULAB_SIMD_SUPPORTS_DTYPE(lhs->dtype) || !ndarray_binary_operands_are_dense(lhs, rhs, ndim, shape)) {
+        return MP_OBJ_NULL;
+    }
+    ndarray_obj_t *results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT8);
+    results->boolean = 1;
+    ulab_simd_binary(lhs->dtype, op, ULAB_SIMD_LAYOUT(lhs, rhs), results->array, lhs->array, rhs->array, results->len);
+    return MP_OBJ_FROM_PTR(results);
+}
+#endif /* ULAB_HAS_SIMD */
+
+#if NDARRAY_BINARY_HAS_DENSE_LOOP & (NDARRAY_HAS_BINARY_OP_ADD | NDARRAY_HAS_BINARY_OP_MULTIPLY | NDARRAY_HAS_BINARY_OP_SUBTRACT |\
+    NDARRAY_HAS_BINARY_OP_TRUE_DIVIDE | NDARRAY_HAS_BINARY_OP_OR | NDARRAY_HAS_BINARY_OP_XOR | NDARRAY_HAS_BINARY_OP_AND |\
+    NDARRAY_HAS_BINARY_OP_EQUAL | NDARRAY_HAS_BINARY_OP_NOT_EQUAL | NDARRAY_HAS_BINARY_OP_MORE | NDARRAY_HAS_BINARY_OP_MORE_EQUAL |\
+    NDARRAY_HAS_BINARY_OP_LESS | NDARRAY_HAS_BINARY_OP_LESS_EQUAL)
+
+// the state of a dense binary operator; the scalar operands are not advanced
+typedef struct _ndarray_binary_dense_t {
+    uint8_t *array;
+    uint8_t *larray;
+    uint8_t *rarray;
+    mp_binary_op_t op;
+    // the dtype, and the size of the operands, and the size of the results,
+    // which are different for the comparisons
+    uint8_t dtype;
+    uint8_t itemsize;
+    uint8_t ritemsize;
+    uint8_t layout;
+} ndarray_binary_dense_t;
+
+// runs the loop of the layout of the operands, i.e., with a scalar on the right, or on the left hand side, or without scalars
+#define DENSE_BINARY_LAYOUT(UNWRAP, dense, array, larray, rarray, len, OPERATOR)\
+({\
+    if((dense)->layout == ULAB_SIMD_RSCALAR) {\
+        UNWRAP((dense)->dtype, (array), (larray), (rarray), (len), OPERATOR, DENSE_BINARY_LOOP_RSCALAR);\
+    } else if((dense)->layout == ULAB_SIMD_LSCALAR) {\
+        UNWRAP((dense)->dtype, (array), (larray), (rarray), (len), OPERATOR, DENSE_BINARY_LOOP_LSCALAR);\
+    } else {\
+        UNWRAP((dense)->dtype, (array), (larray), (rarray), (len), OPERATOR, DENSE_BINARY_LOOP);\
+    }\
+})
+
+static void ndarray_binary_dense_kernel(void *context, size_t start, size_t end, uint8_t core) {
+    (void)core;
+    ndarray_binary_dense_t *dense = (ndarray_binary_dense_t *)context;
+    size_t len = end - start;
+    uint8_t *array = dense->array + start * dense->ritemsize;
+    uint8_t *larray = dense->larray + (dense->layout == ULAB_SIMD_LSCALAR ? 0 : start * dense->itemsize);
+    uint8_t *rarray = dense->rarray + (dense->layout == ULAB_SIMD_RSCALAR ? 0 : start * dense->itemsize);
+    mp_binary_op_t op = dense->op;
+
+    #if ULAB_HAS_SIMD
+    // the comparisons have already been offered to the vector kernels by the caller
+    if((op == MP_BINARY_OP_ADD) || (op == MP_BINARY_OP_MULTIPLY) || (op == MP_BINARY_OP_SUBTRACT)) {
+        uint8_t simd_op = op == MP_BINARY_OP_ADD ? ULAB_SIMD_ADD : (op == MP_BINARY_OP_MULTIPLY ? ULAB_SIMD_MULTIPLY : ULAB_SIMD_SUBTRACT);
+        if(ulab_simd_binary(dense->dtype, simd_op, dense->layout, array, larray, rarray, len)) {
+            return;
+        }
+    }
+    #endif
+
+    switch(op) {
+        #if NDARRAY_HAS_BINARY_OP_ADD
+        case MP_BINARY_OP_ADD:
+            DENSE_BINARY_LAYOUT(UNWRAP_DENSE_BINARY_LOOP, dense, array, larray, rarray, len, +);
+            break;
+        #endif
+        #if NDARRAY_HAS_BINARY_OP_MULTIPLY
+        case MP_BINARY_OP_MULTIPLY:
+            DENSE_BINARY_LAYOUT(UNWRAP_DENSE_BINARY_LOOP, dense, array, larray, rarray, len, *);
+            break;
+        #endif
+        #if NDARRAY_HAS_BINARY_OP_SUBTRACT
+        case MP_BINARY_OP_SUBTRACT:
+            DENSE_BINARY_LAYOUT(UNWRAP_DENSE_BINARY_LOOP, dense, array, larray, rarray, len, -);
+            break;
+        #endif
+        #if NDARRAY_HAS_BINARY_OP_TRUE_DIVIDE
+        case MP_BINARY_OP_TRUE_DIVIDE:
+            DENSE_BINARY_LAYOUT(UNWRAP_DENSE_FLOAT_LOOP, dense, array, larray, rarray, len, /);
+            break;
+        #endif
+        #if NDARRAY_HAS_BINARY_OP_OR
+        case MP_BINARY_OP_OR:
+            DENSE_BINARY_LAYOUT(UNWRAP_DENSE_INTEGER_LOOP, dense, array, larray, rarray, len, |);
+            break;
+        #endif
+        #if NDARRAY_HAS_BINARY_OP_XOR
+        case MP_BINARY_OP_XOR:
+            DENSE_BINARY_LAYOUT(UNWRAP_DENSE_INTEGER_LOOP, dense, array, larray, rarray, len, ^);
+            break;
+        #endif
+        #if NDARRAY_HAS_BINARY_OP_AND
+        case MP_BINARY_OP_AND:
+            DENSE_BINARY_LAYOUT(UNWRAP_DENSE_INTEGER_LOOP, dense, array, larray, rarray, len, &);
+            break;
+        #endif
+        #if NDARRAY_HAS_BINARY_OP_EQUAL
+        case MP_BINARY_OP_EQUAL:
+            DENSE_BINARY_LAYOUT(UNWRAP_DENSE_COMPARISON_LOOP, dense, array, larray, rarray, len, ==);
+            break;
+        #endif
+        #if NDARRAY_HAS_BINARY_OP_NOT_EQUAL
+        case MP_BINARY_OP_NOT_EQUAL:
+            DENSE_BINARY_LAYOUT(UNWRAP_DENSE_COMPARISON_LOOP, dense, array, larray, rarray, len, !=);
+            break;
+        #endif
+        #if NDARRAY_HAS_BINARY_OP_MORE | NDARRAY_HAS_BINARY_OP_LESS
+        case MP_BINARY_OP_MORE:
+            DENSE_BINARY_LAYOUT(UNWRAP_DENSE_COMPARISON_LOOP, dense, array, larray, rarray, len, >);
+            break;
+        #endif
+        #if NDARRAY_HAS_BINARY_OP_MORE_EQUAL | NDARRAY_HAS_BINARY_OP_LESS_EQUAL
+        case MP_BINARY_OP_MORE_EQUAL:
+            DENSE_BINARY_LAYOUT(UNWRAP_DENSE_COMPARISON_LOOP, dense, array, larray, rarray, len, >=);
+            break;
+        #endif
+        default:
+            break;
+    }
+}
+
+static mp_obj_t ndarray_binary_dense_loop(ndarray_obj_t *lhs, ndarray_obj_t *rhs, uint8_t ndim, size_t *shape, mp_binary_op_t op) {
+    // both operands are dense, and of identical dtype, hence, the result has the same dtype, too,
+    // except for the comparisons, whose results are Booleans
+    bool comparison = (op == MP_BINARY_OP_EQUAL) || (op == MP_BINARY_OP_NOT_EQUAL) ||
+                    (op == MP_BINARY_OP_MORE) || (op == MP_BINARY_OP_MORE_EQUAL);
+    ndarray_obj_t *results = ndarray_new_dense_ndarray(ndim, shape, comparison ? NDARRAY_UINT8 : lhs->dtype);
+    if(comparison) {
+        results->boolean = 1;
+    } else if((op == MP_BINARY_OP_OR) || (op == MP_BINARY_OP_XOR) || (op == MP_BINARY_OP_AND)) {
+        results->boolean = lhs->boolean & rhs->boolean;
+    }
+    ndarray_binary_dense_t dense = {
+        .array = (uint8_t *)results->array,
+        .larray = (uint8_t *)lhs->array,
+        .rarray = (uint8_t *)rhs->array,
+        .op = op,
+        .dtype = lhs->dtype,
+        .itemsize = lhs->itemsize,
+        .ritemsize = results->itemsize,
+        .layout = ULAB_SIMD_LAYOUT(lhs, rhs),
+    };
+    ulab_parallel_for(ndarray_binary_dense_kernel, &dense, results->len, 1);
+    return MP_OBJ_FROM_PTR(results);
+}
+#endif /* NDARRAY_BINARY_HAS_DENSE_LOOP */
+
 #if NDARRAY_HAS_BINARY_OP_EQUAL | NDARRAY_HAS_BINARY_OP_NOT_EQUAL
 mp_obj_t ndarray_binary_equality(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
                                             uint8_t ndim, size_t *shape,  int32_t *lstrides, int32_t *rstrides, mp_binary_op_t op) {
@@ -47,6 +230,19 @@ mp_obj_t ndarray_binary_equality(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
     }
     #endif
 
+    #if ULAB_HAS_SIMD
+    mp_obj_t simd_results = ndarray_binary_simd_comparison(lhs, rhs, ndim, shape, op == MP_BINARY_OP_EQUAL ? ULAB_SIMD_EQUAL : ULAB_SIMD_NOT_EQUAL);
+    if(simd_results != MP_OBJ_NULL) {
+        return simd_results;
+    }
+    #endif
+
+    #if NDARRAY_BINARY_HAS_DENSE_LOOP
+    if(ndarray_binary_operands_are_dense(lhs, rhs, ndim, shape)) {
+        return ndarray_binary_dense_loop(lhs, rhs, ndim, shape, op);
+    }
+    #endif
+
     ndarray_obj_t *results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT8);
     results->boolean = 1;
     uint8_t *array = (uint8_t *)results->array;
@@ -58,21 +254,21 @@ mp_obj_t ndarray_binary_equality(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(lhs->dtype == NDARRAY_UINT8) {
             if(rhs->dtype == NDARRAY_UINT8) {
                 EQUALITY_LOOP(results, array, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, ==);
-            } else if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                 EQUALITY_LOOP(results, array, uint8_t, int8_t, larray, lstrides, rarray, rstrides, ==);
             } else if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, ==);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, uint8_t, int16_t, larray, lstrides, rarray, rstrides, ==);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, uint8_t, mp_float_t, larray, lstrides, rarray, rstrides, ==);
             }
-        } else if(lhs->dtype == NDARRAY_INT8) {
-            if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
+            if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                 EQUALITY_LOOP(results, array, int8_t, int8_t, larray, lstrides, rarray, rstrides, ==);
             } else if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, int8_t, uint16_t, larray, lstrides, rarray, rstrides, ==);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, int8_t, int16_t, larray, lstrides, rarray, rstrides, ==);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, int8_t, mp_float_t, larray, lstrides, rarray, rstrides, ==);
@@ -82,15 +278,15 @@ mp_obj_t ndarray_binary_equality(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         } else if(lhs->dtype == NDARRAY_UINT16) {
             if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, ==);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, uint16_t, int16_t, larray, lstrides, rarray, rstrides, ==);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, uint16_t, mp_float_t, larray, lstrides, rarray, rstrides, ==);
             } else {
                 return ndarray_binary_op(op, MP_OBJ_FROM_PTR(rhs), MP_OBJ_FROM_PTR(lhs));
             }
-        } else if(lhs->dtype == NDARRAY_INT16) {
-            if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
+            if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, int16_t, int16_t, larray, lstrides, rarray, rstrides, ==);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, int16_t, mp_float_t, larray, lstrides, rarray, rstrides, ==);
@@ -112,21 +308,21 @@ mp_obj_t ndarray_binary_equality(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(lhs->dtype == NDARRAY_UINT8) {
             if(rhs->dtype == NDARRAY_UINT8) {
                 EQUALITY_LOOP(results, array, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, !=);
-            } else if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                 EQUALITY_LOOP(results, array, uint8_t, int8_t, larray, lstrides, rarray, rstrides, !=);
             } else if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, !=);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, uint8_t, int16_t, larray, lstrides, rarray, rstrides, !=);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, uint8_t, mp_float_t, larray, lstrides, rarray, rstrides, !=);
             }
-        } else if(lhs->dtype == NDARRAY_INT8) {
-            if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
+            if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                 EQUALITY_LOOP(results, array, int8_t, int8_t, larray, lstrides, rarray, rstrides, !=);
             } else if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, int8_t, uint16_t, larray, lstrides, rarray, rstrides, !=);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, int8_t, int16_t, larray, lstrides, rarray, rstrides, !=);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, int8_t, mp_float_t, larray, lstrides, rarray, rstrides, !=);
@@ -136,15 +332,15 @@ mp_obj_t ndarray_binary_equality(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         } else if(lhs->dtype == NDARRAY_UINT16) {
             if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, !=);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, uint16_t, int16_t, larray, lstrides, rarray, rstrides, !=);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, uint16_t, mp_float_t, larray, lstrides, rarray, rstrides, !=);
             } else {
                 return ndarray_binary_op(op, MP_OBJ_FROM_PTR(rhs), MP_OBJ_FROM_PTR(lhs));
             }
-        } else if(lhs->dtype == NDARRAY_INT16) {
-            if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
+            if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, int16_t, int16_t, larray, lstrides, rarray, rstrides, !=);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, int16_t, mp_float_t, larray, lstrides, rarray, rstrides, !=);
@@ -175,6 +371,12 @@ mp_obj_t ndarray_binary_add(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
     }
     #endif
 
+    #if NDARRAY_BINARY_HAS_DENSE_LOOP
+    if(ndarray_binary_operands_are_dense(lhs, rhs, ndim, shape)) {
+        return ndarray_binary_dense_loop(lhs, rhs, ndim, shape, MP_BINARY_OP_ADD);
+    }
+    #endif
+
     ndarray_obj_t *results = NULL;
     uint8_t *larray = (uint8_t *)lhs->array;
     uint8_t *rarray = (uint8_t *)rhs->array;
@@ -183,27 +385,27 @@ mp_obj_t ndarray_binary_add(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT8);
             BINARY_LOOP(results, uint8_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, +);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides, +);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, +);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides, +);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             BINARY_LOOP(results, mp_float_t, uint8_t, mp_float_t, larray, lstrides, rarray, rstrides, +);
         }
-    } else if(lhs->dtype == NDARRAY_INT8) {
-        if(rhs->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
+        if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT8);
             BINARY_LOOP(results, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, +);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int8_t, uint16_t, larray, lstrides, rarray, rstrides, +);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int8_t, int16_t, larray, lstrides, rarray, rstrides, +);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
@@ -216,7 +418,7 @@ mp_obj_t ndarray_binary_add(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, +);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             BINARY_LOOP(results, mp_float_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides, +);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
@@ -225,8 +427,8 @@ mp_obj_t ndarray_binary_add(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         } else {
             return ndarray_binary_op(MP_BINARY_OP_ADD, MP_OBJ_FROM_PTR(rhs), MP_OBJ_FROM_PTR(lhs));
         }
-    } else if(lhs->dtype == NDARRAY_INT16) {
-        if(rhs->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
+        if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int16_t, int16_t, larray, lstrides, rarray, rstrides, +);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
@@ -258,6 +460,12 @@ mp_obj_t ndarray_binary_multiply(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
     }
     #endif
 
+    #if NDARRAY_BINARY_HAS_DENSE_LOOP
+    if(ndarray_binary_operands_are_dense(lhs, rhs, ndim, shape)) {
+        return ndarray_binary_dense_loop(lhs, rhs, ndim, shape, MP_BINARY_OP_MULTIPLY);
+    }
+    #endif
+
     ndarray_obj_t *results = NULL;
     uint8_t *larray = (uint8_t *)lhs->array;
     uint8_t *rarray = (uint8_t *)rhs->array;
@@ -266,27 +474,27 @@ mp_obj_t ndarray_binary_multiply(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT8);
             BINARY_LOOP(results, uint8_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, *);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides, *);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, *);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides, *);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             BINARY_LOOP(results, mp_float_t, uint8_t, mp_float_t, larray, lstrides, rarray, rstrides, *);
         }
-    } else if(lhs->dtype == NDARRAY_INT8) {
-        if(rhs->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
+        if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT8);
             BINARY_LOOP(results, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, *);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int8_t, uint16_t, larray, lstrides, rarray, rstrides, *);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int8_t, int16_t, larray, lstrides, rarray, rstrides, *);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
@@ -299,7 +507,7 @@ mp_obj_t ndarray_binary_multiply(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, *);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             BINARY_LOOP(results, mp_float_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides, *);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
@@ -308,8 +516,8 @@ mp_obj_t ndarray_binary_multiply(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         } else {
             return ndarray_binary_op(MP_BINARY_OP_MULTIPLY, MP_OBJ_FROM_PTR(rhs), MP_OBJ_FROM_PTR(lhs));
         }
-    } else if(lhs->dtype == NDARRAY_INT16) {
-        if(rhs->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
+        if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int16_t, int16_t, larray, lstrides, rarray, rstrides, *);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
@@ -335,6 +543,19 @@ mp_obj_t ndarray_binary_multiply(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
 mp_obj_t ndarray_binary_more(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
                                             uint8_t ndim, size_t *shape, int32_t *lstrides, int32_t *rstrides, mp_binary_op_t op) {
 
+    #if ULAB_HAS_SIMD
+    mp_obj_t simd_results = ndarray_binary_simd_comparison(lhs, rhs, ndim, shape, op == MP_BINARY_OP_MORE ? ULAB_SIMD_MORE : ULAB_SIMD_MORE_EQUAL);
+    if(simd_results != MP_OBJ_NULL) {
+        return simd_results;
+    }
+    #endif
+
+    #if NDARRAY_BINARY_HAS_DENSE_LOOP
+    if(ndarray_binary_operands_are_dense(lhs, rhs, ndim, shape)) {
+        return ndarray_binary_dense_loop(lhs, rhs, ndim, shape, op);
+    }
+    #endif
+
     ndarray_obj_t *results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT8);
     results->boolean = 1;
     uint8_t *array = (uint8_t *)results->array;
@@ -346,23 +567,23 @@ mp_obj_t ndarray_binary_more(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(lhs->dtype == NDARRAY_UINT8) {
             if(rhs->dtype == NDARRAY_UINT8) {
                 EQUALITY_LOOP(results, array, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, >);
-            } else if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                 EQUALITY_LOOP(results, array, uint8_t, int8_t, larray, lstrides, rarray, rstrides, >);
             } else if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, >);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, uint8_t, int16_t, larray, lstrides, rarray, rstrides, >);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, uint8_t, mp_float_t, larray, lstrides, rarray, rstrides, >);
             }
-        } else if(lhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
             if(rhs->dtype == NDARRAY_UINT8) {
                 EQUALITY_LOOP(results, array, int8_t, uint8_t, larray, lstrides, rarray, rstrides, >);
-            } else if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                 EQUALITY_LOOP(results, array, int8_t, int8_t, larray, lstrides, rarray, rstrides, >);
             } else if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, int8_t, uint16_t, larray, lstrides, rarray, rstrides, >);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, int8_t, int16_t, larray, lstrides, rarray, rstrides, >);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, int8_t, mp_float_t, larray, lstrides, rarray, rstrides, >);
@@ -370,23 +591,23 @@ mp_obj_t ndarray_binary_more(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         } else if(lhs->dtype == NDARRAY_UINT16) {
             if(rhs->dtype == NDARRAY_UINT8) {
                 EQUALITY_LOOP(results, array, uint16_t, uint8_t, larray, lstrides, rarray, rstrides, >);
-            } else if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                 EQUALITY_LOOP(results, array, uint16_t, int8_t, larray, lstrides, rarray, rstrides, >);
             } else if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, >);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, uint16_t, int16_t, larray, lstrides, rarray, rstrides, >);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, uint16_t, mp_float_t, larray, lstrides, rarray, rstrides, >);
             }
-        } else if(lhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
             if(rhs->dtype == NDARRAY_UINT8) {
                 EQUALITY_LOOP(results, array, int16_t, uint8_t, larray, lstrides, rarray, rstrides, >);
-            } else if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                 EQUALITY_LOOP(results, array, int16_t, int8_t, larray, lstrides, rarray, rstrides, >);
             } else if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, int16_t, uint16_t, larray, lstrides, rarray, rstrides, >);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, int16_t, int16_t, larray, lstrides, rarray, rstrides, >);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, uint16_t, mp_float_t, larray, lstrides, rarray, rstrides, >);
@@ -394,11 +615,11 @@ mp_obj_t ndarray_binary_more(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         } else if(lhs->dtype == NDARRAY_FLOAT) {
             if(rhs->dtype == NDARRAY_UINT8) {
                 EQUALITY_LOOP(results, array, mp_float_t, uint8_t, larray, lstrides, rarray, rstrides, >);
-            } else if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                 EQUALITY_LOOP(results, array, mp_float_t, int8_t, larray, lstrides, rarray, rstrides, >);
             } else if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, mp_float_t, uint16_t, larray, lstrides, rarray, rstrides, >);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, mp_float_t, int16_t, larray, lstrides, rarray, rstrides, >);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, mp_float_t, mp_float_t, larray, lstrides, rarray, rstrides, >);
@@ -411,23 +632,23 @@ mp_obj_t ndarray_binary_more(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(lhs->dtype == NDARRAY_UINT8) {
             if(rhs->dtype == NDARRAY_UINT8) {
                 EQUALITY_LOOP(results, array, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, >=);
-            } else if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                 EQUALITY_LOOP(results, array, uint8_t, int8_t, larray, lstrides, rarray, rstrides, >=);
             } else if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, >=);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, uint8_t, int16_t, larray, lstrides, rarray, rstrides, >=);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, uint8_t, mp_float_t, larray, lstrides, rarray, rstrides, >=);
             }
-        } else if(lhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
             if(rhs->dtype == NDARRAY_UINT8) {
                 EQUALITY_LOOP(results, array, int8_t, uint8_t, larray, lstrides, rarray, rstrides, >=);
-            } else if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                 EQUALITY_LOOP(results, array, int8_t, int8_t, larray, lstrides, rarray, rstrides, >=);
             } else if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, int8_t, uint16_t, larray, lstrides, rarray, rstrides, >=);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, int8_t, int16_t, larray, lstrides, rarray, rstrides, >=);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, int8_t, mp_float_t, larray, lstrides, rarray, rstrides, >=);
@@ -435,23 +656,23 @@ mp_obj_t ndarray_binary_more(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         } else if(lhs->dtype == NDARRAY_UINT16) {
             if(rhs->dtype == NDARRAY_UINT8) {
                 EQUALITY_LOOP(results, array, uint16_t, uint8_t, larray, lstrides, rarray, rstrides, >=);
-            } else if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                 EQUALITY_LOOP(results, array, uint16_t, int8_t, larray, lstrides, rarray, rstrides, >=);
             } else if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, >=);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, uint16_t, int16_t, larray, lstrides, rarray, rstrides, >=);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, uint16_t, mp_float_t, larray, lstrides, rarray, rstrides, >=);
             }
-        } else if(lhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
             if(rhs->dtype == NDARRAY_UINT8) {
                 EQUALITY_LOOP(results, array, int16_t, uint8_t, larray, lstrides, rarray, rstrides, >=);
-            } else if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                 EQUALITY_LOOP(results, array, int16_t, int8_t, larray, lstrides, rarray, rstrides, >=);
             } else if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, int16_t, uint16_t, larray, lstrides, rarray, rstrides, >=);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, int16_t, int16_t, larray, lstrides, rarray, rstrides, >=);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, uint16_t, mp_float_t, larray, lstrides, rarray, rstrides, >=);
@@ -459,11 +680,11 @@ mp_obj_t ndarray_binary_more(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         } else if(lhs->dtype == NDARRAY_FLOAT) {
             if(rhs->dtype == NDARRAY_UINT8) {
                 EQUALITY_LOOP(results, array, mp_float_t, uint8_t, larray, lstrides, rarray, rstrides, >=);
-            } else if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                 EQUALITY_LOOP(results, array, mp_float_t, int8_t, larray, lstrides, rarray, rstrides, >=);
             } else if(rhs->dtype == NDARRAY_UINT16) {
                 EQUALITY_LOOP(results, array, mp_float_t, uint16_t, larray, lstrides, rarray, rstrides, >=);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 EQUALITY_LOOP(results, array, mp_float_t, int16_t, larray, lstrides, rarray, rstrides, >=);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 EQUALITY_LOOP(results, array, mp_float_t, mp_float_t, larray, lstrides, rarray, rstrides, >=);
@@ -486,6 +707,12 @@ mp_obj_t ndarray_binary_subtract(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
     }
     #endif
 
+    #if NDARRAY_BINARY_HAS_DENSE_LOOP
+    if(ndarray_binary_operands_are_dense(lhs, rhs, ndim, shape)) {
+        return ndarray_binary_dense_loop(lhs, rhs, ndim, shape, MP_BINARY_OP_SUBTRACT);
+    }
+    #endif
+
     ndarray_obj_t *results = NULL;
     uint8_t *larray = (uint8_t *)lhs->array;
     uint8_t *rarray = (uint8_t *)rhs->array;
@@ -494,30 +721,30 @@ mp_obj_t ndarray_binary_subtract(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT8);
             BINARY_LOOP(results, uint8_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, -);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides, -);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, -);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides, -);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             BINARY_LOOP(results, mp_float_t, uint8_t, mp_float_t, larray, lstrides, rarray, rstrides, -);
         }
-    } else if(lhs->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int8_t, uint8_t, larray, lstrides, rarray, rstrides, -);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT8);
             BINARY_LOOP(results, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, -);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int8_t, uint16_t, larray, lstrides, rarray, rstrides, -);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int8_t, int16_t, larray, lstrides, rarray, rstrides, -);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
@@ -528,30 +755,30 @@ mp_obj_t ndarray_binary_subtract(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint16_t, uint8_t, larray, lstrides, rarray, rstrides, -);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint16_t, int8_t, larray, lstrides, rarray, rstrides, -);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, -);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             BINARY_LOOP(results, mp_float_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides, -);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             BINARY_LOOP(results, mp_float_t, uint16_t, mp_float_t, larray, lstrides, rarray, rstrides, -);
         }
-    } else if(lhs->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int16_t, uint8_t, larray, lstrides, rarray, rstrides, -);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int16_t, int8_t, larray, lstrides, rarray, rstrides, -);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             BINARY_LOOP(results, mp_float_t, int16_t, uint16_t, larray, lstrides, rarray, rstrides, -);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int16_t, int16_t, larray, lstrides, rarray, rstrides, -);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
@@ -562,13 +789,13 @@ mp_obj_t ndarray_binary_subtract(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             BINARY_LOOP(results, mp_float_t, mp_float_t, uint8_t, larray, lstrides, rarray, rstrides, -);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             BINARY_LOOP(results, mp_float_t, mp_float_t, int8_t, larray, lstrides, rarray, rstrides, -);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             BINARY_LOOP(results, mp_float_t, mp_float_t, uint16_t, larray, lstrides, rarray, rstrides, -);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             BINARY_LOOP(results, mp_float_t, mp_float_t, int16_t, larray, lstrides, rarray, rstrides, -);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
@@ -591,6 +818,12 @@ mp_obj_t ndarray_binary_true_divide(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
     }
     #endif
 
+    #if NDARRAY_BINARY_HAS_DENSE_LOOP
+    if((lhs->dtype == NDARRAY_FLOAT) && ndarray_binary_operands_are_dense(lhs, rhs, ndim, shape)) {
+        return ndarray_binary_dense_loop(lhs, rhs, ndim, shape, MP_BINARY_OP_TRUE_DIVIDE);
+    }
+    #endif
+
     ndarray_obj_t *results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
     uint8_t *larray = (uint8_t *)lhs->array;
     uint8_t *rarray = (uint8_t *)rhs->array;
@@ -609,23 +842,23 @@ mp_obj_t ndarray_binary_true_divide(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
     if(lhs->dtype == NDARRAY_UINT8) {
         if(rhs->dtype == NDARRAY_UINT8) {
             BINARY_LOOP(results, mp_float_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, /);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             BINARY_LOOP(results, mp_float_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides, /);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             BINARY_LOOP(results, mp_float_t, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, /);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             BINARY_LOOP(results, mp_float_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides, /);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             BINARY_LOOP(results, mp_float_t, uint8_t, mp_float_t, larray, lstrides, rarray, rstrides, /);
         }
-    } else if(lhs->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
         if(rhs->dtype == NDARRAY_UINT8) {
             BINARY_LOOP(results, mp_float_t, int8_t, uint8_t, larray, lstrides, rarray, rstrides, /);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             BINARY_LOOP(results, mp_float_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, /);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             BINARY_LOOP(results, mp_float_t, int8_t, uint16_t, larray, lstrides, rarray, rstrides, /);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             BINARY_LOOP(results, mp_float_t, int8_t, int16_t, larray, lstrides, rarray, rstrides, /);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             BINARY_LOOP(results, mp_float_t, int8_t, mp_float_t, larray, lstrides, rarray, rstrides, /);
@@ -633,23 +866,23 @@ mp_obj_t ndarray_binary_true_divide(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
     } else if(lhs->dtype == NDARRAY_UINT16) {
         if(rhs->dtype == NDARRAY_UINT8) {
             BINARY_LOOP(results, mp_float_t, uint16_t, uint8_t, larray, lstrides, rarray, rstrides, /);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             BINARY_LOOP(results, mp_float_t, uint16_t, int8_t, larray, lstrides, rarray, rstrides, /);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             BINARY_LOOP(results, mp_float_t, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, /);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             BINARY_LOOP(results, mp_float_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides, /);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             BINARY_LOOP(results, mp_float_t, uint16_t, mp_float_t, larray, lstrides, rarray, rstrides, /);
         }
-    } else if(lhs->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
         if(rhs->dtype == NDARRAY_UINT8) {
             BINARY_LOOP(results, mp_float_t, int16_t, uint8_t, larray, lstrides, rarray, rstrides, /);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             BINARY_LOOP(results, mp_float_t, int16_t, int8_t, larray, lstrides, rarray, rstrides, /);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             BINARY_LOOP(results, mp_float_t, int16_t, uint16_t, larray, lstrides, rarray, rstrides, /);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             BINARY_LOOP(results, mp_float_t, int16_t, int16_t, larray, lstrides, rarray, rstrides, /);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             BINARY_LOOP(results, mp_float_t, int16_t, mp_float_t, larray, lstrides, rarray, rstrides, /);
@@ -657,11 +890,11 @@ mp_obj_t ndarray_binary_true_divide(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
     } else if(lhs->dtype == NDARRAY_FLOAT) {
         if(rhs->dtype == NDARRAY_UINT8) {
             BINARY_LOOP(results, mp_float_t, mp_float_t, uint8_t, larray, lstrides, rarray, rstrides, /);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             BINARY_LOOP(results, mp_float_t, mp_float_t, int8_t, larray, lstrides, rarray, rstrides, /);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             BINARY_LOOP(results, mp_float_t, mp_float_t, uint16_t, larray, lstrides, rarray, rstrides, /);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             BINARY_LOOP(results, mp_float_t, mp_float_t, int16_t, larray, lstrides, rarray, rstrides, /);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             BINARY_LOOP(results, mp_float_t, mp_float_t, mp_float_t, larray, lstrides, rarray, rstrides, /);
@@ -685,30 +918,30 @@ mp_obj_t ndarray_binary_floor_divide(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT8);
             FLOOR_DIVIDE_LOOP_UINT(results, uint8_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             FLOOR_DIVIDE_LOOP(results, int16_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             FLOOR_DIVIDE_LOOP_UINT(results, uint16_t, uint8_t, uint16_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             FLOOR_DIVIDE_LOOP(results, int16_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             FLOOR_DIVIDE_LOOP_FLOAT(results, mp_float_t, uint8_t, mp_float_t, larray, lstrides, rarray, rstrides);
         }
-    } else if(lhs->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             FLOOR_DIVIDE_LOOP(results, int16_t, int8_t, uint8_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT8);
             FLOOR_DIVIDE_LOOP(results, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             FLOOR_DIVIDE_LOOP(results, uint16_t, int8_t, uint16_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             FLOOR_DIVIDE_LOOP(results, int16_t, int8_t, int16_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
@@ -719,30 +952,30 @@ mp_obj_t ndarray_binary_floor_divide(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             FLOOR_DIVIDE_LOOP_UINT(results, uint16_t, uint16_t, uint8_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             FLOOR_DIVIDE_LOOP(results, uint16_t, uint16_t, int8_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             FLOOR_DIVIDE_LOOP_UINT(results, uint16_t, uint16_t, uint16_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             FLOOR_DIVIDE_LOOP_FLOAT(results, mp_float_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             FLOOR_DIVIDE_LOOP_FLOAT(results, mp_float_t, uint16_t, mp_float_t, larray, lstrides, rarray, rstrides);
         }
-    } else if(lhs->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             FLOOR_DIVIDE_LOOP(results, int16_t, int16_t, uint8_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             FLOOR_DIVIDE_LOOP(results, int16_t, int16_t, int8_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
             FLOOR_DIVIDE_LOOP_FLOAT(results, mp_float_t, int16_t, uint16_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             FLOOR_DIVIDE_LOOP(results, int16_t, int16_t, int16_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
@@ -753,11 +986,11 @@ mp_obj_t ndarray_binary_floor_divide(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
         if(rhs->dtype == NDARRAY_UINT8) {
             FLOOR_DIVIDE_LOOP_FLOAT(results, mp_float_t, mp_float_t, uint8_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             FLOOR_DIVIDE_LOOP_FLOAT(results, mp_float_t, mp_float_t, int8_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             FLOOR_DIVIDE_LOOP_FLOAT(results, mp_float_t, mp_float_t, uint16_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             FLOOR_DIVIDE_LOOP_FLOAT(results, mp_float_t, mp_float_t, int16_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             FLOOR_DIVIDE_LOOP_FLOAT(results, mp_float_t, mp_float_t, mp_float_t, larray, lstrides, rarray, rstrides);
@@ -793,23 +1026,23 @@ mp_obj_t ndarray_binary_power(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
     if(lhs->dtype == NDARRAY_UINT8) {
         if(rhs->dtype == NDARRAY_UINT8) {
             POWER_LOOP(results, mp_float_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             POWER_LOOP(results, mp_float_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             POWER_LOOP(results, mp_float_t, uint8_t, uint16_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             POWER_LOOP(results, mp_float_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             POWER_LOOP(results, mp_float_t, uint8_t, mp_float_t, larray, lstrides, rarray, rstrides);
         }
-    } else if(lhs->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
         if(rhs->dtype == NDARRAY_UINT8) {
             POWER_LOOP(results, mp_float_t, int8_t, uint8_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             POWER_LOOP(results, mp_float_t, int8_t, int8_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             POWER_LOOP(results, mp_float_t, int8_t, uint16_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             POWER_LOOP(results, mp_float_t, int8_t, int16_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             POWER_LOOP(results, mp_float_t, int8_t, mp_float_t, larray, lstrides, rarray, rstrides);
@@ -817,23 +1050,23 @@ mp_obj_t ndarray_binary_power(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
     } else if(lhs->dtype == NDARRAY_UINT16) {
         if(rhs->dtype == NDARRAY_UINT8) {
             POWER_LOOP(results, mp_float_t, uint16_t, uint8_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             POWER_LOOP(results, mp_float_t, uint16_t, int8_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             POWER_LOOP(results, mp_float_t, uint16_t, uint16_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             POWER_LOOP(results, mp_float_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             POWER_LOOP(results, mp_float_t, uint16_t, mp_float_t, larray, lstrides, rarray, rstrides);
         }
-    } else if(lhs->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
         if(rhs->dtype == NDARRAY_UINT8) {
             POWER_LOOP(results, mp_float_t, int16_t, uint8_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             POWER_LOOP(results, mp_float_t, int16_t, int8_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             POWER_LOOP(results, mp_float_t, int16_t, uint16_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             POWER_LOOP(results, mp_float_t, int16_t, int16_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             POWER_LOOP(results, mp_float_t, uint16_t, mp_float_t, larray, lstrides, rarray, rstrides);
@@ -841,11 +1074,11 @@ mp_obj_t ndarray_binary_power(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
     } else if(lhs->dtype == NDARRAY_FLOAT) {
         if(rhs->dtype == NDARRAY_UINT8) {
             POWER_LOOP(results, mp_float_t, mp_float_t, uint8_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             POWER_LOOP(results, mp_float_t, mp_float_t, int8_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             POWER_LOOP(results, mp_float_t, mp_float_t, uint16_t, larray, lstrides, rarray, rstrides);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             POWER_LOOP(results, mp_float_t, mp_float_t, int16_t, larray, lstrides, rarray, rstrides);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
             POWER_LOOP(results, mp_float_t, mp_float_t, mp_float_t, larray, lstrides, rarray, rstrides);
@@ -873,11 +1106,17 @@ mp_obj_t ndarray_binary_logical(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
 
     // bail out, if both inputs are of 16-bit types, but differ in sign;
     // numpy promotes the result to int32
-    if(((lhs->dtype == NDARRAY_INT16) && (rhs->dtype == NDARRAY_UINT16)) || 
-        ((lhs->dtype == NDARRAY_UINT16) && (rhs->dtype == NDARRAY_INT16))) {
+    if((ULAB_DTYPE_IS(lhs->dtype, INT16) && (rhs->dtype == NDARRAY_UINT16)) || 
+        ((lhs->dtype == NDARRAY_UINT16) && ULAB_DTYPE_IS(rhs->dtype, INT16))) {
         mp_raise_TypeError(MP_ERROR_TEXT("dtype of int32 is not supported"));
     }
 
+    #if NDARRAY_BINARY_HAS_DENSE_LOOP
+    if(ndarray_binary_operands_are_dense(lhs, rhs, ndim, shape)) {
+        return ndarray_binary_dense_loop(lhs, rhs, ndim, shape, op);
+    }
+    #endif
+
     ndarray_obj_t *results = NULL;
     uint8_t *larray = (uint8_t *)lhs->array;
     uint8_t *rarray = (uint8_t *)rhs->array;
@@ -892,24 +1131,24 @@ mp_obj_t ndarray_binary_logical(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
                         results->boolean = 1;
                     }
                     BINARY_LOOP(results, uint8_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, ^);
-                } else if(rhs->dtype == NDARRAY_INT8) {
+                } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
                     BINARY_LOOP(results, int16_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides, ^);
                 } else if(rhs->dtype == NDARRAY_UINT16) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
                     BINARY_LOOP(results, uint16_t, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, ^);
-                } else if(rhs->dtype == NDARRAY_INT16) {
+                } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
                     BINARY_LOOP(results, int16_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides, ^);
                 }
-            } else if(lhs->dtype == NDARRAY_INT8) {
-                if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
+                if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT8);
                     BINARY_LOOP(results, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, ^);
                 } else if(rhs->dtype == NDARRAY_UINT16) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
                     BINARY_LOOP(results, int16_t, int8_t, uint16_t, larray, lstrides, rarray, rstrides, ^);
-                } else if(rhs->dtype == NDARRAY_INT16) {
+                } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
                     BINARY_LOOP(results, int16_t, int8_t, int16_t, larray, lstrides, rarray, rstrides, ^);
                 } else {
@@ -919,14 +1158,14 @@ mp_obj_t ndarray_binary_logical(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
                 if(rhs->dtype == NDARRAY_UINT16) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
                     BINARY_LOOP(results, uint16_t, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, ^);
-                } else if(rhs->dtype == NDARRAY_INT16) {
+                } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
                     BINARY_LOOP(results, mp_float_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides, ^);
                 } else {
                     return ndarray_binary_op(MP_BINARY_OP_XOR, MP_OBJ_FROM_PTR(rhs), MP_OBJ_FROM_PTR(lhs));
                 }
-            } else if(lhs->dtype == NDARRAY_INT16) {
-                if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
+                if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
                     BINARY_LOOP(results, int16_t, int16_t, int16_t, larray, lstrides, rarray, rstrides, ^);
                 } else {
@@ -943,24 +1182,24 @@ mp_obj_t ndarray_binary_logical(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
                         results->boolean = 1;
                     }
                     BINARY_LOOP(results, uint8_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, |);
-                } else if(rhs->dtype == NDARRAY_INT8) {
+                } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
                     BINARY_LOOP(results, int16_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides, |);
                 } else if(rhs->dtype == NDARRAY_UINT16) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
                     BINARY_LOOP(results, uint16_t, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, |);
-                } else if(rhs->dtype == NDARRAY_INT16) {
+                } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
                     BINARY_LOOP(results, int16_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides, |);
                 }
-            } else if(lhs->dtype == NDARRAY_INT8) {
-                if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
+                if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT8);
                     BINARY_LOOP(results, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, |);
                 } else if(rhs->dtype == NDARRAY_UINT16) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
                     BINARY_LOOP(results, int16_t, int8_t, uint16_t, larray, lstrides, rarray, rstrides, |);
-                } else if(rhs->dtype == NDARRAY_INT16) {
+                } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
                     BINARY_LOOP(results, int16_t, int8_t, int16_t, larray, lstrides, rarray, rstrides, |);
                 } else {
@@ -970,14 +1209,14 @@ mp_obj_t ndarray_binary_logical(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
                 if(rhs->dtype == NDARRAY_UINT16) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
                     BINARY_LOOP(results, uint16_t, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, |);
-                } else if(rhs->dtype == NDARRAY_INT16) {
+                } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
                     BINARY_LOOP(results, mp_float_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides, |);
                 } else {
                     return ndarray_binary_op(MP_BINARY_OP_OR, MP_OBJ_FROM_PTR(rhs), MP_OBJ_FROM_PTR(lhs));
                 }
-            } else if(lhs->dtype == NDARRAY_INT16) {
-                if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
+                if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
                     BINARY_LOOP(results, int16_t, int16_t, int16_t, larray, lstrides, rarray, rstrides, |);
                 } else {
@@ -994,24 +1233,24 @@ mp_obj_t ndarray_binary_logical(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
                         results->boolean = 1;
                     }
                     BINARY_LOOP(results, uint8_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, &);
-                } else if(rhs->dtype == NDARRAY_INT8) {
+                } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
                     BINARY_LOOP(results, int16_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides, &);
                 } else if(rhs->dtype == NDARRAY_UINT16) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
                     BINARY_LOOP(results, uint16_t, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, &);
-                } else if(rhs->dtype == NDARRAY_INT16) {
+                } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
                     BINARY_LOOP(results, int16_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides, &);
                 }
-            } else if(lhs->dtype == NDARRAY_INT8) {
-                if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
+                if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT8);
                     BINARY_LOOP(results, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, &);
                 } else if(rhs->dtype == NDARRAY_UINT16) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
                     BINARY_LOOP(results, int16_t, int8_t, uint16_t, larray, lstrides, rarray, rstrides, &);
-                } else if(rhs->dtype == NDARRAY_INT16) {
+                } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
                     BINARY_LOOP(results, int16_t, int8_t, int16_t, larray, lstrides, rarray, rstrides, &);
                 } else {
@@ -1021,14 +1260,14 @@ mp_obj_t ndarray_binary_logical(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
                 if(rhs->dtype == NDARRAY_UINT16) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
                     BINARY_LOOP(results, uint16_t, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, &);
-                } else if(rhs->dtype == NDARRAY_INT16) {
+                } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
                     BINARY_LOOP(results, mp_float_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides, &);
                 } else {
                     return ndarray_binary_op(MP_BINARY_OP_AND, MP_OBJ_FROM_PTR(rhs), MP_OBJ_FROM_PTR(lhs));
                 }
-            } else if(lhs->dtype == NDARRAY_INT16) {
-                if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
+                if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                     results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
                     BINARY_LOOP(results, int16_t, int16_t, int16_t, larray, lstrides, rarray, rstrides, &);
                 } else {
@@ -1085,11 +1324,11 @@ mp_obj_t ndarray_inplace_divide(ndarray_obj_t *lhs, ndarray_obj_t *rhs, int32_t
 
     if(rhs->dtype == NDARRAY_UINT8) {
         INPLACE_LOOP(lhs, mp_float_t, uint8_t, larray, rarray, rstrides, /=);
-    } else if(rhs->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
         INPLACE_LOOP(lhs, mp_float_t, int8_t, larray, rarray, rstrides, /=);
     } else if(rhs->dtype == NDARRAY_UINT16) {
         INPLACE_LOOP(lhs, mp_float_t, uint16_t, larray, rarray, rstrides, /=);
-    } else if(rhs->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
         INPLACE_LOOP(lhs, mp_float_t, int16_t, larray, rarray, rstrides, /=);
     } else if(lhs->dtype == NDARRAY_FLOAT) {
         INPLACE_LOOP(lhs, mp_float_t, mp_float_t, larray, rarray, rstrides, /=);
@@ -1109,11 +1348,11 @@ mp_obj_t ndarray_inplace_power(ndarray_obj_t *lhs, ndarray_obj_t *rhs, int32_t *
 
     if(rhs->dtype == NDARRAY_UINT8) {
         INPLACE_POWER(lhs, mp_float_t, uint8_t, larray, rarray, rstrides);
-    } else if(rhs->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
         INPLACE_POWER(lhs, mp_float_t, int8_t, larray, rarray, rstrides);
     } else if(rhs->dtype == NDARRAY_UINT16) {
         INPLACE_POWER(lhs, mp_float_t, uint16_t, larray, rarray, rstrides);
-    } else if(rhs->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
         INPLACE_POWER(lhs, mp_float_t, int16_t, larray, rarray, rstrides);
     } else if(lhs->dtype == NDARRAY_FLOAT) {
         INPLACE_POWER(lhs, mp_float_t, mp_float_t, larray, rarray, rstrides);
@@ -1121,3 +1360,259 @@ mp_obj_t ndarray_inplace_power(ndarray_obj_t *lhs, ndarray_obj_t *rhs, int32_t *
     return MP_OBJ_FROM_PTR(lhs);
 }
 #endif /* NDARRAY_HAS_INPLACE_POWER */
+
+#if ULAB_HAS_GENERIC_DTYPES
+// The int32, uint32, and float16 dtypes are not spelt out in the typed loops above, since
+// they would multiply the number of branches. Instead, the operands are read, and the results
+// are written through function pointers, and the arithmetic is carried out either in int32_t,
+// if the result is an integer, or in mp_float_t. The integer results wrap around as in C.
+#define GENERIC_LOOP(type, results, array, ostrides, larray, lstrides, rarray, rstrides, OPERATION) do {\
+    size_t coords[ULAB_MAX_DIMS] = { 0 };\
+    for(size_t n = 0; n < (results)->len; n++) {\
+        type lvalue = get_lhs((larray));\
+        type rvalue = get_rhs((rarray));\
+        set_result((array), (OPERATION));\
+        for(uint8_t d = ULAB_MAX_DIMS; d > 0; d--) {\
+            (array) += (ostrides)[d - 1];\
+            (larray) += (lstrides)[d - 1];\
+            (rarray) += (rstrides)[d - 1];\
+            if(++coords[d - 1] < (results)->shape[d - 1]) {\
+                break;\
+            }\
+            (array) -= (ostrides)[d - 1] * (results)->shape[d - 1];\
+            (larray) -= (lstrides)[d - 1] * (results)->shape[d - 1];\
+            (rarray) -= (rstrides)[d - 1] * (results)->shape[d - 1];\
+            coords[d - 1] = 0;\
+        }\
+    }\
+} while(0)
+
+#if ULAB_SUPPORTS_INT32
+static int32_t ndarray_generic_floor_divide(int32_t a, int32_t b) {
+    // python semantics: the quotient is rounded towards negative infinity
+    if(b == 0) {
+        return 0;
+    }
+    if(b == -1) {
+        // avoids the overflow of INT32_MIN / -1
+        return (int32_t)(0U - (uint32_t)a);
+    }
+    int32_t q = a / b;
+    if(((a % b) != 0) && ((a < 0) != (b < 0))) {
+        q--;
+    }
+    return q;
+}
+
+static void ndarray_generic_integer(ndarray_obj_t *results, uint8_t *array, int32_t *ostrides, uint8_t *larray, uint8_t ldtype,
+                                    int32_t *lstrides, uint8_t *rarray, uint8_t rdtype, int32_t *rstrides, mp_binary_op_t op, bool is_unsigned) {
+    // the unsigned values are passed on as the bit patterns of int32_t
+    int32_t (*get_lhs)(void *) = ndarray_get_int32_function(ldtype);
+    int32_t (*get_rhs)(void *) = ndarray_get_int32_function(rdtype);
+    void (*set_result)(void *, int32_t ) = ndarray_set_int32_function(results->dtype);
+
+    switch(op) {
+        case MP_BINARY_OP_ADD:
+        case MP_BINARY_OP_INPLACE_ADD:
+            GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, (int32_t)((uint32_t)lvalue + (uint32_t)rvalue));
+            break;
+        case MP_BINARY_OP_SUBTRACT:
+        case MP_BINARY_OP_INPLACE_SUBTRACT:
+            GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, (int32_t)((uint32_t)lvalue - (uint32_t)rvalue));
+            break;
+        case MP_BINARY_OP_MULTIPLY:
+        case MP_BINARY_OP_INPLACE_MULTIPLY:
+            GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, (int32_t)((uint32_t)lvalue * (uint32_t)rvalue));
+            break;
+        case MP_BINARY_OP_FLOOR_DIVIDE:
+            if(is_unsigned) {
+                GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides,
+                        rvalue ? (int32_t)((uint32_t)lvalue / (uint32_t)rvalue) : 0);
+            } else {
+                GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, ndarray_generic_floor_divide(lvalue, rvalue));
+            }
+            break;
+        case MP_BINARY_OP_OR:
+            GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue | rvalue);
+            break;
+        case MP_BINARY_OP_XOR:
+            GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue ^ rvalue);
+            break;
+        case MP_BINARY_OP_AND:
+            GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue & rvalue);
+            break;
+        case MP_BINARY_OP_LESS:
+            if(is_unsigned) {
+                GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, (uint32_t)lvalue < (uint32_t)rvalue);
+            } else {
+                GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue < rvalue);
+            }
+            break;
+        case MP_BINARY_OP_LESS_EQUAL:
+            if(is_unsigned) {
+                GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, (uint32_t)lvalue <= (uint32_t)rvalue);
+            } else {
+                GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue <= rvalue);
+            }
+            break;
+        case MP_BINARY_OP_MORE:
+            if(is_unsigned) {
+                GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, (uint32_t)lvalue > (uint32_t)rvalue);
+            } else {
+                GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue > rvalue);
+            }
+            break;
+        case MP_BINARY_OP_MORE_EQUAL:
+            if(is_unsigned) {
+                GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, (uint32_t)lvalue >= (uint32_t)rvalue);
+            } else {
+                GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue >= rvalue);
+            }
+            break;
+        case MP_BINARY_OP_EQUAL:
+            GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue == rvalue);
+            break;
+        case MP_BINARY_OP_NOT_EQUAL:
+            GENERIC_LOOP(int32_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue != rvalue);
+            break;
+        default:
+            break;
+    }
+}
+#endif /* ULAB_SUPPORTS_INT32 */
+
+static void ndarray_generic_float(ndarray_obj_t *results, uint8_t *array, int32_t *ostrides, uint8_t *larray, uint8_t ldtype,
+                                    int32_t *lstrides, uint8_t *rarray, uint8_t rdtype, int32_t *rstrides, mp_binary_op_t op) {
+    mp_float_t (*get_lhs)(void *) = ndarray_get_float_function(ldtype);
+    mp_float_t (*get_rhs)(void *) = ndarray_get_float_function(rdtype);
+    void (*set_result)(void *, mp_float_t ) = ndarray_set_float_function(results->dtype);
+
+    switch(op) {
+        case MP_BINARY_OP_ADD:
+        case MP_BINARY_OP_INPLACE_ADD:
+            GENERIC_LOOP(mp_float_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue + rvalue);
+            break;
+        case MP_BINARY_OP_SUBTRACT:
+        case MP_BINARY_OP_INPLACE_SUBTRACT:
+            GENERIC_LOOP(mp_float_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue - rvalue);
+            break;
+        case MP_BINARY_OP_MULTIPLY:
+        case MP_BINARY_OP_INPLACE_MULTIPLY:
+            GENERIC_LOOP(mp_float_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue * rvalue);
+            break;
+        case MP_BINARY_OP_TRUE_DIVIDE:
+        case MP_BINARY_OP_INPLACE_TRUE_DIVIDE:
+            GENERIC_LOOP(mp_float_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue / rvalue);
+            break;
+        case MP_BINARY_OP_FLOOR_DIVIDE:
+            GENERIC_LOOP(mp_float_t, results, array, ostrides, larray, lstrides, rarray, rstrides, MICROPY_FLOAT_C_FUN(floor)(lvalue / rvalue));
+            break;
+        case MP_BINARY_OP_POWER:
+        case MP_BINARY_OP_INPLACE_POWER:
+            GENERIC_LOOP(mp_float_t, results, array, ostrides, larray, lstrides, rarray, rstrides, MICROPY_FLOAT_C_FUN(pow)(lvalue, rvalue));
+            break;
+        case MP_BINARY_OP_LESS:
+            GENERIC_LOOP(mp_float_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue < rvalue);
+            break;
+        case MP_BINARY_OP_LESS_EQUAL:
+            GENERIC_LOOP(mp_float_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue <= rvalue);
+            break;
+        case MP_BINARY_OP_MORE:
+            GENERIC_LOOP(mp_float_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue > rvalue);
+            break;
+        case MP_BINARY_OP_MORE_EQUAL:
+            GENERIC_LOOP(mp_float_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue >= rvalue);
+            break;
+        case MP_BINARY_OP_EQUAL:
+            GENERIC_LOOP(mp_float_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue == rvalue);
+            break;
+        case MP_BINARY_OP_NOT_EQUAL:
+            GENERIC_LOOP(mp_float_t, results, array, ostrides, larray, lstrides, rarray, rstrides, lvalue != rvalue);
+            break;
+        default:
+            break;
+    }
+}
+
+mp_obj_t ndarray_binary_generic(ndarray_obj_t *lhs, ndarray_obj_t *rhs, uint8_t ndim, size_t *shape,
+                                    int32_t *lstrides, int32_t *rstrides, mp_binary_op_t op) {
+    #if ULAB_SUPPORTS_COMPLEX
+    if((lhs->dtype == NDARRAY_COMPLEX) || (rhs->dtype == NDARRAY_COMPLEX)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("operation not supported for the input types"));
+    }
+    #endif
+    uint8_t dtype = ndarray_upcast_dtype(lhs->dtype, rhs->dtype);
+    bool integer = !ULAB_DTYPE_IS_FLOAT(dtype);
+    bool is_bool = false;
+
+    switch(op) {
+        case MP_BINARY_OP_TRUE_DIVIDE:
+        case MP_BINARY_OP_POWER:
+            dtype = NDARRAY_FLOAT;
+            integer = false;
+            break;
+        case MP_BINARY_OP_OR:
+        case MP_BINARY_OP_XOR:
+        case MP_BINARY_OP_AND:
+            if(!integer) {
+                mp_raise_TypeError(MP_ERROR_TEXT("operation not supported for the input types"));
+            }
+            break;
+        case MP_BINARY_OP_LESS:
+        case MP_BINARY_OP_LESS_EQUAL:
+        case MP_BINARY_OP_MORE:
+        case MP_BINARY_OP_MORE_EQUAL:
+        case MP_BINARY_OP_EQUAL:
+        case MP_BINARY_OP_NOT_EQUAL:
+            is_bool = true;
+            break;
+        default:
+            break;
+    }
+
+    ndarray_obj_t *results = ndarray_new_dense_ndarray(ndim, shape, is_bool ? NDARRAY_BOOL : dtype);
+    int32_t *ostrides = results->strides;
+    uint8_t *array = (uint8_t *)results->array;
+    uint8_t *larray = (uint8_t *)lhs->array;
+    uint8_t *rarray = (uint8_t *)rhs->array;
+
+    #if ULAB_SUPPORTS_INT32
+    if(integer) {
+        ndarray_generic_integer(results, array, ostrides, larray, lhs->dtype, lstrides, rarray, rhs->dtype, rstrides, op, dtype == NDARRAY_UINT32);
+        if((op == MP_BINARY_OP_OR) || (op == MP_BINARY_OP_XOR) || (op == MP_BINARY_OP_AND)) {
+            results->boolean = lhs->boolean & rhs->boolean;
+        }
+        return MP_OBJ_FROM_PTR(results);
+    }
+    #endif
+    ndarray_generic_float(results, array, ostrides, larray, lhs->dtype, lstrides, rarray, rhs->dtype, rstrides, op);
+    return MP_OBJ_FROM_PTR(results);
+}
+
+mp_obj_t ndarray_inplace_generic(ndarray_obj_t *lhs, ndarray_obj_t *rhs, int32_t *rstrides, mp_binary_op_t op) {
+    #if ULAB_SUPPORTS_COMPLEX
+    if((lhs->dtype == NDARRAY_COMPLEX) || (rhs->dtype == NDARRAY_COMPLEX)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("operation not supported for the input types"));
+    }
+    #endif
+    // the same casting rules apply as in ndarray_inplace_ams, ndarray_inplace_divide, and ndarray_inplace_power
+    if((op == MP_BINARY_OP_INPLACE_TRUE_DIVIDE) || (op == MP_BINARY_OP_INPLACE_POWER)) {
+        if(!ULAB_DTYPE_IS_FLOAT(lhs->dtype)) {
+            mp_raise_TypeError(MP_ERROR_TEXT("results cannot be cast to specified type"));
+        }
+    } else if(!ULAB_DTYPE_IS_FLOAT(lhs->dtype) && ULAB_DTYPE_IS_FLOAT(rhs->dtype)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("cannot cast output with casting rule"));
+    }
+    uint8_t *larray = (uint8_t *)lhs->array;
+    uint8_t *rarray = (uint8_t *)rhs->array;
+
+    #if ULAB_SUPPORTS_INT32
+    if(!ULAB_DTYPE_IS_FLOAT(lhs->dtype)) {
+        ndarray_generic_integer(lhs, larray, lhs->strides, larray, lhs->dtype, lhs->strides, rarray, rhs->dtype, rstrides, op, false);
+        return MP_OBJ_FROM_PTR(lhs);
+    }
+    #endif
+    ndarray_generic_float(lhs, larray, lhs->strides, larray, lhs->dtype, lhs->strides, rarray, rhs->dtype, rstrides, op);
+    return MP_OBJ_FROM_PTR(lhs);
+}
+#endif /* ULAB_HAS_GENERIC_DTYPES */
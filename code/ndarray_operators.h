@@ -10,6 +10,8 @@
 
 #include "ndarray.h"
 
+bool ndarray_binary_operands_are_dense(ndarray_obj_t *, ndarray_obj_t *, uint8_t , size_t *);
+
 mp_obj_t ndarray_binary_equality(ndarray_obj_t *, ndarray_obj_t *, uint8_t , size_t *,  int32_t *, int32_t *, mp_binary_op_t );
 mp_obj_t ndarray_binary_add(ndarray_obj_t *, ndarray_obj_t *, uint8_t , size_t *, int32_t *, int32_t *);
 mp_obj_t ndarray_binary_multiply(ndarray_obj_t *, ndarray_obj_t *, uint8_t , size_t *, int32_t *, int32_t *);
@@ -24,22 +26,114 @@ mp_obj_t ndarray_inplace_ams(ndarray_obj_t *, ndarray_obj_t *, int32_t *, uint8_
 mp_obj_t ndarray_inplace_power(ndarray_obj_t *, ndarray_obj_t *, int32_t *);
 mp_obj_t ndarray_inplace_divide(ndarray_obj_t *, ndarray_obj_t *, int32_t *);
 
+#if ULAB_HAS_GENERIC_DTYPES
+mp_obj_t ndarray_binary_generic(ndarray_obj_t *, ndarray_obj_t *, uint8_t , size_t *, int32_t *, int32_t *, mp_binary_op_t );
+mp_obj_t ndarray_inplace_generic(ndarray_obj_t *, ndarray_obj_t *, int32_t *, mp_binary_op_t );
+#endif
+
+// if both operands are dense, and of the same type, the operator can be
+// evaluated in a single flat loop, which the compiler is free to unroll;
+// the results are of rtype, which differs from type for the comparisons only
+#define DENSE_BINARY_LOOP(rtype, type, array, larray, rarray, len, OPERATOR)\
+({\
+    rtype *_array = (rtype *)(array);\
+    type *_larray = (type *)(larray);\
+    type *_rarray = (type *)(rarray);\
+    for(size_t _n = 0; _n < (len); _n++) {\
+        _array[_n] = _larray[_n] OPERATOR _rarray[_n];\
+    }\
+})
+
+// the same as DENSE_BINARY_LOOP, but the right hand side is a scalar
+#define DENSE_BINARY_LOOP_RSCALAR(rtype, type, array, larray, rarray, len, OPERATOR)\
+({\
+    rtype *_array = (rtype *)(array);\
+    type *_larray = (type *)(larray);\
+    const type _value = *((type *)(rarray));\
+    for(size_t _n = 0; _n < (len); _n++) {\
+        _array[_n] = _larray[_n] OPERATOR _value;\
+    }\
+})
+
+// the same as DENSE_BINARY_LOOP, but the left hand side is a scalar
+#define DENSE_BINARY_LOOP_LSCALAR(rtype, type, array, larray, rarray, len, OPERATOR)\
+({\
+    rtype *_array = (rtype *)(array);\
+    const type _value = *((type *)(larray));\
+    type *_rarray = (type *)(rarray);\
+    for(size_t _n = 0; _n < (len); _n++) {\
+        _array[_n] = _value OPERATOR _rarray[_n];\
+    }\
+})
+
+#define UNWRAP_DENSE_BINARY_LOOP(dtype, array, larray, rarray, len, OPERATOR, LOOP)\
+({\
+    if((dtype) == NDARRAY_UINT8) {\
+        LOOP(uint8_t, uint8_t, (array), (larray), (rarray), (len), OPERATOR);\
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {\
+        LOOP(int8_t, int8_t, (array), (larray), (rarray), (len), OPERATOR);\
+    } else if((dtype) == NDARRAY_UINT16) {\
+        LOOP(uint16_t, uint16_t, (array), (larray), (rarray), (len), OPERATOR);\
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {\
+        LOOP(int16_t, int16_t, (array), (larray), (rarray), (len), OPERATOR);\
+    } else {\
+        LOOP(mp_float_t, mp_float_t, (array), (larray), (rarray), (len), OPERATOR);\
+    }\
+})
+
+// the bitwise operators are defined for the integer types only
+#define UNWRAP_DENSE_INTEGER_LOOP(dtype, array, larray, rarray, len, OPERATOR, LOOP)\
+({\
+    if((dtype) == NDARRAY_UINT8) {\
+        LOOP(uint8_t, uint8_t, (array), (larray), (rarray), (len), OPERATOR);\
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {\
+        LOOP(int8_t, int8_t, (array), (larray), (rarray), (len), OPERATOR);\
+    } else if((dtype) == NDARRAY_UINT16) {\
+        LOOP(uint16_t, uint16_t, (array), (larray), (rarray), (len), OPERATOR);\
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {\
+        LOOP(int16_t, int16_t, (array), (larray), (rarray), (len), OPERATOR);\
+    }\
+})
+
+// the results of the comparisons are Booleans
+#define UNWRAP_DENSE_COMPARISON_LOOP(dtype, array, larray, rarray, len, OPERATOR, LOOP)\
+({\
+    if((dtype) == NDARRAY_UINT8) {\
+        LOOP(uint8_t, uint8_t, (array), (larray), (rarray), (len), OPERATOR);\
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {\
+        LOOP(uint8_t, int8_t, (array), (larray), (rarray), (len), OPERATOR);\
+    } else if((dtype) == NDARRAY_UINT16) {\
+        LOOP(uint8_t, uint16_t, (array), (larray), (rarray), (len), OPERATOR);\
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {\
+        LOOP(uint8_t, int16_t, (array), (larray), (rarray), (len), OPERATOR);\
+    } else {\
+        LOOP(uint8_t, mp_float_t, (array), (larray), (rarray), (len), OPERATOR);\
+    }\
+})
+
+// the true division of dense operands is specialised for floats only,
+// since the quotient of two integers is not of the type of the operands
+#define UNWRAP_DENSE_FLOAT_LOOP(dtype, array, larray, rarray, len, OPERATOR, LOOP)\
+({\
+    LOOP(mp_float_t, mp_float_t, (array), (larray), (rarray), (len), OPERATOR);\
+})
+
 #define UNWRAP_INPLACE_OPERATOR(lhs, larray, rarray, rstrides, OPERATOR)\
 ({\
     if((lhs)->dtype == NDARRAY_UINT8) {\
         if((rhs)->dtype == NDARRAY_UINT8) {\
             INPLACE_LOOP((lhs), uint8_t, uint8_t, (larray), (rarray), (rstrides), OPERATOR);\
-        } else if(rhs->dtype == NDARRAY_INT8) {\
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {\
             INPLACE_LOOP((lhs), uint8_t, int8_t, (larray), (rarray), (rstrides), OPERATOR);\
         } else if(rhs->dtype == NDARRAY_UINT16) {\
             INPLACE_LOOP((lhs), uint8_t, uint16_t, (larray), (rarray), (rstrides), OPERATOR);\
         } else {\
             INPLACE_LOOP((lhs), uint8_t, int16_t, (larray), (rarray), (rstrides), OPERATOR);\
         }\
-    } else if(lhs->dtype == NDARRAY_INT8) {\
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {\
         if(rhs->dtype == NDARRAY_UINT8) {\
             INPLACE_LOOP((lhs), int8_t, uint8_t, (larray), (rarray), (rstrides), OPERATOR);\
-        } else if(rhs->dtype == NDARRAY_INT8) {\
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {\
             INPLACE_LOOP((lhs), int8_t, int8_t, (larray), (rarray), (rstrides), OPERATOR);\
         } else if(rhs->dtype == NDARRAY_UINT16) {\
             INPLACE_LOOP((lhs), int8_t, uint16_t, (larray), (rarray), (rstrides), OPERATOR);\
@@ -49,17 +143,17 @@ mp_obj_t ndarray_inplace_divide(ndarray_obj_t *, ndarray_obj_t *, int32_t *);
     } else if(lhs->dtype == NDARRAY_UINT16) {\
         if(rhs->dtype == NDARRAY_UINT8) {\
             INPLACE_LOOP((lhs), uint16_t, uint8_t, (larray), (rarray), (rstrides), OPERATOR);\
-        } else if(rhs->dtype == NDARRAY_INT8) {\
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {\
             INPLACE_LOOP((lhs), uint16_t, int8_t, (larray), (rarray), (rstrides), OPERATOR);\
         } else if(rhs->dtype == NDARRAY_UINT16) {\
             INPLACE_LOOP((lhs), uint16_t, uint16_t, (larray), (rarray), (rstrides), OPERATOR);\
         } else {\
             INPLACE_LOOP((lhs), uint16_t, int16_t, (larray), (rarray), (rstrides), OPERATOR);\
         }\
-    } else if(lhs->dtype == NDARRAY_INT16) {\
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {\
         if(rhs->dtype == NDARRAY_UINT8) {\
             INPLACE_LOOP((lhs), int16_t, uint8_t, (larray), (rarray), (rstrides), OPERATOR);\
-        } else if(rhs->dtype == NDARRAY_INT8) {\
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {\
             INPLACE_LOOP((lhs), int16_t, int8_t, (larray), (rarray), (rstrides), OPERATOR);\
         } else if(rhs->dtype == NDARRAY_UINT16) {\
             INPLACE_LOOP((lhs), int16_t, uint16_t, (larray), (rarray), (rstrides), OPERATOR);\
@@ -69,11 +163,11 @@ mp_obj_t ndarray_inplace_divide(ndarray_obj_t *, ndarray_obj_t *, int32_t *);
     } else if(lhs->dtype == NDARRAY_FLOAT) {\
         if(rhs->dtype == NDARRAY_UINT8) {\
             INPLACE_LOOP((lhs), mp_float_t, uint8_t, (larray), (rarray), (rstrides), OPERATOR);\
-        } else if(rhs->dtype == NDARRAY_INT8) {\
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {\
             INPLACE_LOOP((lhs), mp_float_t, int8_t, (larray), (rarray), (rstrides), OPERATOR);\
         } else if(rhs->dtype == NDARRAY_UINT16) {\
             INPLACE_LOOP((lhs), mp_float_t, uint16_t, (larray), (rarray), (rstrides), OPERATOR);\
-        } else if(rhs->dtype == NDARRAY_INT16) {\
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {\
             INPLACE_LOOP((lhs), mp_float_t, int16_t, (larray), (rarray), (rstrides), OPERATOR);\
         } else {\
             INPLACE_LOOP((lhs), mp_float_t, mp_float_t, (larray), (rarray), (rstrides), OPERATOR);\
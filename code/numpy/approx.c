@@ -27,6 +27,101 @@
 
 ULAB_DEFINE_FLOAT_CONST(approx_trapz_dx, MICROPY_FLOAT_CONST(1.0), 0x3f800000UL, 0x3ff0000000000000ULL);
 
+#if ULAB_NUMPY_HAS_INTERP | ULAB_NUMPY_HAS_INTERPOLATOR
+static mp_float_t *approx_interp_table(approx_interpolator_obj_t *table, mp_obj_t xp_in, mp_obj_t fp_in, mp_obj_t left, mp_obj_t right) {
+    // reads the data points into a single float buffer, and calculates the slopes of the segments;
+    // the buffer holds xp, fp, and the slopes, and is returned, so that the caller can release it
+    ndarray_obj_t *xp = ndarray_from_mp_obj(xp_in, 0); // xp must hold an increasing sequence of independent values
+    ndarray_obj_t *fp = ndarray_from_mp_obj(fp_in, 0);
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(xp->dtype)
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(fp->dtype)
+    if((xp->ndim != 1) || (fp->ndim != 1) || (xp->len < 2) || (fp->len < 2) || (xp->len != fp->len)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("interp is defined for 1D iterables of equal length"));
+    }
+    size_t len = xp->len;
+    mp_float_t *buffer = m_new(mp_float_t, 3 * len - 1);
+    table->len = len;
+    table->xp = buffer;
+    table->fp = buffer + len;
+    table->slope = buffer + 2 * len;
+
+    mp_float_t (*xfunc)(void *) = ndarray_get_float_function(xp->dtype);
+    mp_float_t (*ffunc)(void *) = ndarray_get_float_function(fp->dtype);
+    uint8_t *xparray = (uint8_t *)xp->array;
+    uint8_t *fparray = (uint8_t *)fp->array;
+    for(size_t i = 0; i < len; i++) {
+        table->xp[i] = xfunc(xparray);
+        table->fp[i] = ffunc(fparray);
+        xparray += xp->strides[ULAB_MAX_DIMS - 1];
+        fparray += fp->strides[ULAB_MAX_DIMS - 1];
+    }
+    for(size_t i = 0; i < len - 1; i++) {
+        table->slope[i] = (table->fp[i + 1] - table->fp[i]) / (table->xp[i + 1] - table->xp[i]);
+    }
+    table->left = left == mp_const_none ? table->fp[0] : mp_obj_get_float(left);
+    table->right = right == mp_const_none ? table->fp[len - 1] : mp_obj_get_float(right);
+    return buffer;
+}
+
+static mp_obj_t approx_interp_evaluate(approx_interpolator_obj_t *table, mp_obj_t x_in, bool assume_sorted) {
+    ndarray_obj_t *x = ndarray_from_mp_obj(x_in, 0);
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(x->dtype)
+
+    ndarray_obj_t *y = ndarray_new_linear_array(x->len, NDARRAY_FLOAT);
+    mp_float_t *yarray = (mp_float_t *)y->array;
+    mp_float_t (*func)(void *) = ndarray_get_float_function(x->dtype);
+    int32_t stride = x->strides[ULAB_MAX_DIMS - 1];
+    uint8_t *xarray = (uint8_t *)x->array;
+
+    // if the query points are sorted, the segments can be found by walking along xp,
+    // which costs O(n + m) instead of the O(m log n) of the binary searches;
+    // checking the order is a single pass over x
+    bool sorted = assume_sorted;
+    if(!sorted) {
+        sorted = true;
+        for(size_t i = 1; i < x->len; i++) {
+            if(func(xarray + i * stride) < func(xarray + (i - 1) * stride)) {
+                sorted = false;
+                break;
+            }
+        }
+    }
+
+    const mp_float_t *xp = table->xp;
+    size_t last = table->len - 1;
+    size_t j = 0;
+    for(size_t i = 0; i < x->len; i++) {
+        mp_float_t value = func(xarray);
+        xarray += stride;
+        if(value < xp[0]) {
+            *yarray++ = table->left;
+        } else if(value > xp[last]) {
+            *yarray++ = table->right;
+        } else {
+            // find j such that xp[j] <= value <= xp[j + 1], preferring the lower segment at the nodes
+            if(sorted) {
+                while((j < last - 1) && (value > xp[j + 1])) {
+                    j++;
+                }
+            } else {
+                size_t left_index = 0, right_index = last;
+                while(right_index - left_index > 1) {
+                    size_t middle_index = left_index + (right_index - left_index) / 2;
+                    if(value <= xp[middle_index]) {
+                        right_index = middle_index;
+                    } else {
+                        left_index = middle_index;
+                    }
+                }
+                j = left_index;
+            }
+            *yarray++ = table->fp[j] + (value - xp[j]) * table->slope[j];
+        }
+    }
+    return MP_OBJ_FROM_PTR(y);
+}
+#endif /* ULAB_NUMPY_HAS_INTERP | ULAB_NUMPY_HAS_INTERPOLATOR */
+
 #if ULAB_NUMPY_HAS_INTERP
 //| def interp(
 //|     x: ulab.numpy.ndarray,
@@ -34,7 +129,8 @@ ULAB_DEFINE_FLOAT_CONST(approx_trapz_dx, MICROPY_FLOAT_CONST(1.0), 0x3f800000UL,
 //|     fp: ulab.numpy.ndarray,
 //|     *,
 //|     left: Optional[_float] = None,
-//|     right: Optional[_float] = None
+//|     right: Optional[_float] = None,
+//|     assume_sorted: bool = False
 //| ) -> ulab.numpy.ndarray:
 //|     """
 //|     :param ulab.numpy.ndarray x: The x-coordinates at which to evaluate the interpolated values.
@@ -42,6 +138,7 @@ ULAB_DEFINE_FLOAT_CONST(approx_trapz_dx, MICROPY_FLOAT_CONST(1.0), 0x3f800000UL,
 //|     :param ulab.numpy.ndarray fp: The y-coordinates of the data points, same length as xp
 //|     :param left: Value to return for ``x < xp[0]``, default is ``fp[0]``.
 //|     :param right: Value to return for ``x > xp[-1]``, default is ``fp[-1]``.
+//|     :param bool assume_sorted: if True, x is taken to be non-decreasing without checking
 //|
 //|     Returns the one-dimensional piecewise linear interpolant to a function with given discrete data points (xp, fp), evaluated at x."""
 //|     ...
@@ -54,90 +151,105 @@ STATIC mp_obj_t approx_interp(size_t n_args, const mp_obj_t *pos_args, mp_map_t
         { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
         { MP_QSTR_left, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
         { MP_QSTR_right, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_assume_sorted, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false } },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
-    ndarray_obj_t *x = ndarray_from_mp_obj(args[0].u_obj, 0);
-    ndarray_obj_t *xp = ndarray_from_mp_obj(args[1].u_obj, 0); // xp must hold an increasing sequence of independent values
-    ndarray_obj_t *fp = ndarray_from_mp_obj(args[2].u_obj, 0);
-    COMPLEX_DTYPE_NOT_IMPLEMENTED(x->dtype)
-    COMPLEX_DTYPE_NOT_IMPLEMENTED(xp->dtype)
-    COMPLEX_DTYPE_NOT_IMPLEMENTED(fp->dtype)
-    if((xp->ndim != 1) || (fp->ndim != 1) || (xp->len < 2) || (fp->len < 2) || (xp->len != fp->len)) {
-        mp_raise_ValueError(MP_ERROR_TEXT("interp is defined for 1D iterables of equal length"));
-    }
-
-    ndarray_obj_t *y = ndarray_new_linear_array(x->len, NDARRAY_FLOAT);
-    mp_float_t left_value, right_value;
-    uint8_t *xparray = (uint8_t *)xp->array;
-
-    mp_float_t xp_left = ndarray_get_float_value(xparray, xp->dtype);
-    xparray += (xp->len-1) * xp->strides[ULAB_MAX_DIMS - 1];
-    mp_float_t xp_right = ndarray_get_float_value(xparray, xp->dtype);
+    approx_interpolator_obj_t table;
+    mp_float_t *buffer = approx_interp_table(&table, args[1].u_obj, args[2].u_obj, args[3].u_obj, args[4].u_obj);
+    mp_obj_t y = approx_interp_evaluate(&table, args[0].u_obj, args[5].u_bool);
+    m_del(mp_float_t, buffer, 3 * table.len - 1);
+    return y;
+}
 
-    uint8_t *fparray = (uint8_t *)fp->array;
+MP_DEFINE_CONST_FUN_OBJ_KW(approx_interp_obj, 2, approx_interp);
+#endif
 
-    if(args[3].u_obj == mp_const_none) {
-        left_value = ndarray_get_float_value(fparray, fp->dtype);
-    } else {
-        left_value = mp_obj_get_float(args[3].u_obj);
-    }
-    if(args[4].u_obj == mp_const_none) {
-        fparray += (fp->len-1) * fp->strides[ULAB_MAX_DIMS - 1];
-        right_value = ndarray_get_float_value(fparray, fp->dtype);
-    } else {
-        right_value = mp_obj_get_float(args[4].u_obj);
-    }
+#if ULAB_NUMPY_HAS_INTERPOLATOR
+//| class interpolator:
+//|     """Piecewise linear interpolant of the data points (xp, fp), whose segment slopes are calculated once"""
+//|
+//|     def __init__(
+//|         self,
+//|         xp: ulab.numpy.ndarray,
+//|         fp: ulab.numpy.ndarray,
+//|         *,
+//|         left: Optional[_float] = None,
+//|         right: Optional[_float] = None
+//|     ) -> None:
+//|         """The arguments have the same meaning as in `interp`"""
+//|         ...
+//|
+//|     def __call__(self, x: ulab.numpy.ndarray, *, assume_sorted: bool = False) -> ulab.numpy.ndarray:
+//|         """Equivalent to ``interp(x, xp, fp, left=left, right=right, assume_sorted=assume_sorted)``"""
+//|         ...
+//|
 
-    xparray = xp->array;
-    fparray = fp->array;
+static mp_obj_t approx_interpolator_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    (void) type;
+    mp_arg_check_num(n_args, n_kw, 2, 2, true);
+    mp_map_t kw_args;
+    mp_map_init_fixed_table(&kw_args, n_kw, args + n_args);
 
-    uint8_t *xarray = (uint8_t *)x->array;
-    mp_float_t *yarray = (mp_float_t *)y->array;
-    uint8_t *temp;
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_left, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_right, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+    };
+    mp_arg_val_t _args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, args, &kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, _args);
 
-    for(size_t i=0; i < x->len; i++, yarray++) {
-        mp_float_t x_value = ndarray_get_float_value(xarray, x->dtype);
-        xarray += x->strides[ULAB_MAX_DIMS - 1];
-        if(x_value < xp_left) {
-            *yarray = left_value;
-        } else if(x_value > xp_right) {
-            *yarray = right_value;
-        } else { // do the binary search here
-            mp_float_t xp_left_, xp_right_;
-            mp_float_t fp_left, fp_right;
-            size_t left_index = 0, right_index = xp->len - 1, middle_index;
-            while(right_index - left_index > 1) {
-                middle_index = left_index + (right_index - left_index) / 2;
-                temp = xparray + middle_index * xp->strides[ULAB_MAX_DIMS - 1];
-                mp_float_t xp_middle = ndarray_get_float_value(temp, xp->dtype);
-                if(x_value <= xp_middle) {
-                    right_index = middle_index;
-                } else {
-                    left_index = middle_index;
-                }
-            }
-            temp = xparray + left_index * xp->strides[ULAB_MAX_DIMS - 1];
-            xp_left_ = ndarray_get_float_value(temp, xp->dtype);
+    approx_interpolator_obj_t *self = m_new_obj(approx_interpolator_obj_t);
+    self->base.type = &approx_interpolator_type;
+    approx_interp_table(self, _args[0].u_obj, _args[1].u_obj, _args[2].u_obj, _args[3].u_obj);
+    return MP_OBJ_FROM_PTR(self);
+}
 
-            temp = xparray + right_index * xp->strides[ULAB_MAX_DIMS - 1];
-            xp_right_ = ndarray_get_float_value(temp, xp->dtype);
+static mp_obj_t approx_interpolator_call(mp_obj_t self_in, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 1, 1, true);
+    mp_map_t kw_args;
+    mp_map_init_fixed_table(&kw_args, n_kw, args + n_args);
 
-            temp = fparray + left_index * fp->strides[ULAB_MAX_DIMS - 1];
-            fp_left = ndarray_get_float_value(temp, fp->dtype);
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_assume_sorted, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false } },
+    };
+    mp_arg_val_t _args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, args, &kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, _args);
 
-            temp = fparray + right_index * fp->strides[ULAB_MAX_DIMS - 1];
-            fp_right = ndarray_get_float_value(temp, fp->dtype);
+    return approx_interp_evaluate(MP_OBJ_TO_PTR(self_in), _args[0].u_obj, _args[1].u_bool);
+}
 
-            *yarray = fp_left + (x_value - xp_left_) * (fp_right - fp_left) / (xp_right_ - xp_left_);
-        }
-    }
-    return MP_OBJ_FROM_PTR(y);
+static void approx_interpolator_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    (void)kind;
+    approx_interpolator_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_printf(print, "interpolator(%d)", self->len);
 }
 
-MP_DEFINE_CONST_FUN_OBJ_KW(approx_interp_obj, 2, approx_interp);
+#if defined(MP_DEFINE_CONST_OBJ_TYPE)
+MP_DEFINE_CONST_OBJ_TYPE(
+    approx_interpolator_type,
+    MP_QSTR_interpolator,
+    MP_TYPE_FLAG_NONE,
+    make_new, approx_interpolator_make_new,
+    print, approx_interpolator_print,
+    call, approx_interpolator_call
+);
+#else
+const mp_obj_type_t approx_interpolator_type = {
+    { &mp_type_type },
+    .flags = MP_TYPE_FLAG_EXTENDED,
+    .name = MP_QSTR_interpolator,
+    .make_new = approx_interpolator_make_new,
+    .print = approx_interpolator_print,
+    MP_TYPE_EXTENDED_FIELDS(
+    .call = approx_interpolator_call,
+    )
+};
 #endif
+#endif /* ULAB_NUMPY_HAS_INTERPOLATOR */
 
 #if ULAB_NUMPY_HAS_TRAPZ
 //| def trapz(y: ulab.numpy.ndarray, x: Optional[ulab.numpy.ndarray] = None, dx: _float = 1.0) -> _float:
@@ -211,7 +323,8 @@ STATIC mp_obj_t approx_trapz(size_t n_args, const mp_obj_t *pos_args, mp_map_t *
         yarray += y->strides[ULAB_MAX_DIMS - 1];
 
         for(size_t i=1; i < y->len; i++) {
-            y2 = ndarray_get_float_index(y->array, y->dtype, i);
+            y2 = funcy(yarray);
+            yarray += y->strides[ULAB_MAX_DIMS - 1];
             mp_float_t value = (y2 + y1);
             m = mean + (value - mean) / (mp_float_t)count;
             mean = m;
@@ -23,6 +23,19 @@
 #define     APPROX_GAMMA        MICROPY_FLOAT_CONST(0.5)
 #define     APPROX_DELTA        MICROPY_FLOAT_CONST(0.5)
 
+typedef struct _approx_interpolator_obj_t {
+    mp_obj_base_t base;
+    size_t len;
+    mp_float_t left;
+    mp_float_t right;
+    // xp, fp, and the len - 1 slopes of the segments share a single allocation
+    mp_float_t *xp;
+    mp_float_t *fp;
+    mp_float_t *slope;
+} approx_interpolator_obj_t;
+
+extern const mp_obj_type_t approx_interpolator_type;
+
 MP_DECLARE_CONST_FUN_OBJ_KW(approx_interp_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(approx_trapz_obj);
 
@@ -31,24 +31,24 @@ ndarray_obj_t *bitwise_bitwise_and_loop(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT8);
             BINARY_LOOP(results, uint8_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, &);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides, &);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, &);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides, &);
         } 
-    } else if(lhs->dtype == NDARRAY_INT8) {
-        if(rhs->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
+        if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT8);
             BINARY_LOOP(results, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, &);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, int8_t, uint16_t, larray, lstrides, rarray, rstrides, &);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int8_t, int16_t, larray, lstrides, rarray, rstrides, &);
         } else {
@@ -58,14 +58,14 @@ ndarray_obj_t *bitwise_bitwise_and_loop(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, &);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides, &);
         } else {
             return bitwise_bitwise_and_loop(rhs, lhs, ndim, shape, rstrides, lstrides);
         }
-    } else if(lhs->dtype == NDARRAY_INT16) {
-        if(rhs->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
+        if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int16_t, int16_t, larray, lstrides, rarray, rstrides, &);
         } else {
@@ -88,24 +88,24 @@ ndarray_obj_t *bitwise_bitwise_or_loop(ndarray_obj_t *lhs, ndarray_obj_t *rhs, u
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT8);
             BINARY_LOOP(results, uint8_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, |);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides, |);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, |);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides, |);
         } 
-    } else if(lhs->dtype == NDARRAY_INT8) {
-        if(rhs->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
+        if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT8);
             BINARY_LOOP(results, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, |);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, int8_t, uint16_t, larray, lstrides, rarray, rstrides, |);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int8_t, int16_t, larray, lstrides, rarray, rstrides, |);
         } else {
@@ -115,14 +115,14 @@ ndarray_obj_t *bitwise_bitwise_or_loop(ndarray_obj_t *lhs, ndarray_obj_t *rhs, u
         if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, |);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides, |);
         } else {
             return bitwise_bitwise_or_loop(rhs, lhs, ndim, shape, rstrides, lstrides);
         }
-    } else if(lhs->dtype == NDARRAY_INT16) {
-        if(rhs->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
+        if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int16_t, int16_t, larray, lstrides, rarray, rstrides, |);
         } else {
@@ -146,24 +146,24 @@ ndarray_obj_t *bitwise_bitwise_xor_loop(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT8);
             BINARY_LOOP(results, uint8_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, ^);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides, ^);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, ^);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides, ^);
         } 
-    } else if(lhs->dtype == NDARRAY_INT8) {
-        if(rhs->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
+        if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT8);
             BINARY_LOOP(results, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, ^);
         } else if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, int8_t, uint16_t, larray, lstrides, rarray, rstrides, ^);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int8_t, int16_t, larray, lstrides, rarray, rstrides, ^);
         } else {
@@ -173,14 +173,14 @@ ndarray_obj_t *bitwise_bitwise_xor_loop(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(rhs->dtype == NDARRAY_UINT16) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, ^);
-        } else if(rhs->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides, ^);
         } else {
             return bitwise_bitwise_xor_loop(rhs, lhs, ndim, shape, rstrides, lstrides);
         }
-    } else if(lhs->dtype == NDARRAY_INT16) {
-        if(rhs->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
+        if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int16_t, int16_t, larray, lstrides, rarray, rstrides, ^);
         } else {
@@ -201,7 +201,7 @@ ndarray_obj_t *bitwise_left_shift_loop(ndarray_obj_t *lhs, ndarray_obj_t *rhs, u
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT8);
             BINARY_LOOP(results, uint8_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, <<);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides, <<);
         } else if(rhs->dtype == NDARRAY_UINT16) {
@@ -211,11 +211,11 @@ ndarray_obj_t *bitwise_left_shift_loop(ndarray_obj_t *lhs, ndarray_obj_t *rhs, u
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides, <<);
         } 
-    } else if(lhs->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int8_t, uint8_t, larray, lstrides, rarray, rstrides, <<);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT8);
             BINARY_LOOP(results, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, <<);
         } else if(rhs->dtype == NDARRAY_UINT16) {
@@ -229,7 +229,7 @@ ndarray_obj_t *bitwise_left_shift_loop(ndarray_obj_t *lhs, ndarray_obj_t *rhs, u
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint16_t, uint8_t, larray, lstrides, rarray, rstrides, <<);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT8);
             BINARY_LOOP(results, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, <<);
         } else if(rhs->dtype == NDARRAY_UINT16) {
@@ -239,11 +239,11 @@ ndarray_obj_t *bitwise_left_shift_loop(ndarray_obj_t *lhs, ndarray_obj_t *rhs, u
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides, <<);
         }
-    } else if(lhs->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int16_t, uint8_t, larray, lstrides, rarray, rstrides, <<);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int16_t, int8_t, larray, lstrides, rarray, rstrides, <<);
         } else if(rhs->dtype == NDARRAY_UINT16) {
@@ -268,7 +268,7 @@ ndarray_obj_t *bitwise_right_shift_loop(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT8);
             BINARY_LOOP(results, uint8_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, >>);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides, >>);
         } else if(rhs->dtype == NDARRAY_UINT16) {
@@ -278,11 +278,11 @@ ndarray_obj_t *bitwise_right_shift_loop(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides, >>);
         } 
-    } else if(lhs->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int8_t, uint8_t, larray, lstrides, rarray, rstrides, >>);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT8);
             BINARY_LOOP(results, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, >>);
         } else if(rhs->dtype == NDARRAY_UINT16) {
@@ -296,7 +296,7 @@ ndarray_obj_t *bitwise_right_shift_loop(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_UINT16);
             BINARY_LOOP(results, uint16_t, uint16_t, uint8_t, larray, lstrides, rarray, rstrides, >>);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT8);
             BINARY_LOOP(results, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, >>);
         } else if(rhs->dtype == NDARRAY_UINT16) {
@@ -306,11 +306,11 @@ ndarray_obj_t *bitwise_right_shift_loop(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides, >>);
         }
-    } else if(lhs->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
         if(rhs->dtype == NDARRAY_UINT8) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int16_t, uint8_t, larray, lstrides, rarray, rstrides, >>);
-        } else if(rhs->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
             results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_INT16);
             BINARY_LOOP(results, int16_t, int16_t, int8_t, larray, lstrides, rarray, rstrides, >>);
         } else if(rhs->dtype == NDARRAY_UINT16) {
@@ -338,6 +338,8 @@ mp_obj_t *bitwise_binary_operators(mp_obj_t x1, mp_obj_t x2, uint8_t optype) {
         mp_raise_ValueError(MP_ERROR_TEXT("not supported for input types"));
     }
     #endif
+    GENERIC_DTYPE_NOT_IMPLEMENTED(lhs->dtype)
+    GENERIC_DTYPE_NOT_IMPLEMENTED(rhs->dtype)
     
     uint8_t ndim = 0;
     size_t *shape = m_new(size_t, ULAB_MAX_DIMS);
@@ -21,6 +21,7 @@
 #include "../../ulab.h"
 #include "../../ndarray.h"
 #include "../../ulab_tools.h"
+#include "../sort/sort_tools.h"
 #include "carray.h"
 
 #if ULAB_SUPPORTS_COMPLEX
@@ -132,55 +133,6 @@ MP_DEFINE_CONST_FUN_OBJ_1(carray_conjugate_obj, carray_conjugate);
 //|     ...
 //|
 
-static void carray_sort_complex_(mp_float_t *array, size_t len) {
-    // array is assumed to be a floating vector containing the real and imaginary parts
-    // of a complex array at alternating positions as
-    // array[0] = real[0]
-    // array[1] = imag[0]
-    // array[2] = real[1]
-    // array[3] = imag[1]
-
-    mp_float_t real, imag;
-    size_t c, q = len, p, r = len >> 1;
-    for (;;) {
-        if (r > 0) {
-            r--;
-            real = array[2 * r];
-            imag = array[2 * r + 1];
-        } else {
-            q--;
-            if(q == 0) {
-                break;
-            }
-            real = array[2 * q];
-            imag = array[2 * q + 1];
-            array[2 * q] = array[0];
-            array[2 * q + 1] = array[1];
-        }
-        p = r;
-        c = r + r + 1;
-        while (c < q) {
-            if(c + 1 < q) {
-                if((array[2 * (c+1)] > array[2 * c]) ||
-                    ((array[2 * (c+1)] == array[2 * c]) && (array[2 * (c+1) + 1] > array[2 * c + 1]))) {
-                    c++;
-                }
-            }
-            if((array[2 * c] > real) ||
-                ((array[2 * c] == real) && (array[2 * c + 1] > imag))) {
-                array[2 * p] = array[2 * c]; // real part
-                array[2 * p + 1] = array[2 * c + 1]; // imag part
-                p = c;
-                c = p + p + 1;
-            } else {
-                break;
-            }
-        }
-        array[2 * p] = real;
-        array[2 * p + 1] = imag;
-    }
-}
-
 mp_obj_t carray_sort_complex(mp_obj_t _source) {
     if(!mp_obj_is_type(_source, &ulab_ndarray_type)) {
         mp_raise_TypeError(MP_ERROR_TEXT("input must be a 1D ndarray"));
@@ -194,7 +146,7 @@ mp_obj_t carray_sort_complex(mp_obj_t _source) {
 
     if(ndarray->len != 0) {
         mp_float_t *array = (mp_float_t *)ndarray->array;
-        carray_sort_complex_(array, ndarray->len);
+        sort_complex(array, ndarray->len);
     }
     
     return MP_OBJ_FROM_PTR(ndarray);
@@ -303,6 +255,102 @@ static void carray_copy_part(uint8_t *tarray, uint8_t *sarray, size_t *shape, in
     #endif /* ULAB_MAX_DIMS > 3 */
 }
 
+static int8_t carray_dense_step(ndarray_obj_t *results, ndarray_obj_t *operand, int32_t *strides) {
+    // Returns the number of floats between consecutive operand elements, if the broadcast strides
+    // traverse the operand in the order of the (dense) results, 0, if the operand is broadcast
+    // from a single element, and -1 otherwise. Only float and complex operands are considered.
+    if((operand->dtype != NDARRAY_COMPLEX) && (operand->dtype != NDARRAY_FLOAT)) {
+        return -1;
+    }
+    int32_t itemsize = operand->dtype == NDARRAY_COMPLEX ? 2 * sizeof(mp_float_t) : sizeof(mp_float_t);
+    int32_t stride = itemsize;
+    bool dense = true, scalar = true;
+    for(uint8_t i = ULAB_MAX_DIMS; i > ULAB_MAX_DIMS - results->ndim; i--) {
+        if(results->shape[i - 1] > 1) {
+            dense = dense && (strides[i - 1] == stride);
+            scalar = scalar && (strides[i - 1] == 0);
+        }
+        stride *= (int32_t)results->shape[i - 1];
+    }
+    if(scalar) {
+        return 0;
+    }
+    return dense ? (int8_t)(itemsize / sizeof(mp_float_t)) : -1;
+}
+
+static bool carray_binary_dense(ndarray_obj_t *results, ndarray_obj_t *lhs, ndarray_obj_t *rhs,
+                            int32_t *lstrides, int32_t *rstrides, mp_binary_op_t op) {
+    // Evaluates op with flat loops, if both operands are dense, or broadcast from a single element,
+    // and of float, or complex dtype; returns false, if the generic strided loops are needed.
+    int8_t lstep = carray_dense_step(results, lhs, lstrides);
+    int8_t rstep = carray_dense_step(results, rhs, rstrides);
+    if((lstep < 0) || (rstep < 0)) {
+        return false;
+    }
+    bool lcomplex = lhs->dtype == NDARRAY_COMPLEX;
+    bool rcomplex = rhs->dtype == NDARRAY_COMPLEX;
+    mp_float_t *larray = (mp_float_t *)lhs->array;
+    mp_float_t *rarray = (mp_float_t *)rhs->array;
+    mp_float_t *resarray = (mp_float_t *)results->array;
+
+    if(op == MP_BINARY_OP_ADD) {
+        for(size_t i = 0; i < results->len; i++) {
+            *resarray++ = larray[0] + rarray[0];
+            *resarray++ = lcomplex ? (rcomplex ? larray[1] + rarray[1] : larray[1]) : rarray[1];
+            larray += lstep;
+            rarray += rstep;
+        }
+    } else if(op == MP_BINARY_OP_SUBTRACT) {
+        for(size_t i = 0; i < results->len; i++) {
+            *resarray++ = larray[0] - rarray[0];
+            *resarray++ = lcomplex ? (rcomplex ? larray[1] - rarray[1] : larray[1]) : -rarray[1];
+            larray += lstep;
+            rarray += rstep;
+        }
+    } else if(op == MP_BINARY_OP_MULTIPLY) {
+        if(lcomplex && rcomplex) {
+            for(size_t i = 0; i < results->len; i++) {
+                *resarray++ = larray[0] * rarray[0] - larray[1] * rarray[1];
+                *resarray++ = larray[0] * rarray[1] + larray[1] * rarray[0];
+                larray += lstep;
+                rarray += rstep;
+            }
+        } else {
+            // align the complex operand to the left
+            if(rcomplex) {
+                SWAP(mp_float_t *, larray, rarray);
+                SWAP(int8_t, lstep, rstep);
+            }
+            for(size_t i = 0; i < results->len; i++) {
+                *resarray++ = larray[0] * rarray[0];
+                *resarray++ = larray[1] * rarray[0];
+                larray += lstep;
+                rarray += rstep;
+            }
+        }
+    } else { // MP_BINARY_OP_TRUE_DIVIDE
+        for(size_t i = 0; i < results->len; i++) {
+            if(!rcomplex) {
+                *resarray++ = larray[0] / rarray[0];
+                *resarray++ = larray[1] / rarray[0];
+            } else {
+                mp_float_t denom = rarray[0] * rarray[0] + rarray[1] * rarray[1];
+                if(lcomplex) {
+                    *resarray++ = (larray[0] * rarray[0] + larray[1] * rarray[1]) / denom;
+                    *resarray++ = (larray[1] * rarray[0] - larray[0] * rarray[1]) / denom;
+                } else {
+                    mp_float_t a = larray[0] / denom;
+                    *resarray++ = a * rarray[0];
+                    *resarray++ = -a * rarray[1];
+                }
+            }
+            larray += lstep;
+            rarray += rstep;
+        }
+    }
+    return true;
+}
+
 mp_obj_t carray_binary_equal_not_equal(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
                             uint8_t ndim, size_t *shape, int32_t *lstrides, int32_t *rstrides, mp_binary_op_t op) {
 
@@ -388,11 +436,11 @@ mp_obj_t carray_binary_equal_not_equal(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
 
         if(rdtype == NDARRAY_UINT8) {
             BINARY_LOOP_COMPLEX_EQUAL(results, array, uint8_t, larray, lstrides_, rarray, rstrides_);
-        } else if(rdtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rdtype, INT8)) {
             BINARY_LOOP_COMPLEX_EQUAL(results, array, int8_t, larray, lstrides_, rarray, rstrides_);
         } else if(rdtype == NDARRAY_UINT16) {
             BINARY_LOOP_COMPLEX_EQUAL(results, array, uint16_t, larray, lstrides_, rarray, rstrides_);
-        } else if(rdtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rdtype, INT16)) {
             BINARY_LOOP_COMPLEX_EQUAL(results, array, int16_t, larray, lstrides_, rarray, rstrides_);
         } else if(rdtype == NDARRAY_FLOAT) {
             BINARY_LOOP_COMPLEX_EQUAL(results, array, mp_float_t, larray, lstrides_, rarray, rstrides_);
@@ -407,6 +455,10 @@ mp_obj_t carray_binary_add(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
     ndarray_obj_t *results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_COMPLEX);
     mp_float_t *resarray = (mp_float_t *)results->array;
 
+    if(carray_binary_dense(results, lhs, rhs, lstrides, rstrides, MP_BINARY_OP_ADD)) {
+        return MP_OBJ_FROM_PTR(results);
+    }
+
     if((lhs->dtype == NDARRAY_COMPLEX) && (rhs->dtype == NDARRAY_COMPLEX)) {
         mp_float_t *larray = (mp_float_t *)lhs->array;
         mp_float_t *rarray = (mp_float_t *)rhs->array;
@@ -479,11 +531,11 @@ mp_obj_t carray_binary_add(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
 
         if(rdtype == NDARRAY_UINT8) {
             BINARY_LOOP_COMPLEX(results, resarray, uint8_t, larray, lstrides_, rarray, rstrides_, +);
-        } else if(rdtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(rdtype, INT8)) {
             BINARY_LOOP_COMPLEX(results, resarray, int8_t, larray, lstrides_, rarray, rstrides_, +);
         } else if(rdtype == NDARRAY_UINT16) {
             BINARY_LOOP_COMPLEX(results, resarray, uint16_t, larray, lstrides_, rarray, rstrides_, +);
-        } else if(rdtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(rdtype, INT16)) {
             BINARY_LOOP_COMPLEX(results, resarray, int16_t, larray, lstrides_, rarray, rstrides_, +);
         } else if(rdtype == NDARRAY_FLOAT) {
             BINARY_LOOP_COMPLEX(results, resarray, mp_float_t, larray, lstrides_, rarray, rstrides_, +);
@@ -510,11 +562,11 @@ static void carray_binary_multiply_(ndarray_obj_t *results, mp_float_t *resarray
 
     if(rdtype == NDARRAY_UINT8) {
         BINARY_LOOP_COMPLEX(results, resarray, uint8_t, larray, lstrides, rarray, rstrides, *);
-    } else if(rdtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(rdtype, INT8)) {
         BINARY_LOOP_COMPLEX(results, resarray, int8_t, larray, lstrides, rarray, rstrides, *);
     } else if(rdtype == NDARRAY_UINT16) {
         BINARY_LOOP_COMPLEX(results, resarray, uint16_t, larray, lstrides, rarray, rstrides, *);
-    } else if(rdtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(rdtype, INT16)) {
         BINARY_LOOP_COMPLEX(results, resarray, int16_t, larray, lstrides, rarray, rstrides, *);
     } else if(rdtype == NDARRAY_FLOAT) {
         BINARY_LOOP_COMPLEX(results, resarray, mp_float_t, larray, lstrides, rarray, rstrides, *);
@@ -527,6 +579,10 @@ mp_obj_t carray_binary_multiply(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
     ndarray_obj_t *results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_COMPLEX);
     mp_float_t *resarray = (mp_float_t *)results->array;
 
+    if(carray_binary_dense(results, lhs, rhs, lstrides, rstrides, MP_BINARY_OP_MULTIPLY)) {
+        return MP_OBJ_FROM_PTR(results);
+    }
+
     if((lhs->dtype == NDARRAY_COMPLEX) && (rhs->dtype == NDARRAY_COMPLEX)) {
         mp_float_t *larray = (mp_float_t *)lhs->array;
         mp_float_t *rarray = (mp_float_t *)rhs->array;
@@ -619,6 +675,10 @@ mp_obj_t carray_binary_subtract(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
     ndarray_obj_t *results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_COMPLEX);
     mp_float_t *resarray = (mp_float_t *)results->array;
 
+    if(carray_binary_dense(results, lhs, rhs, lstrides, rstrides, MP_BINARY_OP_SUBTRACT)) {
+        return MP_OBJ_FROM_PTR(results);
+    }
+
     if((lhs->dtype == NDARRAY_COMPLEX) && (rhs->dtype == NDARRAY_COMPLEX)) {
         mp_float_t *larray = (mp_float_t *)lhs->array;
         mp_float_t *rarray = (mp_float_t *)rhs->array;
@@ -678,11 +738,11 @@ mp_obj_t carray_binary_subtract(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
             uint8_t *rarray = (uint8_t *)rhs->array;
             if(rhs->dtype == NDARRAY_UINT8) {
                 BINARY_LOOP_COMPLEX(results, resarray, uint8_t, larray, lstrides, rarray, rstrides, -);
-            } else if(rhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
                 BINARY_LOOP_COMPLEX(results, resarray, int8_t, larray, lstrides, rarray, rstrides, -);
             } else if(rhs->dtype == NDARRAY_UINT16) {
                 BINARY_LOOP_COMPLEX(results, resarray, uint16_t, larray, lstrides, rarray, rstrides, -);
-            } else if(rhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
                 BINARY_LOOP_COMPLEX(results, resarray, int16_t, larray, lstrides, rarray, rstrides, -);
             } else if(rhs->dtype == NDARRAY_FLOAT) {
                 BINARY_LOOP_COMPLEX(results, resarray, mp_float_t, larray, lstrides, rarray, rstrides, -);
@@ -701,11 +761,11 @@ mp_obj_t carray_binary_subtract(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
 
             if(lhs->dtype == NDARRAY_UINT8) {
                 BINARY_LOOP_COMPLEX_REVERSED_SUBTRACT(results, resarray, uint8_t, larray, lstrides, rarray, rstrides);
-            } else if(lhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
                 BINARY_LOOP_COMPLEX_REVERSED_SUBTRACT(results, resarray, int8_t, larray, lstrides, rarray, rstrides);
             } else if(lhs->dtype == NDARRAY_UINT16) {
                 BINARY_LOOP_COMPLEX_REVERSED_SUBTRACT(results, resarray, uint16_t, larray, lstrides, rarray, rstrides);
-            } else if(lhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
                 BINARY_LOOP_COMPLEX_REVERSED_SUBTRACT(results, resarray, int16_t, larray, lstrides, rarray, rstrides);
             } else if(lhs->dtype == NDARRAY_FLOAT) {
                 BINARY_LOOP_COMPLEX_REVERSED_SUBTRACT(results, resarray, mp_float_t, larray, lstrides, rarray, rstrides);
@@ -721,11 +781,11 @@ static void carray_binary_left_divide_(ndarray_obj_t *results, mp_float_t *resar
 
     if(rdtype == NDARRAY_UINT8) {
         BINARY_LOOP_COMPLEX(results, resarray, uint8_t, larray, lstrides, rarray, rstrides, /);
-    } else if(rdtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(rdtype, INT8)) {
         BINARY_LOOP_COMPLEX(results, resarray, int8_t, larray, lstrides, rarray, rstrides, /);
     } else if(rdtype == NDARRAY_UINT16) {
         BINARY_LOOP_COMPLEX(results, resarray, uint16_t, larray, lstrides, rarray, rstrides, /);
-    } else if(rdtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(rdtype, INT16)) {
         BINARY_LOOP_COMPLEX(results, resarray, int16_t, larray, lstrides, rarray, rstrides, /);
     } else if(rdtype == NDARRAY_FLOAT) {
         BINARY_LOOP_COMPLEX(results, resarray, mp_float_t, larray, lstrides, rarray, rstrides, /);
@@ -738,6 +798,10 @@ mp_obj_t carray_binary_divide(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
     ndarray_obj_t *results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_COMPLEX);
     mp_float_t *resarray = (mp_float_t *)results->array;
 
+    if(carray_binary_dense(results, lhs, rhs, lstrides, rstrides, MP_BINARY_OP_TRUE_DIVIDE)) {
+        return MP_OBJ_FROM_PTR(results);
+    }
+
     if((lhs->dtype == NDARRAY_COMPLEX) && (rhs->dtype == NDARRAY_COMPLEX)) {
         mp_float_t *larray = (mp_float_t *)lhs->array;
         mp_float_t *rarray = (mp_float_t *)rhs->array;
@@ -812,11 +876,11 @@ mp_obj_t carray_binary_divide(ndarray_obj_t *lhs, ndarray_obj_t *rhs,
         } else {
             if(lhs->dtype == NDARRAY_UINT8) {
                 BINARY_LOOP_COMPLEX_RIGHT_DIVIDE(results, resarray, uint8_t, larray, lstrides, rarray, rstrides);
-            } else if(lhs->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
                 BINARY_LOOP_COMPLEX_RIGHT_DIVIDE(results, resarray, int8_t, larray, lstrides, rarray, rstrides);
             } else if(lhs->dtype == NDARRAY_UINT16) {
                 BINARY_LOOP_COMPLEX_RIGHT_DIVIDE(results, resarray, uint16_t, larray, lstrides, rarray, rstrides);
-            } else if(lhs->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
                 BINARY_LOOP_COMPLEX_RIGHT_DIVIDE(results, resarray, int16_t, larray, lstrides, rarray, rstrides);
             } else if(lhs->dtype == NDARRAY_FLOAT) {
                 BINARY_LOOP_COMPLEX_RIGHT_DIVIDE(results, resarray, mp_float_t, larray, lstrides, rarray, rstrides);
@@ -20,10 +20,11 @@
 #include "../ulab.h"
 #include "../ndarray_operators.h"
 #include "../ulab_tools.h"
+#include "../ulab_simd.h"
 #include "carray/carray_tools.h"
 #include "compare.h"
 
-static mp_obj_t compare_function(mp_obj_t x1, mp_obj_t x2, uint8_t op) {
+static mp_obj_t compare_function(mp_obj_t x1, mp_obj_t x2, uint8_t op, mp_obj_t out) {
     ndarray_obj_t *lhs = ndarray_from_mp_obj(x1, 0);
     ndarray_obj_t *rhs = ndarray_from_mp_obj(x2, 0);
     #if ULAB_SUPPORTS_COMPLEX
@@ -31,15 +32,14 @@ static mp_obj_t compare_function(mp_obj_t x1, mp_obj_t x2, uint8_t op) {
         NOT_IMPLEMENTED_FOR_COMPLEX()
     }
     #endif
+    GENERIC_DTYPE_NOT_IMPLEMENTED(lhs->dtype)
+    GENERIC_DTYPE_NOT_IMPLEMENTED(rhs->dtype)
     uint8_t ndim = 0;
-    size_t *shape = m_new(size_t, ULAB_MAX_DIMS);
-    int32_t *lstrides = m_new(int32_t, ULAB_MAX_DIMS);
-    int32_t *rstrides = m_new(int32_t, ULAB_MAX_DIMS);
+    size_t shape[ULAB_MAX_DIMS] = { 0 };
+    int32_t lstrides[ULAB_MAX_DIMS] = { 0 };
+    int32_t rstrides[ULAB_MAX_DIMS] = { 0 };
     if(!ndarray_can_broadcast(lhs, rhs, &ndim, shape, lstrides, rstrides)) {
         mp_raise_ValueError(MP_ERROR_TEXT("operands could not be broadcast together"));
-        m_del(size_t, shape, ULAB_MAX_DIMS);
-        m_del(int32_t, lstrides, ULAB_MAX_DIMS);
-        m_del(int32_t, rstrides, ULAB_MAX_DIMS);
     }
 
     uint8_t *larray = (uint8_t *)lhs->array;
@@ -50,6 +50,24 @@ static mp_obj_t compare_function(mp_obj_t x1, mp_obj_t x2, uint8_t op) {
     } else if(op == COMPARE_NOT_EQUAL) {
         return ndarray_binary_equality(lhs, rhs, ndim, shape, lstrides, rstrides, MP_BINARY_OP_NOT_EQUAL);
     }
+
+    #if ULAB_HAS_SIMD
+    // operands of identical dtype preserve the type, so that dense operands can be
+    // handed to the vector kernels, provided that out is dense, too
+    if(ULAB_SIMD_SUPPORTS_DTYPE(lhs->dtype) && ndarray_binary_operands_are_dense(lhs, rhs, ndim, shape)) {
+        ndarray_obj_t *results;
+        if(out == mp_const_none) {
+            results = ndarray_new_dense_ndarray(ndim, shape, lhs->dtype);
+        } else {
+            results = tools_get_out_array(out, ndim, shape, lhs->dtype);
+        }
+        if(ndarray_is_contiguous(results)) {
+            ulab_simd_binary(lhs->dtype, op == COMPARE_MINIMUM ? ULAB_SIMD_MINIMUM : ULAB_SIMD_MAXIMUM,
+                            ULAB_SIMD_LAYOUT(lhs, rhs), results->array, lhs->array, rhs->array, results->len);
+            return MP_OBJ_FROM_PTR(results);
+        }
+    }
+    #endif
     // These are the upcasting rules
     // float always becomes float
     // operation on identical types preserves type
@@ -63,63 +81,63 @@ static mp_obj_t compare_function(mp_obj_t x1, mp_obj_t x2, uint8_t op) {
     // typecode of result, type_out, type_left, type_right, lhs operand, rhs operand, operator
     if(lhs->dtype == NDARRAY_UINT8) {
         if(rhs->dtype == NDARRAY_UINT8) {
-            RUN_COMPARE_LOOP(NDARRAY_UINT8, uint8_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
-        } else if(rhs->dtype == NDARRAY_INT8) {
-            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
+            RUN_COMPARE_LOOP(NDARRAY_UINT8, uint8_t, uint8_t, uint8_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
+            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, uint8_t, int8_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
         } else if(rhs->dtype == NDARRAY_UINT16) {
-            RUN_COMPARE_LOOP(NDARRAY_UINT16, uint16_t, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
-        } else if(rhs->dtype == NDARRAY_INT16) {
-            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
+            RUN_COMPARE_LOOP(NDARRAY_UINT16, uint16_t, uint8_t, uint16_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
+            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, uint8_t, int16_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
-            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, uint8_t, mp_float_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
+            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, uint8_t, mp_float_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
         }
-    } else if(lhs->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT8)) {
         if(rhs->dtype == NDARRAY_UINT8) {
-            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, int8_t, uint8_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
-        } else if(rhs->dtype == NDARRAY_INT8) {
-            RUN_COMPARE_LOOP(NDARRAY_INT8, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
+            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, int8_t, uint8_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
+            RUN_COMPARE_LOOP(NDARRAY_INT8, int8_t, int8_t, int8_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
         } else if(rhs->dtype == NDARRAY_UINT16) {
-            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, int8_t, uint16_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
-        } else if(rhs->dtype == NDARRAY_INT16) {
-            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, int8_t, int16_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
+            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, int8_t, uint16_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
+            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, int8_t, int16_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
-            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, int8_t, mp_float_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
+            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, int8_t, mp_float_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
         }
     } else if(lhs->dtype == NDARRAY_UINT16) {
         if(rhs->dtype == NDARRAY_UINT8) {
-            RUN_COMPARE_LOOP(NDARRAY_UINT16, uint16_t, uint16_t, uint8_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
-        } else if(rhs->dtype == NDARRAY_INT8) {
-            RUN_COMPARE_LOOP(NDARRAY_UINT16, uint16_t, uint16_t, int8_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
+            RUN_COMPARE_LOOP(NDARRAY_UINT16, uint16_t, uint16_t, uint8_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
+            RUN_COMPARE_LOOP(NDARRAY_UINT16, uint16_t, uint16_t, int8_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
         } else if(rhs->dtype == NDARRAY_UINT16) {
-            RUN_COMPARE_LOOP(NDARRAY_UINT16, uint16_t, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
-        } else if(rhs->dtype == NDARRAY_INT16) {
-            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
+            RUN_COMPARE_LOOP(NDARRAY_UINT16, uint16_t, uint16_t, uint16_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
+            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, uint16_t, int16_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
-            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, uint16_t, mp_float_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
+            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, uint16_t, mp_float_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
         }
-    } else if(lhs->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(lhs->dtype, INT16)) {
         if(rhs->dtype == NDARRAY_UINT8) {
-            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, int16_t, uint8_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
-        } else if(rhs->dtype == NDARRAY_INT8) {
-            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, int16_t, int8_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
+            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, int16_t, uint8_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
+            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, int16_t, int8_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
         } else if(rhs->dtype == NDARRAY_UINT16) {
-            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, int16_t, uint16_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
-        } else if(rhs->dtype == NDARRAY_INT16) {
-            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, int16_t, int16_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
+            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, int16_t, uint16_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
+            RUN_COMPARE_LOOP(NDARRAY_INT16, int16_t, int16_t, int16_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
-            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, int16_t, mp_float_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
+            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, int16_t, mp_float_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
         }
     } else if(lhs->dtype == NDARRAY_FLOAT) {
         if(rhs->dtype == NDARRAY_UINT8) {
-            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, mp_float_t, uint8_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
-        } else if(rhs->dtype == NDARRAY_INT8) {
-            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, mp_float_t, int8_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
+            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, mp_float_t, uint8_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT8)) {
+            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, mp_float_t, int8_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
         } else if(rhs->dtype == NDARRAY_UINT16) {
-            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, mp_float_t, uint16_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
-        } else if(rhs->dtype == NDARRAY_INT16) {
-            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, mp_float_t, int16_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
+            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, mp_float_t, uint16_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
+        } else if(ULAB_DTYPE_IS(rhs->dtype, INT16)) {
+            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, mp_float_t, int16_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
         } else if(rhs->dtype == NDARRAY_FLOAT) {
-            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, mp_float_t, mp_float_t, larray, lstrides, rarray, rstrides, ndim, shape, op);
+            RUN_COMPARE_LOOP(NDARRAY_FLOAT, mp_float_t, mp_float_t, mp_float_t, larray, lstrides, rarray, rstrides, ndim, shape, op, out);
         }
     }
     return mp_const_none; // we should never reach this point
@@ -128,7 +146,7 @@ static mp_obj_t compare_function(mp_obj_t x1, mp_obj_t x2, uint8_t op) {
 #if ULAB_NUMPY_HAS_EQUAL | ULAB_NUMPY_HAS_NOTEQUAL
 static mp_obj_t compare_equal_helper(mp_obj_t x1, mp_obj_t x2, uint8_t comptype) {
     // scalar comparisons should return a single object of mp_obj_t type
-    mp_obj_t result = compare_function(x1, x2, comptype);
+    mp_obj_t result = compare_function(x1, x2, comptype, mp_const_none);
     if((mp_obj_is_int(x1) || mp_obj_is_float(x1)) && (mp_obj_is_int(x2) || mp_obj_is_float(x2))) {
         mp_obj_iter_buf_t iter_buf;
         mp_obj_t iterable = mp_getiter(result, &iter_buf);
@@ -141,7 +159,22 @@ static mp_obj_t compare_equal_helper(mp_obj_t x1, mp_obj_t x2, uint8_t comptype)
 
 #if ULAB_NUMPY_HAS_CLIP
 
-mp_obj_t compare_clip(mp_obj_t x1, mp_obj_t x2, mp_obj_t x3) {
+mp_obj_t compare_clip(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_out, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t x1 = args[0].u_obj;
+    mp_obj_t x2 = args[1].u_obj;
+    mp_obj_t x3 = args[2].u_obj;
+    mp_obj_t out = args[3].u_obj;
+
     // Note: this function could be made faster by implementing a single-loop comparison in
     // RUN_COMPARE_LOOP. However, that would add around 2 kB of compile size, while we
     // would not gain a factor of two in speed, since the two comparisons should still be
@@ -158,11 +191,38 @@ mp_obj_t compare_clip(mp_obj_t x1, mp_obj_t x2, mp_obj_t x3) {
             return x1;
         }
     } else { // assume ndarrays
-        return compare_function(x2, compare_function(x1, x3, COMPARE_MINIMUM), COMPARE_MAXIMUM);
+        // The intermediate result can be stored in out, and the second comparison
+        // evaluated in place, if the dtype of the intermediate result is that of out.
+        // This is guaranteed, if x1 is a float, or if x1 and x3 are of the same type.
+        mp_obj_t tmp = mp_const_none;
+        if(mp_obj_is_type(out, &ulab_ndarray_type) && mp_obj_is_type(x1, &ulab_ndarray_type)) {
+            ndarray_obj_t *_out = MP_OBJ_TO_PTR(out);
+            ndarray_obj_t *_x1 = MP_OBJ_TO_PTR(x1);
+            if(_x1->dtype == _out->dtype) {
+                if(_x1->dtype == NDARRAY_FLOAT) {
+                    tmp = out;
+                } else if(mp_obj_is_type(x3, &ulab_ndarray_type)) {
+                    ndarray_obj_t *_x3 = MP_OBJ_TO_PTR(x3);
+                    tmp = _x3->dtype == _x1->dtype ? out : mp_const_none;
+                }
+            }
+            if(tmp != mp_const_none) {
+                // out has the shape of all three operands broadcast together, so it can hold
+                // the intermediate result only, if x2 does not extend the shape of x1, and x3
+                ndarray_obj_t *_x3 = ndarray_from_mp_obj(x3, 0);
+                for(uint8_t i = 0; i < ULAB_MAX_DIMS; i++) {
+                    if(MAX(_x1->shape[i], _x3->shape[i]) != _out->shape[i]) {
+                        tmp = mp_const_none;
+                        break;
+                    }
+                }
+            }
+        }
+        return compare_function(x2, compare_function(x1, x3, COMPARE_MINIMUM, tmp), COMPARE_MAXIMUM, out);
     }
 }
 
-MP_DEFINE_CONST_FUN_OBJ_3(compare_clip_obj, compare_clip);
+MP_DEFINE_CONST_FUN_OBJ_KW(compare_clip_obj, 3, compare_clip);
 #endif
 
 #if ULAB_NUMPY_HAS_EQUAL
@@ -285,64 +345,82 @@ mp_obj_t compare_isinf(mp_obj_t _x) {
 MP_DEFINE_CONST_FUN_OBJ_1(compare_isinf_obj, compare_isinf);
 #endif
 
-#if ULAB_NUMPY_HAS_MAXIMUM
-mp_obj_t compare_maximum(mp_obj_t x1, mp_obj_t x2) {
+#if ULAB_NUMPY_HAS_MAXIMUM | ULAB_NUMPY_HAS_MINIMUM
+static mp_obj_t compare_minimum_maximum(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args, uint8_t op) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_out, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t x1 = args[0].u_obj;
+    mp_obj_t x2 = args[1].u_obj;
+    mp_obj_t out = args[2].u_obj;
+
+    mp_obj_t result = compare_function(x1, x2, op, out);
     // extra round, so that we can return maximum(3, 4) properly
-    mp_obj_t result = compare_function(x1, x2, COMPARE_MAXIMUM);
-    if((mp_obj_is_int(x1) || mp_obj_is_float(x1)) && (mp_obj_is_int(x2) || mp_obj_is_float(x2))) {
+    if((out == mp_const_none) && (mp_obj_is_int(x1) || mp_obj_is_float(x1)) && (mp_obj_is_int(x2) || mp_obj_is_float(x2))) {
         ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(result);
-        return mp_binary_get_val_array(ndarray->dtype, ndarray->array, 0);
+        return ndarray_get_value(ndarray->dtype, ndarray->array, 0);
     }
     return result;
 }
+#endif /* ULAB_NUMPY_HAS_MAXIMUM | ULAB_NUMPY_HAS_MINIMUM */
+
+#if ULAB_NUMPY_HAS_MAXIMUM
+mp_obj_t compare_maximum(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    return compare_minimum_maximum(n_args, pos_args, kw_args, COMPARE_MAXIMUM);
+}
 
-MP_DEFINE_CONST_FUN_OBJ_2(compare_maximum_obj, compare_maximum);
+MP_DEFINE_CONST_FUN_OBJ_KW(compare_maximum_obj, 2, compare_maximum);
 #endif
 
 #if ULAB_NUMPY_HAS_MINIMUM
 
-mp_obj_t compare_minimum(mp_obj_t x1, mp_obj_t x2) {
-    // extra round, so that we can return minimum(3, 4) properly
-    mp_obj_t result = compare_function(x1, x2, COMPARE_MINIMUM);
-    if((mp_obj_is_int(x1) || mp_obj_is_float(x1)) && (mp_obj_is_int(x2) || mp_obj_is_float(x2))) {
-        ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(result);
-        return mp_binary_get_val_array(ndarray->dtype, ndarray->array, 0);
-    }
-    return result;
+mp_obj_t compare_minimum(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    return compare_minimum_maximum(n_args, pos_args, kw_args, COMPARE_MINIMUM);
 }
 
-MP_DEFINE_CONST_FUN_OBJ_2(compare_minimum_obj, compare_minimum);
+MP_DEFINE_CONST_FUN_OBJ_KW(compare_minimum_obj, 2, compare_minimum);
 #endif
 
-#if ULAB_NUMPY_HAS_NONZERO
-
-mp_obj_t compare_nonzero(mp_obj_t x) {
-    ndarray_obj_t *ndarray_x = ndarray_from_mp_obj(x, 0);
-    // since ndarray_new_linear_array calls m_new0, the content of zero is a single zero
-    ndarray_obj_t *zero = ndarray_new_linear_array(1, NDARRAY_UINT8);
-
-    uint8_t ndim = 0;
-    size_t *shape = m_new(size_t, ULAB_MAX_DIMS);
-    int32_t *x_strides = m_new(int32_t, ULAB_MAX_DIMS);
-    int32_t *zero_strides = m_new(int32_t, ULAB_MAX_DIMS);
-    // we don't actually have to inspect the outcome of ndarray_can_broadcast,
-    // because the right hand side is a linear array with a single element
-    ndarray_can_broadcast(ndarray_x, zero, &ndim, shape, x_strides, zero_strides);
-
-    // equal_obj is a Boolean ndarray
-    mp_obj_t equal_obj = ndarray_binary_equality(ndarray_x, zero, ndim, shape, x_strides, zero_strides, MP_BINARY_OP_NOT_EQUAL);
-    ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(equal_obj);
-
-    // these are no longer needed, get rid of them
-    m_del(size_t, shape, ULAB_MAX_DIMS);
-    m_del(int32_t, x_strides, ULAB_MAX_DIMS);
-    m_del(int32_t, zero_strides, ULAB_MAX_DIMS);
+#if ULAB_NUMPY_HAS_NONZERO | ULAB_NUMPY_HAS_COUNT_NONZERO | ULAB_NUMPY_HAS_FLATNONZERO
+static inline bool compare_is_nonzero(uint8_t *array, uint8_t dtype) {
+    if((dtype == NDARRAY_UINT8) || ULAB_DTYPE_IS(dtype, INT8)) {
+        return *array != 0;
+    } else if((dtype == NDARRAY_UINT16) || ULAB_DTYPE_IS(dtype, INT16)) {
+        return *(uint16_t *)array != 0;
+    }
+    #if ULAB_SUPPORTS_INT32
+    else if((dtype == NDARRAY_INT32) || (dtype == NDARRAY_UINT32)) {
+        return *(uint32_t *)array != 0;
+    }
+    #endif
+    #if ULAB_SUPPORTS_COMPLEX
+    else if(dtype == NDARRAY_COMPLEX) {
+        mp_float_t *c = (mp_float_t *)array;
+        return (c[0] != MICROPY_FLOAT_CONST(0.0)) || (c[1] != MICROPY_FLOAT_CONST(0.0));
+    }
+    #endif
+    else if(dtype == NDARRAY_FLOAT) {
+        return *(mp_float_t *)array != MICROPY_FLOAT_CONST(0.0);
+    }
+    return ndarray_get_float_value(array, dtype) != MICROPY_FLOAT_CONST(0.0);
+}
 
+static size_t compare_nonzero_scan(ndarray_obj_t *ndarray, uint16_t **arrays, uint8_t *flat, uint8_t flat_size) {
+    // counts the non-zero elements of ndarray in a single pass over the input, without a Boolean
+    // intermediate; if arrays is not NULL, the indices along each axis are written into arrays,
+    // and if flat is not NULL, the indices into the flattened array are written into flat
+    if(ndarray->len == 0) {
+        return 0;
+    }
     uint8_t *array = (uint8_t *)ndarray->array;
-    uint8_t *origin = (uint8_t *)ndarray->array;
-
-    // First, count the number of Trues:
-    uint16_t count = 0;
+    size_t count = 0;
+    size_t n = 0;
     size_t indices[ULAB_MAX_DIMS];
 
     #if ULAB_MAX_DIMS > 3
@@ -359,9 +437,22 @@ mp_obj_t compare_nonzero(mp_obj_t x) {
             #endif
                 indices[0] = 0;
                 do {
-                    if(*array != 0) {
+                    if(compare_is_nonzero(array, ndarray->dtype)) {
+                        if(arrays != NULL) {
+                            for(uint8_t d = 0; d < ndarray->ndim; d++) {
+                                arrays[ULAB_MAX_DIMS - 1 - d][count] = indices[d];
+                            }
+                        }
+                        if(flat != NULL) {
+                            if(flat_size == sizeof(uint16_t)) {
+                                ((uint16_t *)flat)[count] = (uint16_t)n;
+                            } else {
+                                ((uint32_t *)flat)[count] = (uint32_t)n;
+                            }
+                        }
                         count++;
                     }
+                    n++;
                     array += ndarray->strides[ULAB_MAX_DIMS - 1];
                     indices[0]++;
                 } while(indices[0] < ndarray->shape[ULAB_MAX_DIMS - 1]);
@@ -383,6 +474,59 @@ mp_obj_t compare_nonzero(mp_obj_t x) {
         indices[3]++;
     } while(indices[3] < ndarray->shape[ULAB_MAX_DIMS - 4]);
     #endif
+    return count;
+}
+#endif
+
+#if ULAB_NUMPY_HAS_COUNT_NONZERO
+//| def count_nonzero(a: _ArrayLike) -> int:
+//|     """Return the number of non-zero elements of a"""
+//|     ...
+//|
+
+mp_obj_t compare_count_nonzero(mp_obj_t x) {
+    ndarray_obj_t *ndarray = ndarray_from_mp_obj(x, 0);
+    return mp_obj_new_int_from_uint(compare_nonzero_scan(ndarray, NULL, NULL, 0));
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(compare_count_nonzero_obj, compare_count_nonzero);
+#endif /* ULAB_NUMPY_HAS_COUNT_NONZERO */
+
+#if ULAB_NUMPY_HAS_FLATNONZERO
+//| def flatnonzero(a: _ArrayLike) -> ulab.numpy.ndarray:
+//|     """Return the indices of the non-zero elements of the flattened a"""
+//|     ...
+//|
+
+mp_obj_t compare_flatnonzero(mp_obj_t x) {
+    ndarray_obj_t *ndarray = ndarray_from_mp_obj(x, 0);
+    uint8_t dtype = NDARRAY_UINT16;
+    if(ndarray->len > (size_t)UINT16_MAX + 1) {
+        #if ULAB_SUPPORTS_INT32
+        dtype = NDARRAY_UINT32;
+        #else
+        mp_raise_ValueError(MP_ERROR_TEXT("indices do not fit into uint16"));
+        #endif
+    }
+    // the elements are counted first, so that the indices can be written into an exact-sized array
+    size_t count = compare_nonzero_scan(ndarray, NULL, NULL, 0);
+    ndarray_obj_t *results = ndarray_new_linear_array(count, dtype);
+    if(count > 0) {
+        compare_nonzero_scan(ndarray, NULL, (uint8_t *)results->array, results->itemsize);
+    }
+    return MP_OBJ_FROM_PTR(results);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(compare_flatnonzero_obj, compare_flatnonzero);
+#endif /* ULAB_NUMPY_HAS_FLATNONZERO */
+
+#if ULAB_NUMPY_HAS_NONZERO
+
+mp_obj_t compare_nonzero(mp_obj_t x) {
+    ndarray_obj_t *ndarray = ndarray_from_mp_obj(x, 0);
+
+    // First, count the number of Trues, then fill in the indices
+    size_t count = compare_nonzero_scan(ndarray, NULL, NULL, 0);
 
     mp_obj_t *items = m_new(mp_obj_t, ndarray->ndim);
     uint16_t *arrays[ULAB_MAX_DIMS];
@@ -393,51 +537,9 @@ mp_obj_t compare_nonzero(mp_obj_t x) {
         arrays[ULAB_MAX_DIMS - 1 - i] = iarray;
         items[ndarray->ndim - 1 - i] = MP_OBJ_FROM_PTR(item_array);
     }
-    array = origin;
-    count = 0;
-
-    #if ULAB_MAX_DIMS > 3
-    indices[3] = 0;
-    do {
-    #endif
-        #if ULAB_MAX_DIMS > 2
-        indices[2] = 0;
-        do {
-        #endif
-            #if ULAB_MAX_DIMS > 1
-            indices[1] = 0;
-            do {
-            #endif
-                indices[0] = 0;
-                do {
-                    if(*array != 0) {
-                        for(uint8_t d = 0; d < ndarray->ndim; d++) {
-                            arrays[ULAB_MAX_DIMS - 1 - d][count] = indices[d];
-                        }
-                        count++;
-                    }
-                    array += ndarray->strides[ULAB_MAX_DIMS - 1];
-                    indices[0]++;
-                } while(indices[0] < ndarray->shape[ULAB_MAX_DIMS - 1]);
-            #if ULAB_MAX_DIMS > 1
-                array -= ndarray->strides[ULAB_MAX_DIMS - 1] * ndarray->shape[ULAB_MAX_DIMS-1];
-                array += ndarray->strides[ULAB_MAX_DIMS - 2];
-                indices[1]++;
-            } while(indices[1] < ndarray->shape[ULAB_MAX_DIMS - 2]);
-            #endif
-        #if ULAB_MAX_DIMS > 2
-            array -= ndarray->strides[ULAB_MAX_DIMS - 2] * ndarray->shape[ULAB_MAX_DIMS-2];
-            array += ndarray->strides[ULAB_MAX_DIMS - 3];
-            indices[2]++;
-        } while(indices[2] < ndarray->shape[ULAB_MAX_DIMS - 3]);
-        #endif
-    #if ULAB_MAX_DIMS > 3
-        array -= ndarray->strides[ULAB_MAX_DIMS - 3] * ndarray->shape[ULAB_MAX_DIMS-3];
-        array += ndarray->strides[ULAB_MAX_DIMS - 4];
-        indices[3]++;
-    } while(indices[3] < ndarray->shape[ULAB_MAX_DIMS - 4]);
-    #endif
-
+    if(count > 0) {
+        compare_nonzero_scan(ndarray, arrays, NULL, 0);
+    }
     return mp_obj_new_tuple(ndarray->ndim, items);
 }
 
@@ -456,11 +558,11 @@ mp_obj_t compare_where(mp_obj_t _condition, mp_obj_t _x, mp_obj_t _y) {
     COMPLEX_DTYPE_NOT_IMPLEMENTED(x->dtype)
     COMPLEX_DTYPE_NOT_IMPLEMENTED(y->dtype)
 
-    int32_t *cstrides = m_new(int32_t, ULAB_MAX_DIMS);
-    int32_t *xstrides = m_new(int32_t, ULAB_MAX_DIMS);
-    int32_t *ystrides = m_new(int32_t, ULAB_MAX_DIMS);
+    int32_t cstrides[ULAB_MAX_DIMS];
+    int32_t xstrides[ULAB_MAX_DIMS];
+    int32_t ystrides[ULAB_MAX_DIMS];
 
-    size_t *oshape = m_new(size_t, ULAB_MAX_DIMS);
+    size_t oshape[ULAB_MAX_DIMS];
 
     uint8_t ndim;
 
@@ -495,6 +597,32 @@ mp_obj_t compare_where(mp_obj_t _condition, mp_obj_t _x, mp_obj_t _y) {
     uint8_t *xarray = (uint8_t *)x->array;
     uint8_t *yarray = (uint8_t *)y->array;
 
+    // with a Boolean condition, and operands of the output dtype, the rows are copied by the typed
+    // COMPARE_WHERE_ROW, instead of converting each element to float, and back; scalar operands,
+    // e.g., the 0 in where(a > t, a, 0), are converted to the output dtype once, beforehand
+    mp_float_t xbuffer[2], ybuffer[2];
+    bool typed = (c->dtype == NDARRAY_UINT8) && ((out_dtype == NDARRAY_UINT8) || ULAB_DTYPE_IS(out_dtype, INT8) ||
+                (out_dtype == NDARRAY_UINT16) || ULAB_DTYPE_IS(out_dtype, INT16) || (out_dtype == NDARRAY_FLOAT) ||
+                ULAB_DTYPE_IS(out_dtype, INT32) || ULAB_DTYPE_IS(out_dtype, UINT32));
+    if(typed && (x->dtype != out_dtype)) {
+        typed = x->len == 1;
+        ofunc(xbuffer, xfunc(xarray));
+        xarray = (uint8_t *)xbuffer;
+    }
+    if(typed && (y->dtype != out_dtype)) {
+        typed = y->len == 1;
+        ofunc(ybuffer, yfunc(yarray));
+        yarray = (uint8_t *)ybuffer;
+    }
+    if(!typed) {
+        xarray = (uint8_t *)x->array;
+        yarray = (uint8_t *)y->array;
+    }
+    int32_t cs = cstrides[ULAB_MAX_DIMS - 1];
+    int32_t xs = xstrides[ULAB_MAX_DIMS - 1];
+    int32_t ys = ystrides[ULAB_MAX_DIMS - 1];
+    size_t len = out->shape[ULAB_MAX_DIMS - 1];
+
     #if ULAB_MAX_DIMS > 3
     size_t i = 0;
     do {
@@ -507,22 +635,48 @@ mp_obj_t compare_where(mp_obj_t _condition, mp_obj_t _x, mp_obj_t _y) {
             size_t k = 0;
             do {
             #endif
-                size_t l = 0;
-                do {
-                    mp_float_t value;
-                    mp_float_t cvalue = cfunc(carray);
-                    if(cvalue != MICROPY_FLOAT_CONST(0.0)) {
-                        value = xfunc(xarray);
-                    } else {
-                        value = yfunc(yarray);
+                if(typed) {
+                    if(out_dtype == NDARRAY_UINT8) {
+                        COMPARE_WHERE_ROW(uint8_t, oarray, carray, cs, xarray, xs, yarray, ys, len);
+                    } else if(ULAB_DTYPE_IS(out_dtype, INT8)) {
+                        COMPARE_WHERE_ROW(int8_t, oarray, carray, cs, xarray, xs, yarray, ys, len);
+                    } else if(out_dtype == NDARRAY_UINT16) {
+                        COMPARE_WHERE_ROW(uint16_t, oarray, carray, cs, xarray, xs, yarray, ys, len);
+                    } else if(ULAB_DTYPE_IS(out_dtype, INT16)) {
+                        COMPARE_WHERE_ROW(int16_t, oarray, carray, cs, xarray, xs, yarray, ys, len);
                     }
-                    ofunc(oarray, value);
-                    oarray += out->itemsize;
-                    carray += cstrides[ULAB_MAX_DIMS - 1];
-                    xarray += xstrides[ULAB_MAX_DIMS - 1];
-                    yarray += ystrides[ULAB_MAX_DIMS - 1];
-                    l++;
-                } while(l < out->shape[ULAB_MAX_DIMS - 1]);
+                    #if ULAB_SUPPORTS_INT32
+                    else if(out_dtype == NDARRAY_INT32) {
+                        COMPARE_WHERE_ROW(int32_t, oarray, carray, cs, xarray, xs, yarray, ys, len);
+                    } else if(out_dtype == NDARRAY_UINT32) {
+                        COMPARE_WHERE_ROW(uint32_t, oarray, carray, cs, xarray, xs, yarray, ys, len);
+                    }
+                    #endif
+                    else {
+                        COMPARE_WHERE_ROW(mp_float_t, oarray, carray, cs, xarray, xs, yarray, ys, len);
+                    }
+                    oarray += out->itemsize * len;
+                    carray += cs * len;
+                    xarray += xs * len;
+                    yarray += ys * len;
+                } else {
+                    size_t l = 0;
+                    do {
+                        mp_float_t value;
+                        mp_float_t cvalue = cfunc(carray);
+                        if(cvalue != MICROPY_FLOAT_CONST(0.0)) {
+                            value = xfunc(xarray);
+                        } else {
+                            value = yfunc(yarray);
+                        }
+                        ofunc(oarray, value);
+                        oarray += out->itemsize;
+                        carray += cs;
+                        xarray += xs;
+                        yarray += ys;
+                        l++;
+                    } while(l < len);
+                }
             #if ULAB_MAX_DIMS > 1
                 carray -= cstrides[ULAB_MAX_DIMS - 1] * c->shape[ULAB_MAX_DIMS-1];
                 carray += cstrides[ULAB_MAX_DIMS - 2];
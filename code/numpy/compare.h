@@ -23,12 +23,14 @@ enum COMPARE_FUNCTION_TYPE {
     COMPARE_CLIP,
 };
 
-MP_DECLARE_CONST_FUN_OBJ_3(compare_clip_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(compare_clip_obj);
+MP_DECLARE_CONST_FUN_OBJ_1(compare_count_nonzero_obj);
 MP_DECLARE_CONST_FUN_OBJ_2(compare_equal_obj);
+MP_DECLARE_CONST_FUN_OBJ_1(compare_flatnonzero_obj);
 MP_DECLARE_CONST_FUN_OBJ_2(compare_isfinite_obj);
 MP_DECLARE_CONST_FUN_OBJ_2(compare_isinf_obj);
-MP_DECLARE_CONST_FUN_OBJ_2(compare_minimum_obj);
-MP_DECLARE_CONST_FUN_OBJ_2(compare_maximum_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(compare_minimum_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(compare_maximum_obj);
 MP_DECLARE_CONST_FUN_OBJ_1(compare_nonzero_obj);
 MP_DECLARE_CONST_FUN_OBJ_2(compare_not_equal_obj);
 MP_DECLARE_CONST_FUN_OBJ_3(compare_where_obj);
@@ -63,6 +65,8 @@ MP_DECLARE_CONST_FUN_OBJ_3(compare_where_obj);
         (larray) += (lstrides)[ULAB_MAX_DIMS - 2];\
         (rarray) -= (rstrides)[ULAB_MAX_DIMS - 1] * results->shape[ULAB_MAX_DIMS-1];\
         (rarray) += (rstrides)[ULAB_MAX_DIMS - 2];\
+        (array) -= (results)->strides[ULAB_MAX_DIMS - 1] * results->shape[ULAB_MAX_DIMS-1];\
+        (array) += (results)->strides[ULAB_MAX_DIMS - 2];\
         k++;\
     } while(k <  results->shape[ULAB_MAX_DIMS - 2]);\
     return MP_OBJ_FROM_PTR(results);\
@@ -87,12 +91,16 @@ MP_DECLARE_CONST_FUN_OBJ_3(compare_where_obj);
             (larray) += (lstrides)[ULAB_MAX_DIMS - 2];\
             (rarray) -= (rstrides)[ULAB_MAX_DIMS - 1] * results->shape[ULAB_MAX_DIMS-1];\
             (rarray) += (rstrides)[ULAB_MAX_DIMS - 2];\
+            (array) -= (results)->strides[ULAB_MAX_DIMS - 1] * results->shape[ULAB_MAX_DIMS-1];\
+            (array) += (results)->strides[ULAB_MAX_DIMS - 2];\
             k++;\
         } while(k <  results->shape[ULAB_MAX_DIMS - 2]);\
         (larray) -= (lstrides)[ULAB_MAX_DIMS - 2] * results->shape[ULAB_MAX_DIMS-2];\
         (larray) += (lstrides)[ULAB_MAX_DIMS - 3];\
         (rarray) -= (rstrides)[ULAB_MAX_DIMS - 2] * results->shape[ULAB_MAX_DIMS-2];\
         (rarray) += (rstrides)[ULAB_MAX_DIMS - 3];\
+        (array) -= (results)->strides[ULAB_MAX_DIMS - 2] * results->shape[ULAB_MAX_DIMS-2];\
+        (array) += (results)->strides[ULAB_MAX_DIMS - 3];\
         j++;\
     } while(j <  results->shape[ULAB_MAX_DIMS - 3]);\
     return MP_OBJ_FROM_PTR(results);\
@@ -119,26 +127,75 @@ MP_DECLARE_CONST_FUN_OBJ_3(compare_where_obj);
                 (larray) += (lstrides)[ULAB_MAX_DIMS - 2];\
                 (rarray) -= (rstrides)[ULAB_MAX_DIMS - 1] * results->shape[ULAB_MAX_DIMS-1];\
                 (rarray) += (rstrides)[ULAB_MAX_DIMS - 2];\
+                (array) -= (results)->strides[ULAB_MAX_DIMS - 1] * results->shape[ULAB_MAX_DIMS-1];\
+                (array) += (results)->strides[ULAB_MAX_DIMS - 2];\
                 k++;\
             } while(k <  results->shape[ULAB_MAX_DIMS - 2]);\
             (larray) -= (lstrides)[ULAB_MAX_DIMS - 2] * results->shape[ULAB_MAX_DIMS-2];\
             (larray) += (lstrides)[ULAB_MAX_DIMS - 3];\
             (rarray) -= (rstrides)[ULAB_MAX_DIMS - 2] * results->shape[ULAB_MAX_DIMS-2];\
             (rarray) += (rstrides)[ULAB_MAX_DIMS - 3];\
+            (array) -= (results)->strides[ULAB_MAX_DIMS - 2] * results->shape[ULAB_MAX_DIMS-2];\
+            (array) += (results)->strides[ULAB_MAX_DIMS - 3];\
             j++;\
         } while(j <  results->shape[ULAB_MAX_DIMS - 3]);\
         (larray) -= (lstrides)[ULAB_MAX_DIMS - 3] * results->shape[ULAB_MAX_DIMS-3];\
         (larray) += (lstrides)[ULAB_MAX_DIMS - 4];\
         (rarray) -= (rstrides)[ULAB_MAX_DIMS - 3] * results->shape[ULAB_MAX_DIMS-3];\
         (rarray) += (rstrides)[ULAB_MAX_DIMS - 4];\
+        (array) -= (results)->strides[ULAB_MAX_DIMS - 3] * results->shape[ULAB_MAX_DIMS-3];\
+        (array) += (results)->strides[ULAB_MAX_DIMS - 4];\
         i++;\
     } while(i <  results->shape[ULAB_MAX_DIMS - 4]);\
     return MP_OBJ_FROM_PTR(results);\
 
 #endif // ULAB_MAX_DIMS == 4
 
-#define RUN_COMPARE_LOOP(dtype, type_out, type_left, type_right, larray, lstrides, rarray, rstrides, ndim, shape, op) do {\
-    ndarray_obj_t *results = ndarray_new_dense_ndarray((ndim), (shape), (dtype));\
+// a single row of where: the condition is a Boolean, or uint8, the operands are of the dtype of
+// the output, and an operand with a zero stride is loaded once only, so that it stays in a register
+#define COMPARE_WHERE_ROW(type, oarray, carray, cs, xarray, xs, yarray, ys, len) do {\
+    type *_o = (type *)(oarray);\
+    uint8_t *_c = (carray);\
+    uint8_t *_x = (xarray);\
+    uint8_t *_y = (yarray);\
+    if(((xs) == 0) && ((ys) == 0)) {\
+        type _xv = *(type *)_x;\
+        type _yv = *(type *)_y;\
+        for(size_t _l = 0; _l < (len); _l++) {\
+            *_o++ = *_c ? _xv : _yv;\
+            _c += (cs);\
+        }\
+    } else if((ys) == 0) {\
+        type _yv = *(type *)_y;\
+        for(size_t _l = 0; _l < (len); _l++) {\
+            *_o++ = *_c ? *(type *)_x : _yv;\
+            _c += (cs);\
+            _x += (xs);\
+        }\
+    } else if((xs) == 0) {\
+        type _xv = *(type *)_x;\
+        for(size_t _l = 0; _l < (len); _l++) {\
+            *_o++ = *_c ? _xv : *(type *)_y;\
+            _c += (cs);\
+            _y += (ys);\
+        }\
+    } else {\
+        for(size_t _l = 0; _l < (len); _l++) {\
+            *_o++ = *_c ? *(type *)_x : *(type *)_y;\
+            _c += (cs);\
+            _x += (xs);\
+            _y += (ys);\
+        }\
+    }\
+} while(0)
+
+#define RUN_COMPARE_LOOP(dtype, type_out, type_left, type_right, larray, lstrides, rarray, rstrides, ndim, shape, op, out) do {\
+    ndarray_obj_t *results;\
+    if((out) == mp_const_none) {\
+        results = ndarray_new_dense_ndarray((ndim), (shape), (dtype));\
+    } else {\
+        results = tools_get_out_array((out), (ndim), (shape), (dtype));\
+    }\
     uint8_t *array = (uint8_t *)results->array;\
     if((op) == COMPARE_MINIMUM) {\
         COMPARE_LOOP(results, array, type_out, type_left, type_right, larray, lstrides, rarray, rstrides, <);\
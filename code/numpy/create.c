@@ -22,20 +22,20 @@
 #include "../ulab_tools.h"
 
 #if ULAB_NUMPY_HAS_ONES | ULAB_NUMPY_HAS_ZEROS | ULAB_NUMPY_HAS_FULL | ULAB_NUMPY_HAS_EMPTY
-static mp_obj_t create_zeros_ones_full(mp_obj_t oshape, uint8_t dtype, mp_obj_t value) {
+static mp_obj_t create_zeros_ones_full(mp_obj_t oshape, uint8_t dtype, mp_obj_t value, mp_obj_t memory) {
     if(!mp_obj_is_int(oshape) && !mp_obj_is_type(oshape, &mp_type_tuple) && !mp_obj_is_type(oshape, &mp_type_list)) {
         mp_raise_TypeError(MP_ERROR_TEXT("input argument must be an integer, a tuple, or a list"));
     }
-    ndarray_obj_t *ndarray = NULL;
+    uint8_t policy = ulab_memory_get_policy(memory);
+    size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
+    uint8_t len = 1;
     if(mp_obj_is_int(oshape)) {
-        size_t n = mp_obj_get_int(oshape);
-        ndarray = ndarray_new_linear_array(n, dtype);
-    } else if(mp_obj_is_type(oshape, &mp_type_tuple) || mp_obj_is_type(oshape, &mp_type_list)) {
-        uint8_t len = (uint8_t)mp_obj_get_int(mp_obj_len_maybe(oshape));
+        shape[ULAB_MAX_DIMS - 1] = (size_t)mp_obj_get_int(oshape);
+    } else {
+        len = (uint8_t)mp_obj_get_int(mp_obj_len_maybe(oshape));
         if(len > ULAB_MAX_DIMS) {
             mp_raise_TypeError(MP_ERROR_TEXT("too many dimensions"));
         }
-        size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
 
         size_t i = 0;
         mp_obj_iter_buf_t iter_buf;
@@ -44,8 +44,13 @@ static mp_obj_t create_zeros_ones_full(mp_obj_t oshape, uint8_t dtype, mp_obj_t
             shape[ULAB_MAX_DIMS - len + i] = (size_t)mp_obj_get_int(item);
             i++;
         }
-        ndarray = ndarray_new_dense_ndarray(len, shape, dtype);
     }
+    int32_t *strides = m_new(int32_t, ULAB_MAX_DIMS);
+    strides[ULAB_MAX_DIMS - 1] = (int32_t)ulab_binary_get_size(dtype);
+    for(uint8_t i = ULAB_MAX_DIMS; i > 1; i--) {
+        strides[i - 2] = strides[i - 1] * MAX(1, shape[i - 1]);
+    }
+    ndarray_obj_t *ndarray = ndarray_new_ndarray_with_memory(len, shape, strides, dtype, policy);
     if(value != mp_const_none) {
         if(dtype == NDARRAY_BOOL) {
             dtype = NDARRAY_UINT8;
@@ -84,12 +89,22 @@ static ndarray_obj_t *create_linspace_arange(mp_float_t start, mp_float_t step,
         }
     } else if(dtype == NDARRAY_UINT8) {
         ARANGE_LOOP(uint8_t, ndarray, len, step, stop);
-    } else if(dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {
         ARANGE_LOOP(int8_t, ndarray, len, step, stop);
     } else if(dtype == NDARRAY_UINT16) {
         ARANGE_LOOP(uint16_t, ndarray, len, step, stop);
-    } else if(dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {
         ARANGE_LOOP(int16_t, ndarray, len, step, stop);
+    #if ULAB_HAS_GENERIC_DTYPES
+    } else if(ULAB_DTYPE_IS_GENERIC(dtype)) {
+        void (*set)(void *, mp_float_t) = ndarray_set_float_function(dtype);
+        uint8_t *array = (uint8_t *)ndarray->array;
+        for(size_t i = 0; i < len - 1; i++, value += step) {
+            set(array, value);
+            array += ndarray->itemsize;
+        }
+        set(array, stop);
+    #endif
     } else {
         ARANGE_LOOP(mp_float_t, ndarray, len, step, stop);
     }
@@ -132,17 +147,17 @@ mp_obj_t create_arange(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_arg
         start = MICROPY_FLOAT_CONST(0.0);
         stop = mp_obj_get_float(args[0].u_obj);
         step = MICROPY_FLOAT_CONST(1.0);
-        if(mp_obj_is_int(args[0].u_obj)) dtype = NDARRAY_INT16;
+        if(mp_obj_is_int(args[0].u_obj)) dtype = NDARRAY_INT_DEFAULT;
     } else if(n_args == 2) {
         start = mp_obj_get_float(args[0].u_obj);
         stop = mp_obj_get_float(args[1].u_obj);
         step = MICROPY_FLOAT_CONST(1.0);
-        if(mp_obj_is_int(args[0].u_obj) && mp_obj_is_int(args[1].u_obj)) dtype = NDARRAY_INT16;
+        if(mp_obj_is_int(args[0].u_obj) && mp_obj_is_int(args[1].u_obj)) dtype = NDARRAY_INT_DEFAULT;
     } else if(n_args == 3) {
         start = mp_obj_get_float(args[0].u_obj);
         stop = mp_obj_get_float(args[1].u_obj);
         step = mp_obj_get_float(args[2].u_obj);
-        if(mp_obj_is_int(args[0].u_obj) && mp_obj_is_int(args[1].u_obj) && mp_obj_is_int(args[2].u_obj)) dtype = NDARRAY_INT16;
+        if(mp_obj_is_int(args[0].u_obj) && mp_obj_is_int(args[1].u_obj) && mp_obj_is_int(args[2].u_obj)) dtype = NDARRAY_INT_DEFAULT;
     } else {
         mp_raise_TypeError(MP_ERROR_TEXT("wrong number of arguments"));
     }
@@ -307,49 +322,67 @@ mp_obj_t create_concatenate(size_t n_args, const mp_obj_t *pos_args, mp_map_t *k
         uint8_t *sarray = (uint8_t *)source->array;
         tarray = tpos;
 
-        #if ULAB_MAX_DIMS > 3
-        size_t i = 0;
-        do {
-        #endif
-            #if ULAB_MAX_DIMS > 2
-            size_t j = 0;
+        if(ndarray_is_contiguous(source)) {
+            // the blocks of the source along the leading axes are contiguous in the target, too,
+            // so that each of them can be copied in one go
+            size_t blocks = 1;
+            for(uint8_t j = ULAB_MAX_DIMS - ndim; j < axis; j++) {
+                blocks *= source->shape[j];
+            }
+            if(blocks > 0) {
+                size_t ssize = source->len / blocks * source->itemsize;
+                size_t tsize = target->len / blocks * target->itemsize;
+                for(size_t b = 0; b < blocks; b++) {
+                    memcpy(tarray, sarray, ssize);
+                    tarray += tsize;
+                    sarray += ssize;
+                }
+            }
+        } else {
+            #if ULAB_MAX_DIMS > 3
+            size_t i = 0;
             do {
             #endif
-                #if ULAB_MAX_DIMS > 1
-                size_t k = 0;
+                #if ULAB_MAX_DIMS > 2
+                size_t j = 0;
                 do {
                 #endif
-                    size_t l = 0;
+                    #if ULAB_MAX_DIMS > 1
+                    size_t k = 0;
                     do {
-                        memcpy(tarray, sarray, source->itemsize);
-                        tarray += target->strides[ULAB_MAX_DIMS - 1];
-                        sarray += source->strides[ULAB_MAX_DIMS - 1];
-                        l++;
-                    } while(l < source->shape[ULAB_MAX_DIMS - 1]);
-                #if ULAB_MAX_DIMS > 1
-                    tarray -= target->strides[ULAB_MAX_DIMS - 1] * source->shape[ULAB_MAX_DIMS-1];
-                    tarray += target->strides[ULAB_MAX_DIMS - 2];
-                    sarray -= source->strides[ULAB_MAX_DIMS - 1] * source->shape[ULAB_MAX_DIMS-1];
-                    sarray += source->strides[ULAB_MAX_DIMS - 2];
-                    k++;
-                } while(k < source->shape[ULAB_MAX_DIMS - 2]);
+                    #endif
+                        size_t l = 0;
+                        do {
+                            memcpy(tarray, sarray, source->itemsize);
+                            tarray += target->strides[ULAB_MAX_DIMS - 1];
+                            sarray += source->strides[ULAB_MAX_DIMS - 1];
+                            l++;
+                        } while(l < source->shape[ULAB_MAX_DIMS - 1]);
+                    #if ULAB_MAX_DIMS > 1
+                        tarray -= target->strides[ULAB_MAX_DIMS - 1] * source->shape[ULAB_MAX_DIMS-1];
+                        tarray += target->strides[ULAB_MAX_DIMS - 2];
+                        sarray -= source->strides[ULAB_MAX_DIMS - 1] * source->shape[ULAB_MAX_DIMS-1];
+                        sarray += source->strides[ULAB_MAX_DIMS - 2];
+                        k++;
+                    } while(k < source->shape[ULAB_MAX_DIMS - 2]);
+                    #endif
+                #if ULAB_MAX_DIMS > 2
+                    tarray -= target->strides[ULAB_MAX_DIMS - 2] * source->shape[ULAB_MAX_DIMS-2];
+                    tarray += target->strides[ULAB_MAX_DIMS - 3];
+                    sarray -= source->strides[ULAB_MAX_DIMS - 2] * source->shape[ULAB_MAX_DIMS-2];
+                    sarray += source->strides[ULAB_MAX_DIMS - 3];
+                    j++;
+                } while(j < source->shape[ULAB_MAX_DIMS - 3]);
                 #endif
-            #if ULAB_MAX_DIMS > 2
-                tarray -= target->strides[ULAB_MAX_DIMS - 2] * source->shape[ULAB_MAX_DIMS-2];
-                tarray += target->strides[ULAB_MAX_DIMS - 3];
-                sarray -= source->strides[ULAB_MAX_DIMS - 2] * source->shape[ULAB_MAX_DIMS-2];
-                sarray += source->strides[ULAB_MAX_DIMS - 3];
-                j++;
-            } while(j < source->shape[ULAB_MAX_DIMS - 3]);
+            #if ULAB_MAX_DIMS > 3
+                tarray -= target->strides[ULAB_MAX_DIMS - 3] * source->shape[ULAB_MAX_DIMS-3];
+                tarray += target->strides[ULAB_MAX_DIMS - 4];
+                sarray -= source->strides[ULAB_MAX_DIMS - 3] * source->shape[ULAB_MAX_DIMS-3];
+                sarray += source->strides[ULAB_MAX_DIMS - 4];
+                i++;
+            } while(i < source->shape[ULAB_MAX_DIMS - 4]);
             #endif
-        #if ULAB_MAX_DIMS > 3
-            tarray -= target->strides[ULAB_MAX_DIMS - 3] * source->shape[ULAB_MAX_DIMS-3];
-            tarray += target->strides[ULAB_MAX_DIMS - 4];
-            sarray -= source->strides[ULAB_MAX_DIMS - 3] * source->shape[ULAB_MAX_DIMS-3];
-            sarray += source->strides[ULAB_MAX_DIMS - 4];
-            i++;
-        } while(i < source->shape[ULAB_MAX_DIMS - 4]);
-        #endif
+        }
         if(p < ndarrays->len - 1) {
             tpos += target->strides[axis] * source->shape[axis];
         }
@@ -444,12 +477,14 @@ MP_DEFINE_CONST_FUN_OBJ_KW(create_diag_obj, 1, create_diag);
 #if ULAB_NUMPY_HAS_EMPTY
 // This function is bound in numpy.c to numpy.zeros(), and is simply an alias for that
 
-//| def empty(shape: Union[int, Tuple[int, ...]], *, dtype: _DType = ulab.numpy.float) -> ulab.numpy.ndarray:
+//| def empty(shape: Union[int, Tuple[int, ...]], *, dtype: _DType = ulab.numpy.float, memory: Optional[str] = None) -> ulab.numpy.ndarray:
 //|    """
 //|    .. param: shape
 //|       Shape of the array, either an integer (for a 1-D array) or a tuple of 2 integers (for a 2-D array)
 //|    .. param: dtype
 //|       Type of values in the array
+//|    .. param: memory
+//|       'gc', or 'external', the memory in which the values are stored
 //|
 //|    Return a new array of the given shape with all elements set to 0. An alias for numpy.zeros."""
 //|    ...
@@ -509,7 +544,7 @@ MP_DEFINE_CONST_FUN_OBJ_KW(create_eye_obj, 1, create_eye);
 #endif /* ULAB_MAX_DIMS > 1 */
 
 #if ULAB_NUMPY_HAS_FULL
-//| def full(shape: Union[int, Tuple[int, ...]], fill_value: Union[_float, _bool], *, dtype: _DType = ulab.numpy.float) -> ulab.numpy.ndarray:
+//| def full(shape: Union[int, Tuple[int, ...]], fill_value: Union[_float, _bool], *, dtype: _DType = ulab.numpy.float, memory: Optional[str] = None) -> ulab.numpy.ndarray:
 //|    """
 //|    .. param: shape
 //|       Shape of the array, either an integer (for a 1-D array) or a tuple of integers (for tensors of higher rank)
@@ -517,6 +552,8 @@ MP_DEFINE_CONST_FUN_OBJ_KW(create_eye_obj, 1, create_eye);
 //|       scalar, the value with which the array is filled
 //|    .. param: dtype
 //|       Type of values in the array
+//|    .. param: memory
+//|       'gc', or 'external', the memory in which the values are stored
 //|
 //|    Return a new array of the given shape with all elements set to 0."""
 //|    ...
@@ -527,6 +564,7 @@ mp_obj_t create_full(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
         { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_obj = MP_OBJ_NULL } },
         { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_obj = MP_OBJ_NULL } },
         { MP_QSTR_dtype, MP_ARG_KW_ONLY | MP_ARG_INT, { .u_int = NDARRAY_FLOAT } },
+        { MP_QSTR_memory, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
     };
 
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
@@ -534,7 +572,7 @@ mp_obj_t create_full(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
 
     uint8_t dtype = args[2].u_int;
 
-    return create_zeros_ones_full(args[0].u_obj, dtype, args[1].u_obj);
+    return create_zeros_ones_full(args[0].u_obj, dtype, args[1].u_obj, args[3].u_obj);
 }
 
 MP_DEFINE_CONST_FUN_OBJ_KW(create_full_obj, 0, create_full);
@@ -728,15 +766,24 @@ mp_obj_t create_logspace(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_a
         } else {
             for(size_t i=0; i < len; i++, value *= quotient) *array++ = (uint8_t)value;
         }
-    } else if(ndarray->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(ndarray->dtype, INT8)) {
         int8_t *array = (int8_t *)ndarray->array;
         for(size_t i=0; i < len; i++, value *= quotient) *array++ = (int8_t)value;
     } else if(ndarray->dtype == NDARRAY_UINT16) {
         uint16_t *array = (uint16_t *)ndarray->array;
         for(size_t i=0; i < len; i++, value *= quotient) *array++ = (uint16_t)value;
-    } else if(ndarray->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(ndarray->dtype, INT16)) {
         int16_t *array = (int16_t *)ndarray->array;
         for(size_t i=0; i < len; i++, value *= quotient) *array++ = (int16_t)value;
+    #if ULAB_HAS_GENERIC_DTYPES
+    } else if(ULAB_DTYPE_IS_GENERIC(ndarray->dtype)) {
+        void (*set)(void *, mp_float_t) = ndarray_set_float_function(ndarray->dtype);
+        uint8_t *array = (uint8_t *)ndarray->array;
+        for(size_t i=0; i < len; i++, value *= quotient) {
+            set(array, value);
+            array += ndarray->itemsize;
+        }
+    #endif
     } else {
         mp_float_t *array = (mp_float_t *)ndarray->array;
         for(size_t i=0; i < len; i++, value *= quotient) *array++ = value;
@@ -748,12 +795,14 @@ MP_DEFINE_CONST_FUN_OBJ_KW(create_logspace_obj, 2, create_logspace);
 #endif
 
 #if ULAB_NUMPY_HAS_ONES
-//| def ones(shape: Union[int, Tuple[int, ...]], *, dtype: _DType = ulab.numpy.float) -> ulab.numpy.ndarray:
+//| def ones(shape: Union[int, Tuple[int, ...]], *, dtype: _DType = ulab.numpy.float, memory: Optional[str] = None) -> ulab.numpy.ndarray:
 //|    """
 //|    .. param: shape
 //|       Shape of the array, either an integer (for a 1-D array) or a tuple of 2 integers (for a 2-D array)
 //|    .. param: dtype
 //|       Type of values in the array
+//|    .. param: memory
+//|       'gc', or 'external', the memory in which the values are stored
 //|
 //|    Return a new array of the given shape with all elements set to 1."""
 //|    ...
@@ -763,6 +812,7 @@ mp_obj_t create_ones(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_obj = MP_OBJ_NULL } },
         { MP_QSTR_dtype, MP_ARG_KW_ONLY | MP_ARG_INT, { .u_int = NDARRAY_FLOAT } },
+        { MP_QSTR_memory, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
     };
 
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
@@ -770,19 +820,21 @@ mp_obj_t create_ones(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
 
     uint8_t dtype = args[1].u_int;
     mp_obj_t one = mp_obj_new_int(1);
-    return create_zeros_ones_full(args[0].u_obj, dtype, one);
+    return create_zeros_ones_full(args[0].u_obj, dtype, one, args[2].u_obj);
 }
 
 MP_DEFINE_CONST_FUN_OBJ_KW(create_ones_obj, 0, create_ones);
 #endif
 
 #if ULAB_NUMPY_HAS_ZEROS
-//| def zeros(shape: Union[int, Tuple[int, ...]], *, dtype: _DType = ulab.numpy.float) -> ulab.numpy.ndarray:
+//| def zeros(shape: Union[int, Tuple[int, ...]], *, dtype: _DType = ulab.numpy.float, memory: Optional[str] = None) -> ulab.numpy.ndarray:
 //|    """
 //|    .. param: shape
 //|       Shape of the array, either an integer (for a 1-D array) or a tuple of 2 integers (for a 2-D array)
 //|    .. param: dtype
 //|       Type of values in the array
+//|    .. param: memory
+//|       'gc', or 'external', the memory in which the values are stored
 //|
 //|    Return a new array of the given shape with all elements set to 0."""
 //|    ...
@@ -792,13 +844,14 @@ mp_obj_t create_zeros(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_obj = MP_OBJ_NULL } },
         { MP_QSTR_dtype, MP_ARG_KW_ONLY | MP_ARG_INT, { .u_int = NDARRAY_FLOAT } },
+        { MP_QSTR_memory, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
     };
 
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
     uint8_t dtype = args[1].u_int;
-    return create_zeros_ones_full(args[0].u_obj, dtype, mp_const_none);
+    return create_zeros_ones_full(args[0].u_obj, dtype, mp_const_none, args[2].u_obj);
 }
 
 MP_DEFINE_CONST_FUN_OBJ_KW(create_zeros_obj, 0, create_zeros);
@@ -848,8 +901,11 @@ mp_obj_t create_frombuffer(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw
         ndarray->shape[ULAB_MAX_DIMS - 1] = len;
         ndarray->strides[ULAB_MAX_DIMS - 1] = sz;
 
+        // the array is a view over the buffer, nothing is copied; origin keeps the
+        // buffer object alive for as long as the view exists
         uint8_t *buffer = bufinfo.buf;
         ndarray->array = buffer + offset;
+        ndarray->origin = MP_OBJ_TO_PTR(args[0].u_obj);
         return MP_OBJ_FROM_PTR(ndarray);
     }
     return mp_const_none;
@@ -21,6 +21,7 @@
 #include "py/objarray.h"
 
 #include "../carray/carray_tools.h"
+#include "../../ulab_profile.h"
 #include "fft.h"
 
 //| """Frequency-domain functions"""
@@ -29,69 +30,289 @@
 //| import ulab.utils
 
 
-//| def fft(r: ulab.numpy.ndarray, c: Optional[ulab.numpy.ndarray] = None) -> Tuple[ulab.numpy.ndarray, ulab.numpy.ndarray]:
+//| def fft(r: ulab.numpy.ndarray, c: Optional[ulab.numpy.ndarray] = None, *, plan: Optional[plan] = None, out: Optional[Tuple[ulab.numpy.ndarray, ulab.numpy.ndarray]] = None, dtype: _DType = ulab.numpy.float, block: bool = True) -> Tuple[ulab.numpy.ndarray, ulab.numpy.ndarray]:
 //|     """
-//|     :param ulab.numpy.ndarray r: A 1-dimension array of values whose size is a power of 2
-//|     :param ulab.numpy.ndarray c: An optional 1-dimension array of values whose size is a power of 2, giving the complex part of the value
+//|     :param ulab.numpy.ndarray r: A 1-dimension array of values
+//|     :param ulab.numpy.ndarray c: An optional 1-dimension array of values of the same size, giving the complex part of the value
+//|     :param plan: An optional plan of the same length as the input, created by `ulab.numpy.fft.plan`
+//|     :param out: An optional tuple of two dense float arrays of the same length as the input (a dense complex array, if the
+//|         firmware is numpy-compatible), into which the results are written. The input arrays can be passed here.
+//|     :param dtype: if ``int16``, the transform is calculated in Q15 fixed-point arithmetic
+//|     :param bool block: in fixed-point mode, scale a stage only, if it could overflow
 //|     :return tuple (r, c): The real and complex parts of the FFT
 //|
-//|     Perform a Fast Fourier Transform from the time domain into the frequency domain
+//|     Perform a Fast Fourier Transform from the time domain into the frequency domain. Lengths that are
+//|     powers of 2 are the fastest, lengths whose prime factors are 2, 3, and 5 are handled by a mixed-radix
+//|     kernel, and all other lengths by Bluestein's algorithm, which requires considerably more memory.
+//|
+//|     With ``dtype=int16``, the inputs must be int16 arrays, whose length is a power of 2, and the
+//|     tuple (r, c, exponent) is returned, where the transform is (r + 1j * c) * 2**exponent.
 //|
 //|     See also `ulab.utils.spectrogram`, which computes the magnitude of the fft,
 //|     rather than separately returning its real and imaginary parts."""
 //|     ...
 //|
-#if ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE
-static mp_obj_t fft_fft(mp_obj_t arg) {
-    return fft_fft_ifft_spectrogram(arg, FFT_FFT);
-}
 
-MP_DEFINE_CONST_FUN_OBJ_1(fft_fft_obj, fft_fft);
-#else
-static mp_obj_t fft_fft(size_t n_args, const mp_obj_t *args) {
-    if(n_args == 2) {
-        return fft_fft_ifft_spectrogram(n_args, args[0], args[1], FFT_FFT);
+static mp_obj_t fft_fft_ifft(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args, uint8_t type) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        #if !(ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE)
+        { MP_QSTR_, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        #endif
+        { MP_QSTR_plan, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_out, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        #if ULAB_SUPPORTS_Q15
+        { MP_QSTR_dtype, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = NDARRAY_FLOAT } },
+        { MP_QSTR_block, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = true } },
+        #endif
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    // the index of the plan keyword argument, which is followed by out, dtype, and block
+    #if ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE
+    uint8_t p = 1;
+    #else
+    uint8_t p = 2;
+    #endif
+
+    #if ULAB_SUPPORTS_Q15
+    if(args[p + 2].u_int == NDARRAY_INT16) {
+        if(args[p + 1].u_obj != mp_const_none) {
+            mp_raise_NotImplementedError(MP_ERROR_TEXT("out is not supported in fixed-point mode"));
+        }
+        mp_obj_t im = p == 2 ? args[1].u_obj : mp_const_none;
+        return fft_fft_ifft_q15(args[0].u_obj, im, type, args[p + 3].u_bool, args[p].u_obj);
+    } else if(args[p + 2].u_int != NDARRAY_FLOAT) {
+        mp_raise_ValueError(MP_ERROR_TEXT("dtype must be float, or int16"));
+    }
+    #endif
+
+    #if ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE
+    return fft_fft_ifft_spectrogram(args[0].u_obj, type, args[p].u_obj, args[p + 1].u_obj);
+    #else
+    if(type == FFT_IFFT) {
+        NOT_IMPLEMENTED_FOR_COMPLEX()
+    }
+    if(args[1].u_obj != mp_const_none) {
+        return fft_fft_ifft_spectrogram(2, args[0].u_obj, args[1].u_obj, type, args[p].u_obj, args[p + 1].u_obj);
     } else {
-        return fft_fft_ifft_spectrogram(n_args, args[0], mp_const_none, FFT_FFT);
+        return fft_fft_ifft_spectrogram(1, args[0].u_obj, mp_const_none, type, args[p].u_obj, args[p + 1].u_obj);
     }
+    #endif
 }
 
-MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(fft_fft_obj, 1, 2, fft_fft);
-#endif
+static mp_obj_t fft_fft(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    return fft_fft_ifft(n_args, pos_args, kw_args, FFT_FFT);
+}
 
-//| def ifft(r: ulab.numpy.ndarray, c: Optional[ulab.numpy.ndarray] = None) -> Tuple[ulab.numpy.ndarray, ulab.numpy.ndarray]:
+MP_DEFINE_CONST_FUN_OBJ_KW(fft_fft_obj, 1, fft_fft);
+
+//| def ifft(r: ulab.numpy.ndarray, c: Optional[ulab.numpy.ndarray] = None, *, plan: Optional[plan] = None, out: Optional[Tuple[ulab.numpy.ndarray, ulab.numpy.ndarray]] = None, dtype: _DType = ulab.numpy.float, block: bool = True) -> Tuple[ulab.numpy.ndarray, ulab.numpy.ndarray]:
 //|     """
-//|     :param ulab.numpy.ndarray r: A 1-dimension array of values whose size is a power of 2
-//|     :param ulab.numpy.ndarray c: An optional 1-dimension array of values whose size is a power of 2, giving the complex part of the value
+//|     :param ulab.numpy.ndarray r: A 1-dimension array of values
+//|     :param ulab.numpy.ndarray c: An optional 1-dimension array of values of the same size, giving the complex part of the value
+//|     :param plan: An optional plan of the same length as the input, created by `ulab.numpy.fft.plan`
+//|     :param out: An optional output, as in `fft`
+//|     :param dtype: if ``int16``, the transform is calculated in Q15 fixed-point arithmetic
+//|     :param bool block: in fixed-point mode, scale a stage only, if it could overflow
 //|     :return tuple (r, c): The real and complex parts of the inverse FFT
 //|
 //|     Perform an Inverse Fast Fourier Transform from the frequeny domain into the time domain"""
 //|     ...
 //|
 
+static mp_obj_t fft_ifft(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    return fft_fft_ifft(n_args, pos_args, kw_args, FFT_IFFT);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(fft_ifft_obj, 1, fft_ifft);
+
+#if ULAB_FFT_HAS_FFT_INPLACE
+//| def fft_inplace(r: ulab.numpy.ndarray, c: ulab.numpy.ndarray, *, inverse: bool = False, plan: Optional[plan] = None) -> None:
+//|     """
+//|     :param ulab.numpy.ndarray r: A dense 1-dimension float array, holding the real part of the values
+//|     :param ulab.numpy.ndarray c: A dense float array of the same size, holding the imaginary part of the values
+//|     :param bool inverse: if ``True``, the inverse transform is calculated
+//|     :param plan: An optional plan of the same length as the input, created by `ulab.numpy.fft.plan`
+//|
+//|     Overwrite ``r``, and ``c`` with their (inverse) Fast Fourier Transform. Nothing is allocated,
+//|     if the length is a power of 2."""
+//|     ...
+//|
+
+static mp_obj_t fft_fft_inplace(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_inverse, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false } },
+        { MP_QSTR_plan, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    uint8_t type = args[2].u_bool ? FFT_IFFT : FFT_FFT;
+    return fft_inplace(args[0].u_obj, args[1].u_obj, type, args[3].u_obj);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(fft_fft_inplace_obj, 2, fft_fft_inplace);
+#endif /* ULAB_FFT_HAS_FFT_INPLACE */
+
+#if ULAB_FFT_HAS_AFFT
+//| def afft(r: ulab.numpy.ndarray, c: Optional[ulab.numpy.ndarray] = None, *, inverse: bool = False, plan: Optional[plan] = None) -> ulab.job:
+//|     """
+//|     :param ulab.numpy.ndarray r: A 1-dimension array of values
+//|     :param ulab.numpy.ndarray c: An optional 1-dimension array of values of the same size, giving the complex part of the value
+//|     :param bool inverse: if ``True``, the inverse transform is calculated
+//|     :param plan: An optional plan of the same length as the input, created by `ulab.numpy.fft.plan`
+//|
+//|     Return a job, whose ``step`` method calculates the (inverse) Fast Fourier Transform one pass
+//|     at a time, and whose ``result`` method returns the same value as `fft`, or `ifft`. Only
+//|     power-of-two lengths are resumable, other lengths are transformed in a single step."""
+//|     ...
+//|
+
+static mp_obj_t fft_afft(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        #if !(ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE)
+        { MP_QSTR_, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        #endif
+        { MP_QSTR_inverse, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false } },
+        { MP_QSTR_plan, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    #if ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE
+    uint8_t p = 1;
+    mp_obj_t im = mp_const_none;
+    #else
+    uint8_t p = 2;
+    mp_obj_t im = args[1].u_obj;
+    #endif
+
+    uint8_t type = args[p].u_bool ? FFT_IFFT : FFT_FFT;
+    return fft_new_job(args[0].u_obj, im, type, args[p + 1].u_obj);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(fft_afft_obj, 1, fft_afft);
+#endif /* ULAB_FFT_HAS_AFFT */
+
+//| class plan:
+//|     """A precomputed table of twiddle factors, and bit-reversal indices for transforms of a given length"""
+//|
+
+static void fft_plan_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    (void)kind;
+    fft_plan_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_printf(print, "plan(%d)", self->n);
+}
+
+#if defined(MP_DEFINE_CONST_OBJ_TYPE)
+MP_DEFINE_CONST_OBJ_TYPE(
+    fft_plan_type,
+    MP_QSTR_plan,
+    MP_TYPE_FLAG_NONE,
+    print, fft_plan_print
+);
+#else
+const mp_obj_type_t fft_plan_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_plan,
+    .print = fft_plan_print,
+};
+#endif
+
+//| def plan(n: int) -> plan:
+//|     """
+//|     :param int n: The length of the transform, a power of 2
+//|
+//|     Precompute the twiddle factors, and the bit-reversal permutation of a transform of length ``n``.
+//|     The plan can be passed to `fft`, and `ifft` via the ``plan`` keyword argument, when transforms
+//|     of the same length have to be computed repeatedly. Besides saving the set-up time, the
+//|     tabulated twiddle factors are also more accurate than those of the trigonometric recurrence."""
+//|     ...
+//|
+
+static mp_obj_t fft_plan(mp_obj_t n) {
+    return MP_OBJ_FROM_PTR(fft_new_plan(mp_obj_get_int(n)));
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(fft_plan_obj, fft_plan);
+
+#if ULAB_FFT_HAS_RFFT
+//| def rfft(r: ulab.numpy.ndarray) -> Tuple[ulab.numpy.ndarray, ulab.numpy.ndarray]:
+//|     """
+//|     :param ulab.numpy.ndarray r: A 1-dimension array of real values whose size is a power of 2
+//|     :return tuple (r, c): The real and complex parts of the non-negative frequency terms of the FFT
+//|
+//|     Perform a Fast Fourier Transform of a real signal. Only the first ``len(r)/2 + 1`` terms
+//|     of the spectrum are returned, the rest follows from symmetry. Since the
+//|     computation is done on a complex array of half length, this is about twice as
+//|     fast as `fft`, and requires half as much memory."""
+//|     ...
+//|
+
+static mp_obj_t fft_rfft(mp_obj_t arg) {
+    #if ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE
+    return fft_rfft_irfft(arg, FFT_RFFT);
+    #else
+    return fft_rfft_irfft(1, arg, mp_const_none, FFT_RFFT);
+    #endif
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(fft_rfft_obj, fft_rfft);
+#endif /* ULAB_FFT_HAS_RFFT */
+
+#if ULAB_FFT_HAS_IRFFT
+//| def irfft(r: ulab.numpy.ndarray, c: Optional[ulab.numpy.ndarray] = None) -> ulab.numpy.ndarray:
+//|     """
+//|     :param ulab.numpy.ndarray r: A 1-dimension array of values whose size is a power of 2 plus 1
+//|     :param ulab.numpy.ndarray c: An optional 1-dimension array of values of the same size, giving the complex part of the value
+//|     :return ulab.numpy.ndarray: The real signal
+//|
+//|     Perform the inverse of `rfft`, i.e., reconstruct a real signal of length ``2*(len(r) - 1)``
+//|     from the non-negative frequency terms of its spectrum."""
+//|     ...
+//|
+
 #if ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE
-static mp_obj_t fft_ifft(mp_obj_t arg) {
-    return fft_fft_ifft_spectrogram(arg, FFT_IFFT);
+static mp_obj_t fft_irfft(mp_obj_t arg) {
+    return fft_rfft_irfft(arg, FFT_IRFFT);
 }
 
-MP_DEFINE_CONST_FUN_OBJ_1(fft_ifft_obj, fft_ifft);
+MP_DEFINE_CONST_FUN_OBJ_1(fft_irfft_obj, fft_irfft);
 #else
-static mp_obj_t fft_ifft(size_t n_args, const mp_obj_t *args) {
-    NOT_IMPLEMENTED_FOR_COMPLEX()
+static mp_obj_t fft_irfft(size_t n_args, const mp_obj_t *args) {
     if(n_args == 2) {
-        return fft_fft_ifft_spectrogram(n_args, args[0], args[1], FFT_IFFT);
+        return fft_rfft_irfft(n_args, args[0], args[1], FFT_IRFFT);
     } else {
-        return fft_fft_ifft_spectrogram(n_args, args[0], mp_const_none, FFT_IFFT);
+        return fft_rfft_irfft(n_args, args[0], mp_const_none, FFT_IRFFT);
     }
 }
 
-MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(fft_ifft_obj, 1, 2, fft_ifft);
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(fft_irfft_obj, 1, 2, fft_irfft);
 #endif
+#endif /* ULAB_FFT_HAS_IRFFT */
 
 STATIC const mp_rom_map_elem_t ulab_fft_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_fft) },
-    { MP_ROM_QSTR(MP_QSTR_fft), MP_ROM_PTR(&fft_fft_obj) },
-    { MP_ROM_QSTR(MP_QSTR_ifft), MP_ROM_PTR(&fft_ifft_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fft), ULAB_PROFILE_PTR(MP_QSTR_fft, MP_QSTR_fft, fft_fft_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ifft), ULAB_PROFILE_PTR(MP_QSTR_fft, MP_QSTR_ifft, fft_ifft_obj) },
+    #if ULAB_FFT_HAS_FFT_INPLACE
+    { MP_ROM_QSTR(MP_QSTR_fft_inplace), ULAB_PROFILE_PTR(MP_QSTR_fft, MP_QSTR_fft_inplace, fft_fft_inplace_obj) },
+    #endif
+    #if ULAB_FFT_HAS_AFFT
+    { MP_ROM_QSTR(MP_QSTR_afft), ULAB_PROFILE_PTR(MP_QSTR_fft, MP_QSTR_afft, fft_afft_obj) },
+    #endif
+    { MP_ROM_QSTR(MP_QSTR_plan), ULAB_PROFILE_PTR(MP_QSTR_fft, MP_QSTR_plan, fft_plan_obj) },
+    #if ULAB_FFT_HAS_RFFT
+    { MP_ROM_QSTR(MP_QSTR_rfft), ULAB_PROFILE_PTR(MP_QSTR_fft, MP_QSTR_rfft, fft_rfft_obj) },
+    #endif
+    #if ULAB_FFT_HAS_IRFFT
+    { MP_ROM_QSTR(MP_QSTR_irfft), ULAB_PROFILE_PTR(MP_QSTR_fft, MP_QSTR_irfft, fft_irfft_obj) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_ulab_fft_globals, ulab_fft_globals_table);
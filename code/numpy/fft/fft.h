@@ -19,12 +19,21 @@
 
 extern const mp_obj_module_t ulab_fft_module;
 
+MP_DECLARE_CONST_FUN_OBJ_KW(fft_fft_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(fft_ifft_obj);
+#if ULAB_FFT_HAS_FFT_INPLACE
+MP_DECLARE_CONST_FUN_OBJ_KW(fft_fft_inplace_obj);
+#endif
+#if ULAB_FFT_HAS_AFFT
+MP_DECLARE_CONST_FUN_OBJ_KW(fft_afft_obj);
+#endif
+MP_DECLARE_CONST_FUN_OBJ_1(fft_plan_obj);
+
+MP_DECLARE_CONST_FUN_OBJ_1(fft_rfft_obj);
 #if ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE
-MP_DECLARE_CONST_FUN_OBJ_3(fft_fft_obj);
-MP_DECLARE_CONST_FUN_OBJ_3(fft_ifft_obj);
+MP_DECLARE_CONST_FUN_OBJ_1(fft_irfft_obj);
 #else
-MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(fft_fft_obj);
-MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(fft_ifft_obj);
+MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(fft_irfft_obj);
 #endif
 
 #endif
@@ -14,6 +14,8 @@
 
 #include "../../ndarray.h"
 #include "../../ulab_tools.h"
+#include "../../ulab_dsp.h"
+#include "../../ulab_job.h"
 #include "../carray/carray_tools.h"
 #include "fft_tools.h"
 
@@ -24,17 +26,143 @@
 #define MP_E MICROPY_FLOAT_CONST(2.71828182845904523536)
 #endif
 
-/* Kernel implementation for the case, when ulab has no complex support
+// constants of the radix-3, and radix-5 butterflies
+#define FFT_SIN_2PI_3   MICROPY_FLOAT_CONST(0.86602540378443864676)
+#define FFT_COS_2PI_5   MICROPY_FLOAT_CONST(0.30901699437494742410)
+#define FFT_COS_4PI_5   MICROPY_FLOAT_CONST(-0.80901699437494742410)
+#define FFT_SIN_2PI_5   MICROPY_FLOAT_CONST(0.95105651629515357212)
+#define FFT_SIN_4PI_5   MICROPY_FLOAT_CONST(0.58778525229247312917)
 
- * The following function takes two arrays, namely, the real and imaginary
- * parts of a complex array, and calculates the Fourier transform in place.
+/* The power-of-two kernel. The real and imaginary parts of the i-th element are
+ * re[i*step], and im[i*step], so that the same code can work on interleaved
+ * (step = 2), and on separate arrays (step = 1).
  *
- * The function is basically a modification of four1 from Numerical Recipes,
- * has no dependencies beyond micropython itself (for the definition of mp_float_t),
- * and can be used independent of ulab.
+ * After the bit-reversal permutation, pairs of consecutive radix-2 stages are
+ * fused into a single radix-4 pass: this halves the number of passes over the
+ * data, and saves one complex multiplication out of four, since the factor
+ * of -i (or i in the inverse direction) of the butterfly is just a swap of
+ * the real and imaginary parts. If the number of stages is odd, a single radix-2
+ * stage, whose twiddle factors are all 1, is executed first. The three steps are
+ * separate functions, so that the job of afft can execute them one at a time.
  */
+static void fft_pow2_permute(mp_float_t *re, mp_float_t *im, size_t step, size_t n, fft_plan_t *plan) {
+    size_t j, m;
+    if(plan != NULL) {
+        for(size_t i = 0; i < n; i++) {
+            j = plan->permutation[i];
+            if (j > i) {
+                SWAP(mp_float_t, re[i*step], re[j*step]);
+                SWAP(mp_float_t, im[i*step], im[j*step]);
+            }
+        }
+    } else {
+        j = 0;
+        for(size_t i = 0; i < n; i++) {
+            if (j > i) {
+                SWAP(mp_float_t, re[i*step], re[j*step]);
+                SWAP(mp_float_t, im[i*step], im[j*step]);
+            }
+            m = n >> 1;
+            while (j >= m && m > 0) {
+                j -= m;
+                m >>= 1;
+            }
+            j += m;
+        }
+    }
+}
+
+static size_t fft_pow2_first_stage(mp_float_t *re, mp_float_t *im, size_t step, size_t n) {
+    // executes the radix-2 stage, if the number of stages is odd, and returns the length
+    // of the sub-transforms that the radix-4 passes start from
+    size_t stages = 0;
+    while(((size_t)1 << stages) < n) {
+        stages++;
+    }
+    if((stages & 1) == 0) {
+        return 1;
+    }
+    for(size_t i = 0; i < n; i += 2) {
+        mp_float_t tempr = re[(i+1)*step];
+        mp_float_t tempi = im[(i+1)*step];
+        re[(i+1)*step] = re[i*step] - tempr;
+        im[(i+1)*step] = im[i*step] - tempi;
+        re[i*step] += tempr;
+        im[i*step] += tempi;
+    }
+    return 2;
+}
+
+static void fft_pow2_pass(mp_float_t *re, mp_float_t *im, size_t step, size_t n, size_t mmax, int isign, fft_plan_t *plan) {
+    // a single radix-4 pass, which combines the sub-transforms of length mmax into ones of length 4 * mmax
+    mp_float_t wtemp, wr, wi, theta;
+    mp_float_t wpr = MICROPY_FLOAT_CONST(0.0), wpi = MICROPY_FLOAT_CONST(0.0);
+    size_t istep = mmax << 2;
+    if(plan == NULL) {
+        theta = MICROPY_FLOAT_CONST(-2.0)*isign*MP_PI/istep;
+        wtemp = MICROPY_FLOAT_C_FUN(sin)(MICROPY_FLOAT_CONST(0.5) * theta);
+        wpr = MICROPY_FLOAT_CONST(-2.0) * wtemp * wtemp;
+        wpi = MICROPY_FLOAT_C_FUN(sin)(theta);
+    }
+    wr = MICROPY_FLOAT_CONST(1.0);
+    wi = MICROPY_FLOAT_CONST(0.0);
+    for(size_t m = 0; m < mmax; m++) {
+        if(plan != NULL) {
+            // the twiddle factors are taken from the table, no recurrence is needed
+            FFT_PLAN_TWIDDLE(plan, m * (n / istep), isign, wr, wi);
+        }
+        // w2 = w^2, w3 = w^3
+        mp_float_t w2r = wr * wr - wi * wi;
+        mp_float_t w2i = MICROPY_FLOAT_CONST(2.0) * wr * wi;
+        mp_float_t w3r = w2r * wr - w2i * wi;
+        mp_float_t w3i = w2r * wi + w2i * wr;
+        for(size_t i = m; i < n; i += istep) {
+            size_t i0 = i * step;
+            size_t i1 = (i + mmax) * step;
+            size_t i2 = (i + 2 * mmax) * step;
+            size_t i3 = (i + 3 * mmax) * step;
+            mp_float_t t1r = w2r * re[i1] - w2i * im[i1];
+            mp_float_t t1i = w2r * im[i1] + w2i * re[i1];
+            mp_float_t t2r = wr * re[i2] - wi * im[i2];
+            mp_float_t t2i = wr * im[i2] + wi * re[i2];
+            mp_float_t t3r = w3r * re[i3] - w3i * im[i3];
+            mp_float_t t3i = w3r * im[i3] + w3i * re[i3];
+
+            mp_float_t s0r = re[i0] + t1r;
+            mp_float_t s0i = im[i0] + t1i;
+            mp_float_t d0r = re[i0] - t1r;
+            mp_float_t d0i = im[i0] - t1i;
+            mp_float_t s1r = t2r + t3r;
+            mp_float_t s1i = t2i + t3i;
+            // d1 is multiplied by -i*isign
+            mp_float_t d1r = isign * (t2i - t3i);
+            mp_float_t d1i = isign * (t3r - t2r);
+
+            re[i0] = s0r + s1r;
+            im[i0] = s0i + s1i;
+            re[i2] = s0r - s1r;
+            im[i2] = s0i - s1i;
+            re[i1] = d0r + d1r;
+            im[i1] = d0i + d1i;
+            re[i3] = d0r - d1r;
+            im[i3] = d0i - d1i;
+        }
+        if(plan == NULL) {
+            wtemp = wr;
+            wr = wr*wpr - wi*wpi + wr;
+            wi = wi*wpr + wtemp*wpi + wi;
+        }
+    }
+}
+
+static void fft_kernel_pow2(mp_float_t *re, mp_float_t *im, size_t step, size_t n, int isign, fft_plan_t *plan) {
+    fft_pow2_permute(re, im, step, n, plan);
+    for(size_t mmax = fft_pow2_first_stage(re, im, step, n); mmax < n; mmax <<= 2) {
+        fft_pow2_pass(re, im, step, n, mmax, isign, plan);
+    }
+}
+
 
-#if ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE
 /* Kernel implementation for the complex case. Data are contained in data as
 
     data[0], data[1], data[2], data[3], .... , data[2n - 2], data[2n-1]
@@ -45,17 +173,385 @@
     imag[i] = data[2i+1]
 
 */
-void fft_kernel_complex(mp_float_t *data, size_t n, int isign) {
-    size_t j, m, mmax, istep;
-    mp_float_t tempr, tempi;
+void fft_kernel_complex(mp_float_t *data, size_t n, int isign, fft_plan_t *plan) {
+    if(ulab_dsp_cfft(data, n, isign)) {
+        return;
+    }
+    // the vendor libraries initialise their tables on first use, hence the GIL is released for the portable kernel only
+    bool released = ulab_gil_exit(n);
+    fft_kernel_pow2(data, data + 1, 2, n, isign, plan);
+    ulab_gil_enter(released);
+}
+
+/* Mixed-radix kernel for lengths, whose prime factors are 2, 3, and 5.
+ * The transform is decimated in time recursively: the elements of in, which
+ * are 2*stride floats apart, are split into p sub-sequences of length n/p, whose
+ * transforms are written consecutively into out, and then combined by radix-p
+ * butterflies in place.
+ */
+static void fft_mixed_pass(mp_float_t *in, mp_float_t *out, size_t n, size_t stride, const uint8_t *factors, int isign) {
+    uint8_t p = factors[0];
+    size_t m = n / p;
+    if(m == 1) {
+        for(uint8_t q = 0; q < p; q++) {
+            out[2*q] = in[2*q*stride];
+            out[2*q+1] = in[2*q*stride+1];
+        }
+    } else {
+        for(uint8_t q = 0; q < p; q++) {
+            fft_mixed_pass(in + 2 * q * stride, out + 2 * q * m, m, stride * p, factors + 1, isign);
+        }
+    }
+
+    mp_float_t wtemp, wr, wi, wpr, wpi, theta;
+    theta = MICROPY_FLOAT_CONST(-2.0)*isign*MP_PI/n;
+    wtemp = MICROPY_FLOAT_C_FUN(sin)(MICROPY_FLOAT_CONST(0.5) * theta);
+    wpr = MICROPY_FLOAT_CONST(-2.0) * wtemp * wtemp;
+    wpi = MICROPY_FLOAT_C_FUN(sin)(theta);
+    wr = MICROPY_FLOAT_CONST(1.0);
+    wi = MICROPY_FLOAT_CONST(0.0);
+
+    // the real and imaginary parts of the twiddled inputs of a single butterfly
+    mp_float_t ar[5], ai[5];
+    for(size_t k = 0; k < m; k++) {
+        // the q-th input is multiplied by w^q
+        mp_float_t vr = MICROPY_FLOAT_CONST(1.0), vi = MICROPY_FLOAT_CONST(0.0);
+        for(uint8_t q = 0; q < p; q++) {
+            mp_float_t xr = out[2*(q*m+k)];
+            mp_float_t xi = out[2*(q*m+k)+1];
+            ar[q] = vr * xr - vi * xi;
+            ai[q] = vr * xi + vi * xr;
+            wtemp = vr;
+            vr = vr * wr - vi * wi;
+            vi = vi * wr + wtemp * wi;
+        }
+        mp_float_t *x0 = &out[2*k];
+        mp_float_t *x1 = &out[2*(k+m)];
+        mp_float_t *x2 = &out[2*(k+2*m)];
+        if(p == 2) {
+            x0[0] = ar[0] + ar[1];
+            x0[1] = ai[0] + ai[1];
+            x1[0] = ar[0] - ar[1];
+            x1[1] = ai[0] - ai[1];
+        } else if(p == 3) {
+            mp_float_t sr = ar[1] + ar[2];
+            mp_float_t si = ai[1] + ai[2];
+            mp_float_t tr = ar[0] - MICROPY_FLOAT_CONST(0.5) * sr;
+            mp_float_t ti = ai[0] - MICROPY_FLOAT_CONST(0.5) * si;
+            // (a1 - a2) multiplied by -i * isign * sin(2 pi / 3)
+            mp_float_t dr = isign * FFT_SIN_2PI_3 * (ai[1] - ai[2]);
+            mp_float_t di = isign * FFT_SIN_2PI_3 * (ar[2] - ar[1]);
+            x0[0] = ar[0] + sr;
+            x0[1] = ai[0] + si;
+            x1[0] = tr + dr;
+            x1[1] = ti + di;
+            x2[0] = tr - dr;
+            x2[1] = ti - di;
+        } else if(p == 4) {
+            mp_float_t *x3 = &out[2*(k+3*m)];
+            mp_float_t s0r = ar[0] + ar[2];
+            mp_float_t s0i = ai[0] + ai[2];
+            mp_float_t d0r = ar[0] - ar[2];
+            mp_float_t d0i = ai[0] - ai[2];
+            mp_float_t s1r = ar[1] + ar[3];
+            mp_float_t s1i = ai[1] + ai[3];
+            // (a1 - a3) multiplied by -i * isign
+            mp_float_t d1r = isign * (ai[1] - ai[3]);
+            mp_float_t d1i = isign * (ar[3] - ar[1]);
+            x0[0] = s0r + s1r;
+            x0[1] = s0i + s1i;
+            x2[0] = s0r - s1r;
+            x2[1] = s0i - s1i;
+            x1[0] = d0r + d1r;
+            x1[1] = d0i + d1i;
+            x3[0] = d0r - d1r;
+            x3[1] = d0i - d1i;
+        } else { // p == 5
+            mp_float_t *x3 = &out[2*(k+3*m)];
+            mp_float_t *x4 = &out[2*(k+4*m)];
+            mp_float_t s1r = ar[1] + ar[4];
+            mp_float_t s1i = ai[1] + ai[4];
+            mp_float_t s2r = ar[2] + ar[3];
+            mp_float_t s2i = ai[2] + ai[3];
+            mp_float_t d1r = ar[1] - ar[4];
+            mp_float_t d1i = ai[1] - ai[4];
+            mp_float_t d2r = ar[2] - ar[3];
+            mp_float_t d2i = ai[2] - ai[3];
+            mp_float_t t1r = ar[0] + FFT_COS_2PI_5 * s1r + FFT_COS_4PI_5 * s2r;
+            mp_float_t t1i = ai[0] + FFT_COS_2PI_5 * s1i + FFT_COS_4PI_5 * s2i;
+            mp_float_t t2r = ar[0] + FFT_COS_4PI_5 * s1r + FFT_COS_2PI_5 * s2r;
+            mp_float_t t2i = ai[0] + FFT_COS_4PI_5 * s1i + FFT_COS_2PI_5 * s2i;
+            // the odd parts, multiplied by -i * isign
+            mp_float_t u1r = isign * (FFT_SIN_2PI_5 * d1i + FFT_SIN_4PI_5 * d2i);
+            mp_float_t u1i = -isign * (FFT_SIN_2PI_5 * d1r + FFT_SIN_4PI_5 * d2r);
+            mp_float_t u2r = isign * (FFT_SIN_4PI_5 * d1i - FFT_SIN_2PI_5 * d2i);
+            mp_float_t u2i = -isign * (FFT_SIN_4PI_5 * d1r - FFT_SIN_2PI_5 * d2r);
+            x0[0] = ar[0] + s1r + s2r;
+            x0[1] = ai[0] + s1i + s2i;
+            x1[0] = t1r + u1r;
+            x1[1] = t1i + u1i;
+            x4[0] = t1r - u1r;
+            x4[1] = t1i - u1i;
+            x2[0] = t2r + u2r;
+            x2[1] = t2i + u2i;
+            x3[0] = t2r - u2r;
+            x3[1] = t2i - u2i;
+        }
+        wtemp = wr;
+        wr = wr*wpr - wi*wpi + wr;
+        wi = wi*wpr + wtemp*wpi + wi;
+    }
+}
+
+/* Bluestein's algorithm for lengths with prime factors other than 2, 3, and 5.
+ * The transform is written as the convolution of the input, multiplied by a chirp,
+ * with the conjugate of the chirp, and the convolution is calculated by
+ * power-of-two transforms of length at least 2n - 1.
+ */
+static void fft_bluestein(mp_float_t *data, size_t n, int isign) {
+    size_t len = 1;
+    while(len < 2 * n - 1) {
+        len <<= 1;
+    }
+    mp_float_t *chirp = ulab_scratch_new(mp_float_t, 2 * n);
+    mp_float_t *a = ulab_scratch_new0(mp_float_t, 2 * len);
+    mp_float_t *b = ulab_scratch_new0(mp_float_t, 2 * len);
+
+    // chirp[k] = exp(-i pi isign k^2 / n); since this is periodic in k^2 with 2n,
+    // k^2 is taken modulo 2n, so that the argument remains accurate
+    size_t k2 = 0;
+    for(size_t k = 0; k < n; k++) {
+        mp_float_t theta = -isign * MP_PI * k2 / n;
+        chirp[2*k] = MICROPY_FLOAT_C_FUN(cos)(theta);
+        chirp[2*k+1] = MICROPY_FLOAT_C_FUN(sin)(theta);
+        k2 = (k2 + 2 * k + 1) % (2 * n);
+    }
+
+    for(size_t k = 0; k < n; k++) {
+        a[2*k] = data[2*k] * chirp[2*k] - data[2*k+1] * chirp[2*k+1];
+        a[2*k+1] = data[2*k] * chirp[2*k+1] + data[2*k+1] * chirp[2*k];
+        b[2*k] = chirp[2*k];
+        b[2*k+1] = -chirp[2*k+1];
+        if(k > 0) {
+            b[2*(len-k)] = chirp[2*k];
+            b[2*(len-k)+1] = -chirp[2*k+1];
+        }
+    }
+    fft_kernel_complex(a, len, 1, NULL);
+    fft_kernel_complex(b, len, 1, NULL);
+    for(size_t k = 0; k < len; k++) {
+        mp_float_t tempr = a[2*k] * b[2*k] - a[2*k+1] * b[2*k+1];
+        a[2*k+1] = a[2*k] * b[2*k+1] + a[2*k+1] * b[2*k];
+        a[2*k] = tempr;
+    }
+    fft_kernel_complex(a, len, -1, NULL);
+
+    for(size_t k = 0; k < n; k++) {
+        data[2*k] = (a[2*k] * chirp[2*k] - a[2*k+1] * chirp[2*k+1]) / len;
+        data[2*k+1] = (a[2*k] * chirp[2*k+1] + a[2*k+1] * chirp[2*k]) / len;
+    }
+    ulab_scratch_del(mp_float_t, b, 2 * len);
+    ulab_scratch_del(mp_float_t, a, 2 * len);
+    ulab_scratch_del(mp_float_t, chirp, 2 * n);
+}
+
+/* Kernel for arbitrary lengths on interleaved data. Powers of two are
+ * transformed in place by fft_kernel_complex (a plan is used only in this case),
+ * lengths whose prime factors are 2, 3, and 5 by the mixed-radix kernel, and
+ * everything else by Bluestein's algorithm. The latter two require scratch space.
+ */
+void fft_kernel_mixed(mp_float_t *data, size_t n, int isign, fft_plan_t *plan) {
+    if((n & (n - 1)) == 0) {
+        fft_kernel_complex(data, n, isign, plan);
+        return;
+    }
+    uint8_t factors[8 * sizeof(size_t)];
+    uint8_t nfactors = 0;
+    size_t rest = n;
+    while(rest % 4 == 0) {
+        factors[nfactors++] = 4;
+        rest /= 4;
+    }
+    const uint8_t primes[3] = {2, 3, 5};
+    for(uint8_t i = 0; i < 3; i++) {
+        while(rest % primes[i] == 0) {
+            factors[nfactors++] = primes[i];
+            rest /= primes[i];
+        }
+    }
+    if(rest != 1) {
+        fft_bluestein(data, n, isign);
+        return;
+    }
+    mp_float_t *scratch = ulab_scratch_new(mp_float_t, 2 * n);
+    memcpy(scratch, data, 2 * n * sizeof(mp_float_t));
+    bool released = ulab_gil_exit(n);
+    fft_mixed_pass(scratch, data, n, 1, factors, isign);
+    ulab_gil_enter(released);
+    ulab_scratch_del(mp_float_t, scratch, 2 * n);
+}
+
+/* Kernel implementation for real signals of length n. In the forward direction
+ * (isign = 1), the n real samples in data[0]...data[n-1] are treated as a complex
+ * array of length n/2, which is transformed by fft_kernel_complex, and the
+ * positive-frequency half of the spectrum is then recovered in a split step.
+ * The result is written to data in the same interleaved format as in the
+ * complex case, i.e., data must be able to hold n + 2 values (n/2 + 1 complex
+ * numbers, with both ends being real). In the backward direction (isign = -1),
+ * the steps are executed in the reverse order, and the n real samples are
+ * returned in data[0]...data[n-1]. As with the complex kernel, the result is
+ * not normalised, i.e., it has to be divided by n. If plan is not NULL, it must
+ * be the plan of the half-length transform, i.e., of length n/2.
+ */
+void fft_kernel_real(mp_float_t *data, size_t n, int isign, fft_plan_t *plan) {
+    if(n < 2) {
+        data[1] = MICROPY_FLOAT_CONST(0.0);
+        return;
+    }
+    size_t m = n >> 1;
+    mp_float_t a, b, c, d, evr, evi, odr, odi, tr, ti;
     mp_float_t wtemp, wr, wpr, wpi, wi, theta;
 
-    j = 0;
-    for(size_t i = 0; i < n; i++) {
-        if (j > i) {
-            SWAP(mp_float_t, data[2*i], data[2*j]);
-            SWAP(mp_float_t, data[2*i+1], data[2*j+1]);
+    theta = MICROPY_FLOAT_CONST(-2.0)*isign*MP_PI/n;
+    wtemp = MICROPY_FLOAT_C_FUN(sin)(MICROPY_FLOAT_CONST(0.5) * theta);
+    wpr = MICROPY_FLOAT_CONST(-2.0) * wtemp * wtemp;
+    wpi = MICROPY_FLOAT_C_FUN(sin)(theta);
+    wr = MICROPY_FLOAT_CONST(1.0);
+    wi = MICROPY_FLOAT_CONST(0.0);
+
+    if(isign == 1) {
+        fft_kernel_complex(data, m, 1, plan);
+        a = data[0];
+        b = data[1];
+        data[0] = a + b;
+        data[1] = MICROPY_FLOAT_CONST(0.0);
+        data[2*m] = a - b;
+        data[2*m+1] = MICROPY_FLOAT_CONST(0.0);
+    } else {
+        a = data[0];
+        c = data[2*m];
+        data[0] = a + c;
+        data[1] = a - c;
+    }
+
+    // the even and odd samples are separated, and mixed with the twiddle factors
+    // the pairs at k, and m - k depend on the same values, so they are processed together
+    for(size_t k = 1; k <= m / 2; k++) {
+        wtemp = wr;
+        wr = wr*wpr - wi*wpi + wr;
+        wi = wi*wpr + wtemp*wpi + wi;
+
+        a = data[2*k];
+        b = data[2*k+1];
+        c = data[2*(m-k)];
+        d = data[2*(m-k)+1];
+        if(isign == 1) {
+            evr = MICROPY_FLOAT_CONST(0.5) * (a + c);
+            evi = MICROPY_FLOAT_CONST(0.5) * (b - d);
+            odr = MICROPY_FLOAT_CONST(0.5) * (b + d);
+            odi = MICROPY_FLOAT_CONST(0.5) * (c - a);
+            tr = wr * odr - wi * odi;
+            ti = wr * odi + wi * odr;
+            data[2*k] = evr + tr;
+            data[2*k+1] = evi + ti;
+            data[2*(m-k)] = evr - tr;
+            data[2*(m-k)+1] = ti - evi;
+        } else {
+            evr = a + c;
+            evi = b - d;
+            tr = a - c;
+            ti = b + d;
+            odr = tr * wr - ti * wi;
+            odi = tr * wi + ti * wr;
+            data[2*k] = evr - odi;
+            data[2*k+1] = evi + odr;
+            data[2*(m-k)] = evr + odi;
+            data[2*(m-k)+1] = odr - evi;
         }
+    }
+
+    if(isign != 1) {
+        fft_kernel_complex(data, m, -1, plan);
+    }
+}
+
+static ndarray_obj_t *fft_get_linear_array(mp_obj_t arg) {
+    if(!mp_obj_is_type(arg, &ulab_ndarray_type)) {
+        mp_raise_NotImplementedError(MP_ERROR_TEXT("FFT is defined for ndarrays only"));
+    }
+    ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(arg);
+    #if ULAB_MAX_DIMS > 1
+    if(ndarray->ndim != 1) {
+        mp_raise_TypeError(MP_ERROR_TEXT("FFT is implemented for linear arrays only"));
+    }
+    #endif
+    return ndarray;
+}
+
+static void fft_copy_real(ndarray_obj_t *ndarray, mp_float_t *data, uint8_t step) {
+    // copies the elements of a real array into data[0], data[step], data[2*step]...
+    uint8_t *array = (uint8_t *)ndarray->array;
+    mp_float_t (*func)(void *) = ndarray_get_float_function(ndarray->dtype);
+    for(size_t i = 0; i < ndarray->len; i++) {
+        *data = func(array);
+        data += step;
+        array += ndarray->strides[ULAB_MAX_DIMS - 1];
+    }
+}
+
+static size_t fft_irfft_length(size_t len) {
+    // the length of the real signal, whose transform has len elements
+    if((len < 2) || (((len - 1) & (len - 2)) != 0)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("input array length must be power of 2 plus 1"));
+    }
+    return 2 * (len - 1);
+}
+
+static mp_obj_t fft_real_spectrogram(ndarray_obj_t *in) {
+    // calculates the spectrum of a real signal through the half-length transform
+    // the negative frequencies are simply mirror images of the positive ones
+    size_t len = in->len;
+    mp_float_t *data = ulab_scratch_new(mp_float_t, len + 2);
+    fft_copy_real(in, data, 1);
+    fft_kernel_real(data, len, 1, NULL);
+
+    ndarray_obj_t *spectrum = ndarray_new_linear_array(len, NDARRAY_FLOAT);
+    mp_float_t *sarray = (mp_float_t *)spectrum->array;
+    for(size_t k = 0; k <= len / 2; k++) {
+        mp_float_t value = MICROPY_FLOAT_C_FUN(sqrt)(data[2*k] * data[2*k] + data[2*k+1] * data[2*k+1]);
+        sarray[k] = value;
+        if((k > 0) && (k < len - k)) {
+            sarray[len - k] = value;
+        }
+    }
+    ulab_scratch_del(mp_float_t, data, len + 2);
+    return MP_OBJ_FROM_PTR(spectrum);
+}
+
+fft_plan_t *fft_new_plan(size_t n) {
+    if((n == 0) || ((n & (n-1)) != 0)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("plan length must be power of 2"));
+    }
+    if(n > 65536) {
+        mp_raise_ValueError(MP_ERROR_TEXT("plan length is too large"));
+    }
+    fft_plan_t *plan = m_new_obj(fft_plan_t);
+    plan->base.type = &fft_plan_type;
+    plan->n = n;
+
+    // the twiddle factors of the forward transform, exp(-2 pi i k / n), for k = 0...n/2-1
+    plan->twiddles = m_new(mp_float_t, MAX(1, n));
+    for(size_t k = 0; k < n / 2; k++) {
+        mp_float_t theta = MICROPY_FLOAT_CONST(-2.0) * MP_PI * k / n;
+        plan->twiddles[2*k] = MICROPY_FLOAT_C_FUN(cos)(theta);
+        plan->twiddles[2*k+1] = MICROPY_FLOAT_C_FUN(sin)(theta);
+    }
+
+    // the bit-reversal permutation
+    plan->permutation = m_new(uint16_t, n);
+    size_t j = 0, m;
+    for(size_t i = 0; i < n; i++) {
+        plan->permutation[i] = (uint16_t)j;
         m = n >> 1;
         while (j >= m && m > 0) {
             j -= m;
@@ -63,40 +559,195 @@ void fft_kernel_complex(mp_float_t *data, size_t n, int isign) {
         }
         j += m;
     }
+    return plan;
+}
 
-    mmax = 1;
-    while (n > mmax) {
-        istep = mmax << 1;
-        theta = MICROPY_FLOAT_CONST(-2.0)*isign*MP_PI/istep;
-        wtemp = MICROPY_FLOAT_C_FUN(sin)(MICROPY_FLOAT_CONST(0.5) * theta);
-        wpr = MICROPY_FLOAT_CONST(-2.0) * wtemp * wtemp;
-        wpi = MICROPY_FLOAT_C_FUN(sin)(theta);
-        wr = MICROPY_FLOAT_CONST(1.0);
-        wi = MICROPY_FLOAT_CONST(0.0);
-        for(m = 0; m < mmax; m++) {
-            for(size_t i = m; i < n; i += istep) {
-                j = i + mmax;
-                tempr = wr * data[2*j] - wi * data[2*j+1];
-                tempi = wr * data[2*j+1] + wi * data[2*j];
-                data[2*j] = data[2*i] - tempr;
-                data[2*j+1] = data[2*i+1] - tempi;
-                data[2*i] += tempr;
-                data[2*i+1] += tempi;
-            }
-            wtemp = wr;
-            wr = wr*wpr - wi*wpi + wr;
-            wi = wi*wpr + wtemp*wpi + wi;
+fft_plan_t *fft_get_plan(mp_obj_t plan_in, size_t len) {
+    // returns NULL, if no plan was supplied; otherwise, the plan must fit the input
+    if(plan_in == mp_const_none) {
+        return NULL;
+    }
+    if(!mp_obj_is_type(plan_in, &fft_plan_type)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("plan must be an FFT plan"));
+    }
+    fft_plan_t *plan = MP_OBJ_TO_PTR(plan_in);
+    if(plan->n != len) {
+        mp_raise_ValueError(MP_ERROR_TEXT("plan length must match input length"));
+    }
+    return plan;
+}
+
+#if ULAB_FFT_HAS_FFT_INPLACE | !(ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE)
+static void fft_kernel_split(mp_float_t *real, mp_float_t *imag, size_t n, int isign, fft_plan_t *plan) {
+    // arbitrary lengths are transformed by the mixed-radix kernel, which expects interleaved data
+    if((n & (n - 1)) == 0) {
+        fft_kernel_pow2(real, imag, 1, n, isign, plan);
+        return;
+    }
+    mp_float_t *data = ulab_scratch_new(mp_float_t, 2 * n);
+    for(size_t i = 0; i < n; i++) {
+        data[2*i] = real[i];
+        data[2*i+1] = imag[i];
+    }
+    fft_kernel_mixed(data, n, isign, NULL);
+    for(size_t i = 0; i < n; i++) {
+        real[i] = data[2*i];
+        imag[i] = data[2*i+1];
+    }
+    ulab_scratch_del(mp_float_t, data, 2 * n);
+}
+#endif
+
+static ndarray_obj_t *fft_get_out(mp_obj_t out, size_t len, uint8_t dtype) {
+    // the transform is written straight into out, hence, it must be dense
+    size_t shape[ULAB_MAX_DIMS] = { 0 };
+    shape[ULAB_MAX_DIMS - 1] = len;
+    ndarray_obj_t *ndarray = tools_get_out_array(out, 1, shape, dtype);
+    if(!ndarray_is_contiguous(ndarray)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("out must be a dense array"));
+    }
+    return ndarray;
+}
+
+#if ULAB_FFT_HAS_FFT_INPLACE
+mp_obj_t fft_inplace(mp_obj_t arg_re, mp_obj_t arg_im, uint8_t type, mp_obj_t plan_in) {
+    // transforms the dense float arrays arg_re, and arg_im where they are
+    if(!mp_obj_is_type(arg_re, &ulab_ndarray_type)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("FFT is defined for ndarrays only"));
+    }
+    ndarray_obj_t *re = MP_OBJ_TO_PTR(arg_re);
+    size_t len = re->len;
+    re = fft_get_out(arg_re, len, NDARRAY_FLOAT);
+    ndarray_obj_t *im = fft_get_out(arg_im, len, NDARRAY_FLOAT);
+    if(re->array == im->array) {
+        mp_raise_ValueError(MP_ERROR_TEXT("real and imaginary parts must be distinct arrays"));
+    }
+    fft_plan_t *plan = fft_get_plan(plan_in, len);
+    mp_float_t *data_re = (mp_float_t *)re->array;
+    mp_float_t *data_im = (mp_float_t *)im->array;
+
+    if(type == FFT_FFT) {
+        fft_kernel_split(data_re, data_im, len, 1, plan);
+    } else {
+        fft_kernel_split(data_re, data_im, len, -1, plan);
+        for(size_t i = 0; i < len; i++) {
+            *data_re++ /= len;
+            *data_im++ /= len;
+        }
+    }
+    return mp_const_none;
+}
+#endif /* ULAB_FFT_HAS_FFT_INPLACE */
+
+#if ULAB_FFT_HAS_AFFT
+typedef struct _fft_job_obj_t {
+    ulab_job_obj_t job;
+    mp_float_t *re;
+    mp_float_t *im;
+    size_t step;
+    size_t n;
+    int isign;
+    fft_plan_t *plan;
+    // the length of the sub-transforms that have been completed, 0 before the permutation
+    size_t mmax;
+} fft_job_obj_t;
+
+static bool fft_job_slice(ulab_job_obj_t *job) {
+    // the first slice is the permutation, and each further slice is a single pass over the data
+    fft_job_obj_t *self = (fft_job_obj_t *)job;
+    size_t n = self->n;
+    if(self->mmax != 0) {
+        fft_pow2_pass(self->re, self->im, self->step, n, self->mmax, self->isign, self->plan);
+        self->mmax <<= 2;
+    } else if((n & (n - 1)) != 0) {
+        // the mixed-radix, and Bluestein kernels are not resumable, hence they run in a single slice
+        #if ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE
+        fft_kernel_mixed(self->re, n, self->isign, self->plan);
+        #else
+        fft_kernel_split(self->re, self->im, n, self->isign, self->plan);
+        #endif
+        self->mmax = n;
+    #if ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE
+    } else if(ulab_dsp_cfft(self->re, n, self->isign)) {
+        self->mmax = n;
+    #endif
+    } else {
+        fft_pow2_permute(self->re, self->im, self->step, n, self->plan);
+        self->mmax = fft_pow2_first_stage(self->re, self->im, self->step, n);
+    }
+    if(self->mmax < n) {
+        return false;
+    }
+    if(self->isign == -1) {
+        for(size_t i = 0; i < n; i++) {
+            self->re[i * self->step] /= n;
+            self->im[i * self->step] /= n;
         }
-        mmax = istep;
     }
+    return true;
 }
 
+mp_obj_t fft_new_job(mp_obj_t arg_re, mp_obj_t arg_im, uint8_t type, mp_obj_t plan_in) {
+    // the input is copied into the output, which is then transformed in place by the slices
+    ndarray_obj_t *re = fft_get_linear_array(arg_re);
+    size_t len = re->len;
+    fft_plan_t *plan = fft_get_plan(plan_in, len);
+
+    fft_job_obj_t *self = ulab_new_job(fft_job_obj_t, fft_job_slice);
+    self->n = len;
+    self->isign = type == FFT_FFT ? 1 : -1;
+    self->plan = plan;
+    self->mmax = 0;
+
+    #if ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE
+    (void)arg_im;
+    ndarray_obj_t *out = ndarray_new_linear_array(len, NDARRAY_COMPLEX);
+    mp_float_t *data = (mp_float_t *)out->array;
+    if(re->dtype == NDARRAY_COMPLEX) {
+        uint8_t *array = (uint8_t *)re->array;
+        for(size_t i = 0; i < len; i++) {
+            memcpy(data + 2 * i, array, 2 * sizeof(mp_float_t));
+            array += re->strides[ULAB_MAX_DIMS - 1];
+        }
+    } else {
+        fft_copy_real(re, data, 2);
+    }
+    self->re = data;
+    self->im = data + 1;
+    self->step = 2;
+    self->job.result = MP_OBJ_FROM_PTR(out);
+    #else
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(re->dtype)
+    ndarray_obj_t *out_re = ndarray_new_linear_array(len, NDARRAY_FLOAT);
+    ndarray_obj_t *out_im = ndarray_new_linear_array(len, NDARRAY_FLOAT);
+    fft_copy_real(re, (mp_float_t *)out_re->array, 1);
+    if(arg_im != mp_const_none) {
+        ndarray_obj_t *im = fft_get_linear_array(arg_im);
+        COMPLEX_DTYPE_NOT_IMPLEMENTED(im->dtype)
+        if(im->len != len) {
+            mp_raise_ValueError(MP_ERROR_TEXT("real and imaginary parts must be of equal length"));
+        }
+        fft_copy_real(im, (mp_float_t *)out_im->array, 1);
+    }
+    self->re = (mp_float_t *)out_re->array;
+    self->im = (mp_float_t *)out_im->array;
+    self->step = 1;
+    mp_obj_t tuple[2];
+    tuple[0] = MP_OBJ_FROM_PTR(out_re);
+    tuple[1] = MP_OBJ_FROM_PTR(out_im);
+    self->job.result = mp_obj_new_tuple(2, tuple);
+    #endif
+    return MP_OBJ_FROM_PTR(self);
+}
+#endif /* ULAB_FFT_HAS_AFFT */
+
+#if ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE
 /*
  * The following function is a helper interface to the python side.
  * It has been factored out from fft.c, so that the same argument parsing
  * routine can be called from scipy.signal.spectrogram.
  */
-mp_obj_t fft_fft_ifft_spectrogram(mp_obj_t data_in, uint8_t type) {
+mp_obj_t fft_fft_ifft_spectrogram(mp_obj_t data_in, uint8_t type, mp_obj_t plan_in, mp_obj_t out_in) {
     if(!mp_obj_is_type(data_in, &ulab_ndarray_type)) {
         mp_raise_NotImplementedError(MP_ERROR_TEXT("FFT is defined for ndarrays only"));
     }
@@ -107,47 +758,58 @@ mp_obj_t fft_fft_ifft_spectrogram(mp_obj_t data_in, uint8_t type) {
     }
     #endif
     size_t len = in->len;
-    // Check if input is of length of power of 2
-    if((len & (len-1)) != 0) {
-        mp_raise_ValueError(MP_ERROR_TEXT("input array length must be power of 2"));
+
+    if((type == FFT_SPECTROGRAM) && (in->dtype != NDARRAY_COMPLEX) && ((len & (len-1)) == 0)) {
+        return fft_real_spectrogram(in);
     }
+    fft_plan_t *plan = fft_get_plan(plan_in, len);
 
-    ndarray_obj_t *out = ndarray_new_linear_array(len, NDARRAY_COMPLEX);
-    mp_float_t *data = (mp_float_t *)out->array;
+    ndarray_obj_t *out = NULL;
+    mp_float_t *data;
+    if(type == FFT_SPECTROGRAM) {
+        // the complex transform is only an intermediate result
+        data = ulab_scratch_new0(mp_float_t, 2 * len);
+    } else if(out_in != mp_const_none) {
+        out = fft_get_out(out_in, len, NDARRAY_COMPLEX);
+        data = (mp_float_t *)out->array;
+    } else {
+        out = ndarray_new_linear_array(len, NDARRAY_COMPLEX);
+        data = (mp_float_t *)out->array;
+    }
     uint8_t *array = (uint8_t *)in->array;
 
     if(in->dtype == NDARRAY_COMPLEX) {
-        uint8_t sz = 2 * sizeof(mp_float_t);
-        for(size_t i = 0; i < len; i++) {
-            memcpy(data, array, sz);
-            data += 2;
-            array += in->strides[ULAB_MAX_DIMS - 1];
+        // there is nothing to copy, if the input is transformed in place
+        if(array != (uint8_t *)data) {
+            uint8_t sz = 2 * sizeof(mp_float_t);
+            for(size_t i = 0; i < len; i++) {
+                memcpy(data + 2 * i, array, sz);
+                array += in->strides[ULAB_MAX_DIMS - 1];
+            }
         }
     } else {
         mp_float_t (*func)(void *) = ndarray_get_float_function(in->dtype);
         for(size_t i = 0; i < len; i++) {
-            // real part; the imaginary part is 0, no need to assign
-            *data = func(array);
-            data += 2;
+            // the imaginary part has to be cleared, if the output was supplied by the caller
+            data[2 * i] = func(array);
+            data[2 * i + 1] = MICROPY_FLOAT_CONST(0.0);
             array += in->strides[ULAB_MAX_DIMS - 1];
         }
     }
-    data -= 2 * len;
 
     if((type == FFT_FFT) || (type == FFT_SPECTROGRAM)) {
-        fft_kernel_complex(data, len, 1);
+        fft_kernel_mixed(data, len, 1, plan);
         if(type == FFT_SPECTROGRAM) {
             ndarray_obj_t *spectrum = ndarray_new_linear_array(len, NDARRAY_FLOAT);
             mp_float_t *sarray = (mp_float_t *)spectrum->array;
             for(size_t i = 0; i < len; i++) {
-                *sarray++ = MICROPY_FLOAT_C_FUN(sqrt)(data[0] * data[0] + data[1] * data[1]);
-                data += 2;
+                sarray[i] = MICROPY_FLOAT_C_FUN(sqrt)(data[2*i] * data[2*i] + data[2*i+1] * data[2*i+1]);
             }
-            m_del(mp_float_t, data, 2 * len);
+            ulab_scratch_del(mp_float_t, data, 2 * len);
             return MP_OBJ_FROM_PTR(spectrum);
         }
     } else { // inverse transform
-        fft_kernel_complex(data, len, -1);
+        fft_kernel_mixed(data, len, -1, plan);
         // TODO: numpy accepts the norm keyword argument
         for(size_t i = 0; i < 2 * len; i++) {
             *data++ /= len;
@@ -155,54 +817,64 @@ mp_obj_t fft_fft_ifft_spectrogram(mp_obj_t data_in, uint8_t type) {
     }
     return MP_OBJ_FROM_PTR(out);
 }
-#else /* ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE */
-void fft_kernel(mp_float_t *real, mp_float_t *imag, size_t n, int isign) {
-    size_t j, m, mmax, istep;
-    mp_float_t tempr, tempi;
-    mp_float_t wtemp, wr, wpr, wpi, wi, theta;
 
-    j = 0;
-    for(size_t i = 0; i < n; i++) {
-        if (j > i) {
-            SWAP(mp_float_t, real[i], real[j]);
-            SWAP(mp_float_t, imag[i], imag[j]);
+mp_obj_t fft_rfft_irfft(mp_obj_t data_in, uint8_t type) {
+    ndarray_obj_t *in = fft_get_linear_array(data_in);
+    size_t len = in->len;
+
+    if(type == FFT_RFFT) {
+        if(in->dtype == NDARRAY_COMPLEX) {
+            mp_raise_TypeError(MP_ERROR_TEXT("input must be a real array"));
         }
-        m = n >> 1;
-        while (j >= m && m > 0) {
-            j -= m;
-            m >>= 1;
+        if((len & (len-1)) != 0) {
+            mp_raise_ValueError(MP_ERROR_TEXT("input array length must be power of 2"));
         }
-        j += m;
+        // the output has room for len + 2 floats, so the transform can be done in place
+        ndarray_obj_t *out = ndarray_new_linear_array(len / 2 + 1, NDARRAY_COMPLEX);
+        mp_float_t *data = (mp_float_t *)out->array;
+        fft_copy_real(in, data, 1);
+        fft_kernel_real(data, len, 1, NULL);
+        return MP_OBJ_FROM_PTR(out);
     }
 
-    mmax = 1;
-    while (n > mmax) {
-        istep = mmax << 1;
-        theta = MICROPY_FLOAT_CONST(-2.0)*isign*MP_PI/istep;
-        wtemp = MICROPY_FLOAT_C_FUN(sin)(MICROPY_FLOAT_CONST(0.5) * theta);
-        wpr = MICROPY_FLOAT_CONST(-2.0) * wtemp * wtemp;
-        wpi = MICROPY_FLOAT_C_FUN(sin)(theta);
-        wr = MICROPY_FLOAT_CONST(1.0);
-        wi = MICROPY_FLOAT_CONST(0.0);
-        for(m = 0; m < mmax; m++) {
-            for(size_t i = m; i < n; i += istep) {
-                j = i + mmax;
-                tempr = wr * real[j] - wi * imag[j];
-                tempi = wr * imag[j] + wi * real[j];
-                real[j] = real[i] - tempr;
-                imag[j] = imag[i] - tempi;
-                real[i] += tempr;
-                imag[i] += tempi;
-            }
-            wtemp = wr;
-            wr = wr*wpr - wi*wpi + wr;
-            wi = wi*wpr + wtemp*wpi + wi;
+    // inverse transform
+    size_t n = fft_irfft_length(len);
+    mp_float_t *data = ulab_scratch_new0(mp_float_t, n + 2);
+    if(in->dtype == NDARRAY_COMPLEX) {
+        uint8_t *array = (uint8_t *)in->array;
+        uint8_t sz = 2 * sizeof(mp_float_t);
+        for(size_t i = 0; i < len; i++) {
+            memcpy(&data[2*i], array, sz);
+            array += in->strides[ULAB_MAX_DIMS - 1];
         }
-        mmax = istep;
+    } else {
+        fft_copy_real(in, data, 2);
     }
+    fft_kernel_real(data, n, -1, NULL);
+
+    ndarray_obj_t *out = ndarray_new_linear_array(n, NDARRAY_FLOAT);
+    mp_float_t *array = (mp_float_t *)out->array;
+    for(size_t i = 0; i < n; i++) {
+        *array++ = data[i] / n;
+    }
+    ulab_scratch_del(mp_float_t, data, n + 2);
+    return MP_OBJ_FROM_PTR(out);
+}
+#else /* ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE */
+/* Kernel implementation for the case, when ulab has no complex support
+
+ * The following function takes two arrays, namely, the real and imaginary
+ * parts of a complex array, and calculates the Fourier transform in place.
+ *
+ * The function is a thin wrapper around the power-of-two kernel, which
+ * has no dependencies beyond micropython itself (for the definition of mp_float_t),
+ * and can be used independent of ulab.
+ */
+void fft_kernel(mp_float_t *real, mp_float_t *imag, size_t n, int isign, fft_plan_t *plan) {
+    fft_kernel_pow2(real, imag, 1, n, isign, plan);
 }
 
-mp_obj_t fft_fft_ifft_spectrogram(size_t n_args, mp_obj_t arg_re, mp_obj_t arg_im, uint8_t type) {
+mp_obj_t fft_fft_ifft_spectrogram(size_t n_args, mp_obj_t arg_re, mp_obj_t arg_im, uint8_t type, mp_obj_t plan_in, mp_obj_t out_in) {
     if(!mp_obj_is_type(arg_re, &ulab_ndarray_type)) {
         mp_raise_NotImplementedError(MP_ERROR_TEXT("FFT is defined for ndarrays only"));
     }
@@ -219,12 +891,28 @@ mp_obj_t fft_fft_ifft_spectrogram(size_t n_args, mp_obj_t arg_re, mp_obj_t arg_i
     }
     #endif
     size_t len = re->len;
-    // Check if input is of length of power of 2
-    if((len & (len-1)) != 0) {
-        mp_raise_ValueError(MP_ERROR_TEXT("input array length must be power of 2"));
+
+    if((type == FFT_SPECTROGRAM) && (n_args == 1) && ((len & (len-1)) == 0)) {
+        return fft_real_spectrogram(re);
     }
+    fft_plan_t *plan = fft_get_plan(plan_in, len);
 
-    ndarray_obj_t *out_re = ndarray_new_linear_array(len, NDARRAY_FLOAT);
+    ndarray_obj_t *out_re, *out_im;
+    if(out_in != mp_const_none) {
+        // the real, and imaginary parts are written into the two arrays of the caller
+        if(!mp_obj_is_type(out_in, &mp_type_tuple) || (((mp_obj_tuple_t *)MP_OBJ_TO_PTR(out_in))->len != 2)) {
+            mp_raise_TypeError(MP_ERROR_TEXT("out must be a tuple of two ndarrays"));
+        }
+        mp_obj_t *items = ((mp_obj_tuple_t *)MP_OBJ_TO_PTR(out_in))->items;
+        out_re = fft_get_out(items[0], len, NDARRAY_FLOAT);
+        out_im = fft_get_out(items[1], len, NDARRAY_FLOAT);
+        if(out_re->array == out_im->array) {
+            mp_raise_ValueError(MP_ERROR_TEXT("real and imaginary parts must be distinct arrays"));
+        }
+    } else {
+        out_re = ndarray_new_linear_array(len, NDARRAY_FLOAT);
+        out_im = ndarray_new_linear_array(len, NDARRAY_FLOAT);
+    }
     mp_float_t *data_re = (mp_float_t *)out_re->array;
 
     uint8_t *array = (uint8_t *)re->array;
@@ -235,7 +923,6 @@ mp_obj_t fft_fft_ifft_spectrogram(size_t n_args, mp_obj_t arg_re, mp_obj_t arg_i
         array += re->strides[ULAB_MAX_DIMS - 1];
     }
     data_re -= len;
-    ndarray_obj_t *out_im = ndarray_new_linear_array(len, NDARRAY_FLOAT);
     mp_float_t *data_im = (mp_float_t *)out_im->array;
 
     if(n_args == 2) {
@@ -256,10 +943,12 @@ mp_obj_t fft_fft_ifft_spectrogram(size_t n_args, mp_obj_t arg_re, mp_obj_t arg_i
            array += im->strides[ULAB_MAX_DIMS - 1];
         }
         data_im -= len;
+    } else if(out_in != mp_const_none) {
+        memset(data_im, 0, len * sizeof(mp_float_t));
     }
 
     if((type == FFT_FFT) || (type == FFT_SPECTROGRAM)) {
-        fft_kernel(data_re, data_im, len, 1);
+        fft_kernel_split(data_re, data_im, len, 1, plan);
         if(type == FFT_SPECTROGRAM) {
             for(size_t i=0; i < len; i++) {
                 *data_re = MICROPY_FLOAT_C_FUN(sqrt)(*data_re * *data_re + *data_im * *data_im);
@@ -268,7 +957,7 @@ mp_obj_t fft_fft_ifft_spectrogram(size_t n_args, mp_obj_t arg_re, mp_obj_t arg_i
             }
         }
     } else { // inverse transform
-        fft_kernel(data_re, data_im, len, -1);
+        fft_kernel_split(data_re, data_im, len, -1, plan);
         // TODO: numpy accepts the norm keyword argument
         for(size_t i=0; i < len; i++) {
             *data_re++ /= len;
@@ -284,4 +973,208 @@ mp_obj_t fft_fft_ifft_spectrogram(size_t n_args, mp_obj_t arg_re, mp_obj_t arg_i
         return mp_obj_new_tuple(2, tuple);
     }
 }
+
+mp_obj_t fft_rfft_irfft(size_t n_args, mp_obj_t arg_re, mp_obj_t arg_im, uint8_t type) {
+    ndarray_obj_t *re = fft_get_linear_array(arg_re);
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(re->dtype)
+    size_t len = re->len;
+
+    if(type == FFT_RFFT) {
+        if((len & (len-1)) != 0) {
+            mp_raise_ValueError(MP_ERROR_TEXT("input array length must be power of 2"));
+        }
+        mp_float_t *data = ulab_scratch_new(mp_float_t, len + 2);
+        fft_copy_real(re, data, 1);
+        fft_kernel_real(data, len, 1, NULL);
+
+        ndarray_obj_t *out_re = ndarray_new_linear_array(len / 2 + 1, NDARRAY_FLOAT);
+        ndarray_obj_t *out_im = ndarray_new_linear_array(len / 2 + 1, NDARRAY_FLOAT);
+        mp_float_t *data_re = (mp_float_t *)out_re->array;
+        mp_float_t *data_im = (mp_float_t *)out_im->array;
+        for(size_t i = 0; i < len / 2 + 1; i++) {
+            *data_re++ = data[2*i];
+            *data_im++ = data[2*i+1];
+        }
+        ulab_scratch_del(mp_float_t, data, len + 2);
+
+        mp_obj_t tuple[2];
+        tuple[0] = MP_OBJ_FROM_PTR(out_re);
+        tuple[1] = MP_OBJ_FROM_PTR(out_im);
+        return mp_obj_new_tuple(2, tuple);
+    }
+
+    // inverse transform
+    size_t n = fft_irfft_length(len);
+    ndarray_obj_t *im = NULL;
+    if(n_args == 2) {
+        im = fft_get_linear_array(arg_im);
+        COMPLEX_DTYPE_NOT_IMPLEMENTED(im->dtype)
+        if(re->len != im->len) {
+            mp_raise_ValueError(MP_ERROR_TEXT("real and imaginary parts must be of equal length"));
+        }
+    }
+    mp_float_t *data = ulab_scratch_new0(mp_float_t, n + 2);
+    fft_copy_real(re, data, 2);
+    if(im != NULL) {
+        fft_copy_real(im, data + 1, 2);
+    }
+    fft_kernel_real(data, n, -1, NULL);
+
+    ndarray_obj_t *out = ndarray_new_linear_array(n, NDARRAY_FLOAT);
+    mp_float_t *array = (mp_float_t *)out->array;
+    for(size_t i = 0; i < n; i++) {
+        *array++ = data[i] / n;
+    }
+    ulab_scratch_del(mp_float_t, data, n + 2);
+    return MP_OBJ_FROM_PTR(out);
+}
 #endif  /* ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE */
+
+#if ULAB_SUPPORTS_Q15
+/* Fixed-point kernel for power-of-two lengths. The real and imaginary parts are int16
+ * values in Q15 format, and the transform is calculated in place by radix-2 butterflies,
+ * whose products are accumulated in 32 bits, and rounded back to Q15. The results are
+ * saturated, so that the data never wrap around.
+ *
+ * If block is false, each stage is scaled by 1/2, so that the result is the transform
+ * divided by n, and overflow is impossible. If block is true, a stage is scaled only,
+ * if the largest magnitude in the data exceeds FFT_Q15_HEADROOM (block floating point),
+ * which preserves the precision of weak signals. The function returns the number of
+ * stages that were scaled, i.e., the transform is the result multiplied by 2 to this power.
+ * No floating point operations are executed in the butterflies, only the twiddle factors
+ * are derived from the floating point recurrence, or taken from the plan.
+ */
+uint8_t fft_kernel_q15(int16_t *re, int16_t *im, size_t n, int isign, bool block, fft_plan_t *plan) {
+    size_t j, m;
+    if(plan != NULL) {
+        for(size_t i = 0; i < n; i++) {
+            j = plan->permutation[i];
+            if (j > i) {
+                SWAP(int16_t, re[i], re[j]);
+                SWAP(int16_t, im[i], im[j]);
+            }
+        }
+    } else {
+        j = 0;
+        for(size_t i = 0; i < n; i++) {
+            if (j > i) {
+                SWAP(int16_t, re[i], re[j]);
+                SWAP(int16_t, im[i], im[j]);
+            }
+            m = n >> 1;
+            while (j >= m && m > 0) {
+                j -= m;
+                m >>= 1;
+            }
+            j += m;
+        }
+    }
+
+    uint8_t scaled = 0;
+    mp_float_t wtemp, wr, wi, theta;
+    mp_float_t wpr = MICROPY_FLOAT_CONST(0.0), wpi = MICROPY_FLOAT_CONST(0.0);
+    for(size_t mmax = 1; mmax < n; mmax <<= 1) {
+        size_t istep = mmax << 1;
+        int32_t shift = 1;
+        if(block) {
+            int32_t largest = 0;
+            for(size_t i = 0; i < n; i++) {
+                int32_t r = re[i] < 0 ? -re[i] : re[i];
+                int32_t c = im[i] < 0 ? -im[i] : im[i];
+                largest = MAX(largest, MAX(r, c));
+            }
+            shift = largest > FFT_Q15_HEADROOM ? 1 : 0;
+        }
+        scaled += shift;
+
+        if(plan == NULL) {
+            theta = MICROPY_FLOAT_CONST(-2.0)*isign*MP_PI/istep;
+            wtemp = MICROPY_FLOAT_C_FUN(sin)(MICROPY_FLOAT_CONST(0.5) * theta);
+            wpr = MICROPY_FLOAT_CONST(-2.0) * wtemp * wtemp;
+            wpi = MICROPY_FLOAT_C_FUN(sin)(theta);
+        }
+        wr = MICROPY_FLOAT_CONST(1.0);
+        wi = MICROPY_FLOAT_CONST(0.0);
+        for(m = 0; m < mmax; m++) {
+            if(plan != NULL) {
+                FFT_PLAN_TWIDDLE(plan, m * (n / istep), isign, wr, wi);
+            }
+            int32_t qr = (int32_t)MICROPY_FLOAT_C_FUN(floor)(wr * FFT_Q15_ONE + MICROPY_FLOAT_CONST(0.5));
+            int32_t qi = (int32_t)MICROPY_FLOAT_C_FUN(floor)(wi * FFT_Q15_ONE + MICROPY_FLOAT_CONST(0.5));
+            for(size_t i = m; i < n; i += istep) {
+                j = i + mmax;
+                // |qr| + |qi| < 2^16, hence the sums of the products fit into 32 bits
+                int32_t tr = (qr * re[j] - qi * im[j] + (1 << 14)) >> 15;
+                int32_t ti = (qr * im[j] + qi * re[j] + (1 << 14)) >> 15;
+                int32_t ar = re[i];
+                int32_t ai = im[i];
+                re[j] = TOOLS_Q15_SATURATE((ar - tr + shift) >> shift);
+                im[j] = TOOLS_Q15_SATURATE((ai - ti + shift) >> shift);
+                re[i] = TOOLS_Q15_SATURATE((ar + tr + shift) >> shift);
+                im[i] = TOOLS_Q15_SATURATE((ai + ti + shift) >> shift);
+            }
+            if(plan == NULL) {
+                wtemp = wr;
+                wr = wr*wpr - wi*wpi + wr;
+                wi = wi*wpr + wtemp*wpi + wi;
+            }
+        }
+    }
+    return scaled;
+}
+
+static void fft_copy_q15(ndarray_obj_t *ndarray, int16_t *data) {
+    uint8_t *array = (uint8_t *)ndarray->array;
+    for(size_t i = 0; i < ndarray->len; i++) {
+        *data++ = *((int16_t *)array);
+        array += ndarray->strides[ULAB_MAX_DIMS - 1];
+    }
+}
+
+/*
+ * The python interface of the fixed-point transforms. The result is returned as the tuple
+ * (real, imag, exponent), where real, and imag are int16 arrays, and the transform is
+ * (real + 1j * imag) * 2**exponent. The inverse transform is normalised as in numpy.
+ */
+mp_obj_t fft_fft_ifft_q15(mp_obj_t arg_re, mp_obj_t arg_im, uint8_t type, bool block, mp_obj_t plan_in) {
+    ndarray_obj_t *re = fft_get_linear_array(arg_re);
+    if(re->dtype != NDARRAY_INT16) {
+        mp_raise_TypeError(MP_ERROR_TEXT("fixed-point FFT requires int16 arrays"));
+    }
+    size_t len = re->len;
+    if((len == 0) || ((len & (len-1)) != 0)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("input array length must be power of 2"));
+    }
+    fft_plan_t *plan = fft_get_plan(plan_in, len);
+
+    ndarray_obj_t *out_re = ndarray_new_linear_array(len, NDARRAY_INT16);
+    ndarray_obj_t *out_im = ndarray_new_linear_array(len, NDARRAY_INT16);
+    fft_copy_q15(re, (int16_t *)out_re->array);
+    if(arg_im != mp_const_none) {
+        ndarray_obj_t *im = fft_get_linear_array(arg_im);
+        if(im->dtype != NDARRAY_INT16) {
+            mp_raise_TypeError(MP_ERROR_TEXT("fixed-point FFT requires int16 arrays"));
+        }
+        if(re->len != im->len) {
+            mp_raise_ValueError(MP_ERROR_TEXT("real and imaginary parts must be of equal length"));
+        }
+        fft_copy_q15(im, (int16_t *)out_im->array);
+    }
+
+    int isign = (type == FFT_IFFT) ? -1 : 1;
+    int32_t exponent = fft_kernel_q15((int16_t *)out_re->array, (int16_t *)out_im->array, len, isign, block, plan);
+    if(type == FFT_IFFT) {
+        // the inverse transform is divided by len
+        while(len > 1) {
+            exponent--;
+            len >>= 1;
+        }
+    }
+
+    mp_obj_t tuple[3];
+    tuple[0] = MP_OBJ_FROM_PTR(out_re);
+    tuple[1] = MP_OBJ_FROM_PTR(out_im);
+    tuple[2] = mp_obj_new_int(exponent);
+    return mp_obj_new_tuple(3, tuple);
+}
+#endif /* ULAB_SUPPORTS_Q15 */
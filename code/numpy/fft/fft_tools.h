@@ -15,14 +15,59 @@ enum FFT_TYPE {
     FFT_FFT,
     FFT_IFFT,
     FFT_SPECTROGRAM,
+    FFT_RFFT,
+    FFT_IRFFT,
 };
 
+// a plan holds the twiddle factors, and the bit-reversal permutation of a transform of length n,
+// so that these don't have to be re-calculated, if transforms of the same length are repeated
+typedef struct _fft_plan_t {
+    mp_obj_base_t base;
+    size_t n;
+    mp_float_t *twiddles;
+    uint16_t *permutation;
+} fft_plan_t;
+
+extern const mp_obj_type_t fft_plan_type;
+
+// loads the twiddle factor exp(-2 pi i isign k / n) from the table of the plan
+#define FFT_PLAN_TWIDDLE(plan, k, isign, wr, wi) {\
+    (wr) = (plan)->twiddles[2 * (k)];\
+    (wi) = (isign) * (plan)->twiddles[2 * (k) + 1];\
+}
+
+fft_plan_t *fft_new_plan(size_t );
+fft_plan_t *fft_get_plan(mp_obj_t , size_t );
+
+void fft_kernel_complex(mp_float_t *, size_t , int , fft_plan_t *);
+void fft_kernel_mixed(mp_float_t *, size_t , int , fft_plan_t *);
+void fft_kernel_real(mp_float_t *, size_t , int , fft_plan_t *);
+
+#if ULAB_SUPPORTS_Q15
+// 1.0 in Q15 format, and the largest magnitude that survives an unscaled radix-2 stage,
+// i.e., FFT_Q15_ONE / (1 + sqrt(2))
+#define FFT_Q15_ONE         MICROPY_FLOAT_CONST(32767.0)
+#define FFT_Q15_HEADROOM    (13572)
+
+uint8_t fft_kernel_q15(int16_t *, int16_t *, size_t , int , bool , fft_plan_t *);
+mp_obj_t fft_fft_ifft_q15(mp_obj_t , mp_obj_t , uint8_t , bool , mp_obj_t );
+#endif
+
+#if ULAB_FFT_HAS_FFT_INPLACE
+mp_obj_t fft_inplace(mp_obj_t , mp_obj_t , uint8_t , mp_obj_t );
+#endif
+
+#if ULAB_FFT_HAS_AFFT
+mp_obj_t fft_new_job(mp_obj_t , mp_obj_t , uint8_t , mp_obj_t );
+#endif
+
 #if ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE
-void fft_kernel(mp_float_t *, size_t , int );
-mp_obj_t fft_fft_ifft_spectrogram(mp_obj_t , uint8_t );
+mp_obj_t fft_fft_ifft_spectrogram(mp_obj_t , uint8_t , mp_obj_t , mp_obj_t );
+mp_obj_t fft_rfft_irfft(mp_obj_t , uint8_t );
 #else
-void fft_kernel(mp_float_t *, mp_float_t *, size_t , int );
-mp_obj_t fft_fft_ifft_spectrogram(size_t , mp_obj_t , mp_obj_t , uint8_t );
+void fft_kernel(mp_float_t *, mp_float_t *, size_t , int , fft_plan_t *);
+mp_obj_t fft_fft_ifft_spectrogram(size_t , mp_obj_t , mp_obj_t , uint8_t , mp_obj_t , mp_obj_t );
+mp_obj_t fft_rfft_irfft(size_t , mp_obj_t , mp_obj_t , uint8_t );
 #endif /* ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE */
 
 #endif /* _FFT_TOOLS_ */
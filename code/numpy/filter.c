@@ -20,50 +20,205 @@
 #include "py/misc.h"
 
 #include "../ulab.h"
+#include "../ulab_tools.h"
+#include "../ulab_dsp.h"
+#include "../ulab_job.h"
 #include "../scipy/signal/signal.h"
 #include "carray/carray_tools.h"
 #include "filter.h"
+#include "fft/fft_tools.h"
 
 #if ULAB_NUMPY_HAS_CONVOLVE
 
-mp_obj_t filter_convolve(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    static const mp_arg_t allowed_args[] = {
-        { MP_QSTR_a, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
-        { MP_QSTR_v, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
-    };
+static void filter_load(mp_float_t *data, ndarray_obj_t *ndarray, size_t offset, size_t count, bool interleaved) {
+    // copies count elements of ndarray, starting at offset, into data; if interleaved is true,
+    // the imaginary parts are written to the odd positions, otherwise, the array must be real
+    uint8_t *array = (uint8_t *)ndarray->array + offset * ndarray->strides[ULAB_MAX_DIMS - 1];
+    #if ULAB_SUPPORTS_COMPLEX
+    if(ndarray->dtype == NDARRAY_COMPLEX) {
+        for(size_t i = 0; i < count; i++) {
+            memcpy(data, array, 2 * sizeof(mp_float_t));
+            data += 2;
+            array += ndarray->strides[ULAB_MAX_DIMS - 1];
+        }
+        return;
+    }
+    #endif
+    mp_float_t (*func)(void *) = ndarray_get_float_function(ndarray->dtype);
+    for(size_t i = 0; i < count; i++) {
+        *data = func(array);
+        data += interleaved ? 2 : 1;
+        array += ndarray->strides[ULAB_MAX_DIMS - 1];
+    }
+}
 
-    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
-    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+enum FILTER_CONVOLVE_METHOD {
+    FILTER_CONVOLVE_DIRECT,
+    FILTER_CONVOLVE_FFT,
+    FILTER_CONVOLVE_Q15,
+};
 
-    if(!mp_obj_is_type(args[0].u_obj, &ulab_ndarray_type) || !mp_obj_is_type(args[1].u_obj, &ulab_ndarray_type)) {
-        mp_raise_TypeError(MP_ERROR_TEXT("convolve arguments must be ndarrays"));
-    }
+// the parsed arguments of convolve, and aconvolve: results holds the samples of the full
+// convolution of a, and c, starting at shift; with the FFT method, c is the shorter input
+typedef struct _filter_convolve_t {
+    ndarray_obj_t *a;
+    ndarray_obj_t *c;
+    ndarray_obj_t *results;
+    int32_t shift;
+    uint8_t method;
+} filter_convolve_t;
 
-    ndarray_obj_t *a = MP_OBJ_TO_PTR(args[0].u_obj);
-    ndarray_obj_t *c = MP_OBJ_TO_PTR(args[1].u_obj);
-    // deal with linear arrays only
-    #if ULAB_MAX_DIMS > 1
-    if((a->ndim != 1) || (c->ndim != 1)) {
-        mp_raise_TypeError(MP_ERROR_TEXT("convolve arguments must be linear arrays"));
+// the state of the overlap-add convolution: the spectrum of the kernel c is calculated once,
+// and the signal a is transformed in blocks, so that the scratch space is bounded by the length
+// of the kernel, and not that of the signal
+typedef struct _filter_fft_t {
+    mp_float_t *kernel;
+    mp_float_t *buffer;
+    size_t n;
+    size_t block;
+    size_t size;
+    bool is_complex;
+    // the buffers are taken from the scratch space, unless they have to outlive the call
+    bool scratch;
+} filter_fft_t;
+
+static void filter_fft_init(filter_convolve_t *conv, filter_fft_t *fft, bool scratch) {
+    size_t len_c = conv->c->len;
+    size_t len = conv->a->len + len_c - 1;
+
+    // the transform length is at least twice the kernel, but not longer than the full result
+    size_t n = 1;
+    while(n < 2 * len_c) {
+        n <<= 1;
+    }
+    size_t nfull = 1;
+    while(nfull < len) {
+        nfull <<= 1;
     }
+    fft->n = MIN(n, nfull);
+    fft->block = fft->n - len_c + 1;
+
+    fft->is_complex = false;
+    #if ULAB_SUPPORTS_COMPLEX
+    fft->is_complex = conv->results->dtype == NDARRAY_COMPLEX;
     #endif
-    size_t len_a = a->len;
-    size_t len_c = c->len;
-    if(len_a == 0 || len_c == 0) {
-        mp_raise_TypeError(MP_ERROR_TEXT("convolve arguments must not be empty"));
+    // real data are transformed by the half-length real kernel,
+    // which requires n/2 + 1 complex values
+    fft->size = fft->is_complex ? 2 * fft->n : fft->n + 2;
+    fft->scratch = scratch;
+    if(scratch) {
+        fft->kernel = ulab_scratch_new0(mp_float_t, fft->size);
+        fft->buffer = ulab_scratch_new(mp_float_t, fft->size);
+    } else {
+        fft->kernel = m_new0(mp_float_t, fft->size);
+        fft->buffer = m_new(mp_float_t, fft->size);
+    }
+
+    filter_load(fft->kernel, conv->c, 0, len_c, fft->is_complex);
+    if(fft->is_complex) {
+        fft_kernel_complex(fft->kernel, fft->n, 1, NULL);
+    } else {
+        fft_kernel_real(fft->kernel, fft->n, 1, NULL);
+    }
+}
+
+static void filter_fft_block(filter_convolve_t *conv, filter_fft_t *fft, size_t start) {
+    // adds the convolution of the block of a starting at start to the results
+    size_t len_a = conv->a->len;
+    size_t len = len_a + conv->c->len - 1;
+    size_t shift = conv->shift;
+    size_t n = fft->n;
+    mp_float_t *kernel = fft->kernel;
+    mp_float_t *buffer = fft->buffer;
+    mp_float_t *array = (mp_float_t *)conv->results->array;
+
+    memset(buffer, 0, fft->size * sizeof(mp_float_t));
+    filter_load(buffer, conv->a, start, MIN(fft->block, len_a - start), fft->is_complex);
+    if(fft->is_complex) {
+        fft_kernel_complex(buffer, n, 1, NULL);
+    } else {
+        fft_kernel_real(buffer, n, 1, NULL);
+    }
+    size_t pairs = fft->is_complex ? n : n / 2 + 1;
+    for(size_t k = 0; k < pairs; k++) {
+        mp_float_t re = buffer[2*k] * kernel[2*k] - buffer[2*k+1] * kernel[2*k+1];
+        buffer[2*k+1] = buffer[2*k] * kernel[2*k+1] + buffer[2*k+1] * kernel[2*k];
+        buffer[2*k] = re;
+    }
+    // the part of the block that falls into the requested window of the full result
+    size_t begin = MAX(start, shift);
+    size_t end = MIN(MIN(start + n, len), shift + conv->results->len);
+    if(begin >= end) {
+        return;
     }
+    if(fft->is_complex) {
+        fft_kernel_complex(buffer, n, -1, NULL);
+        for(size_t i = begin; i < end; i++) {
+            array[2 * (i - shift)] += buffer[2 * (i - start)] / n;
+            array[2 * (i - shift) + 1] += buffer[2 * (i - start) + 1] / n;
+        }
+    } else {
+        fft_kernel_real(buffer, n, -1, NULL);
+        for(size_t i = begin; i < end; i++) {
+            array[i - shift] += buffer[i - start] / n;
+        }
+    }
+}
 
-    int len = len_a + len_c - 1; // convolve mode "full"
+static void filter_fft_free(filter_fft_t *fft) {
+    // the buffers are released in the reverse order of their allocation
+    if(fft->scratch) {
+        ulab_scratch_del(mp_float_t, fft->buffer, fft->size);
+        ulab_scratch_del(mp_float_t, fft->kernel, fft->size);
+    } else {
+        m_del(mp_float_t, fft->buffer, fft->size);
+        m_del(mp_float_t, fft->kernel, fft->size);
+    }
+    fft->buffer = NULL;
+    fft->kernel = NULL;
+}
+
+#if ULAB_SUPPORTS_Q15
+static void filter_convolve_q15(filter_convolve_t *conv, int32_t first, int32_t count) {
+    // the direct convolution of two int16 arrays in Q15 format: the products are accumulated
+    // exactly in 64 bits, and the sums are rounded, and saturated to Q15 only at the end;
+    // the samples first...first + count - 1 of the results are calculated
+    ndarray_obj_t *a = conv->a;
+    ndarray_obj_t *c = conv->c;
+    int32_t len_a = a->len;
+    int32_t len_c = c->len;
+    int32_t shift = conv->shift + first;
     int32_t off = len_c - 1;
-    uint8_t dtype = NDARRAY_FLOAT;
+    int32_t as = a->strides[ULAB_MAX_DIMS - 1] / a->itemsize;
+    int32_t cs = c->strides[ULAB_MAX_DIMS - 1] / c->itemsize;
+    int16_t *array = (int16_t *)conv->results->array + first;
 
-    #if ULAB_SUPPORTS_COMPLEX
-    if((a->dtype == NDARRAY_COMPLEX) || (c->dtype == NDARRAY_COMPLEX)) {
-        dtype = NDARRAY_COMPLEX;
+    for(int32_t k = shift - off; k < shift + count - off; k++) {
+        int64_t accum = 0;
+        int32_t top_n = MIN(len_c, len_a - k);
+        int32_t bot_n = MAX(-k, 0);
+        int16_t *_a = (int16_t *)a->array + (bot_n + k) * as;
+        int16_t *_c = (int16_t *)c->array + (len_c - bot_n - 1) * cs;
+        for(int32_t n = bot_n; n < top_n; n++) {
+            accum += (int32_t)(*_a) * (int32_t)(*_c);
+            _a += as;
+            _c -= cs;
+        }
+        accum = (accum + (1 << 14)) >> 15;
+        *array++ = TOOLS_Q15_SATURATE(accum);
     }
-    #endif
-    ndarray_obj_t *ndarray = ndarray_new_linear_array(len, dtype);
-    mp_float_t *array = (mp_float_t *)ndarray->array;
+}
+#endif
+
+static void filter_convolve_direct(filter_convolve_t *conv, int32_t first, int32_t count) {
+    // calculates the samples first...first + count - 1 of the results by the direct sum
+    ndarray_obj_t *a = conv->a;
+    ndarray_obj_t *c = conv->c;
+    int32_t len_a = a->len;
+    int32_t len_c = c->len;
+    int32_t shift = conv->shift + first;
+    int32_t len = count;
+    int32_t off = len_c - 1;
 
     uint8_t *aarray = (uint8_t *)a->array;
     uint8_t *carray = (uint8_t *)c->array;
@@ -71,12 +226,12 @@ mp_obj_t filter_convolve(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_a
     int32_t as = a->strides[ULAB_MAX_DIMS - 1] / a->itemsize;
     int32_t cs = c->strides[ULAB_MAX_DIMS - 1] / c->itemsize;
 
-
     #if ULAB_SUPPORTS_COMPLEX
-    if(dtype == NDARRAY_COMPLEX) {
+    if(conv->results->dtype == NDARRAY_COMPLEX) {
+        mp_float_t *array = (mp_float_t *)conv->results->array + 2 * first;
         mp_float_t a_real, a_imag;
         mp_float_t c_real, c_imag = MICROPY_FLOAT_CONST(0.0);
-        for(int32_t k = -off; k < len-off; k++) {
+        for(int32_t k = shift - off; k < shift + len - off; k++) {
             mp_float_t accum_real = MICROPY_FLOAT_CONST(0.0);
             mp_float_t accum_imag = MICROPY_FLOAT_CONST(0.0);
 
@@ -107,26 +262,229 @@ mp_obj_t filter_convolve(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_a
             *array++ = accum_real;
             *array++ = accum_imag;
         }
-        return MP_OBJ_FROM_PTR(ndarray);
+        return;
     }
     #endif
 
-    for(int32_t k = -off; k < len-off; k++) {
-        mp_float_t accum = MICROPY_FLOAT_CONST(0.0);
-        int32_t top_n = MIN(len_c, len_a - k);
-        int32_t bot_n = MAX(-k, 0);
-        for(int32_t n = bot_n; n < top_n; n++) {
-            int32_t idx_c = (len_c - n - 1) * cs;
-            int32_t idx_a = (n + k) * as;
-            mp_float_t ai = ndarray_get_float_index(aarray, a->dtype, idx_a);
-            mp_float_t ci = ndarray_get_float_index(carray, c->dtype, idx_c);
-            accum += ai * ci;
+    mp_float_t *array = (mp_float_t *)conv->results->array + first;
+    // the real kernel is specialised for each pair of dtypes, so that the inner loop
+    // walks typed pointers, instead of dispatching on the dtype for each sample
+    if(a->dtype == NDARRAY_UINT8) {
+        FILTER_CONVOLVE_DISPATCH(uint8_t);
+    } else if(ULAB_DTYPE_IS(a->dtype, INT8)) {
+        FILTER_CONVOLVE_DISPATCH(int8_t);
+    } else if(a->dtype == NDARRAY_UINT16) {
+        FILTER_CONVOLVE_DISPATCH(uint16_t);
+    } else if(ULAB_DTYPE_IS(a->dtype, INT16)) {
+        FILTER_CONVOLVE_DISPATCH(int16_t);
+    } else {
+        FILTER_CONVOLVE_DISPATCH(mp_float_t);
+    }
+}
+
+static const mp_arg_t filter_convolve_allowed_args[] = {
+    { MP_QSTR_a, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+    { MP_QSTR_v, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+    { MP_QSTR_mode, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_QSTR(MP_QSTR_full) } },
+    { MP_QSTR_method, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_QSTR(MP_QSTR_auto) } },
+    #if ULAB_SUPPORTS_Q15
+    { MP_QSTR_dtype, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = NDARRAY_FLOAT } },
+    #endif
+};
+
+static void filter_convolve_parse(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args, filter_convolve_t *conv) {
+    // parses the arguments of convolve, and aconvolve, and allocates the results
+    mp_arg_val_t args[MP_ARRAY_SIZE(filter_convolve_allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(filter_convolve_allowed_args), filter_convolve_allowed_args, args);
+
+    if(!mp_obj_is_type(args[0].u_obj, &ulab_ndarray_type) || !mp_obj_is_type(args[1].u_obj, &ulab_ndarray_type)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("convolve arguments must be ndarrays"));
+    }
+
+    ndarray_obj_t *a = MP_OBJ_TO_PTR(args[0].u_obj);
+    ndarray_obj_t *c = MP_OBJ_TO_PTR(args[1].u_obj);
+    // deal with linear arrays only
+    #if ULAB_MAX_DIMS > 1
+    if((a->ndim != 1) || (c->ndim != 1)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("convolve arguments must be linear arrays"));
+    }
+    #endif
+    size_t len_a = a->len;
+    size_t len_c = c->len;
+    if(len_a == 0 || len_c == 0) {
+        mp_raise_TypeError(MP_ERROR_TEXT("convolve arguments must not be empty"));
+    }
+
+    if(!mp_obj_is_str(args[3].u_obj)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("method must be a string"));
+    }
+    GET_STR_DATA_LEN(args[3].u_obj, method, mlen);
+    conv->method = FILTER_CONVOLVE_DIRECT;
+    if((mlen == 3) && (memcmp(method, "fft", 3) == 0)) {
+        conv->method = FILTER_CONVOLVE_FFT;
+    } else if((mlen == 4) && (memcmp(method, "auto", 4) == 0)) {
+        // the direct method costs len_a * len_c multiplications, the FFT pays off only for long inputs
+        if((len_a * len_c > ULAB_NUMPY_CONVOLVE_FFT_THRESHOLD) && (MIN(len_a, len_c) >= FILTER_CONVOLVE_FFT_MIN_LENGTH)) {
+            conv->method = FILTER_CONVOLVE_FFT;
+        }
+    } else if((mlen != 6) || (memcmp(method, "direct", 6) != 0)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("method must be 'auto', 'direct', or 'fft'"));
+    }
+
+    if(!mp_obj_is_str(args[2].u_obj)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("mode must be a string"));
+    }
+    GET_STR_DATA_LEN(args[2].u_obj, mode, modelen);
+    // len is the length of the output, and shift is the index of its first sample in the full convolution
+    int32_t len = len_a + len_c - 1;
+    conv->shift = 0;
+    if((modelen == 4) && (memcmp(mode, "same", 4) == 0)) {
+        len = MAX(len_a, len_c);
+        conv->shift = (MIN(len_a, len_c) - 1) / 2;
+    } else if((modelen == 5) && (memcmp(mode, "valid", 5) == 0)) {
+        len = MAX(len_a, len_c) - MIN(len_a, len_c) + 1;
+        conv->shift = MIN(len_a, len_c) - 1;
+    } else if((modelen != 4) || (memcmp(mode, "full", 4) != 0)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("mode must be 'full', 'same', or 'valid'"));
+    }
+
+    uint8_t dtype = NDARRAY_FLOAT;
+    #if ULAB_SUPPORTS_Q15
+    if(args[4].u_int == NDARRAY_INT16) {
+        // the fixed-point convolution is always direct, and stays integer end to end
+        if((a->dtype != NDARRAY_INT16) || (c->dtype != NDARRAY_INT16)) {
+            mp_raise_TypeError(MP_ERROR_TEXT("fixed-point convolution requires int16 arrays"));
         }
-        *array++ = accum;
+        conv->method = FILTER_CONVOLVE_Q15;
+        dtype = NDARRAY_INT16;
+    } else if(args[4].u_int != NDARRAY_FLOAT) {
+        mp_raise_ValueError(MP_ERROR_TEXT("dtype must be float, or int16"));
+    }
+    #endif
+
+    #if ULAB_HAS_GENERIC_DTYPES
+    // the direct kernels are typed, the 32-bit integers, and float16 are converted to float first
+    if(ULAB_DTYPE_IS_GENERIC(a->dtype)) {
+        a = ndarray_copy_view_convert_type(a, NDARRAY_FLOAT);
     }
+    if(ULAB_DTYPE_IS_GENERIC(c->dtype)) {
+        c = ndarray_copy_view_convert_type(c, NDARRAY_FLOAT);
+    }
+    #endif
+
+    #if ULAB_SUPPORTS_COMPLEX
+    if((a->dtype == NDARRAY_COMPLEX) || (c->dtype == NDARRAY_COMPLEX)) {
+        dtype = NDARRAY_COMPLEX;
+    }
+    #endif
+    conv->results = ndarray_new_linear_array(len, dtype);
+
+    // convolution is commutative, the FFT method takes the shorter array as the kernel
+    if((conv->method == FILTER_CONVOLVE_FFT) && (len_c > len_a)) {
+        SWAP(ndarray_obj_t *, a, c);
+    }
+    conv->a = a;
+    conv->c = c;
+}
+
+mp_obj_t filter_convolve(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    filter_convolve_t conv;
+    filter_convolve_parse(n_args, pos_args, kw_args, &conv);
+    ndarray_obj_t *a = conv.a;
+    ndarray_obj_t *c = conv.c;
+    ndarray_obj_t *ndarray = conv.results;
+    int32_t len = ndarray->len;
+
+    if(conv.method == FILTER_CONVOLVE_FFT) {
+        filter_fft_t fft;
+        filter_fft_init(&conv, &fft, true);
+        for(size_t start = 0; start < a->len; start += fft.block) {
+            filter_fft_block(&conv, &fft, start);
+        }
+        filter_fft_free(&fft);
+        return MP_OBJ_FROM_PTR(ndarray);
+    }
+
+    if((ndarray->dtype == NDARRAY_FLOAT) && (a->dtype == NDARRAY_FLOAT) && (c->dtype == NDARRAY_FLOAT) &&
+        (a->strides[ULAB_MAX_DIMS - 1] == sizeof(mp_float_t)) && (c->strides[ULAB_MAX_DIMS - 1] == sizeof(mp_float_t)) &&
+        (conv.shift == 0) && (len == (int32_t)(a->len + c->len - 1))) {
+        // the full convolution of dense float arrays can be delegated to the DSP library
+        if(ulab_dsp_convolve((mp_float_t *)a->array, a->len, (mp_float_t *)c->array, c->len, (mp_float_t *)ndarray->array)) {
+            return MP_OBJ_FROM_PTR(ndarray);
+        }
+    }
+
+    // the output has been allocated, and the direct convolution does not touch python objects
+    bool released = ulab_gil_exit((size_t)len * c->len);
+    #if ULAB_SUPPORTS_Q15
+    if(conv.method == FILTER_CONVOLVE_Q15) {
+        filter_convolve_q15(&conv, 0, len);
+    } else {
+        filter_convolve_direct(&conv, 0, len);
+    }
+    #else
+    filter_convolve_direct(&conv, 0, len);
+    #endif
+    ulab_gil_enter(released);
     return MP_OBJ_FROM_PTR(ndarray);
 }
 
 MP_DEFINE_CONST_FUN_OBJ_KW(filter_convolve_obj, 2, filter_convolve);
 
+#if ULAB_NUMPY_HAS_ACONVOLVE
+typedef struct _filter_convolve_job_obj_t {
+    ulab_job_obj_t job;
+    filter_convolve_t conv;
+    filter_fft_t fft;
+    // the next sample of the results with the direct method, and of a with the FFT method
+    size_t position;
+} filter_convolve_job_obj_t;
+
+static bool filter_convolve_job_slice(ulab_job_obj_t *job) {
+    filter_convolve_job_obj_t *self = (filter_convolve_job_obj_t *)job;
+    filter_convolve_t *conv = &self->conv;
+
+    if(conv->method == FILTER_CONVOLVE_FFT) {
+        // a slice is a single block of the overlap-add convolution
+        filter_fft_block(conv, &self->fft, self->position);
+        self->position += self->fft.block;
+        if(self->position < conv->a->len) {
+            return false;
+        }
+        filter_fft_free(&self->fft);
+        return true;
+    }
+
+    size_t len = conv->results->len;
+    size_t count = MAX(1, ULAB_NUMPY_ACONVOLVE_SLICE / conv->c->len);
+    count = MIN(count, len - self->position);
+    #if ULAB_SUPPORTS_Q15
+    if(conv->method == FILTER_CONVOLVE_Q15) {
+        filter_convolve_q15(conv, self->position, count);
+    } else {
+        filter_convolve_direct(conv, self->position, count);
+    }
+    #else
+    filter_convolve_direct(conv, self->position, count);
+    #endif
+    self->position += count;
+    return self->position == len;
+}
+
+mp_obj_t filter_aconvolve(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    filter_convolve_job_obj_t *self = ulab_new_job(filter_convolve_job_obj_t, filter_convolve_job_slice);
+    filter_convolve_parse(n_args, pos_args, kw_args, &self->conv);
+    self->job.result = MP_OBJ_FROM_PTR(self->conv.results);
+    self->position = 0;
+    if(self->conv.method == FILTER_CONVOLVE_FFT) {
+        // the spectrum of the kernel is calculated up front, the signal is transformed block by block;
+        // since the job might never be completed, its buffers are on the heap, as in fft.afft
+        filter_fft_init(&self->conv, &self->fft, false);
+    }
+    return MP_OBJ_FROM_PTR(self);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(filter_aconvolve_obj, 2, filter_aconvolve);
+#endif /* ULAB_NUMPY_HAS_ACONVOLVE */
+
 #endif
@@ -16,5 +16,44 @@
 #include "../ulab.h"
 #include "../ndarray.h"
 
+// with method='auto', the FFT is not used, if either of the inputs is shorter than this
+#define FILTER_CONVOLVE_FFT_MIN_LENGTH      (32)
+
+// the direct convolution of a typed array a with a typed kernel c, evaluated
+// for the samples k = shift - off, ..., shift + len - off - 1 of the output
+#define FILTER_CONVOLVE_LOOP(type_a, type_c) do {\
+    for(int32_t k = shift - off; k < shift + len - off; k++) {\
+        mp_float_t accum = MICROPY_FLOAT_CONST(0.0);\
+        int32_t top_n = MIN((int32_t)len_c, (int32_t)len_a - k);\
+        int32_t bot_n = MAX(-k, 0);\
+        type_a *_a = (type_a *)aarray + (bot_n + k) * as;\
+        type_c *_c = (type_c *)carray + ((int32_t)len_c - bot_n - 1) * cs;\
+        for(int32_t n = bot_n; n < top_n; n++) {\
+            accum += (mp_float_t)(*_a) * (mp_float_t)(*_c);\
+            _a += as;\
+            _c -= cs;\
+        }\
+        *array++ = accum;\
+    }\
+} while(0)
+
+#define FILTER_CONVOLVE_DISPATCH(type_a) do {\
+    if(c->dtype == NDARRAY_UINT8) {\
+        FILTER_CONVOLVE_LOOP(type_a, uint8_t);\
+    } else if(ULAB_DTYPE_IS(c->dtype, INT8)) {\
+        FILTER_CONVOLVE_LOOP(type_a, int8_t);\
+    } else if(c->dtype == NDARRAY_UINT16) {\
+        FILTER_CONVOLVE_LOOP(type_a, uint16_t);\
+    } else if(ULAB_DTYPE_IS(c->dtype, INT16)) {\
+        FILTER_CONVOLVE_LOOP(type_a, int16_t);\
+    } else {\
+        FILTER_CONVOLVE_LOOP(type_a, mp_float_t);\
+    }\
+} while(0)
+
 MP_DECLARE_CONST_FUN_OBJ_KW(filter_convolve_obj);
+
+#if ULAB_NUMPY_HAS_ACONVOLVE
+MP_DECLARE_CONST_FUN_OBJ_KW(filter_aconvolve_obj);
+#endif
 #endif
@@ -25,13 +25,70 @@
 
 #define ULAB_IO_BUFFER_SIZE         128
 #define ULAB_IO_CLIPBOARD_SIZE      32
-#define ULAB_IO_MAX_ROWS            65535
 
 #define ULAB_IO_NULL_ENDIAN         0
 #define ULAB_IO_LITTLE_ENDIAN       1
 #define ULAB_IO_BIG_ENDIAN          2
 
-#if ULAB_NUMPY_HAS_LOAD
+// each frame of the packed format starts with the magic string, the version, the dtype,
+// the number of dimensions, and the width of the packed deltas in bits, followed by
+// the shape, and the first value as little endian 32-bit integers
+#define ULAB_IO_PACKED_MAGIC        "ULPK"
+#define ULAB_IO_PACKED_VERSION      1
+// the zigzag-encoded difference of two 16-bit integers fits into 17 bits
+#define ULAB_IO_PACKED_MAX_BITS     17
+
+#if ULAB_NUMPY_HAS_LOAD_PACKED || ULAB_NUMPY_HAS_SAVE_PACKED
+static bool io_packed_supports_dtype(uint8_t dtype) {
+    return (dtype == NDARRAY_UINT8) || ULAB_DTYPE_IS(dtype, INT8) || (dtype == NDARRAY_UINT16) || ULAB_DTYPE_IS(dtype, INT16);
+}
+
+static int32_t io_packed_get_value(uint8_t *array, uint8_t dtype, size_t i) {
+    if(dtype == NDARRAY_UINT8) {
+        return ((uint8_t *)array)[i];
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {
+        return ((int8_t *)array)[i];
+    } else if(dtype == NDARRAY_UINT16) {
+        return ((uint16_t *)array)[i];
+    } else {
+        return ((int16_t *)array)[i];
+    }
+}
+
+static void io_packed_set_value(uint8_t *array, uint8_t dtype, size_t i, int32_t value) {
+    if(dtype == NDARRAY_UINT8) {
+        ((uint8_t *)array)[i] = (uint8_t)value;
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {
+        ((int8_t *)array)[i] = (int8_t)value;
+    } else if(dtype == NDARRAY_UINT16) {
+        ((uint16_t *)array)[i] = (uint16_t)value;
+    } else {
+        ((int16_t *)array)[i] = (int16_t)value;
+    }
+}
+
+static void io_packed_put_uint32(char *buffer, uint32_t value) {
+    for(uint8_t i = 0; i < 4; i++) {
+        buffer[i] = (char)(value & 0xff);
+        value >>= 8;
+    }
+}
+
+static uint32_t io_packed_get_uint32(const char *buffer) {
+    uint32_t value = 0;
+    for(uint8_t i = 4; i > 0; i--) {
+        value = (value << 8) | (uint8_t)buffer[i - 1];
+    }
+    return value;
+}
+
+static size_t io_packed_payload_size(size_t len, uint8_t bits) {
+    // the first value is stored in the header, the rest as bit-packed deltas
+    return len > 1 ? ((len - 1) * bits + 7) / 8 : 0;
+}
+#endif /* ULAB_NUMPY_HAS_LOAD_PACKED || ULAB_NUMPY_HAS_SAVE_PACKED */
+
+#if ULAB_NUMPY_HAS_LOAD || ULAB_NUMPY_HAS_LOAD_PACKED
 static void io_read_(mp_obj_t stream, const mp_stream_p_t *stream_p, char *buffer, const char *string, uint16_t len, int *error) {
     size_t read = stream_p->read(stream, buffer, len, error);
     bool fail = false;
@@ -50,10 +107,67 @@ static void io_read_(mp_obj_t stream, const mp_stream_p_t *stream_p, char *buffe
     }
 }
 
-static mp_obj_t io_load(mp_obj_t file) {
+static void io_skip_(mp_obj_t stream, const mp_stream_p_t *stream_p, char *buffer, size_t len, int *error) {
+    // moves the file pointer by len bytes; the bytes are read and discarded,
+    // if the stream cannot seek
+    if(len == 0) {
+        return;
+    }
+    struct mp_stream_seek_t seek_s;
+    seek_s.offset = len;
+    seek_s.whence = MP_SEEK_CUR;
+    if(stream_p->ioctl(stream, MP_STREAM_SEEK, (mp_uint_t)(uintptr_t)&seek_s, error) != MP_STREAM_ERROR) {
+        return;
+    }
+    while(len > 0) {
+        uint16_t bytes_to_read = MIN(ULAB_IO_BUFFER_SIZE, len);
+        io_read_(stream, stream_p, buffer, NULL, bytes_to_read, error);
+        len -= bytes_to_read;
+    }
+}
+
+#endif /* ULAB_NUMPY_HAS_LOAD || ULAB_NUMPY_HAS_LOAD_PACKED */
+
+#if ULAB_NUMPY_HAS_LOAD
+static void io_byteswap_(uint8_t *array, size_t n, uint8_t sz) {
+    // reverses the byte order of n items of size sz
+    if(sz == 2) {
+        for(size_t i = 0; i < n; i++) {
+            uint8_t tmp = array[0];
+            array[0] = array[1];
+            array[1] = tmp;
+            array += 2;
+        }
+    } else {
+        for(size_t i = 0; i < n; i++) {
+            for(uint8_t j = 0; j < sz / 2; j++) {
+                uint8_t tmp = array[j];
+                array[j] = array[sz - 1 - j];
+                array[sz - 1 - j] = tmp;
+            }
+            array += sz;
+        }
+    }
+}
+
+static mp_obj_t io_load(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_offset, MP_ARG_KW_ONLY | MP_ARG_INT, { .u_int = 0 } },
+        { MP_QSTR_count, MP_ARG_KW_ONLY | MP_ARG_INT, { .u_int = -1 } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t file = args[0].u_obj;
     if(!mp_obj_is_str(file)) {
         mp_raise_TypeError(MP_ERROR_TEXT("wrong input type"));
     }
+    if(args[1].u_int < 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("offset must be non-negative"));
+    }
+    size_t row_offset = (size_t)args[1].u_int;
 
     int error;
     char *buffer = m_new(char, ULAB_IO_BUFFER_SIZE);
@@ -104,6 +218,18 @@ static mp_obj_t io_load(mp_obj_t file) {
     } else if(memcmp(buffer, "i2", 2) == 0) {
         dtype = NDARRAY_INT16;
     }
+    #if ULAB_SUPPORTS_INT32
+    else if(memcmp(buffer, "u4", 2) == 0) {
+        dtype = NDARRAY_UINT32;
+    } else if(memcmp(buffer, "i4", 2) == 0) {
+        dtype = NDARRAY_INT32;
+    }
+    #endif
+    #if ULAB_SUPPORTS_FLOAT16
+    else if(memcmp(buffer, "f2", 2) == 0) {
+        dtype = NDARRAY_FLOAT16;
+    }
+    #endif
     #if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT
     else if(memcmp(buffer, "f4", 2) == 0) {
         dtype = NDARRAY_FLOAT;
@@ -182,10 +308,36 @@ static mp_obj_t io_load(mp_obj_t file) {
         io_read_(stream, stream_p, buffer, NULL, header_length - (bytes_to_read + 51), &error);
     }
 
-    ndarray_obj_t *ndarray = ndarray_new_dense_ndarray(ndim, shape, dtype);
+    // offset, and count select a range of rows along the leading axis, so that
+    // files larger than the available RAM can be processed in chunks
+    size_t rows = shape[ULAB_MAX_DIMS - ndim];
+    if(row_offset > rows) {
+        stream_p->ioctl(stream, MP_STREAM_CLOSE, 0, &error);
+        mp_raise_ValueError(MP_ERROR_TEXT("offset is out of range"));
+    }
+    size_t count = rows - row_offset;
+    if((args[2].u_int >= 0) && ((size_t)args[2].u_int < count)) {
+        count = (size_t)args[2].u_int;
+    }
+
+    ndarray_obj_t *ndarray;
+    if(count == rows) {
+        ndarray = ndarray_new_dense_ndarray(ndim, shape, dtype);
+    } else {
+        uint8_t itemsize = ulab_binary_get_size(dtype);
+        size_t row_size = itemsize;
+        for(uint8_t i = 1; i < ndim; i++) {
+            row_size *= shape[ULAB_MAX_DIMS - i];
+        }
+        io_skip_(stream, stream_p, buffer, row_offset * row_size, &error);
+        shape[ULAB_MAX_DIMS - ndim] = count;
+        ndarray = ndarray_new_dense_ndarray(ndim, shape, dtype);
+    }
     char *array = (char *)ndarray->array;
 
-    size_t read = stream_p->read(stream, array, ndarray->len * ndarray->itemsize, &error);
+    // the payload is read directly into the array; mp_stream_rw takes care of
+    // streams that return less than the requested number of bytes in one call
+    size_t read = mp_stream_read_exactly(stream, array, ndarray->len * ndarray->itemsize, &error);
     if(read != ndarray->len * ndarray->itemsize) {
         stream_p->ioctl(stream, MP_STREAM_CLOSE, 0, &error);
         mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("corrupted file"));
@@ -194,39 +346,18 @@ static mp_obj_t io_load(mp_obj_t file) {
     stream_p->ioctl(stream, MP_STREAM_CLOSE, 0, &error);
     m_del(char, buffer, ULAB_IO_BUFFER_SIZE);
 
-    // swap the bytes, if necessary
+    // swap the bytes in place, if necessary
     if((native_endianness != endianness) && (dtype != NDARRAY_UINT8) && (dtype != NDARRAY_INT8)) {
         uint8_t sz = ndarray->itemsize;
-        char *tmpbuff = NULL;
-
+        size_t n = ndarray->len;
         #if ULAB_SUPPORTS_COMPLEX
         if(dtype == NDARRAY_COMPLEX) {
             // work with the floating point real and imaginary parts
             sz /= 2;
-            tmpbuff = m_new(char, sz);
-            for(size_t i = 0; i < ndarray->len; i++) {
-                for(uint8_t k = 0; k < 2; k++) {
-                    tmpbuff += sz;
-                    for(uint8_t j = 0; j < sz; j++) {
-                        memcpy(--tmpbuff, array++, 1);
-                    }
-                    memcpy(array-sz, tmpbuff, sz);
-                }
-            }
-        } else {
-        #endif
-            tmpbuff = m_new(char, sz);
-            for(size_t i = 0; i < ndarray->len; i++) {
-                tmpbuff += sz;
-                for(uint8_t j = 0; j < sz; j++) {
-                    memcpy(--tmpbuff, array++, 1);
-                }
-                memcpy(array-sz, tmpbuff, sz);
-            }
-        #if ULAB_SUPPORTS_COMPLEX
+            n *= 2;
         }
         #endif
-        m_del(char, tmpbuff, sz);
+        io_byteswap_((uint8_t *)array, n, sz);
     }
 
     m_del(size_t, shape, ULAB_MAX_DIMS);
@@ -234,17 +365,253 @@ static mp_obj_t io_load(mp_obj_t file) {
     return MP_OBJ_FROM_PTR(ndarray);
 }
 
-MP_DEFINE_CONST_FUN_OBJ_1(io_load_obj, io_load);
+MP_DEFINE_CONST_FUN_OBJ_KW(io_load_obj, 1, io_load);
 #endif /* ULAB_NUMPY_HAS_LOAD */
 
+#if ULAB_NUMPY_HAS_LOAD_PACKED
+static uint8_t io_load_packed_header(mp_obj_t stream, const mp_stream_p_t *stream_p, char *buffer, uint8_t *ndim, size_t *shape, int32_t *first, uint8_t *bits, int *error) {
+    // reads the header of the next frame, and returns its dtype, or 0 at the end of the file
+    size_t read = stream_p->read(stream, buffer, 8, error);
+    if(read == 0) {
+        return 0;
+    }
+    if((read != 8) || (memcmp(buffer, ULAB_IO_PACKED_MAGIC, 4) != 0) || (buffer[4] != ULAB_IO_PACKED_VERSION)) {
+        stream_p->ioctl(stream, MP_STREAM_CLOSE, 0, error);
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("corrupted file"));
+    }
+    uint8_t dtype = buffer[5];
+    *ndim = buffer[6];
+    *bits = buffer[7];
+    if(!io_packed_supports_dtype(dtype) || (*ndim == 0) || (*ndim > ULAB_MAX_DIMS) || (*bits > ULAB_IO_PACKED_MAX_BITS)) {
+        stream_p->ioctl(stream, MP_STREAM_CLOSE, 0, error);
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("corrupted file"));
+    }
+    io_read_(stream, stream_p, buffer, NULL, 4 * *ndim + 4, error);
+    memset(shape, 0, ULAB_MAX_DIMS * sizeof(size_t));
+    for(uint8_t i = 0; i < *ndim; i++) {
+        shape[ULAB_MAX_DIMS - *ndim + i] = io_packed_get_uint32(buffer + 4 * i);
+    }
+    *first = (int32_t)io_packed_get_uint32(buffer + 4 * *ndim);
+    return dtype;
+}
+
+static mp_obj_t io_load_packed(mp_obj_t file) {
+    if(!mp_obj_is_str(file)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("wrong input type"));
+    }
+
+    int error;
+    char *buffer = m_new(char, ULAB_IO_BUFFER_SIZE);
+
+    mp_obj_t open_args[2] = {
+        file,
+        MP_OBJ_NEW_QSTR(MP_QSTR_rb)
+    };
+
+    mp_obj_t stream = mp_builtin_open_obj.fun.kw(2, open_args, (mp_map_t *)&mp_const_empty_map);
+    const mp_stream_p_t *stream_p = mp_get_stream(stream);
+
+    size_t shape[ULAB_MAX_DIMS];
+    size_t frame_shape[ULAB_MAX_DIMS];
+    uint8_t ndim = 0, frame_ndim, dtype = 0, bits;
+    int32_t first;
+
+    // first pass: collect the frame headers, and check that the frames can be stacked
+    // along the leading axis
+    uint8_t frame_dtype;
+    while((frame_dtype = io_load_packed_header(stream, stream_p, buffer, &frame_ndim, frame_shape, &first, &bits, &error)) != 0) {
+        if(dtype == 0) {
+            dtype = frame_dtype;
+            ndim = frame_ndim;
+            memcpy(shape, frame_shape, ULAB_MAX_DIMS * sizeof(size_t));
+        } else {
+            bool compatible = (dtype == frame_dtype) && (ndim == frame_ndim);
+            for(uint8_t i = ULAB_MAX_DIMS - ndim + 1; compatible && (i < ULAB_MAX_DIMS); i++) {
+                compatible = shape[i] == frame_shape[i];
+            }
+            if(!compatible) {
+                stream_p->ioctl(stream, MP_STREAM_CLOSE, 0, &error);
+                mp_raise_ValueError(MP_ERROR_TEXT("incompatible frames"));
+            }
+            shape[ULAB_MAX_DIMS - ndim] += frame_shape[ULAB_MAX_DIMS - ndim];
+        }
+        size_t len = 1;
+        for(uint8_t i = ULAB_MAX_DIMS - frame_ndim; i < ULAB_MAX_DIMS; i++) {
+            len *= frame_shape[i];
+        }
+        io_skip_(stream, stream_p, buffer, io_packed_payload_size(len, bits), &error);
+    }
+
+    if(dtype == 0) {
+        stream_p->ioctl(stream, MP_STREAM_CLOSE, 0, &error);
+        mp_raise_ValueError(MP_ERROR_TEXT("empty file"));
+    }
+
+    ndarray_obj_t *ndarray = ndarray_new_dense_ndarray(ndim, shape, dtype);
+    uint8_t *array = (uint8_t *)ndarray->array;
+
+    struct mp_stream_seek_t seek_s;
+    seek_s.offset = 0;
+    seek_s.whence = MP_SEEK_SET;
+    stream_p->ioctl(stream, MP_STREAM_SEEK, (mp_uint_t)(uintptr_t)&seek_s, &error);
+
+    // second pass: decode the frames into the array
+    size_t idx = 0;
+    while(io_load_packed_header(stream, stream_p, buffer, &frame_ndim, frame_shape, &first, &bits, &error) != 0) {
+        size_t len = 1;
+        for(uint8_t i = ULAB_MAX_DIMS - ndim; i < ULAB_MAX_DIMS; i++) {
+            len *= frame_shape[i];
+        }
+        if(len == 0) {
+            continue;
+        }
+
+        size_t remaining = io_packed_payload_size(len, bits);
+        size_t available = 0;
+        char *pointer = buffer;
+        uint32_t mask = (1UL << bits) - 1;
+        uint32_t accumulator = 0;
+        uint8_t accumulated = 0;
+        int32_t value = first;
+
+        io_packed_set_value(array, dtype, idx++, value);
+        for(size_t i = 1; i < len; i++) {
+            while(accumulated < bits) {
+                if(available == 0) {
+                    available = MIN(ULAB_IO_BUFFER_SIZE, remaining);
+                    io_read_(stream, stream_p, buffer, NULL, available, &error);
+                    remaining -= available;
+                    pointer = buffer;
+                }
+                accumulator |= (uint32_t)(uint8_t)*pointer++ << accumulated;
+                accumulated += 8;
+                available--;
+            }
+            uint32_t zigzag = accumulator & mask;
+            accumulator >>= bits;
+            accumulated -= bits;
+            value += (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1);
+            io_packed_set_value(array, dtype, idx++, value);
+        }
+    }
+
+    stream_p->ioctl(stream, MP_STREAM_CLOSE, 0, &error);
+    m_del(char, buffer, ULAB_IO_BUFFER_SIZE);
+
+    return MP_OBJ_FROM_PTR(ndarray);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(io_load_packed_obj, io_load_packed);
+#endif /* ULAB_NUMPY_HAS_LOAD_PACKED */
+
 #if ULAB_NUMPY_HAS_LOADTXT
-static void io_assign_value(const char *clipboard, uint8_t len, ndarray_obj_t *ndarray, size_t *idx, uint8_t dtype) {
-    mp_obj_t value = mp_parse_num_decimal(clipboard, len, false, false, NULL);
-    if(dtype != NDARRAY_FLOAT) {
-        mp_float_t _value = mp_obj_get_float(value);
-        value = mp_obj_new_int((int32_t)MICROPY_FLOAT_C_FUN(round)(_value));
+static mp_float_t io_parse_float(const char *string, size_t len) {
+    // fast path for plain decimal numbers with an optional exponent; everything else,
+    // e.g., inf, or nan, is passed on to the generic number parser
+    const char *c = string;
+    const char *end = string + len;
+    bool negative = false;
+    if((*c == '-') || (*c == '+')) {
+        negative = *c == '-';
+        c++;
+    }
+
+    uint64_t mantissa = 0;
+    int16_t exponent = 0;
+    uint8_t digits = 0;
+    bool valid = false;
+
+    while((c < end) && (*c >= '0') && (*c <= '9')) {
+        if(digits < 19) {
+            mantissa = mantissa * 10 + (*c - '0');
+            digits += mantissa > 0 ? 1 : 0;
+        } else {
+            exponent++;
+        }
+        valid = true;
+        c++;
+    }
+    if((c < end) && (*c == '.')) {
+        c++;
+        while((c < end) && (*c >= '0') && (*c <= '9')) {
+            if(digits < 19) {
+                mantissa = mantissa * 10 + (*c - '0');
+                digits += mantissa > 0 ? 1 : 0;
+                exponent--;
+            }
+            valid = true;
+            c++;
+        }
+    }
+    if(valid && (c < end) && ((*c == 'e') || (*c == 'E'))) {
+        c++;
+        bool negative_exponent = false;
+        if((c < end) && ((*c == '-') || (*c == '+'))) {
+            negative_exponent = *c == '-';
+            c++;
+        }
+        int16_t e = 0;
+        valid = false;
+        while((c < end) && (*c >= '0') && (*c <= '9')) {
+            if(e < 1000) {
+                e = e * 10 + (*c - '0');
+            }
+            valid = true;
+            c++;
+        }
+        exponent += negative_exponent ? -e : e;
+    }
+
+    if(!valid || (c != end)) {
+        return mp_obj_get_float(mp_parse_num_decimal(string, len, false, false, NULL));
+    }
+
+    mp_float_t value = (mp_float_t)mantissa;
+    // dividing by an exact power of ten is more accurate than multiplying by its inverse
+    if(exponent > 0) {
+        value *= MICROPY_FLOAT_C_FUN(pow)(MICROPY_FLOAT_CONST(10.0), exponent);
+    } else if(exponent < 0) {
+        value /= MICROPY_FLOAT_C_FUN(pow)(MICROPY_FLOAT_CONST(10.0), -exponent);
+    }
+    return negative ? -value : value;
+}
+
+static void io_store_value(uint8_t *data, size_t idx, uint8_t dtype, mp_float_t value) {
+    if(dtype == NDARRAY_FLOAT) {
+        ((mp_float_t *)data)[idx] = value;
+        return;
+    }
+    #if ULAB_SUPPORTS_COMPLEX
+    if(dtype == NDARRAY_COMPLEX) {
+        ((mp_float_t *)data)[2 * idx] = value;
+        return;
+    }
+    #endif
+    #if ULAB_HAS_GENERIC_DTYPES
+    if(ULAB_DTYPE_IS_GENERIC(dtype)) {
+        void (*set)(void *, mp_float_t) = ndarray_set_float_function(dtype);
+        set(data + idx * ulab_binary_get_size(dtype), ULAB_DTYPE_IS_FLOAT(dtype) ? value : MICROPY_FLOAT_C_FUN(round)(value));
+        return;
+    }
+    #endif
+    int32_t x = (int32_t)MICROPY_FLOAT_C_FUN(round)(value);
+    if(dtype == NDARRAY_UINT16) {
+        ((uint16_t *)data)[idx] = (uint16_t)x;
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {
+        ((int16_t *)data)[idx] = (int16_t)x;
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {
+        ((int8_t *)data)[idx] = (int8_t)x;
+    } else if(dtype == NDARRAY_BOOL) {
+        data[idx] = x != 0 ? 1 : 0;
+    } else {
+        data[idx] = (uint8_t)x;
     }
-    ndarray_set_value(dtype, ndarray->array, (*idx)++, value);
+}
+
+static void io_loadtxt_raise(mp_obj_t stream, const mp_stream_p_t *stream_p, mp_rom_error_text_t msg) {
+    int error;
+    stream_p->ioctl(stream, MP_STREAM_CLOSE, 0, &error);
+    mp_raise_ValueError(msg);
 }
 
 static mp_obj_t io_loadtxt(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
@@ -261,41 +628,27 @@ static mp_obj_t io_loadtxt(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
-    mp_obj_t open_args[2] = {
-        args[0].u_obj,
-        MP_OBJ_NEW_QSTR(MP_QSTR_r)
-    };
-
-    mp_obj_t stream = mp_builtin_open_obj.fun.kw(2, open_args, (mp_map_t *)&mp_const_empty_map);
-    const mp_stream_p_t *stream_p = mp_get_stream(stream);
-
-    char *buffer = m_new(char, ULAB_IO_BUFFER_SIZE);
-    int error;
-
     char delimiter = ' ';
     if(args[1].u_obj != mp_const_none) {
         size_t _len;
-        char *_delimiter = m_new(char, 8);
-        _delimiter = (char *)mp_obj_str_get_data(args[1].u_obj, &_len);
-        delimiter = _delimiter[0];
+        delimiter = mp_obj_str_get_data(args[1].u_obj, &_len)[0];
     }
 
     char comment_char = '#';
     if(args[2].u_obj != mp_const_none) {
         size_t _len;
-        char *_comment_char = m_new(char, 8);
-        _comment_char = (char *)mp_obj_str_get_data(args[2].u_obj, &_len);
-        comment_char = _comment_char[0];
+        comment_char = mp_obj_str_get_data(args[2].u_obj, &_len)[0];
     }
 
-    uint16_t skiprows = args[6].u_int;
-    uint16_t max_rows = ULAB_IO_MAX_ROWS;
-    if((args[3].u_int > 0) && (args[3].u_int < ULAB_IO_MAX_ROWS)) {
-        max_rows = args[3].u_int + skiprows;
+    size_t skiprows = args[6].u_int > 0 ? (size_t)args[6].u_int : 0;
+    // as before, max_rows counts all lines, including the comments, after skiprows
+    size_t max_lines = SIZE_MAX;
+    if(args[3].u_int > 0) {
+        max_lines = (size_t)args[3].u_int + skiprows;
     }
 
     uint16_t *cols = NULL;
-    uint8_t used_columns = 0;
+    uint16_t used_columns = 0;
     if(args[4].u_obj != mp_const_none) {
         if(mp_obj_is_int(args[4].u_obj)) {
             used_columns = 1;
@@ -310,180 +663,167 @@ static mp_obj_t io_loadtxt(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw
             cols = m_new(uint16_t, used_columns);
             mp_obj_iter_buf_t iter_buf;
             mp_obj_t item, iterable = mp_getiter(args[4].u_obj, &iter_buf);
+            uint16_t c = 0;
             while((item = mp_iternext(iterable)) != MP_OBJ_STOP_ITERATION) {
-                *cols++ = (uint16_t)mp_obj_get_int(item);
+                cols[c++] = (uint16_t)mp_obj_get_int(item);
             }
-            cols -= used_columns;
             #endif
         }
     }
 
     uint8_t dtype = args[5].u_int;
+    uint8_t itemsize = ulab_binary_get_size(dtype);
+
+    mp_obj_t open_args[2] = {
+        args[0].u_obj,
+        MP_OBJ_NEW_QSTR(MP_QSTR_r)
+    };
+
+    mp_obj_t stream = mp_builtin_open_obj.fun.kw(2, open_args, (mp_map_t *)&mp_const_empty_map);
+    const mp_stream_p_t *stream_p = mp_get_stream(stream);
+    int error;
 
-    // count the columns and rows
-    // we actually count only the rows and the items, and assume that
-    // the number of columns can be gotten by means of a simple division,
-    // i.e., that each row has the same number of columns
-    char *offset;
-    uint16_t rows = 0, items = 0, all_rows = 0;
-    uint8_t read;
-    uint8_t len = 0;
+    char *buffer = m_new(char, ULAB_IO_BUFFER_SIZE);
+    char clipboard[ULAB_IO_CLIPBOARD_SIZE];
+
+    // the file is traversed once only: the values are collected in a buffer that
+    // doubles its size, whenever it is full, and is copied into the array at the end
+    size_t capacity = 64;
+    uint8_t *data = m_new0(uint8_t, capacity * itemsize);
+
+    // the number of columns per row, as determined by the first data row
+    size_t columns = 0;
+    // the number of values stored per row
+    size_t width = used_columns;
+    size_t rows = 0;
+    size_t line = 0;
+    size_t column = 0;
+    // the position of the current field in the row; negative, if the field is not stored
+    int32_t position = -1;
+    // the length of the current field; the fields that are not stored can be of any length
+    size_t len = 0;
+    bool comment = false;
+    bool done = false;
+    size_t read;
 
     do {
-        read = (uint8_t)stream_p->read(stream, buffer, ULAB_IO_BUFFER_SIZE - 1, &error);
-        buffer[read] = '\0';
-        offset = buffer;
-        while(*offset != '\0') {
-            if(*offset == comment_char) {
-                // clear the line till the end, or the buffer's end
-                while((*offset != '\0')) {
-                    offset++;
-                    if(*offset == '\n') {
-                        offset++;
-                        all_rows++;
-                        break;
+        read = stream_p->read(stream, buffer, ULAB_IO_BUFFER_SIZE, &error);
+        // an empty read marks the end of the file; a missing new line is supplied, so that
+        // the last line is closed properly
+        size_t n = read > 0 ? read : 1;
+
+        for(size_t i = 0; (i < n) && !done; i++) {
+            char ch = read > 0 ? buffer[i] : '\n';
+            if(comment && (ch != '\n')) {
+                continue;
+            }
+            bool separator = (ch == ' ') || (ch == '\t') || (ch == '\v') || (ch == '\f') ||
+                            (ch == '\r') || (ch == '\n') || (ch == delimiter) || (ch == comment_char);
+
+            if(!separator) {
+                if(len == 0) {
+                    // a new field begins: find out, whether it has to be parsed at all
+                    position = -1;
+                    if(line >= skiprows) {
+                        if(cols == NULL) {
+                            if((columns == 0) || (column < columns)) {
+                                position = column;
+                            }
+                        } else {
+                            for(uint16_t c = 0; c < used_columns; c++) {
+                                if(cols[c] == column) {
+                                    position = c;
+                                    break;
+                                }
+                            }
+                        }
                     }
                 }
+                if(position >= 0) {
+                    // numbers are parsed from the clipboard, hence, longer fields are rejected
+                    if(len == ULAB_IO_CLIPBOARD_SIZE) {
+                        io_loadtxt_raise(stream, stream_p, MP_ERROR_TEXT("number is too long"));
+                    }
+                    clipboard[len] = ch;
+                }
+                len++;
+                continue;
             }
 
-            // catch whitespaces here: if these are not on a comment line, then they delimit a number
-            if(*offset == '\n') {
-                all_rows++;
-                if(all_rows > skiprows) {
-                    rows++;
-                    items++;
-                    len = 0;
-                }
-                if(all_rows == max_rows) {
-                    break;
+            if(len > 0) {
+                // close the current field
+                if(position >= 0) {
+                    size_t idx = rows * width + position;
+                    if(idx >= capacity) {
+                        size_t new_capacity = 2 * capacity;
+                        while(new_capacity <= idx) {
+                            new_capacity *= 2;
+                        }
+                        data = m_renew(uint8_t, data, capacity * itemsize, new_capacity * itemsize);
+                        memset(data + capacity * itemsize, 0, (new_capacity - capacity) * itemsize);
+                        capacity = new_capacity;
+                    }
+                    io_store_value(data, idx, dtype, io_parse_float(clipboard, len));
                 }
+                column++;
+                len = 0;
             }
 
-            if((*offset == ' ') || (*offset == '\t') || (*offset == '\v') ||
-                (*offset == '\f') || (*offset == '\r') || (*offset == delimiter)) {
-                offset++;
-                while((*offset == ' ') || (*offset == '\t') || (*offset == '\v') || (*offset == '\f') || (*offset == '\r')) {
-                    offset++;
-                }
-                if(len > 0) {
-                    if(all_rows >= skiprows) {
-                        items++;
+            if(ch == comment_char) {
+                comment = true;
+            } else if(ch == '\n') {
+                if((line >= skiprows) && (column > 0)) {
+                    if(columns == 0) {
+                        columns = column;
+                        if(cols == NULL) {
+                            width = columns;
+                        } else {
+                            for(uint16_t c = 0; c < used_columns; c++) {
+                                if(cols[c] >= columns) {
+                                    io_loadtxt_raise(stream, stream_p, MP_ERROR_TEXT("usecols is too high"));
+                                }
+                            }
+                        }
+                    } else if(column != columns) {
+                        io_loadtxt_raise(stream, stream_p, MP_ERROR_TEXT("wrong number of columns"));
                     }
-                    len = 0;
+                    rows++;
+                }
+                line++;
+                column = 0;
+                comment = false;
+                if(line == max_lines) {
+                    done = true;
                 }
-            } else {
-                offset++;
-                len++;
             }
         }
-    } while((read > 0) && (all_rows < max_rows));
+    } while((read > 0) && !done);
+
+    stream_p->ioctl(stream, MP_STREAM_CLOSE, 0, &error);
+    m_del(char, buffer, ULAB_IO_BUFFER_SIZE);
 
     if(rows == 0) {
         mp_raise_ValueError(MP_ERROR_TEXT("empty file"));
     }
-    uint16_t columns = items / rows;
-
-    if(columns < used_columns) {
-        mp_raise_ValueError(MP_ERROR_TEXT("usecols is too high"));
-    }
 
     size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
 
     #if ULAB_MAX_DIMS == 1
+    if(width != 1) {
+        mp_raise_ValueError(MP_ERROR_TEXT("usecols keyword must be specified"));
+    }
     shape[0] = rows;
     ndarray_obj_t *ndarray = ndarray_new_dense_ndarray(1, shape, dtype);
     #else
-    if(args[4].u_obj == mp_const_none) {
-        shape[ULAB_MAX_DIMS - 1] = columns;
-    } else {
-        shape[ULAB_MAX_DIMS - 1] = used_columns;
-    }
+    shape[ULAB_MAX_DIMS - 1] = width;
     shape[ULAB_MAX_DIMS - 2] = rows;
     ndarray_obj_t *ndarray = ndarray_new_dense_ndarray(2, shape, dtype);
     #endif
 
-    struct mp_stream_seek_t seek_s;
-    seek_s.offset = 0;
-    seek_s.whence = MP_SEEK_SET;
-    stream_p->ioctl(stream, MP_STREAM_SEEK, (mp_uint_t)(uintptr_t)&seek_s, &error);
-
-    char *clipboard = m_new(char, ULAB_IO_CLIPBOARD_SIZE);
-    char *clipboard_origin = clipboard;
-
-    rows = 0;
-    columns = 0;
-    len = 0;
-
-    size_t idx = 0;
-    do {
-        read = stream_p->read(stream, buffer, ULAB_IO_BUFFER_SIZE - 1, &error);
-        buffer[read] = '\0';
-        offset = buffer;
-
-        while(*offset != '\0') {
-            if(*offset == comment_char) {
-                // clear the line till the end, or the buffer's end
-                while((*offset != '\0')) {
-                    offset++;
-                    if(*offset == '\n') {
-                        rows++;
-                        offset++;
-                        break;
-                    }
-                }
-            }
-
-            if(rows == max_rows) {
-                break;
-            }
-
-            if((*offset == ' ') || (*offset == '\t') || (*offset == '\v') ||
-                (*offset == '\f') || (*offset == '\r') || (*offset == '\n') || (*offset == delimiter)) {
-                offset++;
-                while((*offset == ' ') || (*offset == '\t') || (*offset == '\v') ||
-                    (*offset == '\f') || (*offset == '\r') || (*offset == '\n')) {
-                    offset++;
-                }
-                if(len > 0) {
-                    clipboard = clipboard_origin;
-                    if(rows >= skiprows) {
-                        #if ULAB_MAX_DIMS == 1
-                        if(columns == cols[0]) {
-                            io_assign_value(clipboard, len, ndarray, &idx, dtype);
-                        }
-                        #else
-                        if(args[4].u_obj == mp_const_none) {
-                            io_assign_value(clipboard, len, ndarray, &idx, dtype);
-                        } else {
-                            for(uint8_t c = 0; c < used_columns; c++) {
-                                if(columns == cols[c]) {
-                                    io_assign_value(clipboard, len, ndarray, &idx, dtype);
-                                    break;
-                                }
-                            }
-                        }
-                        #endif
-                    }
-                    columns++;
-                    len = 0;
-
-                    if(offset[-1] == '\n') {
-                        columns = 0;
-                        rows++;
-                    }
-                }
-            } else {
-                *clipboard++ = *offset++;
-                len++;
-            }
-        }
-    } while((read > 0) && (rows < max_rows));
-
-    stream_p->ioctl(stream, MP_STREAM_CLOSE, 0, &error);
+    memcpy(ndarray->array, data, ndarray->len * ndarray->itemsize);
 
+    m_del(uint8_t, data, capacity * itemsize);
     m_del(size_t, shape, ULAB_MAX_DIMS);
-    m_del(char, buffer, ULAB_IO_BUFFER_SIZE);
-    m_del(char, clipboard, ULAB_IO_CLIPBOARD_SIZE);
     m_del(uint16_t, cols, used_columns);
 
     return MP_OBJ_FROM_PTR(ndarray);
@@ -553,7 +893,7 @@ static mp_obj_t io_save(mp_obj_t file, mp_obj_t ndarray_) {
     offset += 21;
 
     buffer[offset] = native_endianness;
-    if((ndarray->dtype == NDARRAY_UINT8) || (ndarray->dtype == NDARRAY_INT8)) {
+    if((ndarray->dtype == NDARRAY_UINT8) || ULAB_DTYPE_IS(ndarray->dtype, INT8)) {
         // for single-byte data, the endianness doesn't matter
         buffer[offset] = '|';
     }
@@ -571,6 +911,19 @@ static mp_obj_t io_save(mp_obj_t file, mp_obj_t ndarray_) {
         case NDARRAY_INT16:
             memcpy(buffer+offset, "i2", 2);
             break;
+        #if ULAB_SUPPORTS_INT32
+        case NDARRAY_UINT32:
+            memcpy(buffer+offset, "u4", 2);
+            break;
+        case NDARRAY_INT32:
+            memcpy(buffer+offset, "i4", 2);
+            break;
+        #endif
+        #if ULAB_SUPPORTS_FLOAT16
+        case NDARRAY_FLOAT16:
+            memcpy(buffer+offset, "f2", 2);
+            break;
+        #endif
         case NDARRAY_FLOAT:
             #if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT
             memcpy(buffer+offset, "f4", 2);
@@ -609,7 +962,15 @@ static mp_obj_t io_save(mp_obj_t file, mp_obj_t ndarray_) {
     buffer[ULAB_IO_BUFFER_SIZE - 1] = '\n';
     stream_p->write(stream, buffer, ULAB_IO_BUFFER_SIZE, &error);
 
-    // write the array data
+    // write the array data; contiguous arrays are written in a single call,
+    // everything else is collected in the buffer first
+    if(ndarray_is_contiguous(ndarray)) {
+        mp_stream_write_exactly(stream, ndarray->array, ndarray->len * ndarray->itemsize, &error);
+        stream_p->ioctl(stream, MP_STREAM_CLOSE, 0, &error);
+        m_del(char, buffer, ULAB_IO_BUFFER_SIZE);
+        return mp_const_none;
+    }
+
     uint8_t sz = ndarray->itemsize;
     offset = 0;
 
@@ -667,6 +1028,105 @@ static mp_obj_t io_save(mp_obj_t file, mp_obj_t ndarray_) {
 MP_DEFINE_CONST_FUN_OBJ_2(io_save_obj, io_save);
 #endif /* ULAB_NUMPY_HAS_SAVE */
 
+#if ULAB_NUMPY_HAS_SAVE_PACKED
+static mp_obj_t io_save_packed(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_append, MP_ARG_KW_ONLY | MP_ARG_BOOL, { .u_bool = false } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if(!mp_obj_is_str(args[0].u_obj) || !mp_obj_is_type(args[1].u_obj, &ulab_ndarray_type)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("wrong input type"));
+    }
+
+    ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(args[1].u_obj);
+    uint8_t dtype = ndarray->dtype;
+    if(!io_packed_supports_dtype(dtype)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("input must be an integer ndarray"));
+    }
+    if(!ndarray_is_contiguous(ndarray)) {
+        ndarray = ndarray_copy_view(ndarray);
+    }
+    uint8_t *array = (uint8_t *)ndarray->array;
+
+    // find the width of the zigzag-encoded deltas
+    int32_t first = ndarray->len > 0 ? io_packed_get_value(array, dtype, 0) : 0;
+    int32_t previous = first;
+    uint32_t bitmap = 0;
+    for(size_t i = 1; i < ndarray->len; i++) {
+        int32_t value = io_packed_get_value(array, dtype, i);
+        int32_t delta = value - previous;
+        bitmap |= ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+        previous = value;
+    }
+    uint8_t bits = 0;
+    while(bitmap != 0) {
+        bits++;
+        bitmap >>= 1;
+    }
+
+    int error;
+    char *buffer = m_new(char, ULAB_IO_BUFFER_SIZE);
+
+    // in the append mode, the frame is simply attached to the end of the file,
+    // there is no global header that would have to be rewritten
+    mp_obj_t open_args[2] = {
+        args[0].u_obj,
+        args[2].u_bool ? MP_OBJ_NEW_QSTR(MP_QSTR_ab) : MP_OBJ_NEW_QSTR(MP_QSTR_wb)
+    };
+
+    mp_obj_t stream = mp_builtin_open_obj.fun.kw(2, open_args, (mp_map_t *)&mp_const_empty_map);
+    const mp_stream_p_t *stream_p = mp_get_stream(stream);
+
+    memcpy(buffer, ULAB_IO_PACKED_MAGIC, 4);
+    buffer[4] = ULAB_IO_PACKED_VERSION;
+    buffer[5] = dtype;
+    buffer[6] = ndarray->ndim;
+    buffer[7] = bits;
+    uint8_t offset = 8;
+    for(uint8_t i = ULAB_MAX_DIMS - ndarray->ndim; i < ULAB_MAX_DIMS; i++) {
+        io_packed_put_uint32(buffer + offset, ndarray->shape[i]);
+        offset += 4;
+    }
+    io_packed_put_uint32(buffer + offset, (uint32_t)first);
+    offset += 4;
+
+    uint32_t accumulator = 0;
+    uint8_t accumulated = 0;
+    previous = first;
+    for(size_t i = 1; i < ndarray->len; i++) {
+        int32_t value = io_packed_get_value(array, dtype, i);
+        int32_t delta = value - previous;
+        accumulator |= (((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31)) << accumulated;
+        accumulated += bits;
+        previous = value;
+        while(accumulated >= 8) {
+            buffer[offset++] = (char)(accumulator & 0xff);
+            accumulator >>= 8;
+            accumulated -= 8;
+            if(offset == ULAB_IO_BUFFER_SIZE) {
+                mp_stream_write_exactly(stream, buffer, offset, &error);
+                offset = 0;
+            }
+        }
+    }
+    if(accumulated > 0) {
+        buffer[offset++] = (char)(accumulator & 0xff);
+    }
+    mp_stream_write_exactly(stream, buffer, offset, &error);
+    stream_p->ioctl(stream, MP_STREAM_CLOSE, 0, &error);
+
+    m_del(char, buffer, ULAB_IO_BUFFER_SIZE);
+    return mp_const_none;
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(io_save_packed_obj, 2, io_save_packed);
+#endif /* ULAB_NUMPY_HAS_SAVE_PACKED */
+
 #if ULAB_NUMPY_HAS_SAVETXT
 static int8_t io_format_float(ndarray_obj_t *ndarray, mp_float_t (*func)(void *), uint8_t *array, char *buffer, const char *delimiter) {
     // own implementation of float formatting for platforms that don't have sprintf
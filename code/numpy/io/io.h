@@ -11,9 +11,11 @@
 #ifndef _ULAB_IO_
 #define _ULAB_IO_
 
-MP_DECLARE_CONST_FUN_OBJ_1(io_load_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(io_load_obj);
+MP_DECLARE_CONST_FUN_OBJ_1(io_load_packed_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(io_loadtxt_obj);
 MP_DECLARE_CONST_FUN_OBJ_2(io_save_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(io_save_packed_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(io_savetxt_obj);
 
 #endif
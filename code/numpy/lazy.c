@@ -0,0 +1,374 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#include <math.h>
+#include <string.h>
+#include "py/obj.h"
+#include "py/runtime.h"
+#include "py/misc.h"
+
+#include "../ulab.h"
+#include "../ulab_tools.h"
+#include "carray/carray_tools.h"
+#include "lazy.h"
+
+#if ULAB_NUMPY_HAS_LAZY
+
+// Lazy expressions record the operator tree of an arithmetic expression,
+// and evaluate it in a single pass over the operands, when the result is
+// requested. This way, no intermediate arrays are created.
+
+typedef struct _lazy_instruction_t {
+    uint8_t code;
+    uint8_t index;
+} lazy_instruction_t;
+
+typedef struct _lazy_leaf_t {
+    ndarray_obj_t *ndarray;
+    uint8_t *array;
+    mp_float_t (*func)(void *);
+    int32_t strides[ULAB_MAX_DIMS];
+} lazy_leaf_t;
+
+typedef struct _lazy_program_t {
+    lazy_instruction_t code[2 * LAZY_MAX_OPERANDS];
+    uint8_t length;
+    lazy_leaf_t leaves[LAZY_MAX_OPERANDS];
+    uint8_t nleaves;
+    mp_float_t constants[LAZY_MAX_OPERANDS];
+    uint8_t nconstants;
+} lazy_program_t;
+
+static uint8_t lazy_count_operands(mp_obj_t obj) {
+    // returns the number of operands in obj, or 0, if obj cannot be part of an expression
+    if(mp_obj_is_type(obj, &lazy_type)) {
+        lazy_obj_t *node = MP_OBJ_TO_PTR(obj);
+        return node->operands;
+    } else if(mp_obj_is_type(obj, &ulab_ndarray_type)) {
+        ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(obj);
+        COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+        return 1;
+    } else if(mp_obj_is_int(obj) || mp_obj_is_float(obj)) {
+        return 1;
+    }
+    return 0;
+}
+
+static uint8_t lazy_count_instructions(mp_obj_t obj) {
+    // returns the number of instructions emitted by lazy_compile for obj; operands take a single one
+    if(mp_obj_is_type(obj, &lazy_type)) {
+        lazy_obj_t *node = MP_OBJ_TO_PTR(obj);
+        return node->length;
+    }
+    return 1;
+}
+
+static lazy_obj_t *lazy_new_node(uint8_t op, mp_obj_t lhs, mp_obj_t rhs, uint8_t operands, uint8_t length) {
+    // unary operators add an instruction, but no operand, therefore, the length of the program
+    // has to be checked separately, before it could overflow lazy_program_t.code
+    if((operands > LAZY_MAX_OPERANDS) || (length > 2 * LAZY_MAX_OPERANDS)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("expression is too long"));
+    }
+    lazy_obj_t *node = m_new_obj(lazy_obj_t);
+    node->base.type = &lazy_type;
+    node->op = op;
+    node->operands = operands;
+    node->length = length;
+    node->lhs = lhs;
+    node->rhs = rhs;
+    return node;
+}
+
+//| def lazy(x: _ArrayLike) -> lazy:
+//|     """
+//|     :param x: an ndarray, or a scalar
+//|
+//|     Wrap ``x`` in a lazy expression. Arithmetic operations involving the returned
+//|     object are not evaluated immediately, but are recorded, and computed in a single
+//|     pass over all operands by the ``evaluate`` method."""
+//|     ...
+//|
+
+static mp_obj_t lazy_lazy(mp_obj_t x) {
+    if(lazy_count_operands(x) == 0) {
+        mp_raise_TypeError(MP_ERROR_TEXT("wrong operand type"));
+    }
+    if(mp_obj_is_type(x, &lazy_type)) {
+        return x;
+    }
+    return MP_OBJ_FROM_PTR(lazy_new_node(LAZY_LOAD, x, mp_const_none, 1, 1));
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(lazy_lazy_obj, lazy_lazy);
+
+static mp_obj_t lazy_binary_op(mp_binary_op_t _op, mp_obj_t lobj, mp_obj_t robj) {
+    // the lazy object is always lobj; in the case of reversed operators, the operands are swapped
+    uint8_t op;
+    mp_obj_t lhs = lobj, rhs = robj;
+    if((_op >= MP_BINARY_OP_REVERSE_OR) && (_op <= MP_BINARY_OP_REVERSE_POWER)) {
+        lhs = robj;
+        rhs = lobj;
+        _op -= MP_BINARY_OP_REVERSE_OR - MP_BINARY_OP_OR;
+    }
+    switch(_op) {
+        case MP_BINARY_OP_ADD:
+            op = LAZY_ADD;
+            break;
+        case MP_BINARY_OP_SUBTRACT:
+            op = LAZY_SUBTRACT;
+            break;
+        case MP_BINARY_OP_MULTIPLY:
+            op = LAZY_MULTIPLY;
+            break;
+        case MP_BINARY_OP_TRUE_DIVIDE:
+            op = LAZY_TRUE_DIVIDE;
+            break;
+        case MP_BINARY_OP_POWER:
+            op = LAZY_POWER;
+            break;
+        default:
+            return MP_OBJ_NULL; // op not supported
+    }
+    uint8_t loperands = lazy_count_operands(lhs);
+    uint8_t roperands = lazy_count_operands(rhs);
+    if((loperands == 0) || (roperands == 0)) {
+        return MP_OBJ_NULL;
+    }
+    return MP_OBJ_FROM_PTR(lazy_new_node(op, lhs, rhs, loperands + roperands,
+                            lazy_count_instructions(lhs) + lazy_count_instructions(rhs) + 1));
+}
+
+static mp_obj_t lazy_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
+    lazy_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    switch(op) {
+        case MP_UNARY_OP_POSITIVE:
+            return self_in;
+        case MP_UNARY_OP_NEGATIVE:
+            return MP_OBJ_FROM_PTR(lazy_new_node(LAZY_NEGATIVE, self_in, mp_const_none, self->operands, self->length + 1));
+        default:
+            return MP_OBJ_NULL; // op not supported
+    }
+}
+
+static void lazy_emit(lazy_program_t *program, uint8_t code, uint8_t index) {
+    program->code[program->length].code = code;
+    program->code[program->length].index = index;
+    program->length++;
+}
+
+static void lazy_compile(lazy_program_t *program, mp_obj_t obj) {
+    // translates the expression tree into a postfix program; the number of
+    // instructions is bounded by 2 * LAZY_MAX_OPERANDS, hence, so is the depth of the recursion
+    if(mp_obj_is_type(obj, &lazy_type)) {
+        lazy_obj_t *node = MP_OBJ_TO_PTR(obj);
+        lazy_compile(program, node->lhs);
+        if(node->op == LAZY_NEGATIVE) {
+            lazy_emit(program, LAZY_NEGATIVE, 0);
+        } else if(node->op != LAZY_LOAD) {
+            lazy_compile(program, node->rhs);
+            lazy_emit(program, node->op, 0);
+        }
+    } else if(mp_obj_is_type(obj, &ulab_ndarray_type)) {
+        ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(obj);
+        uint8_t index = 0;
+        // an array might appear more than once in the expression
+        while((index < program->nleaves) && (program->leaves[index].ndarray != ndarray)) {
+            index++;
+        }
+        if(index == program->nleaves) {
+            program->leaves[index].ndarray = ndarray;
+            program->nleaves++;
+        }
+        lazy_emit(program, LAZY_LOAD, index);
+    } else {
+        program->constants[program->nconstants] = mp_obj_get_float(obj);
+        lazy_emit(program, LAZY_CONSTANT, program->nconstants);
+        program->nconstants++;
+    }
+}
+
+static uint8_t lazy_broadcast(lazy_program_t *program, size_t *shape) {
+    // works out the shape of the result, and the strides of the operands, as in ndarray_can_broadcast
+    uint8_t ndim = 0;
+    for(uint8_t j = 0; j < program->nleaves; j++) {
+        ndim = MAX(ndim, program->leaves[j].ndarray->ndim);
+    }
+    for(uint8_t i = ULAB_MAX_DIMS; i > 0; i--) {
+        shape[i - 1] = 1;
+        if(i <= ULAB_MAX_DIMS - ndim) {
+            continue;
+        }
+        for(uint8_t j = 0; j < program->nleaves; j++) {
+            ndarray_obj_t *ndarray = program->leaves[j].ndarray;
+            if((i > ULAB_MAX_DIMS - ndarray->ndim) && (ndarray->shape[i - 1] != 1)) {
+                if(shape[i - 1] == 1) {
+                    shape[i - 1] = ndarray->shape[i - 1];
+                } else if(shape[i - 1] != ndarray->shape[i - 1]) {
+                    mp_raise_ValueError(MP_ERROR_TEXT("operands could not be broadcast together"));
+                }
+            }
+        }
+    }
+    for(uint8_t j = 0; j < program->nleaves; j++) {
+        lazy_leaf_t *leaf = &program->leaves[j];
+        ndarray_obj_t *ndarray = leaf->ndarray;
+        leaf->array = (uint8_t *)ndarray->array;
+        leaf->func = ndarray_get_float_function(ndarray->dtype);
+        for(uint8_t i = ULAB_MAX_DIMS; i > 0; i--) {
+            if((i > ULAB_MAX_DIMS - ndarray->ndim) && (ndarray->shape[i - 1] == shape[i - 1])) {
+                leaf->strides[i - 1] = ndarray->strides[i - 1];
+            } else {
+                // this axis is either missing, or is broadcast
+                leaf->strides[i - 1] = 0;
+            }
+        }
+    }
+    return ndim;
+}
+
+static mp_float_t lazy_run(lazy_program_t *program) {
+    // evaluates the program at the current position of the operands
+    mp_float_t stack[LAZY_MAX_OPERANDS];
+    uint8_t sp = 0;
+    lazy_instruction_t *instruction = program->code;
+    for(uint8_t i = 0; i < program->length; i++, instruction++) {
+        if(instruction->code == LAZY_LOAD) {
+            lazy_leaf_t *leaf = &program->leaves[instruction->index];
+            stack[sp++] = leaf->func(leaf->array);
+        } else if(instruction->code == LAZY_CONSTANT) {
+            stack[sp++] = program->constants[instruction->index];
+        } else if(instruction->code == LAZY_NEGATIVE) {
+            stack[sp - 1] = -stack[sp - 1];
+        } else {
+            sp--;
+            mp_float_t y = stack[sp];
+            mp_float_t *x = &stack[sp - 1];
+            switch(instruction->code) {
+                case LAZY_ADD:
+                    *x = *x + y;
+                    break;
+                case LAZY_SUBTRACT:
+                    *x = *x - y;
+                    break;
+                case LAZY_MULTIPLY:
+                    *x = *x * y;
+                    break;
+                case LAZY_TRUE_DIVIDE:
+                    *x = *x / y;
+                    break;
+                default: // LAZY_POWER
+                    *x = MICROPY_FLOAT_C_FUN(pow)(*x, y);
+                    break;
+            }
+        }
+    }
+    return stack[0];
+}
+
+//| def evaluate(self, *, out: Optional[ulab.numpy.ndarray] = None) -> Union[ulab.numpy.ndarray, _float]:
+//|     """
+//|     :param out: an optional float array, into which the results are written
+//|
+//|     Compute the value of the expression element-wise in a single pass. Operands
+//|     are broadcast according to the usual rules, and the result is always of type float."""
+//|     ...
+//|
+
+static mp_obj_t lazy_evaluate(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_out, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    lazy_program_t program;
+    program.length = 0;
+    program.nleaves = 0;
+    program.nconstants = 0;
+    lazy_compile(&program, args[0].u_obj);
+
+    if(program.nleaves == 0) {
+        // the expression contains scalars only
+        return mp_obj_new_float(lazy_run(&program));
+    }
+
+    size_t shape[ULAB_MAX_DIMS];
+    uint8_t ndim = lazy_broadcast(&program, shape);
+
+    ndarray_obj_t *results;
+    if(args[1].u_obj == mp_const_none) {
+        results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
+    } else {
+        results = tools_get_out_array(args[1].u_obj, ndim, shape, NDARRAY_FLOAT);
+    }
+
+    int32_t rstrides[ULAB_MAX_DIMS] = { 0 };
+    for(uint8_t i = ULAB_MAX_DIMS; i > ULAB_MAX_DIMS - ndim; i--) {
+        rstrides[i - 1] = results->strides[i - 1];
+    }
+    uint8_t *rarray = (uint8_t *)results->array;
+
+    size_t coords[ULAB_MAX_DIMS] = { 0 };
+    for(size_t n = 0; n < results->len; n++) {
+        *(mp_float_t *)rarray = lazy_run(&program);
+        // advance all pointers by one element, and roll over the exhausted axes
+        uint8_t i = ULAB_MAX_DIMS - 1;
+        while(1) {
+            rarray += rstrides[i];
+            for(uint8_t j = 0; j < program.nleaves; j++) {
+                program.leaves[j].array += program.leaves[j].strides[i];
+            }
+            coords[i]++;
+            if((coords[i] < shape[i]) || (i == 0)) {
+                break;
+            }
+            coords[i] = 0;
+            rarray -= rstrides[i] * shape[i];
+            for(uint8_t j = 0; j < program.nleaves; j++) {
+                program.leaves[j].array -= program.leaves[j].strides[i] * shape[i];
+            }
+            i--;
+        }
+    }
+    return MP_OBJ_FROM_PTR(results);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(lazy_evaluate_obj, 1, lazy_evaluate);
+
+static const mp_rom_map_elem_t lazy_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_evaluate), MP_ROM_PTR(&lazy_evaluate_obj) },
+};
+
+static MP_DEFINE_CONST_DICT(lazy_locals_dict, lazy_locals_dict_table);
+
+#if defined(MP_DEFINE_CONST_OBJ_TYPE)
+MP_DEFINE_CONST_OBJ_TYPE(
+    lazy_type,
+    MP_QSTR_lazy,
+    MP_TYPE_FLAG_NONE,
+    unary_op, lazy_unary_op,
+    binary_op, lazy_binary_op,
+    locals_dict, &lazy_locals_dict
+);
+#else
+const mp_obj_type_t lazy_type = {
+    { &mp_type_type },
+    .flags = MP_TYPE_FLAG_EXTENDED,
+    .name = MP_QSTR_lazy,
+    .locals_dict = (mp_obj_dict_t*)&lazy_locals_dict,
+    MP_TYPE_EXTENDED_FIELDS(
+    .unary_op = lazy_unary_op,
+    .binary_op = lazy_binary_op,
+    )
+};
+#endif
+
+#endif /* ULAB_NUMPY_HAS_LAZY */
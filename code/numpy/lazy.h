@@ -0,0 +1,45 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#ifndef _LAZY_
+#define _LAZY_
+
+#include "../ulab.h"
+#include "../ndarray.h"
+
+// the maximum number of operands (arrays, and scalars) in a single expression;
+// this also bounds the depth of the evaluation stack
+#define LAZY_MAX_OPERANDS       (32)
+
+enum LAZY_OPERATION {
+    LAZY_LOAD,
+    LAZY_CONSTANT,
+    LAZY_ADD,
+    LAZY_SUBTRACT,
+    LAZY_MULTIPLY,
+    LAZY_TRUE_DIVIDE,
+    LAZY_POWER,
+    LAZY_NEGATIVE,
+};
+
+typedef struct _lazy_obj_t {
+    mp_obj_base_t base;
+    uint8_t op;
+    uint8_t operands;
+    uint8_t length;
+    mp_obj_t lhs;
+    mp_obj_t rhs;
+} lazy_obj_t;
+
+extern const mp_obj_type_t lazy_type;
+
+MP_DECLARE_CONST_FUN_OBJ_1(lazy_lazy_obj);
+
+#endif
@@ -23,6 +23,7 @@
 #include "../../ulab.h"
 #include "../../ulab_tools.h"
 #include "../carray/carray_tools.h"
+#include "../../ulab_profile.h"
 #include "linalg.h"
 
 #if ULAB_NUMPY_HAS_LINALG_MODULE
@@ -35,22 +36,16 @@
 #if ULAB_MAX_DIMS > 1
 //| def cholesky(A: ulab.numpy.ndarray) -> ulab.numpy.ndarray:
 //|     """
-//|     :param ~ulab.numpy.ndarray A: a positive definite, symmetric square matrix
+//|     :param ~ulab.numpy.ndarray A: a positive definite, symmetric square matrix, or a stack of such matrices
 //|     :return ~ulab.numpy.ndarray L: a square root matrix in the lower triangular form
 //|     :raises ValueError: If the input does not fulfill the necessary conditions
 //|
-//|     The returned matrix satisfies the equation m=LL*"""
+//|     The returned matrix satisfies the equation m=LL*. Arrays of shape (..., N, N) are decomposed matrix by matrix."""
 //|     ...
 //|
 
-static mp_obj_t linalg_cholesky(mp_obj_t oin) {
-    ndarray_obj_t *ndarray = tools_object_is_square(oin);
-    COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
-    ndarray_obj_t *L = ndarray_new_dense_ndarray(2, ndarray_shape_vector(0, 0, ndarray->shape[ULAB_MAX_DIMS - 1], ndarray->shape[ULAB_MAX_DIMS - 1]), NDARRAY_FLOAT);
-    mp_float_t *Larray = (mp_float_t *)L->array;
-
-    size_t N = ndarray->shape[ULAB_MAX_DIMS - 1];
-    uint8_t *array = (uint8_t *)ndarray->array;
+static void linalg_cholesky_matrix(ndarray_obj_t *ndarray, uint8_t *array, mp_float_t *Larray, size_t N) {
+    // decomposes the N-by-N matrix starting at array, and writes the lower triangular factor into Larray
     mp_float_t (*func)(void *) = ndarray_get_float_function(ndarray->dtype);
 
     for(size_t m=0; m < N; m++) { // rows
@@ -96,6 +91,20 @@ static mp_obj_t linalg_cholesky(mp_obj_t oin) {
             }
         }
     }
+}
+
+static mp_obj_t linalg_cholesky(mp_obj_t oin) {
+    ndarray_obj_t *ndarray = tools_object_is_square_stack(oin);
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+    ndarray_obj_t *L = ndarray_new_dense_ndarray(ndarray->ndim, ndarray->shape, NDARRAY_FLOAT);
+    mp_float_t *Larray = (mp_float_t *)L->array;
+
+    size_t N = ndarray->shape[ULAB_MAX_DIMS - 1];
+    // stacked matrices are decomposed one by one
+    for(size_t s=0; s < tools_stack_count(ndarray, 2); s++) {
+        linalg_cholesky_matrix(ndarray, tools_stack_pointer(ndarray, 2, s), Larray, N);
+        Larray += N * N;
+    }
     return MP_OBJ_FROM_PTR(L);
 }
 
@@ -103,19 +112,15 @@ MP_DEFINE_CONST_FUN_OBJ_1(linalg_cholesky_obj, linalg_cholesky);
 
 //| def det(m: ulab.numpy.ndarray) -> float:
 //|     """
-//|     :param: m, a square matrix
-//|     :return float: The determinant of the matrix
+//|     :param: m, a square matrix, or a stack of square matrices of shape (..., N, N)
+//|     :return float: The determinant of the matrix, or an array of the determinants of the stack
 //|
-//|     Computes the eigenvalues and eigenvectors of a square matrix"""
+//|     Computes the determinant of a square matrix"""
 //|     ...
 //|
 
-static mp_obj_t linalg_det(mp_obj_t oin) {
-    ndarray_obj_t *ndarray = tools_object_is_square(oin);
-    COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
-    uint8_t *array = (uint8_t *)ndarray->array;
-    size_t N = ndarray->shape[ULAB_MAX_DIMS - 1];
-    mp_float_t *tmp = m_new(mp_float_t, N * N);
+static mp_float_t linalg_det_matrix(ndarray_obj_t *ndarray, uint8_t *array, mp_float_t *tmp, size_t N) {
+    // returns the determinant of the N-by-N matrix starting at array; tmp is a scratch buffer of length N * N
     for(size_t m=0; m < N; m++) { // rows
         for(size_t n=0; n < N; n++) { // columns
             *tmp++ = ndarray_get_float_value(array, ndarray->dtype);
@@ -147,8 +152,7 @@ static mp_obj_t linalg_det(mp_obj_t oin) {
                 }
             }
             if (m1 >= N) {
-                m_del(mp_float_t, tmp, N * N);
-                return mp_obj_new_float(0.0);
+                return MICROPY_FLOAT_CONST(0.0);
             }
         }
         for(size_t n=0; n < N; n++) {
@@ -165,8 +169,35 @@ static mp_obj_t linalg_det(mp_obj_t oin) {
     for(size_t m=0; m < N; m++){
         det *= tmp[m * (N+1)];
     }
-    m_del(mp_float_t, tmp, N * N);
-    return mp_obj_new_float(det);
+    return det;
+}
+
+static mp_obj_t linalg_det(mp_obj_t oin) {
+    ndarray_obj_t *ndarray = tools_object_is_square_stack(oin);
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+    size_t N = ndarray->shape[ULAB_MAX_DIMS - 1];
+    mp_float_t *tmp = ulab_scratch_new(mp_float_t, N * N);
+
+    if(ndarray->ndim == 2) {
+        mp_float_t det = linalg_det_matrix(ndarray, (uint8_t *)ndarray->array, tmp, N);
+        ulab_scratch_del(mp_float_t, tmp, N * N);
+        return mp_obj_new_float(det);
+    }
+
+    // for stacked matrices, the result has the shape of the leading axes
+    size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
+    for(uint8_t i = ULAB_MAX_DIMS - 1; i > ULAB_MAX_DIMS - ndarray->ndim + 1; i--) {
+        shape[i] = ndarray->shape[i - 2];
+    }
+    ndarray_obj_t *results = ndarray_new_dense_ndarray(ndarray->ndim - 2, shape, NDARRAY_FLOAT);
+    m_del(size_t, shape, ULAB_MAX_DIMS);
+    mp_float_t *rarray = (mp_float_t *)results->array;
+
+    for(size_t s=0; s < results->len; s++) {
+        *rarray++ = linalg_det_matrix(ndarray, tools_stack_pointer(ndarray, 2, s), tmp, N);
+    }
+    ulab_scratch_del(mp_float_t, tmp, N * N);
+    return MP_OBJ_FROM_PTR(results);
 }
 
 MP_DEFINE_CONST_FUN_OBJ_1(linalg_det_obj, linalg_det);
@@ -174,24 +205,27 @@ MP_DEFINE_CONST_FUN_OBJ_1(linalg_det_obj, linalg_det);
 #endif
 
 #if ULAB_MAX_DIMS > 1
-//| def eig(m: ulab.numpy.ndarray) -> Tuple[ulab.numpy.ndarray, ulab.numpy.ndarray]:
-//|     """
-//|     :param m: a square matrix
-//|     :return tuple (eigenvectors, eigenvalues):
-//|
-//|     Computes the eigenvalues and eigenvectors of a square matrix"""
-//|     ...
-//|
-
-static mp_obj_t linalg_eig(mp_obj_t oin) {
+static mp_obj_t linalg_symmetric_eigen_ndarray(mp_obj_t oin, bool vectors) {
+    // computes the eigenvalues, and if vectors is true, the eigenvectors of a symmetric matrix
     ndarray_obj_t *in = tools_object_is_square(oin);
     COMPLEX_DTYPE_NOT_IMPLEMENTED(in->dtype)
     uint8_t *iarray = (uint8_t *)in->array;
     size_t S = in->shape[ULAB_MAX_DIMS - 1];
-    mp_float_t *array = m_new(mp_float_t, S*S);
+
+    // the eigenvectors are computed in place, so that no scratch matrix is required
+    ndarray_obj_t *eigenvectors = NULL;
+    mp_float_t *array;
+    if(vectors) {
+        eigenvectors = ndarray_new_dense_ndarray(2, ndarray_shape_vector(0, 0, S, S), NDARRAY_FLOAT);
+        array = (mp_float_t *)eigenvectors->array;
+    } else {
+        array = ulab_scratch_new(mp_float_t, S * S);
+    }
+
+    mp_float_t (*func)(void *) = ndarray_get_float_function(in->dtype);
     for(size_t i=0; i < S; i++) { // rows
         for(size_t j=0; j < S; j++) { // columns
-            *array++ = ndarray_get_float_value(iarray, in->dtype);
+            *array++ = func(iarray);
             iarray += in->strides[ULAB_MAX_DIMS - 1];
         }
         iarray -= in->strides[ULAB_MAX_DIMS - 1] * S;
@@ -204,70 +238,113 @@ static mp_obj_t linalg_eig(mp_obj_t oin) {
             // compare entry (m, n) to (n, m)
             // TODO: this must probably be scaled!
             if(LINALG_EPSILON < MICROPY_FLOAT_C_FUN(fabs)(array[m * S + n] - array[n * S + m])) {
+                if(!vectors) {
+                    ulab_scratch_del(mp_float_t, array, S * S);
+                }
                 mp_raise_ValueError(MP_ERROR_TEXT("input matrix is asymmetric"));
             }
         }
     }
 
     // if we got this far, then the matrix will be symmetric
+    ndarray_obj_t *eigenvalues = ndarray_new_linear_array(S, NDARRAY_FLOAT);
+    mp_float_t *eigvalues = (mp_float_t *)eigenvalues->array;
 
-    ndarray_obj_t *eigenvectors = ndarray_new_dense_ndarray(2, ndarray_shape_vector(0, 0, S, S), NDARRAY_FLOAT);
-    mp_float_t *eigvectors = (mp_float_t *)eigenvectors->array;
-
-    size_t iterations = linalg_jacobi_rotations(array, eigvectors, S);
-
-    if(iterations == 0) {
+    bool converged = linalg_symmetric_eigen(array, eigvalues, S, vectors);
+    if(!vectors) {
+        ulab_scratch_del(mp_float_t, array, S * S);
+    }
+    if(!converged) {
         // the computation did not converge; numpy raises LinAlgError
-        m_del(mp_float_t, array, in->len);
         mp_raise_ValueError(MP_ERROR_TEXT("iterations did not converge"));
     }
-    ndarray_obj_t *eigenvalues = ndarray_new_linear_array(S, NDARRAY_FLOAT);
-    mp_float_t *eigvalues = (mp_float_t *)eigenvalues->array;
-    for(size_t i=0; i < S; i++) {
-        eigvalues[i] = array[i * (S + 1)];
-    }
-    m_del(mp_float_t, array, in->len);
 
+    if(!vectors) {
+        return MP_OBJ_FROM_PTR(eigenvalues);
+    }
     mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(mp_obj_new_tuple(2, NULL));
     tuple->items[0] = MP_OBJ_FROM_PTR(eigenvalues);
     tuple->items[1] = MP_OBJ_FROM_PTR(eigenvectors);
     return MP_OBJ_FROM_PTR(tuple);
 }
 
+//| def eig(m: ulab.numpy.ndarray) -> Tuple[ulab.numpy.ndarray, ulab.numpy.ndarray]:
+//|     """
+//|     :param m: a symmetric square matrix
+//|     :return tuple (eigenvalues, eigenvectors):
+//|
+//|     Computes the eigenvalues and eigenvectors of a symmetric square matrix.
+//|     The eigenvalues are sorted in ascending order, and the eigenvectors are
+//|     the columns of the second matrix"""
+//|     ...
+//|
+
+static mp_obj_t linalg_eig(mp_obj_t oin) {
+    return linalg_symmetric_eigen_ndarray(oin, true);
+}
+
 MP_DEFINE_CONST_FUN_OBJ_1(linalg_eig_obj, linalg_eig);
 
+//| def eigh(m: ulab.numpy.ndarray) -> Tuple[ulab.numpy.ndarray, ulab.numpy.ndarray]:
+//|     """
+//|     :param m: a symmetric square matrix
+//|     :return tuple (eigenvalues, eigenvectors):
+//|
+//|     An alias of eig, since ulab's eig is restricted to symmetric matrices"""
+//|     ...
+//|
+
+//| def eigvalsh(m: ulab.numpy.ndarray) -> ulab.numpy.ndarray:
+//|     """
+//|     :param m: a symmetric square matrix
+//|     :return: the eigenvalues in ascending order
+//|
+//|     Computes the eigenvalues of a symmetric square matrix, without the eigenvectors."""
+//|     ...
+//|
+
+static mp_obj_t linalg_eigvalsh(mp_obj_t oin) {
+    return linalg_symmetric_eigen_ndarray(oin, false);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(linalg_eigvalsh_obj, linalg_eigvalsh);
+
 //| def inv(m: ulab.numpy.ndarray) -> ulab.numpy.ndarray:
 //|     """
-//|     :param ~ulab.numpy.ndarray m: a square matrix
+//|     :param ~ulab.numpy.ndarray m: a square matrix, or a stack of square matrices of shape (..., N, N)
 //|     :return: The inverse of the matrix, if it exists
 //|     :raises ValueError: if the matrix is not invertible
 //|
-//|     Computes the inverse of a square matrix"""
+//|     Computes the inverse of a square matrix, or of each matrix of a stack"""
 //|     ...
 //|
 static mp_obj_t linalg_inv(mp_obj_t o_in) {
-    ndarray_obj_t *ndarray = tools_object_is_square(o_in);
+    ndarray_obj_t *ndarray = tools_object_is_square_stack(o_in);
     COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
-    uint8_t *array = (uint8_t *)ndarray->array;
     size_t N = ndarray->shape[ULAB_MAX_DIMS - 1];
-    ndarray_obj_t *inverted = ndarray_new_dense_ndarray(2, ndarray_shape_vector(0, 0, N, N), NDARRAY_FLOAT);
+    ndarray_obj_t *inverted = ndarray_new_dense_ndarray(ndarray->ndim, ndarray->shape, NDARRAY_FLOAT);
     mp_float_t *iarray = (mp_float_t *)inverted->array;
 
     mp_float_t (*func)(void *) = ndarray_get_float_function(ndarray->dtype);
 
-    for(size_t i=0; i < N; i++) { // rows
-        for(size_t j=0; j < N; j++) { // columns
-            *iarray++ = func(array);
-            array += ndarray->strides[ULAB_MAX_DIMS - 1];
+    // stacked matrices are inverted one by one
+    for(size_t s=0; s < tools_stack_count(ndarray, 2); s++) {
+        uint8_t *array = tools_stack_pointer(ndarray, 2, s);
+        for(size_t i=0; i < N; i++) { // rows
+            for(size_t j=0; j < N; j++) { // columns
+                *iarray++ = func(array);
+                array += ndarray->strides[ULAB_MAX_DIMS - 1];
+            }
+            array -= ndarray->strides[ULAB_MAX_DIMS - 1] * N;
+            array += ndarray->strides[ULAB_MAX_DIMS - 2];
         }
-        array -= ndarray->strides[ULAB_MAX_DIMS - 1] * N;
-        array += ndarray->strides[ULAB_MAX_DIMS - 2];
-    }
-    // re-wind the pointer
-    iarray -= N*N;
+        // re-wind the pointer
+        iarray -= N*N;
 
-    if(!linalg_invert_matrix(iarray, N)) {
-        mp_raise_ValueError(MP_ERROR_TEXT("input matrix is singular"));
+        if(!linalg_invert_matrix(iarray, N)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("input matrix is singular"));
+        }
+        iarray += N*N;
     }
     return MP_OBJ_FROM_PTR(inverted);
 }
@@ -506,27 +583,86 @@ static mp_obj_t linalg_qr(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
 MP_DEFINE_CONST_FUN_OBJ_KW(linalg_qr_obj, 1, linalg_qr);
 #endif
 
+#if ULAB_MAX_DIMS > 1
+//| def solve(a: ulab.numpy.ndarray, b: ulab.numpy.ndarray) -> ulab.numpy.ndarray:
+//|     """
+//|     :param ~ulab.numpy.ndarray a: a square matrix
+//|     :param ~ulab.numpy.ndarray b: right-hand-side vector, or matrix, whose columns are the right hand sides
+//|     :return: solution to the system a x = b. Shape of return matches b
+//|     :raises ValueError: if the matrix is singular
+//|
+//|     Solves the linear equations a x = b through the LU decomposition of a with partial pivoting."""
+//|     ...
+//|
+
+static mp_obj_t linalg_solve(mp_obj_t _a, mp_obj_t _b) {
+    ndarray_obj_t *a = tools_object_is_square(_a);
+    if(!mp_obj_is_type(_b, &ulab_ndarray_type)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("arguments must be ndarrays"));
+    }
+    ndarray_obj_t *b = MP_OBJ_TO_PTR(_b);
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(a->dtype)
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(b->dtype)
+
+    size_t N = a->shape[ULAB_MAX_DIMS - 1];
+    mp_float_t *data = ulab_scratch_new(mp_float_t, N * N);
+    uint16_t *pivots = ulab_scratch_new(uint16_t, N);
+
+    uint8_t *array = (uint8_t *)a->array;
+    mp_float_t (*func)(void *) = ndarray_get_float_function(a->dtype);
+    for(size_t i=0; i < N; i++) { // rows
+        for(size_t j=0; j < N; j++) { // columns
+            data[i * N + j] = func(array);
+            array += a->strides[ULAB_MAX_DIMS - 1];
+        }
+        array -= a->strides[ULAB_MAX_DIMS - 1] * N;
+        array += a->strides[ULAB_MAX_DIMS - 2];
+    }
+
+    if(!linalg_lu_decompose(data, pivots, N)) {
+        ulab_scratch_del(uint16_t, pivots, N);
+        ulab_scratch_del(mp_float_t, data, N * N);
+        mp_raise_ValueError(MP_ERROR_TEXT("input matrix is singular"));
+    }
+    ndarray_obj_t *x = linalg_lu_solve_ndarray(data, pivots, N, b);
+    ulab_scratch_del(uint16_t, pivots, N);
+    ulab_scratch_del(mp_float_t, data, N * N);
+    return MP_OBJ_FROM_PTR(x);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_2(linalg_solve_obj, linalg_solve);
+#endif
+
 STATIC const mp_rom_map_elem_t ulab_linalg_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_linalg) },
     #if ULAB_MAX_DIMS > 1
         #if ULAB_LINALG_HAS_CHOLESKY
-        { MP_ROM_QSTR(MP_QSTR_cholesky), MP_ROM_PTR(&linalg_cholesky_obj) },
+        { MP_ROM_QSTR(MP_QSTR_cholesky), ULAB_PROFILE_PTR(MP_QSTR_linalg, MP_QSTR_cholesky, linalg_cholesky_obj) },
         #endif
         #if ULAB_LINALG_HAS_DET
-        { MP_ROM_QSTR(MP_QSTR_det), MP_ROM_PTR(&linalg_det_obj) },
+        { MP_ROM_QSTR(MP_QSTR_det), ULAB_PROFILE_PTR(MP_QSTR_linalg, MP_QSTR_det, linalg_det_obj) },
         #endif
         #if ULAB_LINALG_HAS_EIG
-        { MP_ROM_QSTR(MP_QSTR_eig), MP_ROM_PTR(&linalg_eig_obj) },
+        { MP_ROM_QSTR(MP_QSTR_eig), ULAB_PROFILE_PTR(MP_QSTR_linalg, MP_QSTR_eig, linalg_eig_obj) },
+        #endif
+        #if ULAB_LINALG_HAS_EIGH
+        { MP_ROM_QSTR(MP_QSTR_eigh), ULAB_PROFILE_PTR(MP_QSTR_linalg, MP_QSTR_eigh, linalg_eig_obj) },
+        #endif
+        #if ULAB_LINALG_HAS_EIGVALSH
+        { MP_ROM_QSTR(MP_QSTR_eigvalsh), ULAB_PROFILE_PTR(MP_QSTR_linalg, MP_QSTR_eigvalsh, linalg_eigvalsh_obj) },
         #endif
         #if ULAB_LINALG_HAS_INV
-        { MP_ROM_QSTR(MP_QSTR_inv), MP_ROM_PTR(&linalg_inv_obj) },
+        { MP_ROM_QSTR(MP_QSTR_inv), ULAB_PROFILE_PTR(MP_QSTR_linalg, MP_QSTR_inv, linalg_inv_obj) },
         #endif
         #if ULAB_LINALG_HAS_QR
-        { MP_ROM_QSTR(MP_QSTR_qr), MP_ROM_PTR(&linalg_qr_obj) },
+        { MP_ROM_QSTR(MP_QSTR_qr), ULAB_PROFILE_PTR(MP_QSTR_linalg, MP_QSTR_qr, linalg_qr_obj) },
+        #endif
+        #if ULAB_LINALG_HAS_SOLVE
+        { MP_ROM_QSTR(MP_QSTR_solve), ULAB_PROFILE_PTR(MP_QSTR_linalg, MP_QSTR_solve, linalg_solve_obj) },
         #endif
     #endif
     #if ULAB_LINALG_HAS_NORM
-    { MP_ROM_QSTR(MP_QSTR_norm), MP_ROM_PTR(&linalg_norm_obj) },
+    { MP_ROM_QSTR(MP_QSTR_norm), ULAB_PROFILE_PTR(MP_QSTR_linalg, MP_QSTR_norm, linalg_norm_obj) },
     #endif
 };
 
@@ -21,7 +21,9 @@ extern const mp_obj_module_t ulab_linalg_module;
 MP_DECLARE_CONST_FUN_OBJ_1(linalg_cholesky_obj);
 MP_DECLARE_CONST_FUN_OBJ_1(linalg_det_obj);
 MP_DECLARE_CONST_FUN_OBJ_1(linalg_eig_obj);
+MP_DECLARE_CONST_FUN_OBJ_1(linalg_eigvalsh_obj);
 MP_DECLARE_CONST_FUN_OBJ_1(linalg_inv_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(linalg_norm_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(linalg_qr_obj);
+MP_DECLARE_CONST_FUN_OBJ_2(linalg_solve_obj);
 #endif
@@ -12,6 +12,7 @@
 #include <string.h>
 #include "py/runtime.h"
 
+#include "../../ulab_tools.h"
 #include "linalg_tools.h"
 
 /*
@@ -32,6 +33,7 @@ bool linalg_invert_matrix(mp_float_t *data, size_t N) {
     for(size_t m=0; m < N; m++) {
         memcpy(&unit[m * (N+1)], &elem, sizeof(mp_float_t));
     }
+    bool released = ulab_gil_exit(N * N * N);
     for(size_t m=0; m < N; m++){
         // this could be faster with ((c < epsilon) && (c > -epsilon))
         if(MICROPY_FLOAT_C_FUN(fabs)(data[m * (N+1)]) < LINALG_EPSILON) {
@@ -51,6 +53,7 @@ bool linalg_invert_matrix(mp_float_t *data, size_t N) {
                 }
             }
             if (m1 >= N) {
+                ulab_gil_enter(released);
                 m_del(mp_float_t, unit, N*N);
                 return false;
             }
@@ -73,98 +76,368 @@ bool linalg_invert_matrix(mp_float_t *data, size_t N) {
         }
     }
     memcpy(data, unit, sizeof(mp_float_t)*N*N);
+    ulab_gil_enter(released);
     m_del(mp_float_t, unit, N * N);
     return true;
 }
 
 /*
- * The following function calculates the eigenvalues and eigenvectors of a symmetric
- * real matrix, whose entries are given in the input array.
+ * The following function calculates the eigenvalues and, optionally, the eigenvectors of
+ * a symmetric real matrix, whose entries are given in the input array, V. The matrix is
+ * first reduced to tridiagonal form by Householder reflections, and the tridiagonal matrix is
+ * then diagonalised by the implicit QL algorithm, with Wilkinson shifts. The algorithm follows
+ * the EISPACK routines tred2, and tql2.
+ *
+ * On return, eigvalues holds the eigenvalues in ascending order. If vectors is true, the
+ * columns of V hold the corresponding normalised eigenvectors, otherwise, the content of V
+ * is undefined. The function returns false, if the QL iterations did not converge.
  * The function has no dependencies beyond micropython itself (for the definition of mp_float_t),
  * and can be used independent of ulab.
  */
 
-size_t linalg_jacobi_rotations(mp_float_t *array, mp_float_t *eigvectors, size_t S) {
-    // eigvectors should be a 0-array; start out with the unit matrix
-    for(size_t m=0; m < S; m++) {
-        eigvectors[m * (S+1)] = 1.0;
-    }
-    mp_float_t largest, w, t, c, s, tau, aMk, aNk, vm, vn;
-    size_t M, N;
-    size_t iterations = JACOBI_MAX * S * S;
-    do {
-        iterations--;
-        // find the pivot here
-        M = 0;
-        N = 0;
-        largest = 0.0;
-        for(size_t m=0; m < S-1; m++) { // -1: no need to inspect last row
-            for(size_t n=m+1; n < S; n++) {
-                w = MICROPY_FLOAT_C_FUN(fabs)(array[m * S + n]);
-                if((largest < w) && (LINALG_EPSILON < w)) {
-                    M = m;
-                    N = n;
-                    largest = w;
+static void linalg_householder_tridiagonal(mp_float_t *V, mp_float_t *d, mp_float_t *e, size_t S, bool vectors) {
+    // on return, d holds the diagonal, and e[1:] the sub-diagonal of the tridiagonal matrix
+    for(size_t j = 0; j < S; j++) {
+        d[j] = V[(S - 1) * S + j];
+    }
+
+    for(size_t i = S - 1; i > 0; i--) {
+        // scale the row to avoid under-, and overflow
+        mp_float_t scale = MICROPY_FLOAT_CONST(0.0);
+        mp_float_t h = MICROPY_FLOAT_CONST(0.0);
+        for(size_t k = 0; k < i; k++) {
+            scale += MICROPY_FLOAT_C_FUN(fabs)(d[k]);
+        }
+        if(scale == MICROPY_FLOAT_CONST(0.0)) {
+            e[i] = d[i - 1];
+            for(size_t j = 0; j < i; j++) {
+                d[j] = V[(i - 1) * S + j];
+                V[i * S + j] = MICROPY_FLOAT_CONST(0.0);
+                V[j * S + i] = MICROPY_FLOAT_CONST(0.0);
+            }
+        } else {
+            // generate the Householder vector
+            for(size_t k = 0; k < i; k++) {
+                d[k] /= scale;
+                h += d[k] * d[k];
+            }
+            mp_float_t f = d[i - 1];
+            mp_float_t g = MICROPY_FLOAT_C_FUN(sqrt)(h);
+            if(f > MICROPY_FLOAT_CONST(0.0)) {
+                g = -g;
+            }
+            e[i] = scale * g;
+            h = h - f * g;
+            d[i - 1] = f - g;
+            for(size_t j = 0; j < i; j++) {
+                e[j] = MICROPY_FLOAT_CONST(0.0);
+            }
+
+            // apply the similarity transformation to the remaining columns
+            for(size_t j = 0; j < i; j++) {
+                f = d[j];
+                V[j * S + i] = f;
+                g = e[j] + V[j * S + j] * f;
+                for(size_t k = j + 1; k < i; k++) {
+                    g += V[k * S + j] * d[k];
+                    e[k] += V[k * S + j] * f;
+                }
+                e[j] = g;
+            }
+            f = MICROPY_FLOAT_CONST(0.0);
+            for(size_t j = 0; j < i; j++) {
+                e[j] /= h;
+                f += e[j] * d[j];
+            }
+            mp_float_t hh = f / (h + h);
+            for(size_t j = 0; j < i; j++) {
+                e[j] -= hh * d[j];
+            }
+            for(size_t j = 0; j < i; j++) {
+                f = d[j];
+                g = e[j];
+                for(size_t k = j; k < i; k++) {
+                    V[k * S + j] -= (f * e[k] + g * d[k]);
+                }
+                d[j] = V[(i - 1) * S + j];
+                V[i * S + j] = MICROPY_FLOAT_CONST(0.0);
+            }
+        }
+        d[i] = h;
+    }
+
+    if(!vectors) {
+        // the diagonal of the tridiagonal matrix is left on the diagonal of V
+        for(size_t j = 0; j < S; j++) {
+            d[j] = V[j * (S + 1)];
+        }
+        e[0] = MICROPY_FLOAT_CONST(0.0);
+        return;
+    }
+
+    // accumulate the transformations
+    for(size_t i = 0; i < S - 1; i++) {
+        V[(S - 1) * S + i] = V[i * (S + 1)];
+        V[i * (S + 1)] = MICROPY_FLOAT_CONST(1.0);
+        mp_float_t h = d[i + 1];
+        if(h != MICROPY_FLOAT_CONST(0.0)) {
+            for(size_t k = 0; k <= i; k++) {
+                d[k] = V[k * S + i + 1] / h;
+            }
+            for(size_t j = 0; j <= i; j++) {
+                mp_float_t g = MICROPY_FLOAT_CONST(0.0);
+                for(size_t k = 0; k <= i; k++) {
+                    g += V[k * S + i + 1] * V[k * S + j];
+                }
+                for(size_t k = 0; k <= i; k++) {
+                    V[k * S + j] -= g * d[k];
+                }
+            }
+        }
+        for(size_t k = 0; k <= i; k++) {
+            V[k * S + i + 1] = MICROPY_FLOAT_CONST(0.0);
+        }
+    }
+    for(size_t j = 0; j < S; j++) {
+        d[j] = V[(S - 1) * S + j];
+        V[(S - 1) * S + j] = MICROPY_FLOAT_CONST(0.0);
+    }
+    V[S * S - 1] = MICROPY_FLOAT_CONST(1.0);
+    e[0] = MICROPY_FLOAT_CONST(0.0);
+}
+
+static bool linalg_tridiagonal_ql(mp_float_t *V, mp_float_t *d, mp_float_t *e, size_t S, bool vectors) {
+    for(size_t i = 1; i < S; i++) {
+        e[i - 1] = e[i];
+    }
+    e[S - 1] = MICROPY_FLOAT_CONST(0.0);
+
+    mp_float_t f = MICROPY_FLOAT_CONST(0.0);
+    mp_float_t tst1 = MICROPY_FLOAT_CONST(0.0);
+    for(size_t l = 0; l < S; l++) {
+        // find a small sub-diagonal element
+        mp_float_t t = MICROPY_FLOAT_C_FUN(fabs)(d[l]) + MICROPY_FLOAT_C_FUN(fabs)(e[l]);
+        if(tst1 < t) {
+            tst1 = t;
+        }
+        size_t m = l;
+        while(m < S - 1) {
+            if(MICROPY_FLOAT_C_FUN(fabs)(e[m]) <= LINALG_EPSILON * tst1) {
+                break;
+            }
+            m++;
+        }
+
+        // if m == l, d[l] is already an eigenvalue, otherwise, iterate
+        if(m > l) {
+            uint8_t iterations = 0;
+            do {
+                if(iterations++ == LINALG_QL_MAX_ITERATIONS) {
+                    return false;
+                }
+                // compute the implicit shift
+                mp_float_t g = d[l];
+                mp_float_t p = (d[l + 1] - g) / (MICROPY_FLOAT_CONST(2.0) * e[l]);
+                mp_float_t r = MICROPY_FLOAT_C_FUN(sqrt)(p * p + MICROPY_FLOAT_CONST(1.0));
+                if(p < MICROPY_FLOAT_CONST(0.0)) {
+                    r = -r;
+                }
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                mp_float_t dl1 = d[l + 1];
+                mp_float_t h = g - d[l];
+                for(size_t i = l + 2; i < S; i++) {
+                    d[i] -= h;
+                }
+                f += h;
+
+                // the implicit QL transformation
+                p = d[m];
+                mp_float_t c = MICROPY_FLOAT_CONST(1.0);
+                mp_float_t c2 = c;
+                mp_float_t c3 = c;
+                mp_float_t el1 = e[l + 1];
+                mp_float_t s = MICROPY_FLOAT_CONST(0.0);
+                mp_float_t s2 = MICROPY_FLOAT_CONST(0.0);
+                for(size_t i = m; i-- > l; ) {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = MICROPY_FLOAT_C_FUN(sqrt)(p * p + e[i] * e[i]);
+                    e[i + 1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i + 1] = h + s * (c * g + s * d[i]);
+
+                    if(vectors) {
+                        // the Givens rotation acts on the ith, and (i+1)th columns only
+                        for(size_t k = 0; k < S; k++) {
+                            h = V[k * S + i + 1];
+                            V[k * S + i + 1] = s * V[k * S + i] + c * h;
+                            V[k * S + i] = c * V[k * S + i] - s * h;
+                        }
+                    }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+            } while(MICROPY_FLOAT_C_FUN(fabs)(e[l]) > LINALG_EPSILON * tst1);
+        }
+        d[l] = d[l] + f;
+        e[l] = MICROPY_FLOAT_CONST(0.0);
+    }
+
+    // sort the eigenvalues, and the eigenvectors in ascending order
+    for(size_t i = 0; i < S - 1; i++) {
+        size_t k = i;
+        mp_float_t p = d[i];
+        for(size_t j = i + 1; j < S; j++) {
+            if(d[j] < p) {
+                k = j;
+                p = d[j];
+            }
+        }
+        if(k != i) {
+            d[k] = d[i];
+            d[i] = p;
+            if(vectors) {
+                for(size_t j = 0; j < S; j++) {
+                    p = V[j * S + i];
+                    V[j * S + i] = V[j * S + k];
+                    V[j * S + k] = p;
                 }
             }
         }
-        if(M + N == 0) { // all entries are smaller than epsilon, there is not much we can do...
+    }
+    return true;
+}
+
+bool linalg_symmetric_eigen(mp_float_t *V, mp_float_t *eigvalues, size_t S, bool vectors) {
+    if(S == 0) {
+        return true;
+    }
+    // the off-diagonal of the tridiagonal matrix
+    mp_float_t *e = m_new0(mp_float_t, S);
+    bool released = ulab_gil_exit(S * S * S);
+    linalg_householder_tridiagonal(V, eigvalues, e, S, vectors);
+    bool converged = linalg_tridiagonal_ql(V, eigvalues, e, S, vectors);
+    ulab_gil_enter(released);
+    m_del(mp_float_t, e, S);
+    return converged;
+}
+
+/*
+ * The following function computes the LU decomposition of a matrix with partial pivoting,
+ * P A = L U, in place. On return, the strictly lower triangle of data holds L (whose diagonal
+ * is 1, and is not stored), and the upper triangle holds U. As in LAPACK, the kth row was
+ * interchanged with row pivots[k].
+ * The function has no dependencies beyond micropython itself (for the definition of mp_float_t),
+ * and can be used independent of ulab.
+ */
+
+bool linalg_lu_decompose(mp_float_t *data, uint16_t *pivots, size_t N) {
+    // returns true, if the decomposition was successful,
+    // false, if the matrix is singular
+    bool released = ulab_gil_exit(N * N * N);
+    bool regular = true;
+    for(size_t k=0; k < N; k++) {
+        // find the largest element in the kth column, on, or below the diagonal
+        size_t p = k;
+        mp_float_t largest = MICROPY_FLOAT_C_FUN(fabs)(data[k * N + k]);
+        for(size_t i=k+1; i < N; i++) {
+            mp_float_t value = MICROPY_FLOAT_C_FUN(fabs)(data[i * N + k]);
+            if(value > largest) {
+                largest = value;
+                p = i;
+            }
+        }
+        if(largest < LINALG_EPSILON) {
+            regular = false;
             break;
         }
-        // at this point, we have the pivot, and it is the entry (M, N)
-        // now we have to find the rotation angle
-        w = (array[N * S + N] - array[M * S + M]) / (MICROPY_FLOAT_CONST(2.0)*array[M * S + N]);
-        // The following if/else chooses the smaller absolute value for the tangent
-        // of the rotation angle. Going with the smaller should be numerically stabler.
-        if(w > 0) {
-            t = MICROPY_FLOAT_C_FUN(sqrt)(w*w + MICROPY_FLOAT_CONST(1.0)) - w;
-        } else {
-            t = MICROPY_FLOAT_CONST(-1.0)*(MICROPY_FLOAT_C_FUN(sqrt)(w*w + MICROPY_FLOAT_CONST(1.0)) + w);
-        }
-        s = t / MICROPY_FLOAT_C_FUN(sqrt)(t*t + MICROPY_FLOAT_CONST(1.0)); // the sine of the rotation angle
-        c = MICROPY_FLOAT_CONST(1.0) / MICROPY_FLOAT_C_FUN(sqrt)(t*t + MICROPY_FLOAT_CONST(1.0)); // the cosine of the rotation angle
-        tau = (MICROPY_FLOAT_CONST(1.0)-c)/s; // this is equal to the tangent of the half of the rotation angle
-
-        // at this point, we have the rotation angles, so we can transform the matrix
-        // first the two diagonal elements
-        // a(M, M) = a(M, M) - t*a(M, N)
-        array[M * S + M] = array[M * S + M] - t * array[M * S + N];
-        // a(N, N) = a(N, N) + t*a(M, N)
-        array[N * S + N] = array[N * S + N] + t * array[M * S + N];
-        // after the rotation, the a(M, N), and a(N, M) entries should become zero
-        array[M * S + N] = array[N * S + M] = MICROPY_FLOAT_CONST(0.0);
-        // then all other elements in the column
-        for(size_t k=0; k < S; k++) {
-            if((k == M) || (k == N)) {
-                continue;
-            }
-            aMk = array[M * S + k];
-            aNk = array[N * S + k];
-            // a(M, k) = a(M, k) - s*(a(N, k) + tau*a(M, k))
-            array[M * S + k] -= s * (aNk + tau * aMk);
-            // a(N, k) = a(N, k) + s*(a(M, k) - tau*a(N, k))
-            array[N * S + k] += s * (aMk - tau * aNk);
-            // a(k, M) = a(M, k)
-            array[k * S + M] = array[M * S + k];
-            // a(k, N) = a(N, k)
-            array[k * S + N] = array[N * S + k];
-        }
-        // now we have to update the eigenvectors
-        // the rotation matrix, R, multiplies from the right
-        // R is the unit matrix, except for the
-        // R(M,M) = R(N, N) = c
-        // R(N, M) = s
-        // (M, N) = -s
-        // entries. This means that only the Mth, and Nth columns will change
-        for(size_t m=0; m < S; m++) {
-            vm = eigvectors[m * S + M];
-            vn = eigvectors[m * S + N];
-            // the new value of eigvectors(m, M)
-            eigvectors[m * S + M] = c * vm - s * vn;
-            // the new value of eigvectors(m, N)
-            eigvectors[m * S + N] = s * vm + c * vn;
-        }
-    } while(iterations > 0);
-
-    return iterations;
+        pivots[k] = (uint16_t)p;
+        if(p != k) {
+            for(size_t j=0; j < N; j++) {
+                mp_float_t swapVal = data[k * N + j];
+                data[k * N + j] = data[p * N + j];
+                data[p * N + j] = swapVal;
+            }
+        }
+        for(size_t i=k+1; i < N; i++) {
+            mp_float_t c = data[i * N + k] / data[k * N + k];
+            data[i * N + k] = c;
+            for(size_t j=k+1; j < N; j++) {
+                data[i * N + j] -= c * data[k * N + j];
+            }
+        }
+    }
+    ulab_gil_enter(released);
+    return regular;
+}
+
+void linalg_lu_substitute(mp_float_t *data, uint16_t *pivots, size_t N, mp_float_t *b) {
+    // solves L U x = P b with the output of linalg_lu_decompose, and overwrites b with x
+    for(size_t k=0; k < N; k++) {
+        if(pivots[k] != k) {
+            mp_float_t swapVal = b[k];
+            b[k] = b[pivots[k]];
+            b[pivots[k]] = swapVal;
+        }
+    }
+    // forward substitution with the unit lower triangular L
+    for(size_t i=0; i < N; i++) {
+        mp_float_t sum = b[i];
+        for(size_t j=0; j < i; j++) {
+            sum -= data[i * N + j] * b[j];
+        }
+        b[i] = sum;
+    }
+    // backward substitution with U
+    for(size_t i=N; i > 0; i--) {
+        mp_float_t sum = b[i - 1];
+        for(size_t j=i; j < N; j++) {
+            sum -= data[(i - 1) * N + j] * b[j];
+        }
+        b[i - 1] = sum / data[(i - 1) * N + (i - 1)];
+    }
+}
+
+ndarray_obj_t *linalg_lu_solve_ndarray(mp_float_t *data, uint16_t *pivots, size_t N, ndarray_obj_t *b) {
+    // solves the system for each column of b, which can be a vector of length N,
+    // or a matrix of shape (N, K), and returns the solution in a new float array of the same shape
+    if(b->shape[ULAB_MAX_DIMS - b->ndim] != N) {
+        mp_raise_ValueError(MP_ERROR_TEXT("dimensions do not match"));
+    }
+    #if ULAB_MAX_DIMS > 1
+    if(b->ndim > 2) {
+        mp_raise_ValueError(MP_ERROR_TEXT("right hand side must be a vector, or a matrix"));
+    }
+    #endif
+    size_t K = b->ndim == 1 ? 1 : b->shape[ULAB_MAX_DIMS - 1];
+    int32_t rstride = b->strides[ULAB_MAX_DIMS - b->ndim];
+    int32_t cstride = b->ndim == 1 ? 0 : b->strides[ULAB_MAX_DIMS - 1];
+
+    ndarray_obj_t *x = ndarray_new_dense_ndarray(b->ndim, b->shape, NDARRAY_FLOAT);
+    mp_float_t *xarray = (mp_float_t *)x->array;
+    mp_float_t *column = m_new(mp_float_t, N);
+    mp_float_t (*func)(void *) = ndarray_get_float_function(b->dtype);
+
+    bool released = ulab_gil_exit(N * N * K);
+    for(size_t k=0; k < K; k++) {
+        uint8_t *barray = (uint8_t *)b->array + k * cstride;
+        for(size_t i=0; i < N; i++) {
+            column[i] = func(barray);
+            barray += rstride;
+        }
+        linalg_lu_substitute(data, pivots, N, column);
+        for(size_t i=0; i < N; i++) {
+            xarray[i * K + k] = column[i];
+        }
+    }
+    ulab_gil_enter(released);
+    m_del(mp_float_t, column, N);
+    return x;
 }
@@ -11,6 +11,8 @@
 #ifndef _TOOLS_TOOLS_
 #define _TOOLS_TOOLS_
 
+#include "../../ndarray.h"
+
 #ifndef LINALG_EPSILON
 #if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT
 #define LINALG_EPSILON      MICROPY_FLOAT_CONST(1.2e-7)
@@ -19,10 +21,14 @@
 #endif
 #endif /* LINALG_EPSILON */
 
-#define JACOBI_MAX     20
+// the maximum number of QL iterations per eigenvalue
+#define LINALG_QL_MAX_ITERATIONS    30
 
 bool linalg_invert_matrix(mp_float_t *, size_t );
-size_t linalg_jacobi_rotations(mp_float_t *, mp_float_t *, size_t );
+bool linalg_symmetric_eigen(mp_float_t *, mp_float_t *, size_t , bool );
+bool linalg_lu_decompose(mp_float_t *, uint16_t *, size_t );
+void linalg_lu_substitute(mp_float_t *, uint16_t *, size_t , mp_float_t *);
+ndarray_obj_t *linalg_lu_solve_ndarray(mp_float_t *, uint16_t *, size_t , ndarray_obj_t *);
 
 #endif /* _TOOLS_TOOLS_ */
 
@@ -22,7 +22,9 @@
 
 #include "../ulab.h"
 #include "../ulab_tools.h"
+#include "../ulab_parallel.h"
 #include "./carray/carray_tools.h"
+#include "./sort/sort_tools.h"
 #include "numerical.h"
 
 enum NUMERICAL_FUNCTION_TYPE {
@@ -30,6 +32,9 @@ enum NUMERICAL_FUNCTION_TYPE {
     NUMERICAL_ANY,
     NUMERICAL_ARGMAX,
     NUMERICAL_ARGMIN,
+    NUMERICAL_CUMPROD,
+    NUMERICAL_CUMSUM,
+    NUMERICAL_CUMULATIVE_TRAPEZOID,
     NUMERICAL_MAX,
     NUMERICAL_MEAN,
     NUMERICAL_MIN,
@@ -90,6 +95,27 @@ static void numerical_reduce_axes(ndarray_obj_t *ndarray, int8_t axis, size_t *s
     }
 }
 
+#if ULAB_NUMPY_HAS_SUM | ULAB_NUMPY_HAS_MEAN | ULAB_NUMPY_HAS_STD | ULAB_NUMPY_HAS_ARGMINMAX
+static bool numerical_reduce_rows(ndarray_obj_t *ndarray, int8_t ax, size_t *outer, size_t *inner) {
+    // returns true, if the array is contiguous, and the reduced axis is not the last one, i.e.,
+    // if the reduction can proceed row by row; outer, and inner are given in units of the rows
+    if((ax == ndarray->ndim - 1) || !ndarray_is_contiguous(ndarray)) {
+        return false;
+    }
+    *outer = 1;
+    *inner = 1;
+    for(uint8_t d = 0; d < ndarray->ndim; d++) {
+        size_t length = ndarray->shape[ULAB_MAX_DIMS - ndarray->ndim + d];
+        if(d < ax) {
+            *outer *= length;
+        } else if(d > ax) {
+            *inner *= length;
+        }
+    }
+    return true;
+}
+#endif
+
 #if ULAB_NUMPY_HAS_ALL | ULAB_NUMPY_HAS_ANY
 static mp_obj_t numerical_all_any(mp_obj_t oin, mp_obj_t axis, uint8_t optype) {
     bool anytype = optype == NUMERICAL_ALL ? 1 : 0;
@@ -246,6 +272,326 @@ static mp_obj_t numerical_all_any(mp_obj_t oin, mp_obj_t axis, uint8_t optype) {
 #endif
 
 #if ULAB_NUMPY_HAS_SUM | ULAB_NUMPY_HAS_MEAN | ULAB_NUMPY_HAS_STD
+// Returns the sum of (x - shift), or, if squared is set, of (x - shift)^2 over a strided lane.
+// By default, the lane is halved recursively, until it is shorter than NUMERICAL_PAIRWISE_BLOCK,
+// and the blocks are summed with eight independent accumulators. This bounds the rounding error
+// by O(log(len)), instead of O(len), at practically the cost of the naive loop.
+#if ULAB_NUMPY_SUM_USES_KAHAN
+#define NUMERICAL_SUM_FUNCTION(type)\
+static mp_float_t numerical_sum_##type(uint8_t *array, int32_t stride, size_t len, mp_float_t shift, uint8_t squared) {\
+    mp_float_t sum = MICROPY_FLOAT_CONST(0.0), c = MICROPY_FLOAT_CONST(0.0);\
+    for(size_t i = 0; i < len; i++) {\
+        mp_float_t value = (mp_float_t)(*(type *)array) - shift;\
+        if(squared) {\
+            value *= value;\
+        }\
+        mp_float_t y = value - c;\
+        mp_float_t t = sum + y;\
+        c = (t - sum) - y;\
+        sum = t;\
+        array += stride;\
+    }\
+    return sum;\
+}
+#else
+#define NUMERICAL_SUM_FUNCTION(type)\
+static mp_float_t numerical_sum_##type(uint8_t *array, int32_t stride, size_t len, mp_float_t shift, uint8_t squared) {\
+    if(len > NUMERICAL_PAIRWISE_BLOCK) {\
+        size_t half = (len / 2) & ~(size_t)7;\
+        return numerical_sum_##type(array, stride, half, shift, squared) +\
+                numerical_sum_##type(array + half * stride, stride, len - half, shift, squared);\
+    }\
+    mp_float_t r[8] = { MICROPY_FLOAT_CONST(0.0) };\
+    size_t i = 0;\
+    for(; i + 8 <= len; i += 8) {\
+        for(uint8_t j = 0; j < 8; j++) {\
+            mp_float_t value = (mp_float_t)(*(type *)array) - shift;\
+            r[j] += squared ? value * value : value;\
+            array += stride;\
+        }\
+    }\
+    mp_float_t sum = ((r[0] + r[1]) + (r[2] + r[3])) + ((r[4] + r[5]) + (r[6] + r[7]));\
+    for(; i < len; i++) {\
+        mp_float_t value = (mp_float_t)(*(type *)array) - shift;\
+        sum += squared ? value * value : value;\
+        array += stride;\
+    }\
+    return sum;\
+}
+#endif
+
+NUMERICAL_SUM_FUNCTION(uint8_t)
+NUMERICAL_SUM_FUNCTION(int8_t)
+NUMERICAL_SUM_FUNCTION(uint16_t)
+NUMERICAL_SUM_FUNCTION(int16_t)
+#if ULAB_SUPPORTS_INT32
+NUMERICAL_SUM_FUNCTION(int32_t)
+NUMERICAL_SUM_FUNCTION(uint32_t)
+#endif
+NUMERICAL_SUM_FUNCTION(mp_float_t)
+
+static mp_float_t numerical_sum_lane(uint8_t dtype, uint8_t *array, int32_t stride, size_t len, mp_float_t shift, uint8_t squared) {
+    if(dtype == NDARRAY_UINT8) {
+        return numerical_sum_uint8_t(array, stride, len, shift, squared);
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {
+        return numerical_sum_int8_t(array, stride, len, shift, squared);
+    } else if(dtype == NDARRAY_UINT16) {
+        return numerical_sum_uint16_t(array, stride, len, shift, squared);
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {
+        return numerical_sum_int16_t(array, stride, len, shift, squared);
+    }
+    #if ULAB_SUPPORTS_INT32
+    else if(dtype == NDARRAY_INT32) {
+        return numerical_sum_int32_t(array, stride, len, shift, squared);
+    } else if(dtype == NDARRAY_UINT32) {
+        return numerical_sum_uint32_t(array, stride, len, shift, squared);
+    }
+    #endif
+    else {
+        return numerical_sum_mp_float_t(array, stride, len, shift, squared);
+    }
+}
+
+// adds n rows of length inner to sum with compensation in c; if shift is not NULL,
+// the squares of the deviations from shift are added instead
+#define NUMERICAL_SUM_ROWS_FUNCTION(type)\
+static void numerical_sum_rows_##type(uint8_t *array, size_t n, size_t inner, mp_float_t *sum, mp_float_t *c, const mp_float_t *shift) {\
+    type *_array = (type *)array;\
+    for(size_t i = 0; i < n; i++) {\
+        if(shift == NULL) {\
+            for(size_t j = 0; j < inner; j++) {\
+                mp_float_t y = (mp_float_t)_array[j] - c[j];\
+                mp_float_t t = sum[j] + y;\
+                c[j] = (t - sum[j]) - y;\
+                sum[j] = t;\
+            }\
+        } else {\
+            for(size_t j = 0; j < inner; j++) {\
+                mp_float_t value = (mp_float_t)_array[j] - shift[j];\
+                mp_float_t y = value * value - c[j];\
+                mp_float_t t = sum[j] + y;\
+                c[j] = (t - sum[j]) - y;\
+                sum[j] = t;\
+            }\
+        }\
+        _array += inner;\
+    }\
+}
+
+NUMERICAL_SUM_ROWS_FUNCTION(uint8_t)
+NUMERICAL_SUM_ROWS_FUNCTION(int8_t)
+NUMERICAL_SUM_ROWS_FUNCTION(uint16_t)
+NUMERICAL_SUM_ROWS_FUNCTION(int16_t)
+#if ULAB_SUPPORTS_INT32
+NUMERICAL_SUM_ROWS_FUNCTION(int32_t)
+NUMERICAL_SUM_ROWS_FUNCTION(uint32_t)
+#endif
+NUMERICAL_SUM_ROWS_FUNCTION(mp_float_t)
+
+static void numerical_sum_rows(uint8_t dtype, uint8_t *array, size_t n, size_t inner, mp_float_t *sum, mp_float_t *c, const mp_float_t *shift) {
+    if(dtype == NDARRAY_UINT8) {
+        numerical_sum_rows_uint8_t(array, n, inner, sum, c, shift);
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {
+        numerical_sum_rows_int8_t(array, n, inner, sum, c, shift);
+    } else if(dtype == NDARRAY_UINT16) {
+        numerical_sum_rows_uint16_t(array, n, inner, sum, c, shift);
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {
+        numerical_sum_rows_int16_t(array, n, inner, sum, c, shift);
+    }
+    #if ULAB_SUPPORTS_INT32
+    else if(dtype == NDARRAY_INT32) {
+        numerical_sum_rows_int32_t(array, n, inner, sum, c, shift);
+    } else if(dtype == NDARRAY_UINT32) {
+        numerical_sum_rows_uint32_t(array, n, inner, sum, c, shift);
+    }
+    #endif
+    else {
+        numerical_sum_rows_mp_float_t(array, n, inner, sum, c, shift);
+    }
+}
+
+static void numerical_sum_mean_std_rows(ndarray_obj_t *ndarray, mp_float_t *farray, size_t outer, size_t n, size_t inner, uint8_t optype, mp_float_t div) {
+    // the sum, mean, or standard deviation of a contiguous array along an axis other than the last one
+    mp_float_t *c = m_new(mp_float_t, 2 * inner);
+    mp_float_t *S = c + inner;
+    uint8_t *array = (uint8_t *)ndarray->array;
+    for(size_t o = 0; o < outer; o++) {
+        memset(c, 0, inner * sizeof(mp_float_t));
+        numerical_sum_rows(ndarray->dtype, array, n, inner, farray, c, NULL);
+        if(optype != NUMERICAL_SUM) {
+            for(size_t j = 0; j < inner; j++) {
+                farray[j] /= (mp_float_t)n;
+            }
+        }
+        if(optype == NUMERICAL_STD) {
+            memset(c, 0, 2 * inner * sizeof(mp_float_t));
+            numerical_sum_rows(ndarray->dtype, array, n, inner, S, c, farray);
+            for(size_t j = 0; j < inner; j++) {
+                farray[j] = MICROPY_FLOAT_C_FUN(sqrt)(S[j] / div);
+            }
+        }
+        array += n * inner * ndarray->itemsize;
+        farray += inner;
+    }
+    m_del(mp_float_t, c, 2 * inner);
+}
+
+#if ULAB_HAS_PARALLEL
+// the state of the sum of a contiguous array; each core writes its own partial sum
+typedef struct _numerical_sum_t {
+    uint8_t *array;
+    int32_t stride;
+    mp_float_t shift;
+    uint8_t dtype;
+    uint8_t squared;
+    mp_float_t sum[ULAB_PARALLEL_CORES];
+} numerical_sum_t;
+
+static void numerical_sum_kernel(void *context, size_t start, size_t end, uint8_t core) {
+    numerical_sum_t *sum = (numerical_sum_t *)context;
+    sum->sum[core] = numerical_sum_lane(sum->dtype, sum->array + start * sum->stride, sum->stride, end - start, sum->shift, sum->squared);
+}
+#endif /* ULAB_HAS_PARALLEL */
+
+static mp_float_t numerical_sum_flattened(ndarray_obj_t *ndarray, uint8_t *array, mp_float_t shift, uint8_t squared) {
+    // sums the lanes along the last axis, and adds the partial sums with compensation;
+    // for complex arrays, array points to either the real, or the imaginary part of the first element
+    mp_float_t sum = MICROPY_FLOAT_CONST(0.0), c = MICROPY_FLOAT_CONST(0.0);
+
+    #if ULAB_HAS_PARALLEL
+    if((ndarray->len >= ULAB_PARALLEL_THRESHOLD) && ndarray_is_contiguous(ndarray)) {
+        // the array is a single lane, whose halves can be summed on separate cores
+        numerical_sum_t partial = {
+            .array = array,
+            .stride = ndarray->itemsize,
+            .shift = shift,
+            .dtype = ndarray->dtype,
+            .squared = squared,
+            .sum = { MICROPY_FLOAT_CONST(0.0) },
+        };
+        ulab_parallel_for(numerical_sum_kernel, &partial, ndarray->len, 1);
+        for(uint8_t i = 0; i < ULAB_PARALLEL_CORES; i++) {
+            sum += partial.sum[i];
+        }
+        return sum;
+    }
+    #endif
+
+    #if ULAB_MAX_DIMS > 3
+    size_t i = 0;
+    do {
+    #endif
+        #if ULAB_MAX_DIMS > 2
+        size_t j = 0;
+        do {
+        #endif
+            #if ULAB_MAX_DIMS > 1
+            size_t k = 0;
+            do {
+            #endif
+                mp_float_t y = numerical_sum_lane(ndarray->dtype, array, ndarray->strides[ULAB_MAX_DIMS - 1],
+                                                ndarray->shape[ULAB_MAX_DIMS - 1], shift, squared) - c;
+                mp_float_t t = sum + y;
+                c = (t - sum) - y;
+                sum = t;
+            #if ULAB_MAX_DIMS > 1
+                array += ndarray->strides[ULAB_MAX_DIMS - 2];
+                k++;
+            } while(k < ndarray->shape[ULAB_MAX_DIMS - 2]);
+            #endif
+        #if ULAB_MAX_DIMS > 2
+            array -= ndarray->strides[ULAB_MAX_DIMS - 2] * ndarray->shape[ULAB_MAX_DIMS - 2];
+            array += ndarray->strides[ULAB_MAX_DIMS - 3];
+            j++;
+        } while(j < ndarray->shape[ULAB_MAX_DIMS - 3]);
+        #endif
+    #if ULAB_MAX_DIMS > 3
+        array -= ndarray->strides[ULAB_MAX_DIMS - 3] * ndarray->shape[ULAB_MAX_DIMS - 3];
+        array += ndarray->strides[ULAB_MAX_DIMS - 4];
+        i++;
+    } while(i < ndarray->shape[ULAB_MAX_DIMS - 4]);
+    #endif
+    return sum;
+}
+
+#if ULAB_SUPPORTS_INT32
+// With the 32-bit integer types, the sums of integer arrays are exact: the flattened sum is
+// accumulated in int64_t, and the sums along an axis are promoted to int32, or uint32.
+#define NUMERICAL_SUM_ACCUMULATOR(type, wide)   wide
+
+#define NUMERICAL_INTEGER_SUM_FUNCTION(type)\
+static int64_t numerical_integer_sum_##type(uint8_t *array, int32_t stride, size_t len) {\
+    int64_t sum = 0;\
+    for(size_t i = 0; i < len; i++) {\
+        sum += *((type *)array);\
+        array += stride;\
+    }\
+    return sum;\
+}
+
+NUMERICAL_INTEGER_SUM_FUNCTION(uint8_t)
+NUMERICAL_INTEGER_SUM_FUNCTION(int8_t)
+NUMERICAL_INTEGER_SUM_FUNCTION(uint16_t)
+NUMERICAL_INTEGER_SUM_FUNCTION(int16_t)
+NUMERICAL_INTEGER_SUM_FUNCTION(int32_t)
+NUMERICAL_INTEGER_SUM_FUNCTION(uint32_t)
+
+static int64_t numerical_integer_sum_lane(uint8_t dtype, uint8_t *array, int32_t stride, size_t len) {
+    if(dtype == NDARRAY_UINT8) {
+        return numerical_integer_sum_uint8_t(array, stride, len);
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {
+        return numerical_integer_sum_int8_t(array, stride, len);
+    } else if(dtype == NDARRAY_UINT16) {
+        return numerical_integer_sum_uint16_t(array, stride, len);
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {
+        return numerical_integer_sum_int16_t(array, stride, len);
+    } else if(dtype == NDARRAY_INT32) {
+        return numerical_integer_sum_int32_t(array, stride, len);
+    } else {
+        return numerical_integer_sum_uint32_t(array, stride, len);
+    }
+}
+
+static int64_t numerical_integer_sum_flattened(ndarray_obj_t *ndarray) {
+    uint8_t *array = (uint8_t *)ndarray->array;
+    int64_t sum = 0;
+    #if ULAB_MAX_DIMS > 3
+    size_t i = 0;
+    do {
+    #endif
+        #if ULAB_MAX_DIMS > 2
+        size_t j = 0;
+        do {
+        #endif
+            #if ULAB_MAX_DIMS > 1
+            size_t k = 0;
+            do {
+            #endif
+                sum += numerical_integer_sum_lane(ndarray->dtype, array, ndarray->strides[ULAB_MAX_DIMS - 1],
+                                                ndarray->shape[ULAB_MAX_DIMS - 1]);
+            #if ULAB_MAX_DIMS > 1
+                array += ndarray->strides[ULAB_MAX_DIMS - 2];
+                k++;
+            } while(k < ndarray->shape[ULAB_MAX_DIMS - 2]);
+            #endif
+        #if ULAB_MAX_DIMS > 2
+            array -= ndarray->strides[ULAB_MAX_DIMS - 2] * ndarray->shape[ULAB_MAX_DIMS - 2];
+            array += ndarray->strides[ULAB_MAX_DIMS - 3];
+            j++;
+        } while(j < ndarray->shape[ULAB_MAX_DIMS - 3]);
+        #endif
+    #if ULAB_MAX_DIMS > 3
+        array -= ndarray->strides[ULAB_MAX_DIMS - 3] * ndarray->shape[ULAB_MAX_DIMS - 3];
+        array += ndarray->strides[ULAB_MAX_DIMS - 4];
+        i++;
+    } while(i < ndarray->shape[ULAB_MAX_DIMS - 4]);
+    #endif
+    return sum;
+}
+#else
+#define NUMERICAL_SUM_ACCUMULATOR(type, wide)   type
+#endif /* ULAB_SUPPORTS_INT32 */
+
 static mp_obj_t numerical_sum_mean_std_iterable(mp_obj_t oin, uint8_t optype, size_t ddof) {
     mp_float_t value = MICROPY_FLOAT_CONST(0.0);
     mp_float_t M = MICROPY_FLOAT_CONST(0.0);
@@ -272,10 +618,77 @@ static mp_obj_t numerical_sum_mean_std_iterable(mp_obj_t oin, uint8_t optype, si
     }
 }
 
+#if ULAB_SUPPORTS_COMPLEX
+static mp_obj_t numerical_sum_mean_complex(ndarray_obj_t *ndarray, shape_strides _shape_strides, mp_obj_t axis, uint8_t optype) {
+    // the real and imaginary parts are reduced as two float arrays sharing the strides of the complex array
+    uint8_t *array = (uint8_t *)ndarray->array;
+    if(axis == mp_const_none) {
+        mp_float_t real = numerical_sum_flattened(ndarray, array, MICROPY_FLOAT_CONST(0.0), 0);
+        mp_float_t imag = numerical_sum_flattened(ndarray, array + sizeof(mp_float_t), MICROPY_FLOAT_CONST(0.0), 0);
+        if(optype == NUMERICAL_MEAN) {
+            mp_float_t len = ndarray->len > 0 ? (mp_float_t)ndarray->len : MICROPY_FLOAT_CONST(1.0);
+            real /= len;
+            imag /= len;
+        }
+        return mp_obj_new_complex(real, imag);
+    }
+    ndarray_obj_t *results = ndarray_new_dense_ndarray(_shape_strides.ndim, _shape_strides.shape, NDARRAY_COMPLEX);
+    mp_float_t *scratch = m_new(mp_float_t, 2 * results->len);
+    mp_float_t *farray = scratch;
+    RUN_MEAN_STD(mp_float_t, array, farray, _shape_strides, MICROPY_FLOAT_CONST(0.0), 0);
+    array = (uint8_t *)ndarray->array + sizeof(mp_float_t);
+    RUN_MEAN_STD(mp_float_t, array, farray, _shape_strides, MICROPY_FLOAT_CONST(0.0), 0);
+
+    mp_float_t norm = optype == NUMERICAL_SUM ? (mp_float_t)_shape_strides.shape[0] : MICROPY_FLOAT_CONST(1.0);
+    mp_float_t *rarray = (mp_float_t *)results->array;
+    for(size_t i = 0; i < results->len; i++) {
+        *rarray++ = scratch[i] * norm;
+        *rarray++ = scratch[results->len + i] * norm;
+    }
+    m_del(mp_float_t, scratch, 2 * results->len);
+    if(results->ndim == 0) {
+        rarray = (mp_float_t *)results->array;
+        return mp_obj_new_complex(rarray[0], rarray[1]);
+    }
+    return MP_OBJ_FROM_PTR(results);
+}
+#endif
+
+static uint8_t numerical_sum_dtype(uint8_t dtype) {
+    // the dtype of the sum along an axis
+    #if ULAB_SUPPORTS_INT32
+    // numpy promotes the output to the highest integer type
+    if((dtype == NDARRAY_UINT8) || (dtype == NDARRAY_UINT16)) {
+        return NDARRAY_UINT32;
+    } else if(ULAB_DTYPE_IS(dtype, INT8) || ULAB_DTYPE_IS(dtype, INT16)) {
+        return NDARRAY_INT32;
+    }
+    #endif
+    #if ULAB_SUPPORTS_FLOAT16
+    if(dtype == NDARRAY_FLOAT16) {
+        return NDARRAY_FLOAT;
+    }
+    #endif
+    return dtype;
+}
+
 static mp_obj_t numerical_sum_mean_std_ndarray(ndarray_obj_t *ndarray, mp_obj_t axis, uint8_t optype, size_t ddof) {
-    COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+    #if ULAB_SUPPORTS_FLOAT16
+    if(ndarray->dtype == NDARRAY_FLOAT16) {
+        // half-precision floats are summed in mp_float_t
+        ndarray = ndarray_copy_view_convert_type(ndarray, NDARRAY_FLOAT);
+    }
+    #endif
     uint8_t *array = (uint8_t *)ndarray->array;
     shape_strides _shape_strides = tools_reduce_axes(ndarray, axis);
+    #if ULAB_SUPPORTS_COMPLEX
+    if(ndarray->dtype == NDARRAY_COMPLEX) {
+        if(optype == NUMERICAL_STD) {
+            raise_complex_NotImplementedError();
+        }
+        return numerical_sum_mean_complex(ndarray, _shape_strides, axis, optype);
+    }
+    #endif
 
     if(axis == mp_const_none) {
         // work with the flattened array
@@ -283,66 +696,25 @@ static mp_obj_t numerical_sum_mean_std_ndarray(ndarray_obj_t *ndarray, mp_obj_t
             // if there are too many degrees of freedom, there is no point in calculating anything
             return mp_obj_new_float(MICROPY_FLOAT_CONST(0.0));
         }
-        mp_float_t (*func)(void *) = ndarray_get_float_function(ndarray->dtype);
-        mp_float_t M = MICROPY_FLOAT_CONST(0.0);
-        mp_float_t m = MICROPY_FLOAT_CONST(0.0);
-        mp_float_t S = MICROPY_FLOAT_CONST(0.0);
-        mp_float_t s = MICROPY_FLOAT_CONST(0.0);
-        size_t count = 0;
-
-        #if ULAB_MAX_DIMS > 3
-        size_t i = 0;
-        do {
-        #endif
-            #if ULAB_MAX_DIMS > 2
-            size_t j = 0;
-            do {
-            #endif
-                #if ULAB_MAX_DIMS > 1
-                size_t k = 0;
-                do {
-                #endif
-                    size_t l = 0;
-                    do {
-                        count++;
-                        mp_float_t value = func(array);
-                        m = M + (value - M) / (mp_float_t)count;
-                        if(optype == NUMERICAL_STD) {
-                            s = S + (value - M) * (value - m);
-                            S = s;
-                        }
-                        M = m;
-                        array += _shape_strides.strides[ULAB_MAX_DIMS - 1];
-                        l++;
-                    } while(l < _shape_strides.shape[ULAB_MAX_DIMS - 1]);
-                #if ULAB_MAX_DIMS > 1
-                    array -= _shape_strides.strides[ULAB_MAX_DIMS - 1] * _shape_strides.shape[ULAB_MAX_DIMS - 1];
-                    array += _shape_strides.strides[ULAB_MAX_DIMS - 2];
-                    k++;
-                } while(k < _shape_strides.shape[ULAB_MAX_DIMS - 2]);
-                #endif
-            #if ULAB_MAX_DIMS > 2
-                array -= _shape_strides.strides[ULAB_MAX_DIMS - 2] * _shape_strides.shape[ULAB_MAX_DIMS - 2];
-                array += _shape_strides.strides[ULAB_MAX_DIMS - 3];
-                j++;
-            } while(j < _shape_strides.shape[ULAB_MAX_DIMS - 3]);
-            #endif
-        #if ULAB_MAX_DIMS > 3
-            array -= _shape_strides.strides[ULAB_MAX_DIMS - 3] * _shape_strides.shape[ULAB_MAX_DIMS - 3];
-            array += _shape_strides.strides[ULAB_MAX_DIMS - 4];
-            i++;
-        } while(i < _shape_strides.shape[ULAB_MAX_DIMS - 4]);
+        #if ULAB_SUPPORTS_INT32
+        if((optype == NUMERICAL_SUM) && (ndarray->dtype != NDARRAY_FLOAT)) {
+            return mp_obj_new_int_from_ll(ndarray->len > 0 ? numerical_integer_sum_flattened(ndarray) : 0);
+        }
         #endif
+        mp_float_t sum = numerical_sum_flattened(ndarray, array, MICROPY_FLOAT_CONST(0.0), 0);
         if(optype == NUMERICAL_SUM) {
             // numpy returns an integer for integer input types
             if(ndarray->dtype == NDARRAY_FLOAT) {
-                return mp_obj_new_float(M * ndarray->len);
+                return mp_obj_new_float(sum);
             } else {
-                return mp_obj_new_int((int32_t)MICROPY_FLOAT_C_FUN(round)(M * ndarray->len));
+                return mp_obj_new_int((int32_t)MICROPY_FLOAT_C_FUN(round)(sum));
             }
-        } else if(optype == NUMERICAL_MEAN) {
+        }
+        mp_float_t M = ndarray->len > 0 ? sum / (mp_float_t)ndarray->len : MICROPY_FLOAT_CONST(0.0);
+        if(optype == NUMERICAL_MEAN) {
             return mp_obj_new_float(M);
         } else { // this must be the case of the standard deviation
+            mp_float_t S = numerical_sum_flattened(ndarray, array, M, 1);
             // we have already made certain that ddof < ndarray->len holds
             return mp_obj_new_float(MICROPY_FLOAT_C_FUN(sqrt)(S / (ndarray->len - ddof)));
         }
@@ -350,21 +722,49 @@ static mp_obj_t numerical_sum_mean_std_ndarray(ndarray_obj_t *ndarray, mp_obj_t
         ndarray_obj_t *results = NULL;
         uint8_t *rarray = NULL;
         mp_float_t *farray = NULL;
+        size_t outer, inner, n = _shape_strides.shape[0];
+        bool rows = numerical_reduce_rows(ndarray, tools_get_axis(axis, ndarray->ndim), &outer, &inner);
         if(optype == NUMERICAL_SUM) {
-            results = ndarray_new_dense_ndarray(_shape_strides.ndim, _shape_strides.shape, ndarray->dtype);
+            results = ndarray_new_dense_ndarray(_shape_strides.ndim, _shape_strides.shape, numerical_sum_dtype(ndarray->dtype));
             rarray = (uint8_t *)results->array;
-            // TODO: numpy promotes the output to the highest integer type
-            if(ndarray->dtype == NDARRAY_UINT8) {
-                RUN_SUM(uint8_t, array, results, rarray, _shape_strides);
-            } else if(ndarray->dtype == NDARRAY_INT8) {
-                RUN_SUM(int8_t, array, results, rarray, _shape_strides);
+            if(rows) {
+                if(ndarray->dtype == NDARRAY_UINT8) {
+                    RUN_SUM_ROWS(uint8_t, NUMERICAL_SUM_ACCUMULATOR(uint8_t, uint32_t), array, rarray, outer, n, inner);
+                } else if(ULAB_DTYPE_IS(ndarray->dtype, INT8)) {
+                    RUN_SUM_ROWS(int8_t, NUMERICAL_SUM_ACCUMULATOR(int8_t, int32_t), array, rarray, outer, n, inner);
+                } else if(ndarray->dtype == NDARRAY_UINT16) {
+                    RUN_SUM_ROWS(uint16_t, NUMERICAL_SUM_ACCUMULATOR(uint16_t, uint32_t), array, rarray, outer, n, inner);
+                } else if(ULAB_DTYPE_IS(ndarray->dtype, INT16)) {
+                    RUN_SUM_ROWS(int16_t, NUMERICAL_SUM_ACCUMULATOR(int16_t, int32_t), array, rarray, outer, n, inner);
+                }
+                #if ULAB_SUPPORTS_INT32
+                else if(ndarray->dtype == NDARRAY_INT32) {
+                    RUN_SUM_ROWS(int32_t, int32_t, array, rarray, outer, n, inner);
+                } else if(ndarray->dtype == NDARRAY_UINT32) {
+                    RUN_SUM_ROWS(uint32_t, uint32_t, array, rarray, outer, n, inner);
+                }
+                #endif
+                else {
+                    numerical_sum_mean_std_rows(ndarray, (mp_float_t *)rarray, outer, n, inner, optype, MICROPY_FLOAT_CONST(0.0));
+                }
+            } else if(ndarray->dtype == NDARRAY_UINT8) {
+                RUN_SUM(uint8_t, NUMERICAL_SUM_ACCUMULATOR(uint8_t, uint32_t), array, results, rarray, _shape_strides);
+            } else if(ULAB_DTYPE_IS(ndarray->dtype, INT8)) {
+                RUN_SUM(int8_t, NUMERICAL_SUM_ACCUMULATOR(int8_t, int32_t), array, results, rarray, _shape_strides);
             } else if(ndarray->dtype == NDARRAY_UINT16) {
-                RUN_SUM(uint16_t, array, results, rarray, _shape_strides);
-            } else if(ndarray->dtype == NDARRAY_INT16) {
-                RUN_SUM(int16_t, array, results, rarray, _shape_strides);
-            } else {
-                // for floats, the sum might be inaccurate with the naive summation
-                // call mean, and multiply with the number of samples
+                RUN_SUM(uint16_t, NUMERICAL_SUM_ACCUMULATOR(uint16_t, uint32_t), array, results, rarray, _shape_strides);
+            } else if(ULAB_DTYPE_IS(ndarray->dtype, INT16)) {
+                RUN_SUM(int16_t, NUMERICAL_SUM_ACCUMULATOR(int16_t, int32_t), array, results, rarray, _shape_strides);
+            }
+            #if ULAB_SUPPORTS_INT32
+            else if(ndarray->dtype == NDARRAY_INT32) {
+                RUN_SUM(int32_t, int32_t, array, results, rarray, _shape_strides);
+            } else if(ndarray->dtype == NDARRAY_UINT32) {
+                RUN_SUM(uint32_t, uint32_t, array, results, rarray, _shape_strides);
+            }
+            #endif
+            else {
+                // floats are summed pairwise in the mean, which is then multiplied by the number of samples
                 farray = (mp_float_t *)results->array;
                 RUN_MEAN_STD(mp_float_t, array, farray, _shape_strides, MICROPY_FLOAT_CONST(0.0), 0);
                 mp_float_t norm = (mp_float_t)_shape_strides.shape[0];
@@ -383,20 +783,30 @@ static mp_obj_t numerical_sum_mean_std_ndarray(ndarray_obj_t *ndarray, mp_obj_t
                 return MP_OBJ_FROM_PTR(results);
             }
             mp_float_t div = optype == NUMERICAL_STD ? (mp_float_t)(_shape_strides.shape[0] - ddof) : MICROPY_FLOAT_CONST(0.0);
-            if(ndarray->dtype == NDARRAY_UINT8) {
+            if(rows) {
+                numerical_sum_mean_std_rows(ndarray, farray, outer, n, inner, optype, div);
+            } else if(ndarray->dtype == NDARRAY_UINT8) {
                 RUN_MEAN_STD(uint8_t, array, farray, _shape_strides, div, isStd);
-            } else if(ndarray->dtype == NDARRAY_INT8) {
+            } else if(ULAB_DTYPE_IS(ndarray->dtype, INT8)) {
                 RUN_MEAN_STD(int8_t, array, farray, _shape_strides, div, isStd);
             } else if(ndarray->dtype == NDARRAY_UINT16) {
                 RUN_MEAN_STD(uint16_t, array, farray, _shape_strides, div, isStd);
-            } else if(ndarray->dtype == NDARRAY_INT16) {
+            } else if(ULAB_DTYPE_IS(ndarray->dtype, INT16)) {
                 RUN_MEAN_STD(int16_t, array, farray, _shape_strides, div, isStd);
-            } else {
+            }
+            #if ULAB_SUPPORTS_INT32
+            else if(ndarray->dtype == NDARRAY_INT32) {
+                RUN_MEAN_STD(int32_t, array, farray, _shape_strides, div, isStd);
+            } else if(ndarray->dtype == NDARRAY_UINT32) {
+                RUN_MEAN_STD(uint32_t, array, farray, _shape_strides, div, isStd);
+            }
+            #endif
+            else {
                 RUN_MEAN_STD(mp_float_t, array, farray, _shape_strides, div, isStd);
             }
         }
         if(results->ndim == 0) { // return a scalar here
-            return mp_binary_get_val_array(results->dtype, results->array, 0);
+            return ndarray_get_value(results->dtype, results->array, 0);
         }
         return MP_OBJ_FROM_PTR(results);
     }
@@ -452,6 +862,7 @@ static mp_obj_t numerical_argmin_argmax_ndarray(ndarray_obj_t *ndarray, mp_obj_t
         mp_float_t best_value = func(array);
         mp_float_t value;
         size_t index = 0, best_index = 0;
+        uint8_t *best_array = array;
 
         #if ULAB_MAX_DIMS > 3
         size_t i = 0;
@@ -472,11 +883,13 @@ static mp_obj_t numerical_argmin_argmax_ndarray(ndarray_obj_t *ndarray, mp_obj_t
                             if(best_value < value) {
                                 best_value = value;
                                 best_index = index;
+                                best_array = array;
                             }
                         } else {
                             if(best_value > value) {
                                 best_value = value;
                                 best_index = index;
+                                best_array = array;
                             }
                         }
                         array += ndarray->strides[ULAB_MAX_DIMS - 1];
@@ -505,15 +918,21 @@ static mp_obj_t numerical_argmin_argmax_ndarray(ndarray_obj_t *ndarray, mp_obj_t
         if((optype == NUMERICAL_ARGMIN) || (optype == NUMERICAL_ARGMAX)) {
             return mp_obj_new_int(best_index);
         } else {
-            if(ndarray->dtype == NDARRAY_FLOAT) {
+            if(ULAB_DTYPE_IS_FLOAT(ndarray->dtype)) {
                 return mp_obj_new_float(best_value);
             } else {
-                return MP_OBJ_NEW_SMALL_INT((int32_t)best_value);
+                // the value is read out of the array, so that 32-bit integers come back without loss
+                return ndarray_get_value(ndarray->dtype, best_array, 0);
             }
         }
     } else {
         int8_t ax = tools_get_axis(axis, ndarray->ndim);
 
+        #if ULAB_SUPPORTS_FLOAT16
+        if(ndarray->dtype == NDARRAY_FLOAT16) {
+            ndarray = ndarray_copy_view_convert_type(ndarray, NDARRAY_FLOAT);
+        }
+        #endif
         uint8_t *array = (uint8_t *)ndarray->array;
         size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
         int32_t *strides = m_new0(int32_t, ULAB_MAX_DIMS);
@@ -524,29 +943,62 @@ static mp_obj_t numerical_argmin_argmax_ndarray(ndarray_obj_t *ndarray, mp_obj_t
         ndarray_obj_t *results = NULL;
 
         if((optype == NUMERICAL_ARGMIN) || (optype == NUMERICAL_ARGMAX)) {
-            results = ndarray_new_dense_ndarray(MAX(1, ndarray->ndim-1), shape, NDARRAY_INT16);
+            // the indices are non-negative, so that they fit a uint16, if there is no int16
+            results = ndarray_new_dense_ndarray(MAX(1, ndarray->ndim-1), shape, ULAB_SUPPORTS_INT16 ? NDARRAY_INT16 : NDARRAY_UINT16);
         } else {
             results = ndarray_new_dense_ndarray(MAX(1, ndarray->ndim-1), shape, ndarray->dtype);
         }
 
         uint8_t *rarray = (uint8_t *)results->array;
+        size_t outer, inner;
 
-        if(ndarray->dtype == NDARRAY_UINT8) {
+        if(numerical_reduce_rows(ndarray, ax, &outer, &inner)) {
+            size_t n = ndarray->shape[index];
+            uint8_t *best = m_new(uint8_t, inner * ndarray->itemsize);
+            if(ndarray->dtype == NDARRAY_UINT8) {
+                RUN_ARGMIN_ROWS(uint8_t, array, rarray, best, outer, n, inner, optype);
+            } else if(ULAB_DTYPE_IS(ndarray->dtype, INT8)) {
+                RUN_ARGMIN_ROWS(int8_t, array, rarray, best, outer, n, inner, optype);
+            } else if(ndarray->dtype == NDARRAY_UINT16) {
+                RUN_ARGMIN_ROWS(uint16_t, array, rarray, best, outer, n, inner, optype);
+            } else if(ULAB_DTYPE_IS(ndarray->dtype, INT16)) {
+                RUN_ARGMIN_ROWS(int16_t, array, rarray, best, outer, n, inner, optype);
+            }
+            #if ULAB_SUPPORTS_INT32
+            else if(ndarray->dtype == NDARRAY_INT32) {
+                RUN_ARGMIN_ROWS(int32_t, array, rarray, best, outer, n, inner, optype);
+            } else if(ndarray->dtype == NDARRAY_UINT32) {
+                RUN_ARGMIN_ROWS(uint32_t, array, rarray, best, outer, n, inner, optype);
+            }
+            #endif
+            else {
+                RUN_ARGMIN_ROWS(mp_float_t, array, rarray, best, outer, n, inner, optype);
+            }
+            m_del(uint8_t, best, inner * ndarray->itemsize);
+        } else if(ndarray->dtype == NDARRAY_UINT8) {
             RUN_ARGMIN(ndarray, uint8_t, array, results, rarray, shape, strides, index, optype);
-        } else if(ndarray->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(ndarray->dtype, INT8)) {
             RUN_ARGMIN(ndarray, int8_t, array, results, rarray, shape, strides, index, optype);
         } else if(ndarray->dtype == NDARRAY_UINT16) {
             RUN_ARGMIN(ndarray, uint16_t, array, results, rarray, shape, strides, index, optype);
-        } else if(ndarray->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(ndarray->dtype, INT16)) {
             RUN_ARGMIN(ndarray, int16_t, array, results, rarray, shape, strides, index, optype);
-        } else {
+        }
+        #if ULAB_SUPPORTS_INT32
+        else if(ndarray->dtype == NDARRAY_INT32) {
+            RUN_ARGMIN(ndarray, int32_t, array, results, rarray, shape, strides, index, optype);
+        } else if(ndarray->dtype == NDARRAY_UINT32) {
+            RUN_ARGMIN(ndarray, uint32_t, array, results, rarray, shape, strides, index, optype);
+        }
+        #endif
+        else {
             RUN_ARGMIN(ndarray, mp_float_t, array, results, rarray, shape, strides, index, optype);
         }
 
         m_del(int32_t, strides, ULAB_MAX_DIMS);
 
         if(results->len == 1) {
-            return mp_binary_get_val_array(results->dtype, results->array, 0);
+            return ndarray_get_value(results->dtype, results->array, 0);
         }
         return MP_OBJ_FROM_PTR(results);
     }
@@ -554,10 +1006,47 @@ static mp_obj_t numerical_argmin_argmax_ndarray(ndarray_obj_t *ndarray, mp_obj_t
 }
 #endif
 
+static mp_obj_t numerical_keepdims(mp_obj_t result, ndarray_obj_t *ndarray, mp_obj_t axis, uint8_t dtype) {
+    // re-inserts the reduced axes with a length of 1, so that the result broadcasts against the input;
+    // dtype is the type of the array, if the reduction returned a scalar
+    ndarray_obj_t *results;
+    if(mp_obj_is_type(result, &ulab_ndarray_type)) {
+        // the results of the reductions are always dense, and have not been seen by anyone else
+        results = MP_OBJ_TO_PTR(result);
+    } else {
+        #if ULAB_SUPPORTS_COMPLEX
+        if(mp_obj_is_type(result, &mp_type_complex)) {
+            results = ndarray_new_linear_array(1, NDARRAY_COMPLEX);
+            mp_float_t *rarray = (mp_float_t *)results->array;
+            mp_obj_get_complex(result, &rarray[0], &rarray[1]);
+        } else
+        #endif
+        {
+            results = ndarray_new_linear_array(1, dtype);
+            ndarray_set_value(dtype, results->array, 0, result);
+        }
+    }
+    int8_t ax = axis == mp_const_none ? -1 : tools_get_axis(axis, ndarray->ndim);
+    int32_t stride = results->itemsize;
+    for(uint8_t i = ULAB_MAX_DIMS; i > 0; i--) {
+        if(i > ULAB_MAX_DIMS - ndarray->ndim) {
+            uint8_t d = i - 1 - (ULAB_MAX_DIMS - ndarray->ndim);
+            results->shape[i - 1] = ((ax == -1) || (d == ax)) ? 1 : ndarray->shape[i - 1];
+        } else {
+            results->shape[i - 1] = 0;
+        }
+        results->strides[i - 1] = stride;
+        stride *= MAX(1, results->shape[i - 1]);
+    }
+    results->ndim = ndarray->ndim;
+    return MP_OBJ_FROM_PTR(results);
+}
+
 static mp_obj_t numerical_function(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args, uint8_t optype) {
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE} } ,
         { MP_QSTR_axis, MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_keepdims, MP_ARG_KW_ONLY | MP_ARG_BOOL, { .u_bool = false } },
     };
 
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
@@ -565,6 +1054,7 @@ static mp_obj_t numerical_function(size_t n_args, const mp_obj_t *pos_args, mp_m
 
     mp_obj_t oin = args[0].u_obj;
     mp_obj_t axis = args[1].u_obj;
+    bool keepdims = args[2].u_bool;
     if((axis != mp_const_none) && (!mp_obj_is_int(axis))) {
         mp_raise_TypeError(MP_ERROR_TEXT("axis must be None, or an integer"));
     }
@@ -590,20 +1080,37 @@ static mp_obj_t numerical_function(size_t n_args, const mp_obj_t *pos_args, mp_m
         }
     } else if(mp_obj_is_type(oin, &ulab_ndarray_type)) {
         ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(oin);
+        mp_obj_t result = mp_const_none;
+        uint8_t dtype = NDARRAY_FLOAT;
         switch(optype) {
             case NUMERICAL_MIN:
             case NUMERICAL_MAX:
             case NUMERICAL_ARGMIN:
             case NUMERICAL_ARGMAX:
                 COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
-                return numerical_argmin_argmax_ndarray(ndarray, axis, optype);
+                result = numerical_argmin_argmax_ndarray(ndarray, axis, optype);
+                if((optype == NUMERICAL_ARGMIN) || (optype == NUMERICAL_ARGMAX)) {
+                    dtype = ULAB_SUPPORTS_INT16 ? NDARRAY_INT16 : NDARRAY_UINT16;
+                } else {
+                    dtype = ndarray->dtype;
+                }
+                break;
             case NUMERICAL_SUM:
             case NUMERICAL_MEAN:
-                COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
-                return numerical_sum_mean_std_ndarray(ndarray, axis, optype, 0);
+                result = numerical_sum_mean_std_ndarray(ndarray, axis, optype, 0);
+                if(optype == NUMERICAL_SUM) {
+                    dtype = numerical_sum_dtype(ndarray->dtype);
+                    // the sum of all elements of an integer array is an exact python int,
+                    // which would overflow, if it was stored in the dtype of the input
+                    if(mp_obj_is_int(result)) {
+                        dtype = NDARRAY_FLOAT;
+                    }
+                }
+                break;
             default:
                 mp_raise_NotImplementedError(MP_ERROR_TEXT("operation is not implemented on ndarrays"));
         }
+        return keepdims ? numerical_keepdims(result, ndarray, axis, dtype) : result;
     } else {
         mp_raise_TypeError(MP_ERROR_TEXT("input must be tuple, list, range, or ndarray"));
     }
@@ -611,7 +1118,7 @@ static mp_obj_t numerical_function(size_t n_args, const mp_obj_t *pos_args, mp_m
 }
 
 #if ULAB_NUMPY_HAS_SORT | NDARRAY_HAS_SORT
-static mp_obj_t numerical_sort_helper(mp_obj_t oin, mp_obj_t axis, uint8_t inplace) {
+static mp_obj_t numerical_sort_helper(mp_obj_t oin, mp_obj_t axis, mp_obj_t kind_in, uint8_t inplace) {
     if(!mp_obj_is_type(oin, &ulab_ndarray_type)) {
         mp_raise_TypeError(MP_ERROR_TEXT("sort argument must be an ndarray"));
     }
@@ -623,6 +1130,8 @@ static mp_obj_t numerical_sort_helper(mp_obj_t oin, mp_obj_t axis, uint8_t inpla
         ndarray = ndarray_copy_view(MP_OBJ_TO_PTR(oin));
     }
     COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+    GENERIC_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+    uint8_t kind = sort_get_kind(kind_in);
 
     int8_t ax = 0;
     if(axis == mp_const_none) {
@@ -650,12 +1159,12 @@ static mp_obj_t numerical_sort_helper(mp_obj_t oin, mp_obj_t axis, uint8_t inpla
 
     uint8_t *array = (uint8_t *)ndarray->array;
     if(ndarray->shape[ax]) {
-        if((ndarray->dtype == NDARRAY_UINT8) || (ndarray->dtype == NDARRAY_INT8)) {
-            HEAPSORT(ndarray, uint8_t, array, shape, strides, ax, increment, ndarray->shape[ax]);
-        } else if((ndarray->dtype == NDARRAY_UINT16) || (ndarray->dtype == NDARRAY_INT16)) {
-            HEAPSORT(ndarray, uint16_t, array, shape, strides, ax, increment, ndarray->shape[ax]);
-        } else {
-            HEAPSORT(ndarray, mp_float_t, array, shape, strides, ax, increment, ndarray->shape[ax]);
+        // the scratch space of the counting and radix sorts is shared by all lanes
+        size_t ssize = sort_values_scratch(ndarray->dtype, ndarray->shape[ax], kind);
+        uint8_t *scratch = ssize ? ulab_scratch_new(uint8_t, ssize) : NULL;
+        RUN_SORT(ndarray->dtype, array, shape, strides, increment, ndarray->shape[ax], kind, scratch);
+        if(ssize) {
+            ulab_scratch_del(uint8_t, scratch, ssize);
         }
     }
 
@@ -684,7 +1193,7 @@ MP_DEFINE_CONST_FUN_OBJ_KW(numerical_any_obj, 1, numerical_any);
 #endif
 
 #if ULAB_NUMPY_HAS_ARGMINMAX
-//| def argmax(array: _ArrayLike, *, axis: Optional[int] = None) -> int:
+//| def argmax(array: _ArrayLike, *, axis: Optional[int] = None, keepdims: bool = False) -> int:
 //|     """Return the index of the maximum element of the 1D array"""
 //|     ...
 //|
@@ -695,7 +1204,7 @@ mp_obj_t numerical_argmax(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
 
 MP_DEFINE_CONST_FUN_OBJ_KW(numerical_argmax_obj, 1, numerical_argmax);
 
-//| def argmin(array: _ArrayLike, *, axis: Optional[int] = None) -> int:
+//| def argmin(array: _ArrayLike, *, axis: Optional[int] = None, keepdims: bool = False) -> int:
 //|     """Return the index of the minimum element of the 1D array"""
 //|     ...
 //|
@@ -708,8 +1217,9 @@ MP_DEFINE_CONST_FUN_OBJ_KW(numerical_argmin_obj, 1, numerical_argmin);
 #endif
 
 #if ULAB_NUMPY_HAS_ARGSORT
-//| def argsort(array: ulab.numpy.ndarray, *, axis: int = -1) -> ulab.numpy.ndarray:
-//|     """Returns an array which gives indices into the input array from least to greatest."""
+//| def argsort(array: ulab.numpy.ndarray, *, axis: int = -1, kind: Optional[str] = None) -> ulab.numpy.ndarray:
+//|     """Returns an array which gives indices into the input array from least to greatest.
+//|        kind can be 'quicksort' (default), 'heapsort', 'stable', or 'mergesort' (an alias of 'stable')."""
 //|     ...
 //|
 
@@ -717,6 +1227,7 @@ mp_obj_t numerical_argsort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
         { MP_QSTR_axis, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_kind, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -726,6 +1237,8 @@ mp_obj_t numerical_argsort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw
 
     ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(args[0].u_obj);
     COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+    GENERIC_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+    uint8_t kind = sort_get_kind(args[2].u_obj);
     if(args[1].u_obj == mp_const_none) {
         // bail out, though dense arrays could still be sorted
         mp_raise_NotImplementedError(MP_ERROR_TEXT("argsort is not implemented for flattened arrays"));
@@ -800,12 +1313,11 @@ mp_obj_t numerical_argsort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw
     iarray = indices->array;
 
     if(ndarray->shape[ax]) {
-        if((ndarray->dtype == NDARRAY_UINT8) || (ndarray->dtype == NDARRAY_INT8)) {
-            HEAP_ARGSORT(ndarray, uint8_t, array, shape, strides, ax, increment, ndarray->shape[ax], iarray, istrides, iincrement);
-        } else if((ndarray->dtype == NDARRAY_UINT16) || (ndarray->dtype == NDARRAY_INT16)) {
-            HEAP_ARGSORT(ndarray, uint16_t, array, shape, strides, ax, increment, ndarray->shape[ax], iarray, istrides, iincrement);
-        } else {
-            HEAP_ARGSORT(ndarray, mp_float_t, array, shape, strides, ax, increment, ndarray->shape[ax], iarray, istrides, iincrement);
+        size_t ssize = sort_indices_scratch(ndarray->shape[ax], kind);
+        uint16_t *scratch = ssize ? ulab_scratch_new(uint16_t, ssize) : NULL;
+        RUN_ARGSORT(ndarray->dtype, array, shape, strides, increment, ndarray->shape[ax], iarray, istrides, iincrement, kind, scratch);
+        if(ssize) {
+            ulab_scratch_del(uint16_t, scratch, ssize);
         }
     }
 
@@ -833,6 +1345,8 @@ static mp_obj_t numerical_cross(mp_obj_t _a, mp_obj_t _b) {
     ndarray_obj_t *b = MP_OBJ_TO_PTR(_b);
     COMPLEX_DTYPE_NOT_IMPLEMENTED(a->dtype)
     COMPLEX_DTYPE_NOT_IMPLEMENTED(b->dtype)
+    GENERIC_DTYPE_NOT_IMPLEMENTED(a->dtype)
+    GENERIC_DTYPE_NOT_IMPLEMENTED(b->dtype)
     if((a->ndim != 1) || (b->ndim != 1) || (a->len != b->len) || (a->len != 3)) {
         mp_raise_ValueError(MP_ERROR_TEXT("cross is defined for 1D arrays of length 3"));
     }
@@ -859,32 +1373,19 @@ static mp_obj_t numerical_cross(mp_obj_t _a, mp_obj_t _b) {
 
     */
 
-    uint8_t dtype = NDARRAY_FLOAT;
-    if(a->dtype == b->dtype) {
-        dtype = a->dtype;
-    } else if(((a->dtype == NDARRAY_UINT8) && (b->dtype == NDARRAY_INT8)) || ((a->dtype == NDARRAY_INT8) && (b->dtype == NDARRAY_UINT8))) {
-        dtype = NDARRAY_INT16;
-    } else if(((a->dtype == NDARRAY_UINT8) && (b->dtype == NDARRAY_INT16)) || ((a->dtype == NDARRAY_INT16) && (b->dtype == NDARRAY_UINT8))) {
-        dtype = NDARRAY_INT16;
-    } else if(((a->dtype == NDARRAY_UINT8) && (b->dtype == NDARRAY_UINT16)) || ((a->dtype == NDARRAY_UINT16) && (b->dtype == NDARRAY_UINT8))) {
-        dtype = NDARRAY_UINT16;
-    } else if(((a->dtype == NDARRAY_INT8) && (b->dtype == NDARRAY_INT16)) || ((a->dtype == NDARRAY_INT16) && (b->dtype == NDARRAY_INT8))) {
-        dtype = NDARRAY_INT16;
-    } else if(((a->dtype == NDARRAY_INT8) && (b->dtype == NDARRAY_UINT16)) || ((a->dtype == NDARRAY_UINT16) && (b->dtype == NDARRAY_INT8))) {
-        dtype = NDARRAY_UINT16;
-    }
+    uint8_t dtype = ndarray_upcast_dtype(a->dtype, b->dtype);
 
     ndarray_obj_t *ndarray = ndarray_new_linear_array(3, dtype);
     if(dtype == NDARRAY_UINT8) {
         uint8_t *array = (uint8_t *)ndarray->array;
         for(uint8_t i=0; i < 3; i++) array[i] = (uint8_t)results[i];
-    } else if(dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {
         int8_t *array = (int8_t *)ndarray->array;
         for(uint8_t i=0; i < 3; i++) array[i] = (int8_t)results[i];
     } else if(dtype == NDARRAY_UINT16) {
         uint16_t *array = (uint16_t *)ndarray->array;
         for(uint8_t i=0; i < 3; i++) array[i] = (uint16_t)results[i];
-    } else if(dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {
         int16_t *array = (int16_t *)ndarray->array;
         for(uint8_t i=0; i < 3; i++) array[i] = (int16_t)results[i];
     } else {
@@ -899,6 +1400,301 @@ MP_DEFINE_CONST_FUN_OBJ_2(numerical_cross_obj, numerical_cross);
 
 #endif /* ULAB_NUMERICAL_HAS_CROSS */
 
+#if ULAB_NUMPY_HAS_CUMPROD | ULAB_NUMPY_HAS_CUMSUM | ULAB_SCIPY_INTEGRATE_HAS_CUMULATIVE_TRAPEZOID
+// the parameters of the running operations, which are evaluated lane by lane
+typedef struct _numerical_lane_t {
+    uint8_t optype;
+    uint8_t dtype;
+    uint8_t rdtype;
+    int32_t stride;
+    int32_t rstride;
+    size_t len;
+    // cumulative_trapezoid only
+    mp_float_t *xdiff;
+    mp_float_t dx;
+    bool has_initial;
+    mp_float_t initial;
+    mp_float_t *scratch;
+} numerical_lane_t;
+
+static void numerical_cumulate_lane(numerical_lane_t *lane, uint8_t *array, uint8_t *rarray) {
+    #if ULAB_SCIPY_INTEGRATE_HAS_CUMULATIVE_TRAPEZOID
+    if(lane->optype == NUMERICAL_CUMULATIVE_TRAPEZOID) {
+        // the lane is converted to float in a typed loop first
+        mp_float_t *y = lane->scratch;
+        tools_load_float(y, 1, array, lane->stride, lane->dtype, lane->len);
+        if(lane->has_initial) {
+            *(mp_float_t *)rarray = lane->initial;
+            rarray += lane->rstride;
+        }
+        mp_float_t sum = MICROPY_FLOAT_CONST(0.0);
+        for(size_t i = 1; i < lane->len; i++) {
+            mp_float_t dx = lane->xdiff == NULL ? lane->dx : lane->xdiff[i - 1];
+            sum += MICROPY_FLOAT_CONST(0.5) * dx * (y[i] + y[i - 1]);
+            *(mp_float_t *)rarray = sum;
+            rarray += lane->rstride;
+        }
+        return;
+    }
+    #endif
+    // the type of the accumulator is that of the output: either that of the input, or float
+    if(lane->rdtype == NDARRAY_FLOAT) {
+        if((lane->dtype == NDARRAY_UINT8) || (lane->dtype == NDARRAY_BOOL)) {
+            NUMERICAL_CUMULATE_LOOP(uint8_t, mp_float_t, array, rarray, lane);
+        } else if(ULAB_DTYPE_IS(lane->dtype, INT8)) {
+            NUMERICAL_CUMULATE_LOOP(int8_t, mp_float_t, array, rarray, lane);
+        } else if(lane->dtype == NDARRAY_UINT16) {
+            NUMERICAL_CUMULATE_LOOP(uint16_t, mp_float_t, array, rarray, lane);
+        } else if(ULAB_DTYPE_IS(lane->dtype, INT16)) {
+            NUMERICAL_CUMULATE_LOOP(int16_t, mp_float_t, array, rarray, lane);
+        } else {
+            NUMERICAL_CUMULATE_LOOP(mp_float_t, mp_float_t, array, rarray, lane);
+        }
+    } else {
+        if((lane->dtype == NDARRAY_UINT8) || (lane->dtype == NDARRAY_BOOL)) {
+            NUMERICAL_CUMULATE_LOOP(uint8_t, uint8_t, array, rarray, lane);
+        } else if(ULAB_DTYPE_IS(lane->dtype, INT8)) {
+            NUMERICAL_CUMULATE_LOOP(int8_t, int8_t, array, rarray, lane);
+        } else if(lane->dtype == NDARRAY_UINT16) {
+            NUMERICAL_CUMULATE_LOOP(uint16_t, uint16_t, array, rarray, lane);
+        } else if(ULAB_DTYPE_IS(lane->dtype, INT16)) {
+            NUMERICAL_CUMULATE_LOOP(int16_t, int16_t, array, rarray, lane);
+        }
+    }
+}
+
+static void numerical_cumulate_axis(ndarray_obj_t *ndarray, ndarray_obj_t *results, int8_t ax, numerical_lane_t *lane) {
+    // runs the operation along the lanes of axis ax; except for the length
+    // of the lanes, ndarray and results must have the same shape
+    uint8_t index = ULAB_MAX_DIMS - ndarray->ndim + ax;
+    lane->stride = ndarray->strides[index];
+    lane->rstride = results->strides[index];
+    lane->len = ndarray->shape[index];
+    if((ndarray->len == 0) || (results->len == 0)) {
+        return;
+    }
+
+    size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
+    int32_t *strides = m_new0(int32_t, ULAB_MAX_DIMS);
+    int32_t *rstrides = m_new0(int32_t, ULAB_MAX_DIMS);
+    numerical_reduce_axes(results, ax, shape, rstrides);
+    numerical_reduce_axes(ndarray, ax, shape, strides);
+
+    uint8_t *array = (uint8_t *)ndarray->array;
+    uint8_t *rarray = (uint8_t *)results->array;
+
+    #if ULAB_MAX_DIMS > 3
+    size_t i = 0;
+    do {
+    #endif
+        #if ULAB_MAX_DIMS > 2
+        size_t j = 0;
+        do {
+        #endif
+            #if ULAB_MAX_DIMS > 1
+            size_t k = 0;
+            do {
+            #endif
+                numerical_cumulate_lane(lane, array, rarray);
+            #if ULAB_MAX_DIMS > 1
+                array += strides[ULAB_MAX_DIMS - 1];
+                rarray += rstrides[ULAB_MAX_DIMS - 1];
+                k++;
+            } while(k < shape[ULAB_MAX_DIMS - 1]);
+            #endif
+        #if ULAB_MAX_DIMS > 2
+            array -= strides[ULAB_MAX_DIMS - 1] * shape[ULAB_MAX_DIMS - 1];
+            array += strides[ULAB_MAX_DIMS - 2];
+            rarray -= rstrides[ULAB_MAX_DIMS - 1] * shape[ULAB_MAX_DIMS - 1];
+            rarray += rstrides[ULAB_MAX_DIMS - 2];
+            j++;
+        } while(j < shape[ULAB_MAX_DIMS - 2]);
+        #endif
+    #if ULAB_MAX_DIMS > 3
+        array -= strides[ULAB_MAX_DIMS - 2] * shape[ULAB_MAX_DIMS - 2];
+        array += strides[ULAB_MAX_DIMS - 3];
+        rarray -= rstrides[ULAB_MAX_DIMS - 2] * shape[ULAB_MAX_DIMS - 2];
+        rarray += rstrides[ULAB_MAX_DIMS - 3];
+        i++;
+    } while(i < shape[ULAB_MAX_DIMS - 3]);
+    #endif
+
+    m_del(size_t, shape, ULAB_MAX_DIMS);
+    m_del(int32_t, strides, ULAB_MAX_DIMS);
+    m_del(int32_t, rstrides, ULAB_MAX_DIMS);
+}
+#endif
+
+#if ULAB_NUMPY_HAS_CUMPROD | ULAB_NUMPY_HAS_CUMSUM
+static mp_obj_t numerical_cumulate(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args, uint8_t optype) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_axis, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_out, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    ndarray_obj_t *ndarray = ndarray_from_mp_obj(args[0].u_obj, 0);
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+    GENERIC_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+    mp_obj_t axis = args[1].u_obj;
+    mp_obj_t out = args[2].u_obj;
+    if(!mp_obj_is_int(axis) & (axis != mp_const_none)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("axis must be None, or an integer"));
+    }
+
+    numerical_lane_t lane;
+    lane.optype = optype;
+    lane.dtype = ndarray->dtype;
+    // as with sum, the results are of the type of the input, unless out is a float array
+    lane.rdtype = ndarray->dtype == NDARRAY_BOOL ? NDARRAY_UINT8 : ndarray->dtype;
+    if(mp_obj_is_type(out, &ulab_ndarray_type)) {
+        ndarray_obj_t *o = MP_OBJ_TO_PTR(out);
+        if(o->dtype == NDARRAY_FLOAT) {
+            lane.rdtype = NDARRAY_FLOAT;
+        }
+    }
+
+    int8_t ax = 0;
+    ndarray_obj_t *results;
+    if(axis == mp_const_none) {
+        // the flattened array is a single lane
+        if(!ndarray_is_contiguous(ndarray)) {
+            ndarray = ndarray_copy_view(ndarray);
+        }
+        size_t *shape = ndarray_shape_vector(0, 0, 0, ndarray->len);
+        if(out == mp_const_none) {
+            results = ndarray_new_dense_ndarray(1, shape, lane.rdtype);
+        } else {
+            results = tools_get_out_array(out, 1, shape, lane.rdtype);
+        }
+        m_del(size_t, shape, ULAB_MAX_DIMS);
+        // the contiguous array can be viewed as a linear one
+        ndarray_obj_t flat = *ndarray;
+        flat.ndim = 1;
+        flat.shape[ULAB_MAX_DIMS - 1] = ndarray->len;
+        flat.strides[ULAB_MAX_DIMS - 1] = ndarray->itemsize;
+        numerical_cumulate_axis(&flat, results, 0, &lane);
+    } else {
+        ax = tools_get_axis(axis, ndarray->ndim);
+        if(out == mp_const_none) {
+            results = ndarray_new_dense_ndarray(ndarray->ndim, ndarray->shape, lane.rdtype);
+        } else {
+            results = tools_get_out_array(out, ndarray->ndim, ndarray->shape, lane.rdtype);
+        }
+        numerical_cumulate_axis(ndarray, results, ax, &lane);
+    }
+    return MP_OBJ_FROM_PTR(results);
+}
+#endif
+
+#if ULAB_NUMPY_HAS_CUMPROD
+//| def cumprod(array: _ArrayLike, axis: Optional[int] = None, *, out: Optional[ulab.numpy.ndarray] = None) -> ulab.numpy.ndarray:
+//|     """Return the running product of the elements along the given axis, or of the flattened array"""
+//|     ...
+//|
+
+mp_obj_t numerical_cumprod(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    return numerical_cumulate(n_args, pos_args, kw_args, NUMERICAL_CUMPROD);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(numerical_cumprod_obj, 1, numerical_cumprod);
+#endif
+
+#if ULAB_NUMPY_HAS_CUMSUM
+//| def cumsum(array: _ArrayLike, axis: Optional[int] = None, *, out: Optional[ulab.numpy.ndarray] = None) -> ulab.numpy.ndarray:
+//|     """Return the running sum of the elements along the given axis, or of the flattened array"""
+//|     ...
+//|
+
+mp_obj_t numerical_cumsum(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    return numerical_cumulate(n_args, pos_args, kw_args, NUMERICAL_CUMSUM);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(numerical_cumsum_obj, 1, numerical_cumsum);
+#endif
+
+#if ULAB_SCIPY_INTEGRATE_HAS_CUMULATIVE_TRAPEZOID
+//| def cumulative_trapezoid(
+//|     y: _ArrayLike,
+//|     x: Optional[_ArrayLike] = None,
+//|     dx: _float = 1.0,
+//|     axis: int = -1,
+//|     initial: Optional[_float] = None,
+//|     *,
+//|     out: Optional[ulab.numpy.ndarray] = None
+//| ) -> ulab.numpy.ndarray:
+//|     """Return the running integral of y along the given axis by the trapezoidal rule.
+//|        If initial is given, it is inserted at the beginning of the results."""
+//|     ...
+//|
+
+mp_obj_t numerical_cumulative_trapezoid(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_x, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_dx, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_axis, MP_ARG_INT, {.u_int = -1 } },
+        { MP_QSTR_initial, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_out, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    ndarray_obj_t *y = ndarray_from_mp_obj(args[0].u_obj, 0);
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(y->dtype)
+    int8_t ax = tools_get_axis(mp_obj_new_int(args[3].u_int), y->ndim);
+    uint8_t index = ULAB_MAX_DIMS - y->ndim + ax;
+    size_t len = y->shape[index];
+
+    numerical_lane_t lane;
+    lane.optype = NUMERICAL_CUMULATIVE_TRAPEZOID;
+    lane.dtype = y->dtype;
+    lane.rdtype = NDARRAY_FLOAT;
+    lane.xdiff = NULL;
+    lane.dx = args[2].u_obj == mp_const_none ? MICROPY_FLOAT_CONST(1.0) : mp_obj_get_float(args[2].u_obj);
+    lane.has_initial = args[4].u_obj != mp_const_none;
+    lane.initial = lane.has_initial ? mp_obj_get_float(args[4].u_obj) : MICROPY_FLOAT_CONST(0.0);
+
+    // the scratch buffer holds a lane of y, followed by the differences of x
+    lane.scratch = m_new(mp_float_t, 2 * len);
+    if(args[1].u_obj != mp_const_none) {
+        ndarray_obj_t *x = ndarray_from_mp_obj(args[1].u_obj, 0);
+        COMPLEX_DTYPE_NOT_IMPLEMENTED(x->dtype)
+        if((x->ndim != 1) || (x->len != len)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("x must be a 1D array of the length of the axis"));
+        }
+        lane.xdiff = lane.scratch + len;
+        tools_load_float(lane.xdiff, 1, (uint8_t *)x->array, x->strides[ULAB_MAX_DIMS - 1], x->dtype, len);
+        for(size_t i = 1; i < len; i++) {
+            lane.xdiff[i - 1] = lane.xdiff[i] - lane.xdiff[i - 1];
+        }
+    }
+
+    size_t *shape = m_new(size_t, ULAB_MAX_DIMS);
+    memcpy(shape, y->shape, ULAB_MAX_DIMS * sizeof(size_t));
+    if(!lane.has_initial && (len > 0)) {
+        shape[index] = len - 1;
+    }
+    ndarray_obj_t *results;
+    if(args[5].u_obj == mp_const_none) {
+        results = ndarray_new_dense_ndarray(y->ndim, shape, NDARRAY_FLOAT);
+    } else {
+        results = tools_get_out_array(args[5].u_obj, y->ndim, shape, NDARRAY_FLOAT);
+    }
+    m_del(size_t, shape, ULAB_MAX_DIMS);
+
+    numerical_cumulate_axis(y, results, ax, &lane);
+    m_del(mp_float_t, lane.scratch, 2 * len);
+    return MP_OBJ_FROM_PTR(results);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(numerical_cumulative_trapezoid_obj, 1, numerical_cumulative_trapezoid);
+#endif
+
 #if ULAB_NUMPY_HAS_DIFF
 //| def diff(array: ulab.numpy.ndarray, *, n: int = 1, axis: int = -1) -> ulab.numpy.ndarray:
 //|     """Return the numerical derivative of successive elements of the array, as
@@ -922,6 +1718,7 @@ mp_obj_t numerical_diff(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_ar
 
     ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(args[0].u_obj);
     COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+    GENERIC_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
     int8_t ax = args[2].u_int;
     if(ax < 0) ax += ndarray->ndim;
 
@@ -961,11 +1758,11 @@ mp_obj_t numerical_diff(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_ar
 
     if(ndarray->dtype == NDARRAY_UINT8) {
         RUN_DIFF(ndarray, uint8_t, array, results, rarray, shape, strides, index, stencil, N);
-    } else if(ndarray->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(ndarray->dtype, INT8)) {
         RUN_DIFF(ndarray, int8_t, array, results, rarray, shape, strides, index, stencil, N);
     }  else if(ndarray->dtype == NDARRAY_UINT16) {
         RUN_DIFF(ndarray, uint16_t, array, results, rarray, shape, strides, index, stencil, N);
-    } else if(ndarray->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(ndarray->dtype, INT16)) {
         RUN_DIFF(ndarray, int16_t, array, results, rarray, shape, strides, index, stencil, N);
     } else {
         RUN_DIFF(ndarray, mp_float_t, array, results, rarray, shape, strides, index, stencil, N);
@@ -1025,7 +1822,7 @@ MP_DEFINE_CONST_FUN_OBJ_KW(numerical_flip_obj, 1, numerical_flip);
 #endif
 
 #if ULAB_NUMPY_HAS_MINMAX
-//| def max(array: _ArrayLike, *, axis: Optional[int] = None) -> _float:
+//| def max(array: _ArrayLike, *, axis: Optional[int] = None, keepdims: bool = False) -> _float:
 //|     """Return the maximum element of the 1D array"""
 //|     ...
 //|
@@ -1038,7 +1835,7 @@ MP_DEFINE_CONST_FUN_OBJ_KW(numerical_max_obj, 1, numerical_max);
 #endif
 
 #if ULAB_NUMPY_HAS_MEAN
-//| def mean(array: _ArrayLike, *, axis: Optional[int] = None) -> _float:
+//| def mean(array: _ArrayLike, *, axis: Optional[int] = None, keepdims: bool = False) -> _float:
 //|     """Return the mean element of the 1D array, as a number if axis is None, otherwise as an array."""
 //|     ...
 //|
@@ -1050,59 +1847,236 @@ mp_obj_t numerical_mean(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_ar
 MP_DEFINE_CONST_FUN_OBJ_KW(numerical_mean_obj, 1, numerical_mean);
 #endif
 
-#if ULAB_NUMPY_HAS_MEDIAN
-//| def median(array: ulab.numpy.ndarray, *, axis: int = -1) -> ulab.numpy.ndarray:
-//|     """Find the median value in an array along the given axis, or along all axes if axis is None."""
-//|     ...
-//|
+#if ULAB_NUMPY_HAS_MEDIAN | ULAB_NUMPY_HAS_PERCENTILE | ULAB_NUMPY_HAS_QUANTILE
+static void numerical_select_sift(mp_float_t *array, int32_t root, int32_t end) {
+    while(2 * root + 1 <= end) {
+        int32_t child = 2 * root + 1;
+        if((child < end) && (array[child] < array[child + 1])) {
+            child++;
+        }
+        if(!(array[root] < array[child])) {
+            return;
+        }
+        SWAP(mp_float_t, array[root], array[child]);
+        root = child;
+    }
+}
 
-mp_obj_t numerical_median(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    static const mp_arg_t allowed_args[] = {
-        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
-        { MP_QSTR_axis, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
-    };
+static void numerical_select_heapsort(mp_float_t *array, int32_t len) {
+    // fall-back for the selection, if the partitioning degenerates
+    for(int32_t start = len / 2 - 1; start >= 0; start--) {
+        numerical_select_sift(array, start, len - 1);
+    }
+    for(int32_t end = len - 1; end > 0; end--) {
+        SWAP(mp_float_t, array[0], array[end]);
+        numerical_select_sift(array, 0, end - 1);
+    }
+}
 
-    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
-    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
-    if(!mp_obj_is_type(args[0].u_obj, &ulab_ndarray_type)) {
-        mp_raise_TypeError(MP_ERROR_TEXT("median argument must be an ndarray"));
+static mp_float_t numerical_select(mp_float_t *array, int32_t len, int32_t k) {
+    // introselect: partitions array in place, so that array[k] is the k-th smallest value,
+    // and no value to the left (right) of k is larger (smaller) than that;
+    // the pivot is the median of three, and after 2*log2(len) partitions, the rest is sorted
+    int32_t left = 0, right = len - 1;
+    uint8_t depth = 0;
+    for(int32_t n = len; n; n >>= 1) {
+        depth += 2;
     }
+    while(right > left) {
+        if(depth-- == 0) {
+            numerical_select_heapsort(array + left, right - left + 1);
+            break;
+        }
+        int32_t mid = left + (right - left) / 2;
+        if(array[mid] < array[left]) {
+            SWAP(mp_float_t, array[mid], array[left]);
+        }
+        if(array[right] < array[left]) {
+            SWAP(mp_float_t, array[right], array[left]);
+        }
+        if(array[right] < array[mid]) {
+            SWAP(mp_float_t, array[right], array[mid]);
+        }
+        mp_float_t pivot = array[mid];
+        int32_t i = left, j = right;
+        while(i <= j) {
+            while(array[i] < pivot) i++;
+            while(array[j] > pivot) j--;
+            if(i <= j) {
+                SWAP(mp_float_t, array[i], array[j]);
+                i++;
+                j--;
+            }
+        }
+        if(k <= j) {
+            right = j;
+        } else if(k >= i) {
+            left = i;
+        } else {
+            break;
+        }
+    }
+    return array[k];
+}
 
-    ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(args[0].u_obj);
-    if(ndarray->len == 0) {
-        return mp_obj_new_float(MICROPY_FLOAT_C_FUN(nan)(""));
+static mp_float_t numerical_quantile_value(mp_float_t *array, size_t len, mp_float_t q) {
+    // linear interpolation between the two closest ranks, as in numpy's default method
+    mp_float_t position = q * (len - 1);
+    size_t lo = (size_t)MICROPY_FLOAT_C_FUN(floor)(position);
+    mp_float_t fraction = position - lo;
+    mp_float_t value = numerical_select(array, len, lo);
+    if((fraction > MICROPY_FLOAT_CONST(0.0)) && (lo + 1 < len)) {
+        // after the selection, the next rank is the smallest value to the right of lo
+        mp_float_t next = array[lo + 1];
+        for(size_t i = lo + 2; i < len; i++) {
+            if(array[i] < next) {
+                next = array[i];
+            }
+        }
+        if(fraction == MICROPY_FLOAT_CONST(0.5)) {
+            value = (value + next) * MICROPY_FLOAT_CONST(0.5);
+        } else {
+            value += fraction * (next - value);
+        }
     }
+    return value;
+}
+
+static void numerical_quantile_fill(ndarray_obj_t *ndarray, mp_float_t *scratch) {
+    // copies all elements of ndarray into scratch as floats
+    mp_float_t (*func)(void *) = ndarray_get_float_function(ndarray->dtype);
+    uint8_t *array = (uint8_t *)ndarray->array;
+    #if ULAB_MAX_DIMS > 3
+    size_t i = 0;
+    do {
+    #endif
+        #if ULAB_MAX_DIMS > 2
+        size_t j = 0;
+        do {
+        #endif
+            #if ULAB_MAX_DIMS > 1
+            size_t k = 0;
+            do {
+            #endif
+                size_t l = 0;
+                do {
+                    *scratch++ = func(array);
+                    array += ndarray->strides[ULAB_MAX_DIMS - 1];
+                    l++;
+                } while(l < ndarray->shape[ULAB_MAX_DIMS - 1]);
+            #if ULAB_MAX_DIMS > 1
+                array -= ndarray->strides[ULAB_MAX_DIMS - 1] * ndarray->shape[ULAB_MAX_DIMS-1];
+                array += ndarray->strides[ULAB_MAX_DIMS - 2];
+                k++;
+            } while(k < ndarray->shape[ULAB_MAX_DIMS - 2]);
+            #endif
+        #if ULAB_MAX_DIMS > 2
+            array -= ndarray->strides[ULAB_MAX_DIMS - 2] * ndarray->shape[ULAB_MAX_DIMS-2];
+            array += ndarray->strides[ULAB_MAX_DIMS - 3];
+            j++;
+        } while(j < ndarray->shape[ULAB_MAX_DIMS - 3]);
+        #endif
+    #if ULAB_MAX_DIMS > 3
+        array -= ndarray->strides[ULAB_MAX_DIMS - 3] * ndarray->shape[ULAB_MAX_DIMS-3];
+        array += ndarray->strides[ULAB_MAX_DIMS - 4];
+        i++;
+    } while(i < ndarray->shape[ULAB_MAX_DIMS - 4]);
+    #endif
+}
 
-    ndarray = MP_OBJ_TO_PTR(numerical_sort_helper(args[0].u_obj, args[1].u_obj, 0));
+static mp_obj_t numerical_quantile_helper(mp_obj_t oin, mp_obj_t axis, mp_obj_t q_in, mp_float_t scale) {
+    // the common implementation of median, percentile, and quantile; the values of q_in are divided
+    // by scale, and for each lane along axis, a single scratch buffer is partitioned in place
+    if(!mp_obj_is_type(oin, &ulab_ndarray_type)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("input must be an ndarray"));
+    }
+    ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(oin);
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
 
-    if((args[1].u_obj == mp_const_none) || (ndarray->ndim == 1)) {
-        // at this point, the array holding the sorted values should be flat
-        uint8_t *array = (uint8_t *)ndarray->array;
-        size_t len = ndarray->len;
-        array += (len >> 1) * ndarray->itemsize;
-        mp_float_t median = ndarray_get_float_value(array, ndarray->dtype);
-        if(!(len & 0x01)) { // len is an even number
-            array -= ndarray->itemsize;
-            median += ndarray_get_float_value(array, ndarray->dtype);
-            median *= MICROPY_FLOAT_CONST(0.5);
+    // q_in is None for the median
+    bool q_is_scalar = (q_in == mp_const_none) || mp_obj_is_int(q_in) || mp_obj_is_float(q_in);
+    size_t nq = 1;
+    if(!q_is_scalar) {
+        if(!ndarray_object_is_array_like(q_in)) {
+            mp_raise_TypeError(MP_ERROR_TEXT("q must be a scalar or an iterable"));
         }
-        return mp_obj_new_float(median);
+        nq = (size_t)mp_obj_get_int(mp_obj_len_maybe(q_in));
+    }
+    mp_float_t *q = m_new(mp_float_t, nq);
+    if(q_in == mp_const_none) {
+        q[0] = MICROPY_FLOAT_CONST(0.5);
+    } else if(q_is_scalar) {
+        q[0] = mp_obj_get_float(q_in);
     } else {
-        int8_t ax = tools_get_axis(args[1].u_obj, ndarray->ndim);
+        fill_array_iterable(q, q_in);
+    }
+    for(size_t i = 0; i < nq; i++) {
+        q[i] /= scale;
+        if(!(q[i] >= MICROPY_FLOAT_CONST(0.0)) || !(q[i] <= MICROPY_FLOAT_CONST(1.0))) {
+            mp_raise_ValueError(MP_ERROR_TEXT("q is out of range"));
+        }
+    }
 
-        size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
-        int32_t *strides = m_new0(int32_t, ULAB_MAX_DIMS);
-        numerical_reduce_axes(ndarray, ax, shape, strides);
+    ndarray_obj_t *results = NULL;
+    mp_float_t *rarray = NULL;
 
-        ax = ULAB_MAX_DIMS - ndarray->ndim + ax;
-        ndarray_obj_t *results = ndarray_new_dense_ndarray(ndarray->ndim-1, shape, NDARRAY_FLOAT);
-        m_del(size_t, shape, ULAB_MAX_DIMS);
+    if((axis == mp_const_none) || (ndarray->ndim == 1)) {
+        if(!q_is_scalar) {
+            results = ndarray_new_linear_array(nq, NDARRAY_FLOAT);
+            rarray = (mp_float_t *)results->array;
+        }
+        if(ndarray->len == 0) {
+            for(size_t i = 0; i < nq; i++) {
+                q[i] = MICROPY_FLOAT_C_FUN(nan)("");
+            }
+        } else {
+            if(axis != mp_const_none) {
+                tools_get_axis(axis, ndarray->ndim);
+            }
+            mp_float_t *scratch = ulab_scratch_new(mp_float_t, ndarray->len);
+            numerical_quantile_fill(ndarray, scratch);
+            for(size_t i = 0; i < nq; i++) {
+                q[i] = numerical_quantile_value(scratch, ndarray->len, q[i]);
+            }
+            ulab_scratch_del(mp_float_t, scratch, ndarray->len);
+        }
+        if(q_is_scalar) {
+            mp_obj_t out = mp_obj_new_float(q[0]);
+            m_del(mp_float_t, q, nq);
+            return out;
+        }
+        memcpy(rarray, q, nq * sizeof(mp_float_t));
+        m_del(mp_float_t, q, nq);
+        return MP_OBJ_FROM_PTR(results);
+    }
 
-        mp_float_t *rarray = (mp_float_t *)results->array;
+    int8_t ax = tools_get_axis(axis, ndarray->ndim);
 
-        uint8_t *array = (uint8_t *)ndarray->array;
+    size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
+    int32_t *strides = m_new0(int32_t, ULAB_MAX_DIMS);
+    numerical_reduce_axes(ndarray, ax, shape, strides);
+    ax = ULAB_MAX_DIMS - ndarray->ndim + ax;
 
-        size_t len = ndarray->shape[ax];
+    if(q_is_scalar) {
+        results = ndarray_new_dense_ndarray(ndarray->ndim - 1, shape, NDARRAY_FLOAT);
+    } else {
+        // the first axis of the results runs over the values of q
+        shape[ULAB_MAX_DIMS - ndarray->ndim] = nq;
+        results = ndarray_new_dense_ndarray(ndarray->ndim, shape, NDARRAY_FLOAT);
+        shape[ULAB_MAX_DIMS - ndarray->ndim] = 0;
+    }
+    rarray = (mp_float_t *)results->array;
+    size_t lanes = results->len / nq;
+
+    size_t len = ndarray->shape[ax];
+    if(len == 0) {
+        for(size_t i = 0; i < results->len; i++) {
+            rarray[i] = MICROPY_FLOAT_C_FUN(nan)("");
+        }
+    } else {
+        mp_float_t (*func)(void *) = ndarray_get_float_function(ndarray->dtype);
+        mp_float_t *scratch = ulab_scratch_new(mp_float_t, len);
+        uint8_t *array = (uint8_t *)ndarray->array;
 
         #if ULAB_MAX_DIMS > 3
         size_t i = 0;
@@ -1114,18 +2088,16 @@ mp_obj_t numerical_median(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
             #endif
                 size_t k = 0;
                 do {
-                    array += ndarray->strides[ax] * (len >> 1);
-                    mp_float_t median = ndarray_get_float_value(array, ndarray->dtype);
-                    if(!(len & 0x01)) { // len is an even number
-                        array -= ndarray->strides[ax];
-                        median += ndarray_get_float_value(array, ndarray->dtype);
-                        median *= MICROPY_FLOAT_CONST(0.5);
+                    for(size_t l = 0; l < len; l++) {
+                        scratch[l] = func(array);
                         array += ndarray->strides[ax];
                     }
-                    array -= ndarray->strides[ax] * (len >> 1);
-                    array += strides[ULAB_MAX_DIMS - 1];
-                    *rarray = median;
+                    array -= ndarray->strides[ax] * len;
+                    for(size_t m = 0; m < nq; m++) {
+                        rarray[m * lanes] = numerical_quantile_value(scratch, len, q[m]);
+                    }
                     rarray++;
+                    array += strides[ULAB_MAX_DIMS - 1];
                     k++;
                 } while(k < shape[ULAB_MAX_DIMS - 1]);
             #if ULAB_MAX_DIMS > 2
@@ -1140,17 +2112,82 @@ mp_obj_t numerical_median(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
             i++;
         } while(i < shape[ULAB_MAX_DIMS - 3]);
         #endif
+        ulab_scratch_del(mp_float_t, scratch, len);
+    }
+    m_del(size_t, shape, ULAB_MAX_DIMS);
+    m_del(int32_t, strides, ULAB_MAX_DIMS);
+    m_del(mp_float_t, q, nq);
+    return MP_OBJ_FROM_PTR(results);
+}
+#endif /* ULAB_NUMPY_HAS_MEDIAN | ULAB_NUMPY_HAS_PERCENTILE | ULAB_NUMPY_HAS_QUANTILE */
 
-        return MP_OBJ_FROM_PTR(results);
+#if ULAB_NUMPY_HAS_MEDIAN
+//| def median(array: ulab.numpy.ndarray, *, axis: int = -1) -> ulab.numpy.ndarray:
+//|     """Find the median value in an array along the given axis, or along all axes if axis is None."""
+//|     ...
+//|
+
+mp_obj_t numerical_median(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_axis, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    if(!mp_obj_is_type(args[0].u_obj, &ulab_ndarray_type)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("median argument must be an ndarray"));
     }
-    return mp_const_none;
+    return numerical_quantile_helper(args[0].u_obj, args[1].u_obj, mp_const_none, MICROPY_FLOAT_CONST(1.0));
 }
 
 MP_DEFINE_CONST_FUN_OBJ_KW(numerical_median_obj, 1, numerical_median);
 #endif
 
+#if ULAB_NUMPY_HAS_PERCENTILE | ULAB_NUMPY_HAS_QUANTILE
+static mp_obj_t numerical_percentile_quantile(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args, mp_float_t scale) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_q, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_axis, MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    return numerical_quantile_helper(args[0].u_obj, args[2].u_obj, args[1].u_obj, scale);
+}
+#endif
+
+#if ULAB_NUMPY_HAS_PERCENTILE
+//| def percentile(array: ulab.numpy.ndarray, q: _ArrayLike, axis: Optional[int] = None) -> Union[_float, ulab.numpy.ndarray]:
+//|     """Compute the q-th percentile of the data along the given axis, or along all axes if axis is None.
+//|     q must be between 0 and 100 inclusive, and it can be a scalar, or an iterable."""
+//|     ...
+//|
+
+mp_obj_t numerical_percentile(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    return numerical_percentile_quantile(n_args, pos_args, kw_args, MICROPY_FLOAT_CONST(100.0));
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(numerical_percentile_obj, 2, numerical_percentile);
+#endif
+
+#if ULAB_NUMPY_HAS_QUANTILE
+//| def quantile(array: ulab.numpy.ndarray, q: _ArrayLike, axis: Optional[int] = None) -> Union[_float, ulab.numpy.ndarray]:
+//|     """Compute the q-th quantile of the data along the given axis, or along all axes if axis is None.
+//|     q must be between 0 and 1 inclusive, and it can be a scalar, or an iterable."""
+//|     ...
+//|
+
+mp_obj_t numerical_quantile(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    return numerical_percentile_quantile(n_args, pos_args, kw_args, MICROPY_FLOAT_CONST(1.0));
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(numerical_quantile_obj, 2, numerical_quantile);
+#endif
+
 #if ULAB_NUMPY_HAS_MINMAX
-//| def min(array: _ArrayLike, *, axis: Optional[int] = None) -> _float:
+//| def min(array: _ArrayLike, *, axis: Optional[int] = None, keepdims: bool = False) -> _float:
 //|     """Return the minimum element of the 1D array"""
 //|     ...
 //|
@@ -1328,9 +2365,11 @@ MP_DEFINE_CONST_FUN_OBJ_KW(numerical_roll_obj, 2, numerical_roll);
 #endif
 
 #if ULAB_NUMPY_HAS_SORT
-//| def sort(array: ulab.numpy.ndarray, *, axis: int = -1) -> ulab.numpy.ndarray:
+//| def sort(array: ulab.numpy.ndarray, *, axis: int = -1, kind: Optional[str] = None) -> ulab.numpy.ndarray:
 //|     """Sort the array along the given axis, or along all axes if axis is None.
-//|        The array is modified in place."""
+//|        The array is modified in place. kind can be 'quicksort' (default), 'heapsort',
+//|        'stable', or 'mergesort'; integer arrays are sorted by counting, or radix sort,
+//|        unless kind is 'heapsort'."""
 //|     ...
 //|
 
@@ -1338,12 +2377,13 @@ mp_obj_t numerical_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_ar
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
         { MP_QSTR_axis, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_kind, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
     };
 
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
-    return numerical_sort_helper(args[0].u_obj, args[1].u_obj, 0);
+    return numerical_sort_helper(args[0].u_obj, args[1].u_obj, args[2].u_obj, 0);
 }
 
 MP_DEFINE_CONST_FUN_OBJ_KW(numerical_sort_obj, 1, numerical_sort);
@@ -1355,19 +2395,20 @@ static mp_obj_t numerical_sort_inplace(size_t n_args, const mp_obj_t *pos_args,
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
         { MP_QSTR_axis, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_int = -1 } },
+        { MP_QSTR_kind, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
     };
 
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
-    return numerical_sort_helper(args[0].u_obj, args[1].u_obj, 1);
+    return numerical_sort_helper(args[0].u_obj, args[1].u_obj, args[2].u_obj, 1);
 }
 
 MP_DEFINE_CONST_FUN_OBJ_KW(numerical_sort_inplace_obj, 1, numerical_sort_inplace);
 #endif /* NDARRAY_HAS_SORT */
 
 #if ULAB_NUMPY_HAS_STD
-//| def std(array: _ArrayLike, *, axis: Optional[int] = None, ddof: int = 0) -> _float:
+//| def std(array: _ArrayLike, *, axis: Optional[int] = None, ddof: int = 0, keepdims: bool = False) -> _float:
 //|     """Return the standard deviation of the array, as a number if axis is None, otherwise as an array."""
 //|     ...
 //|
@@ -1377,6 +2418,7 @@ mp_obj_t numerical_std(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_arg
         { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } } ,
         { MP_QSTR_axis, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
         { MP_QSTR_ddof, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_keepdims, MP_ARG_KW_ONLY | MP_ARG_BOOL, { .u_bool = false } },
     };
 
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
@@ -1393,7 +2435,8 @@ mp_obj_t numerical_std(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_arg
         return numerical_sum_mean_std_iterable(oin, NUMERICAL_STD, ddof);
     } else if(mp_obj_is_type(oin, &ulab_ndarray_type)) {
         ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(oin);
-        return numerical_sum_mean_std_ndarray(ndarray, axis, NUMERICAL_STD, ddof);
+        mp_obj_t result = numerical_sum_mean_std_ndarray(ndarray, axis, NUMERICAL_STD, ddof);
+        return args[3].u_bool ? numerical_keepdims(result, ndarray, axis, NDARRAY_FLOAT) : result;
     } else {
         mp_raise_TypeError(MP_ERROR_TEXT("input must be tuple, list, range, or ndarray"));
     }
@@ -1404,7 +2447,7 @@ MP_DEFINE_CONST_FUN_OBJ_KW(numerical_std_obj, 1, numerical_std);
 #endif
 
 #if ULAB_NUMPY_HAS_SUM
-//| def sum(array: _ArrayLike, *, axis: Optional[int] = None) -> Union[_float, int, ulab.numpy.ndarray]:
+//| def sum(array: _ArrayLike, *, axis: Optional[int] = None, keepdims: bool = False) -> Union[_float, int, ulab.numpy.ndarray]:
 //|     """Return the sum of the array, as a number if axis is None, otherwise as an array."""
 //|     ...
 //|
@@ -15,7 +15,8 @@
 #include "../ulab.h"
 #include "../ndarray.h"
 
-// TODO: implement cumsum
+// floats are summed pairwise in blocks of this length
+#define NUMERICAL_PAIRWISE_BLOCK        (128)
 
 #define RUN_ARGMIN1(ndarray, type, array, results, rarray, index, op)\
 ({\
@@ -46,9 +47,33 @@
     (rarray) += (results)->itemsize;\
 })
 
-#define RUN_SUM1(type, array, results, rarray, ss)\
+// the running sum, or product of a lane, with an accumulator of the output type
+#define NUMERICAL_CUMULATE_LOOP(type, rtype, array, rarray, lane) do {\
+    uint8_t *_array = (array);\
+    uint8_t *_rarray = (rarray);\
+    if((lane)->optype == NUMERICAL_CUMPROD) {\
+        rtype _acc = 1;\
+        for(size_t _i = 0; _i < (lane)->len; _i++) {\
+            _acc *= (rtype)(*((type *)_array));\
+            *((rtype *)_rarray) = _acc;\
+            _array += (lane)->stride;\
+            _rarray += (lane)->rstride;\
+        }\
+    } else {\
+        rtype _acc = 0;\
+        for(size_t _i = 0; _i < (lane)->len; _i++) {\
+            _acc += (rtype)(*((type *)_array));\
+            *((rtype *)_rarray) = _acc;\
+            _array += (lane)->stride;\
+            _rarray += (lane)->rstride;\
+        }\
+    }\
+} while(0)
+
+// the sum is accumulated in stype, which may be wider than the type of the input
+#define RUN_SUM1(type, stype, array, results, rarray, ss)\
 ({\
-    type sum = 0;\
+    stype sum = 0;\
     for(size_t i=0; i < (ss).shape[0]; i++) {\
         sum += *((type *)(array));\
         (array) += (ss).strides[0];\
@@ -57,6 +82,56 @@
     (rarray) += (results)->itemsize;\
 })
 
+// When a contiguous array is reduced along an axis other than the last one, the array is
+// traversed as outer blocks of n rows, each of length inner. The rows are added to the outer
+// results, so that both the input, and the output are read contiguously.
+#define RUN_SUM_ROWS(type, stype, array, rarray, outer, n, inner) do {\
+    type *_array = (type *)(array);\
+    stype *_rarray = (stype *)(rarray);\
+    for(size_t _o = 0; _o < (outer); _o++) {\
+        for(size_t _i = 0; _i < (n); _i++) {\
+            for(size_t _j = 0; _j < (inner); _j++) {\
+                _rarray[_j] += _array[_j];\
+            }\
+            _array += (inner);\
+        }\
+        _rarray += (inner);\
+    }\
+} while(0)
+
+// the first row is taken as the best one, and the other rows are compared to it element-wise;
+// rarray receives either the indices, or the values; best is a scratch row of length inner
+// for the values, if the indices are returned
+#define RUN_ARGMIN_ROWS(type, array, rarray, best, outer, n, inner, op) do {\
+    type *_array = (type *)(array);\
+    uint16_t *_index = (uint16_t *)(rarray);\
+    uint8_t _arg = ((op) == NUMERICAL_ARGMIN) || ((op) == NUMERICAL_ARGMAX);\
+    for(size_t _o = 0; _o < (outer); _o++) {\
+        type *_best = _arg ? (type *)(best) : (type *)(rarray) + _o * (inner);\
+        memcpy(_best, _array, (inner) * sizeof(type));\
+        _array += (inner);\
+        for(uint16_t _i = 1; _i < (n); _i++) {\
+            if(((op) == NUMERICAL_MAX) || ((op) == NUMERICAL_ARGMAX)) {\
+                for(size_t _j = 0; _j < (inner); _j++) {\
+                    if(_array[_j] > _best[_j]) {\
+                        _best[_j] = _array[_j];\
+                        if(_arg) _index[_j] = _i;\
+                    }\
+                }\
+            } else {\
+                for(size_t _j = 0; _j < (inner); _j++) {\
+                    if(_array[_j] < _best[_j]) {\
+                        _best[_j] = _array[_j];\
+                        if(_arg) _index[_j] = _i;\
+                    }\
+                }\
+            }\
+            _array += (inner);\
+        }\
+        _index += (inner);\
+    }\
+} while(0)
+
 // The mean could be calculated by simply dividing the sum by
 // the number of elements, but that method is numerically unstable
 #define RUN_MEAN1(type, array, rarray, ss)\
@@ -86,19 +161,49 @@
     *(rarray)++ = MICROPY_FLOAT_C_FUN(sqrt)(S / (div));\
 })
 
+// The statistics of a contiguous block of k samples, each of which is a row of length m.
+// The means, and the sums of the squared deviations from the means are added to the zeroed
+// bmean, and bm2 in two passes over the rows, while vmin, and vmax are updated in place.
+// The block can then be merged into running statistics with the parallel form of Welford's
+// algorithm (Chan et al.).
+#define RUN_BLOCK_STATS(type, array, k, m, bmean, bm2, vmin, vmax) do {\
+    type *_row = (type *)(array);\
+    for(size_t _i = 0; _i < (k); _i++) {\
+        for(size_t _j = 0; _j < (m); _j++) {\
+            mp_float_t _value = (mp_float_t)_row[_j];\
+            (bmean)[_j] += _value;\
+            if(_value < (vmin)[_j]) (vmin)[_j] = _value;\
+            if(_value > (vmax)[_j]) (vmax)[_j] = _value;\
+        }\
+        _row += (m);\
+    }\
+    for(size_t _j = 0; _j < (m); _j++) {\
+        (bmean)[_j] /= (mp_float_t)(k);\
+    }\
+    _row = (type *)(array);\
+    for(size_t _i = 0; _i < (k); _i++) {\
+        for(size_t _j = 0; _j < (m); _j++) {\
+            mp_float_t _value = (mp_float_t)_row[_j] - (bmean)[_j];\
+            (bm2)[_j] += _value * _value;\
+        }\
+        _row += (m);\
+    }\
+} while(0)
+
+// the lanes are summed by the numerical_sum_<type> functions in numerical.c;
+// the standard deviation is calculated in two passes, so that no precision is lost
+// on the squares of the deviations from the mean
 #define RUN_MEAN_STD1(type, array, rarray, ss, div, isStd)\
 ({\
-    mp_float_t M = 0.0, m = 0.0, S = 0.0;\
-    for(size_t i=0; i < (ss).shape[0]; i++) {\
-        mp_float_t value = (mp_float_t)(*(type *)(array));\
-        m = M + (value - M) / (mp_float_t)(i+1);\
-        if(isStd) {\
-            S += (value - M) * (value - m);\
-        }\
-        M = m;\
-        (array) += (ss).strides[0];\
+    mp_float_t M = numerical_sum_##type((array), (ss).strides[0], (ss).shape[0], MICROPY_FLOAT_CONST(0.0), 0);\
+    M /= (mp_float_t)(ss).shape[0];\
+    if(isStd) {\
+        mp_float_t S = numerical_sum_##type((array), (ss).strides[0], (ss).shape[0], M, 1);\
+        *(rarray)++ = MICROPY_FLOAT_C_FUN(sqrt)(S / (div));\
+    } else {\
+        *(rarray)++ = M;\
     }\
-    *(rarray)++ = isStd ? MICROPY_FLOAT_C_FUN(sqrt)(S / (div)) : M;\
+    (array) += (ss).strides[0] * (ss).shape[0];\
 })
 
 #define RUN_DIFF1(ndarray, type, array, results, rarray, index, stencil, N)\
@@ -150,47 +255,9 @@
     }\
 })
 
-#define HEAP_ARGSORT1(type, array, increment, N, iarray, iincrement)\
-({\
-    type *_array = (type *)array;\
-    type tmp;\
-    uint16_t itmp, c, q = (N), p, r = (N) >> 1;\
-    assert(N);\
-    for (;;) {\
-        if (r > 0) {\
-            r--;\
-            itmp = (iarray)[r*(iincrement)];\
-            tmp = _array[itmp*(increment)];\
-        } else {\
-            q--;\
-            if(q == 0) {\
-                break;\
-            }\
-            itmp = (iarray)[q*(iincrement)];\
-            tmp = _array[itmp*(increment)];\
-            (iarray)[q*(iincrement)] = (iarray)[0];\
-        }\
-        p = r;\
-        c = r + r + 1;\
-        while (c < q) {\
-            if((c + 1 < q)  &&  (_array[(iarray)[(c+1)*(iincrement)]*(increment)] > _array[(iarray)[c*(iincrement)]*(increment)])) {\
-                c++;\
-            }\
-            if(_array[(iarray)[c*(iincrement)]*(increment)] > tmp) {\
-                (iarray)[p*(iincrement)] = (iarray)[c*(iincrement)];\
-                p = c;\
-                c = p + p + 1;\
-            } else {\
-                break;\
-            }\
-        }\
-        (iarray)[p*(iincrement)] = itmp;\
-    }\
-})
-
 #if ULAB_MAX_DIMS == 1
-#define RUN_SUM(type, array, results, rarray, ss) do {\
-    RUN_SUM1(type, (array), (results), (rarray), (ss));\
+#define RUN_SUM(type, stype, array, results, rarray, ss) do {\
+    RUN_SUM1(type, stype, (array), (results), (rarray), (ss));\
 } while(0)
 
 #define RUN_MEAN(type, array, rarray, ss) do {\
@@ -213,21 +280,21 @@
     RUN_DIFF1((ndarray), type, (array), (results), (rarray), (index), (stencil), (N));\
 } while(0)
 
-#define HEAPSORT(ndarray, type, array, shape, strides, index, increment, N) do {\
-    HEAPSORT1(type, (array), (increment), (N));\
+#define RUN_SORT(dtype, array, shape, strides, increment, N, kind, scratch) do {\
+    sort_values((dtype), (array), (increment), (N), (kind), (scratch));\
 } while(0)
 
-#define HEAP_ARGSORT(ndarray, type, array, shape, strides, index, increment, N, iarray, istrides, iincrement) do {\
-    HEAP_ARGSORT1(type, (array), (increment), (N), (iarray), (iincrement));\
+#define RUN_ARGSORT(dtype, array, shape, strides, increment, N, iarray, istrides, iincrement, kind, scratch) do {\
+    sort_indices((dtype), (array), (increment), (iarray), (iincrement), (N), (kind), (scratch));\
 } while(0)
 
 #endif
 
 #if ULAB_MAX_DIMS == 2
-#define RUN_SUM(type, array, results, rarray, ss) do {\
+#define RUN_SUM(type, stype, array, results, rarray, ss) do {\
     size_t l = 0;\
     do {\
-        RUN_SUM1(type, (array), (results), (rarray), (ss));\
+        RUN_SUM1(type, stype, (array), (results), (rarray), (ss));\
         (array) -= (ss).strides[0] * (ss).shape[0];\
         (array) += (ss).strides[ULAB_MAX_DIMS - 1];\
         l++;\
@@ -287,19 +354,19 @@
     } while(l < (results)->shape[ULAB_MAX_DIMS - 2]);\
 } while(0)
 
-#define HEAPSORT(ndarray, type, array, shape, strides, index, increment, N) do {\
+#define RUN_SORT(dtype, array, shape, strides, increment, N, kind, scratch) do {\
     size_t l = 0;\
     do {\
-        HEAPSORT1(type, (array), (increment), (N));\
+        sort_values((dtype), (array), (increment), (N), (kind), (scratch));\
         (array) += (strides)[ULAB_MAX_DIMS - 1];\
         l++;\
     } while(l < (shape)[ULAB_MAX_DIMS - 1]);\
 } while(0)
 
-#define HEAP_ARGSORT(ndarray, type, array, shape, strides, index, increment, N, iarray, istrides, iincrement) do {\
+#define RUN_ARGSORT(dtype, array, shape, strides, increment, N, iarray, istrides, iincrement, kind, scratch) do {\
     size_t l = 0;\
     do {\
-        HEAP_ARGSORT1(type, (array), (increment), (N), (iarray), (iincrement));\
+        sort_indices((dtype), (array), (increment), (iarray), (iincrement), (N), (kind), (scratch));\
         (array) += (strides)[ULAB_MAX_DIMS - 1];\
         (iarray) += (istrides)[ULAB_MAX_DIMS - 1];\
         l++;\
@@ -309,12 +376,12 @@
 #endif
 
 #if ULAB_MAX_DIMS == 3
-#define RUN_SUM(type, array, results, rarray, ss) do {\
+#define RUN_SUM(type, stype, array, results, rarray, ss) do {\
     size_t k = 0;\
     do {\
         size_t l = 0;\
         do {\
-            RUN_SUM1(type, (array), (results), (rarray), (ss));\
+            RUN_SUM1(type, stype, (array), (results), (rarray), (ss));\
             (array) -= (ss).strides[0] * (ss).shape[0];\
             (array) += (ss).strides[ULAB_MAX_DIMS - 1];\
             l++;\
@@ -409,12 +476,12 @@
     } while(k < (shape)[ULAB_MAX_DIMS - 3]);\
 } while(0)
 
-#define HEAPSORT(ndarray, type, array, shape, strides, index, increment, N) do {\
+#define RUN_SORT(dtype, array, shape, strides, increment, N, kind, scratch) do {\
     size_t k = 0;\
     do {\
         size_t l = 0;\
         do {\
-            HEAPSORT1(type, (array), (increment), (N));\
+            sort_values((dtype), (array), (increment), (N), (kind), (scratch));\
             (array) += (strides)[ULAB_MAX_DIMS - 1];\
             l++;\
         } while(l < (shape)[ULAB_MAX_DIMS - 1]);\
@@ -424,12 +491,12 @@
     } while(k < (shape)[ULAB_MAX_DIMS - 2]);\
 } while(0)
 
-#define HEAP_ARGSORT(ndarray, type, array, shape, strides, index, increment, N, iarray, istrides, iincrement) do {\
+#define RUN_ARGSORT(dtype, array, shape, strides, increment, N, iarray, istrides, iincrement, kind, scratch) do {\
     size_t k = 0;\
     do {\
         size_t l = 0;\
         do {\
-            HEAP_ARGSORT1(type, (array), (increment), (N), (iarray), (iincrement));\
+            sort_indices((dtype), (array), (increment), (iarray), (iincrement), (N), (kind), (scratch));\
             (array) += (strides)[ULAB_MAX_DIMS - 1];\
             (iarray) += (istrides)[ULAB_MAX_DIMS - 1];\
             l++;\
@@ -445,14 +512,14 @@
 #endif
 
 #if ULAB_MAX_DIMS == 4
-#define RUN_SUM(type, array, results, rarray, ss) do {\
+#define RUN_SUM(type, stype, array, results, rarray, ss) do {\
     size_t j = 0;\
     do {\
         size_t k = 0;\
         do {\
             size_t l = 0;\
             do {\
-                RUN_SUM1(type, (array), (results), (rarray), (ss));\
+                RUN_SUM1(type, stype, (array), (results), (rarray), (ss));\
                 (array) -= (ss).strides[0] * (ss).shape[0];\
                 (array) += (ss).strides[ULAB_MAX_DIMS - 1];\
                 l++;\
@@ -583,14 +650,14 @@
     } while(j < (shape)[ULAB_MAX_DIMS - 4]);\
 } while(0)
 
-#define HEAPSORT(ndarray, type, array, shape, strides, index, increment, N) do {\
+#define RUN_SORT(dtype, array, shape, strides, increment, N, kind, scratch) do {\
     size_t j = 0;\
     do {\
         size_t k = 0;\
         do {\
             size_t l = 0;\
             do {\
-                HEAPSORT1(type, (array), (increment), (N));\
+                sort_values((dtype), (array), (increment), (N), (kind), (scratch));\
                 (array) += (strides)[ULAB_MAX_DIMS - 1];\
                 l++;\
             } while(l < (shape)[ULAB_MAX_DIMS - 1]);\
@@ -604,14 +671,14 @@
     } while(j < (shape)[ULAB_MAX_DIMS - 3]);\
 } while(0)
 
-#define HEAP_ARGSORT(ndarray, type, array, shape, strides, index, increment, N, iarray, istrides, iincrement) do {\
+#define RUN_ARGSORT(dtype, array, shape, strides, increment, N, iarray, istrides, iincrement, kind, scratch) do {\
     size_t j = 0;\
     do {\
         size_t k = 0;\
         do {\
             size_t l = 0;\
             do {\
-                HEAP_ARGSORT1(type, (array), (increment), (N), (iarray), (iincrement));\
+                sort_indices((dtype), (array), (increment), (iarray), (iincrement), (N), (kind), (scratch));\
                 (array) += (strides)[ULAB_MAX_DIMS - 1];\
                 (iarray) += (istrides)[ULAB_MAX_DIMS - 1];\
                 l++;\
@@ -638,12 +705,17 @@ MP_DECLARE_CONST_FUN_OBJ_KW(numerical_argmax_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(numerical_argmin_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(numerical_argsort_obj);
 MP_DECLARE_CONST_FUN_OBJ_2(numerical_cross_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(numerical_cumprod_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(numerical_cumsum_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(numerical_cumulative_trapezoid_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(numerical_diff_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(numerical_flip_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(numerical_max_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(numerical_mean_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(numerical_median_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(numerical_min_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(numerical_percentile_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(numerical_quantile_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(numerical_roll_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(numerical_std_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(numerical_sum_obj);
@@ -25,11 +25,13 @@
 #include "fft/fft.h"
 #include "filter.h"
 #include "io/io.h"
+#include "lazy.h"
 #include "linalg/linalg.h"
 #include "numerical.h"
 #include "stats.h"
 #include "transform.h"
 #include "poly.h"
+#include "../ulab_profile.h"
 #include "vector.h"
 
 //| """Compatibility layer for numpy"""
@@ -76,9 +78,9 @@ ULAB_DEFINE_FLOAT_CONST(ulab_const_float_pi, MP_PI, 0x40490fdbUL, 0x400921fb5444
 static const mp_rom_map_elem_t ulab_numpy_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_numpy) },
     { MP_ROM_QSTR(MP_QSTR_ndarray), MP_ROM_PTR(&ulab_ndarray_type) },
-    { MP_ROM_QSTR(MP_QSTR_array), MP_ROM_PTR(&ndarray_array_constructor_obj) },
+    { MP_ROM_QSTR(MP_QSTR_array), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_array, ndarray_array_constructor_obj) },
     #if ULAB_NUMPY_HAS_FROMBUFFER
-        { MP_ROM_QSTR(MP_QSTR_frombuffer), MP_ROM_PTR(&create_frombuffer_obj) },
+        { MP_ROM_QSTR(MP_QSTR_frombuffer), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_frombuffer, create_frombuffer_obj) },
     #endif
     // math constants
     #if ULAB_NUMPY_HAS_E
@@ -93,13 +95,24 @@ static const mp_rom_map_elem_t ulab_numpy_globals_table[] = {
     #if ULAB_NUMPY_HAS_PI
         { MP_ROM_QSTR(MP_QSTR_pi), ULAB_REFERENCE_FLOAT_CONST(ulab_const_float_pi) },
     #endif
-    // class constants, always included
+    // class constants; the signed, and the 32-bit integer types, and float16 are optional
     { MP_ROM_QSTR(MP_QSTR_bool), MP_ROM_INT(NDARRAY_BOOL) },
     { MP_ROM_QSTR(MP_QSTR_uint8), MP_ROM_INT(NDARRAY_UINT8) },
-    { MP_ROM_QSTR(MP_QSTR_int8), MP_ROM_INT(NDARRAY_INT8) },
+    #if ULAB_SUPPORTS_INT8
+        { MP_ROM_QSTR(MP_QSTR_int8), MP_ROM_INT(NDARRAY_INT8) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_uint16), MP_ROM_INT(NDARRAY_UINT16) },
-    { MP_ROM_QSTR(MP_QSTR_int16), MP_ROM_INT(NDARRAY_INT16) },
+    #if ULAB_SUPPORTS_INT16
+        { MP_ROM_QSTR(MP_QSTR_int16), MP_ROM_INT(NDARRAY_INT16) },
+    #endif
+    #if ULAB_SUPPORTS_INT32
+        { MP_ROM_QSTR(MP_QSTR_int32), MP_ROM_INT(NDARRAY_INT32) },
+        { MP_ROM_QSTR(MP_QSTR_uint32), MP_ROM_INT(NDARRAY_UINT32) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_float), MP_ROM_INT(NDARRAY_FLOAT) },
+    #if ULAB_SUPPORTS_FLOAT16
+        { MP_ROM_QSTR(MP_QSTR_float16), MP_ROM_INT(NDARRAY_FLOAT16) },
+    #endif
     #if ULAB_SUPPORTS_COMPLEX
         { MP_ROM_QSTR(MP_QSTR_complex), MP_ROM_INT(NDARRAY_COMPLEX) },
     #endif
@@ -111,280 +124,319 @@ static const mp_rom_map_elem_t ulab_numpy_globals_table[] = {
         { MP_ROM_QSTR(MP_QSTR_linalg), MP_ROM_PTR(&ulab_linalg_module) },
     #endif
     #if ULAB_HAS_PRINTOPTIONS
-        { MP_ROM_QSTR(MP_QSTR_set_printoptions), MP_ROM_PTR(&ndarray_set_printoptions_obj) },
-        { MP_ROM_QSTR(MP_QSTR_get_printoptions), MP_ROM_PTR(&ndarray_get_printoptions_obj) },
+        { MP_ROM_QSTR(MP_QSTR_set_printoptions), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_set_printoptions, ndarray_set_printoptions_obj) },
+        { MP_ROM_QSTR(MP_QSTR_get_printoptions), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_get_printoptions, ndarray_get_printoptions_obj) },
     #endif
     #if ULAB_NUMPY_HAS_NDINFO
-        { MP_ROM_QSTR(MP_QSTR_ndinfo), MP_ROM_PTR(&ndarray_info_obj) },
+        { MP_ROM_QSTR(MP_QSTR_ndinfo), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_ndinfo, ndarray_info_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ARANGE
-        { MP_ROM_QSTR(MP_QSTR_arange), MP_ROM_PTR(&create_arange_obj) },
+        { MP_ROM_QSTR(MP_QSTR_arange), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_arange, create_arange_obj) },
     #endif
     #if ULAB_NUMPY_HAS_COMPRESS
-        { MP_ROM_QSTR(MP_QSTR_compress), MP_ROM_PTR(&transform_compress_obj) },
+        { MP_ROM_QSTR(MP_QSTR_compress), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_compress, transform_compress_obj) },
     #endif
     #if ULAB_NUMPY_HAS_CONCATENATE
-        { MP_ROM_QSTR(MP_QSTR_concatenate), MP_ROM_PTR(&create_concatenate_obj) },
+        { MP_ROM_QSTR(MP_QSTR_concatenate), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_concatenate, create_concatenate_obj) },
     #endif
     #if ULAB_NUMPY_HAS_DELETE
-        { MP_ROM_QSTR(MP_QSTR_delete), MP_ROM_PTR(&transform_delete_obj) },
+        { MP_ROM_QSTR(MP_QSTR_delete), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_delete, transform_delete_obj) },
     #endif
     #if ULAB_NUMPY_HAS_DIAG
         #if ULAB_MAX_DIMS > 1
-            { MP_ROM_QSTR(MP_QSTR_diag), MP_ROM_PTR(&create_diag_obj) },
+            { MP_ROM_QSTR(MP_QSTR_diag), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_diag, create_diag_obj) },
         #endif
     #endif
     #if ULAB_NUMPY_HAS_EMPTY
-        { MP_ROM_QSTR(MP_QSTR_empty), MP_ROM_PTR(&create_zeros_obj) },
+        { MP_ROM_QSTR(MP_QSTR_empty), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_empty, create_zeros_obj) },
     #endif
     #if ULAB_MAX_DIMS > 1
         #if ULAB_NUMPY_HAS_EYE
-            { MP_ROM_QSTR(MP_QSTR_eye), MP_ROM_PTR(&create_eye_obj) },
+            { MP_ROM_QSTR(MP_QSTR_eye), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_eye, create_eye_obj) },
         #endif
     #endif /* ULAB_MAX_DIMS */
+    #if ULAB_NUMPY_HAS_PUT
+        { MP_ROM_QSTR(MP_QSTR_put), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_put, transform_put_obj) },
+    #endif
+    #if ULAB_NUMPY_HAS_TAKE
+        { MP_ROM_QSTR(MP_QSTR_take), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_take, transform_take_obj) },
+    #endif
     // functions of the approx sub-module
     #if ULAB_NUMPY_HAS_INTERP
-        { MP_ROM_QSTR(MP_QSTR_interp), MP_ROM_PTR(&approx_interp_obj) },
+        { MP_ROM_QSTR(MP_QSTR_interp), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_interp, approx_interp_obj) },
+    #endif
+    #if ULAB_NUMPY_HAS_INTERPOLATOR
+        { MP_ROM_QSTR(MP_QSTR_interpolator), MP_ROM_PTR(&approx_interpolator_type) },
     #endif
     #if ULAB_NUMPY_HAS_TRAPZ
-        { MP_ROM_QSTR(MP_QSTR_trapz), MP_ROM_PTR(&approx_trapz_obj) },
+        { MP_ROM_QSTR(MP_QSTR_trapz), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_trapz, approx_trapz_obj) },
     #endif
     // functions of the create sub-module
     #if ULAB_NUMPY_HAS_FULL
-        { MP_ROM_QSTR(MP_QSTR_full), MP_ROM_PTR(&create_full_obj) },
+        { MP_ROM_QSTR(MP_QSTR_full), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_full, create_full_obj) },
     #endif
     #if ULAB_NUMPY_HAS_LINSPACE
-        { MP_ROM_QSTR(MP_QSTR_linspace), MP_ROM_PTR(&create_linspace_obj) },
+        { MP_ROM_QSTR(MP_QSTR_linspace), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_linspace, create_linspace_obj) },
     #endif
     #if ULAB_NUMPY_HAS_LOGSPACE
-        { MP_ROM_QSTR(MP_QSTR_logspace), MP_ROM_PTR(&create_logspace_obj) },
+        { MP_ROM_QSTR(MP_QSTR_logspace), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_logspace, create_logspace_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ONES
-        { MP_ROM_QSTR(MP_QSTR_ones), MP_ROM_PTR(&create_ones_obj) },
+        { MP_ROM_QSTR(MP_QSTR_ones), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_ones, create_ones_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ZEROS
-        { MP_ROM_QSTR(MP_QSTR_zeros), MP_ROM_PTR(&create_zeros_obj) },
+        { MP_ROM_QSTR(MP_QSTR_zeros), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_zeros, create_zeros_obj) },
     #endif
     #if ULAB_NUMPY_HAS_CLIP
-        { MP_ROM_QSTR(MP_QSTR_clip), MP_ROM_PTR(&compare_clip_obj) },
+        { MP_ROM_QSTR(MP_QSTR_clip), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_clip, compare_clip_obj) },
     #endif
     #if ULAB_NUMPY_HAS_EQUAL
-        { MP_ROM_QSTR(MP_QSTR_equal), MP_ROM_PTR(&compare_equal_obj) },
+        { MP_ROM_QSTR(MP_QSTR_equal), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_equal, compare_equal_obj) },
     #endif
     #if ULAB_NUMPY_HAS_NOTEQUAL
-        { MP_ROM_QSTR(MP_QSTR_not_equal), MP_ROM_PTR(&compare_not_equal_obj) },
+        { MP_ROM_QSTR(MP_QSTR_not_equal), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_not_equal, compare_not_equal_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ISFINITE
-        { MP_ROM_QSTR(MP_QSTR_isfinite), MP_ROM_PTR(&compare_isfinite_obj) },
+        { MP_ROM_QSTR(MP_QSTR_isfinite), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_isfinite, compare_isfinite_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ISINF
-        { MP_ROM_QSTR(MP_QSTR_isinf), MP_ROM_PTR(&compare_isinf_obj) },
+        { MP_ROM_QSTR(MP_QSTR_isinf), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_isinf, compare_isinf_obj) },
     #endif
     #if ULAB_NUMPY_HAS_MAXIMUM
-        { MP_ROM_QSTR(MP_QSTR_maximum), MP_ROM_PTR(&compare_maximum_obj) },
+        { MP_ROM_QSTR(MP_QSTR_maximum), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_maximum, compare_maximum_obj) },
     #endif
     #if ULAB_NUMPY_HAS_MINIMUM
-        { MP_ROM_QSTR(MP_QSTR_minimum), MP_ROM_PTR(&compare_minimum_obj) },
+        { MP_ROM_QSTR(MP_QSTR_minimum), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_minimum, compare_minimum_obj) },
+    #endif
+    #if ULAB_NUMPY_HAS_COUNT_NONZERO
+        { MP_ROM_QSTR(MP_QSTR_count_nonzero), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_count_nonzero, compare_count_nonzero_obj) },
+    #endif
+    #if ULAB_NUMPY_HAS_FLATNONZERO
+        { MP_ROM_QSTR(MP_QSTR_flatnonzero), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_flatnonzero, compare_flatnonzero_obj) },
     #endif
     #if ULAB_NUMPY_HAS_NONZERO
-        { MP_ROM_QSTR(MP_QSTR_nonzero), MP_ROM_PTR(&compare_nonzero_obj) },
+        { MP_ROM_QSTR(MP_QSTR_nonzero), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_nonzero, compare_nonzero_obj) },
     #endif
     #if ULAB_NUMPY_HAS_WHERE
-        { MP_ROM_QSTR(MP_QSTR_where), MP_ROM_PTR(&compare_where_obj) },
+        { MP_ROM_QSTR(MP_QSTR_where), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_where, compare_where_obj) },
     #endif
     // bitwise operators
     #if ULAB_NUMPY_HAS_BITWISE_AND
-        { MP_ROM_QSTR(MP_QSTR_bitwise_and), MP_ROM_PTR(&bitwise_bitwise_and_obj) },
+        { MP_ROM_QSTR(MP_QSTR_bitwise_and), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_bitwise_and, bitwise_bitwise_and_obj) },
     #endif
     #if ULAB_NUMPY_HAS_BITWISE_OR
-        { MP_ROM_QSTR(MP_QSTR_bitwise_or), MP_ROM_PTR(&bitwise_bitwise_or_obj) },
+        { MP_ROM_QSTR(MP_QSTR_bitwise_or), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_bitwise_or, bitwise_bitwise_or_obj) },
     #endif
     #if ULAB_NUMPY_HAS_BITWISE_XOR
-        { MP_ROM_QSTR(MP_QSTR_bitwise_xor), MP_ROM_PTR(&bitwise_bitwise_xor_obj) },
+        { MP_ROM_QSTR(MP_QSTR_bitwise_xor), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_bitwise_xor, bitwise_bitwise_xor_obj) },
     #endif
     #if ULAB_NUMPY_HAS_LEFT_SHIFT
-        { MP_ROM_QSTR(MP_QSTR_left_shift), MP_ROM_PTR(&left_shift_obj) },
+        { MP_ROM_QSTR(MP_QSTR_left_shift), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_left_shift, left_shift_obj) },
     #endif
     #if ULAB_NUMPY_HAS_RIGHT_SHIFT
-        { MP_ROM_QSTR(MP_QSTR_right_shift), MP_ROM_PTR(&right_shift_obj) },
+        { MP_ROM_QSTR(MP_QSTR_right_shift), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_right_shift, right_shift_obj) },
     #endif
     // functions of the filter sub-module
     #if ULAB_NUMPY_HAS_CONVOLVE
-        { MP_ROM_QSTR(MP_QSTR_convolve), MP_ROM_PTR(&filter_convolve_obj) },
+        { MP_ROM_QSTR(MP_QSTR_convolve), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_convolve, filter_convolve_obj) },
+    #endif
+    #if ULAB_NUMPY_HAS_CONVOLVE & ULAB_NUMPY_HAS_ACONVOLVE
+        { MP_ROM_QSTR(MP_QSTR_aconvolve), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_aconvolve, filter_aconvolve_obj) },
     #endif
     // functions of the numerical sub-module
     #if ULAB_NUMPY_HAS_ALL
-        { MP_ROM_QSTR(MP_QSTR_all), MP_ROM_PTR(&numerical_all_obj) },
+        { MP_ROM_QSTR(MP_QSTR_all), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_all, numerical_all_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ANY
-        { MP_ROM_QSTR(MP_QSTR_any), MP_ROM_PTR(&numerical_any_obj) },
+        { MP_ROM_QSTR(MP_QSTR_any), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_any, numerical_any_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ARGMINMAX
-        { MP_ROM_QSTR(MP_QSTR_argmax), MP_ROM_PTR(&numerical_argmax_obj) },
-        { MP_ROM_QSTR(MP_QSTR_argmin), MP_ROM_PTR(&numerical_argmin_obj) },
+        { MP_ROM_QSTR(MP_QSTR_argmax), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_argmax, numerical_argmax_obj) },
+        { MP_ROM_QSTR(MP_QSTR_argmin), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_argmin, numerical_argmin_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ARGSORT
-        { MP_ROM_QSTR(MP_QSTR_argsort), MP_ROM_PTR(&numerical_argsort_obj) },
+        { MP_ROM_QSTR(MP_QSTR_argsort), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_argsort, numerical_argsort_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ASARRAY
-        { MP_ROM_QSTR(MP_QSTR_asarray), MP_ROM_PTR(&create_asarray_obj) },
+        { MP_ROM_QSTR(MP_QSTR_asarray), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_asarray, create_asarray_obj) },
     #endif
     #if ULAB_NUMPY_HAS_CROSS
-        { MP_ROM_QSTR(MP_QSTR_cross), MP_ROM_PTR(&numerical_cross_obj) },
+        { MP_ROM_QSTR(MP_QSTR_cross), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_cross, numerical_cross_obj) },
+    #endif
+    #if ULAB_NUMPY_HAS_CUMPROD
+        { MP_ROM_QSTR(MP_QSTR_cumprod), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_cumprod, numerical_cumprod_obj) },
+    #endif
+    #if ULAB_NUMPY_HAS_CUMSUM
+        { MP_ROM_QSTR(MP_QSTR_cumsum), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_cumsum, numerical_cumsum_obj) },
     #endif
     #if ULAB_NUMPY_HAS_DIFF
-        { MP_ROM_QSTR(MP_QSTR_diff), MP_ROM_PTR(&numerical_diff_obj) },
+        { MP_ROM_QSTR(MP_QSTR_diff), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_diff, numerical_diff_obj) },
     #endif
     #if ULAB_NUMPY_HAS_DOT
         #if ULAB_MAX_DIMS > 1
-            { MP_ROM_QSTR(MP_QSTR_dot), MP_ROM_PTR(&transform_dot_obj) },
+            { MP_ROM_QSTR(MP_QSTR_dot), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_dot, transform_dot_obj) },
         #endif
     #endif
     #if ULAB_NUMPY_HAS_TRACE
         #if ULAB_MAX_DIMS > 1
-            { MP_ROM_QSTR(MP_QSTR_trace), MP_ROM_PTR(&stats_trace_obj) },
+            { MP_ROM_QSTR(MP_QSTR_trace), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_trace, stats_trace_obj) },
         #endif
     #endif
     #if ULAB_NUMPY_HAS_FLIP
-        { MP_ROM_QSTR(MP_QSTR_flip), MP_ROM_PTR(&numerical_flip_obj) },
+        { MP_ROM_QSTR(MP_QSTR_flip), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_flip, numerical_flip_obj) },
     #endif
     #if ULAB_NUMPY_HAS_LOAD
-        { MP_ROM_QSTR(MP_QSTR_load), MP_ROM_PTR(&io_load_obj) },
+        { MP_ROM_QSTR(MP_QSTR_load), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_load, io_load_obj) },
+    #endif
+    #if ULAB_NUMPY_HAS_LOAD_PACKED
+        { MP_ROM_QSTR(MP_QSTR_load_packed), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_load_packed, io_load_packed_obj) },
     #endif
     #if ULAB_NUMPY_HAS_LOADTXT
-        { MP_ROM_QSTR(MP_QSTR_loadtxt), MP_ROM_PTR(&io_loadtxt_obj) },
+        { MP_ROM_QSTR(MP_QSTR_loadtxt), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_loadtxt, io_loadtxt_obj) },
+    #endif
+    #if ULAB_NUMPY_HAS_LAZY
+        { MP_ROM_QSTR(MP_QSTR_lazy), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_lazy, lazy_lazy_obj) },
     #endif
     #if ULAB_NUMPY_HAS_MINMAX
-        { MP_ROM_QSTR(MP_QSTR_max), MP_ROM_PTR(&numerical_max_obj) },
+        { MP_ROM_QSTR(MP_QSTR_max), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_max, numerical_max_obj) },
     #endif
     #if ULAB_NUMPY_HAS_MEAN
-        { MP_ROM_QSTR(MP_QSTR_mean), MP_ROM_PTR(&numerical_mean_obj) },
+        { MP_ROM_QSTR(MP_QSTR_mean), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_mean, numerical_mean_obj) },
     #endif
     #if ULAB_NUMPY_HAS_MEDIAN
-        { MP_ROM_QSTR(MP_QSTR_median), MP_ROM_PTR(&numerical_median_obj) },
+        { MP_ROM_QSTR(MP_QSTR_median), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_median, numerical_median_obj) },
     #endif
     #if ULAB_NUMPY_HAS_MINMAX
-        { MP_ROM_QSTR(MP_QSTR_min), MP_ROM_PTR(&numerical_min_obj) },
+        { MP_ROM_QSTR(MP_QSTR_min), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_min, numerical_min_obj) },
+    #endif
+    #if ULAB_NUMPY_HAS_PERCENTILE
+        { MP_ROM_QSTR(MP_QSTR_percentile), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_percentile, numerical_percentile_obj) },
+    #endif
+    #if ULAB_NUMPY_HAS_QUANTILE
+        { MP_ROM_QSTR(MP_QSTR_quantile), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_quantile, numerical_quantile_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ROLL
-        { MP_ROM_QSTR(MP_QSTR_roll), MP_ROM_PTR(&numerical_roll_obj) },
+        { MP_ROM_QSTR(MP_QSTR_roll), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_roll, numerical_roll_obj) },
     #endif
     #if ULAB_NUMPY_HAS_SAVE
-        { MP_ROM_QSTR(MP_QSTR_save), MP_ROM_PTR(&io_save_obj) },
+        { MP_ROM_QSTR(MP_QSTR_save), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_save, io_save_obj) },
+    #endif
+    #if ULAB_NUMPY_HAS_SAVE_PACKED
+        { MP_ROM_QSTR(MP_QSTR_save_packed), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_save_packed, io_save_packed_obj) },
     #endif
     #if ULAB_NUMPY_HAS_SAVETXT
-        { MP_ROM_QSTR(MP_QSTR_savetxt), MP_ROM_PTR(&io_savetxt_obj) },
+        { MP_ROM_QSTR(MP_QSTR_savetxt), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_savetxt, io_savetxt_obj) },
     #endif
     #if ULAB_NUMPY_HAS_SIZE
-        { MP_ROM_QSTR(MP_QSTR_size), MP_ROM_PTR(&transform_size_obj) },
+        { MP_ROM_QSTR(MP_QSTR_size), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_size, transform_size_obj) },
     #endif
     #if ULAB_NUMPY_HAS_SORT
-        { MP_ROM_QSTR(MP_QSTR_sort), MP_ROM_PTR(&numerical_sort_obj) },
+        { MP_ROM_QSTR(MP_QSTR_sort), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_sort, numerical_sort_obj) },
     #endif
     #if ULAB_NUMPY_HAS_STD
-        { MP_ROM_QSTR(MP_QSTR_std), MP_ROM_PTR(&numerical_std_obj) },
+        { MP_ROM_QSTR(MP_QSTR_std), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_std, numerical_std_obj) },
     #endif
     #if ULAB_NUMPY_HAS_SUM
-        { MP_ROM_QSTR(MP_QSTR_sum), MP_ROM_PTR(&numerical_sum_obj) },
+        { MP_ROM_QSTR(MP_QSTR_sum), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_sum, numerical_sum_obj) },
     #endif
     // functions of the poly sub-module
     #if ULAB_NUMPY_HAS_POLYFIT
-        { MP_ROM_QSTR(MP_QSTR_polyfit), MP_ROM_PTR(&poly_polyfit_obj) },
+        { MP_ROM_QSTR(MP_QSTR_polyfit), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_polyfit, poly_polyfit_obj) },
     #endif
     #if ULAB_NUMPY_HAS_POLYVAL
-        { MP_ROM_QSTR(MP_QSTR_polyval), MP_ROM_PTR(&poly_polyval_obj) },
+        { MP_ROM_QSTR(MP_QSTR_polyval), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_polyval, poly_polyval_obj) },
     #endif
     // functions of the vector sub-module
     #if ULAB_NUMPY_HAS_ACOS
-    { MP_ROM_QSTR(MP_QSTR_acos), MP_ROM_PTR(&vector_acos_obj) },
+    { MP_ROM_QSTR(MP_QSTR_acos), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_acos, vector_acos_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ACOSH
-    { MP_ROM_QSTR(MP_QSTR_acosh), MP_ROM_PTR(&vector_acosh_obj) },
+    { MP_ROM_QSTR(MP_QSTR_acosh), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_acosh, vector_acosh_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ARCTAN2
-    { MP_ROM_QSTR(MP_QSTR_arctan2), MP_ROM_PTR(&vector_arctan2_obj) },
+    { MP_ROM_QSTR(MP_QSTR_arctan2), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_arctan2, vector_arctan2_obj) },
     #endif
     #if ULAB_NUMPY_HAS_AROUND
-    { MP_ROM_QSTR(MP_QSTR_around), MP_ROM_PTR(&vector_around_obj) },
+    { MP_ROM_QSTR(MP_QSTR_around), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_around, vector_around_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ASIN
-    { MP_ROM_QSTR(MP_QSTR_asin), MP_ROM_PTR(&vector_asin_obj) },
+    { MP_ROM_QSTR(MP_QSTR_asin), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_asin, vector_asin_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ASINH
-    { MP_ROM_QSTR(MP_QSTR_asinh), MP_ROM_PTR(&vector_asinh_obj) },
+    { MP_ROM_QSTR(MP_QSTR_asinh), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_asinh, vector_asinh_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ATAN
-    { MP_ROM_QSTR(MP_QSTR_atan), MP_ROM_PTR(&vector_atan_obj) },
+    { MP_ROM_QSTR(MP_QSTR_atan), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_atan, vector_atan_obj) },
     #endif
     #if ULAB_NUMPY_HAS_ATANH
-    { MP_ROM_QSTR(MP_QSTR_atanh), MP_ROM_PTR(&vector_atanh_obj) },
+    { MP_ROM_QSTR(MP_QSTR_atanh), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_atanh, vector_atanh_obj) },
     #endif
     #if ULAB_NUMPY_HAS_CEIL
-    { MP_ROM_QSTR(MP_QSTR_ceil), MP_ROM_PTR(&vector_ceil_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ceil), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_ceil, vector_ceil_obj) },
     #endif
     #if ULAB_NUMPY_HAS_COS
-    { MP_ROM_QSTR(MP_QSTR_cos), MP_ROM_PTR(&vector_cos_obj) },
+    { MP_ROM_QSTR(MP_QSTR_cos), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_cos, vector_cos_obj) },
     #endif
     #if ULAB_NUMPY_HAS_COSH
-    { MP_ROM_QSTR(MP_QSTR_cosh), MP_ROM_PTR(&vector_cosh_obj) },
+    { MP_ROM_QSTR(MP_QSTR_cosh), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_cosh, vector_cosh_obj) },
     #endif
     #if ULAB_NUMPY_HAS_DEGREES
-    { MP_ROM_QSTR(MP_QSTR_degrees), MP_ROM_PTR(&vector_degrees_obj) },
+    { MP_ROM_QSTR(MP_QSTR_degrees), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_degrees, vector_degrees_obj) },
     #endif
     #if ULAB_NUMPY_HAS_EXP
-    { MP_ROM_QSTR(MP_QSTR_exp), MP_ROM_PTR(&vector_exp_obj) },
+    { MP_ROM_QSTR(MP_QSTR_exp), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_exp, vector_exp_obj) },
     #endif
     #if ULAB_NUMPY_HAS_EXPM1
-    { MP_ROM_QSTR(MP_QSTR_expm1), MP_ROM_PTR(&vector_expm1_obj) },
+    { MP_ROM_QSTR(MP_QSTR_expm1), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_expm1, vector_expm1_obj) },
     #endif
     #if ULAB_NUMPY_HAS_FLOOR
-    { MP_ROM_QSTR(MP_QSTR_floor), MP_ROM_PTR(&vector_floor_obj) },
+    { MP_ROM_QSTR(MP_QSTR_floor), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_floor, vector_floor_obj) },
     #endif
     #if ULAB_NUMPY_HAS_LOG
-    { MP_ROM_QSTR(MP_QSTR_log), MP_ROM_PTR(&vector_log_obj) },
+    { MP_ROM_QSTR(MP_QSTR_log), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_log, vector_log_obj) },
     #endif
     #if ULAB_NUMPY_HAS_LOG10
-    { MP_ROM_QSTR(MP_QSTR_log10), MP_ROM_PTR(&vector_log10_obj) },
+    { MP_ROM_QSTR(MP_QSTR_log10), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_log10, vector_log10_obj) },
     #endif
     #if ULAB_NUMPY_HAS_LOG2
-    { MP_ROM_QSTR(MP_QSTR_log2), MP_ROM_PTR(&vector_log2_obj) },
+    { MP_ROM_QSTR(MP_QSTR_log2), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_log2, vector_log2_obj) },
     #endif
     #if ULAB_NUMPY_HAS_RADIANS
-    { MP_ROM_QSTR(MP_QSTR_radians), MP_ROM_PTR(&vector_radians_obj) },
+    { MP_ROM_QSTR(MP_QSTR_radians), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_radians, vector_radians_obj) },
     #endif
     #if ULAB_NUMPY_HAS_SIN
-    { MP_ROM_QSTR(MP_QSTR_sin), MP_ROM_PTR(&vector_sin_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sin), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_sin, vector_sin_obj) },
     #endif
     #if ULAB_NUMPY_HAS_SINC
-    { MP_ROM_QSTR(MP_QSTR_sinc), MP_ROM_PTR(&vector_sinc_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sinc), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_sinc, vector_sinc_obj) },
     #endif
     #if ULAB_NUMPY_HAS_SINH
-    { MP_ROM_QSTR(MP_QSTR_sinh), MP_ROM_PTR(&vector_sinh_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sinh), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_sinh, vector_sinh_obj) },
     #endif
     #if ULAB_NUMPY_HAS_SQRT
-    { MP_ROM_QSTR(MP_QSTR_sqrt), MP_ROM_PTR(&vector_sqrt_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sqrt), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_sqrt, vector_sqrt_obj) },
     #endif
     #if ULAB_NUMPY_HAS_TAN
-    { MP_ROM_QSTR(MP_QSTR_tan), MP_ROM_PTR(&vector_tan_obj) },
+    { MP_ROM_QSTR(MP_QSTR_tan), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_tan, vector_tan_obj) },
     #endif
     #if ULAB_NUMPY_HAS_TANH
-    { MP_ROM_QSTR(MP_QSTR_tanh), MP_ROM_PTR(&vector_tanh_obj) },
+    { MP_ROM_QSTR(MP_QSTR_tanh), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_tanh, vector_tanh_obj) },
     #endif
     #if ULAB_NUMPY_HAS_VECTORIZE
-    { MP_ROM_QSTR(MP_QSTR_vectorize), MP_ROM_PTR(&vector_vectorize_obj) },
+    { MP_ROM_QSTR(MP_QSTR_vectorize), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_vectorize, vector_vectorize_obj) },
     #endif
     #if ULAB_SUPPORTS_COMPLEX
         #if ULAB_NUMPY_HAS_REAL
-        { MP_ROM_QSTR(MP_QSTR_real), MP_ROM_PTR(&carray_real_obj) },
+        { MP_ROM_QSTR(MP_QSTR_real), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_real, carray_real_obj) },
         #endif
         #if ULAB_NUMPY_HAS_IMAG
-        { MP_ROM_QSTR(MP_QSTR_imag), MP_ROM_PTR(&carray_imag_obj) },
+        { MP_ROM_QSTR(MP_QSTR_imag), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_imag, carray_imag_obj) },
         #endif
         #if ULAB_NUMPY_HAS_CONJUGATE
-            { MP_ROM_QSTR(MP_QSTR_conjugate), MP_ROM_PTR(&carray_conjugate_obj) },
+            { MP_ROM_QSTR(MP_QSTR_conjugate), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_conjugate, carray_conjugate_obj) },
         #endif
         #if ULAB_NUMPY_HAS_SORT_COMPLEX
-            { MP_ROM_QSTR(MP_QSTR_sort_complex), MP_ROM_PTR(&carray_sort_complex_obj) },
+            { MP_ROM_QSTR(MP_QSTR_sort_complex), ULAB_PROFILE_PTR(MP_QSTR_numpy, MP_QSTR_sort_complex, carray_sort_complex_obj) },
         #endif
     #endif
 };
@@ -12,6 +12,7 @@
  *               2020 Taku Fukada
 */
 
+#include <string.h>
 #include "py/obj.h"
 #include "py/runtime.h"
 #include "py/objarray.h"
@@ -24,134 +25,276 @@
 
 #if ULAB_NUMPY_HAS_POLYFIT
 
-mp_obj_t poly_polyfit(size_t n_args, const mp_obj_t *args) {
-    if(!ndarray_object_is_array_like(args[0])) {
+static void poly_reader_init(poly_reader_t *reader, mp_obj_t obj) {
+    // one-dimensional ndarrays are read directly, everything else through the iterator
+    reader->iterable = MP_OBJ_NULL;
+    if(mp_obj_is_type(obj, &ulab_ndarray_type)) {
+        ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(obj);
+        if(ndarray->ndim == 1) {
+            reader->array = (uint8_t *)ndarray->array;
+            reader->stride = ndarray->strides[ULAB_MAX_DIMS - 1];
+            reader->dtype = ndarray->dtype;
+            return;
+        }
+    }
+    reader->iterable = mp_getiter(obj, &reader->buf);
+}
+
+static mp_float_t poly_reader_next(poly_reader_t *reader) {
+    if(reader->iterable == MP_OBJ_NULL) {
+        mp_float_t value = ndarray_get_float_value(reader->array, reader->dtype);
+        reader->array += reader->stride;
+        return value;
+    }
+    return mp_obj_get_float(mp_iternext(reader->iterable));
+}
+
+static void poly_givens_update(mp_float_t *R, mp_float_t *qy, mp_float_t *row, mp_float_t b, size_t m) {
+    // adds a row of the (weighted) Vandermonde matrix, and the corresponding data point
+    // to the triangular factor R, and to Q^T y by means of Givens rotations
+    for(size_t j = 0; j < m; j++) {
+        if(row[j] == MICROPY_FLOAT_CONST(0.0)) {
+            continue;
+        }
+        mp_float_t rjj = R[j * m + j];
+        mp_float_t r = MICROPY_FLOAT_C_FUN(sqrt)(rjj * rjj + row[j] * row[j]);
+        mp_float_t c = rjj / r;
+        mp_float_t s = row[j] / r;
+        R[j * m + j] = r;
+        for(size_t k = j + 1; k < m; k++) {
+            mp_float_t t = R[j * m + k];
+            R[j * m + k] = c * t + s * row[k];
+            row[k] = c * row[k] - s * t;
+        }
+        mp_float_t t = qy[j];
+        qy[j] = c * t + s * b;
+        b = c * b - s * t;
+    }
+}
+
+mp_obj_t poly_polyfit(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_w, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if(!ndarray_object_is_array_like(args[0].u_obj)) {
         mp_raise_ValueError(MP_ERROR_TEXT("input data must be an iterable"));
     }
     #if ULAB_SUPPORTS_COMPLEX
-    if(mp_obj_is_type(args[0], &ulab_ndarray_type)) {
-        ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(args[0]);
+    if(mp_obj_is_type(args[0].u_obj, &ulab_ndarray_type)) {
+        ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(args[0].u_obj);
         COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
     }
     #endif
-    size_t lenx = 0, leny = 0;
-    uint8_t deg = 0;
-    mp_float_t *x, *XT, *y, *prod;
+    size_t len;
+    uint8_t deg;
+    mp_obj_t o_x, o_y;
 
-    if(n_args == 2) { // only the y values are supplied
+    if(args[2].u_obj == mp_const_none) { // only the y values are supplied
         // TODO: this is actually not enough: the first argument can very well be a matrix,
         // in which case we are between the rock and a hard place
-        leny = (size_t)mp_obj_get_int(mp_obj_len_maybe(args[0]));
-        deg = (uint8_t)mp_obj_get_int(args[1]);
-        if(leny < deg) {
-            mp_raise_ValueError(MP_ERROR_TEXT("more degrees of freedom than data points"));
-        }
-        lenx = leny;
-        x = m_new(mp_float_t, lenx); // assume uniformly spaced data points
-        for(size_t i=0; i < lenx; i++) {
-            x[i] = i;
-        }
-        y = m_new(mp_float_t, leny);
-        fill_array_iterable(y, args[0]);
-    } else /* n_args == 3 */ {
-        if(!ndarray_object_is_array_like(args[1])) {
+        o_x = mp_const_none; // assume uniformly spaced data points
+        o_y = args[0].u_obj;
+        len = (size_t)mp_obj_get_int(mp_obj_len_maybe(o_y));
+        deg = (uint8_t)mp_obj_get_int(args[1].u_obj);
+    } else {
+        if(!ndarray_object_is_array_like(args[1].u_obj)) {
             mp_raise_ValueError(MP_ERROR_TEXT("input data must be an iterable"));
         }
-        lenx = (size_t)mp_obj_get_int(mp_obj_len_maybe(args[0]));
-        leny = (size_t)mp_obj_get_int(mp_obj_len_maybe(args[1]));
-        if(lenx != leny) {
+        o_x = args[0].u_obj;
+        o_y = args[1].u_obj;
+        len = (size_t)mp_obj_get_int(mp_obj_len_maybe(o_x));
+        if(len != (size_t)mp_obj_get_int(mp_obj_len_maybe(o_y))) {
             mp_raise_ValueError(MP_ERROR_TEXT("input vectors must be of equal length"));
         }
-        deg = (uint8_t)mp_obj_get_int(args[2]);
-        if(leny < deg) {
-            mp_raise_ValueError(MP_ERROR_TEXT("more degrees of freedom than data points"));
-        }
-        x = m_new(mp_float_t, lenx);
-        fill_array_iterable(x, args[0]);
-        y = m_new(mp_float_t, leny);
-        fill_array_iterable(y, args[1]);
+        deg = (uint8_t)mp_obj_get_int(args[2].u_obj);
     }
-
-    // one could probably express X as a function of XT,
-    // and thereby save RAM, because X is used only in the product
-    XT = m_new(mp_float_t, (deg+1)*leny); // XT is a matrix of shape (deg+1, len) (rows, columns)
-    for(size_t i=0; i < leny; i++) { // column index
-        XT[i+0*lenx] = 1.0; // top row
-        for(uint8_t j=1; j < deg+1; j++) { // row index
-            XT[i+j*leny] = XT[i+(j-1)*leny]*x[i];
+    if(len < deg) {
+        mp_raise_ValueError(MP_ERROR_TEXT("more degrees of freedom than data points"));
+    }
+    mp_obj_t o_w = args[3].u_obj;
+    if(o_w != mp_const_none) {
+        if(!ndarray_object_is_array_like(o_w)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("input data must be an iterable"));
+        }
+        if(len != (size_t)mp_obj_get_int(mp_obj_len_maybe(o_w))) {
+            mp_raise_ValueError(MP_ERROR_TEXT("input vectors must be of equal length"));
         }
     }
 
-    prod = m_new(mp_float_t, (deg+1)*(deg+1)); // the product matrix is of shape (deg+1, deg+1)
-    mp_float_t sum;
-    for(uint8_t i=0; i < deg+1; i++) { // column index
-        for(uint8_t j=0; j < deg+1; j++) { // row index
-            sum = 0.0;
-            for(size_t k=0; k < lenx; k++) {
-                // (j, k) * (k, i)
-                // Note that the second matrix is simply the transpose of the first:
-                // X(k, i) = XT(i, k) = XT[k*lenx+i]
-                sum += XT[j*lenx+k]*XT[i*lenx+k]; // X[k*(deg+1)+i];
-            }
-            prod[j*(deg+1)+i] = sum;
-        }
+    // The least-squares problem is solved by a QR decomposition of the Vandermonde matrix,
+    // which is built up one row at a time, so that neither the Vandermonde matrix, nor the
+    // data have to be stored: beside the (deg+1, deg+1) triangular factor R, only Q^T y,
+    // and the current row are kept.
+    size_t m = deg + 1;
+    mp_float_t *R = m_new0(mp_float_t, m * (m + 2));
+    mp_float_t *qy = R + m * m;
+    mp_float_t *row = qy + m;
+
+    poly_reader_t xreader, yreader, wreader;
+    if(o_x != mp_const_none) {
+        poly_reader_init(&xreader, o_x);
     }
-    if(!linalg_invert_matrix(prod, deg+1)) {
-        // Although X was a Vandermonde matrix, whose inverse is guaranteed to exist,
-        // we bail out here, if prod couldn't be inverted: if the values in x are not all
-        // distinct, prod is singular
-        m_del(mp_float_t, XT, (deg+1)*lenx);
-        m_del(mp_float_t, x, lenx);
-        m_del(mp_float_t, y, lenx);
-        m_del(mp_float_t, prod, (deg+1)*(deg+1));
-        mp_raise_ValueError(MP_ERROR_TEXT("could not invert Vandermonde matrix"));
+    poly_reader_init(&yreader, o_y);
+    if(o_w != mp_const_none) {
+        poly_reader_init(&wreader, o_w);
     }
-    // at this point, we have the inverse of X^T * X
-    // y is a column vector; x is free now, we can use it for storing intermediate values
-    for(uint8_t i=0; i < deg+1; i++) { // row index
-        sum = 0.0;
-        for(size_t j=0; j < lenx; j++) { // column index
-            sum += XT[i*lenx+j]*y[j];
+
+    for(size_t i = 0; i < len; i++) {
+        mp_float_t x = o_x == mp_const_none ? (mp_float_t)i : poly_reader_next(&xreader);
+        mp_float_t y = poly_reader_next(&yreader);
+        // as in numpy, the weights multiply the residuals, and not their squares
+        mp_float_t w = o_w == mp_const_none ? MICROPY_FLOAT_CONST(1.0) : poly_reader_next(&wreader);
+        row[0] = w;
+        for(size_t j = 1; j < m; j++) {
+            row[j] = row[j - 1] * x;
         }
-        x[i] = sum;
+        poly_givens_update(R, qy, row, w * y, m);
     }
-    // XT is no longer needed
-    m_del(mp_float_t, XT, (deg+1)*leny);
 
-    ndarray_obj_t *beta = ndarray_new_linear_array(deg+1, NDARRAY_FLOAT);
+    ndarray_obj_t *beta = ndarray_new_linear_array(m, NDARRAY_FLOAT);
     mp_float_t *betav = (mp_float_t *)beta->array;
-    // x[0..(deg+1)] contains now the product X^T * y; we can get rid of y
-    m_del(float, y, leny);
-
-    // now, we calculate beta, i.e., we apply prod = (X^T * X)^(-1) on x = X^T * y; x is a column vector now
-    for(uint8_t i=0; i < deg+1; i++) {
-        sum = 0.0;
-        for(uint8_t j=0; j < deg+1; j++) {
-            sum += prod[i*(deg+1)+j]*x[j];
+    // back substitution; the coefficients are written in reverse order,
+    // for the leading coefficient comes first
+    for(size_t j = m; j-- > 0; ) {
+        mp_float_t rjj = R[j * m + j];
+        // the rotations preserve the norm of the columns, hence the norm of the j-th
+        // column of the Vandermonde matrix can be read off R
+        mp_float_t norm = MICROPY_FLOAT_CONST(0.0);
+        for(size_t k = 0; k <= j; k++) {
+            norm += R[k * m + j] * R[k * m + j];
         }
-        betav[i] = sum;
-    }
-    m_del(mp_float_t, x, lenx);
-    m_del(mp_float_t, prod, (deg+1)*(deg+1));
-    for(uint8_t i=0; i < (deg+1)/2; i++) {
-        // We have to reverse the array, for the leading coefficient comes first.
-        SWAP(mp_float_t, betav[i], betav[deg-i]);
+        if(MICROPY_FLOAT_C_FUN(fabs)(rjj) <= MICROPY_FLOAT_C_FUN(sqrt)(norm) * m * LINALG_EPSILON) {
+            // if the values in x are not all distinct, the Vandermonde matrix is singular
+            m_del(mp_float_t, R, m * (m + 2));
+            mp_raise_ValueError(MP_ERROR_TEXT("could not invert Vandermonde matrix"));
+        }
+        mp_float_t sum = qy[j];
+        for(size_t k = j + 1; k < m; k++) {
+            sum -= R[j * m + k] * betav[deg - k];
+        }
+        betav[deg - j] = sum / rjj;
     }
+    m_del(mp_float_t, R, m * (m + 2));
     return MP_OBJ_FROM_PTR(beta);
 }
 
-MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(poly_polyfit_obj, 2, 3, poly_polyfit);
+MP_DEFINE_CONST_FUN_OBJ_KW(poly_polyfit_obj, 2, poly_polyfit);
 #endif
 
 #if ULAB_NUMPY_HAS_POLYVAL
 
-static mp_float_t poly_eval(mp_float_t x, mp_float_t *p, uint8_t plen) {
-    mp_float_t y = p[0];
-    for(uint8_t j=0; j < plen-1; j++) {
-        y *= x;
-        y += p[j+1];
+static void poly_horner(mp_float_t *y, mp_float_t *x, size_t len, mp_float_t *p, size_t plen) {
+    // Horner's scheme is applied to a block of values with one coefficient at a time,
+    // so that the inner loop carries no dependency from one element to the next;
+    // since the block is copied first, y and x may point to the same buffer
+    mp_float_t xblock[POLY_HORNER_BLOCK];
+    mp_float_t p0 = plen > 0 ? p[0] : MICROPY_FLOAT_CONST(0.0);
+    while(len > 0) {
+        size_t n = len < POLY_HORNER_BLOCK ? len : POLY_HORNER_BLOCK;
+        memcpy(xblock, x, n * sizeof(mp_float_t));
+        for(size_t i = 0; i < n; i++) {
+            y[i] = p0;
+        }
+        for(size_t j = 1; j < plen; j++) {
+            mp_float_t c = p[j];
+            for(size_t i = 0; i < n; i++) {
+                y[i] = y[i] * xblock[i] + c;
+            }
+        }
+        x += n;
+        y += n;
+        len -= n;
+    }
+}
+
+static mp_float_t *poly_coefficients(mp_obj_t o_p, size_t *npoly, size_t *plen, bool *batched) {
+    // reads the coefficients into a dense float buffer of npoly polynomials of length plen;
+    // as in numpy, the polynomials of a 2-D array are stored in its columns
+    *npoly = 1;
+    *batched = false;
+    if(mp_obj_is_type(o_p, &ulab_ndarray_type)) {
+        ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(o_p);
+        if(ndarray->ndim > 2) {
+            mp_raise_ValueError(MP_ERROR_TEXT("coefficients must be a 1- or 2-dimensional array"));
+        }
+        uint8_t *parray = (uint8_t *)ndarray->array;
+        *plen = ndarray->shape[ULAB_MAX_DIMS - 1];
+        int32_t pstride = ndarray->strides[ULAB_MAX_DIMS - 1];
+        int32_t rstride = 0;
+        #if ULAB_MAX_DIMS > 1
+        if(ndarray->ndim == 2) {
+            *plen = ndarray->shape[ULAB_MAX_DIMS - 2];
+            *npoly = ndarray->shape[ULAB_MAX_DIMS - 1];
+            pstride = ndarray->strides[ULAB_MAX_DIMS - 2];
+            rstride = ndarray->strides[ULAB_MAX_DIMS - 1];
+            *batched = true;
+        }
+        #endif
+        mp_float_t *p = m_new(mp_float_t, *npoly * *plen);
+        for(size_t r = 0; r < *npoly; r++) {
+            tools_load_float(p + r * *plen, 1, parray, pstride, ndarray->dtype, *plen);
+            parray += rstride;
+        }
+        return p;
+    }
+    // p had better be a one-dimensional standard iterable
+    *plen = (size_t)mp_obj_get_int(mp_obj_len_maybe(o_p));
+    mp_float_t *p = m_new(mp_float_t, *plen);
+    mp_obj_iter_buf_t p_buf;
+    mp_obj_t p_item, p_iterable = mp_getiter(o_p, &p_buf);
+    size_t i = 0;
+    while((p_item = mp_iternext(p_iterable)) != MP_OBJ_STOP_ITERATION) {
+        p[i] = mp_obj_get_float(p_item);
+        i++;
+    }
+    return p;
+}
+
+static void poly_load_ndarray(mp_float_t *array, ndarray_obj_t *source) {
+    // converts the elements of source to float in typed loops, row by row, or in a
+    // single run, if the array is contiguous
+    uint8_t *sarray = (uint8_t *)source->array;
+    if(ndarray_is_contiguous(source)) {
+        tools_load_float(array, 1, sarray, source->itemsize, source->dtype, source->len);
+        return;
     }
-    return y;
+    #if ULAB_MAX_DIMS > 3
+    size_t i = 0;
+    do {
+    #endif
+        #if ULAB_MAX_DIMS > 2
+        size_t j = 0;
+        do {
+        #endif
+            #if ULAB_MAX_DIMS > 1
+            size_t k = 0;
+            do {
+            #endif
+                tools_load_float(array, 1, sarray, source->strides[ULAB_MAX_DIMS - 1], source->dtype, source->shape[ULAB_MAX_DIMS - 1]);
+                array += source->shape[ULAB_MAX_DIMS - 1];
+            #if ULAB_MAX_DIMS > 1
+                sarray += source->strides[ULAB_MAX_DIMS - 2];
+                k++;
+            } while(k < source->shape[ULAB_MAX_DIMS - 2]);
+            #endif
+        #if ULAB_MAX_DIMS > 2
+            sarray -= source->strides[ULAB_MAX_DIMS - 2] * source->shape[ULAB_MAX_DIMS-2];
+            sarray += source->strides[ULAB_MAX_DIMS - 3];
+            j++;
+        } while(j < source->shape[ULAB_MAX_DIMS - 3]);
+        #endif
+    #if ULAB_MAX_DIMS > 3
+        sarray -= source->strides[ULAB_MAX_DIMS - 3] * source->shape[ULAB_MAX_DIMS-3];
+        sarray += source->strides[ULAB_MAX_DIMS - 4];
+        i++;
+    } while(i < source->shape[ULAB_MAX_DIMS - 4]);
+    #endif
 }
 
 mp_obj_t poly_polyval(mp_obj_t o_p, mp_obj_t o_x) {
@@ -169,81 +312,76 @@ mp_obj_t poly_polyval(mp_obj_t o_p, mp_obj_t o_x) {
         COMPLEX_DTYPE_NOT_IMPLEMENTED(input->dtype)
     }
     #endif
-    // p had better be a one-dimensional standard iterable
-    size_t plen = (size_t)mp_obj_get_int(mp_obj_len_maybe(o_p));
-    mp_float_t *p = m_new(mp_float_t, plen);
-    mp_obj_iter_buf_t p_buf;
-    mp_obj_t p_item, p_iterable = mp_getiter(o_p, &p_buf);
-    uint8_t i = 0;
-    while((p_item = mp_iternext(p_iterable)) != MP_OBJ_STOP_ITERATION) {
-        p[i] = mp_obj_get_float(p_item);
-        i++;
-    }
+    size_t npoly, plen;
+    bool batched;
+    mp_float_t *p = poly_coefficients(o_p, &npoly, &plen, &batched);
 
     if(!ndarray_object_is_array_like(o_x)) {
-        return mp_obj_new_float(poly_eval(mp_obj_get_float(o_x), p, plen));
+        mp_float_t x = mp_obj_get_float(o_x);
+        if(!batched) {
+            mp_float_t y;
+            poly_horner(&y, &x, 1, p, plen);
+            m_del(mp_float_t, p, plen);
+            return mp_obj_new_float(y);
+        }
+        // a set of polynomials evaluated at a scalar yields a linear array
+        ndarray_obj_t *ndarray = ndarray_new_linear_array(npoly, NDARRAY_FLOAT);
+        mp_float_t *array = (mp_float_t *)ndarray->array;
+        for(size_t r = 0; r < npoly; r++) {
+            poly_horner(array++, &x, 1, p + r * plen, plen);
+        }
+        m_del(mp_float_t, p, npoly * plen);
+        return MP_OBJ_FROM_PTR(ndarray);
     }
 
-    // polynomials are going to be of type float, except, when both
-    // the coefficients and the independent variable are integers
-    ndarray_obj_t *ndarray;
+    // the results are of type float; with a set of polynomials, the shape of the
+    // output is (npoly,) + x.shape
+    size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
+    uint8_t ndim = 1;
+    size_t xlen;
+    ndarray_obj_t *source = NULL;
     if(mp_obj_is_type(o_x, &ulab_ndarray_type)) {
-        ndarray_obj_t *source = MP_OBJ_TO_PTR(o_x);
-        uint8_t *sarray = (uint8_t *)source->array;
-        ndarray = ndarray_new_dense_ndarray(source->ndim, source->shape, NDARRAY_FLOAT);
-        mp_float_t *array = (mp_float_t *)ndarray->array;
-
-        mp_float_t (*func)(void *) = ndarray_get_float_function(source->dtype);
-
-        // TODO: these loops are really nothing, but the re-impplementation of
-        // ITERATE_VECTOR from vectorise.c. We could pass a function pointer here
-        #if ULAB_MAX_DIMS > 3
-        size_t i = 0;
-        do {
-        #endif
-            #if ULAB_MAX_DIMS > 2
-            size_t j = 0;
-            do {
-            #endif
-                #if ULAB_MAX_DIMS > 1
-                size_t k = 0;
-                do {
-                #endif
-                    size_t l = 0;
-                    do {
-                        *array++ = poly_eval(func(sarray), p, plen);
-                        sarray += source->strides[ULAB_MAX_DIMS - 1];
-                        l++;
-                    } while(l < source->shape[ULAB_MAX_DIMS - 1]);
-                #if ULAB_MAX_DIMS > 1
-                    sarray -= source->strides[ULAB_MAX_DIMS - 1] * source->shape[ULAB_MAX_DIMS-1];
-                    sarray += source->strides[ULAB_MAX_DIMS - 2];
-                    k++;
-                } while(k < source->shape[ULAB_MAX_DIMS - 2]);
-                #endif
-            #if ULAB_MAX_DIMS > 2
-                sarray -= source->strides[ULAB_MAX_DIMS - 2] * source->shape[ULAB_MAX_DIMS-2];
-                sarray += source->strides[ULAB_MAX_DIMS - 3];
-                j++;
-            } while(j < source->shape[ULAB_MAX_DIMS - 3]);
-            #endif
-        #if ULAB_MAX_DIMS > 3
-            sarray -= source->strides[ULAB_MAX_DIMS - 3] * source->shape[ULAB_MAX_DIMS-3];
-            sarray += source->strides[ULAB_MAX_DIMS - 4];
-            i++;
-        } while(i < source->shape[ULAB_MAX_DIMS - 4]);
-        #endif
+        source = MP_OBJ_TO_PTR(o_x);
+        ndim = source->ndim;
+        xlen = source->len;
+        memcpy(shape, source->shape, ULAB_MAX_DIMS * sizeof(size_t));
     } else {
         // o_x had better be a one-dimensional standard iterable
-        ndarray = ndarray_new_linear_array(mp_obj_get_int(mp_obj_len_maybe(o_x)), NDARRAY_FLOAT);
-        mp_float_t *array = (mp_float_t *)ndarray->array;
+        xlen = (size_t)mp_obj_get_int(mp_obj_len_maybe(o_x));
+        shape[ULAB_MAX_DIMS - 1] = xlen;
+    }
+    if(batched) {
+        if(ndim == ULAB_MAX_DIMS) {
+            mp_raise_ValueError(MP_ERROR_TEXT("maximum number of dimensions is " MP_STRINGIFY(ULAB_MAX_DIMS)));
+        }
+        shape[ULAB_MAX_DIMS - 1 - ndim] = npoly;
+        ndim++;
+    }
+    ndarray_obj_t *ndarray = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
+    m_del(size_t, shape, ULAB_MAX_DIMS);
+    mp_float_t *array = (mp_float_t *)ndarray->array;
+
+    // the independent variable is converted only once: for a single polynomial, it is
+    // stored in the output, and the polynomial is evaluated in place
+    mp_float_t *x = batched ? m_new(mp_float_t, xlen) : array;
+    if(source != NULL) {
+        poly_load_ndarray(x, source);
+    } else {
         mp_obj_iter_buf_t x_buf;
         mp_obj_t x_item, x_iterable = mp_getiter(o_x, &x_buf);
-        while ((x_item = mp_iternext(x_iterable)) != MP_OBJ_STOP_ITERATION) {
-            *array++ = poly_eval(mp_obj_get_float(x_item), p, plen);
+        mp_float_t *xarray = x;
+        while((x_item = mp_iternext(x_iterable)) != MP_OBJ_STOP_ITERATION) {
+            *xarray++ = mp_obj_get_float(x_item);
         }
     }
-    m_del(mp_float_t, p, plen);
+
+    for(size_t r = 0; r < npoly; r++) {
+        poly_horner(array + r * xlen, x, xlen, p + r * plen, plen);
+    }
+    if(batched) {
+        m_del(mp_float_t, x, xlen);
+    }
+    m_del(mp_float_t, p, npoly * plen);
     return MP_OBJ_FROM_PTR(ndarray);
 }
 
@@ -15,7 +15,19 @@
 #include "../ulab.h"
 #include "../ndarray.h"
 
-MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(poly_polyfit_obj);
+// polyval applies the coefficients to blocks of this many values at a time
+#define POLY_HORNER_BLOCK       (16)
+
+// polyfit reads one-dimensional ndarrays directly, and other iterables element by element
+typedef struct _poly_reader_t {
+    uint8_t *array;
+    int32_t stride;
+    uint8_t dtype;
+    mp_obj_t iterable;
+    mp_obj_iter_buf_t buf;
+} poly_reader_t;
+
+MP_DECLARE_CONST_FUN_OBJ_KW(poly_polyfit_obj);
 MP_DECLARE_CONST_FUN_OBJ_2(poly_polyval_obj);
 
 #endif
@@ -0,0 +1,453 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#include <string.h>
+#include "py/obj.h"
+#include "py/runtime.h"
+#include "py/misc.h"
+
+#include "../../ulab.h"
+#include "../../ulab_tools.h"
+#include "sort_tools.h"
+
+// The sorting engine of sort, argsort, and sort_complex. All routines work on strided
+// lanes; the increments are measured in elements, and not in bytes. Integer values
+// are sorted by counting (8-bit), or LSD radix sort (16-bit), floats by introsort. Short
+// runs are always sorted by insertion. The routines are generated for each type by the
+// templates below, with LESS supplying the ordering.
+
+#define SORT_DEFINE_INSERTION(name, type, LESS)\
+static void name(type *a, int32_t inc, int32_t n) {\
+    for(int32_t i = 1; i < n; i++) {\
+        type v = a[i * inc];\
+        int32_t j = i;\
+        while((j > 0) && LESS(v, a[(j - 1) * inc])) {\
+            a[j * inc] = a[(j - 1) * inc];\
+            j--;\
+        }\
+        a[j * inc] = v;\
+    }\
+}
+
+#define SORT_DEFINE_HEAPSORT(name, type, LESS)\
+static void name##_sift(type *a, int32_t inc, int32_t root, int32_t end) {\
+    type v = a[root * inc];\
+    while(2 * root + 1 <= end) {\
+        int32_t child = 2 * root + 1;\
+        if((child < end) && LESS(a[child * inc], a[(child + 1) * inc])) {\
+            child++;\
+        }\
+        if(!LESS(v, a[child * inc])) {\
+            break;\
+        }\
+        a[root * inc] = a[child * inc];\
+        root = child;\
+    }\
+    a[root * inc] = v;\
+}\
+static void name(type *a, int32_t inc, int32_t n) {\
+    for(int32_t start = n / 2 - 1; start >= 0; start--) {\
+        name##_sift(a, inc, start, n - 1);\
+    }\
+    for(int32_t end = n - 1; end > 0; end--) {\
+        SWAP(type, a[0], a[end * inc]);\
+        name##_sift(a, inc, 0, end - 1);\
+    }\
+}
+
+// the pivot is the median of three; after depth partitions, the rest of the run is heap-sorted,
+// hence the worst case is O(n log n); the recursion descends into the shorter part only
+#define SORT_DEFINE_INTROSORT(name, type, LESS, insertion, heapsort)\
+static void name(type *a, int32_t inc, int32_t n, uint8_t depth) {\
+    while(n > SORT_INSERTION_THRESHOLD) {\
+        if(depth == 0) {\
+            heapsort(a, inc, n);\
+            return;\
+        }\
+        depth--;\
+        int32_t mid = n / 2;\
+        int32_t i = 0, j = n - 1;\
+        if(LESS(a[mid * inc], a[0])) {\
+            SWAP(type, a[mid * inc], a[0]);\
+        }\
+        if(LESS(a[j * inc], a[0])) {\
+            SWAP(type, a[j * inc], a[0]);\
+        }\
+        if(LESS(a[j * inc], a[mid * inc])) {\
+            SWAP(type, a[j * inc], a[mid * inc]);\
+        }\
+        type pivot = a[mid * inc];\
+        while(i <= j) {\
+            while(LESS(a[i * inc], pivot)) i++;\
+            while(LESS(pivot, a[j * inc])) j--;\
+            if(i <= j) {\
+                SWAP(type, a[i * inc], a[j * inc]);\
+                i++;\
+                j--;\
+            }\
+        }\
+        if(j + 1 < n - i) {\
+            name(a, inc, j + 1, depth);\
+            a += i * inc;\
+            n -= i;\
+        } else {\
+            name(a + i * inc, inc, n - i, depth);\
+            n = j + 1;\
+        }\
+    }\
+    insertion(a, inc, n);\
+}
+
+// the index variants compare the values at the indices, and move only the indices
+#define SORT_DEFINE_ARG_INSERTION(name, type)\
+static void name(type *a, int32_t inc, uint16_t *idx, int32_t iinc, int32_t n) {\
+    for(int32_t i = 1; i < n; i++) {\
+        uint16_t v = idx[i * iinc];\
+        int32_t j = i;\
+        while((j > 0) && (a[v * inc] < a[idx[(j - 1) * iinc] * inc])) {\
+            idx[j * iinc] = idx[(j - 1) * iinc];\
+            j--;\
+        }\
+        idx[j * iinc] = v;\
+    }\
+}
+
+#define SORT_DEFINE_ARG_HEAPSORT(name, type)\
+static void name##_sift(type *a, int32_t inc, uint16_t *idx, int32_t iinc, int32_t root, int32_t end) {\
+    uint16_t v = idx[root * iinc];\
+    while(2 * root + 1 <= end) {\
+        int32_t child = 2 * root + 1;\
+        if((child < end) && (a[idx[child * iinc] * inc] < a[idx[(child + 1) * iinc] * inc])) {\
+            child++;\
+        }\
+        if(!(a[v * inc] < a[idx[child * iinc] * inc])) {\
+            break;\
+        }\
+        idx[root * iinc] = idx[child * iinc];\
+        root = child;\
+    }\
+    idx[root * iinc] = v;\
+}\
+static void name(type *a, int32_t inc, uint16_t *idx, int32_t iinc, int32_t n) {\
+    for(int32_t start = n / 2 - 1; start >= 0; start--) {\
+        name##_sift(a, inc, idx, iinc, start, n - 1);\
+    }\
+    for(int32_t end = n - 1; end > 0; end--) {\
+        SWAP(uint16_t, idx[0], idx[end * iinc]);\
+        name##_sift(a, inc, idx, iinc, 0, end - 1);\
+    }\
+}
+
+#define SORT_DEFINE_ARG_INTROSORT(name, type, insertion, heapsort)\
+static void name(type *a, int32_t inc, uint16_t *idx, int32_t iinc, int32_t n, uint8_t depth) {\
+    while(n > SORT_INSERTION_THRESHOLD) {\
+        if(depth == 0) {\
+            heapsort(a, inc, idx, iinc, n);\
+            return;\
+        }\
+        depth--;\
+        int32_t mid = n / 2;\
+        int32_t i = 0, j = n - 1;\
+        if(a[idx[mid * iinc] * inc] < a[idx[0] * inc]) {\
+            SWAP(uint16_t, idx[mid * iinc], idx[0]);\
+        }\
+        if(a[idx[j * iinc] * inc] < a[idx[0] * inc]) {\
+            SWAP(uint16_t, idx[j * iinc], idx[0]);\
+        }\
+        if(a[idx[j * iinc] * inc] < a[idx[mid * iinc] * inc]) {\
+            SWAP(uint16_t, idx[j * iinc], idx[mid * iinc]);\
+        }\
+        type pivot = a[idx[mid * iinc] * inc];\
+        while(i <= j) {\
+            while(a[idx[i * iinc] * inc] < pivot) i++;\
+            while(pivot < a[idx[j * iinc] * inc]) j--;\
+            if(i <= j) {\
+                SWAP(uint16_t, idx[i * iinc], idx[j * iinc]);\
+                i++;\
+                j--;\
+            }\
+        }\
+        if(j + 1 < n - i) {\
+            name(a, inc, idx, iinc, j + 1, depth);\
+            idx += i * iinc;\
+            n -= i;\
+        } else {\
+            name(a, inc, idx + i * iinc, iinc, n - i, depth);\
+            n = j + 1;\
+        }\
+    }\
+    insertion(a, inc, idx, iinc, n);\
+}
+
+// bottom-up merge sort of the indices, with insertion-sorted initial runs; scratch holds 2n indices
+#define SORT_DEFINE_ARG_MERGESORT(name, type, insertion)\
+static void name(type *a, int32_t inc, uint16_t *idx, int32_t iinc, int32_t n, uint16_t *scratch) {\
+    for(int32_t s = 0; s < n; s += SORT_INSERTION_THRESHOLD) {\
+        insertion(a, inc, idx + s * iinc, iinc, MIN(SORT_INSERTION_THRESHOLD, n - s));\
+    }\
+    if(n <= SORT_INSERTION_THRESHOLD) {\
+        return;\
+    }\
+    uint16_t *work = scratch;\
+    uint16_t *merged = scratch + n;\
+    for(int32_t i = 0; i < n; i++) {\
+        work[i] = idx[i * iinc];\
+    }\
+    for(int32_t width = SORT_INSERTION_THRESHOLD; width < n; width *= 2) {\
+        for(int32_t lo = 0; lo < n; lo += 2 * width) {\
+            int32_t mid = MIN(lo + width, n), hi = MIN(lo + 2 * width, n);\
+            int32_t l = lo, r = mid, k = lo;\
+            while((l < mid) && (r < hi)) {\
+                merged[k++] = (a[work[r] * inc] < a[work[l] * inc]) ? work[r++] : work[l++];\
+            }\
+            while(l < mid) merged[k++] = work[l++];\
+            while(r < hi) merged[k++] = work[r++];\
+        }\
+        SWAP(uint16_t *, work, merged);\
+    }\
+    for(int32_t i = 0; i < n; i++) {\
+        idx[i * iinc] = work[i];\
+    }\
+}
+
+#define SORT_LESS(a, b)     ((a) < (b))
+
+#if ULAB_NUMPY_HAS_SORT | NDARRAY_HAS_SORT | ULAB_NUMPY_HAS_ARGSORT | (ULAB_SUPPORTS_COMPLEX & ULAB_NUMPY_HAS_SORT_COMPLEX)
+static uint8_t sort_depth(size_t n) {
+    // twice the binary logarithm of n
+    uint8_t depth = 0;
+    while(n >>= 1) {
+        depth += 2;
+    }
+    return depth;
+}
+#endif
+
+#if ULAB_NUMPY_HAS_SORT | NDARRAY_HAS_SORT | ULAB_NUMPY_HAS_ARGSORT
+uint8_t sort_get_kind(mp_obj_t kind) {
+    // None, and 'quicksort' select the default, 'mergesort' is an alias of 'stable'
+    if(kind == mp_const_none) {
+        return SORT_QUICKSORT;
+    }
+    if(mp_obj_is_str(kind)) {
+        GET_STR_DATA_LEN(kind, str, len);
+        if((len == 9) && (memcmp(str, "quicksort", 9) == 0)) {
+            return SORT_QUICKSORT;
+        } else if((len == 8) && (memcmp(str, "heapsort", 8) == 0)) {
+            return SORT_HEAPSORT;
+        } else if(((len == 6) && (memcmp(str, "stable", 6) == 0)) || ((len == 9) && (memcmp(str, "mergesort", 9) == 0))) {
+            return SORT_STABLE;
+        }
+    }
+    mp_raise_ValueError(MP_ERROR_TEXT("kind must be 'quicksort', 'mergesort', 'heapsort', or 'stable'"));
+}
+#endif
+
+#if ULAB_NUMPY_HAS_SORT | NDARRAY_HAS_SORT
+SORT_DEFINE_INSERTION(sort_insertion_uint8, uint8_t, SORT_LESS)
+SORT_DEFINE_INSERTION(sort_insertion_int8, int8_t, SORT_LESS)
+SORT_DEFINE_INSERTION(sort_insertion_uint16, uint16_t, SORT_LESS)
+SORT_DEFINE_INSERTION(sort_insertion_int16, int16_t, SORT_LESS)
+SORT_DEFINE_INSERTION(sort_insertion_float, mp_float_t, SORT_LESS)
+
+SORT_DEFINE_HEAPSORT(sort_heapsort_uint8, uint8_t, SORT_LESS)
+SORT_DEFINE_HEAPSORT(sort_heapsort_int8, int8_t, SORT_LESS)
+SORT_DEFINE_HEAPSORT(sort_heapsort_uint16, uint16_t, SORT_LESS)
+SORT_DEFINE_HEAPSORT(sort_heapsort_int16, int16_t, SORT_LESS)
+SORT_DEFINE_HEAPSORT(sort_heapsort_float, mp_float_t, SORT_LESS)
+
+SORT_DEFINE_INTROSORT(sort_introsort_float, mp_float_t, SORT_LESS, sort_insertion_float, sort_heapsort_float)
+
+static void sort_counting8(uint8_t *a, int32_t inc, int32_t n, uint8_t flip, size_t *counts) {
+    // signed values are sorted by flipping the sign bit, which maps them onto the unsigned order
+    memset(counts, 0, 256 * sizeof(size_t));
+    for(int32_t i = 0; i < n; i++) {
+        counts[a[i * inc] ^ flip]++;
+    }
+    for(uint16_t key = 0; key < 256; key++) {
+        for(size_t c = counts[key]; c; c--) {
+            *a = (uint8_t)key ^ flip;
+            a += inc;
+        }
+    }
+}
+
+static void sort_radix16(uint16_t *a, int32_t inc, int32_t n, uint16_t flip, uint16_t *buffer, size_t *counts) {
+    // two passes of 8 bits: the low bytes scatter a into buffer, the high bytes buffer back into a
+    memset(counts, 0, 256 * sizeof(size_t));
+    for(int32_t i = 0; i < n; i++) {
+        counts[(a[i * inc] ^ flip) & 0xFF]++;
+    }
+    size_t sum = 0;
+    for(uint16_t key = 0; key < 256; key++) {
+        size_t c = counts[key];
+        counts[key] = sum;
+        sum += c;
+    }
+    for(int32_t i = 0; i < n; i++) {
+        uint16_t v = a[i * inc] ^ flip;
+        buffer[counts[v & 0xFF]++] = v;
+    }
+
+    memset(counts, 0, 256 * sizeof(size_t));
+    for(int32_t i = 0; i < n; i++) {
+        counts[buffer[i] >> 8]++;
+    }
+    sum = 0;
+    for(uint16_t key = 0; key < 256; key++) {
+        size_t c = counts[key];
+        counts[key] = sum;
+        sum += c;
+    }
+    for(int32_t i = 0; i < n; i++) {
+        uint16_t v = buffer[i];
+        a[counts[v >> 8]++ * inc] = v ^ flip;
+    }
+}
+
+size_t sort_values_scratch(uint8_t dtype, size_t n, uint8_t kind) {
+    // the size of the scratch space in bytes that sort_values requires for lanes of length n
+    if((kind == SORT_HEAPSORT) || (dtype == NDARRAY_FLOAT)) {
+        return 0;
+    }
+    size_t size = 256 * sizeof(size_t);
+    if((dtype == NDARRAY_UINT16) || ULAB_DTYPE_IS(dtype, INT16)) {
+        size += n * sizeof(uint16_t);
+    }
+    return size;
+}
+
+void sort_values(uint8_t dtype, uint8_t *array, int32_t inc, size_t n, uint8_t kind, void *scratch) {
+    // sorts n values of the given dtype, starting at array, in place; scratch must be
+    // at least sort_values_scratch(dtype, n, kind) bytes long
+    int32_t len = (int32_t)n;
+    bool released = ulab_gil_exit(n);
+    if(dtype == NDARRAY_FLOAT) {
+        if(kind == SORT_HEAPSORT) {
+            sort_heapsort_float((mp_float_t *)array, inc, len);
+        } else {
+            sort_introsort_float((mp_float_t *)array, inc, len, sort_depth(n));
+        }
+    } else if(kind == SORT_HEAPSORT) {
+        if(ULAB_DTYPE_IS(dtype, INT8)) {
+            sort_heapsort_int8((int8_t *)array, inc, len);
+        } else if(dtype == NDARRAY_UINT16) {
+            sort_heapsort_uint16((uint16_t *)array, inc, len);
+        } else if(ULAB_DTYPE_IS(dtype, INT16)) {
+            sort_heapsort_int16((int16_t *)array, inc, len);
+        } else {
+            sort_heapsort_uint8(array, inc, len);
+        }
+    } else if(len <= SORT_INSERTION_THRESHOLD) {
+        if(ULAB_DTYPE_IS(dtype, INT8)) {
+            sort_insertion_int8((int8_t *)array, inc, len);
+        } else if(dtype == NDARRAY_UINT16) {
+            sort_insertion_uint16((uint16_t *)array, inc, len);
+        } else if(ULAB_DTYPE_IS(dtype, INT16)) {
+            sort_insertion_int16((int16_t *)array, inc, len);
+        } else {
+            sort_insertion_uint8(array, inc, len);
+        }
+    } else {
+        size_t *counts = (size_t *)scratch;
+        if(ULAB_DTYPE_IS(dtype, INT8)) {
+            sort_counting8(array, inc, len, 0x80, counts);
+        } else if(dtype == NDARRAY_UINT16) {
+            sort_radix16((uint16_t *)array, inc, len, 0, (uint16_t *)(counts + 256), counts);
+        } else if(ULAB_DTYPE_IS(dtype, INT16)) {
+            sort_radix16((uint16_t *)array, inc, len, 0x8000, (uint16_t *)(counts + 256), counts);
+        } else {
+            sort_counting8(array, inc, len, 0, counts);
+        }
+    }
+    ulab_gil_enter(released);
+}
+#endif /* ULAB_NUMPY_HAS_SORT | NDARRAY_HAS_SORT */
+
+#if ULAB_NUMPY_HAS_ARGSORT
+SORT_DEFINE_ARG_INSERTION(sort_arg_insertion_uint8, uint8_t)
+SORT_DEFINE_ARG_INSERTION(sort_arg_insertion_int8, int8_t)
+SORT_DEFINE_ARG_INSERTION(sort_arg_insertion_uint16, uint16_t)
+SORT_DEFINE_ARG_INSERTION(sort_arg_insertion_int16, int16_t)
+SORT_DEFINE_ARG_INSERTION(sort_arg_insertion_float, mp_float_t)
+
+SORT_DEFINE_ARG_HEAPSORT(sort_arg_heapsort_uint8, uint8_t)
+SORT_DEFINE_ARG_HEAPSORT(sort_arg_heapsort_int8, int8_t)
+SORT_DEFINE_ARG_HEAPSORT(sort_arg_heapsort_uint16, uint16_t)
+SORT_DEFINE_ARG_HEAPSORT(sort_arg_heapsort_int16, int16_t)
+SORT_DEFINE_ARG_HEAPSORT(sort_arg_heapsort_float, mp_float_t)
+
+SORT_DEFINE_ARG_INTROSORT(sort_arg_introsort_uint8, uint8_t, sort_arg_insertion_uint8, sort_arg_heapsort_uint8)
+SORT_DEFINE_ARG_INTROSORT(sort_arg_introsort_int8, int8_t, sort_arg_insertion_int8, sort_arg_heapsort_int8)
+SORT_DEFINE_ARG_INTROSORT(sort_arg_introsort_uint16, uint16_t, sort_arg_insertion_uint16, sort_arg_heapsort_uint16)
+SORT_DEFINE_ARG_INTROSORT(sort_arg_introsort_int16, int16_t, sort_arg_insertion_int16, sort_arg_heapsort_int16)
+SORT_DEFINE_ARG_INTROSORT(sort_arg_introsort_float, mp_float_t, sort_arg_insertion_float, sort_arg_heapsort_float)
+
+SORT_DEFINE_ARG_MERGESORT(sort_arg_mergesort_uint8, uint8_t, sort_arg_insertion_uint8)
+SORT_DEFINE_ARG_MERGESORT(sort_arg_mergesort_int8, int8_t, sort_arg_insertion_int8)
+SORT_DEFINE_ARG_MERGESORT(sort_arg_mergesort_uint16, uint16_t, sort_arg_insertion_uint16)
+SORT_DEFINE_ARG_MERGESORT(sort_arg_mergesort_int16, int16_t, sort_arg_insertion_int16)
+SORT_DEFINE_ARG_MERGESORT(sort_arg_mergesort_float, mp_float_t, sort_arg_insertion_float)
+
+#define SORT_ARG_DISPATCH(type, suffix) do {\
+    if(kind == SORT_HEAPSORT) {\
+        sort_arg_heapsort_##suffix((type *)array, inc, iarray, iinc, len);\
+    } else if(kind == SORT_STABLE) {\
+        sort_arg_mergesort_##suffix((type *)array, inc, iarray, iinc, len, scratch);\
+    } else {\
+        sort_arg_introsort_##suffix((type *)array, inc, iarray, iinc, len, sort_depth(n));\
+    }\
+} while(0)
+
+size_t sort_indices_scratch(size_t n, uint8_t kind) {
+    // the number of indices that sort_indices requires as scratch space for lanes of length n
+    return kind == SORT_STABLE ? 2 * n : 0;
+}
+
+void sort_indices(uint8_t dtype, uint8_t *array, int32_t inc, uint16_t *iarray, int32_t iinc, size_t n, uint8_t kind, uint16_t *scratch) {
+    // re-orders the n indices starting at iarray, so that the values at array are sorted;
+    // with kind = SORT_STABLE, the order of equal values is retained
+    int32_t len = (int32_t)n;
+    bool released = ulab_gil_exit(n);
+    if(ULAB_DTYPE_IS(dtype, INT8)) {
+        SORT_ARG_DISPATCH(int8_t, int8);
+    } else if(dtype == NDARRAY_UINT16) {
+        SORT_ARG_DISPATCH(uint16_t, uint16);
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {
+        SORT_ARG_DISPATCH(int16_t, int16);
+    } else if(dtype == NDARRAY_FLOAT) {
+        SORT_ARG_DISPATCH(mp_float_t, float);
+    } else {
+        SORT_ARG_DISPATCH(uint8_t, uint8);
+    }
+    ulab_gil_enter(released);
+}
+#endif /* ULAB_NUMPY_HAS_ARGSORT */
+
+#if ULAB_SUPPORTS_COMPLEX & ULAB_NUMPY_HAS_SORT_COMPLEX
+typedef struct _sort_complex_t {
+    mp_float_t real;
+    mp_float_t imag;
+} sort_complex_t;
+
+// complex numbers are ordered by the real part first, then the imaginary part
+#define SORT_LESS_COMPLEX(a, b)     (((a).real < (b).real) || (((a).real == (b).real) && ((a).imag < (b).imag)))
+
+SORT_DEFINE_INSERTION(sort_insertion_complex, sort_complex_t, SORT_LESS_COMPLEX)
+SORT_DEFINE_HEAPSORT(sort_heapsort_complex, sort_complex_t, SORT_LESS_COMPLEX)
+SORT_DEFINE_INTROSORT(sort_introsort_complex, sort_complex_t, SORT_LESS_COMPLEX, sort_insertion_complex, sort_heapsort_complex)
+
+void sort_complex(mp_float_t *array, size_t n) {
+    // array holds the real and imaginary parts of a dense complex array at alternating positions
+    bool released = ulab_gil_exit(n);
+    sort_introsort_complex((sort_complex_t *)array, 1, (int32_t)n, sort_depth(n));
+    ulab_gil_enter(released);
+}
+#endif
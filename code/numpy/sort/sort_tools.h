@@ -0,0 +1,38 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#ifndef _SORT_TOOLS_
+#define _SORT_TOOLS_
+
+#include "../../ulab.h"
+#include "../../ndarray.h"
+
+// runs shorter than this are sorted by insertion
+#define SORT_INSERTION_THRESHOLD        (16)
+
+enum SORT_KIND {
+    SORT_QUICKSORT,
+    SORT_HEAPSORT,
+    SORT_STABLE,
+};
+
+uint8_t sort_get_kind(mp_obj_t );
+
+size_t sort_values_scratch(uint8_t , size_t , uint8_t );
+void sort_values(uint8_t , uint8_t *, int32_t , size_t , uint8_t , void *);
+
+size_t sort_indices_scratch(size_t , uint8_t );
+void sort_indices(uint8_t , uint8_t *, int32_t , uint16_t *, int32_t , size_t , uint8_t , uint16_t *);
+
+#if ULAB_SUPPORTS_COMPLEX
+void sort_complex(mp_float_t *, size_t );
+#endif
+
+#endif
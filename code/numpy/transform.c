@@ -12,6 +12,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <math.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include "py/obj.h"
@@ -20,6 +21,7 @@
 
 #include "../ulab.h"
 #include "../ulab_tools.h"
+#include "../ulab_dsp.h"
 #include "carray/carray_tools.h"
 #include "numerical.h"
 #include "transform.h"
@@ -58,16 +60,28 @@ static mp_obj_t transform_compress(size_t n_args, const mp_obj_t *pos_args, mp_m
         mp_raise_ValueError(MP_ERROR_TEXT("wrong length of condition array"));
     }
 
-    size_t true_count = 0;
-    mp_obj_iter_buf_t iter_buf;
-    mp_obj_t item, iterable = mp_getiter(condition, &iter_buf);
-    while((item = mp_iternext(iterable)) != MP_OBJ_STOP_ITERATION) {
-        if(mp_obj_is_true(item)) {
-            true_count++;
+    // the condition is turned into a byte mask once, so that the copy loop below
+    // can jump over runs of false values, instead of iterating item by item
+    uint8_t *mask = NULL;
+    uint8_t *mask_scratch = NULL;
+    int32_t mstride = 1;
+    if(mp_obj_is_type(condition, &ulab_ndarray_type) && (((ndarray_obj_t *)MP_OBJ_TO_PTR(condition))->ndim == 1) &&
+        (((ndarray_obj_t *)MP_OBJ_TO_PTR(condition))->dtype == NDARRAY_UINT8)) {
+        ndarray_obj_t *cndarray = MP_OBJ_TO_PTR(condition);
+        mask = (uint8_t *)cndarray->array;
+        mstride = cndarray->strides[ULAB_MAX_DIMS - 1];
+    } else {
+        mask_scratch = ulab_scratch_new(uint8_t, len);
+        mp_obj_iter_buf_t iter_buf;
+        mp_obj_t item, iterable = mp_getiter(condition, &iter_buf);
+        for(size_t m = 0; m < len; m++) {
+            item = mp_iternext(iterable);
+            mask_scratch[m] = mp_obj_is_true(item) ? 1 : 0;
         }
+        mask = mask_scratch;
     }
 
-    iterable = mp_getiter(condition, &iter_buf);
+    size_t true_count = tools_count_true(mask, mstride, len);
 
     ndarray_obj_t *result = NULL;
 
@@ -114,21 +128,16 @@ static mp_obj_t transform_compress(size_t n_args, const mp_obj_t *pos_args, mp_m
             size_t k = 0;
             do {
             #endif
-                size_t l = 0;
-                if(axis != mp_const_none) {
-                    iterable = mp_getiter(condition, &iter_buf);
+                for(size_t l = tools_next_true(mask, mstride, 0, shape[ULAB_MAX_DIMS - 1]); l < shape[ULAB_MAX_DIMS - 1];
+                    l = tools_next_true(mask, mstride, l + 1, shape[ULAB_MAX_DIMS - 1])) {
+                    memcpy(rarray, array + (ptrdiff_t)l * strides[ULAB_MAX_DIMS - 1], ndarray->itemsize);
+                    rarray += rstrides[ULAB_MAX_DIMS - 1];
+                }
+                if(axis == mp_const_none) {
+                    // the mask runs over the flattened array
+                    mask += (ptrdiff_t)mstride * shape[ULAB_MAX_DIMS - 1];
                 }
-                do {
-                    item = mp_iternext(iterable);
-                    if(mp_obj_is_true(item)) {
-                        memcpy(rarray, array, ndarray->itemsize);
-                        rarray += rstrides[ULAB_MAX_DIMS - 1];
-                    }
-                    array += strides[ULAB_MAX_DIMS - 1];
-                    l++;
-                } while(l < shape[ULAB_MAX_DIMS - 1]);
             #if ULAB_MAX_DIMS > 1
-                array -= strides[ULAB_MAX_DIMS - 1] * shape[ULAB_MAX_DIMS - 1];
                 array += strides[ULAB_MAX_DIMS - 2];
                 rarray -= rstrides[ULAB_MAX_DIMS - 1] * rshape[ULAB_MAX_DIMS - 1];
                 rarray += rstrides[ULAB_MAX_DIMS - 2];
@@ -146,8 +155,8 @@ static mp_obj_t transform_compress(size_t n_args, const mp_obj_t *pos_args, mp_m
     #if ULAB_MAX_DIMS > 3
         array -= strides[ULAB_MAX_DIMS - 3] * shape[ULAB_MAX_DIMS - 3];
         array += strides[ULAB_MAX_DIMS - 4];
-        rarray -= rstrides[ULAB_MAX_DIMS - 2] * rshape[ULAB_MAX_DIMS - 2];
-        rarray += rstrides[ULAB_MAX_DIMS - 3];
+        rarray -= rstrides[ULAB_MAX_DIMS - 3] * rshape[ULAB_MAX_DIMS - 3];
+        rarray += rstrides[ULAB_MAX_DIMS - 4];
         i++;
     } while(i < shape[ULAB_MAX_DIMS - 4]);
     #endif
@@ -156,6 +165,9 @@ static mp_obj_t transform_compress(size_t n_args, const mp_obj_t *pos_args, mp_m
     m_del(size_t, rshape, ULAB_MAX_DIMS);
     m_del(int32_t, strides, ULAB_MAX_DIMS);
     m_del(int32_t, rstrides, ULAB_MAX_DIMS);
+    if(mask_scratch != NULL) {
+        ulab_scratch_del(uint8_t, mask_scratch, len);
+    }
 
     return MP_OBJ_FROM_PTR(result);
 }
@@ -343,67 +355,184 @@ MP_DEFINE_CONST_FUN_OBJ_KW(transform_delete_obj, 2, transform_delete);
 
 #if ULAB_MAX_DIMS > 1
 #if ULAB_NUMPY_HAS_DOT
+// Multiplies the (shape1, K) matrix, whose rows start at array1, with the (K, shape2) matrix at array2.
+// The columns of m2 are packed into a contiguous strip of width columns (at most TRANSFORM_DOT_PANEL elements),
+// and the rows of m1 into a buffer of length K, so that the inner product runs over contiguous memory,
+// and each element is converted only once per strip by the typed loaders of ulab_tools.c. Since the
+// products are accumulated in the order of k, the result is identical to that of the naive triple loop.
+#define TRANSFORM_DOT_KERNEL(type, acc_type, panel, row, load)\
+({\
+    for(size_t jj = 0; jj < shape2; jj += width) {\
+        size_t jb = MIN(width, shape2 - jj);\
+        uint8_t *column = array2 + jj * m2->strides[ULAB_MAX_DIMS - 1];\
+        for(size_t j = 0; j < jb; j++) {\
+            load((panel) + j * K, 1, column, s2, m2->dtype, K);\
+            column += m2->strides[ULAB_MAX_DIMS - 1];\
+        }\
+        uint8_t *source1 = array1;\
+        for(size_t i = 0; i < shape1; i++) {\
+            load((row), 1, source1, s1, m1->dtype, K);\
+            mp_float_t *target = rarray + i * shape2 + jj;\
+            type *p = (panel);\
+            for(size_t j = 0; j < jb; j++) {\
+                acc_type dot = 0;\
+                for(size_t k = 0; k < K; k++) {\
+                    dot += (acc_type)(row)[k] * (acc_type)(*p++);\
+                }\
+                *target++ = (mp_float_t)dot;\
+            }\
+            source1 += m1->strides[ULAB_MAX_DIMS - 2];\
+        }\
+    }\
+})
+
+#if ULAB_SUPPORTS_COMPLEX
+// The complex equivalent of TRANSFORM_DOT_KERNEL: both operands are loaded as interleaved
+// complex numbers, so that real and complex arrays can be freely mixed.
+#define TRANSFORM_DOT_COMPLEX_KERNEL(panel, row)\
+({\
+    for(size_t jj = 0; jj < shape2; jj += width) {\
+        size_t jb = MIN(width, shape2 - jj);\
+        uint8_t *column = array2 + jj * m2->strides[ULAB_MAX_DIMS - 1];\
+        for(size_t j = 0; j < jb; j++) {\
+            tools_load_complex((panel) + 2 * j * K, column, s2, m2->dtype, K);\
+            column += m2->strides[ULAB_MAX_DIMS - 1];\
+        }\
+        uint8_t *source1 = array1;\
+        for(size_t i = 0; i < shape1; i++) {\
+            tools_load_complex((row), source1, s1, m1->dtype, K);\
+            mp_float_t *target = rarray + 2 * (i * shape2 + jj);\
+            mp_float_t *p = (panel);\
+            for(size_t j = 0; j < jb; j++) {\
+                mp_float_t real = MICROPY_FLOAT_CONST(0.0), imag = MICROPY_FLOAT_CONST(0.0);\
+                mp_float_t *r = (row);\
+                for(size_t k = 0; k < K; k++) {\
+                    real += r[0] * p[0] - r[1] * p[1];\
+                    imag += r[0] * p[1] + r[1] * p[0];\
+                    r += 2;\
+                    p += 2;\
+                }\
+                *target++ = real;\
+                *target++ = imag;\
+            }\
+            source1 += m1->strides[ULAB_MAX_DIMS - 2];\
+        }\
+    }\
+})
+#endif
+
 //| def dot(m1: ulab.numpy.ndarray, m2: ulab.numpy.ndarray) -> Union[ulab.numpy.ndarray, _float]:
 //|    """
-//|    :param ~ulab.numpy.ndarray m1: a matrix, or a vector
+//|    :param ~ulab.numpy.ndarray m1: a matrix, a vector, or a stack of matrices of shape (..., M, K)
 //|    :param ~ulab.numpy.ndarray m2: a matrix, or a vector
 //|
-//|    Computes the product of two matrices, or two vectors. In the letter case, the inner product is returned."""
+//|    Computes the product of two matrices, or two vectors. In the letter case, the inner product is returned.
+//|    If m1 is a stack, each of its matrices is multiplied by m2. m2 can't be a stack of matrices."""
 //|    ...
 //|
 
 mp_obj_t transform_dot(mp_obj_t _m1, mp_obj_t _m2) {
     // TODO: should the results be upcast?
-    // This implements 2D operations only!
     if(!mp_obj_is_type(_m1, &ulab_ndarray_type) || !mp_obj_is_type(_m2, &ulab_ndarray_type)) {
         mp_raise_TypeError(MP_ERROR_TEXT("arguments must be ndarrays"));
     }
     ndarray_obj_t *m1 = MP_OBJ_TO_PTR(_m1);
     ndarray_obj_t *m2 = MP_OBJ_TO_PTR(_m2);
-    COMPLEX_DTYPE_NOT_IMPLEMENTED(m1->dtype)
-    COMPLEX_DTYPE_NOT_IMPLEMENTED(m2->dtype)
-
-    uint8_t *array1 = (uint8_t *)m1->array;
-    uint8_t *array2 = (uint8_t *)m2->array;
-
-    mp_float_t (*func1)(void *) = ndarray_get_float_function(m1->dtype);
-    mp_float_t (*func2)(void *) = ndarray_get_float_function(m2->dtype);
+    #if ULAB_SUPPORTS_COMPLEX
+    bool complex = (m1->dtype == NDARRAY_COMPLEX) || (m2->dtype == NDARRAY_COMPLEX);
+    uint8_t dtype = complex ? NDARRAY_COMPLEX : NDARRAY_FLOAT;
+    // a complex element occupies two floats in the buffers and the results
+    uint8_t nfloat = complex ? 2 : 1;
+    #else
+    uint8_t dtype = NDARRAY_FLOAT;
+    uint8_t nfloat = 1;
+    #endif
 
-    if(m1->shape[ULAB_MAX_DIMS - 1] != m2->shape[ULAB_MAX_DIMS - m2->ndim]) {
+    // the contracted axis of m2 is the second to last one, unless m2 is a vector
+    uint8_t axis2 = m2->ndim == 1 ? ULAB_MAX_DIMS - 1 : ULAB_MAX_DIMS - 2;
+    if(m1->shape[ULAB_MAX_DIMS - 1] != m2->shape[axis2]) {
         mp_raise_ValueError(MP_ERROR_TEXT("dimensions do not match"));
     }
-    uint8_t ndim = MIN(m1->ndim, m2->ndim);
-    size_t shape1 = m1->ndim == 2 ? m1->shape[ULAB_MAX_DIMS - m1->ndim] : 1;
-    size_t shape2 = m2->ndim == 2 ? m2->shape[ULAB_MAX_DIMS - 1] : 1;
-
-    size_t *shape = NULL;
-    if(ndim == 2) { // matrix times matrix -> matrix
-        shape = ndarray_shape_vector(0, 0, shape1, shape2);
-    } else { // matrix times vector -> vector, vector times vector -> vector (size 1)
-        shape = ndarray_shape_vector(0, 0, 0, shape1 * shape2);
+    #if ULAB_MAX_DIMS > 2
+    if(m2->ndim > 2) {
+        // numpy.dot would contract with the second to last axis of each matrix of m2,
+        // and return the outer product of the stacks, which is not implemented
+        mp_raise_NotImplementedError(MP_ERROR_TEXT("dot is not implemented for a stack as the second argument"));
     }
-    ndarray_obj_t *results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
-    mp_float_t *rarray = (mp_float_t *)results->array;
-
-    for(size_t i=0; i < shape1; i++) { // rows of m1
-        for(size_t j=0; j < shape2; j++) { // columns of m2
-            mp_float_t dot = 0.0;
-            for(size_t k=0; k < m1->shape[ULAB_MAX_DIMS - 1]; k++) {
-                // (i, k) * (k, j)
-                dot += func1(array1) * func2(array2);
-                array1 += m1->strides[ULAB_MAX_DIMS - 1];
-                array2 += m2->strides[ULAB_MAX_DIMS - m2->ndim];
+    #endif
+    size_t K = m1->shape[ULAB_MAX_DIMS - 1];
+    int32_t s1 = m1->strides[ULAB_MAX_DIMS - 1];
+    int32_t s2 = m2->strides[axis2];
+    size_t shape1 = m1->ndim >= 2 ? m1->shape[ULAB_MAX_DIMS - 2] : 1;
+    size_t shape2 = m2->ndim >= 2 ? m2->shape[ULAB_MAX_DIMS - 1] : 1;
+
+    ndarray_obj_t *results = NULL;
+    if(m1->ndim > 2) {
+        // the result inherits the leading axes of m1
+        size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
+        memcpy(shape, m1->shape, sizeof(size_t) * ULAB_MAX_DIMS);
+        uint8_t ndim = m1->ndim;
+        if(m2->ndim == 1) {
+            // the last axis is contracted
+            for(uint8_t i = ULAB_MAX_DIMS - 1; i > ULAB_MAX_DIMS - m1->ndim; i--) {
+                shape[i] = m1->shape[i - 1];
             }
-            *rarray++ = dot;
-            array1 -= m1->strides[ULAB_MAX_DIMS - 1] * m1->shape[ULAB_MAX_DIMS - 1];
-            array2 -= m2->strides[ULAB_MAX_DIMS - m2->ndim] * m2->shape[ULAB_MAX_DIMS - m2->ndim];
-            array2 += m2->strides[ULAB_MAX_DIMS - 1];
+            ndim--;
+        } else {
+            shape[ULAB_MAX_DIMS - 1] = shape2;
+        }
+        results = ndarray_new_dense_ndarray(ndim, shape, dtype);
+        m_del(size_t, shape, ULAB_MAX_DIMS);
+    } else if(MIN(m1->ndim, m2->ndim) == 2) { // matrix times matrix -> matrix
+        results = ndarray_new_dense_ndarray(2, ndarray_shape_vector(0, 0, shape1, shape2), dtype);
+    } else { // matrix times vector -> vector, vector times vector -> vector (size 1)
+        results = ndarray_new_dense_ndarray(1, ndarray_shape_vector(0, 0, 0, shape1 * shape2), dtype);
+    }
+
+    size_t stack = m1->ndim > 2 ? tools_stack_count(m1, 2) : 1;
+    size_t width = MAX(1, MIN(shape2, TRANSFORM_DOT_PANEL / MAX(1, K)));
+    // uint32 values don't fit into an int32_t, hence they are multiplied as floats, as is float16
+    bool integer = !ULAB_DTYPE_IS_FLOAT(m1->dtype) && !ULAB_DTYPE_IS_FLOAT(m2->dtype) &&
+                    !ULAB_DTYPE_IS(m1->dtype, UINT32) && !ULAB_DTYPE_IS(m2->dtype, UINT32);
+    // dense float matrices can be handed over to the DSP library, if there is one
+    bool dense = (m1->dtype == NDARRAY_FLOAT) && (m2->dtype == NDARRAY_FLOAT) &&
+                (s1 == sizeof(mp_float_t)) && ((shape1 == 1) || (m1->strides[ULAB_MAX_DIMS - 2] == (int32_t)(K * sizeof(mp_float_t)))) &&
+                (s2 == (int32_t)(shape2 * sizeof(mp_float_t))) && ((shape2 == 1) || (m2->strides[ULAB_MAX_DIMS - 1] == sizeof(mp_float_t)));
+    // the integer buffers are reserved in the float panel, an int32_t is never longer than an mp_float_t
+    mp_float_t *panel = m_new(mp_float_t, nfloat * width * K);
+    mp_float_t *row = m_new(mp_float_t, nfloat * K);
+
+    for(size_t n = 0; n < stack; n++) {
+        uint8_t *array1 = m1->ndim > 2 ? tools_stack_pointer(m1, 2, n) : (uint8_t *)m1->array;
+        uint8_t *array2 = (uint8_t *)m2->array;
+        mp_float_t *rarray = (mp_float_t *)results->array + nfloat * n * shape1 * shape2;
+        #if ULAB_SUPPORTS_COMPLEX
+        if(complex) {
+            TRANSFORM_DOT_COMPLEX_KERNEL(panel, row);
+            continue;
+        }
+        #endif
+        if(dense && ulab_dsp_matmul((mp_float_t *)array1, (mp_float_t *)array2, rarray, shape1, K, shape2)) {
+            continue;
+        }
+        if(integer) {
+            // integer operands are multiplied exactly, and accumulated in 64 bits
+            TRANSFORM_DOT_KERNEL(int32_t, int64_t, (int32_t *)panel, (int32_t *)row, tools_load_int32);
+        } else {
+            TRANSFORM_DOT_KERNEL(mp_float_t, mp_float_t, panel, row, tools_load_float);
         }
-        array1 += m1->strides[ULAB_MAX_DIMS - m1->ndim];
-        array2 = m2->array;
     }
+    m_del(mp_float_t, row, nfloat * K);
+    m_del(mp_float_t, panel, nfloat * width * K);
+
     if((m1->ndim * m2->ndim) == 1) { // return a scalar, if product of two vectors
-        return mp_obj_new_float(*(--rarray));
+        #if ULAB_SUPPORTS_COMPLEX
+        if(complex) {
+            mp_float_t *rarray = (mp_float_t *)results->array;
+            return mp_obj_new_complex(rarray[0], rarray[1]);
+        }
+        #endif
+        return mp_obj_new_float(*(mp_float_t *)results->array);
     } else {
         return MP_OBJ_FROM_PTR(results);
     }
@@ -413,6 +542,44 @@ MP_DEFINE_CONST_FUN_OBJ_2(transform_dot_obj, transform_dot);
 #endif /* ULAB_NUMPY_HAS_DOT */
 #endif /* ULAB_MAX_DIMS > 1 */
 
+#if ULAB_NUMPY_HAS_PUT | ULAB_NUMPY_HAS_TAKE
+static uint8_t transform_get_index_mode(mp_obj_t mode) {
+    if(mp_obj_is_str(mode)) {
+        GET_STR_DATA_LEN(mode, str, len);
+        if((len == 5) && (memcmp(str, "raise", 5) == 0)) {
+            return NDARRAY_INDEX_RAISE;
+        } else if((len == 4) && (memcmp(str, "wrap", 4) == 0)) {
+            return NDARRAY_INDEX_WRAP;
+        } else if((len == 4) && (memcmp(str, "clip", 4) == 0)) {
+            return NDARRAY_INDEX_CLIP;
+        }
+    }
+    mp_raise_ValueError(MP_ERROR_TEXT("mode must be 'raise', 'wrap', or 'clip'"));
+}
+#endif
+
+#if ULAB_NUMPY_HAS_PUT
+static mp_obj_t transform_put(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_mode, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_QSTR(MP_QSTR_raise) } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if(!mp_obj_is_type(args[0].u_obj, &ulab_ndarray_type)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("wrong input type"));
+    }
+    ndarray_put(MP_OBJ_TO_PTR(args[0].u_obj), args[1].u_obj, args[2].u_obj, transform_get_index_mode(args[3].u_obj));
+    return mp_const_none;
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(transform_put_obj, 3, transform_put);
+#endif /* ULAB_NUMPY_HAS_PUT */
+
 #if ULAB_NUMPY_HAS_SIZE
 static mp_obj_t transform_size(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     static const mp_arg_t allowed_args[] = {
@@ -449,3 +616,24 @@ static mp_obj_t transform_size(size_t n_args, const mp_obj_t *pos_args, mp_map_t
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(transform_size_obj, 1, transform_size);
 #endif
+
+#if ULAB_NUMPY_HAS_TAKE
+static mp_obj_t transform_take(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_axis, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_mode, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_QSTR(MP_QSTR_raise) } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if(!mp_obj_is_type(args[0].u_obj, &ulab_ndarray_type)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("wrong input type"));
+    }
+    return ndarray_take(MP_OBJ_TO_PTR(args[0].u_obj), args[1].u_obj, args[2].u_obj, transform_get_index_mode(args[3].u_obj));
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(transform_take_obj, 2, transform_take);
+#endif /* ULAB_NUMPY_HAS_TAKE */
@@ -22,9 +22,14 @@
 #include "../ulab.h"
 #include "../ulab_tools.h"
 
+// the maximum number of elements of m2 that dot packs into a contiguous strip
+#define TRANSFORM_DOT_PANEL         (1024)
+
 MP_DECLARE_CONST_FUN_OBJ_KW(transform_compress_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(transform_delete_obj);
 MP_DECLARE_CONST_FUN_OBJ_2(transform_dot_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(transform_put_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(transform_size_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(transform_take_obj);
 
 #endif
@@ -15,6 +15,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "py/runtime.h"
 #include "py/binary.h"
 #include "py/obj.h"
@@ -22,9 +23,191 @@
 
 #include "../ulab.h"
 #include "../ulab_tools.h"
+#include "../ulab_simd.h"
+#include "../ulab_parallel.h"
 #include "carray/carray_tools.h"
 #include "vector.h"
 
+#if ULAB_VECTOR_FAST_MATH
+#if MICROPY_FLOAT_IMPL != MICROPY_FLOAT_IMPL_FLOAT
+#error "ULAB_VECTOR_FAST_MATH requires single-precision floats"
+#endif
+
+// The approximations follow the single-precision functions of the cephes library:
+// the argument is reduced with a constant that is split into a short, exactly
+// representable part, and a correction, and the remainder goes into a minimax polynomial.
+
+typedef union {
+    mp_float_t f;
+    uint32_t u;
+} vector_fast_float_t;
+
+static mp_float_t vector_fast_pow2(int32_t k) {
+    // returns 2^k for -126 <= k <= 127
+    vector_fast_float_t p;
+    p.u = (uint32_t)(k + 127) << 23;
+    return p.f;
+}
+
+static mp_float_t vector_fast_exp(mp_float_t x) {
+    if(x > MICROPY_FLOAT_CONST(88.72283935546875)) {
+        return INFINITY;
+    } else if(x < MICROPY_FLOAT_CONST(-103.972084)) {
+        return MICROPY_FLOAT_CONST(0.0);
+    } else if(isnan(x)) {
+        return x;
+    }
+    // x = k ln2 + r, with |r| <= ln2 / 2
+    mp_float_t k = MICROPY_FLOAT_C_FUN(floor)(MICROPY_FLOAT_CONST(1.44269504088896341) * x + MICROPY_FLOAT_CONST(0.5));
+    mp_float_t r = x - k * MICROPY_FLOAT_CONST(0.693359375) + k * MICROPY_FLOAT_CONST(2.12194440e-4);
+    mp_float_t p = MICROPY_FLOAT_CONST(1.9875691500e-4);
+    p = p * r + MICROPY_FLOAT_CONST(1.3981999507e-3);
+    p = p * r + MICROPY_FLOAT_CONST(8.3334519073e-3);
+    p = p * r + MICROPY_FLOAT_CONST(4.1665795894e-2);
+    p = p * r + MICROPY_FLOAT_CONST(1.6666665459e-1);
+    p = p * r + MICROPY_FLOAT_CONST(5.0000001201e-1);
+    p = p * r * r + r + MICROPY_FLOAT_CONST(1.0);
+    // 2^k is split into two factors, so that subnormal results come out right
+    int32_t n = (int32_t)k;
+    return p * vector_fast_pow2(n / 2) * vector_fast_pow2(n - n / 2);
+}
+
+static mp_float_t vector_fast_log(mp_float_t x) {
+    if(!(x > MICROPY_FLOAT_CONST(0.0))) {
+        return x == MICROPY_FLOAT_CONST(0.0) ? -INFINITY : NAN;
+    } else if(isinf(x)) {
+        return x;
+    }
+    vector_fast_float_t v = { .f = x };
+    int32_t e = 0;
+    if(v.u < 0x00800000) {
+        // subnormal numbers are normalised first
+        v.f *= MICROPY_FLOAT_CONST(8388608.0);
+        e = -23;
+    }
+    // x = m 2^e, with sqrt(1/2) <= m < sqrt(2)
+    e += (int32_t)(v.u >> 23) - 126;
+    v.u = (v.u & 0x007fffff) | 0x3f000000;
+    mp_float_t m = v.f;
+    if(m < MICROPY_FLOAT_CONST(0.707106781186547524)) {
+        e--;
+        m = m + m - MICROPY_FLOAT_CONST(1.0);
+    } else {
+        m = m - MICROPY_FLOAT_CONST(1.0);
+    }
+    mp_float_t z = m * m;
+    mp_float_t p = MICROPY_FLOAT_CONST(7.0376836292e-2);
+    p = p * m - MICROPY_FLOAT_CONST(1.1514610310e-1);
+    p = p * m + MICROPY_FLOAT_CONST(1.1676998740e-1);
+    p = p * m - MICROPY_FLOAT_CONST(1.2420140846e-1);
+    p = p * m + MICROPY_FLOAT_CONST(1.4249322787e-1);
+    p = p * m - MICROPY_FLOAT_CONST(1.6668057665e-1);
+    p = p * m + MICROPY_FLOAT_CONST(2.0000714765e-1);
+    p = p * m - MICROPY_FLOAT_CONST(2.4999993993e-1);
+    p = p * m + MICROPY_FLOAT_CONST(3.3333331174e-1);
+    mp_float_t fe = (mp_float_t)e;
+    mp_float_t y = m * z * p - fe * MICROPY_FLOAT_CONST(2.12194440e-4) - MICROPY_FLOAT_CONST(0.5) * z;
+    return m + y + fe * MICROPY_FLOAT_CONST(0.693359375);
+}
+
+static mp_float_t vector_fast_sin_cos(mp_float_t x, bool cosine) {
+    mp_float_t a = MICROPY_FLOAT_C_FUN(fabs)(x);
+    if(!(a < MICROPY_FLOAT_CONST(8192.0))) {
+        // the reduction loses too many digits beyond this point
+        return cosine ? MICROPY_FLOAT_C_FUN(cos)(x) : MICROPY_FLOAT_C_FUN(sin)(x);
+    }
+    // a = j pi/4 + r, with an even j, and |r| <= pi/4
+    uint32_t j = (uint32_t)(a * MICROPY_FLOAT_CONST(1.27323954473516));
+    j += j & 1;
+    mp_float_t y = (mp_float_t)j;
+    mp_float_t r = ((a - y * MICROPY_FLOAT_CONST(0.78515625)) - y * MICROPY_FLOAT_CONST(2.4187564849853515625e-4))
+                    - y * MICROPY_FLOAT_CONST(3.77489497744594108e-8);
+    // the cosine is the sine shifted by two octants, and it is an even function
+    bool negative = !cosine && (x < MICROPY_FLOAT_CONST(0.0));
+    j = (j + (cosine ? 2 : 0)) & 7;
+    if(j > 3) {
+        negative = !negative;
+        j -= 4;
+    }
+    mp_float_t z = r * r;
+    if(j == 2) {
+        r = ((MICROPY_FLOAT_CONST(2.443315711809948e-5) * z - MICROPY_FLOAT_CONST(1.388731625493765e-3)) * z
+            + MICROPY_FLOAT_CONST(4.166664568298827e-2)) * z * z - MICROPY_FLOAT_CONST(0.5) * z + MICROPY_FLOAT_CONST(1.0);
+    } else {
+        r = ((MICROPY_FLOAT_CONST(-1.9515295891e-4) * z + MICROPY_FLOAT_CONST(8.3321608736e-3)) * z
+            - MICROPY_FLOAT_CONST(1.6666654611e-1)) * z * r + r;
+    }
+    return negative ? -r : r;
+}
+
+static mp_float_t vector_fast_sin(mp_float_t x) {
+    return vector_fast_sin_cos(x, false);
+}
+
+static mp_float_t vector_fast_cos(mp_float_t x) {
+    return vector_fast_sin_cos(x, true);
+}
+#endif /* ULAB_VECTOR_FAST_MATH */
+
+#if ULAB_SIMD_HAS_SQRT | ULAB_VECTOR_FAST_MATH
+// If f has a vectorised, or an inlined implementation, it is evaluated on a dense float
+// array in a flat loop without the indirect call, and the function returns true.
+static bool vector_dense_loop(mp_float_t (*f)(mp_float_t), mp_float_t *tarray, mp_float_t *sarray, size_t len) {
+    #if ULAB_SIMD_HAS_SQRT
+    if(f == MICROPY_FLOAT_C_FUN(sqrt)) {
+        ulab_simd_sqrt(tarray, sarray, len);
+        return true;
+    }
+    #endif
+    #if ULAB_VECTOR_FAST_MATH
+    if(f == vector_fast_exp) {
+        for(size_t i = 0; i < len; i++) {
+            tarray[i] = vector_fast_exp(sarray[i]);
+        }
+        return true;
+    } else if(f == vector_fast_log) {
+        for(size_t i = 0; i < len; i++) {
+            tarray[i] = vector_fast_log(sarray[i]);
+        }
+        return true;
+    } else if(f == vector_fast_sin) {
+        for(size_t i = 0; i < len; i++) {
+            tarray[i] = vector_fast_sin_cos(sarray[i], false);
+        }
+        return true;
+    } else if(f == vector_fast_cos) {
+        for(size_t i = 0; i < len; i++) {
+            tarray[i] = vector_fast_sin_cos(sarray[i], true);
+        }
+        return true;
+    }
+    #endif
+    return false;
+}
+#endif /* ULAB_SIMD_HAS_SQRT | ULAB_VECTOR_FAST_MATH */
+
+#if ULAB_HAS_PARALLEL
+// the state of a function that is evaluated on a dense float array, possibly on two cores
+typedef struct _vector_dense_t {
+    mp_float_t (*f)(mp_float_t);
+    mp_float_t *tarray;
+    mp_float_t *sarray;
+} vector_dense_t;
+
+static void vector_dense_kernel(void *context, size_t start, size_t end, uint8_t core) {
+    (void)core;
+    vector_dense_t *dense = (vector_dense_t *)context;
+    #if ULAB_SIMD_HAS_SQRT | ULAB_VECTOR_FAST_MATH
+    if(vector_dense_loop(dense->f, dense->tarray + start, dense->sarray + start, end - start)) {
+        return;
+    }
+    #endif
+    for(size_t i = start; i < end; i++) {
+        dense->tarray[i] = dense->f(dense->sarray[i]);
+    }
+}
+#endif /* ULAB_HAS_PARALLEL */
+
 //| """Element-by-element functions
 //|
 //| These functions can operate on numbers, 1-D iterables, and arrays of 1 to 4 dimensions by
@@ -60,27 +243,34 @@ static mp_obj_t vector_generic_vector(size_t n_args, const mp_obj_t *pos_args, m
     if(mp_obj_is_type(o_in, &ulab_ndarray_type)) {
         source = MP_OBJ_TO_PTR(o_in);
         COMPLEX_DTYPE_NOT_IMPLEMENTED(source->dtype)
+        #if ULAB_HAS_GENERIC_DTYPES
+        if(ULAB_DTYPE_IS_GENERIC(source->dtype)) {
+            // the 32-bit integers, and float16 are converted to float first
+            source = ndarray_copy_view_convert_type(source, NDARRAY_FLOAT);
+        }
+        #endif
         if(out == mp_const_none) {
             target = ndarray_new_dense_ndarray(source->ndim, source->shape, NDARRAY_FLOAT);
         } else {
-            if(!mp_obj_is_type(out, &ulab_ndarray_type)) {
-                mp_raise_ValueError(MP_ERROR_TEXT("out must be an ndarray"));
-            }
-            target = MP_OBJ_TO_PTR(out);
-            if(target->dtype != NDARRAY_FLOAT) {
-                mp_raise_ValueError(MP_ERROR_TEXT("out must be of float dtype"));
-            }
-            if(target->ndim != source->ndim) {
-                mp_raise_ValueError(MP_ERROR_TEXT("input and output dimensions differ"));
-            }
-            for(uint8_t d = 0; d < target->ndim; d++) {
-                if(target->shape[ULAB_MAX_DIMS - 1 - d] != source->shape[ULAB_MAX_DIMS - 1 - d]) {
-                    mp_raise_ValueError(MP_ERROR_TEXT("input and output shapes differ"));
-                }
-            }
+            target = tools_get_out_array(out, source->ndim, source->shape, NDARRAY_FLOAT);
         }
         mp_float_t *tarray = (mp_float_t *)target->array;
-        int32_t *tstrides = m_new(int32_t, ULAB_MAX_DIMS);
+
+        #if ULAB_HAS_PARALLEL
+        if((source->dtype == NDARRAY_FLOAT) && ndarray_is_contiguous(source) && ndarray_is_contiguous(target)) {
+            vector_dense_t dense = { .f = f, .tarray = tarray, .sarray = (mp_float_t *)source->array };
+            ulab_parallel_for(vector_dense_kernel, &dense, source->len, 1);
+            return MP_OBJ_FROM_PTR(target);
+        }
+        #elif ULAB_SIMD_HAS_SQRT | ULAB_VECTOR_FAST_MATH
+        if((source->dtype == NDARRAY_FLOAT) && ndarray_is_contiguous(source) && ndarray_is_contiguous(target)) {
+            if(vector_dense_loop(f, tarray, (mp_float_t *)source->array, source->len)) {
+                return MP_OBJ_FROM_PTR(target);
+            }
+        }
+        #endif
+
+        int32_t tstrides[ULAB_MAX_DIMS] = { 0 };
         for(uint8_t d = 0; d < target->ndim; d++) {
             tstrides[ULAB_MAX_DIMS - 1 - d] = target->strides[ULAB_MAX_DIMS - 1 - d] / target->itemsize;
         }
@@ -89,7 +279,7 @@ static mp_obj_t vector_generic_vector(size_t n_args, const mp_obj_t *pos_args, m
 
         #if ULAB_VECTORISE_USES_FUN_POINTER
 
-            mp_float_t (*func)(void *) = ndarray_get_float_function(source->dtype);
+            // each row is converted to float in a typed loop, and f is then applied in place
 
             #if ULAB_MAX_DIMS > 3
             size_t i = 0;
@@ -103,39 +293,45 @@ static mp_obj_t vector_generic_vector(size_t n_args, const mp_obj_t *pos_args, m
                     size_t k = 0;
                     do {
                     #endif
-                        size_t l = 0;
-                        do {
-                            mp_float_t value = func(sarray);
-                            *tarray++ = f(value);
-                            sarray += source->strides[ULAB_MAX_DIMS - 1];
-                            l++;
-                        } while(l < source->shape[ULAB_MAX_DIMS - 1]);
+                        tools_load_float(tarray, tstrides[ULAB_MAX_DIMS - 1], sarray, source->strides[ULAB_MAX_DIMS - 1],
+                                        source->dtype, source->shape[ULAB_MAX_DIMS - 1]);
+                        for(size_t l = 0; l < source->shape[ULAB_MAX_DIMS - 1]; l++) {
+                            *tarray = f(*tarray);
+                            tarray += tstrides[ULAB_MAX_DIMS - 1];
+                        }
+                        sarray += source->strides[ULAB_MAX_DIMS - 1] * source->shape[ULAB_MAX_DIMS - 1];
                     #if ULAB_MAX_DIMS > 1
                         sarray -= source->strides[ULAB_MAX_DIMS - 1] * source->shape[ULAB_MAX_DIMS-1];
                         sarray += source->strides[ULAB_MAX_DIMS - 2];
+                        tarray -= tstrides[ULAB_MAX_DIMS - 1] * source->shape[ULAB_MAX_DIMS-1];
+                        tarray += tstrides[ULAB_MAX_DIMS - 2];
                         k++;
                     } while(k < source->shape[ULAB_MAX_DIMS - 2]);
                     #endif /* ULAB_MAX_DIMS > 1 */
                 #if ULAB_MAX_DIMS > 2
                     sarray -= source->strides[ULAB_MAX_DIMS - 2] * source->shape[ULAB_MAX_DIMS-2];
                     sarray += source->strides[ULAB_MAX_DIMS - 3];
+                    tarray -= tstrides[ULAB_MAX_DIMS - 2] * source->shape[ULAB_MAX_DIMS-2];
+                    tarray += tstrides[ULAB_MAX_DIMS - 3];
                     j++;
                 } while(j < source->shape[ULAB_MAX_DIMS - 3]);
                 #endif /* ULAB_MAX_DIMS > 2 */
             #if ULAB_MAX_DIMS > 3
                 sarray -= source->strides[ULAB_MAX_DIMS - 3] * source->shape[ULAB_MAX_DIMS-3];
                 sarray += source->strides[ULAB_MAX_DIMS - 4];
+                tarray -= tstrides[ULAB_MAX_DIMS - 3] * source->shape[ULAB_MAX_DIMS-3];
+                tarray += tstrides[ULAB_MAX_DIMS - 4];
                 i++;
             } while(i < source->shape[ULAB_MAX_DIMS - 4]);
             #endif /* ULAB_MAX_DIMS > 3 */
         #else
         if(source->dtype == NDARRAY_UINT8) {
             ITERATE_VECTOR(uint8_t, target, tarray, tstrides, source, sarray);
-        } else if(source->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(source->dtype, INT8)) {
            ITERATE_VECTOR(int8_t, target, tarray, tstrides, source, sarray);
         } else if(source->dtype == NDARRAY_UINT16) {
             ITERATE_VECTOR(uint16_t, target, tarray, tstrides, source, sarray);
-        } else if(source->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(source->dtype, INT16)) {
             ITERATE_VECTOR(int16_t, target, tarray, tstrides, source, sarray);
         } else {
             ITERATE_VECTOR(mp_float_t, target, tarray, tstrides, source, sarray);
@@ -163,13 +359,33 @@ static mp_obj_t vector_generic_vector(mp_obj_t o_in, mp_float_t (*f)(mp_float_t)
     if(mp_obj_is_type(o_in, &ulab_ndarray_type)) {
         ndarray_obj_t *source = MP_OBJ_TO_PTR(o_in);
         COMPLEX_DTYPE_NOT_IMPLEMENTED(source->dtype)
+        #if ULAB_HAS_GENERIC_DTYPES
+        if(ULAB_DTYPE_IS_GENERIC(source->dtype)) {
+            // the 32-bit integers, and float16 are converted to float first
+            source = ndarray_copy_view_convert_type(source, NDARRAY_FLOAT);
+        }
+        #endif
         uint8_t *sarray = (uint8_t *)source->array;
         ndarray = ndarray_new_dense_ndarray(source->ndim, source->shape, NDARRAY_FLOAT);
         mp_float_t *array = (mp_float_t *)ndarray->array;
 
+        #if ULAB_HAS_PARALLEL
+        if((source->dtype == NDARRAY_FLOAT) && ndarray_is_contiguous(source)) {
+            vector_dense_t dense = { .f = f, .tarray = array, .sarray = (mp_float_t *)source->array };
+            ulab_parallel_for(vector_dense_kernel, &dense, source->len, 1);
+            return MP_OBJ_FROM_PTR(ndarray);
+        }
+        #elif ULAB_SIMD_HAS_SQRT | ULAB_VECTOR_FAST_MATH
+        if((source->dtype == NDARRAY_FLOAT) && ndarray_is_contiguous(source)) {
+            if(vector_dense_loop(f, array, (mp_float_t *)source->array, source->len)) {
+                return MP_OBJ_FROM_PTR(ndarray);
+            }
+        }
+        #endif
+
         #if ULAB_VECTORISE_USES_FUN_POINTER
 
-            mp_float_t (*func)(void *) = ndarray_get_float_function(source->dtype);
+            // each row is converted to float in a typed loop, and f is then applied in place
 
             #if ULAB_MAX_DIMS > 3
             size_t i = 0;
@@ -183,13 +399,12 @@ static mp_obj_t vector_generic_vector(mp_obj_t o_in, mp_float_t (*f)(mp_float_t)
                     size_t k = 0;
                     do {
                     #endif
-                        size_t l = 0;
-                        do {
-                            mp_float_t value = func(sarray);
-                            *array++ = f(value);
-                            sarray += source->strides[ULAB_MAX_DIMS - 1];
-                            l++;
-                        } while(l < source->shape[ULAB_MAX_DIMS - 1]);
+                        tools_load_float(array, 1, sarray, source->strides[ULAB_MAX_DIMS - 1], source->dtype, source->shape[ULAB_MAX_DIMS - 1]);
+                        for(size_t l = 0; l < source->shape[ULAB_MAX_DIMS - 1]; l++) {
+                            *array = f(*array);
+                            array++;
+                        }
+                        sarray += source->strides[ULAB_MAX_DIMS - 1] * source->shape[ULAB_MAX_DIMS - 1];
                     #if ULAB_MAX_DIMS > 1
                         sarray -= source->strides[ULAB_MAX_DIMS - 1] * source->shape[ULAB_MAX_DIMS-1];
                         sarray += source->strides[ULAB_MAX_DIMS - 2];
@@ -211,11 +426,11 @@ static mp_obj_t vector_generic_vector(mp_obj_t o_in, mp_float_t (*f)(mp_float_t)
         #else
         if(source->dtype == NDARRAY_UINT8) {
             ITERATE_VECTOR(uint8_t, array, source, sarray);
-        } else if(source->dtype == NDARRAY_INT8) {
+        } else if(ULAB_DTYPE_IS(source->dtype, INT8)) {
             ITERATE_VECTOR(int8_t, array, source, sarray);
         } else if(source->dtype == NDARRAY_UINT16) {
             ITERATE_VECTOR(uint16_t, array, source, sarray);
-        } else if(source->dtype == NDARRAY_INT16) {
+        } else if(ULAB_DTYPE_IS(source->dtype, INT16)) {
             ITERATE_VECTOR(int16_t, array, source, sarray);
         } else {
             ITERATE_VECTOR(mp_float_t, array, source, sarray);
@@ -315,15 +530,23 @@ mp_obj_t vector_around(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_arg
     mp_float_t mul = MICROPY_FLOAT_C_FUN(pow)(10.0, n);
     ndarray_obj_t *source = MP_OBJ_TO_PTR(args[0].u_obj);
     COMPLEX_DTYPE_NOT_IMPLEMENTED(source->dtype)
+    ndarray_obj_t *ndarray;
     #if ULAB_MATH_FUNCTIONS_OUT_KEYWORD
     mp_obj_t out = args[2].u_obj;
     if(out != mp_const_none) {
-        mp_raise_ValueError(MP_ERROR_TEXT("out keyword is not supported for function"));
+        ndarray = tools_get_out_array(out, source->ndim, source->shape, NDARRAY_FLOAT);
+    } else {
+        ndarray = ndarray_new_dense_ndarray(source->ndim, source->shape, NDARRAY_FLOAT);
     }
+    #else
+    ndarray = ndarray_new_dense_ndarray(source->ndim, source->shape, NDARRAY_FLOAT);
     #endif /* ULAB_MATH_FUNCTIONS_OUT_KEYWORD */
-    ndarray_obj_t *ndarray = ndarray_new_dense_ndarray(source->ndim, source->shape, NDARRAY_FLOAT);
     mp_float_t *narray = (mp_float_t *)ndarray->array;
     uint8_t *sarray = (uint8_t *)source->array;
+    int32_t nstrides[ULAB_MAX_DIMS] = { 0 };
+    for(uint8_t d = 0; d < ndarray->ndim; d++) {
+        nstrides[ULAB_MAX_DIMS - 1 - d] = ndarray->strides[ULAB_MAX_DIMS - 1 - d] / ndarray->itemsize;
+    }
 
     mp_float_t (*func)(void *) = ndarray_get_float_function(source->dtype);
 
@@ -342,25 +565,32 @@ mp_obj_t vector_around(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_arg
                 size_t l = 0;
                 do {
                     mp_float_t f = func(sarray);
-                    *narray++ = MICROPY_FLOAT_C_FUN(round)(f * mul) / mul;
+                    *narray = MICROPY_FLOAT_C_FUN(round)(f * mul) / mul;
                     sarray += source->strides[ULAB_MAX_DIMS - 1];
+                    narray += nstrides[ULAB_MAX_DIMS - 1];
                     l++;
                 } while(l < source->shape[ULAB_MAX_DIMS - 1]);
             #if ULAB_MAX_DIMS > 1
                 sarray -= source->strides[ULAB_MAX_DIMS - 1] * source->shape[ULAB_MAX_DIMS-1];
                 sarray += source->strides[ULAB_MAX_DIMS - 2];
+                narray -= nstrides[ULAB_MAX_DIMS - 1] * source->shape[ULAB_MAX_DIMS-1];
+                narray += nstrides[ULAB_MAX_DIMS - 2];
                 k++;
             } while(k < source->shape[ULAB_MAX_DIMS - 2]);
             #endif
         #if ULAB_MAX_DIMS > 2
             sarray -= source->strides[ULAB_MAX_DIMS - 2] * source->shape[ULAB_MAX_DIMS-2];
             sarray += source->strides[ULAB_MAX_DIMS - 3];
+            narray -= nstrides[ULAB_MAX_DIMS - 2] * source->shape[ULAB_MAX_DIMS-2];
+            narray += nstrides[ULAB_MAX_DIMS - 3];
             j++;
         } while(j < source->shape[ULAB_MAX_DIMS - 3]);
         #endif
     #if ULAB_MAX_DIMS > 3
         sarray -= source->strides[ULAB_MAX_DIMS - 3] * source->shape[ULAB_MAX_DIMS-3];
         sarray += source->strides[ULAB_MAX_DIMS - 4];
+        narray -= nstrides[ULAB_MAX_DIMS - 3] * source->shape[ULAB_MAX_DIMS-3];
+        narray += nstrides[ULAB_MAX_DIMS - 4];
         i++;
     } while(i < source->shape[ULAB_MAX_DIMS - 4]);
     #endif
@@ -407,7 +637,23 @@ MP_DEFINE_CONST_FUN_OBJ_1(vector_atanh_obj, vector_atanh);
 //|    ...
 //|
 
+#if ULAB_MATH_FUNCTIONS_OUT_KEYWORD
+mp_obj_t vector_arctan2(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_out, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t y = args[0].u_obj;
+    mp_obj_t x = args[1].u_obj;
+    mp_obj_t out = args[2].u_obj;
+#else
 mp_obj_t vector_arctan2(mp_obj_t y, mp_obj_t x) {
+#endif /* ULAB_MATH_FUNCTIONS_OUT_KEYWORD */
     if((mp_obj_is_float(y) || mp_obj_is_int(y)) &&
         (mp_obj_is_float(x) || mp_obj_is_int(x))) {
         mp_float_t _y = mp_obj_get_float(y);
@@ -422,21 +668,31 @@ mp_obj_t vector_arctan2(mp_obj_t y, mp_obj_t x) {
     COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray_y->dtype)
 
     uint8_t ndim = 0;
-    size_t *shape = m_new(size_t, ULAB_MAX_DIMS);
-    int32_t *xstrides = m_new(int32_t, ULAB_MAX_DIMS);
-    int32_t *ystrides = m_new(int32_t, ULAB_MAX_DIMS);
+    size_t shape[ULAB_MAX_DIMS] = { 0 };
+    int32_t xstrides[ULAB_MAX_DIMS] = { 0 };
+    int32_t ystrides[ULAB_MAX_DIMS] = { 0 };
     if(!ndarray_can_broadcast(ndarray_x, ndarray_y, &ndim, shape, xstrides, ystrides)) {
         mp_raise_ValueError(MP_ERROR_TEXT("operands could not be broadcast together"));
-        m_del(size_t, shape, ULAB_MAX_DIMS);
-        m_del(int32_t, xstrides, ULAB_MAX_DIMS);
-        m_del(int32_t, ystrides, ULAB_MAX_DIMS);
     }
 
     uint8_t *xarray = (uint8_t *)ndarray_x->array;
     uint8_t *yarray = (uint8_t *)ndarray_y->array;
 
-    ndarray_obj_t *results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
+    ndarray_obj_t *results;
+    #if ULAB_MATH_FUNCTIONS_OUT_KEYWORD
+    if(out != mp_const_none) {
+        results = tools_get_out_array(out, ndim, shape, NDARRAY_FLOAT);
+    } else {
+        results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
+    }
+    #else
+    results = ndarray_new_dense_ndarray(ndim, shape, NDARRAY_FLOAT);
+    #endif /* ULAB_MATH_FUNCTIONS_OUT_KEYWORD */
     mp_float_t *rarray = (mp_float_t *)results->array;
+    int32_t rstrides[ULAB_MAX_DIMS] = { 0 };
+    for(uint8_t d = 0; d < results->ndim; d++) {
+        rstrides[ULAB_MAX_DIMS - 1 - d] = results->strides[ULAB_MAX_DIMS - 1 - d] / results->itemsize;
+    }
 
     mp_float_t (*funcx)(void *) = ndarray_get_float_function(ndarray_x->dtype);
     mp_float_t (*funcy)(void *) = ndarray_get_float_function(ndarray_y->dtype);
@@ -457,7 +713,8 @@ mp_obj_t vector_arctan2(mp_obj_t y, mp_obj_t x) {
                 do {
                     mp_float_t _x = funcx(xarray);
                     mp_float_t _y = funcy(yarray);
-                    *rarray++ = MICROPY_FLOAT_C_FUN(atan2)(_y, _x);
+                    *rarray = MICROPY_FLOAT_C_FUN(atan2)(_y, _x);
+                    rarray += rstrides[ULAB_MAX_DIMS - 1];
                     xarray += xstrides[ULAB_MAX_DIMS - 1];
                     yarray += ystrides[ULAB_MAX_DIMS - 1];
                     l++;
@@ -467,6 +724,8 @@ mp_obj_t vector_arctan2(mp_obj_t y, mp_obj_t x) {
                 xarray += xstrides[ULAB_MAX_DIMS - 2];
                 yarray -= ystrides[ULAB_MAX_DIMS - 1] * results->shape[ULAB_MAX_DIMS-1];
                 yarray += ystrides[ULAB_MAX_DIMS - 2];
+                rarray -= rstrides[ULAB_MAX_DIMS - 1] * results->shape[ULAB_MAX_DIMS-1];
+                rarray += rstrides[ULAB_MAX_DIMS - 2];
                 k++;
             } while(k < results->shape[ULAB_MAX_DIMS - 2]);
             #endif
@@ -475,6 +734,8 @@ mp_obj_t vector_arctan2(mp_obj_t y, mp_obj_t x) {
             xarray += xstrides[ULAB_MAX_DIMS - 3];
             yarray -= ystrides[ULAB_MAX_DIMS - 2] * results->shape[ULAB_MAX_DIMS-2];
             yarray += ystrides[ULAB_MAX_DIMS - 3];
+            rarray -= rstrides[ULAB_MAX_DIMS - 2] * results->shape[ULAB_MAX_DIMS-2];
+            rarray += rstrides[ULAB_MAX_DIMS - 3];
             j++;
         } while(j < results->shape[ULAB_MAX_DIMS - 3]);
         #endif
@@ -483,6 +744,8 @@ mp_obj_t vector_arctan2(mp_obj_t y, mp_obj_t x) {
         xarray += xstrides[ULAB_MAX_DIMS - 4];
         yarray -= ystrides[ULAB_MAX_DIMS - 3] * results->shape[ULAB_MAX_DIMS-3];
         yarray += ystrides[ULAB_MAX_DIMS - 4];
+        rarray -= rstrides[ULAB_MAX_DIMS - 3] * results->shape[ULAB_MAX_DIMS-3];
+        rarray += rstrides[ULAB_MAX_DIMS - 4];
         i++;
     } while(i < results->shape[ULAB_MAX_DIMS - 4]);
     #endif
@@ -490,7 +753,11 @@ mp_obj_t vector_arctan2(mp_obj_t y, mp_obj_t x) {
     return MP_OBJ_FROM_PTR(results);
 }
 
+#if ULAB_MATH_FUNCTIONS_OUT_KEYWORD
+MP_DEFINE_CONST_FUN_OBJ_KW(vector_arctan2_obj, 2, vector_arctan2);
+#else
 MP_DEFINE_CONST_FUN_OBJ_2(vector_arctan2_obj, vector_arctan2);
+#endif /* ULAB_MATH_FUNCTIONS_OUT_KEYWORD */
 #endif /* ULAB_VECTORISE_HAS_ARCTAN2 */
 
 #if ULAB_NUMPY_HAS_CEIL
@@ -513,7 +780,11 @@ MP_DEFINE_CONST_FUN_OBJ_1(vector_ceil_obj, vector_ceil);
 //|    ...
 //|
 
+#if ULAB_VECTOR_FAST_MATH
+MATH_FUN_1_FAST(cos);
+#else
 MATH_FUN_1(cos, cos);
+#endif
 #if ULAB_MATH_FUNCTIONS_OUT_KEYWORD
 MP_DEFINE_CONST_FUN_OBJ_KW(vector_cos_obj, 1, vector_cos);
 #else
@@ -671,10 +942,15 @@ static mp_obj_t vector_exp(mp_obj_t o_in) {
         }
     }
     #endif /* ULAB_SUPPORTS_COMPLEX */
+    #if ULAB_VECTOR_FAST_MATH
+    mp_float_t (*func)(mp_float_t) = vector_fast_exp;
+    #else
+    mp_float_t (*func)(mp_float_t) = MICROPY_FLOAT_C_FUN(exp);
+    #endif
     #if ULAB_MATH_FUNCTIONS_OUT_KEYWORD
-    return vector_generic_vector(n_args, pos_args, kw_args, MICROPY_FLOAT_C_FUN(exp));   
+    return vector_generic_vector(n_args, pos_args, kw_args, func);
     #else
-    return vector_generic_vector(o_in, MICROPY_FLOAT_C_FUN(exp));
+    return vector_generic_vector(o_in, func);
     #endif /* ULAB_MATH_FUNCTIONS_OUT_KEYWORD */
 }
 
@@ -747,7 +1023,11 @@ MP_DEFINE_CONST_FUN_OBJ_1(vector_lgamma_obj, vector_lgamma);
 //|    ...
 //|
 
+#if ULAB_VECTOR_FAST_MATH
+MATH_FUN_1_FAST(log);
+#else
 MATH_FUN_1(log, log);
+#endif
 #if ULAB_MATH_FUNCTIONS_OUT_KEYWORD
 MP_DEFINE_CONST_FUN_OBJ_KW(vector_log_obj, 1, vector_log);
 #else
@@ -812,7 +1092,11 @@ MP_DEFINE_CONST_FUN_OBJ_1(vector_radians_obj, vector_radians);
 //|    ...
 //|
 
+#if ULAB_VECTOR_FAST_MATH
+MATH_FUN_1_FAST(sin);
+#else
 MATH_FUN_1(sin, sin);
+#endif
 #if ULAB_MATH_FUNCTIONS_OUT_KEYWORD
 MP_DEFINE_CONST_FUN_OBJ_KW(vector_sin_obj, 1, vector_sin);
 #else
@@ -1053,12 +1337,104 @@ MP_DEFINE_CONST_FUN_OBJ_1(vector_tanh_obj, vector_tanh);
 #endif /* ULAB_NUMPY_HAS_TANH */
 
 #if ULAB_NUMPY_HAS_VECTORIZE
+static void vector_vectorized_store_row(uint8_t otypes, uint8_t *rarray, mp_obj_t value, size_t n) {
+    // copies the n values returned by the wrapped function into rarray
+    if(mp_obj_is_type(value, &ulab_ndarray_type)) {
+        ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(value);
+        if((ndarray->ndim != 1) || (ndarray->len != n)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("function must return an array of the length of its argument"));
+        }
+        COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+        uint8_t *array = (uint8_t *)ndarray->array;
+        int32_t stride = ndarray->strides[ULAB_MAX_DIMS - 1];
+        if(otypes == NDARRAY_FLOAT) {
+            tools_load_float((mp_float_t *)rarray, 1, array, stride, ndarray->dtype, n);
+        } else {
+            uint8_t itemsize = ulab_binary_get_size(otypes);
+            for(size_t i = 0; i < n; i++) {
+                ndarray_set_value(otypes, rarray, 0, ndarray_get_value(ndarray->dtype, array, 0));
+                rarray += itemsize;
+                array += stride;
+            }
+        }
+    } else {
+        if((size_t)mp_obj_get_int(mp_obj_len(value)) != n) {
+            mp_raise_ValueError(MP_ERROR_TEXT("function must return an array of the length of its argument"));
+        }
+        mp_obj_iter_buf_t iter_buf;
+        mp_obj_t item, iterable = mp_getiter(value, &iter_buf);
+        size_t i = 0;
+        while((item = mp_iternext(iterable)) != MP_OBJ_STOP_ITERATION) {
+            ndarray_set_value(otypes, rarray, i++, item);
+        }
+    }
+}
+
+static mp_obj_t vector_vectorized_rows(vectorized_function_obj_t *self, ndarray_obj_t *source) {
+    // the wrapped function is called once per row (the last axis) with a dense copy of the row,
+    // which it may overwrite, and return None, instead of allocating a new array
+    size_t n = source->shape[ULAB_MAX_DIMS - 1];
+    size_t rows = source->len / MAX(1, n);
+    ndarray_obj_t *results;
+    if(self->signature == VECTORIZE_ROW_TO_ROW) {
+        results = ndarray_new_dense_ndarray(source->ndim, source->shape, self->otypes);
+    } else {
+        if(source->ndim == 1) {
+            results = ndarray_new_linear_array(1, self->otypes);
+        } else {
+            size_t *shape = m_new0(size_t, ULAB_MAX_DIMS);
+            for(uint8_t i = ULAB_MAX_DIMS - 1; i > ULAB_MAX_DIMS - source->ndim; i--) {
+                shape[i] = source->shape[i - 1];
+            }
+            results = ndarray_new_dense_ndarray(source->ndim - 1, shape, self->otypes);
+            m_del(size_t, shape, ULAB_MAX_DIMS);
+        }
+    }
+    ndarray_obj_t *row = ndarray_new_linear_array(n, source->dtype);
+    uint8_t *rarray = (uint8_t *)results->array;
+    mp_obj_t arg = MP_OBJ_FROM_PTR(row);
+
+    for(size_t r = 0; r < rows; r++) {
+        #if ULAB_MAX_DIMS > 1
+        uint8_t *sarray = tools_stack_pointer(source, 1, r);
+        #else
+        uint8_t *sarray = (uint8_t *)source->array;
+        #endif
+        uint8_t *array = (uint8_t *)row->array;
+        if(source->strides[ULAB_MAX_DIMS - 1] == (int32_t)source->itemsize) {
+            memcpy(array, sarray, n * source->itemsize);
+        } else {
+            for(size_t i = 0; i < n; i++) {
+                memcpy(array, sarray, source->itemsize);
+                array += source->itemsize;
+                sarray += source->strides[ULAB_MAX_DIMS - 1];
+            }
+        }
+        mp_obj_t value = MP_OBJ_TYPE_GET_SLOT(self->type, call)(self->fun, 1, 0, &arg);
+        if(self->signature == VECTORIZE_ROW_TO_SCALAR) {
+            ndarray_set_value(self->otypes, results->array, r, value);
+        } else {
+            vector_vectorized_store_row(self->otypes, rarray, value == mp_const_none ? arg : value, n);
+            rarray += n * results->itemsize;
+        }
+    }
+    if((self->signature == VECTORIZE_ROW_TO_SCALAR) && (source->ndim == 1)) {
+        return ndarray_get_value(self->otypes, results->array, 0);
+    }
+    return MP_OBJ_FROM_PTR(results);
+}
+
 static mp_obj_t vector_vectorized_function_call(mp_obj_t self_in, size_t n_args, size_t n_kw, const mp_obj_t *args) {
     (void) n_args;
     (void) n_kw;
     vectorized_function_obj_t *self = MP_OBJ_TO_PTR(self_in);
     mp_obj_t avalue[1];
     mp_obj_t fvalue;
+    if(self->signature != VECTORIZE_ELEMENTWISE) {
+        ndarray_obj_t *source = ndarray_from_mp_obj(args[0], 0);
+        COMPLEX_DTYPE_NOT_IMPLEMENTED(source->dtype)
+        return vector_vectorized_rows(self, source);
+    }
     if(mp_obj_is_type(args[0], &ulab_ndarray_type)) {
         ndarray_obj_t *source = MP_OBJ_TO_PTR(args[0]);
         COMPLEX_DTYPE_NOT_IMPLEMENTED(source->dtype)
@@ -1081,7 +1457,7 @@ static mp_obj_t vector_vectorized_function_call(mp_obj_t self_in, size_t n_args,
                 #endif
                     size_t l = 0;
                     do {
-                        avalue[0] = mp_binary_get_val_array(source->dtype, sarray, 0);
+                        avalue[0] = ndarray_get_value(source->dtype, sarray, 0);
                         fvalue = MP_OBJ_TYPE_GET_SLOT(self->type, call)(self->fun, 1, 0, avalue);
                         ndarray_set_value(self->otypes, narray, 0, fvalue);
                         sarray += source->strides[ULAB_MAX_DIMS - 1];
@@ -1153,21 +1529,60 @@ const mp_obj_type_t vector_function_type = {
 //| def vectorize(
 //|     f: Union[Callable[[int], _float], Callable[[_float], _float]],
 //|     *,
-//|     otypes: Optional[_DType] = None
+//|     otypes: Optional[_DType] = None,
+//|     signature: Optional[str] = None
 //| ) -> Callable[[_ArrayLike], ulab.numpy.ndarray]:
 //|    """
 //|    :param callable f: The function to wrap
 //|    :param otypes: List of array types that may be returned by the function.  None is interpreted to mean the return value is float.
+//|    :param signature: ``'(n)->(n)'``, or ``'(n)->()'``, if ``f`` is to be called once per row with a one-dimensional array
 //|
 //|    Wrap a Python function ``f`` so that it can be applied to arrays.
-//|    The callable must return only values of the types specified by ``otypes``, or the result is undefined."""
+//|    The callable must return only values of the types specified by ``otypes``, or the result is undefined.
+//|    With ``signature='(n)->(n)'``, ``f`` receives a copy of each row, and either returns an iterable of the
+//|    same length, or overwrites its argument, and returns None."""
 //|    ...
 //|
 
+static uint8_t vector_vectorize_signature(mp_obj_t signature) {
+    // the core dimensions of the input, and the output of the signature
+    // must be identical, e.g., '(n)->(n)', or the output must be '()'
+    if(signature == mp_const_none) {
+        return VECTORIZE_ELEMENTWISE;
+    }
+    size_t len;
+    const char *string = mp_obj_str_get_data(signature, &len);
+    char *buffer = m_new(char, len + 1);
+    size_t length = 0;
+    for(size_t i = 0; i < len; i++) {
+        if(string[i] != ' ') {
+            buffer[length++] = string[i];
+        }
+    }
+    buffer[length] = '\0';
+    uint8_t result = VECTORIZE_ELEMENTWISE;
+    char *close = strchr(buffer, ')');
+    if((buffer[0] == '(') && (close != NULL) && (close > buffer + 1) && (strncmp(close, ")->(", 4) == 0)) {
+        size_t nlen = close - buffer - 1;
+        char *output = close + 4;
+        if(strcmp(output, ")") == 0) {
+            result = VECTORIZE_ROW_TO_SCALAR;
+        } else if((strlen(output) == nlen + 1) && (strncmp(output, buffer + 1, nlen) == 0) && (output[nlen] == ')')) {
+            result = VECTORIZE_ROW_TO_ROW;
+        }
+    }
+    m_del(char, buffer, len + 1);
+    if(result == VECTORIZE_ELEMENTWISE) {
+        mp_raise_ValueError(MP_ERROR_TEXT("signature must be of the form '(n)->(n)', or '(n)->()'"));
+    }
+    return result;
+}
+
 static mp_obj_t vector_vectorize(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
-        { MP_QSTR_otypes, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} }
+        { MP_QSTR_otypes, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_signature, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -1193,6 +1608,7 @@ static mp_obj_t vector_vectorize(size_t n_args, const mp_obj_t *pos_args, mp_map
     vectorized_function_obj_t *function = m_new_obj(vectorized_function_obj_t);
     function->base.type = &vector_function_type;
     function->otypes = otypes;
+    function->signature = vector_vectorize_signature(args[2].u_obj);
     function->fun = args[0].u_obj;
     function->type = type;
     return MP_OBJ_FROM_PTR(function);
@@ -72,7 +72,11 @@ MP_DECLARE_CONST_FUN_OBJ_1(vector_tan_obj);
 MP_DECLARE_CONST_FUN_OBJ_1(vector_tanh_obj);
 #endif
 
+#if ULAB_MATH_FUNCTIONS_OUT_KEYWORD
+MP_DECLARE_CONST_FUN_OBJ_KW(vector_arctan2_obj);
+#else
 MP_DECLARE_CONST_FUN_OBJ_2(vector_arctan2_obj);
+#endif
 MP_DECLARE_CONST_FUN_OBJ_KW(vector_around_obj);
 
 #if ULAB_SUPPORTS_COMPLEX | ULAB_MATH_FUNCTIONS_OUT_KEYWORD
@@ -83,9 +87,16 @@ MP_DECLARE_CONST_FUN_OBJ_1(vector_sqrt_obj);
 
 MP_DECLARE_CONST_FUN_OBJ_KW(vector_vectorize_obj);
 
+enum VECTORIZE_SIGNATURE {
+    VECTORIZE_ELEMENTWISE,
+    VECTORIZE_ROW_TO_ROW,
+    VECTORIZE_ROW_TO_SCALAR,
+};
+
 typedef struct _vectorized_function_obj_t {
     mp_obj_base_t base;
     uint8_t otypes;
+    uint8_t signature;
     mp_obj_t fun;
     const mp_obj_type_t *type;
 } vectorized_function_obj_t;
@@ -211,6 +222,11 @@ typedef struct _vectorized_function_obj_t {
         return vector_generic_vector(n_args, pos_args, kw_args, MICROPY_FLOAT_C_FUN(c_name)); \
 }
 
+#define MATH_FUN_1_FAST(py_name) \
+    static mp_obj_t vector_ ## py_name(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) { \
+        return vector_generic_vector(n_args, pos_args, kw_args, vector_fast_ ## py_name); \
+}
+
 #else /* ULAB_MATH_FUNCTIONS_OUT_KEYWORD */
 
 #if ULAB_HAS_FUNCTION_ITERATOR
@@ -315,5 +331,10 @@ typedef struct _vectorized_function_obj_t {
     static mp_obj_t vector_ ## py_name(mp_obj_t x_obj) { \
         return vector_generic_vector(x_obj, MICROPY_FLOAT_C_FUN(c_name)); \
 }
+
+#define MATH_FUN_1_FAST(py_name) \
+    static mp_obj_t vector_ ## py_name(mp_obj_t x_obj) { \
+        return vector_generic_vector(x_obj, vector_fast_ ## py_name); \
+}
 #endif /* ULAB_MATH_FUNCTIONS_OUT_KEYWORD */
 #endif /* _VECTOR_ */
@@ -19,7 +19,9 @@
 
 #include "../../ulab.h"
 #include "../../ulab_tools.h"
+#include "../../numpy/carray/carray_tools.h"
 #include "../../numpy/linalg/linalg_tools.h"
+#include "../../ulab_profile.h"
 #include "linalg.h"
 
 #if ULAB_SCIPY_HAS_LINALG_MODULE
@@ -255,16 +257,133 @@ static mp_obj_t cho_solve(mp_obj_t _L, mp_obj_t _b) {
 
 MP_DEFINE_CONST_FUN_OBJ_2(linalg_cho_solve_obj, cho_solve);
 
+//| def lu_factor(A: ulab.numpy.ndarray) -> Tuple[ulab.numpy.ndarray, ulab.numpy.ndarray]:
+//|    """
+//|    :param ~ulab.numpy.ndarray A: a square matrix
+//|    :return tuple (lu, piv): the LU factors in a single matrix, and the pivot indices
+//|    :raises ValueError: if A is a singular matrix
+//|
+//|    Computes the LU decomposition of A with partial pivoting. The strictly lower triangle
+//|    of lu holds L, whose unit diagonal is not stored, and the upper triangle holds U.
+//|    Row i of the matrix was interchanged with row piv[i]. The output can be passed to lu_solve."""
+//|    ...
+//|
+
+static mp_obj_t lu_factor(mp_obj_t _A) {
+    ndarray_obj_t *A = tools_object_is_square(_A);
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(A->dtype)
+    size_t N = A->shape[ULAB_MAX_DIMS - 1];
+
+    ndarray_obj_t *lu = ndarray_new_dense_ndarray(2, A->shape, NDARRAY_FLOAT);
+    mp_float_t *luarray = (mp_float_t *)lu->array;
+    ndarray_obj_t *piv = ndarray_new_linear_array(N, NDARRAY_UINT16);
+
+    uint8_t *array = (uint8_t *)A->array;
+    mp_float_t (*func)(void *) = ndarray_get_float_function(A->dtype);
+    for(size_t i=0; i < N; i++) { // rows
+        for(size_t j=0; j < N; j++) { // columns
+            *luarray++ = func(array);
+            array += A->strides[ULAB_MAX_DIMS - 1];
+        }
+        array -= A->strides[ULAB_MAX_DIMS - 1] * N;
+        array += A->strides[ULAB_MAX_DIMS - 2];
+    }
+    // re-wind the pointer
+    luarray -= N*N;
+
+    if(!linalg_lu_decompose(luarray, (uint16_t *)piv->array, N)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("input matrix is singular"));
+    }
+
+    mp_obj_t tuple[2] = { MP_OBJ_FROM_PTR(lu), MP_OBJ_FROM_PTR(piv) };
+    return mp_obj_new_tuple(2, tuple);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(linalg_lu_factor_obj, lu_factor);
+
+//| def lu_solve(lu_and_piv: Tuple[ulab.numpy.ndarray, ulab.numpy.ndarray], b: ulab.numpy.ndarray) -> ulab.numpy.ndarray:
+//|    """
+//|    :param tuple lu_and_piv: the output of lu_factor
+//|    :param ~ulab.numpy.ndarray b: right-hand-side vector, or matrix, whose columns are the right hand sides
+//|    :return: solution to the system A x = b. Shape of return matches b
+//|
+//|    Solve the linear equations A x = b, given the LU factorization of A. The factorization
+//|    can be re-used for any number of right hand sides."""
+//|    ...
+//|
+
+static mp_obj_t lu_solve(mp_obj_t _lu_and_piv, mp_obj_t _b) {
+    if(!mp_obj_is_type(_lu_and_piv, &mp_type_tuple)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("first argument must be a tuple of (lu, piv)"));
+    }
+    mp_obj_tuple_t *lu_and_piv = MP_OBJ_TO_PTR(_lu_and_piv);
+    if(lu_and_piv->len != 2) {
+        mp_raise_TypeError(MP_ERROR_TEXT("first argument must be a tuple of (lu, piv)"));
+    }
+    ndarray_obj_t *lu = tools_object_is_square(lu_and_piv->items[0]);
+    if(!mp_obj_is_type(lu_and_piv->items[1], &ulab_ndarray_type) || !mp_obj_is_type(_b, &ulab_ndarray_type)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("input must be an ndarray"));
+    }
+    ndarray_obj_t *piv = MP_OBJ_TO_PTR(lu_and_piv->items[1]);
+    ndarray_obj_t *b = MP_OBJ_TO_PTR(_b);
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(lu->dtype)
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(b->dtype)
+
+    size_t N = lu->shape[ULAB_MAX_DIMS - 1];
+    if(piv->len != N) {
+        mp_raise_ValueError(MP_ERROR_TEXT("dimensions do not match"));
+    }
+
+    // the factors are copied, because they needn't be a dense float array
+    mp_float_t *data = m_new(mp_float_t, N * N);
+    uint16_t *pivots = m_new(uint16_t, N);
+
+    uint8_t *array = (uint8_t *)lu->array;
+    mp_float_t (*func)(void *) = ndarray_get_float_function(lu->dtype);
+    for(size_t i=0; i < N; i++) { // rows
+        for(size_t j=0; j < N; j++) { // columns
+            data[i * N + j] = func(array);
+            array += lu->strides[ULAB_MAX_DIMS - 1];
+        }
+        array -= lu->strides[ULAB_MAX_DIMS - 1] * N;
+        array += lu->strides[ULAB_MAX_DIMS - 2];
+    }
+
+    array = (uint8_t *)piv->array;
+    func = ndarray_get_float_function(piv->dtype);
+    for(size_t i=0; i < N; i++) {
+        mp_float_t p = func(array);
+        if((p < MICROPY_FLOAT_CONST(0.0)) || (p >= (mp_float_t)N)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("pivot index is out of range"));
+        }
+        pivots[i] = (uint16_t)p;
+        array += piv->strides[ULAB_MAX_DIMS - 1];
+    }
+
+    ndarray_obj_t *x = linalg_lu_solve_ndarray(data, pivots, N, b);
+    m_del(uint16_t, pivots, N);
+    m_del(mp_float_t, data, N * N);
+    return MP_OBJ_FROM_PTR(x);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_2(linalg_lu_solve_obj, lu_solve);
+
 #endif
 
 static const mp_rom_map_elem_t ulab_scipy_linalg_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_linalg) },
     #if ULAB_MAX_DIMS > 1
         #if ULAB_SCIPY_LINALG_HAS_SOLVE_TRIANGULAR
-        { MP_ROM_QSTR(MP_QSTR_solve_triangular), MP_ROM_PTR(&linalg_solve_triangular_obj) },
+        { MP_ROM_QSTR(MP_QSTR_solve_triangular), ULAB_PROFILE_PTR(MP_QSTR_linalg, MP_QSTR_solve_triangular, linalg_solve_triangular_obj) },
         #endif
         #if ULAB_SCIPY_LINALG_HAS_CHO_SOLVE
-        { MP_ROM_QSTR(MP_QSTR_cho_solve), MP_ROM_PTR(&linalg_cho_solve_obj) },
+        { MP_ROM_QSTR(MP_QSTR_cho_solve), ULAB_PROFILE_PTR(MP_QSTR_linalg, MP_QSTR_cho_solve, linalg_cho_solve_obj) },
+        #endif
+        #if ULAB_SCIPY_LINALG_HAS_LU_FACTOR
+        { MP_ROM_QSTR(MP_QSTR_lu_factor), ULAB_PROFILE_PTR(MP_QSTR_linalg, MP_QSTR_lu_factor, linalg_lu_factor_obj) },
+        #endif
+        #if ULAB_SCIPY_LINALG_HAS_LU_SOLVE
+        { MP_ROM_QSTR(MP_QSTR_lu_solve), ULAB_PROFILE_PTR(MP_QSTR_linalg, MP_QSTR_lu_solve, linalg_lu_solve_obj) },
         #endif
     #endif
 };
@@ -17,5 +17,7 @@ extern const mp_obj_module_t ulab_scipy_linalg_module;
 
 MP_DECLARE_CONST_FUN_OBJ_KW(linalg_solve_triangular_obj);
 MP_DECLARE_CONST_FUN_OBJ_2(linalg_cho_solve_obj);
+MP_DECLARE_CONST_FUN_OBJ_1(linalg_lu_factor_obj);
+MP_DECLARE_CONST_FUN_OBJ_2(linalg_lu_solve_obj);
 
 #endif /* _SCIPY_LINALG_ */
@@ -13,6 +13,7 @@
 */
 
 #include <math.h>
+#include <string.h>
 #include "py/obj.h"
 #include "py/runtime.h"
 #include "py/misc.h"
@@ -20,6 +21,8 @@
 #include "../../ndarray.h"
 #include "../../ulab.h"
 #include "../../ulab_tools.h"
+#include "../../numpy/carray/carray_tools.h"
+#include "../../ulab_profile.h"
 #include "optimize.h"
 
 ULAB_DEFINE_FLOAT_CONST(xtolerance, MICROPY_FLOAT_CONST(2.4e-7), 0x3480d959UL, 0x3e901b2b29a4692bULL);
@@ -33,6 +36,42 @@ static mp_float_t optimize_python_call(const mp_obj_type_t *type, mp_obj_t fun,
     return mp_obj_get_float(MP_OBJ_TYPE_GET_SLOT(type, call)(fun, nparams+1, 0, fargs));
 }
 
+#if ULAB_SCIPY_OPTIMIZE_HAS_BISECT || ULAB_SCIPY_OPTIMIZE_HAS_CURVE_FIT || ULAB_SCIPY_OPTIMIZE_HAS_NEWTON
+static void optimize_load_vector(mp_float_t *dest, mp_obj_t obj, size_t len) {
+    // copies the values of a one-dimensional, or contiguous array, or an iterable of length len into dest
+    if(mp_obj_is_type(obj, &ulab_ndarray_type)) {
+        ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(obj);
+        COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+        if((ndarray->len == len) && ((ndarray->ndim == 1) || ndarray_is_contiguous(ndarray))) {
+            tools_load_float(dest, 1, (uint8_t *)ndarray->array, ndarray->strides[ULAB_MAX_DIMS - 1], ndarray->dtype, len);
+            return;
+        }
+    } else if(ndarray_object_is_array_like(obj) && ((size_t)mp_obj_get_int(mp_obj_len_maybe(obj)) == len)) {
+        fill_array_iterable(dest, obj);
+        return;
+    }
+    mp_raise_ValueError(MP_ERROR_TEXT("function returned an array of wrong shape"));
+}
+#endif
+
+#if ULAB_SCIPY_OPTIMIZE_HAS_BISECT || ULAB_SCIPY_OPTIMIZE_HAS_NEWTON
+static ndarray_obj_t *optimize_float_array(mp_obj_t obj) {
+    // returns a dense float copy of an ndarray, or iterable, which the solvers can overwrite
+    if(mp_obj_is_type(obj, &ulab_ndarray_type)) {
+        ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(obj);
+        COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+        return ndarray_copy_view_convert_type(ndarray, NDARRAY_FLOAT);
+    }
+    return ndarray_from_iterable(obj, NDARRAY_FLOAT);
+}
+
+static void optimize_python_call_array(const mp_obj_type_t *type, mp_obj_t fun, ndarray_obj_t *x, mp_float_t *result) {
+    // evaluates f at all elements of x with a single call of the python function
+    mp_obj_t fargs[1] = { MP_OBJ_FROM_PTR(x) };
+    optimize_load_vector(result, MP_OBJ_TYPE_GET_SLOT(type, call)(fun, 1, 0, fargs), x->len);
+}
+#endif
+
 #if ULAB_SCIPY_OPTIMIZE_HAS_BISECT
 //| def bisect(
 //|     fun: Callable[[float], float],
@@ -55,6 +94,92 @@ static mp_float_t optimize_python_call(const mp_obj_type_t *type, mp_obj_t fun,
 //|     ...
 //|
 
+static mp_obj_t optimize_bisect_array(const mp_obj_type_t *type, mp_obj_t fun, mp_obj_t a_obj, mp_obj_t b_obj, mp_float_t xtol, mp_int_t maxiter) {
+    // Solves independent problems in lockstep: the function is called once per iteration
+    // with the array of all midpoints, and the problems that have converged are masked out.
+    // Either end of the interval can be a scalar, which is then shared by all problems.
+    bool a_is_array = ndarray_object_is_array_like(a_obj);
+    bool b_is_array = ndarray_object_is_array_like(b_obj);
+    ndarray_obj_t *x = optimize_float_array(a_is_array ? a_obj : b_obj);
+    mp_float_t *xarray = (mp_float_t *)x->array;
+    size_t len = x->len;
+    ndarray_obj_t *barray = b_is_array ? (a_is_array ? optimize_float_array(b_obj) : x) : NULL;
+    if((barray != NULL) && (barray->len != len)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("the ends of the intervals must be of equal length"));
+    }
+    if(maxiter < 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("maxiter should be > 0"));
+    }
+    mp_float_t a_value = a_is_array ? MICROPY_FLOAT_CONST(0.0) : mp_obj_get_float(a_obj);
+    mp_float_t b_value = b_is_array ? MICROPY_FLOAT_CONST(0.0) : mp_obj_get_float(b_obj);
+
+    // a, and b are kept in rtb, and dx, until the initial brackets are known
+    mp_float_t *rtb = m_new(mp_float_t, 3 * len);
+    mp_float_t *dx = rtb + len;
+    mp_float_t *fval = dx + len;
+    uint8_t *active = m_new(uint8_t, len);
+    for(size_t i = 0; i < len; i++) {
+        rtb[i] = a_is_array ? xarray[i] : a_value;
+        dx[i] = b_is_array ? ((mp_float_t *)barray->array)[i] : b_value;
+    }
+    memcpy(xarray, rtb, len * sizeof(mp_float_t));
+    optimize_python_call_array(type, fun, x, fval);
+    for(size_t i = 0; i < len; i++) {
+        // the sign of f(a) is kept in active, until f(b) is known
+        active[i] = fval[i] < MICROPY_FLOAT_CONST(0.0) ? 1 : (fval[i] > MICROPY_FLOAT_CONST(0.0) ? 2 : 0);
+        xarray[i] = dx[i];
+    }
+    optimize_python_call_array(type, fun, x, fval);
+    size_t nactive = len;
+    for(size_t i = 0; i < len; i++) {
+        if(((active[i] == 1) && (fval[i] < MICROPY_FLOAT_CONST(0.0))) || ((active[i] == 2) && (fval[i] > MICROPY_FLOAT_CONST(0.0)))) {
+            m_del(uint8_t, active, len);
+            m_del(mp_float_t, rtb, 3 * len);
+            mp_raise_ValueError(MP_ERROR_TEXT("function has the same sign at the ends of interval"));
+        }
+        mp_float_t a = rtb[i];
+        mp_float_t b = dx[i];
+        if((active[i] == 0) || (fval[i] == MICROPY_FLOAT_CONST(0.0))) {
+            // one of the ends is already a root, so the problem is done
+            rtb[i] = active[i] == 0 ? a : b;
+            dx[i] = MICROPY_FLOAT_CONST(0.0);
+            active[i] = 0;
+            nactive--;
+            continue;
+        }
+        rtb[i] = active[i] == 1 ? a : b;
+        dx[i] = active[i] == 1 ? b - a : a - b;
+        active[i] = 1;
+    }
+
+    for(mp_int_t iter = 0; (iter < maxiter) && (nactive > 0); iter++) {
+        for(size_t i = 0; i < len; i++) {
+            if(active[i]) {
+                dx[i] *= MICROPY_FLOAT_CONST(0.5);
+                xarray[i] = rtb[i] + dx[i];
+            } else {
+                xarray[i] = rtb[i];
+            }
+        }
+        optimize_python_call_array(type, fun, x, fval);
+        for(size_t i = 0; i < len; i++) {
+            if(active[i]) {
+                if(fval[i] < MICROPY_FLOAT_CONST(0.0)) {
+                    rtb[i] = xarray[i];
+                }
+                if(MICROPY_FLOAT_C_FUN(fabs)(dx[i]) < xtol) {
+                    active[i] = 0;
+                    nactive--;
+                }
+            }
+        }
+    }
+    memcpy(xarray, rtb, len * sizeof(mp_float_t));
+    m_del(uint8_t, active, len);
+    m_del(mp_float_t, rtb, 3 * len);
+    return MP_OBJ_FROM_PTR(x);
+}
+
 STATIC mp_obj_t optimize_bisect(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     // Simple bisection routine
     static const mp_arg_t allowed_args[] = {
@@ -74,6 +199,9 @@ STATIC mp_obj_t optimize_bisect(size_t n_args, const mp_obj_t *pos_args, mp_map_
         mp_raise_TypeError(MP_ERROR_TEXT("first argument must be a function"));
     }
     mp_float_t xtol = mp_obj_get_float(args[3].u_obj);
+    if(ndarray_object_is_array_like(args[1].u_obj) || ndarray_object_is_array_like(args[2].u_obj)) {
+        return optimize_bisect_array(type, fun, args[1].u_obj, args[2].u_obj, xtol, args[4].u_int);
+    }
     mp_obj_t fargs[1];
     mp_float_t left, right;
     mp_float_t x_mid;
@@ -220,44 +348,170 @@ MP_DEFINE_CONST_FUN_OBJ_KW(optimize_fmin_obj, 2, optimize_fmin);
 #endif
 
 #if ULAB_SCIPY_OPTIMIZE_HAS_CURVE_FIT
-static void optimize_jacobi(const mp_obj_type_t *type, mp_obj_t fun, mp_float_t *x, mp_float_t *y, uint16_t len, mp_float_t *params, uint8_t nparams, mp_float_t *jacobi, mp_float_t *grad) {
-    /* Calculates the Jacobian and the gradient of the cost function
-     *
-     * The entries in the Jacobian are
-     * J(m, n) = de_m/da_n,
-     *
-     * where
-     *
-     * e_m = (f(x_m, a1, a2, ...) - y_m)/sigma_m is the error at x_m,
+static void optimize_load_jacobian(mp_float_t *jacobi, mp_obj_t obj, size_t len, uint8_t nparams) {
+    // copies the (len, nparams) matrix returned by the Jacobian into jacobi, row by row
+    #if ULAB_MAX_DIMS > 1
+    if(mp_obj_is_type(obj, &ulab_ndarray_type)) {
+        ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(obj);
+        COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+        if((ndarray->ndim == 2) && (ndarray->shape[ULAB_MAX_DIMS - 2] == len) && (ndarray->shape[ULAB_MAX_DIMS - 1] == nparams)) {
+            uint8_t *array = (uint8_t *)ndarray->array;
+            for(size_t i = 0; i < len; i++) {
+                tools_load_float(jacobi, 1, array, ndarray->strides[ULAB_MAX_DIMS - 1], ndarray->dtype, nparams);
+                array += ndarray->strides[ULAB_MAX_DIMS - 2];
+                jacobi += nparams;
+            }
+            return;
+        }
+    }
+    #endif
+    if(nparams == 1) {
+        // with a single parameter, the Jacobian can also be a vector
+        optimize_load_vector(jacobi, obj, len);
+        return;
+    }
+    if(mp_obj_is_type(obj, &ulab_ndarray_type) || !ndarray_object_is_array_like(obj) ||
+        ((size_t)mp_obj_get_int(mp_obj_len_maybe(obj)) != len)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("function returned an array of wrong shape"));
+    }
+    mp_obj_iter_buf_t buf;
+    mp_obj_t item, iterable = mp_getiter(obj, &buf);
+    while((item = mp_iternext(iterable)) != MP_OBJ_STOP_ITERATION) {
+        optimize_load_vector(jacobi, item, nparams);
+        jacobi += nparams;
+    }
+}
+
+static mp_obj_t optimize_model_call(const mp_obj_type_t *type, mp_obj_t fun, mp_obj_t *fargs, mp_float_t *params, uint8_t nparams) {
+    // calls f(x, a, b, c, ...) with the whole array of the independent variable in fargs[0]
+    for(uint8_t p = 0; p < nparams; p++) {
+        fargs[p + 1] = mp_obj_new_float(params[p]);
+    }
+    return MP_OBJ_TYPE_GET_SLOT(type, call)(fun, nparams + 1, 0, fargs);
+}
+
+static mp_float_t optimize_cost(mp_float_t *f, mp_float_t *y, size_t len) {
+    mp_float_t cost = MICROPY_FLOAT_CONST(0.0);
+    for(size_t i = 0; i < len; i++) {
+        cost += (f[i] - y[i]) * (f[i] - y[i]);
+    }
+    return cost;
+}
+
+static bool optimize_cholesky(mp_float_t *M, uint8_t n) {
+    // replaces the lower triangle of the symmetric matrix M by its Cholesky factor,
+    // and returns false, if M is not positive definite
+    for(uint8_t j = 0; j < n; j++) {
+        mp_float_t sum = M[j * n + j];
+        for(uint8_t k = 0; k < j; k++) {
+            sum -= M[j * n + k] * M[j * n + k];
+        }
+        if(!(sum > MICROPY_FLOAT_CONST(0.0))) {
+            return false;
+        }
+        M[j * n + j] = MICROPY_FLOAT_C_FUN(sqrt)(sum);
+        for(uint8_t i = j + 1; i < n; i++) {
+            sum = M[i * n + j];
+            for(uint8_t k = 0; k < j; k++) {
+                sum -= M[i * n + k] * M[j * n + k];
+            }
+            M[i * n + j] = sum / M[j * n + j];
+        }
+    }
+    return true;
+}
+
+static void optimize_cholesky_solve(mp_float_t *L, mp_float_t *b, uint8_t n) {
+    // solves L L^T x = b in place
+    for(uint8_t i = 0; i < n; i++) {
+        for(uint8_t k = 0; k < i; k++) {
+            b[i] -= L[i * n + k] * b[k];
+        }
+        b[i] /= L[i * n + i];
+    }
+    for(uint8_t i = n; i-- > 0; ) {
+        for(uint8_t k = i + 1; k < n; k++) {
+            b[i] -= L[k * n + i] * b[k];
+        }
+        b[i] /= L[i * n + i];
+    }
+}
+
+static void optimize_jacobi(const mp_obj_type_t *type, mp_obj_t fun, mp_obj_t jac, mp_obj_t *fargs,
+                mp_float_t *params, uint8_t nparams, mp_float_t *f, mp_float_t *ftrial, size_t len, mp_float_t *jacobi) {
+    /* Calculates the Jacobian
      *
-     * and
+     * J(m, n) = df(x_m, a1, a2, ...)/da_n,
      *
-     * a1, a2, ..., a_n are the free parameters
+     * where a1, a2, ..., a_n are the free parameters. If the Jacobian is not supplied, the derivatives
+     * are approximated by forward differences from f, the model at params, and nparams further calls
+     * of the model, each of which evaluates all data points at once; ftrial is used as a scratch buffer
      */
-    mp_obj_t *fargs0 = m_new(mp_obj_t, lenp+1);
-    mp_obj_t *fargs1 = m_new(mp_obj_t, lenp+1);
-    for(uint8_t p=0; p < nparams; p++) {
-        fargs0[p+1] = mp_obj_new_float(params[p]);
-        fargs1[p+1] = mp_obj_new_float(params[p]);
-    }
-    for(uint8_t p=0; p < nparams; p++) {
-        mp_float_t da = params[p] != MICROPY_FLOAT_CONST(0.0) ? (MICROPY_FLOAT_CONST(1.0) + APPROX_NONZDELTA) * params[p] : APPROX_ZDELTA;
-        fargs1[p+1] = mp_obj_new_float(params[p] + da);
-        grad[p] = MICROPY_FLOAT_CONST(0.0);
-        for(uint16_t i=0; i < len; i++) {
-            mp_float_t f0 = optimize_python_call(type, fun, x[i], fargs0, nparams);
-            mp_float_t f1 = optimize_python_call(type, fun, x[i], fargs1, nparams);
-            jacobi[i*nparamp+p] = (f1 - f0) / da;
-            grad[p] += (f0 - y[i]) * jacobi[i*nparamp+p];
+    if(jac != mp_const_none) {
+        const mp_obj_type_t *jac_type = mp_obj_get_type(jac);
+        optimize_load_jacobian(jacobi, optimize_model_call(jac_type, jac, fargs, params, nparams), len, nparams);
+        return;
+    }
+    for(uint8_t p = 0; p < nparams; p++) {
+        mp_float_t a = params[p];
+        mp_float_t da = a != MICROPY_FLOAT_CONST(0.0) ? OPTIMIZE_EPS * MICROPY_FLOAT_C_FUN(fabs)(a) : OPTIMIZE_EPS;
+        params[p] = a + da;
+        // this is the step that is actually representable
+        da = params[p] - a;
+        optimize_load_vector(ftrial, optimize_model_call(type, fun, fargs, params, nparams), len);
+        params[p] = a;
+        for(size_t i = 0; i < len; i++) {
+            jacobi[i * nparams + p] = (ftrial[i] - f[i]) / da;
         }
-        fargs1[p+1] = fargs0[p+1]; // set back to the original value
     }
 }
 
-static void optimize_delta(mp_float_t *jacobi, mp_float_t *grad, uint16_t len, uint8_t nparams, mp_float_t lambda) {
-    //
+static void optimize_normal_equations(mp_float_t *jacobi, mp_float_t *f, mp_float_t *y, size_t len, uint8_t nparams, mp_float_t *A, mp_float_t *grad) {
+    // A = J^T J, and grad = J^T (f - y), i.e., half the gradient of the cost function
+    for(uint8_t p = 0; p < nparams; p++) {
+        for(uint8_t q = 0; q <= p; q++) {
+            mp_float_t sum = MICROPY_FLOAT_CONST(0.0);
+            for(size_t i = 0; i < len; i++) {
+                sum += jacobi[i * nparams + p] * jacobi[i * nparams + q];
+            }
+            A[p * nparams + q] = A[q * nparams + p] = sum;
+        }
+        mp_float_t sum = MICROPY_FLOAT_CONST(0.0);
+        for(size_t i = 0; i < len; i++) {
+            sum += jacobi[i * nparams + p] * (f[i] - y[i]);
+        }
+        grad[p] = sum;
+    }
 }
 
+//| def curve_fit(
+//|     f: Callable[..., _ArrayLike],
+//|     xdata: _ArrayLike,
+//|     ydata: _ArrayLike,
+//|     p0: _ArrayLike,
+//|     *,
+//|     jac: Optional[Callable[..., _ArrayLike]] = None,
+//|     xatol: float = 2.4e-7,
+//|     fatol: float = 2.4e-7,
+//|     maxiter: int = 100
+//| ) -> Tuple[ulab.numpy.ndarray, ulab.numpy.ndarray]:
+//|     """
+//|     :param callable f: The model function, f(x, a, b, c, ...)
+//|     :param xdata: The independent variable, passed to f as is
+//|     :param ydata: The dependent data
+//|     :param p0: The initial values of the parameters
+//|     :param callable jac: The Jacobian of f with respect to the parameters
+//|     :param float xatol: The relative tolerance of the parameters
+//|     :param float fatol: The relative tolerance of the sum of squared residuals
+//|     :param int maxiter: The maximum number of iterations to perform
+//|
+//|     Fits f to the data by the Levenberg-Marquardt method, and returns the
+//|     optimal parameters, and their estimated covariance matrix. f, and jac are
+//|     called with the whole of xdata, and must return an array of the model values,
+//|     and the Jacobian of shape (len(xdata), len(p0)), respectively."""
+//|     ...
+//|
+
 mp_obj_t optimize_curve_fit(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     // Levenberg-Marquardt non-linear fit
     // The implementation follows the introductory discussion in Mark Tanstrum's paper, https://arxiv.org/abs/1201.5885
@@ -266,9 +520,10 @@ mp_obj_t optimize_curve_fit(size_t n_args, const mp_obj_t *pos_args, mp_map_t *k
         { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
         { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
         { MP_QSTR_p0, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
-        { MP_QSTR_xatol, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_PTR(&xtolerance)} },
-        { MP_QSTR_fatol, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_PTR(&xtolerance)} },
-        { MP_QSTR_maxiter, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_jac, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_xatol, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = ULAB_REFERENCE_FLOAT_CONST(xtolerance) } },
+        { MP_QSTR_fatol, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = ULAB_REFERENCE_FLOAT_CONST(xtolerance) } },
+        { MP_QSTR_maxiter, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 100 } },
     };
 
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
@@ -279,6 +534,10 @@ mp_obj_t optimize_curve_fit(size_t n_args, const mp_obj_t *pos_args, mp_map_t *k
     if(!MP_OBJ_TYPE_HAS_SLOT(type, call)) {
         mp_raise_TypeError(MP_ERROR_TEXT("first argument must be a function"));
     }
+    mp_obj_t jac = args[4].u_obj;
+    if((jac != mp_const_none) && !MP_OBJ_TYPE_HAS_SLOT(mp_obj_get_type(jac), call)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("jac must be a function"));
+    }
 
     mp_obj_t x_obj = args[1].u_obj;
     mp_obj_t y_obj = args[2].u_obj;
@@ -286,44 +545,146 @@ mp_obj_t optimize_curve_fit(size_t n_args, const mp_obj_t *pos_args, mp_map_t *k
     if(!ndarray_object_is_array_like(x_obj) || !ndarray_object_is_array_like(y_obj)) {
         mp_raise_TypeError(MP_ERROR_TEXT("data must be iterable"));
     }
-    if(!ndarray_object_is_nditerable(p0_obj)) {
+    if(!ndarray_object_is_array_like(p0_obj)) {
         mp_raise_TypeError(MP_ERROR_TEXT("initial values must be iterable"));
     }
     size_t len = (size_t)mp_obj_get_int(mp_obj_len_maybe(x_obj));
-    uint8_t lenp = (uint8_t)mp_obj_get_int(mp_obj_len_maybe(p0_obj));
-    if(len != (uint16_t)mp_obj_get_int(mp_obj_len_maybe(y_obj))) {
+    size_t lenp = (size_t)mp_obj_get_int(mp_obj_len_maybe(p0_obj));
+    if(len != (size_t)mp_obj_get_int(mp_obj_len_maybe(y_obj))) {
         mp_raise_ValueError(MP_ERROR_TEXT("data must be of equal length"));
     }
+    if((lenp == 0) || (lenp > 255)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("number of parameters must be between 1 and 255"));
+    }
+    if(len < lenp) {
+        mp_raise_ValueError(MP_ERROR_TEXT("more parameters than data points"));
+    }
+    uint8_t nparams = (uint8_t)lenp;
+    mp_float_t xatol = mp_obj_get_float(args[5].u_obj);
+    mp_float_t fatol = mp_obj_get_float(args[6].u_obj);
+    if(args[7].u_int <= 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("maxiter must be > 0"));
+    }
 
-    mp_float_t *x = m_new(mp_float_t, len);
-    fill_array_iterable(x, x_obj);
-    mp_float_t *y = m_new(mp_float_t, len);
-    fill_array_iterable(y, y_obj);
-    mp_float_t *p0 = m_new(mp_float_t, lenp);
-    fill_array_iterable(p0, p0_obj);
-    mp_float_t *grad = m_new(mp_float_t, len);
-    mp_float_t *jacobi = m_new(mp_float_t, len*len);
-    mp_obj_t *fargs = m_new(mp_obj_t, lenp+1);
-
-    m_del(mp_float_t, p0, lenp);
-    // parameters controlling convergence conditions
-    //mp_float_t xatol = mp_obj_get_float(args[2].u_obj);
-    //mp_float_t fatol = mp_obj_get_float(args[3].u_obj);
+    // the arguments of the python function are objects, hence they are kept on the heap;
+    // the model is called with the whole array of the independent variable
+    mp_obj_t *fargs = m_new(mp_obj_t, nparams + 1);
+    if(mp_obj_is_type(x_obj, &ulab_ndarray_type)) {
+        fargs[0] = x_obj;
+    } else {
+        ndarray_obj_t *x = ndarray_new_linear_array(len, NDARRAY_FLOAT);
+        fill_array_iterable((mp_float_t *)x->array, x_obj);
+        fargs[0] = MP_OBJ_FROM_PTR(x);
+    }
 
+    // All buffers are allocated once, and are re-used in each iteration. Since the python
+    // functions can raise exceptions, the buffers are taken from the heap, and not from the
+    // workspace, so that they can always be reclaimed.
+    size_t wlen = len * (nparams + 3) + nparams * (2 * nparams + 4);
+    mp_float_t *y = m_new(mp_float_t, wlen);
+    mp_float_t *f = y + len;
+    mp_float_t *ftrial = f + len;
+    mp_float_t *jacobi = ftrial + len;
+    mp_float_t *A = jacobi + len * nparams;
+    mp_float_t *M = A + nparams * nparams;
+    mp_float_t *grad = M + nparams * nparams;
+    mp_float_t *delta = grad + nparams;
+    mp_float_t *params = delta + nparams;
+    mp_float_t *ptrial = params + nparams;
+
+    optimize_load_vector(y, y_obj, len);
+    fill_array_iterable(params, p0_obj);
+
+    optimize_load_vector(f, optimize_model_call(type, fun, fargs, params, nparams), len);
+    mp_float_t cost = optimize_cost(f, y, len);
+    optimize_jacobi(type, fun, jac, fargs, params, nparams, f, ftrial, len, jacobi);
     // this has finite binary representation; we will multiply/divide by 4
-    //mp_float_t lambda = 0.0078125;
+    mp_float_t lambda = OPTIMIZE_LAMBDA;
+    bool stale = false;
+
+    for(mp_int_t iter = 0; (iter < args[7].u_int) && (cost > MICROPY_FLOAT_CONST(0.0)); iter++) {
+        optimize_normal_equations(jacobi, f, y, len, nparams, A, grad);
+        mp_float_t ctrial = cost;
+        bool accepted = false;
+        while(!accepted && (lambda < OPTIMIZE_LAMBDA_MAX)) {
+            // Marquardt's damping scales the diagonal, so that the step is invariant to the units of the parameters
+            memcpy(M, A, nparams * nparams * sizeof(mp_float_t));
+            for(uint8_t p = 0; p < nparams; p++) {
+                M[p * nparams + p] += lambda * (A[p * nparams + p] > MICROPY_FLOAT_CONST(0.0) ? A[p * nparams + p] : MICROPY_FLOAT_CONST(1.0));
+                delta[p] = -grad[p];
+            }
+            if(optimize_cholesky(M, nparams)) {
+                optimize_cholesky_solve(M, delta, nparams);
+                for(uint8_t p = 0; p < nparams; p++) {
+                    ptrial[p] = params[p] + delta[p];
+                }
+                optimize_load_vector(ftrial, optimize_model_call(type, fun, fargs, ptrial, nparams), len);
+                ctrial = optimize_cost(ftrial, y, len);
+                accepted = ctrial < cost;
+            }
+            if(!accepted) {
+                lambda *= MICROPY_FLOAT_CONST(4.0);
+            }
+        }
+        if(!accepted) {
+            // no step decreases the cost any further
+            break;
+        }
+        bool converged = (cost - ctrial) <= fatol * cost;
+        bool small = true;
+        for(uint8_t p = 0; p < nparams; p++) {
+            small = small && (MICROPY_FLOAT_C_FUN(fabs)(delta[p]) <= xatol * (MICROPY_FLOAT_C_FUN(fabs)(ptrial[p]) + xatol));
+        }
+        SWAP(mp_float_t *, params, ptrial);
+        SWAP(mp_float_t *, f, ftrial);
+        cost = ctrial;
+        lambda /= MICROPY_FLOAT_CONST(4.0);
+        if(converged || small) {
+            stale = true;
+            break;
+        }
+        optimize_jacobi(type, fun, jac, fargs, params, nparams, f, ftrial, len, jacobi);
+    }
+    if(stale) {
+        optimize_jacobi(type, fun, jac, fargs, params, nparams, f, ftrial, len, jacobi);
+    }
 
-    //linalg_invert_matrix(mp_float_t *data, size_t N)
+    ndarray_obj_t *popt = ndarray_new_linear_array(nparams, NDARRAY_FLOAT);
+    memcpy(popt->array, params, nparams * sizeof(mp_float_t));
 
-    m_del(mp_float_t, x, len);
-    m_del(mp_float_t, y, len);
-    m_del(mp_float_t, grad, len);
-    m_del(mp_float_t, jacobi, len*len);
-    m_del(mp_obj_t, fargs, lenp+1);
-    return mp_const_none;
+    // the covariance is estimated as s^2 (J^T J)^{-1}, with s^2 = cost / (len - nparams)
+    #if ULAB_MAX_DIMS > 1
+    ndarray_obj_t *pcov = ndarray_new_dense_ndarray(2, ndarray_shape_vector(0, 0, nparams, nparams), NDARRAY_FLOAT);
+    #else
+    ndarray_obj_t *pcov = ndarray_new_linear_array(nparams * nparams, NDARRAY_FLOAT);
+    #endif
+    mp_float_t *cov = (mp_float_t *)pcov->array;
+    optimize_normal_equations(jacobi, f, y, len, nparams, A, grad);
+    if((len > nparams) && optimize_cholesky(A, nparams)) {
+        mp_float_t s2 = cost / (mp_float_t)(len - nparams);
+        for(uint8_t q = 0; q < nparams; q++) {
+            memset(delta, 0, nparams * sizeof(mp_float_t));
+            delta[q] = MICROPY_FLOAT_CONST(1.0);
+            optimize_cholesky_solve(A, delta, nparams);
+            for(uint8_t p = 0; p < nparams; p++) {
+                cov[p * nparams + q] = s2 * delta[p];
+            }
+        }
+    } else {
+        // the covariance cannot be estimated
+        for(size_t i = 0; i < pcov->len; i++) {
+            cov[i] = INFINITY;
+        }
+    }
+
+    m_del(mp_float_t, y, wlen);
+    m_del(mp_obj_t, fargs, nparams + 1);
+
+    mp_obj_t tuple[2] = { MP_OBJ_FROM_PTR(popt), MP_OBJ_FROM_PTR(pcov) };
+    return mp_obj_new_tuple(2, tuple);
 }
 
-MP_DEFINE_CONST_FUN_OBJ_KW(optimize_curve_fit_obj, 2, optimize_curve_fit);
+MP_DEFINE_CONST_FUN_OBJ_KW(optimize_curve_fit_obj, 4, optimize_curve_fit);
 #endif
 
 #if ULAB_SCIPY_OPTIMIZE_HAS_NEWTON
@@ -348,6 +709,51 @@ MP_DEFINE_CONST_FUN_OBJ_KW(optimize_curve_fit_obj, 2, optimize_curve_fit);
 //|     ...
 //|
 
+static mp_obj_t optimize_newton_array(const mp_obj_type_t *type, mp_obj_t fun, mp_obj_t x0, mp_float_t tol, mp_float_t rtol, mp_int_t maxiter) {
+    // Runs the secant iteration of all problems in lockstep: the function is called twice
+    // per iteration with whole arrays, and the problems that have converged are masked out
+    ndarray_obj_t *x = optimize_float_array(x0);
+    mp_float_t *xarray = (mp_float_t *)x->array;
+    size_t len = x->len;
+    mp_float_t *root = m_new(mp_float_t, 4 * len);
+    mp_float_t *dx = root + len;
+    mp_float_t *fx = dx + len;
+    mp_float_t *fdx = fx + len;
+    uint8_t *active = m_new(uint8_t, len);
+    memcpy(root, xarray, len * sizeof(mp_float_t));
+    for(size_t i = 0; i < len; i++) {
+        dx[i] = root[i] != MICROPY_FLOAT_CONST(0.0) ? OPTIMIZE_EPS * MICROPY_FLOAT_C_FUN(fabs)(root[i]) : OPTIMIZE_EPS;
+        active[i] = 1;
+    }
+
+    size_t nactive = len;
+    for(mp_int_t iter = 0; (iter < maxiter) && (nactive > 0); iter++) {
+        memcpy(xarray, root, len * sizeof(mp_float_t));
+        optimize_python_call_array(type, fun, x, fx);
+        for(size_t i = 0; i < len; i++) {
+            if(active[i]) {
+                xarray[i] += dx[i];
+            }
+        }
+        optimize_python_call_array(type, fun, x, fdx);
+        for(size_t i = 0; i < len; i++) {
+            if(active[i]) {
+                mp_float_t df = (fdx[i] - fx[i]) / (xarray[i] - root[i]);
+                dx[i] = fx[i] / df;
+                root[i] -= dx[i];
+                if(MICROPY_FLOAT_C_FUN(fabs)(dx[i]) < (tol + rtol * MICROPY_FLOAT_C_FUN(fabs)(root[i]))) {
+                    active[i] = 0;
+                    nactive--;
+                }
+            }
+        }
+    }
+    memcpy(xarray, root, len * sizeof(mp_float_t));
+    m_del(uint8_t, active, len);
+    m_del(mp_float_t, root, 4 * len);
+    return MP_OBJ_FROM_PTR(x);
+}
+
 static mp_obj_t optimize_newton(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     // this is actually the secant method, as the first derivative of the function
     // is not accepted as an argument. The function whose root we want to solve for
@@ -368,15 +774,18 @@ static mp_obj_t optimize_newton(size_t n_args, const mp_obj_t *pos_args, mp_map_
     if(!MP_OBJ_TYPE_HAS_SLOT(type, call)) {
         mp_raise_TypeError(MP_ERROR_TEXT("first argument must be a function"));
     }
-    mp_float_t x = mp_obj_get_float(args[1].u_obj);
     mp_float_t tol = mp_obj_get_float(args[2].u_obj);
     mp_float_t rtol = mp_obj_get_float(args[3].u_obj);
-    mp_float_t dx, df, fx;
-    dx = x > MICROPY_FLOAT_CONST(0.0) ? OPTIMIZE_EPS * x : -OPTIMIZE_EPS * x;
-    mp_obj_t fargs[1];
     if(args[4].u_int <= 0) {
         mp_raise_ValueError(MP_ERROR_TEXT("maxiter must be > 0"));
     }
+    if(ndarray_object_is_array_like(args[1].u_obj)) {
+        return optimize_newton_array(type, fun, args[1].u_obj, tol, rtol, args[4].u_int);
+    }
+    mp_float_t x = mp_obj_get_float(args[1].u_obj);
+    mp_float_t dx, df, fx;
+    dx = x > MICROPY_FLOAT_CONST(0.0) ? OPTIMIZE_EPS * x : -OPTIMIZE_EPS * x;
+    mp_obj_t fargs[1];
     for(uint16_t i=0; i < args[4].u_int; i++) {
         fx = optimize_python_call(type, fun, x, fargs, 0);
         df = (optimize_python_call(type, fun, x + dx, fargs, 0) - fx) / dx;
@@ -393,16 +802,16 @@ MP_DEFINE_CONST_FUN_OBJ_KW(optimize_newton_obj, 2, optimize_newton);
 static const mp_rom_map_elem_t ulab_scipy_optimize_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_optimize) },
     #if ULAB_SCIPY_OPTIMIZE_HAS_BISECT
-        { MP_ROM_QSTR(MP_QSTR_bisect), MP_ROM_PTR(&optimize_bisect_obj) },
+        { MP_ROM_QSTR(MP_QSTR_bisect), ULAB_PROFILE_PTR(MP_QSTR_optimize, MP_QSTR_bisect, optimize_bisect_obj) },
     #endif
     #if ULAB_SCIPY_OPTIMIZE_HAS_CURVE_FIT
-        { MP_ROM_QSTR(MP_QSTR_curve_fit), MP_ROM_PTR(&optimize_curve_fit_obj) },
+        { MP_ROM_QSTR(MP_QSTR_curve_fit), ULAB_PROFILE_PTR(MP_QSTR_optimize, MP_QSTR_curve_fit, optimize_curve_fit_obj) },
     #endif
     #if ULAB_SCIPY_OPTIMIZE_HAS_FMIN
-        { MP_ROM_QSTR(MP_QSTR_fmin), MP_ROM_PTR(&optimize_fmin_obj) },
+        { MP_ROM_QSTR(MP_QSTR_fmin), ULAB_PROFILE_PTR(MP_QSTR_optimize, MP_QSTR_fmin, optimize_fmin_obj) },
     #endif
     #if ULAB_SCIPY_OPTIMIZE_HAS_NEWTON
-        { MP_ROM_QSTR(MP_QSTR_newton), MP_ROM_PTR(&optimize_newton_obj) },
+        { MP_ROM_QSTR(MP_QSTR_newton), ULAB_PROFILE_PTR(MP_QSTR_optimize, MP_QSTR_newton, optimize_newton_obj) },
     #endif
 };
 
@@ -31,6 +31,10 @@
 #define     OPTIMIZE_GAMMA        MICROPY_FLOAT_CONST(0.5)
 #define     OPTIMIZE_DELTA        MICROPY_FLOAT_CONST(0.5)
 
+// initial, and maximum damping of the Levenberg-Marquardt steps in curve_fit
+#define     OPTIMIZE_LAMBDA       MICROPY_FLOAT_CONST(0.0078125)
+#define     OPTIMIZE_LAMBDA_MAX   MICROPY_FLOAT_CONST(1.0e10)
+
 extern const mp_obj_module_t ulab_scipy_optimize_module;
 
 MP_DECLARE_CONST_FUN_OBJ_KW(optimize_bisect_obj);
@@ -18,25 +18,581 @@
 
 #include "../../ulab.h"
 #include "../../ndarray.h"
+#include "../../ulab_tools.h"
+#include "../../ulab_dsp.h"
+#include "../../ulab_parallel.h"
 #include "../../numpy/carray/carray_tools.h"
+#include "../../numpy/fft/fft_tools.h"
+#include "../../ulab_profile.h"
+#include "signal.h"
+
+#ifndef MP_PI
+#define MP_PI MICROPY_FLOAT_CONST(3.14159265358979323846)
+#endif
+
+#if ULAB_SCIPY_SIGNAL_HAS_CONVOLVE2D & ULAB_MAX_DIMS > 1
+// the parsed arguments of convolve2d, and correlate2d: both are calculated as the correlation
+// of the zero-padded image with kernel, which is the flipped in2 for the convolution; the output
+// is the window of oh x ow samples of the full correlation starting at r0, and c0
+typedef struct _signal_convolve2d_t {
+    ndarray_obj_t *image;
+    ndarray_obj_t *results;
+    // the kh x kw coefficients, or, if separable is true, the column u, followed by the row v
+    void *kernel;
+    size_t kh;
+    size_t kw;
+    size_t oh;
+    size_t ow;
+    size_t r0;
+    size_t c0;
+    // the product of u, and v is divisor times the kernel
+    int32_t divisor;
+    bool separable;
+    // the kh rows of the ring, and a line of the padded image, allocated by the caller, because
+    // the kernels run without the GIL
+    void *ring;
+} signal_convolve2d_t;
+
+static void signal_load_row_int32_t(int32_t *data, ndarray_obj_t *image, int32_t row, int32_t col, size_t len) {
+    // copies len samples of the row of image, starting at col, into data; outside the image, the samples are 0
+    int32_t height = image->shape[ULAB_MAX_DIMS - 2];
+    int32_t width = image->shape[ULAB_MAX_DIMS - 1];
+    memset(data, 0, len * sizeof(int32_t));
+    if((row < 0) || (row >= height)) {
+        return;
+    }
+    int32_t begin = MAX(col, 0);
+    int32_t end = MIN(col + (int32_t)len, width);
+    uint8_t *array = (uint8_t *)image->array + row * image->strides[ULAB_MAX_DIMS - 2];
+    array += begin * image->strides[ULAB_MAX_DIMS - 1];
+    data += begin - col;
+    int32_t stride = image->strides[ULAB_MAX_DIMS - 1];
+    for(int32_t i = begin; i < end; i++) {
+        if(image->dtype == NDARRAY_UINT8) {
+            *data++ = *(uint8_t *)array;
+        } else if(ULAB_DTYPE_IS(image->dtype, INT8)) {
+            *data++ = *(int8_t *)array;
+        } else if(image->dtype == NDARRAY_UINT16) {
+            *data++ = *(uint16_t *)array;
+        } else {
+            *data++ = *(int16_t *)array;
+        }
+        array += stride;
+    }
+}
+
+static void signal_load_row_mp_float_t(mp_float_t *data, ndarray_obj_t *image, int32_t row, int32_t col, size_t len) {
+    // the same as signal_load_row_int32_t, but for floats
+    int32_t height = image->shape[ULAB_MAX_DIMS - 2];
+    int32_t width = image->shape[ULAB_MAX_DIMS - 1];
+    memset(data, 0, len * sizeof(mp_float_t));
+    if((row < 0) || (row >= height)) {
+        return;
+    }
+    int32_t begin = MAX(col, 0);
+    int32_t end = MIN(col + (int32_t)len, width);
+    uint8_t *array = (uint8_t *)image->array + row * image->strides[ULAB_MAX_DIMS - 2];
+    array += begin * image->strides[ULAB_MAX_DIMS - 1];
+    data += begin - col;
+    mp_float_t (*func)(void *) = ndarray_get_float_function(image->dtype);
+    for(int32_t i = begin; i < end; i++) {
+        *data++ = func(array);
+        array += image->strides[ULAB_MAX_DIMS - 1];
+    }
+}
+
+static inline int16_t signal_int16_int32_t(int32_t value) {
+    return TOOLS_Q15_SATURATE(value);
+}
+
+static inline int16_t signal_int16_mp_float_t(mp_float_t value) {
+    value = MICROPY_FLOAT_C_FUN(round)(value);
+    return value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : (int16_t)value);
+}
+
+// Only kh rows of the padded image are held in a ring of row buffers, so that the scratch space
+// does not depend on the height of the image. With a separable kernel, the rows are filtered by v,
+// when they are loaded, and the outputs are the sums of kh filtered rows weighted by u, so that
+// each output costs kh + kw, instead of kh * kw multiplications.
+#define SIGNAL_CONVOLVE2D_FUNCTION(type)\
+static void signal_convolve2d_##type(signal_convolve2d_t *conv) {\
+    size_t kh = conv->kh;\
+    size_t kw = conv->kw;\
+    size_t ow = conv->ow;\
+    size_t lw = ow + kw - 1;\
+    size_t width = conv->separable ? ow : lw;\
+    type *kernel = (type *)conv->kernel;\
+    type *u = kernel;\
+    type *v = kernel + kh;\
+    type *ring = (type *)conv->ring;\
+    type *line = ring + kh * width;\
+    int32_t col = (int32_t)conv->c0 - (int32_t)(kw - 1);\
+    bool is_float = conv->results->dtype == NDARRAY_FLOAT;\
+    mp_float_t *farray = (mp_float_t *)conv->results->array;\
+    int16_t *iarray = (int16_t *)conv->results->array;\
+    for(size_t p = 0; p < conv->oh + kh - 1; p++) {\
+        int32_t row = (int32_t)(conv->r0 + p) - (int32_t)(kh - 1);\
+        type *slot = ring + (p % kh) * width;\
+        if(conv->separable) {\
+            signal_load_row_##type(line, conv->image, row, col, lw);\
+            for(size_t x = 0; x < ow; x++) {\
+                type accum = 0;\
+                for(size_t j = 0; j < kw; j++) {\
+                    accum += v[j] * line[x + j];\
+                }\
+                slot[x] = accum;\
+            }\
+        } else {\
+            signal_load_row_##type(slot, conv->image, row, col, lw);\
+        }\
+        if(p + 1 < kh) {\
+            continue;\
+        }\
+        /* the ring is full, and the output row y depends on the rows y...y + kh - 1 */\
+        size_t y = p + 1 - kh;\
+        for(size_t x = 0; x < ow; x++) {\
+            type accum = 0;\
+            for(size_t i = 0; i < kh; i++) {\
+                type *r = ring + ((y + i) % kh) * width + x;\
+                if(conv->separable) {\
+                    accum += u[i] * r[0];\
+                } else {\
+                    type *k = kernel + i * kw;\
+                    for(size_t j = 0; j < kw; j++) {\
+                        accum += k[j] * r[j];\
+                    }\
+                }\
+            }\
+            if(conv->divisor != 1) {\
+                accum /= (type)conv->divisor;\
+            }\
+            if(is_float) {\
+                *farray++ = (mp_float_t)accum;\
+            } else {\
+                *iarray++ = signal_int16_##type(accum);\
+            }\
+        }\
+    }\
+}
+
+SIGNAL_CONVOLVE2D_FUNCTION(int32_t);
+SIGNAL_CONVOLVE2D_FUNCTION(mp_float_t);
+
+static bool signal_is_integer(uint8_t dtype) {
+    return (dtype == NDARRAY_UINT8) || ULAB_DTYPE_IS(dtype, INT8) || (dtype == NDARRAY_UINT16) || ULAB_DTYPE_IS(dtype, INT16);
+}
+
+static uint32_t signal_integer_max(uint8_t dtype) {
+    // the largest magnitude of an integer dtype
+    if(dtype == NDARRAY_UINT8) {
+        return UINT8_MAX;
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {
+        return -INT8_MIN;
+    } else if(dtype == NDARRAY_UINT16) {
+        return UINT16_MAX;
+    }
+    return -INT16_MIN;
+}
+
+static mp_obj_t signal_convolve2d_correlate2d(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args, bool flip) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_in1, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_in2, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_mode, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_QSTR(MP_QSTR_full) } },
+        { MP_QSTR_dtype, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = NDARRAY_FLOAT } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if(!mp_obj_is_type(args[0].u_obj, &ulab_ndarray_type) || !mp_obj_is_type(args[1].u_obj, &ulab_ndarray_type)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("input arguments must be ndarrays"));
+    }
+    ndarray_obj_t *image = MP_OBJ_TO_PTR(args[0].u_obj);
+    ndarray_obj_t *in2 = MP_OBJ_TO_PTR(args[1].u_obj);
+    if((image->ndim != 2) || (in2->ndim != 2)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("input arguments must be two-dimensional"));
+    }
+    if((image->len == 0) || (in2->len == 0)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("input arguments must not be empty"));
+    }
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(image->dtype)
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(in2->dtype)
+    uint8_t dtype = (uint8_t)args[3].u_int;
+    if((dtype != NDARRAY_FLOAT) && (dtype != NDARRAY_INT16)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("dtype must be float, or int16"));
+    }
+
+    signal_convolve2d_t conv;
+    size_t height = image->shape[ULAB_MAX_DIMS - 2];
+    size_t width = image->shape[ULAB_MAX_DIMS - 1];
+    size_t kh = in2->shape[ULAB_MAX_DIMS - 2];
+    size_t kw = in2->shape[ULAB_MAX_DIMS - 1];
+
+    if(!mp_obj_is_str(args[2].u_obj)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("mode must be a string"));
+    }
+    GET_STR_DATA_LEN(args[2].u_obj, mode, modelen);
+    conv.oh = height + kh - 1;
+    conv.ow = width + kw - 1;
+    conv.r0 = 0;
+    conv.c0 = 0;
+    if((modelen == 4) && (memcmp(mode, "same", 4) == 0)) {
+        conv.oh = height;
+        conv.ow = width;
+        conv.r0 = (kh - 1) / 2;
+        conv.c0 = (kw - 1) / 2;
+    } else if((modelen == 5) && (memcmp(mode, "valid", 5) == 0)) {
+        if((kh > height) || (kw > width)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("in2 must not be larger than in1 in 'valid' mode"));
+        }
+        conv.oh = height - kh + 1;
+        conv.ow = width - kw + 1;
+        conv.r0 = kh - 1;
+        conv.c0 = kw - 1;
+    } else if((modelen != 4) || (memcmp(mode, "full", 4) != 0)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("mode must be 'full', 'same', or 'valid'"));
+    }
+
+    // the kernel is read once, flipped, if necessary, and stored in the working type; the
+    // configured dtype, and the 16-bit integers are accumulated in 32 bits exactly, provided that
+    // the output cannot overflow, otherwise, in floats
+    mp_float_t *fkernel = m_new(mp_float_t, kh * kw);
+    mp_float_t kmax = MICROPY_FLOAT_CONST(0.0);
+    mp_float_t ksum = MICROPY_FLOAT_CONST(0.0);
+    size_t pr = 0, pc = 0;
+    uint8_t *array = (uint8_t *)in2->array;
+    mp_float_t (*func)(void *) = ndarray_get_float_function(in2->dtype);
+    for(size_t i = 0; i < kh; i++) {
+        for(size_t j = 0; j < kw; j++) {
+            uint8_t *item = array + i * in2->strides[ULAB_MAX_DIMS - 2] + j * in2->strides[ULAB_MAX_DIMS - 1];
+            mp_float_t value = func(item);
+            size_t index = flip ? (kh - 1 - i) * kw + (kw - 1 - j) : i * kw + j;
+            fkernel[index] = value;
+            mp_float_t abs_value = MICROPY_FLOAT_C_FUN(fabs)(value);
+            ksum += abs_value;
+            if(abs_value > kmax) {
+                kmax = abs_value;
+                pr = index / kw;
+                pc = index % kw;
+            }
+        }
+    }
+
+    // the kernel is separable, if it is the outer product of its column, and its row through the pivot;
+    // integer kernels are checked exactly, because the integer sums are divided by the pivot
+    conv.separable = (kh > 1) && (kw > 1) && (kmax > MICROPY_FLOAT_CONST(0.0));
+    bool integer_kernel = signal_is_integer(in2->dtype);
+    mp_float_t pivot = fkernel[pr * kw + pc];
+    mp_float_t usum = MICROPY_FLOAT_CONST(0.0);
+    mp_float_t vsum = MICROPY_FLOAT_CONST(0.0);
+    for(size_t i = 0; conv.separable && (i < kh); i++) {
+        usum += MICROPY_FLOAT_C_FUN(fabs)(fkernel[i * kw + pc]);
+        for(size_t j = 0; j < kw; j++) {
+            mp_float_t a = fkernel[i * kw + j];
+            mp_float_t b = fkernel[i * kw + pc];
+            mp_float_t c = fkernel[pr * kw + j];
+            if(integer_kernel) {
+                conv.separable = (int64_t)a * (int64_t)pivot == (int64_t)b * (int64_t)c;
+            } else {
+                conv.separable = MICROPY_FLOAT_C_FUN(fabs)(a * pivot - b * c) <= SIGNAL_SEPARABLE_EPSILON * kmax * kmax;
+            }
+            if(!conv.separable) {
+                break;
+            }
+        }
+    }
+    for(size_t j = 0; conv.separable && (j < kw); j++) {
+        vsum += MICROPY_FLOAT_C_FUN(fabs)(fkernel[pr * kw + j]);
+    }
+
+    bool integer = signal_is_integer(image->dtype) && integer_kernel;
+    mp_float_t bound = integer ? (mp_float_t)signal_integer_max(image->dtype) : MICROPY_FLOAT_CONST(0.0);
+    if(integer && conv.separable && (bound * usum * vsum > (mp_float_t)INT32_MAX)) {
+        // the rows filtered by v could overflow, while the direct sums might not
+        conv.separable = false;
+    }
+    if(integer && (bound * ksum > (mp_float_t)INT32_MAX)) {
+        integer = false;
+    }
+
+    size_t klen = conv.separable ? kh + kw : kh * kw;
+    conv.divisor = 1;
+    if(integer) {
+        int32_t *ikernel = m_new(int32_t, klen);
+        if(conv.separable) {
+            // the column, and the row are exact integers, and the sums are divided by the pivot at the end
+            for(size_t i = 0; i < kh; i++) {
+                ikernel[i] = (int32_t)fkernel[i * kw + pc];
+            }
+            for(size_t j = 0; j < kw; j++) {
+                ikernel[kh + j] = (int32_t)fkernel[pr * kw + j];
+            }
+            conv.divisor = (int32_t)pivot;
+        } else {
+            for(size_t i = 0; i < klen; i++) {
+                ikernel[i] = (int32_t)fkernel[i];
+            }
+        }
+        conv.kernel = ikernel;
+    } else {
+        mp_float_t *kernel = m_new(mp_float_t, klen);
+        if(conv.separable) {
+            for(size_t i = 0; i < kh; i++) {
+                kernel[i] = fkernel[i * kw + pc] / pivot;
+            }
+            for(size_t j = 0; j < kw; j++) {
+                kernel[kh + j] = fkernel[pr * kw + j];
+            }
+        } else {
+            memcpy(kernel, fkernel, klen * sizeof(mp_float_t));
+        }
+        conv.kernel = kernel;
+    }
+    m_del(mp_float_t, fkernel, kh * kw);
+
+    conv.image = image;
+    conv.kh = kh;
+    conv.kw = kw;
+    size_t shape[ULAB_MAX_DIMS] = { 0 };
+    shape[ULAB_MAX_DIMS - 2] = conv.oh;
+    shape[ULAB_MAX_DIMS - 1] = conv.ow;
+    conv.results = ndarray_new_dense_ndarray(2, shape, dtype);
+
+    size_t lw = conv.ow + kw - 1;
+    size_t rlen = kh * (conv.separable ? conv.ow : lw) + lw;
+    size_t rsize = rlen * (integer ? sizeof(int32_t) : sizeof(mp_float_t));
+    conv.ring = ulab_scratch_new(uint8_t, rsize);
+
+    // the output, and the ring have been allocated, and the kernels do not touch python objects
+    bool released = ulab_gil_exit(conv.oh * conv.ow * klen);
+    if(integer) {
+        signal_convolve2d_int32_t(&conv);
+    } else {
+        signal_convolve2d_mp_float_t(&conv);
+    }
+    ulab_gil_enter(released);
+    ulab_scratch_del(uint8_t, conv.ring, rsize);
+    return MP_OBJ_FROM_PTR(conv.results);
+}
+
+//| def convolve2d(
+//|     in1: ulab.numpy.ndarray,
+//|     in2: ulab.numpy.ndarray,
+//|     mode: str = "full",
+//|     *,
+//|     dtype: _DType = ulab.numpy.float
+//| ) -> ulab.numpy.ndarray:
+//|     """
+//|     :param ulab.numpy.ndarray in1: the two-dimensional input, e.g., an image
+//|     :param ulab.numpy.ndarray in2: the two-dimensional kernel
+//|     :param str mode: one of 'full', 'same', or 'valid'
+//|     :param dtype: the dtype of the output, float, or int16; integers are rounded, and saturated
+//|
+//|     Convolve in1 with in2. The samples outside in1 are 0. Separable kernels are applied
+//|     in two one-dimensional passes, and integer inputs are accumulated in integers."""
+//|     ...
+//|
+
+static mp_obj_t signal_convolve2d(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    return signal_convolve2d_correlate2d(n_args, pos_args, kw_args, true);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(signal_convolve2d_obj, 2, signal_convolve2d);
+
+//| def correlate2d(
+//|     in1: ulab.numpy.ndarray,
+//|     in2: ulab.numpy.ndarray,
+//|     mode: str = "full",
+//|     *,
+//|     dtype: _DType = ulab.numpy.float
+//| ) -> ulab.numpy.ndarray:
+//|     """
+//|     :param ulab.numpy.ndarray in1: the two-dimensional input, e.g., an image
+//|     :param ulab.numpy.ndarray in2: the two-dimensional kernel
+//|     :param str mode: one of 'full', 'same', or 'valid'
+//|     :param dtype: the dtype of the output, float, or int16; integers are rounded, and saturated
+//|
+//|     Cross-correlate in1 with in2. The arguments are the same as those of convolve2d."""
+//|     ...
+//|
+
+static mp_obj_t signal_correlate2d(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    return signal_convolve2d_correlate2d(n_args, pos_args, kw_args, false);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(signal_correlate2d_obj, 2, signal_correlate2d);
+#endif /* ULAB_SCIPY_SIGNAL_HAS_CONVOLVE2D */
 
 #if ULAB_SCIPY_SIGNAL_HAS_SOSFILT & ULAB_MAX_DIMS > 1
-static void signal_sosfilt_array(mp_float_t *x, const mp_float_t *coeffs, mp_float_t *zf, const size_t len) {
-    for(size_t i=0; i < len; i++) {
+static void signal_sosfilt_array(mp_float_t *x, const int32_t stride, const size_t len, const mp_float_t *coeffs, mp_float_t *zf, const size_t lensos) {
+    if((stride == 1) && ulab_dsp_biquad(x, len, coeffs, zf, lensos)) {
+        return;
+    }
+    // the cascade is fused: each sample is pushed through all sections, before the next one is
+    // loaded, hence the data are traversed once, and not once per section
+    for(size_t i = 0; i < len; i++) {
         mp_float_t xn = *x;
-        *x = coeffs[0] * xn + zf[0];
-        zf[0] = zf[1] + coeffs[1] * xn - coeffs[4] * *x;
-        zf[1] = coeffs[2] * xn - coeffs[5] * *x;
-        x++;
+        const mp_float_t *c = coeffs;
+        mp_float_t *z = zf;
+        for(size_t s = 0; s < lensos; s++) {
+            mp_float_t yn = c[0] * xn + z[0];
+            z[0] = z[1] + c[1] * xn - c[4] * yn;
+            z[1] = c[2] * xn - c[5] * yn;
+            xn = yn;
+            c += 6;
+            z += 2;
+        }
+        *x = xn;
+        x += stride;
     }
-    x -= len;
 }
 
+// the state of the channels of sosfilt; each channel has its own delays in z
+typedef struct _signal_sosfilt_t {
+    mp_float_t *y;
+    int32_t stride;
+    int32_t cstride;
+    size_t len;
+    const mp_float_t *coeffs;
+    mp_float_t *z;
+    size_t lensos;
+} signal_sosfilt_t;
+
+static void signal_sosfilt_kernel(void *context, size_t start, size_t end, uint8_t core) {
+    (void)core;
+    signal_sosfilt_t *filter = (signal_sosfilt_t *)context;
+    for(size_t ch = start; ch < end; ch++) {
+        signal_sosfilt_array(filter->y + ch * filter->cstride, filter->stride, filter->len, filter->coeffs,
+                            filter->z + 2 * filter->lensos * ch, filter->lensos);
+    }
+}
+
+#if ULAB_SUPPORTS_Q15
+static void signal_sosfilt_q15_array(int16_t *x, const int32_t stride, const size_t len, const int16_t *coeffs, const uint8_t *shifts, int16_t *state, const size_t lensos) {
+    // direct form I biquads: the delay lines hold the inputs, and outputs of each section,
+    // hence the state cannot overflow, and only the output of a section has to be saturated
+    for(size_t i = 0; i < len; i++) {
+        int32_t xn = *x;
+        const int16_t *c = coeffs;
+        int16_t *z = state;
+        for(size_t s = 0; s < lensos; s++) {
+            int64_t accum = (int64_t)c[0] * xn + (int64_t)c[1] * z[0] + (int64_t)c[2] * z[1]
+                            - (int64_t)c[3] * z[2] - (int64_t)c[4] * z[3];
+            uint8_t q = 15 - shifts[s];
+            if(q > 0) {
+                accum += (int64_t)1 << (q - 1);
+            }
+            int16_t yn = TOOLS_Q15_SATURATE(accum >> q);
+            z[1] = z[0];
+            z[0] = (int16_t)xn;
+            z[3] = z[2];
+            z[2] = yn;
+            xn = yn;
+            c += 5;
+            z += 4;
+        }
+        *x = (int16_t)xn;
+        x += stride;
+    }
+}
+
+static mp_obj_t signal_sosfilt_q15(mp_obj_t sos, mp_obj_t x, mp_obj_t axis, mp_obj_t out) {
+    if(!mp_obj_is_type(x, &ulab_ndarray_type) || (((ndarray_obj_t *)MP_OBJ_TO_PTR(x))->dtype != NDARRAY_INT16)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("fixed-point sosfilt requires an int16 array"));
+    }
+    ndarray_obj_t *inarray = MP_OBJ_TO_PTR(x);
+    if(inarray->ndim > 2) {
+        mp_raise_ValueError(MP_ERROR_TEXT("input must be one-, or two-dimensional"));
+    }
+    ndarray_obj_t *y;
+    if(out == mp_const_none) {
+        y = ndarray_new_dense_ndarray(inarray->ndim, inarray->shape, NDARRAY_INT16);
+    } else {
+        y = tools_get_out_array(out, inarray->ndim, inarray->shape, NDARRAY_INT16);
+    }
+    if(y != inarray) {
+        uint8_t *iarray = (uint8_t *)inarray->array;
+        uint8_t *yarray = (uint8_t *)y->array;
+        size_t rows = inarray->ndim == 2 ? inarray->shape[ULAB_MAX_DIMS - 2] : 1;
+        for(size_t j = 0; j < rows; j++) {
+            uint8_t *irow = iarray + j * inarray->strides[ULAB_MAX_DIMS - 2];
+            uint8_t *yrow = yarray + j * y->strides[ULAB_MAX_DIMS - 2];
+            for(size_t i = 0; i < inarray->shape[ULAB_MAX_DIMS - 1]; i++) {
+                *((int16_t *)yrow) = *((int16_t *)irow);
+                irow += inarray->strides[ULAB_MAX_DIMS - 1];
+                yrow += y->strides[ULAB_MAX_DIMS - 1];
+            }
+        }
+    }
+
+    int8_t ax = tools_get_axis(axis, y->ndim);
+    size_t len = y->shape[ULAB_MAX_DIMS - y->ndim + ax];
+    int32_t stride = y->strides[ULAB_MAX_DIMS - y->ndim + ax] / (int32_t)sizeof(int16_t);
+    size_t nchannels = 1;
+    int32_t cstride = 0;
+    if(y->ndim == 2) {
+        nchannels = y->shape[ULAB_MAX_DIMS - 1 - ax];
+        cstride = y->strides[ULAB_MAX_DIMS - 1 - ax] / (int32_t)sizeof(int16_t);
+    }
+
+    // the coefficients of each section are converted once, to Q(15 - shift), where shift
+    // is the smallest number, for which all coefficients of the section are representable
+    size_t lensos = (size_t)mp_obj_get_int(mp_obj_len_maybe(sos));
+    int16_t *coeffs = m_new(int16_t, 5 * lensos);
+    uint8_t *shifts = m_new(uint8_t, lensos);
+    mp_float_t row[6];
+    mp_obj_iter_buf_t iter_buf;
+    mp_obj_t item, iterable = mp_getiter(sos, &iter_buf);
+    for(size_t s = 0; (item = mp_iternext(iterable)) != MP_OBJ_STOP_ITERATION; s++) {
+        if(mp_obj_get_int(mp_obj_len_maybe(item)) != 6) {
+            mp_raise_ValueError(MP_ERROR_TEXT("sos array must be of shape (n_section, 6)"));
+        }
+        fill_array_iterable(row, item);
+        if(row[3] != MICROPY_FLOAT_CONST(1.0)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("sos[:, 3] should be all ones"));
+        }
+        // the order of the coefficients is b0, b1, b2, a1, a2
+        row[3] = row[4];
+        row[4] = row[5];
+        mp_float_t largest = MICROPY_FLOAT_CONST(0.0);
+        for(uint8_t k = 0; k < 5; k++) {
+            largest = MAX(largest, MICROPY_FLOAT_C_FUN(fabs)(row[k]));
+        }
+        uint8_t shift = 0;
+        while(largest * (mp_float_t)(1 << (15 - shift)) >= MICROPY_FLOAT_CONST(32767.5)) {
+            if(++shift > 15) {
+                mp_raise_ValueError(MP_ERROR_TEXT("sos coefficients are too large for fixed-point arithmetic"));
+            }
+        }
+        shifts[s] = shift;
+        for(uint8_t k = 0; k < 5; k++) {
+            coeffs[5 * s + k] = (int16_t)MICROPY_FLOAT_C_FUN(floor)(row[k] * (mp_float_t)(1 << (15 - shift)) + MICROPY_FLOAT_CONST(0.5));
+        }
+    }
+
+    int16_t *state = m_new(int16_t, 4 * lensos);
+    for(size_t ch = 0; ch < nchannels; ch++) {
+        memset(state, 0, 4 * lensos * sizeof(int16_t));
+        signal_sosfilt_q15_array((int16_t *)y->array + ch * cstride, stride, len, coeffs, shifts, state, lensos);
+    }
+    m_del(int16_t, state, 4 * lensos);
+    m_del(uint8_t, shifts, lensos);
+    m_del(int16_t, coeffs, 5 * lensos);
+    return MP_OBJ_FROM_PTR(y);
+}
+#endif /* ULAB_SUPPORTS_Q15 */
+
 mp_obj_t signal_sosfilt(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_sos, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
         { MP_QSTR_x, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_axis, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_INT(-1) } },
         { MP_QSTR_zi, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_out, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        #if ULAB_SUPPORTS_Q15
+        { MP_QSTR_dtype, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = NDARRAY_FLOAT } },
+        #endif
     };
 
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
@@ -45,69 +601,168 @@ mp_obj_t signal_sosfilt(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_ar
     if(!ndarray_object_is_array_like(args[0].u_obj) || !ndarray_object_is_array_like(args[1].u_obj)) {
         mp_raise_TypeError(MP_ERROR_TEXT("sosfilt requires iterable arguments"));
     }
-    #if ULAB_SUPPORTS_COMPLEX
-    if(mp_obj_is_type(args[1].u_obj, &ulab_ndarray_type)) {
-        ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(args[1].u_obj);
-        COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+
+    #if ULAB_SUPPORTS_Q15
+    if(args[5].u_int == NDARRAY_INT16) {
+        if(args[3].u_obj != mp_const_none) {
+            mp_raise_ValueError(MP_ERROR_TEXT("zi is not supported in fixed-point mode"));
+        }
+        return signal_sosfilt_q15(args[0].u_obj, args[1].u_obj, args[2].u_obj, args[4].u_obj);
+    } else if(args[5].u_int != NDARRAY_FLOAT) {
+        mp_raise_ValueError(MP_ERROR_TEXT("dtype must be float, or int16"));
     }
     #endif
-    size_t lenx = (size_t)mp_obj_get_int(mp_obj_len_maybe(args[1].u_obj));
-    ndarray_obj_t *y = ndarray_new_linear_array(lenx, NDARRAY_FLOAT);
-    mp_float_t *yarray = (mp_float_t *)y->array;
-    mp_float_t coeffs[6];
+
+    ndarray_obj_t *y;
     if(mp_obj_is_type(args[1].u_obj, &ulab_ndarray_type)) {
         ndarray_obj_t *inarray = MP_OBJ_TO_PTR(args[1].u_obj);
-        #if ULAB_MAX_DIMS > 1
-        if(inarray->ndim > 1) {
-            mp_raise_ValueError(MP_ERROR_TEXT("input must be one-dimensional"));
+        COMPLEX_DTYPE_NOT_IMPLEMENTED(inarray->dtype)
+        if(inarray->ndim > 2) {
+            mp_raise_ValueError(MP_ERROR_TEXT("input must be one-, or two-dimensional"));
         }
-        #endif
-        uint8_t *iarray = (uint8_t *)inarray->array;
-        for(size_t i=0; i < lenx; i++) {
-            *yarray++ = ndarray_get_float_value(iarray, inarray->dtype);
-            iarray += inarray->strides[ULAB_MAX_DIMS - 1];
+        if(args[4].u_obj == mp_const_none) {
+            y = ndarray_new_dense_ndarray(inarray->ndim, inarray->shape, NDARRAY_FLOAT);
+        } else {
+            y = tools_get_out_array(args[4].u_obj, inarray->ndim, inarray->shape, NDARRAY_FLOAT);
+        }
+        // with out=x, the data are filtered in place, otherwise, the input is copied first
+        if(y != inarray) {
+            mp_float_t (*func)(void *) = ndarray_get_float_function(inarray->dtype);
+            uint8_t *iarray = (uint8_t *)inarray->array;
+            uint8_t *yarray = (uint8_t *)y->array;
+            size_t rows = inarray->ndim == 2 ? inarray->shape[ULAB_MAX_DIMS - 2] : 1;
+            for(size_t j = 0; j < rows; j++) {
+                uint8_t *irow = iarray + j * inarray->strides[ULAB_MAX_DIMS - 2];
+                uint8_t *yrow = yarray + j * y->strides[ULAB_MAX_DIMS - 2];
+                for(size_t i = 0; i < inarray->shape[ULAB_MAX_DIMS - 1]; i++) {
+                    *((mp_float_t *)yrow) = func(irow);
+                    irow += inarray->strides[ULAB_MAX_DIMS - 1];
+                    yrow += y->strides[ULAB_MAX_DIMS - 1];
+                }
+            }
         }
-        yarray -= lenx;
     } else {
-        fill_array_iterable(yarray, args[1].u_obj);
+        size_t lenx = (size_t)mp_obj_get_int(mp_obj_len_maybe(args[1].u_obj));
+        if(args[4].u_obj == mp_const_none) {
+            y = ndarray_new_linear_array(lenx, NDARRAY_FLOAT);
+        } else {
+            size_t *shape = ndarray_shape_vector(0, 0, 0, lenx);
+            y = tools_get_out_array(args[4].u_obj, 1, shape, NDARRAY_FLOAT);
+            m_del(size_t, shape, ULAB_MAX_DIMS);
+        }
+        if(y->strides[ULAB_MAX_DIMS - 1] == sizeof(mp_float_t)) {
+            fill_array_iterable((mp_float_t *)y->array, args[1].u_obj);
+        } else {
+            mp_obj_iter_buf_t x_buf;
+            mp_obj_t x_item, x_iterable = mp_getiter(args[1].u_obj, &x_buf);
+            uint8_t *yarray = (uint8_t *)y->array;
+            while((x_item = mp_iternext(x_iterable)) != MP_OBJ_STOP_ITERATION) {
+                *((mp_float_t *)yarray) = mp_obj_get_float(x_item);
+                yarray += y->strides[ULAB_MAX_DIMS - 1];
+            }
+        }
+    }
+
+    // the signals are filtered along axis, and there are nchannels of them
+    int8_t ax = tools_get_axis(args[2].u_obj, y->ndim);
+    size_t len = y->shape[ULAB_MAX_DIMS - y->ndim + ax];
+    int32_t stride = y->strides[ULAB_MAX_DIMS - y->ndim + ax] / (int32_t)sizeof(mp_float_t);
+    size_t nchannels = 1;
+    int32_t cstride = 0;
+    if(y->ndim == 2) {
+        nchannels = y->shape[ULAB_MAX_DIMS - 1 - ax];
+        cstride = y->strides[ULAB_MAX_DIMS - 1 - ax] / (int32_t)sizeof(mp_float_t);
     }
 
+    size_t lensos = (size_t)mp_obj_get_int(mp_obj_len_maybe(args[0].u_obj));
+    mp_float_t *coeffs = m_new(mp_float_t, 6 * lensos);
     mp_obj_iter_buf_t iter_buf;
     mp_obj_t item, iterable = mp_getiter(args[0].u_obj, &iter_buf);
-    size_t lensos = (size_t)mp_obj_get_int(mp_obj_len_maybe(args[0].u_obj));
-
-    size_t *shape = ndarray_shape_vector(0, 0, lensos, 2);
-    ndarray_obj_t *zf = ndarray_new_dense_ndarray(2, shape, NDARRAY_FLOAT);
-    mp_float_t *zf_array = (mp_float_t *)zf->array;
+    mp_float_t *c = coeffs;
+    while((item = mp_iternext(iterable)) != MP_OBJ_STOP_ITERATION) {
+        if(mp_obj_get_int(mp_obj_len_maybe(item)) != 6) {
+            mp_raise_ValueError(MP_ERROR_TEXT("sos array must be of shape (n_section, 6)"));
+        }
+        fill_array_iterable(c, item);
+        if(c[3] != MICROPY_FLOAT_CONST(1.0)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("sos[:, 3] should be all ones"));
+        }
+        c += 6;
+    }
 
-    if(args[2].u_obj != mp_const_none) {
-        if(!mp_obj_is_type(args[2].u_obj, &ulab_ndarray_type)) {
+    // zi, and zf are of shape (n_section, 2) for one-dimensional,
+    // and (n_section, n_channel, 2) for two-dimensional inputs
+    ndarray_obj_t *zi = NULL;
+    ndarray_obj_t *zf = NULL;
+    if(args[3].u_obj != mp_const_none) {
+        if(!mp_obj_is_type(args[3].u_obj, &ulab_ndarray_type)) {
             mp_raise_TypeError(MP_ERROR_TEXT("zi must be an ndarray"));
-        } else {
-            ndarray_obj_t *zi = MP_OBJ_TO_PTR(args[2].u_obj);
-            if((zi->shape[ULAB_MAX_DIMS - 2] != lensos) || (zi->shape[ULAB_MAX_DIMS - 1] != 2)) {
+        }
+        zi = MP_OBJ_TO_PTR(args[3].u_obj);
+        if(zi->dtype != NDARRAY_FLOAT) {
+            mp_raise_ValueError(MP_ERROR_TEXT("zi must be of float type"));
+        }
+        if(y->ndim == 1) {
+            if((zi->ndim != 2) || (zi->shape[ULAB_MAX_DIMS - 2] != lensos) || (zi->shape[ULAB_MAX_DIMS - 1] != 2)) {
                 mp_raise_ValueError(MP_ERROR_TEXT("zi must be of shape (n_section, 2)"));
             }
-            if(zi->dtype != NDARRAY_FLOAT) {
-                mp_raise_ValueError(MP_ERROR_TEXT("zi must be of float type"));
+            size_t *shape = ndarray_shape_vector(0, 0, lensos, 2);
+            zf = ndarray_new_dense_ndarray(2, shape, NDARRAY_FLOAT);
+        } else {
+            #if ULAB_MAX_DIMS > 2
+            if((zi->ndim != 3) || (zi->shape[ULAB_MAX_DIMS - 3] != lensos) ||
+                (zi->shape[ULAB_MAX_DIMS - 2] != nchannels) || (zi->shape[ULAB_MAX_DIMS - 1] != 2)) {
+                mp_raise_ValueError(MP_ERROR_TEXT("zi must be of shape (n_section, n_channel, 2)"));
             }
-            // TODO: this won't work with sparse arrays
-            memcpy(zf_array, zi->array, 2*lensos*sizeof(mp_float_t));
+            size_t *shape = ndarray_shape_vector(0, lensos, nchannels, 2);
+            zf = ndarray_new_dense_ndarray(3, shape, NDARRAY_FLOAT);
+            #else
+            mp_raise_ValueError(MP_ERROR_TEXT("zi requires one-dimensional input"));
+            #endif
         }
     }
-    while((item = mp_iternext(iterable)) != MP_OBJ_STOP_ITERATION) {
-        if(mp_obj_get_int(mp_obj_len_maybe(item)) != 6) {
-            mp_raise_ValueError(MP_ERROR_TEXT("sos array must be of shape (n_section, 6)"));
-        } else {
-            fill_array_iterable(coeffs, item);
-            if(coeffs[3] != MICROPY_FLOAT_CONST(1.0)) {
-                mp_raise_ValueError(MP_ERROR_TEXT("sos[:, 3] should be all ones"));
+
+    // the delays of each channel are kept contiguous in z, so that the channels can be filtered independently
+    mp_float_t *z = m_new0(mp_float_t, 2 * lensos * nchannels);
+    if(zi != NULL) {
+        for(size_t ch = 0; ch < nchannels; ch++) {
+            // the section stride is the stride of the first axis of zi, the channel stride that of the second one
+            uint8_t *ziarray = (uint8_t *)zi->array;
+            if(y->ndim == 2) {
+                ziarray += ch * zi->strides[ULAB_MAX_DIMS - 2];
+            }
+            mp_float_t *zch = z + 2 * lensos * ch;
+            for(size_t s = 0; s < lensos; s++) {
+                zch[2 * s] = *((mp_float_t *)(ziarray + s * zi->strides[ULAB_MAX_DIMS - zi->ndim]));
+                zch[2 * s + 1] = *((mp_float_t *)(ziarray + s * zi->strides[ULAB_MAX_DIMS - zi->ndim] + zi->strides[ULAB_MAX_DIMS - 1]));
             }
-            signal_sosfilt_array(yarray, coeffs, zf_array, lenx);
-            zf_array += 2;
         }
     }
-    if(args[2].u_obj == mp_const_none) {
+    signal_sosfilt_t filter = {
+        .y = (mp_float_t *)y->array,
+        .stride = stride,
+        .cstride = cstride,
+        .len = len,
+        .coeffs = coeffs,
+        .z = z,
+        .lensos = lensos,
+    };
+    // the DSP backend allocates its state on the heap, hence it can be called on the calling core only
+    ulab_parallel_for(signal_sosfilt_kernel, &filter, nchannels, ULAB_DSP_BACKEND == ULAB_DSP_BACKEND_NONE ? len * lensos : 0);
+    if(zf != NULL) {
+        mp_float_t *zfarray = (mp_float_t *)zf->array;
+        for(size_t ch = 0; ch < nchannels; ch++) {
+            mp_float_t *zch = z + 2 * lensos * ch;
+            for(size_t s = 0; s < lensos; s++) {
+                zfarray[2 * (s * nchannels + ch)] = zch[2 * s];
+                zfarray[2 * (s * nchannels + ch) + 1] = zch[2 * s + 1];
+            }
+        }
+    }
+    m_del(mp_float_t, z, 2 * lensos * nchannels);
+    m_del(mp_float_t, coeffs, 6 * lensos);
+
+    if(zf == NULL) {
         return MP_OBJ_FROM_PTR(y);
     } else {
         mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(mp_obj_new_tuple(2, NULL));
@@ -120,10 +775,998 @@ mp_obj_t signal_sosfilt(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_ar
 MP_DEFINE_CONST_FUN_OBJ_KW(signal_sosfilt_obj, 2, signal_sosfilt);
 #endif /* ULAB_SCIPY_SIGNAL_HAS_SOSFILT */
 
+#if ULAB_SCIPY_SIGNAL_HAS_LFILTER_STREAM
+static mp_obj_t signal_lfilter_stream_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    (void) type;
+    mp_arg_check_num(n_args, n_kw, 1, 2, true);
+    mp_map_t kw_args;
+    mp_map_init_fixed_table(&kw_args, n_kw, args + n_args);
+
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_b, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_a, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+    };
+    mp_arg_val_t _args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, args, &kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, _args);
+
+    if(!ndarray_object_is_array_like(_args[0].u_obj) ||
+        ((_args[1].u_obj != mp_const_none) && !ndarray_object_is_array_like(_args[1].u_obj))) {
+        mp_raise_TypeError(MP_ERROR_TEXT("lfilter_stream requires iterable arguments"));
+    }
+    size_t nb = (size_t)mp_obj_get_int(mp_obj_len_maybe(_args[0].u_obj));
+    size_t na = 1;
+    if(_args[1].u_obj != mp_const_none) {
+        na = (size_t)mp_obj_get_int(mp_obj_len_maybe(_args[1].u_obj));
+    }
+    if((nb == 0) || (na == 0)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("filter coefficients must not be empty"));
+    }
+    if((nb > UINT16_MAX) || (na > UINT16_MAX)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("too many filter coefficients"));
+    }
+
+    signal_lfilter_stream_obj_t *self = m_new_obj(signal_lfilter_stream_obj_t);
+    self->base.type = &signal_lfilter_stream_type;
+    self->nb = nb;
+    self->na = na - 1;
+    self->xpos = 0;
+    self->ypos = 0;
+    // a single allocation holds the coefficients, and the two ring buffers; the a[0] slot
+    // of the feed-back coefficients is dropped after the normalisation
+    mp_float_t *buffer = m_new0(mp_float_t, 3 * nb + 3 * na);
+    self->b = buffer;
+    self->a = buffer + nb;
+    self->x = self->a + na;
+    self->y = self->x + 2 * nb;
+
+    fill_array_iterable(self->b, _args[0].u_obj);
+    mp_float_t a0 = MICROPY_FLOAT_CONST(1.0);
+    if(_args[1].u_obj != mp_const_none) {
+        fill_array_iterable(self->a, _args[1].u_obj);
+        a0 = self->a[0];
+        if(a0 == MICROPY_FLOAT_CONST(0.0)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("a[0] must not be zero"));
+        }
+    }
+    for(size_t i = 0; i < nb; i++) {
+        self->b[i] /= a0;
+    }
+    for(size_t i = 0; i < na - 1; i++) {
+        self->a[i] = self->a[i + 1] / a0;
+    }
+    return MP_OBJ_FROM_PTR(self);
+}
+
+static inline mp_float_t signal_lfilter_stream_sample(signal_lfilter_stream_obj_t *self, mp_float_t xn) {
+    // direct form I: the ring buffers hold x[n], ..., x[n - nb + 1], and y[n - 1], ..., y[n - na]
+    if(self->xpos == 0) {
+        self->xpos = self->nb;
+    }
+    self->xpos--;
+    self->x[self->xpos] = self->x[self->xpos + self->nb] = xn;
+
+    mp_float_t *x = self->x + self->xpos;
+    mp_float_t yn = MICROPY_FLOAT_CONST(0.0);
+    for(uint16_t k = 0; k < self->nb; k++) {
+        yn += self->b[k] * x[k];
+    }
+    if(self->na) {
+        mp_float_t *y = self->y + self->ypos;
+        for(uint16_t k = 0; k < self->na; k++) {
+            yn -= self->a[k] * y[k];
+        }
+        if(self->ypos == 0) {
+            self->ypos = self->na;
+        }
+        self->ypos--;
+        self->y[self->ypos] = self->y[self->ypos + self->na] = yn;
+    }
+    return yn;
+}
+
+static mp_obj_t signal_lfilter_stream_filter(mp_obj_t self_in, mp_obj_t x_in) {
+    signal_lfilter_stream_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    if(!ndarray_object_is_array_like(x_in)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("input must be an iterable"));
+    }
+    if(mp_obj_is_type(x_in, &ulab_ndarray_type)) {
+        ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(x_in);
+        #if ULAB_MAX_DIMS > 1
+        if(ndarray->ndim > 1) {
+            mp_raise_ValueError(MP_ERROR_TEXT("input must be one-dimensional"));
+        }
+        #endif
+        COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+        uint8_t *array = (uint8_t *)ndarray->array;
+        if(ndarray->dtype == NDARRAY_FLOAT) {
+            // float arrays are filtered in place, so that no memory is allocated per block
+            for(size_t i = 0; i < ndarray->len; i++) {
+                mp_float_t *value = (mp_float_t *)array;
+                *value = signal_lfilter_stream_sample(self, *value);
+                array += ndarray->strides[ULAB_MAX_DIMS - 1];
+            }
+            return x_in;
+        }
+        ndarray_obj_t *results = ndarray_new_linear_array(ndarray->len, NDARRAY_FLOAT);
+        mp_float_t *rarray = (mp_float_t *)results->array;
+        mp_float_t (*func)(void *) = ndarray_get_float_function(ndarray->dtype);
+        for(size_t i = 0; i < ndarray->len; i++) {
+            *rarray++ = signal_lfilter_stream_sample(self, func(array));
+            array += ndarray->strides[ULAB_MAX_DIMS - 1];
+        }
+        return MP_OBJ_FROM_PTR(results);
+    }
+
+    size_t len = (size_t)mp_obj_get_int(mp_obj_len_maybe(x_in));
+    ndarray_obj_t *results = ndarray_new_linear_array(len, NDARRAY_FLOAT);
+    mp_float_t *rarray = (mp_float_t *)results->array;
+    fill_array_iterable(rarray, x_in);
+    for(size_t i = 0; i < len; i++) {
+        rarray[i] = signal_lfilter_stream_sample(self, rarray[i]);
+    }
+    return MP_OBJ_FROM_PTR(results);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_2(signal_lfilter_stream_filter_obj, signal_lfilter_stream_filter);
+
+static mp_obj_t signal_lfilter_stream_reset(mp_obj_t self_in) {
+    signal_lfilter_stream_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    memset(self->x, 0, 2 * (self->nb + self->na) * sizeof(mp_float_t));
+    self->xpos = 0;
+    self->ypos = 0;
+    return mp_const_none;
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(signal_lfilter_stream_reset_obj, signal_lfilter_stream_reset);
+
+static void signal_lfilter_stream_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    (void)kind;
+    signal_lfilter_stream_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_printf(print, "lfilter_stream(%d, %d)", self->nb, self->na + 1);
+}
+
+static const mp_rom_map_elem_t signal_lfilter_stream_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_filter), MP_ROM_PTR(&signal_lfilter_stream_filter_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&signal_lfilter_stream_reset_obj) },
+};
+
+static MP_DEFINE_CONST_DICT(signal_lfilter_stream_locals_dict, signal_lfilter_stream_locals_dict_table);
+
+#if defined(MP_DEFINE_CONST_OBJ_TYPE)
+MP_DEFINE_CONST_OBJ_TYPE(
+    signal_lfilter_stream_type,
+    MP_QSTR_lfilter_stream,
+    MP_TYPE_FLAG_NONE,
+    make_new, signal_lfilter_stream_make_new,
+    print, signal_lfilter_stream_print,
+    locals_dict, &signal_lfilter_stream_locals_dict
+);
+#else
+const mp_obj_type_t signal_lfilter_stream_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_lfilter_stream,
+    .make_new = signal_lfilter_stream_make_new,
+    .print = signal_lfilter_stream_print,
+    .locals_dict = (mp_obj_dict_t*)&signal_lfilter_stream_locals_dict,
+};
+#endif
+#endif /* ULAB_SCIPY_SIGNAL_HAS_LFILTER_STREAM */
+
+#if ULAB_SCIPY_SIGNAL_HAS_WELCH | ULAB_SCIPY_SIGNAL_HAS_STFT | ULAB_SCIPY_SIGNAL_HAS_RESAMPLE_POLY | ULAB_SCIPY_SIGNAL_HAS_DECIMATE | ULAB_SCIPY_SIGNAL_HAS_RESAMPLE_POLY_STREAM
+static uint8_t signal_get_window_type(mp_obj_t window) {
+    GET_STR_DATA_LEN(window, str, len);
+    if((len == 4) && (memcmp(str, "hann", 4) == 0)) {
+        return SIGNAL_WINDOW_HANN;
+    } else if((len == 7) && (memcmp(str, "hamming", 7) == 0)) {
+        return SIGNAL_WINDOW_HAMMING;
+    } else if((len == 8) && (memcmp(str, "blackman", 8) == 0)) {
+        return SIGNAL_WINDOW_BLACKMAN;
+    } else if((len == 6) && (memcmp(str, "boxcar", 6) == 0)) {
+        return SIGNAL_WINDOW_BOXCAR;
+    }
+    mp_raise_ValueError(MP_ERROR_TEXT("window must be 'hann', 'hamming', 'blackman', 'boxcar', or an array"));
+}
+
+static ndarray_obj_t *signal_get_signal(mp_obj_t x_in) {
+    ndarray_obj_t *x = ndarray_from_mp_obj(x_in, 0);
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(x->dtype)
+    if(x->ndim != 1) {
+        mp_raise_ValueError(MP_ERROR_TEXT("x must be a 1D array"));
+    }
+    return x;
+}
+
+static void signal_window(mp_float_t *w, size_t n, uint8_t type, size_t period) {
+    // the periodic windows of scipy.signal.get_window, if period is n, and the symmetric ones, if it is n - 1
+    for(size_t i = 0; i < n; i++) {
+        mp_float_t theta = period == 0 ? MICROPY_FLOAT_CONST(0.0) : MICROPY_FLOAT_CONST(2.0) * MP_PI * i / period;
+        if(type == SIGNAL_WINDOW_HANN) {
+            w[i] = MICROPY_FLOAT_CONST(0.5) - MICROPY_FLOAT_CONST(0.5) * MICROPY_FLOAT_C_FUN(cos)(theta);
+        } else if(type == SIGNAL_WINDOW_HAMMING) {
+            w[i] = MICROPY_FLOAT_CONST(0.54) - MICROPY_FLOAT_CONST(0.46) * MICROPY_FLOAT_C_FUN(cos)(theta);
+        } else if(type == SIGNAL_WINDOW_BLACKMAN) {
+            w[i] = MICROPY_FLOAT_CONST(0.42) - MICROPY_FLOAT_CONST(0.5) * MICROPY_FLOAT_C_FUN(cos)(theta)
+                    + MICROPY_FLOAT_CONST(0.08) * MICROPY_FLOAT_C_FUN(cos)(MICROPY_FLOAT_CONST(2.0) * theta);
+        } else {
+            w[i] = MICROPY_FLOAT_CONST(1.0);
+        }
+    }
+}
+#endif
+
+#if ULAB_SCIPY_SIGNAL_HAS_WELCH | ULAB_SCIPY_SIGNAL_HAS_STFT
+// the window coefficients, and the plan of the last segment length are kept between calls;
+// the cache is on the heap, and is reachable through the root pointer only
+MP_REGISTER_ROOT_POINTER(void *ulab_signal_cache);
+
+void signal_spectral_reset(void) {
+    // the heap does not survive a soft reset, hence the cache has to be dropped
+    MP_STATE_VM(ulab_signal_cache) = NULL;
+}
+
+static signal_spectral_cache_t *signal_get_cache(mp_obj_t window, size_t nperseg) {
+    // returns the cache with the coefficients of the window, and the plan of the half-length
+    // transform of nperseg samples; these are re-calculated only, if they have changed
+    if((nperseg < 2) || ((nperseg & (nperseg - 1)) != 0)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("nperseg must be a power of 2"));
+    }
+    uint8_t type = SIGNAL_WINDOW_ARRAY;
+    ndarray_obj_t *coeffs = NULL;
+    if(mp_obj_is_str(window)) {
+        type = signal_get_window_type(window);
+    } else {
+        coeffs = ndarray_from_mp_obj(window, 0);
+        COMPLEX_DTYPE_NOT_IMPLEMENTED(coeffs->dtype)
+        if((coeffs->ndim != 1) || (coeffs->len != nperseg)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("window must be a 1D array of length nperseg"));
+        }
+    }
+
+    ULAB_STATE_CHECK();
+    signal_spectral_cache_t *cache = (signal_spectral_cache_t *)MP_STATE_VM(ulab_signal_cache);
+    if(cache == NULL) {
+        cache = m_new_obj(signal_spectral_cache_t);
+        cache->nperseg = 0;
+        cache->coeffs = NULL;
+        MP_STATE_VM(ulab_signal_cache) = cache;
+    }
+    if(cache->nperseg != nperseg) {
+        if(cache->coeffs != NULL) {
+            m_del(mp_float_t, cache->coeffs, cache->nperseg);
+        }
+        // if an exception is raised in the following, the cache must not be left in an inconsistent state;
+        // SIGNAL_WINDOW_ARRAY marks the coefficients as invalid, since arrays are always re-loaded
+        cache->window = SIGNAL_WINDOW_ARRAY;
+        cache->nperseg = 0;
+        cache->coeffs = m_new(mp_float_t, nperseg);
+        cache->plan = fft_new_plan(nperseg / 2);
+        cache->nperseg = nperseg;
+    }
+
+    if((type != SIGNAL_WINDOW_ARRAY) && (type == cache->window)) {
+        // a named window of the right length is already in the cache; the contents of an array
+        // can't be compared cheaply, hence arrays are always copied
+        return cache;
+    }
+    mp_float_t *w = cache->coeffs;
+    if(type == SIGNAL_WINDOW_ARRAY) {
+        tools_load_float(w, 1, (uint8_t *)coeffs->array, coeffs->strides[ULAB_MAX_DIMS - 1], coeffs->dtype, nperseg);
+    } else {
+        signal_window(w, nperseg, type, nperseg);
+    }
+    cache->s1 = MICROPY_FLOAT_CONST(0.0);
+    cache->s2 = MICROPY_FLOAT_CONST(0.0);
+    for(size_t i = 0; i < nperseg; i++) {
+        cache->s1 += w[i];
+        cache->s2 += w[i] * w[i];
+    }
+    cache->window = type;
+    return cache;
+}
+
+static bool signal_get_detrend(mp_obj_t detrend) {
+    if((detrend == mp_const_none) || (detrend == mp_const_false)) {
+        return false;
+    }
+    if(mp_obj_is_str(detrend)) {
+        GET_STR_DATA_LEN(detrend, str, len);
+        if((len == 8) && (memcmp(str, "constant", 8) == 0)) {
+            return true;
+        }
+    }
+    mp_raise_ValueError(MP_ERROR_TEXT("detrend must be 'constant', or False"));
+}
+
+static size_t signal_get_nperseg(mp_obj_t nperseg_in, mp_obj_t window, size_t len) {
+    // if not given, nperseg is the length of an explicit window, or 256, but at most the length of x
+    if(nperseg_in != mp_const_none) {
+        mp_int_t nperseg = mp_obj_get_int(nperseg_in);
+        if(nperseg < 1) {
+            mp_raise_ValueError(MP_ERROR_TEXT("nperseg must be a power of 2"));
+        }
+        return (size_t)nperseg;
+    }
+    if(!mp_obj_is_str(window)) {
+        return (size_t)mp_obj_get_int(mp_obj_len(window));
+    }
+    return len < SIGNAL_NPERSEG ? len : SIGNAL_NPERSEG;
+}
+
+static size_t signal_get_noverlap(mp_obj_t noverlap_in, size_t nperseg) {
+    if(noverlap_in == mp_const_none) {
+        return nperseg / 2;
+    }
+    mp_int_t noverlap = mp_obj_get_int(noverlap_in);
+    if((noverlap < 0) || ((size_t)noverlap >= nperseg)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("noverlap must be less than nperseg"));
+    }
+    return (size_t)noverlap;
+}
+
+static void signal_spectral_segment(mp_float_t *data, ndarray_obj_t *x, size_t start, size_t pad,
+                                    signal_spectral_cache_t *cache, bool detrend) {
+    // loads the samples start...start + nperseg - 1 of x, which is preceded by pad, and
+    // followed by an arbitrary number of zeros, detrends, and windows them, and calculates
+    // the positive-frequency half of the spectrum in place; data must hold nperseg + 2 floats
+    size_t n = cache->nperseg;
+    size_t lo = start < pad ? pad - start : 0;
+    size_t hi = pad + x->len > start ? pad + x->len - start : 0;
+    if(hi > n) {
+        hi = n;
+    }
+    memset(data, 0, (n + 2) * sizeof(mp_float_t));
+    if(hi > lo) {
+        uint8_t *array = (uint8_t *)x->array + (int32_t)(start + lo - pad) * x->strides[ULAB_MAX_DIMS - 1];
+        tools_load_float(data + lo, 1, array, x->strides[ULAB_MAX_DIMS - 1], x->dtype, hi - lo);
+    }
+    if(detrend) {
+        mp_float_t mean = MICROPY_FLOAT_CONST(0.0);
+        for(size_t i = 0; i < n; i++) {
+            mean += data[i];
+        }
+        mean /= n;
+        for(size_t i = 0; i < n; i++) {
+            data[i] -= mean;
+        }
+    }
+    for(size_t i = 0; i < n; i++) {
+        data[i] *= cache->coeffs[i];
+    }
+    fft_kernel_real(data, n, 1, cache->plan);
+}
+
+static mp_obj_t signal_spectral_frequencies(size_t nperseg, mp_float_t fs) {
+    size_t nfreq = nperseg / 2 + 1;
+    ndarray_obj_t *freqs = ndarray_new_linear_array(nfreq, NDARRAY_FLOAT);
+    mp_float_t *farray = (mp_float_t *)freqs->array;
+    for(size_t k = 0; k < nfreq; k++) {
+        farray[k] = fs * k / nperseg;
+    }
+    return MP_OBJ_FROM_PTR(freqs);
+}
+#endif /* ULAB_SCIPY_SIGNAL_HAS_WELCH | ULAB_SCIPY_SIGNAL_HAS_STFT */
+
+#if ULAB_SCIPY_SIGNAL_HAS_WELCH
+//| def welch(
+//|     x: _ArrayLike,
+//|     fs: float = 1.0,
+//|     window: Union[str, _ArrayLike] = 'hann',
+//|     nperseg: Optional[int] = None,
+//|     noverlap: Optional[int] = None,
+//|     detrend: Union[str, bool] = 'constant',
+//|     scaling: str = 'density'
+//| ) -> Tuple[ulab.numpy.ndarray, ulab.numpy.ndarray]:
+//|     """
+//|     :param ulab.numpy.ndarray x: the signal
+//|     :param float fs: the sampling frequency
+//|     :param window: 'hann', 'hamming', 'blackman', 'boxcar', or the coefficients of the window
+//|     :param int nperseg: the length of the segments, must be a power of 2
+//|     :param int noverlap: the number of samples shared by consecutive segments, nperseg // 2 by default
+//|     :param detrend: 'constant', if the mean of each segment is to be subtracted, or False
+//|     :param str scaling: 'density' for the power spectral density, or 'spectrum' for the power spectrum
+//|
+//|     Estimate the power spectral density of x by Welch's method, and return the frequencies, and the estimate"""
+//|     ...
+//|
+
+mp_obj_t signal_welch(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_x, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_fs, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_window, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_QSTR(MP_QSTR_hann) } },
+        { MP_QSTR_nperseg, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_noverlap, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_detrend, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_QSTR(MP_QSTR_constant) } },
+        { MP_QSTR_scaling, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_QSTR(MP_QSTR_density) } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    ndarray_obj_t *x = signal_get_signal(args[0].u_obj);
+    mp_float_t fs = args[1].u_obj == mp_const_none ? MICROPY_FLOAT_CONST(1.0) : mp_obj_get_float(args[1].u_obj);
+    size_t nperseg = signal_get_nperseg(args[3].u_obj, args[2].u_obj, x->len);
+    size_t noverlap = signal_get_noverlap(args[4].u_obj, nperseg);
+    bool detrend = signal_get_detrend(args[5].u_obj);
+    bool density = true;
+    if(mp_obj_is_str(args[6].u_obj)) {
+        GET_STR_DATA_LEN(args[6].u_obj, str, len);
+        if((len == 8) && (memcmp(str, "spectrum", 8) == 0)) {
+            density = false;
+        } else if(!((len == 7) && (memcmp(str, "density", 7) == 0))) {
+            mp_raise_ValueError(MP_ERROR_TEXT("scaling must be 'density', or 'spectrum'"));
+        }
+    } else {
+        mp_raise_ValueError(MP_ERROR_TEXT("scaling must be 'density', or 'spectrum'"));
+    }
+    if(x->len < nperseg) {
+        mp_raise_ValueError(MP_ERROR_TEXT("x must not be shorter than nperseg"));
+    }
+    signal_spectral_cache_t *cache = signal_get_cache(args[2].u_obj, nperseg);
+
+    size_t step = nperseg - noverlap;
+    size_t nseg = (x->len - nperseg) / step + 1;
+    size_t nfreq = nperseg / 2 + 1;
+
+    // the periodograms of the segments are accumulated in the output
+    ndarray_obj_t *psd = ndarray_new_linear_array(nfreq, NDARRAY_FLOAT);
+    mp_float_t *parray = (mp_float_t *)psd->array;
+    mp_float_t *data = ulab_scratch_new(mp_float_t, nperseg + 2);
+    for(size_t j = 0; j < nseg; j++) {
+        signal_spectral_segment(data, x, j * step, 0, cache, detrend);
+        for(size_t k = 0; k < nfreq; k++) {
+            parray[k] += data[2 * k] * data[2 * k] + data[2 * k + 1] * data[2 * k + 1];
+        }
+    }
+    ulab_scratch_del(mp_float_t, data, nperseg + 2);
+
+    mp_float_t scale = density ? fs * cache->s2 : cache->s1 * cache->s1;
+    scale = MICROPY_FLOAT_CONST(1.0) / (scale * nseg);
+    for(size_t k = 0; k < nfreq; k++) {
+        // the power of the negative frequencies is added to that of the positive ones
+        parray[k] *= ((k == 0) || (k == nfreq - 1)) ? scale : MICROPY_FLOAT_CONST(2.0) * scale;
+    }
+
+    mp_obj_t tuple[2];
+    tuple[0] = signal_spectral_frequencies(nperseg, fs);
+    tuple[1] = MP_OBJ_FROM_PTR(psd);
+    return mp_obj_new_tuple(2, tuple);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(signal_welch_obj, 1, signal_welch);
+#endif /* ULAB_SCIPY_SIGNAL_HAS_WELCH */
+
+#if ULAB_SCIPY_SIGNAL_HAS_STFT & ULAB_SUPPORTS_COMPLEX & ULAB_MAX_DIMS > 1
+// the state of the segments of stft
+typedef struct _signal_stft_t {
+    mp_float_t *data;
+    mp_float_t *zarray;
+    ndarray_obj_t *x;
+    signal_spectral_cache_t *cache;
+    mp_float_t scale;
+    size_t step;
+    size_t pad;
+    size_t nseg;
+    bool detrend;
+} signal_stft_t;
+
+static void signal_stft_kernel(void *context, size_t start, size_t end, uint8_t core) {
+    signal_stft_t *transform = (signal_stft_t *)context;
+    size_t nperseg = transform->cache->nperseg;
+    size_t nfreq = nperseg / 2 + 1;
+    size_t nseg = transform->nseg;
+    mp_float_t *data = transform->data + core * (nperseg + 2);
+    mp_float_t *zarray = transform->zarray;
+    for(size_t j = start; j < end; j++) {
+        signal_spectral_segment(data, transform->x, j * transform->step, transform->pad, transform->cache, transform->detrend);
+        // the segments are the columns of the result
+        for(size_t k = 0; k < nfreq; k++) {
+            zarray[2 * (k * nseg + j)] = data[2 * k] * transform->scale;
+            zarray[2 * (k * nseg + j) + 1] = data[2 * k + 1] * transform->scale;
+        }
+    }
+}
+
+//| def stft(
+//|     x: _ArrayLike,
+//|     fs: float = 1.0,
+//|     window: Union[str, _ArrayLike] = 'hann',
+//|     nperseg: Optional[int] = None,
+//|     noverlap: Optional[int] = None,
+//|     detrend: Union[str, bool] = False,
+//|     boundary: Optional[str] = 'zeros',
+//|     padded: bool = True
+//| ) -> Tuple[ulab.numpy.ndarray, ulab.numpy.ndarray, ulab.numpy.ndarray]:
+//|     """
+//|     :param ulab.numpy.ndarray x: the signal
+//|     :param float fs: the sampling frequency
+//|     :param window: 'hann', 'hamming', 'blackman', 'boxcar', or the coefficients of the window
+//|     :param int nperseg: the length of the segments, must be a power of 2
+//|     :param int noverlap: the number of samples shared by consecutive segments, nperseg // 2 by default
+//|     :param detrend: 'constant', if the mean of each segment is to be subtracted, or False
+//|     :param boundary: 'zeros', if x is to be extended by nperseg // 2 zeros at both ends, or None
+//|     :param bool padded: whether x is to be padded by zeros to fit an integer number of segments
+//|
+//|     Calculate the short-time Fourier transform of x, and return the frequencies, the times
+//|     of the segments, and the complex transform, whose columns are the segments"""
+//|     ...
+//|
+
+mp_obj_t signal_stft(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_x, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_fs, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_window, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_QSTR(MP_QSTR_hann) } },
+        { MP_QSTR_nperseg, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_noverlap, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_detrend, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_FALSE } },
+        { MP_QSTR_boundary, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_QSTR(MP_QSTR_zeros) } },
+        { MP_QSTR_padded, MP_ARG_BOOL, {.u_bool = true } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    ndarray_obj_t *x = signal_get_signal(args[0].u_obj);
+    mp_float_t fs = args[1].u_obj == mp_const_none ? MICROPY_FLOAT_CONST(1.0) : mp_obj_get_float(args[1].u_obj);
+    size_t nperseg = signal_get_nperseg(args[3].u_obj, args[2].u_obj, x->len);
+    size_t noverlap = signal_get_noverlap(args[4].u_obj, nperseg);
+    bool detrend = signal_get_detrend(args[5].u_obj);
+    size_t pad = 0;
+    if(args[6].u_obj != mp_const_none) {
+        if(!mp_obj_is_str(args[6].u_obj)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("boundary must be 'zeros', or None"));
+        }
+        GET_STR_DATA_LEN(args[6].u_obj, str, len);
+        if(!((len == 5) && (memcmp(str, "zeros", 5) == 0))) {
+            mp_raise_ValueError(MP_ERROR_TEXT("boundary must be 'zeros', or None"));
+        }
+        pad = nperseg / 2;
+    }
+    signal_spectral_cache_t *cache = signal_get_cache(args[2].u_obj, nperseg);
+
+    // the length of the extended signal; the zeros are never stored
+    size_t step = nperseg - noverlap;
+    size_t len = x->len + 2 * pad;
+    if(args[7].u_bool && (len > nperseg) && ((len - nperseg) % step != 0)) {
+        len += step - (len - nperseg) % step;
+    }
+    if(len < nperseg) {
+        mp_raise_ValueError(MP_ERROR_TEXT("x must not be shorter than nperseg"));
+    }
+    size_t nseg = (len - nperseg) / step + 1;
+    size_t nfreq = nperseg / 2 + 1;
+
+    ndarray_obj_t *times = ndarray_new_linear_array(nseg, NDARRAY_FLOAT);
+    mp_float_t *tarray = (mp_float_t *)times->array;
+    for(size_t j = 0; j < nseg; j++) {
+        // the centres of the segments in the time frame of x
+        tarray[j] = ((mp_float_t)(j * step + nperseg / 2) - (mp_float_t)pad) / fs;
+    }
+
+    size_t *shape = ndarray_shape_vector(0, 0, nfreq, nseg);
+    ndarray_obj_t *zxx = ndarray_new_dense_ndarray(2, shape, NDARRAY_COMPLEX);
+    m_del(size_t, shape, ULAB_MAX_DIMS);
+    // each core transforms its segments in its own part of the scratch buffer
+    mp_float_t *data = ulab_scratch_new(mp_float_t, ULAB_PARALLEL_CORES * (nperseg + 2));
+    signal_stft_t transform = {
+        .data = data,
+        .zarray = (mp_float_t *)zxx->array,
+        .x = x,
+        .cache = cache,
+        .scale = MICROPY_FLOAT_CONST(1.0) / cache->s1,
+        .step = step,
+        .pad = pad,
+        .nseg = nseg,
+        .detrend = detrend,
+    };
+    // the DSP backend initialises its tables on the heap, on first use, hence it can be called on the calling core only
+    ulab_parallel_for(signal_stft_kernel, &transform, nseg, ULAB_DSP_BACKEND == ULAB_DSP_BACKEND_NONE ? nperseg : 0);
+    ulab_scratch_del(mp_float_t, data, ULAB_PARALLEL_CORES * (nperseg + 2));
+
+    mp_obj_t tuple[3];
+    tuple[0] = signal_spectral_frequencies(nperseg, fs);
+    tuple[1] = MP_OBJ_FROM_PTR(times);
+    tuple[2] = MP_OBJ_FROM_PTR(zxx);
+    return mp_obj_new_tuple(3, tuple);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(signal_stft_obj, 1, signal_stft);
+#endif /* ULAB_SCIPY_SIGNAL_HAS_STFT */
+
+#if ULAB_SCIPY_SIGNAL_HAS_RESAMPLE_POLY | ULAB_SCIPY_SIGNAL_HAS_DECIMATE | ULAB_SCIPY_SIGNAL_HAS_RESAMPLE_POLY_STREAM
+static mp_float_t signal_bessel_i0(mp_float_t x) {
+    // the power series of the modified Bessel function of the first kind of order 0
+    mp_float_t q = MICROPY_FLOAT_CONST(0.25) * x * x;
+    mp_float_t term = MICROPY_FLOAT_CONST(1.0);
+    mp_float_t sum = MICROPY_FLOAT_CONST(1.0);
+    for(uint16_t k = 1; k < 500; k++) {
+        term *= q / ((mp_float_t)k * (mp_float_t)k);
+        if(sum + term == sum) {
+            break;
+        }
+        sum += term;
+    }
+    return sum;
+}
+
+static void signal_firwin(mp_float_t *h, size_t ntaps, mp_float_t cutoff, uint8_t type, mp_float_t beta) {
+    // the windowed sinc low-pass filter of scipy.signal.firwin; cutoff is relative to the Nyquist
+    // frequency, and the coefficients are normalised to unit gain at zero frequency
+    if(type == SIGNAL_WINDOW_KAISER) {
+        mp_float_t i0beta = signal_bessel_i0(beta);
+        for(size_t i = 0; i < ntaps; i++) {
+            mp_float_t r = ntaps == 1 ? MICROPY_FLOAT_CONST(0.0) : MICROPY_FLOAT_CONST(2.0) * i / (ntaps - 1) - MICROPY_FLOAT_CONST(1.0);
+            h[i] = signal_bessel_i0(beta * MICROPY_FLOAT_C_FUN(sqrt)(MICROPY_FLOAT_CONST(1.0) - r * r)) / i0beta;
+        }
+    } else {
+        signal_window(h, ntaps, type, ntaps - 1);
+    }
+    mp_float_t alpha = MICROPY_FLOAT_CONST(0.5) * (ntaps - 1);
+    mp_float_t sum = MICROPY_FLOAT_CONST(0.0);
+    for(size_t i = 0; i < ntaps; i++) {
+        mp_float_t x = MP_PI * cutoff * (i - alpha);
+        h[i] *= x == MICROPY_FLOAT_CONST(0.0) ? cutoff : cutoff * MICROPY_FLOAT_C_FUN(sin)(x) / x;
+        sum += h[i];
+    }
+    for(size_t i = 0; i < ntaps; i++) {
+        h[i] /= sum;
+    }
+}
+
+static size_t signal_gcd(size_t a, size_t b) {
+    while(b != 0) {
+        size_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+static mp_float_t *signal_resample_filter(mp_obj_t window, size_t up, size_t down, size_t *ntaps, size_t *half_len) {
+    // returns the filter of resample_poly, scaled by up: either the designed low-pass filter,
+    // if window is a name, a tuple, or None (for ('kaiser', 5.0)), or the coefficients in window themselves
+    mp_float_t *h;
+    if((window == mp_const_none) || mp_obj_is_str(window) || mp_obj_is_type(window, &mp_type_tuple)) {
+        uint8_t type = SIGNAL_WINDOW_KAISER;
+        mp_float_t beta = SIGNAL_KAISER_BETA;
+        if(mp_obj_is_str(window)) {
+            type = signal_get_window_type(window);
+        } else if(window != mp_const_none) {
+            mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(window);
+            if((tuple->len != 2) || !mp_obj_is_str(tuple->items[0])) {
+                mp_raise_ValueError(MP_ERROR_TEXT("window tuple must be ('kaiser', beta)"));
+            }
+            GET_STR_DATA_LEN(tuple->items[0], str, slen);
+            if((slen != 6) || (memcmp(str, "kaiser", 6) != 0)) {
+                mp_raise_ValueError(MP_ERROR_TEXT("window tuple must be ('kaiser', beta)"));
+            }
+            beta = mp_obj_get_float(tuple->items[1]);
+        }
+        size_t max_rate = up > down ? up : down;
+        *half_len = SIGNAL_RESAMPLE_ZEROS * max_rate;
+        *ntaps = 2 * *half_len + 1;
+        h = m_new(mp_float_t, *ntaps);
+        signal_firwin(h, *ntaps, MICROPY_FLOAT_CONST(1.0) / max_rate, type, beta);
+    } else {
+        ndarray_obj_t *coeffs = ndarray_from_mp_obj(window, 0);
+        COMPLEX_DTYPE_NOT_IMPLEMENTED(coeffs->dtype)
+        if((coeffs->ndim != 1) || (coeffs->len == 0)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("window must be a 1D array"));
+        }
+        *ntaps = coeffs->len;
+        *half_len = (coeffs->len - 1) / 2;
+        h = m_new(mp_float_t, *ntaps);
+        tools_load_float(h, 1, (uint8_t *)coeffs->array, coeffs->strides[ULAB_MAX_DIMS - 1], coeffs->dtype, *ntaps);
+    }
+    for(size_t i = 0; i < *ntaps; i++) {
+        h[i] *= up;
+    }
+    return h;
+}
+
+static void signal_get_factors(mp_obj_t up_in, mp_obj_t down_in, size_t *up, size_t *down) {
+    mp_int_t _up = mp_obj_get_int(up_in);
+    mp_int_t _down = mp_obj_get_int(down_in);
+    if((_up < 1) || (_down < 1)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("up and down must be positive"));
+    }
+    size_t g = signal_gcd((size_t)_up, (size_t)_down);
+    *up = (size_t)_up / g;
+    *down = (size_t)_down / g;
+}
+
+static mp_float_t signal_polyphase(const mp_float_t *h, size_t ntaps, size_t up, const mp_float_t *x,
+                                    mp_int_t t, mp_int_t jmin, mp_int_t jmax) {
+    // returns the output of the up-sampled, and filtered signal at time t, i.e., the sum of h[t - j * up] * x[j]
+    // over jmin <= j <= jmax; since the zeros of the up-sampled signal are skipped, the sum has ntaps / up terms
+    mp_int_t _up = (mp_int_t)up;
+    mp_int_t jhi = t / _up;
+    mp_int_t a = t - (mp_int_t)ntaps + 1;
+    mp_int_t jlo = a > 0 ? (a + _up - 1) / _up : -((-a) / _up);
+    if(jhi > jmax) {
+        jhi = jmax;
+    }
+    if(jlo < jmin) {
+        jlo = jmin;
+    }
+    mp_float_t sum = MICROPY_FLOAT_CONST(0.0);
+    const mp_float_t *hp = h + (t - jhi * _up);
+    for(mp_int_t j = jhi; j >= jlo; j--) {
+        sum += *hp * x[j];
+        hp += up;
+    }
+    return sum;
+}
+#endif
+
+#if ULAB_SCIPY_SIGNAL_HAS_RESAMPLE_POLY | ULAB_SCIPY_SIGNAL_HAS_DECIMATE
+static mp_obj_t signal_polyphase_array(ndarray_obj_t *x, mp_float_t *h, size_t ntaps, size_t up, size_t down,
+                                        size_t offset, size_t nout) {
+    // calculates only the retained outputs, y[m] = sum_j h[m * down + offset - j * up] * x[j]
+    mp_float_t *xarray = (mp_float_t *)x->array;
+    bool dense = (x->dtype == NDARRAY_FLOAT) && (x->strides[ULAB_MAX_DIMS - 1] == (int32_t)sizeof(mp_float_t));
+    if(!dense) {
+        xarray = ulab_scratch_new(mp_float_t, x->len);
+        tools_load_float(xarray, 1, (uint8_t *)x->array, x->strides[ULAB_MAX_DIMS - 1], x->dtype, x->len);
+    }
+    ndarray_obj_t *y = ndarray_new_linear_array(nout, NDARRAY_FLOAT);
+    mp_float_t *yarray = (mp_float_t *)y->array;
+    for(size_t m = 0; m < nout; m++) {
+        yarray[m] = signal_polyphase(h, ntaps, up, xarray, (mp_int_t)(m * down + offset), 0, (mp_int_t)x->len - 1);
+    }
+    if(!dense) {
+        ulab_scratch_del(mp_float_t, xarray, x->len);
+    }
+    return MP_OBJ_FROM_PTR(y);
+}
+#endif
+
+#if ULAB_SCIPY_SIGNAL_HAS_RESAMPLE_POLY
+//| def resample_poly(
+//|     x: _ArrayLike,
+//|     up: int,
+//|     down: int,
+//|     window: Union[str, Tuple[str, float], _ArrayLike] = ('kaiser', 5.0)
+//| ) -> ulab.numpy.ndarray:
+//|     """
+//|     :param ulab.numpy.ndarray x: the signal
+//|     :param int up: the up-sampling factor
+//|     :param int down: the down-sampling factor
+//|     :param window: the window of the low-pass filter, or the coefficients of the filter
+//|
+//|     Resample x by the factor up / down with a polyphase FIR filter. Only the retained outputs are calculated."""
+//|     ...
+//|
+
+mp_obj_t signal_resample_poly(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_x, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_up, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_down, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_window, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    ndarray_obj_t *x = signal_get_signal(args[0].u_obj);
+    size_t up, down;
+    signal_get_factors(args[1].u_obj, args[2].u_obj, &up, &down);
+    if((up == 1) && (down == 1)) {
+        ndarray_obj_t *y = ndarray_new_linear_array(x->len, NDARRAY_FLOAT);
+        tools_load_float((mp_float_t *)y->array, 1, (uint8_t *)x->array, x->strides[ULAB_MAX_DIMS - 1], x->dtype, x->len);
+        return MP_OBJ_FROM_PTR(y);
+    }
+
+    size_t ntaps, half_len;
+    mp_float_t *h = signal_resample_filter(args[3].u_obj, up, down, &ntaps, &half_len);
+    size_t nout = (x->len * up + down - 1) / down;
+    // the outputs are centred on the filter, i.e., the delay of the filter is removed
+    mp_obj_t y = signal_polyphase_array(x, h, ntaps, up, down, half_len, nout);
+    m_del(mp_float_t, h, ntaps);
+    return y;
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(signal_resample_poly_obj, 3, signal_resample_poly);
+#endif /* ULAB_SCIPY_SIGNAL_HAS_RESAMPLE_POLY */
+
+#if ULAB_SCIPY_SIGNAL_HAS_DECIMATE
+//| def decimate(
+//|     x: _ArrayLike,
+//|     q: int,
+//|     n: Optional[int] = None,
+//|     ftype: str = 'fir',
+//|     zero_phase: bool = True
+//| ) -> ulab.numpy.ndarray:
+//|     """
+//|     :param ulab.numpy.ndarray x: the signal
+//|     :param int q: the down-sampling factor
+//|     :param int n: the order of the filter, 20 * q by default
+//|     :param str ftype: the type of the filter, only 'fir' is implemented
+//|     :param bool zero_phase: whether the delay of the filter is to be removed
+//|
+//|     Down-sample x by the factor q after applying an anti-aliasing FIR filter with a Hamming window"""
+//|     ...
+//|
+
+mp_obj_t signal_decimate(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_x, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_q, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 1 } },
+        { MP_QSTR_n, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_ftype, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_QSTR(MP_QSTR_fir) } },
+        { MP_QSTR_zero_phase, MP_ARG_BOOL, {.u_bool = true } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    ndarray_obj_t *x = signal_get_signal(args[0].u_obj);
+    if(args[1].u_int < 1) {
+        mp_raise_ValueError(MP_ERROR_TEXT("q must be positive"));
+    }
+    size_t q = (size_t)args[1].u_int;
+    if(!mp_obj_is_str(args[3].u_obj)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("ftype must be 'fir'"));
+    }
+    GET_STR_DATA_LEN(args[3].u_obj, str, len);
+    if((len != 3) || (memcmp(str, "fir", 3) != 0)) {
+        mp_raise_NotImplementedError(MP_ERROR_TEXT("only FIR filters are implemented"));
+    }
+    size_t order = 2 * SIGNAL_RESAMPLE_ZEROS * q;
+    if(args[2].u_obj != mp_const_none) {
+        mp_int_t n = mp_obj_get_int(args[2].u_obj);
+        if(n < 0) {
+            mp_raise_ValueError(MP_ERROR_TEXT("n must not be negative"));
+        }
+        order = (size_t)n;
+    }
+    size_t ntaps = order + 1;
+    mp_float_t *h = m_new(mp_float_t, ntaps);
+    signal_firwin(h, ntaps, MICROPY_FLOAT_CONST(1.0) / q, SIGNAL_WINDOW_HAMMING, MICROPY_FLOAT_CONST(0.0));
+
+    mp_obj_t y;
+    if(args[4].u_bool) {
+        y = signal_polyphase_array(x, h, ntaps, 1, q, order / 2, (x->len + q - 1) / q);
+    } else {
+        // the outputs of the causal filter, as in upfirdn
+        size_t nout = x->len == 0 ? 0 : (x->len + ntaps - 2) / q + 1;
+        y = signal_polyphase_array(x, h, ntaps, 1, q, 0, nout);
+    }
+    m_del(mp_float_t, h, ntaps);
+    return y;
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(signal_decimate_obj, 2, signal_decimate);
+#endif /* ULAB_SCIPY_SIGNAL_HAS_DECIMATE */
+
+#if ULAB_SCIPY_SIGNAL_HAS_RESAMPLE_POLY_STREAM
+static mp_obj_t signal_resample_poly_stream_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    (void) type;
+    mp_arg_check_num(n_args, n_kw, 2, 3, true);
+    mp_map_t kw_args;
+    mp_map_init_fixed_table(&kw_args, n_kw, args + n_args);
+
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_up, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_down, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_window, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE } },
+    };
+    mp_arg_val_t _args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, args, &kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, _args);
+
+    signal_resample_stream_obj_t *self = m_new_obj(signal_resample_stream_obj_t);
+    self->base.type = &signal_resample_poly_stream_type;
+    signal_get_factors(_args[0].u_obj, _args[1].u_obj, &self->up, &self->down);
+    size_t half_len;
+    self->h = signal_resample_filter(_args[2].u_obj, self->up, self->down, &self->ntaps, &half_len);
+    // the oldest sample that an output can depend on is this many samples earlier
+    self->nhistory = (self->ntaps - 1 + self->up - 1) / self->up;
+    self->history = m_new0(mp_float_t, MAX(1, self->nhistory));
+    self->t = 0;
+    return MP_OBJ_FROM_PTR(self);
+}
+
+static mp_obj_t signal_resample_poly_stream_filter(mp_obj_t self_in, mp_obj_t x_in) {
+    signal_resample_stream_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    ndarray_obj_t *x = signal_get_signal(x_in);
+    size_t len = x->len;
+    size_t nhistory = self->nhistory;
+
+    // the outputs, whose newest sample is in this block
+    size_t nout = self->t < len * self->up ? (len * self->up - self->t - 1) / self->down + 1 : 0;
+    ndarray_obj_t *y = ndarray_new_linear_array(nout, NDARRAY_FLOAT);
+    mp_float_t *yarray = (mp_float_t *)y->array;
+
+    // the history, and the block are placed in a single buffer, so that the outputs
+    // at the beginning of the block can reach back into the previous blocks
+    mp_float_t *buffer = ulab_scratch_new(mp_float_t, nhistory + len);
+    memcpy(buffer, self->history, nhistory * sizeof(mp_float_t));
+    tools_load_float(buffer + nhistory, 1, (uint8_t *)x->array, x->strides[ULAB_MAX_DIMS - 1], x->dtype, len);
+
+    size_t t = self->t;
+    for(size_t m = 0; m < nout; m++) {
+        yarray[m] = signal_polyphase(self->h, self->ntaps, self->up, buffer + nhistory, (mp_int_t)t, -(mp_int_t)nhistory, (mp_int_t)len - 1);
+        t += self->down;
+    }
+    self->t = t - len * self->up;
+    memcpy(self->history, buffer + len, nhistory * sizeof(mp_float_t));
+    ulab_scratch_del(mp_float_t, buffer, nhistory + len);
+    return MP_OBJ_FROM_PTR(y);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_2(signal_resample_poly_stream_filter_obj, signal_resample_poly_stream_filter);
+
+static mp_obj_t signal_resample_poly_stream_reset(mp_obj_t self_in) {
+    signal_resample_stream_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    memset(self->history, 0, self->nhistory * sizeof(mp_float_t));
+    self->t = 0;
+    return mp_const_none;
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(signal_resample_poly_stream_reset_obj, signal_resample_poly_stream_reset);
+
+static void signal_resample_poly_stream_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    (void)kind;
+    signal_resample_stream_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_printf(print, "resample_poly_stream(%d, %d)", (int)self->up, (int)self->down);
+}
+
+static const mp_rom_map_elem_t signal_resample_poly_stream_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_filter), MP_ROM_PTR(&signal_resample_poly_stream_filter_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&signal_resample_poly_stream_reset_obj) },
+};
+
+static MP_DEFINE_CONST_DICT(signal_resample_poly_stream_locals_dict, signal_resample_poly_stream_locals_dict_table);
+
+#if defined(MP_DEFINE_CONST_OBJ_TYPE)
+MP_DEFINE_CONST_OBJ_TYPE(
+    signal_resample_poly_stream_type,
+    MP_QSTR_resample_poly_stream,
+    MP_TYPE_FLAG_NONE,
+    make_new, signal_resample_poly_stream_make_new,
+    print, signal_resample_poly_stream_print,
+    locals_dict, &signal_resample_poly_stream_locals_dict
+);
+#else
+const mp_obj_type_t signal_resample_poly_stream_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_resample_poly_stream,
+    .make_new = signal_resample_poly_stream_make_new,
+    .print = signal_resample_poly_stream_print,
+    .locals_dict = (mp_obj_dict_t*)&signal_resample_poly_stream_locals_dict,
+};
+#endif
+#endif /* ULAB_SCIPY_SIGNAL_HAS_RESAMPLE_POLY_STREAM */
+
 static const mp_rom_map_elem_t ulab_scipy_signal_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_signal) },
+    #if ULAB_SCIPY_SIGNAL_HAS_CONVOLVE2D & ULAB_MAX_DIMS > 1
+        { MP_ROM_QSTR(MP_QSTR_convolve2d), ULAB_PROFILE_PTR(MP_QSTR_signal, MP_QSTR_convolve2d, signal_convolve2d_obj) },
+        { MP_ROM_QSTR(MP_QSTR_correlate2d), ULAB_PROFILE_PTR(MP_QSTR_signal, MP_QSTR_correlate2d, signal_correlate2d_obj) },
+    #endif
+    #if ULAB_SCIPY_SIGNAL_HAS_DECIMATE
+        { MP_ROM_QSTR(MP_QSTR_decimate), ULAB_PROFILE_PTR(MP_QSTR_signal, MP_QSTR_decimate, signal_decimate_obj) },
+    #endif
     #if ULAB_SCIPY_SIGNAL_HAS_SOSFILT & ULAB_MAX_DIMS > 1
-        { MP_ROM_QSTR(MP_QSTR_sosfilt), MP_ROM_PTR(&signal_sosfilt_obj) },
+        { MP_ROM_QSTR(MP_QSTR_sosfilt), ULAB_PROFILE_PTR(MP_QSTR_signal, MP_QSTR_sosfilt, signal_sosfilt_obj) },
+    #endif
+    #if ULAB_SCIPY_SIGNAL_HAS_STFT & ULAB_SUPPORTS_COMPLEX & ULAB_MAX_DIMS > 1
+        { MP_ROM_QSTR(MP_QSTR_stft), ULAB_PROFILE_PTR(MP_QSTR_signal, MP_QSTR_stft, signal_stft_obj) },
+    #endif
+    #if ULAB_SCIPY_SIGNAL_HAS_WELCH
+        { MP_ROM_QSTR(MP_QSTR_welch), ULAB_PROFILE_PTR(MP_QSTR_signal, MP_QSTR_welch, signal_welch_obj) },
+    #endif
+    #if ULAB_SCIPY_SIGNAL_HAS_LFILTER_STREAM
+        { MP_ROM_QSTR(MP_QSTR_lfilter_stream), MP_ROM_PTR(&signal_lfilter_stream_type) },
+    #endif
+    #if ULAB_SCIPY_SIGNAL_HAS_RESAMPLE_POLY
+        { MP_ROM_QSTR(MP_QSTR_resample_poly), ULAB_PROFILE_PTR(MP_QSTR_signal, MP_QSTR_resample_poly, signal_resample_poly_obj) },
+    #endif
+    #if ULAB_SCIPY_SIGNAL_HAS_RESAMPLE_POLY_STREAM
+        { MP_ROM_QSTR(MP_QSTR_resample_poly_stream), MP_ROM_PTR(&signal_resample_poly_stream_type) },
     #endif
 };
 
@@ -18,6 +18,88 @@
 
 extern const mp_obj_module_t ulab_scipy_signal_module;
 
+typedef struct _signal_lfilter_stream_obj_t {
+    mp_obj_base_t base;
+    uint16_t nb; // number of feed-forward coefficients
+    uint16_t na; // number of feed-back coefficients, a[0] excluded
+    uint16_t xpos; // write positions in the ring buffers
+    uint16_t ypos;
+    mp_float_t *b;
+    mp_float_t *a;
+    // the ring buffers are stored twice, so that the last samples are always contiguous
+    mp_float_t *x;
+    mp_float_t *y;
+} signal_lfilter_stream_obj_t;
+
+extern const mp_obj_type_t signal_lfilter_stream_type;
+
+enum SIGNAL_WINDOW {
+    SIGNAL_WINDOW_ARRAY,
+    SIGNAL_WINDOW_HANN,
+    SIGNAL_WINDOW_HAMMING,
+    SIGNAL_WINDOW_BLACKMAN,
+    SIGNAL_WINDOW_BOXCAR,
+    SIGNAL_WINDOW_KAISER,
+};
+
+// the default shape parameter of the Kaiser window of resample_poly, and
+// the number of zero crossings of the sinc kernel on either side of the centre
+#define SIGNAL_KAISER_BETA      MICROPY_FLOAT_CONST(5.0)
+#define SIGNAL_RESAMPLE_ZEROS   (10)
+
+typedef struct _signal_resample_stream_obj_t {
+    mp_obj_base_t base;
+    size_t up;
+    size_t down;
+    size_t ntaps;
+    size_t nhistory;
+    // the position of the next output in the upsampled time, counted from the first sample of the next block
+    size_t t;
+    mp_float_t *h;
+    // the last nhistory samples of the previous blocks
+    mp_float_t *history;
+} signal_resample_stream_obj_t;
+
+extern const mp_obj_type_t signal_resample_poly_stream_type;
+
+#if ULAB_SCIPY_SIGNAL_HAS_WELCH | ULAB_SCIPY_SIGNAL_HAS_STFT
+#include "../../numpy/fft/fft_tools.h"
+
+// the default length of the segments of welch, and stft
+#define SIGNAL_NPERSEG      (256)
+
+typedef struct _signal_spectral_cache_t {
+    uint8_t window;
+    size_t nperseg;
+    mp_float_t *coeffs;
+    // the sum of the coefficients, and of their squares
+    mp_float_t s1;
+    mp_float_t s2;
+    // the plan of the half-length transform
+    fft_plan_t *plan;
+} signal_spectral_cache_t;
+
+void signal_spectral_reset(void);
+#endif
+
+#if ULAB_SCIPY_SIGNAL_HAS_CONVOLVE2D & ULAB_MAX_DIMS > 1
+// the relative tolerance, with which a float kernel is taken to be the outer product of two vectors
+#ifndef SIGNAL_SEPARABLE_EPSILON
+#if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT
+#define SIGNAL_SEPARABLE_EPSILON    MICROPY_FLOAT_CONST(1.2e-6)
+#elif MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_DOUBLE
+#define SIGNAL_SEPARABLE_EPSILON    MICROPY_FLOAT_CONST(2.3e-15)
+#endif
+#endif /* SIGNAL_SEPARABLE_EPSILON */
+
+MP_DECLARE_CONST_FUN_OBJ_KW(signal_convolve2d_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(signal_correlate2d_obj);
+#endif
+
+MP_DECLARE_CONST_FUN_OBJ_KW(signal_decimate_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(signal_resample_poly_obj);
 MP_DECLARE_CONST_FUN_OBJ_KW(signal_sosfilt_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(signal_stft_obj);
+MP_DECLARE_CONST_FUN_OBJ_KW(signal_welch_obj);
 
 #endif /* _SCIPY_SIGNAL_ */
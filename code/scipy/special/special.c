@@ -16,21 +16,22 @@
 #include "py/runtime.h"
 
 #include "../../ulab.h"
+#include "../../ulab_profile.h"
 #include "../../numpy/vector.h"
 
 static const mp_rom_map_elem_t ulab_scipy_special_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_special) },
     #if ULAB_SCIPY_SPECIAL_HAS_ERF
-		{ MP_ROM_QSTR(MP_QSTR_erf), MP_ROM_PTR(&vector_erf_obj) },
+		{ MP_ROM_QSTR(MP_QSTR_erf), ULAB_PROFILE_PTR(MP_QSTR_special, MP_QSTR_erf, vector_erf_obj) },
     #endif
 	#if ULAB_SCIPY_SPECIAL_HAS_ERFC
-		{ MP_ROM_QSTR(MP_QSTR_erfc), MP_ROM_PTR(&vector_erfc_obj) },
+		{ MP_ROM_QSTR(MP_QSTR_erfc), ULAB_PROFILE_PTR(MP_QSTR_special, MP_QSTR_erfc, vector_erfc_obj) },
 	#endif
 	#if ULAB_SCIPY_SPECIAL_HAS_GAMMA
-		{ MP_ROM_QSTR(MP_QSTR_gamma), MP_ROM_PTR(&vector_gamma_obj) },
+		{ MP_ROM_QSTR(MP_QSTR_gamma), ULAB_PROFILE_PTR(MP_QSTR_special, MP_QSTR_gamma, vector_gamma_obj) },
 	#endif
 	#if ULAB_SCIPY_SPECIAL_HAS_GAMMALN
-		{ MP_ROM_QSTR(MP_QSTR_gammaln), MP_ROM_PTR(&vector_lgamma_obj) },
+		{ MP_ROM_QSTR(MP_QSTR_gammaln), ULAB_PROFILE_PTR(MP_QSTR_special, MP_QSTR_gammaln, vector_lgamma_obj) },
 	#endif
 };
 
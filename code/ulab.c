@@ -22,18 +22,20 @@
 #include "ulab.h"
 #include "ndarray.h"
 #include "ndarray_properties.h"
+#include "ulab_profile.h"
 #include "numpy/create.h"
 #include "numpy/ndarray/ndarray_iter.h"
 
 #include "numpy/numpy.h"
 #include "scipy/scipy.h"
+#include "scipy/signal/signal.h"
 // TODO: we should get rid of this; array.sort depends on it
 #include "numpy/numerical.h"
 
 #include "user/user.h"
 #include "utils/utils.h"
 
-#define ULAB_VERSION 6.4.2
+#define ULAB_VERSION 6.58.0
 #define xstr(s) str(s)
 #define str(s) #s
 
@@ -67,9 +69,15 @@ STATIC const mp_rom_map_elem_t ulab_ndarray_locals_dict_table[] = {
     #if NDARRAY_HAS_FLATTEN
         { MP_ROM_QSTR(MP_QSTR_flatten), MP_ROM_PTR(&ndarray_flatten_obj) },
     #endif
+    #if NDARRAY_HAS_RAVEL
+        { MP_ROM_QSTR(MP_QSTR_ravel), MP_ROM_PTR(&ndarray_ravel_obj) },
+    #endif
     #if NDARRAY_HAS_TOBYTES
         { MP_ROM_QSTR(MP_QSTR_tobytes), MP_ROM_PTR(&ndarray_tobytes_obj) },
     #endif
+    #if NDARRAY_HAS_TOFILE
+        { MP_ROM_QSTR(MP_QSTR_tofile), MP_ROM_PTR(&ndarray_tofile_obj) },
+    #endif
     #if NDARRAY_HAS_TOLIST
         { MP_ROM_QSTR(MP_QSTR_tolist), MP_ROM_PTR(&ndarray_tolist_obj) },
     #endif
@@ -192,9 +200,30 @@ const mp_obj_type_t ndarray_flatiter_type = {
 #endif
 #endif
 
+#if MICROPY_MODULE_BUILTIN_INIT
+static mp_obj_t ulab_init(void) {
+    #if ULAB_HAS_STATE
+    ulab_state_reset();
+    #endif
+    return mp_const_none;
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_0(ulab_init_obj, ulab_init);
+#endif
+
 STATIC const mp_rom_map_elem_t ulab_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_ulab) },
     { MP_ROM_QSTR(MP_QSTR___version__), MP_ROM_PTR(&ulab_version_obj) },
+    #if MICROPY_MODULE_BUILTIN_INIT
+    { MP_ROM_QSTR(MP_QSTR___init__), MP_ROM_PTR(&ulab_init_obj) },
+    #endif
+    #if ULAB_HAS_WORKSPACE
+    { MP_ROM_QSTR(MP_QSTR_set_workspace), MP_ROM_PTR(&ulab_memory_set_workspace_obj) },
+    #endif
+    #if ULAB_HAS_PROFILING
+    { MP_ROM_QSTR(MP_QSTR_stats), MP_ROM_PTR(&ulab_profile_stats_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stats_reset), MP_ROM_PTR(&ulab_profile_stats_reset_obj) },
+    #endif
     #ifdef ULAB_HASH
     { MP_ROM_QSTR(MP_QSTR___sha__), MP_ROM_PTR(&ulab_sha_obj) },
     #endif
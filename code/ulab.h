@@ -36,6 +36,130 @@
 #define ULAB_SUPPORTS_COMPLEX               (1)
 #endif
 
+// The signed integer dtypes can be excluded from the firmware, in which case the branches
+// of the operators, and functions that handle them are compiled away. uint8, and uint16 are
+// always available, since Booleans, and indices are stored in them. The sum of a uint8,
+// and an int8 is an int16, hence int8 requires int16.
+#ifndef ULAB_SUPPORTS_INT16
+#define ULAB_SUPPORTS_INT16                 (1)
+#endif
+
+#ifndef ULAB_SUPPORTS_INT8
+#define ULAB_SUPPORTS_INT8                  (ULAB_SUPPORTS_INT16)
+#endif
+
+#if ULAB_SUPPORTS_INT8 && !ULAB_SUPPORTS_INT16
+#error "ULAB_SUPPORTS_INT8 requires ULAB_SUPPORTS_INT16"
+#endif
+
+// Adds the int32, and uint32 dtypes, e.g., for the exact accumulation of sums, and for 24-bit
+// audio data. The operators handle them in a generic kernel, and the functions that do not
+// implement them raise a TypeError.
+#ifndef ULAB_SUPPORTS_INT32
+#define ULAB_SUPPORTS_INT32                 (0)
+#endif
+
+#define ULAB_SUPPORTS_UINT32                (ULAB_SUPPORTS_INT32)
+
+// Adds the float16 dtype. The values are only stored in half precision, the operators,
+// and functions convert them to mp_float_t, and operate on those.
+#ifndef ULAB_SUPPORTS_FLOAT16
+#define ULAB_SUPPORTS_FLOAT16               (0)
+#endif
+
+#define ULAB_HAS_GENERIC_DTYPES             (ULAB_SUPPORTS_INT32 | ULAB_SUPPORTS_FLOAT16)
+
+// Adds fixed-point (Q15) kernels for int16 data to fft, ifft, convolve, and sosfilt,
+// which are selected with the dtype=int16 keyword argument
+#ifndef ULAB_SUPPORTS_Q15
+#define ULAB_SUPPORTS_Q15                   (ULAB_SUPPORTS_INT16)
+#endif
+
+#if ULAB_SUPPORTS_Q15 && !ULAB_SUPPORTS_INT16
+#error "ULAB_SUPPORTS_Q15 requires ULAB_SUPPORTS_INT16"
+#endif
+
+// Routes the hot kernels (the power-of-two complex FFT, dot, convolve, and the biquads
+// of sosfilt) to a vendor DSP library, if the arguments are float, and contiguous.
+// In all other cases, and with ULAB_DSP_BACKEND_NONE, the portable C code is used.
+// The vendor libraries are single-precision only, hence a backend other than
+// ULAB_DSP_BACKEND_NONE requires MICROPY_FLOAT_IMPL_FLOAT.
+#define ULAB_DSP_BACKEND_NONE               (0)
+#define ULAB_DSP_BACKEND_CMSIS              (1)
+#define ULAB_DSP_BACKEND_ESPDSP             (2)
+
+#ifndef ULAB_DSP_BACKEND
+#define ULAB_DSP_BACKEND                    ULAB_DSP_BACKEND_NONE
+#endif
+
+// Evaluates the contiguous float, and int16 cases of +, -, *, the comparisons, maximum,
+// minimum, clip, and sqrt with explicit vector instructions, if the target has them
+// (MVE on Cortex-M55/M85, NEON, or SSE2 in the unix port). The architecture is
+// detected from the compiler's predefined macros, and the scalar loops are used otherwise.
+#ifndef ULAB_HAS_SIMD
+#define ULAB_HAS_SIMD                       (1)
+#endif
+
+// Places the payload of arrays outside of the GC heap (e.g., in PSRAM), so that the garbage
+// collector does not have to scan it, while the header remains on the heap. The memory is
+// requested with the memory='external' keyword of empty, zeros, ones, and full, or automatically
+// for payloads of at least ULAB_EXTERNAL_MEMORY_THRESHOLD bytes (0 disables the automatic placement).
+// The allocator can be overridden by defining ULAB_EXTERNAL_CALLOC(size), and ULAB_EXTERNAL_FREE(ptr);
+// by default, it is the SPIRAM heap on ESP32, and calloc/free elsewhere. Requires MICROPY_ENABLE_FINALISER.
+#ifndef ULAB_HAS_EXTERNAL_MEMORY
+#define ULAB_HAS_EXTERNAL_MEMORY            (0)
+#endif
+
+#ifndef ULAB_EXTERNAL_MEMORY_THRESHOLD
+#define ULAB_EXTERNAL_MEMORY_THRESHOLD      (0)
+#endif
+
+// Adds ulab.set_workspace(buffer), with which the scratch buffers of the kernels are carved out of
+// a user-supplied buffer, and not allocated on the heap. If the workspace is too small, or
+// has not been set, the kernels fall back on the heap.
+#ifndef ULAB_HAS_WORKSPACE
+#define ULAB_HAS_WORKSPACE                  (1)
+#endif
+
+// Adds ulab.stats(), and ulab.stats_reset(), which report the number of calls, the bytes allocated,
+// and the cycles spent in each function of the module tables. Since each function is wrapped in
+// a timing object, this is meant for development builds; when 0, the hooks are compiled away.
+#ifndef ULAB_HAS_PROFILING
+#define ULAB_HAS_PROFILING                  (0)
+#endif
+
+// the number of distinct functions, whose statistics can be recorded
+#ifndef ULAB_PROFILE_MAX_FUNCTIONS
+#define ULAB_PROFILE_MAX_FUNCTIONS          (64)
+#endif
+
+// Splits dense elementwise operators, vectorised functions, flattened sum, mean, and std, and
+// the channels of sosfilt, and the segments of stft between two cores. The port supplies the
+// second core either by defining ULAB_PARALLEL_LAUNCH(job), and ULAB_PARALLEL_WAIT(job), or
+// through the built-in hooks for the rp2 (pico-sdk, without _thread), and esp32 (FreeRTOS)
+// ports; without a hook, everything runs on the calling core. See ulab_parallel.h.
+#ifndef ULAB_HAS_PARALLEL
+#define ULAB_HAS_PARALLEL                   (0)
+#endif
+
+// the number of elements, below which the work is not shared, because synchronising the
+// cores would take longer than it saves
+#ifndef ULAB_PARALLEL_THRESHOLD
+#define ULAB_PARALLEL_THRESHOLD             (4096)
+#endif
+
+// Releases the GIL in the kernels of the matrix decompositions, the Fourier transforms, convolve,
+// and sort, once the arguments have been parsed, and the outputs allocated, so that other threads
+// can run in the meantime. Kernels that touch fewer than ULAB_GIL_THRESHOLD elements keep the GIL.
+// This has an effect only with MICROPY_PY_THREAD_GIL.
+#ifndef ULAB_RELEASES_GIL
+#define ULAB_RELEASES_GIL                   (1)
+#endif
+
+#ifndef ULAB_GIL_THRESHOLD
+#define ULAB_GIL_THRESHOLD                  (1024)
+#endif
+
 // Determines, whether scipy is defined in ulab. The sub-modules and functions
 // of scipy have to be defined separately
 #ifndef ULAB_HAS_SCIPY
@@ -93,6 +217,14 @@
 #define NDARRAY_BINARY_USES_FUN_POINTER     (0)
 #endif
 
+// If both operands of a binary operator are dense, have the same shape and dtype,
+// or one of them is a scalar, the result can be calculated in a single flat loop.
+// This costs a couple of kB of flash, but is significantly faster than the generic
+// strided iteration.
+#ifndef NDARRAY_BINARY_HAS_DENSE_LOOP
+#define NDARRAY_BINARY_HAS_DENSE_LOOP       (1)
+#endif
+
 #ifndef NDARRAY_HAS_BINARY_OP_ADD
 #define NDARRAY_HAS_BINARY_OP_ADD           (1)
 #endif
@@ -245,6 +377,11 @@
 #define NDARRAY_HAS_ITEMSIZE            (1)
 #endif
 
+// ravel falls back on flatten, if the array cannot be viewed
+#ifndef NDARRAY_HAS_RAVEL
+#define NDARRAY_HAS_RAVEL               (NDARRAY_HAS_FLATTEN)
+#endif
+
 #ifndef NDARRAY_HAS_RESHAPE
 #define NDARRAY_HAS_RESHAPE             (1)
 #endif
@@ -269,6 +406,10 @@
 #define NDARRAY_HAS_TOBYTES             (1)
 #endif
 
+#ifndef NDARRAY_HAS_TOFILE
+#define NDARRAY_HAS_TOFILE              (1)
+#endif
+
 #ifndef NDARRAY_HAS_TOLIST
 #define NDARRAY_HAS_TOLIST              (1)
 #endif
@@ -277,13 +418,22 @@
 #define NDARRAY_HAS_TRANSPOSE           (1)
 #endif
 
-// Firmware size can be reduced at the expense of speed by using a function
-// pointer in iterations. Setting ULAB_VECTORISE_USES_FUNCPOINTER to 1 saves
-// around 800 bytes in the four-dimensional case, and around 200 in two dimensions.
+// Firmware size can be reduced at the expense of speed by converting the rows with
+// a shared typed loader, instead of unrolling the iteration for each dtype. Setting
+// ULAB_VECTORISE_USES_FUNCPOINTER to 1 saves around 800 bytes in the four-dimensional
+// case, and around 200 in two dimensions.
 #ifndef ULAB_VECTORISE_USES_FUN_POINTER
 #define ULAB_VECTORISE_USES_FUN_POINTER (1)
 #endif
 
+// Replaces libm in exp, log, sin, and cos by range-reduced polynomial approximations,
+// which are evaluated in a tight loop for dense float arrays. The maximum error is 1 ulp
+// for exp, and log, while the absolute error of sin, and cos is below 1e-7 for |x| < 8192
+// (libm is called for larger arguments). The approximations are single-precision only.
+#ifndef ULAB_VECTOR_FAST_MATH
+#define ULAB_VECTOR_FAST_MATH           (0)
+#endif
+
 // determines, whether e is defined in ulab.numpy itself
 #ifndef ULAB_NUMPY_HAS_E
 #define ULAB_NUMPY_HAS_E                (1)
@@ -386,6 +536,14 @@
 #define ULAB_NUMPY_HAS_MINIMUM          (1)
 #endif
 
+#ifndef ULAB_NUMPY_HAS_COUNT_NONZERO
+#define ULAB_NUMPY_HAS_COUNT_NONZERO    (1)
+#endif
+
+#ifndef ULAB_NUMPY_HAS_FLATNONZERO
+#define ULAB_NUMPY_HAS_FLATNONZERO      (1)
+#endif
+
 #ifndef ULAB_NUMPY_HAS_NONZERO
 #define ULAB_NUMPY_HAS_NONZERO          (1)
 #endif
@@ -416,6 +574,14 @@
 #define ULAB_LINALG_HAS_EIG             (1)
 #endif
 
+#ifndef ULAB_LINALG_HAS_EIGH
+#define ULAB_LINALG_HAS_EIGH            (1)
+#endif
+
+#ifndef ULAB_LINALG_HAS_EIGVALSH
+#define ULAB_LINALG_HAS_EIGVALSH        (1)
+#endif
+
 #ifndef ULAB_LINALG_HAS_INV
 #define ULAB_LINALG_HAS_INV             (1)
 #endif
@@ -428,6 +594,10 @@
 #define ULAB_LINALG_HAS_QR              (1)
 #endif
 
+#ifndef ULAB_LINALG_HAS_SOLVE
+#define ULAB_LINALG_HAS_SOLVE           (1)
+#endif
+
 // the FFT module; functions of the fft module still have
 // to be defined separately
 #ifndef ULAB_NUMPY_HAS_FFT_MODULE
@@ -451,6 +621,24 @@
 #define ULAB_FFT_HAS_IFFT               (1)
 #endif
 
+#ifndef ULAB_FFT_HAS_RFFT
+#define ULAB_FFT_HAS_RFFT               (1)
+#endif
+
+#ifndef ULAB_FFT_HAS_IRFFT
+#define ULAB_FFT_HAS_IRFFT              (1)
+#endif
+
+// transforms two dense float arrays in place, without allocating the outputs
+#ifndef ULAB_FFT_HAS_FFT_INPLACE
+#define ULAB_FFT_HAS_FFT_INPLACE        (1)
+#endif
+
+// afft returns a job, which calculates the transform one pass at a time
+#ifndef ULAB_FFT_HAS_AFFT
+#define ULAB_FFT_HAS_AFFT               (1)
+#endif
+
 #ifndef ULAB_NUMPY_HAS_ALL
 #define ULAB_NUMPY_HAS_ALL              (1)
 #endif
@@ -479,10 +667,35 @@
 #define ULAB_NUMPY_HAS_CONVOLVE         (1)
 #endif
 
+// with method='auto', convolve switches from the direct sum to overlap-add
+// FFT convolution, when the product of the lengths of the inputs exceeds this value
+#ifndef ULAB_NUMPY_CONVOLVE_FFT_THRESHOLD
+#define ULAB_NUMPY_CONVOLVE_FFT_THRESHOLD   (16384)
+#endif
+
+// aconvolve returns a job, which calculates the convolution in slices, so that it can be
+// interleaved with other tasks, e.g., those of asyncio; see ulab_job.h
+#ifndef ULAB_NUMPY_HAS_ACONVOLVE
+#define ULAB_NUMPY_HAS_ACONVOLVE        (1)
+#endif
+
+// the number of multiply-adds of a slice of the direct method of aconvolve
+#ifndef ULAB_NUMPY_ACONVOLVE_SLICE
+#define ULAB_NUMPY_ACONVOLVE_SLICE      (1024)
+#endif
+
 #ifndef ULAB_NUMPY_HAS_CROSS
 #define ULAB_NUMPY_HAS_CROSS            (1)
 #endif
 
+#ifndef ULAB_NUMPY_HAS_CUMPROD
+#define ULAB_NUMPY_HAS_CUMPROD          (1)
+#endif
+
+#ifndef ULAB_NUMPY_HAS_CUMSUM
+#define ULAB_NUMPY_HAS_CUMSUM           (1)
+#endif
+
 #ifndef ULAB_NUMPY_HAS_DELETE
 #define ULAB_NUMPY_HAS_DELETE           (1)
 #endif
@@ -503,10 +716,20 @@
 #define ULAB_NUMPY_HAS_INTERP           (1)
 #endif
 
+// a callable object, which caches the slopes of interp
+#ifndef ULAB_NUMPY_HAS_INTERPOLATOR
+#define ULAB_NUMPY_HAS_INTERPOLATOR     (ULAB_NUMPY_HAS_INTERP)
+#endif
+
 #ifndef ULAB_NUMPY_HAS_LOAD
 #define ULAB_NUMPY_HAS_LOAD             (1)
 #endif
 
+// delta-encoded, bit-packed container for integer arrays; a ulab extension
+#ifndef ULAB_NUMPY_HAS_LOAD_PACKED
+#define ULAB_NUMPY_HAS_LOAD_PACKED      (ULAB_NUMPY_HAS_LOAD)
+#endif
+
 #ifndef ULAB_NUMPY_HAS_LOADTXT
 #define ULAB_NUMPY_HAS_LOADTXT          (1)
 #endif
@@ -523,6 +746,14 @@
 #define ULAB_NUMPY_HAS_MINMAX           (1)
 #endif
 
+#ifndef ULAB_NUMPY_HAS_PERCENTILE
+#define ULAB_NUMPY_HAS_PERCENTILE       (1)
+#endif
+
+#ifndef ULAB_NUMPY_HAS_QUANTILE
+#define ULAB_NUMPY_HAS_QUANTILE         (1)
+#endif
+
 #ifndef ULAB_NUMPY_HAS_POLYFIT
 #define ULAB_NUMPY_HAS_POLYFIT          (1)
 #endif
@@ -531,6 +762,10 @@
 #define ULAB_NUMPY_HAS_POLYVAL          (1)
 #endif
 
+#ifndef ULAB_NUMPY_HAS_PUT
+#define ULAB_NUMPY_HAS_PUT              (1)
+#endif
+
 #ifndef ULAB_NUMPY_HAS_ROLL
 #define ULAB_NUMPY_HAS_ROLL             (1)
 #endif
@@ -539,6 +774,10 @@
 #define ULAB_NUMPY_HAS_SAVE             (1)
 #endif
 
+#ifndef ULAB_NUMPY_HAS_SAVE_PACKED
+#define ULAB_NUMPY_HAS_SAVE_PACKED      (ULAB_NUMPY_HAS_SAVE)
+#endif
+
 #ifndef ULAB_NUMPY_HAS_SAVETXT
 #define ULAB_NUMPY_HAS_SAVETXT          (1)
 #endif
@@ -559,6 +798,17 @@
 #define ULAB_NUMPY_HAS_SUM              (1)
 #endif
 
+// sum, mean, and std add floats pairwise in blocks of NUMERICAL_PAIRWISE_BLOCK;
+// if this constant is set to 1, a Kahan-compensated running sum is used instead.
+// The compensated sum is slightly more accurate, but slower
+#ifndef ULAB_NUMPY_SUM_USES_KAHAN
+#define ULAB_NUMPY_SUM_USES_KAHAN       (0)
+#endif
+
+#ifndef ULAB_NUMPY_HAS_TAKE
+#define ULAB_NUMPY_HAS_TAKE             (1)
+#endif
+
 #ifndef ULAB_NUMPY_HAS_TRACE
 #define ULAB_NUMPY_HAS_TRACE            (1)
 #endif
@@ -679,6 +929,11 @@
 #define ULAB_NUMPY_HAS_VECTORIZE        (1)
 #endif
 
+// lazy expressions, which evaluate chained arithmetic operations in a single pass
+#ifndef ULAB_NUMPY_HAS_LAZY
+#define ULAB_NUMPY_HAS_LAZY             (1)
+#endif
+
 // Complex functions. The implementations are compiled into
 // the firmware, only if ULAB_SUPPORTS_COMPLEX is set to 1
 #ifndef ULAB_NUMPY_HAS_CONJUGATE
@@ -698,6 +953,14 @@
 #endif
 
 // scipy modules
+#ifndef ULAB_SCIPY_HAS_INTEGRATE_MODULE
+#define ULAB_SCIPY_HAS_INTEGRATE_MODULE     (1)
+#endif
+
+#ifndef ULAB_SCIPY_INTEGRATE_HAS_CUMULATIVE_TRAPEZOID
+#define ULAB_SCIPY_INTEGRATE_HAS_CUMULATIVE_TRAPEZOID   (1)
+#endif
+
 #ifndef ULAB_SCIPY_HAS_LINALG_MODULE
 #define ULAB_SCIPY_HAS_LINALG_MODULE        (1)
 #endif
@@ -706,6 +969,14 @@
 #define ULAB_SCIPY_LINALG_HAS_CHO_SOLVE     (1)
 #endif
 
+#ifndef ULAB_SCIPY_LINALG_HAS_LU_FACTOR
+#define ULAB_SCIPY_LINALG_HAS_LU_FACTOR     (1)
+#endif
+
+#ifndef ULAB_SCIPY_LINALG_HAS_LU_SOLVE
+#define ULAB_SCIPY_LINALG_HAS_LU_SOLVE      (1)
+#endif
+
 #ifndef ULAB_SCIPY_LINALG_HAS_SOLVE_TRIANGULAR
 #define ULAB_SCIPY_LINALG_HAS_SOLVE_TRIANGULAR  (1)
 #endif
@@ -714,10 +985,40 @@
 #define ULAB_SCIPY_HAS_SIGNAL_MODULE        (1)
 #endif
 
+// convolve2d, and correlate2d
+#ifndef ULAB_SCIPY_SIGNAL_HAS_CONVOLVE2D
+#define ULAB_SCIPY_SIGNAL_HAS_CONVOLVE2D    (1)
+#endif
+
 #ifndef ULAB_SCIPY_SIGNAL_HAS_SOSFILT
 #define ULAB_SCIPY_SIGNAL_HAS_SOSFILT       (1)
 #endif
 
+// the streaming FIR/IIR filter object, which keeps its delay line between calls
+#ifndef ULAB_SCIPY_SIGNAL_HAS_DECIMATE
+#define ULAB_SCIPY_SIGNAL_HAS_DECIMATE      (1)
+#endif
+
+#ifndef ULAB_SCIPY_SIGNAL_HAS_LFILTER_STREAM
+#define ULAB_SCIPY_SIGNAL_HAS_LFILTER_STREAM    (1)
+#endif
+
+#ifndef ULAB_SCIPY_SIGNAL_HAS_RESAMPLE_POLY
+#define ULAB_SCIPY_SIGNAL_HAS_RESAMPLE_POLY (1)
+#endif
+
+#ifndef ULAB_SCIPY_SIGNAL_HAS_RESAMPLE_POLY_STREAM
+#define ULAB_SCIPY_SIGNAL_HAS_RESAMPLE_POLY_STREAM  (1)
+#endif
+
+#ifndef ULAB_SCIPY_SIGNAL_HAS_STFT
+#define ULAB_SCIPY_SIGNAL_HAS_STFT          (1)
+#endif
+
+#ifndef ULAB_SCIPY_SIGNAL_HAS_WELCH
+#define ULAB_SCIPY_SIGNAL_HAS_WELCH         (1)
+#endif
+
 #ifndef ULAB_SCIPY_HAS_OPTIMIZE_MODULE
 #define ULAB_SCIPY_HAS_OPTIMIZE_MODULE      (1)
 #endif
@@ -727,7 +1028,7 @@
 #endif
 
 #ifndef ULAB_SCIPY_OPTIMIZE_HAS_CURVE_FIT
-#define ULAB_SCIPY_OPTIMIZE_HAS_CURVE_FIT   (0) // not fully implemented
+#define ULAB_SCIPY_OPTIMIZE_HAS_CURVE_FIT   (1)
 #endif
 
 #ifndef ULAB_SCIPY_OPTIMIZE_HAS_FMIN
@@ -783,6 +1084,28 @@
 #define ULAB_UTILS_HAS_SPECTROGRAM          (1)
 #endif
 
+#ifndef ULAB_UTILS_HAS_ROLLING
+#define ULAB_UTILS_HAS_ROLLING              (1)
+#endif
+
+#ifndef ULAB_UTILS_HAS_DESCRIBE
+#define ULAB_UTILS_HAS_DESCRIBE             (1)
+#endif
+
+#ifndef ULAB_UTILS_HAS_LUT
+#define ULAB_UTILS_HAS_LUT                  (1)
+#endif
+
+// the RunningStats accumulator of the mean, variance, minimum, and maximum of a stream
+#ifndef ULAB_UTILS_HAS_RUNNING_STATS
+#define ULAB_UTILS_HAS_RUNNING_STATS        (1)
+#endif
+
+// the ring buffer of a fixed number of the most recent samples
+#ifndef ULAB_UTILS_HAS_RING
+#define ULAB_UTILS_HAS_RING                 (1)
+#endif
+
 // user-defined module; source of the module and
 // its sub-modules should be placed in code/user/
 #ifndef ULAB_HAS_USER_MODULE
@@ -0,0 +1,100 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#include "ulab.h"
+#include "ulab_api.h"
+#include "ulab_tools.h"
+#include "ndarray.h"
+
+bool ulab_api_get_array_info(mp_obj_t obj, ulab_array_info_t *info) {
+    if(!mp_obj_is_type(obj, &ulab_ndarray_type)) {
+        return false;
+    }
+    ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(obj);
+    info->dtype = ndarray->dtype;
+    info->boolean = ndarray->boolean == NDARRAY_BOOLEAN;
+    info->itemsize = ndarray->itemsize;
+    info->ndim = ndarray->ndim;
+    info->len = ndarray->len;
+    for(uint8_t i = 0; i < ULAB_MAX_DIMS; i++) {
+        info->shape[i] = 0;
+        info->strides[i] = 0;
+    }
+    // internally, the axes are aligned to the right
+    for(uint8_t i = 0; i < ndarray->ndim; i++) {
+        info->shape[i] = ndarray->shape[ULAB_MAX_DIMS - ndarray->ndim + i];
+        info->strides[i] = ndarray->strides[ULAB_MAX_DIMS - ndarray->ndim + i];
+    }
+    info->dense = ndarray_is_contiguous(ndarray);
+    info->data = ndarray->array;
+    return true;
+}
+
+static void ulab_api_check_arguments(uint8_t ndim, uint8_t dtype) {
+    if((ndim == 0) || (ndim > ULAB_MAX_DIMS)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("maximum number of dimensions is " MP_STRINGIFY(ULAB_MAX_DIMS)));
+    }
+    switch(dtype) {
+        case NDARRAY_BOOL:
+        case NDARRAY_UINT8:
+        case NDARRAY_INT8:
+        case NDARRAY_UINT16:
+        case NDARRAY_INT16:
+        case NDARRAY_INT32:
+        case NDARRAY_UINT32:
+        case NDARRAY_FLOAT16:
+        #if ULAB_SUPPORTS_COMPLEX
+        case NDARRAY_COMPLEX:
+        #endif
+        case NDARRAY_FLOAT:
+            // the optional dtypes are rejected, if they have been excluded from the firmware
+            if(ULAB_DTYPE_IS_SUPPORTED(dtype)) {
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+    mp_raise_TypeError(MP_ERROR_TEXT("data type not understood"));
+}
+
+mp_obj_t ulab_api_new_array(uint8_t ndim, const size_t *shape, uint8_t dtype) {
+    ulab_api_check_arguments(ndim, dtype);
+    size_t _shape[ULAB_MAX_DIMS] = { 0 };
+    for(uint8_t i = 0; i < ndim; i++) {
+        _shape[ULAB_MAX_DIMS - ndim + i] = shape[i];
+    }
+    return MP_OBJ_FROM_PTR(ndarray_new_dense_ndarray(ndim, _shape, dtype));
+}
+
+mp_obj_t ulab_api_wrap_array(uint8_t ndim, const size_t *shape, const int32_t *strides, uint8_t dtype, void *data, mp_obj_t owner) {
+    ulab_api_check_arguments(ndim, dtype);
+    ndarray_obj_t *ndarray = m_new0(ndarray_obj_t, 1);
+    ndarray->base.type = &ulab_ndarray_type;
+    ndarray->dtype = dtype == NDARRAY_BOOL ? NDARRAY_UINT8 : dtype;
+    ndarray->boolean = dtype == NDARRAY_BOOL ? NDARRAY_BOOLEAN : NDARRAY_NUMERIC;
+    ndarray->itemsize = ulab_binary_get_size(dtype);
+    ndarray->ndim = ndim;
+    ndarray->len = 1;
+
+    int32_t stride = ndarray->itemsize;
+    for(uint8_t i = ndim; i > 0; i--) {
+        ndarray->shape[ULAB_MAX_DIMS - ndim + i - 1] = shape[i - 1];
+        ndarray->strides[ULAB_MAX_DIMS - ndim + i - 1] = strides == NULL ? stride : strides[i - 1];
+        stride *= MAX(1, shape[i - 1]);
+        ndarray->len *= shape[i - 1];
+    }
+    ndarray->array = data;
+    ndarray->origin = owner == MP_OBJ_NULL ? data : MP_OBJ_TO_PTR(owner);
+    return MP_OBJ_FROM_PTR(ndarray);
+}
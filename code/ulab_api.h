@@ -0,0 +1,55 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#ifndef _ULAB_API_
+#define _ULAB_API_
+
+// C interface for native modules that exchange data with ulab without copying.
+// The functions here do not depend on the internal layout of ndarray_obj_t, so
+// code written against this header keeps working, when the layout changes.
+// ULAB_API_VERSION is incremented, whenever an incompatible change is made.
+
+#include "py/obj.h"
+#include "ulab.h"
+
+#define ULAB_API_VERSION        (1)
+
+typedef struct _ulab_array_info_t {
+    // the typecode of the dtype, i.e., 'B', 'b', 'H', 'h', 'i', 'I', 'e', 'c', or FLOAT_TYPECODE,
+    // and true, if the array is Boolean (in this case, dtype is 'B'); the functions below raise
+    // a TypeError for the dtypes that have been excluded from the firmware
+    uint8_t dtype;
+    bool boolean;
+    uint8_t itemsize;
+    uint8_t ndim;
+    size_t len;
+    // the shape, and the strides in bytes, in the order of the axes, i.e., shape[0] is
+    // the length of the first axis, and entries beyond ndim are not used
+    size_t shape[ULAB_MAX_DIMS];
+    int32_t strides[ULAB_MAX_DIMS];
+    // true, if the items are contiguous, and in C order
+    bool dense;
+    // pointer to the first item
+    void *data;
+} ulab_array_info_t;
+
+// Fills info, and returns true, if obj is an ndarray, otherwise, returns false.
+bool ulab_api_get_array_info(mp_obj_t , ulab_array_info_t *);
+
+// Creates a dense, zero-initialised array with ndim, shape (in the order of the axes), and dtype.
+mp_obj_t ulab_api_new_array(uint8_t , const size_t *, uint8_t );
+
+// Wraps an existing segment of memory as an ndarray, without copying. If strides is NULL,
+// the array is dense. owner, if not MP_OBJ_NULL, is the object holding the memory, and is
+// kept alive for as long as the array exists. Memory outside of the heap must remain valid
+// for the lifetime of the array.
+mp_obj_t ulab_api_wrap_array(uint8_t , const size_t *, const int32_t *, uint8_t , void *, mp_obj_t );
+
+#endif
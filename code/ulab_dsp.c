@@ -0,0 +1,139 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#include <string.h>
+#include "py/runtime.h"
+
+#include "ulab.h"
+#include "ulab_dsp.h"
+
+#if ULAB_DSP_BACKEND == ULAB_DSP_BACKEND_CMSIS
+#include "arm_math.h"
+#elif ULAB_DSP_BACKEND == ULAB_DSP_BACKEND_ESPDSP
+#include "esp_dsp.h"
+#endif
+
+#if ULAB_DSP_BACKEND != ULAB_DSP_BACKEND_NONE
+
+static void ulab_dsp_conjugate(mp_float_t *data, size_t n) {
+    for(size_t i = 0; i < n; i++) {
+        data[2 * i + 1] = -data[2 * i + 1];
+    }
+}
+
+bool ulab_dsp_cfft(mp_float_t *data, size_t n, int isign) {
+    #if ULAB_DSP_BACKEND == ULAB_DSP_BACKEND_CMSIS
+    // CMSIS-DSP has tables for the lengths 16...4096 only
+    arm_cfft_instance_f32 instance;
+    if((n > 4096) || (arm_cfft_init_f32(&instance, (uint16_t)n) != ARM_MATH_SUCCESS)) {
+        return false;
+    }
+    #else
+    // the twiddle factors of ESP-DSP are allocated once, for the largest configured length
+    static bool initialised = false;
+    if((n < 2) || (n > CONFIG_DSP_MAX_FFT_SIZE)) {
+        return false;
+    }
+    if(!initialised) {
+        if(dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE) != ESP_OK) {
+            return false;
+        }
+        initialised = true;
+    }
+    #endif
+
+    // the inverse of the vendor libraries is either missing, or normalised,
+    // hence the inverse transform is calculated as the conjugate of the forward
+    // transform of the conjugate
+    if(isign != 1) {
+        ulab_dsp_conjugate(data, n);
+    }
+    #if ULAB_DSP_BACKEND == ULAB_DSP_BACKEND_CMSIS
+    arm_cfft_f32(&instance, data, 0, 1);
+    #else
+    dsps_fft2r_fc32(data, n);
+    dsps_bit_rev_fc32(data, n);
+    #endif
+    if(isign != 1) {
+        ulab_dsp_conjugate(data, n);
+    }
+    return true;
+}
+
+bool ulab_dsp_matmul(const mp_float_t *a, const mp_float_t *b, mp_float_t *c, size_t m, size_t k, size_t n) {
+    #if ULAB_DSP_BACKEND == ULAB_DSP_BACKEND_CMSIS
+    if((m > UINT16_MAX) || (k > UINT16_MAX) || (n > UINT16_MAX)) {
+        return false;
+    }
+    arm_matrix_instance_f32 A, B, C;
+    arm_mat_init_f32(&A, (uint16_t)m, (uint16_t)k, (float32_t *)a);
+    arm_mat_init_f32(&B, (uint16_t)k, (uint16_t)n, (float32_t *)b);
+    arm_mat_init_f32(&C, (uint16_t)m, (uint16_t)n, c);
+    return arm_mat_mult_f32(&A, &B, &C) == ARM_MATH_SUCCESS;
+    #else
+    return dspm_mult_f32(a, b, c, (int)m, (int)k, (int)n) == ESP_OK;
+    #endif
+}
+
+bool ulab_dsp_convolve(const mp_float_t *a, size_t len_a, const mp_float_t *c, size_t len_c, mp_float_t *out) {
+    #if ULAB_DSP_BACKEND == ULAB_DSP_BACKEND_CMSIS
+    arm_conv_f32((float32_t *)a, (uint32_t)len_a, (float32_t *)c, (uint32_t)len_c, out);
+    return true;
+    #else
+    // the signal must not be shorter than the kernel
+    if(len_a < len_c) {
+        return dsps_conv_f32(c, (int)len_c, a, (int)len_a, out) == ESP_OK;
+    }
+    return dsps_conv_f32(a, (int)len_a, c, (int)len_c, out) == ESP_OK;
+    #endif
+}
+
+bool ulab_dsp_biquad(mp_float_t *x, size_t len, const mp_float_t *coeffs, mp_float_t *z, size_t lensos) {
+    // coeffs holds b0, b1, b2, a0, a1, a2 for each section, and z the two delays
+    // of the transposed direct form II for each section
+    #if ULAB_DSP_BACKEND == ULAB_DSP_BACKEND_CMSIS
+    // CMSIS-DSP implements the same form, but adds the feedback terms
+    if(lensos > UINT8_MAX) {
+        return false;
+    }
+    float32_t *c = m_new(float32_t, 5 * lensos);
+    for(size_t s = 0; s < lensos; s++) {
+        c[5 * s] = coeffs[6 * s];
+        c[5 * s + 1] = coeffs[6 * s + 1];
+        c[5 * s + 2] = coeffs[6 * s + 2];
+        c[5 * s + 3] = -coeffs[6 * s + 4];
+        c[5 * s + 4] = -coeffs[6 * s + 5];
+    }
+    arm_biquad_cascade_df2T_instance_f32 instance;
+    arm_biquad_cascade_df2T_init_f32(&instance, (uint8_t)lensos, c, z);
+    arm_biquad_cascade_df2T_f32(&instance, x, x, (uint32_t)len);
+    m_del(float32_t, c, 5 * lensos);
+    return true;
+    #else
+    // ESP-DSP implements direct form II, whose delays are different; only a filter
+    // at rest is handed over, and the final delays are converted to the transposed form
+    for(size_t s = 0; s < 2 * lensos; s++) {
+        if(z[s] != MICROPY_FLOAT_CONST(0.0)) {
+            return false;
+        }
+    }
+    for(size_t s = 0; s < lensos; s++) {
+        const mp_float_t *c = coeffs + 6 * s;
+        float coef[5] = { c[0], c[1], c[2], c[4], c[5] };
+        float w[2] = { 0.0f, 0.0f };
+        dsps_biquad_f32(x, x, (int)len, coef, w);
+        z[2 * s] = (c[1] - c[0] * c[4]) * w[0] + (c[2] - c[0] * c[5]) * w[1];
+        z[2 * s + 1] = (c[2] - c[0] * c[5]) * w[0] + (c[4] * c[2] - c[5] * c[1]) * w[1];
+    }
+    return true;
+    #endif
+}
+
+#endif /* ULAB_DSP_BACKEND != ULAB_DSP_BACKEND_NONE */
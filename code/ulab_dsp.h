@@ -0,0 +1,45 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#ifndef _ULAB_DSP_
+#define _ULAB_DSP_
+
+#include "ulab.h"
+#include "ndarray.h"
+
+// Each of the following functions returns true, if the vendor library has done the work,
+// and false, if the arguments are not supported by the library, in which case the caller
+// falls back to its own implementation. All arrays are dense float arrays.
+
+#if ULAB_DSP_BACKEND == ULAB_DSP_BACKEND_NONE
+
+#define ulab_dsp_cfft(data, n, isign)                           (false)
+#define ulab_dsp_matmul(a, b, c, m, k, n)                       (false)
+#define ulab_dsp_convolve(a, len_a, c, len_c, out)              (false)
+#define ulab_dsp_biquad(x, len, coeffs, z, lensos)              (false)
+
+#else
+
+#if MICROPY_FLOAT_IMPL != MICROPY_FLOAT_IMPL_FLOAT
+#error "the DSP backends require single-precision floats"
+#endif
+
+// the unnormalised, in-place transform of n interleaved complex numbers, n is a power of 2
+bool ulab_dsp_cfft(mp_float_t *, size_t , int );
+// c (m x n) = a (m x k) times b (k x n)
+bool ulab_dsp_matmul(const mp_float_t *, const mp_float_t *, mp_float_t *, size_t , size_t , size_t );
+// the full convolution of a, and c, out holds len_a + len_c - 1 values
+bool ulab_dsp_convolve(const mp_float_t *, size_t , const mp_float_t *, size_t , mp_float_t *);
+// the cascade of lensos biquads, with the coefficients and the delays of sosfilt, in place
+bool ulab_dsp_biquad(mp_float_t *, size_t , const mp_float_t *, mp_float_t *, size_t );
+
+#endif /* ULAB_DSP_BACKEND */
+
+#endif /* _ULAB_DSP_ */
@@ -0,0 +1,96 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#include "py/runtime.h"
+#include "py/mphal.h"
+
+#include "ulab.h"
+#include "ulab_job.h"
+
+#if ULAB_HAS_JOBS
+
+void *ulab_job_init(void *job_in, ulab_job_slice_t slice) {
+    ulab_job_obj_t *job = (ulab_job_obj_t *)job_in;
+    job->base.type = &ulab_job_type;
+    job->slice = slice;
+    job->result = mp_const_none;
+    job->done = false;
+    return job;
+}
+
+//| class job:
+//|     """A resumable computation, as returned by `ulab.numpy.aconvolve`, and `ulab.numpy.fft.afft`"""
+//|
+//|     def step(self, budget_us: int = 0) -> bool:
+//|         """Advance the computation by at least one slice, and then by further slices, until
+//|         ``budget_us`` microseconds have elapsed. Return ``True``, if the result is ready."""
+//|         ...
+//|
+//|     def result(self) -> Any:
+//|         """Return the result of the completed computation"""
+//|         ...
+//|
+
+static mp_obj_t ulab_job_step(size_t n_args, const mp_obj_t *args) {
+    ulab_job_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_uint_t budget = n_args == 2 ? (mp_uint_t)mp_obj_get_int(args[1]) : 0;
+    if(!self->done) {
+        // the difference of the ticks is correct, even if the counter wraps around in between
+        mp_uint_t start = mp_hal_ticks_us();
+        do {
+            self->done = self->slice(self);
+        } while(!self->done && ((mp_uint_t)(mp_hal_ticks_us() - start) < budget));
+    }
+    return mp_obj_new_bool(self->done);
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ulab_job_step_obj, 1, 2, ulab_job_step);
+
+static mp_obj_t ulab_job_result(mp_obj_t self_in) {
+    ulab_job_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if(!self->done) {
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("job has not been completed"));
+    }
+    return self->result;
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_1(ulab_job_result_obj, ulab_job_result);
+
+static void ulab_job_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    (void)kind;
+    ulab_job_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_printf(print, "job(done=%s)", self->done ? "True" : "False");
+}
+
+static const mp_rom_map_elem_t ulab_job_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_step), MP_ROM_PTR(&ulab_job_step_obj) },
+    { MP_ROM_QSTR(MP_QSTR_result), MP_ROM_PTR(&ulab_job_result_obj) },
+};
+
+static MP_DEFINE_CONST_DICT(ulab_job_locals_dict, ulab_job_locals_dict_table);
+
+#if defined(MP_DEFINE_CONST_OBJ_TYPE)
+MP_DEFINE_CONST_OBJ_TYPE(
+    ulab_job_type,
+    MP_QSTR_job,
+    MP_TYPE_FLAG_NONE,
+    print, ulab_job_print,
+    locals_dict, &ulab_job_locals_dict
+);
+#else
+const mp_obj_type_t ulab_job_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_job,
+    .print = ulab_job_print,
+    .locals_dict = (mp_obj_dict_t*)&ulab_job_locals_dict,
+};
+#endif
+
+#endif /* ULAB_HAS_JOBS */
@@ -0,0 +1,45 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#ifndef _ULAB_JOB_
+#define _ULAB_JOB_
+
+#include <stdbool.h>
+#include "py/obj.h"
+#include "ulab.h"
+
+#define ULAB_HAS_JOBS   (ULAB_NUMPY_HAS_ACONVOLVE | ULAB_FFT_HAS_AFFT)
+
+#if ULAB_HAS_JOBS
+// A job is a kernel, whose loop coordinates are stored in the object, so that the work can be
+// done in slices, and the interpreter, e.g., the scheduler of asyncio, can run in between.
+// The concrete jobs embed this structure as their first member, and supply the slice function,
+// which advances the job by a bounded amount of work, and returns true on completion.
+typedef struct _ulab_job_obj_t ulab_job_obj_t;
+
+typedef bool (*ulab_job_slice_t)(ulab_job_obj_t *);
+
+struct _ulab_job_obj_t {
+    mp_obj_base_t base;
+    ulab_job_slice_t slice;
+    // the object returned by result(); it can be allocated up front, since it is not
+    // handed out, before the job has been completed
+    mp_obj_t result;
+    bool done;
+};
+
+extern const mp_obj_type_t ulab_job_type;
+
+#define ulab_new_job(type, slice_fun)      ((type *)ulab_job_init(m_new_obj(type), (slice_fun)))
+
+void *ulab_job_init(void *, ulab_job_slice_t );
+#endif /* ULAB_HAS_JOBS */
+
+#endif
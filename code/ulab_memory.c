@@ -0,0 +1,304 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#include <string.h>
+#include "py/runtime.h"
+
+#include "ulab.h"
+#include "ulab_memory.h"
+#include "ulab_profile.h"
+#include "scipy/signal/signal.h"
+
+#if ULAB_HAS_EXTERNAL_MEMORY
+
+#if !MICROPY_ENABLE_FINALISER
+#error "ULAB_HAS_EXTERNAL_MEMORY requires MICROPY_ENABLE_FINALISER"
+#endif
+
+#ifndef ULAB_EXTERNAL_CALLOC
+#if defined(ESP_PLATFORM)
+#include "esp_heap_caps.h"
+#define ULAB_EXTERNAL_CALLOC(size)          heap_caps_calloc(1, (size), MALLOC_CAP_SPIRAM)
+#define ULAB_EXTERNAL_FREE(ptr)             heap_caps_free(ptr)
+#else
+#include <stdlib.h>
+#define ULAB_EXTERNAL_CALLOC(size)          calloc(1, (size))
+#define ULAB_EXTERNAL_FREE(ptr)             free(ptr)
+#endif
+#endif /* ULAB_EXTERNAL_CALLOC */
+
+// The block is referenced by the origin of the array, and of all its views, so that
+// the payload is released only after the last of them has been collected.
+typedef struct _ulab_memory_block_t {
+    mp_obj_base_t base;
+    void *payload;
+} ulab_memory_block_t;
+
+static mp_obj_t ulab_memory_block_del(mp_obj_t self_in) {
+    ulab_memory_block_t *self = MP_OBJ_TO_PTR(self_in);
+    if(self->payload != NULL) {
+        ULAB_EXTERNAL_FREE(self->payload);
+        self->payload = NULL;
+    }
+    return mp_const_none;
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_1(ulab_memory_block_del_obj, ulab_memory_block_del);
+
+static const mp_rom_map_elem_t ulab_memory_block_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&ulab_memory_block_del_obj) },
+};
+
+static MP_DEFINE_CONST_DICT(ulab_memory_block_locals_dict, ulab_memory_block_locals_dict_table);
+
+#if defined(MP_DEFINE_CONST_OBJ_TYPE)
+MP_DEFINE_CONST_OBJ_TYPE(
+    ulab_memory_block_type,
+    MP_QSTR_,
+    MP_TYPE_FLAG_NONE,
+    locals_dict, &ulab_memory_block_locals_dict
+);
+#else
+const mp_obj_type_t ulab_memory_block_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_,
+    .locals_dict = (mp_obj_dict_t*)&ulab_memory_block_locals_dict,
+};
+#endif
+
+static void *ulab_memory_external_calloc(size_t size, void **origin) {
+    // the block is allocated first, so that the payload cannot leak, if the heap is exhausted
+    ulab_memory_block_t *block = m_new_obj_with_finaliser(ulab_memory_block_t);
+    block->base.type = &ulab_memory_block_type;
+    block->payload = ULAB_EXTERNAL_CALLOC(size);
+    *origin = block;
+    return block->payload;
+}
+#endif /* ULAB_HAS_EXTERNAL_MEMORY */
+
+uint8_t ulab_memory_get_policy(mp_obj_t memory) {
+    if(memory == mp_const_none) {
+        return ULAB_MEMORY_AUTO;
+    }
+    size_t len;
+    const char *policy = mp_obj_str_get_data(memory, &len);
+    if((len == 2) && (memcmp(policy, "gc", 2) == 0)) {
+        return ULAB_MEMORY_GC;
+    }
+    if((len == 8) && (memcmp(policy, "external", 8) == 0)) {
+        #if ULAB_HAS_EXTERNAL_MEMORY
+        return ULAB_MEMORY_EXTERNAL;
+        #else
+        mp_raise_ValueError(MP_ERROR_TEXT("external memory is not supported"));
+        #endif
+    }
+    mp_raise_ValueError(MP_ERROR_TEXT("memory must be 'gc', or 'external'"));
+}
+
+void *ulab_memory_calloc(size_t size, uint8_t policy, void **origin) {
+    #if ULAB_HAS_EXTERNAL_MEMORY
+    #if ULAB_EXTERNAL_MEMORY_THRESHOLD > 0
+    if((policy == ULAB_MEMORY_EXTERNAL) || ((policy == ULAB_MEMORY_AUTO) && (size >= ULAB_EXTERNAL_MEMORY_THRESHOLD))) {
+    #else
+    // without a threshold, only the explicit requests are placed in the external memory
+    if(policy == ULAB_MEMORY_EXTERNAL) {
+    #endif
+        void *payload = ulab_memory_external_calloc(size, origin);
+        if(payload != NULL) {
+            return payload;
+        }
+        if(policy == ULAB_MEMORY_EXTERNAL) {
+            m_malloc_fail(size);
+        }
+        // if the external memory is exhausted, the array is still placed on the heap
+    }
+    #else
+    (void)policy;
+    #endif
+    void *array = m_new0(byte, size);
+    *origin = array;
+    return array;
+}
+
+#if ULAB_HAS_WORKSPACE
+// The workspace is a stack of blocks, each preceded by a header. Releasing a block marks it as
+// free, and then all free blocks are popped from the top of the stack. If a kernel raises an
+// exception, its blocks are never released; they are reclaimed, when the workspace is set again.
+typedef struct _ulab_scratch_header_t {
+    size_t previous;
+    size_t used;
+} ulab_scratch_header_t;
+
+#define ULAB_SCRATCH_ALIGNMENT              (8)
+#define ULAB_SCRATCH_ALIGN(n)               (((n) + ULAB_SCRATCH_ALIGNMENT - 1) & ~(size_t)(ULAB_SCRATCH_ALIGNMENT - 1))
+#define ULAB_SCRATCH_HEADER_SIZE            ULAB_SCRATCH_ALIGN(sizeof(ulab_scratch_header_t))
+#define ULAB_SCRATCH_NONE                   ((size_t)-1)
+
+typedef struct _ulab_workspace_t {
+    uint8_t *base;
+    size_t size;
+    size_t top;
+    size_t last;
+    // once a workspace has been set, blocks from the heap are left to the garbage collector,
+    // because a block of a previous workspace cannot be told apart from a heap block
+    bool heap_is_shared;
+} ulab_workspace_t;
+
+static ulab_workspace_t ulab_workspace = { NULL, 0, 0, ULAB_SCRATCH_NONE, false };
+
+// the buffer object is stored in the root pointers, so that it is not collected
+MP_REGISTER_ROOT_POINTER(mp_obj_t ulab_workspace);
+
+static bool ulab_workspace_is_set(void) {
+    // base is valid only, as long as the root pointer holds the buffer, from which it was taken
+    return (ulab_workspace.base != NULL) && (MP_STATE_VM(ulab_workspace) != MP_OBJ_NULL);
+}
+
+static void ulab_workspace_reset(void) {
+    ulab_workspace.base = NULL;
+    ulab_workspace.size = 0;
+    ulab_workspace.top = 0;
+    ulab_workspace.last = ULAB_SCRATCH_NONE;
+    MP_STATE_VM(ulab_workspace) = MP_OBJ_NULL;
+}
+
+void *ulab_scratch_alloc(size_t size) {
+    ULAB_STATE_CHECK();
+    size_t required = ULAB_SCRATCH_HEADER_SIZE + ULAB_SCRATCH_ALIGN(size);
+    if(ulab_workspace_is_set() && (required <= ulab_workspace.size - ulab_workspace.top)) {
+        ulab_scratch_header_t *header = (ulab_scratch_header_t *)(ulab_workspace.base + ulab_workspace.top);
+        header->previous = ulab_workspace.last;
+        header->used = 1;
+        ulab_workspace.last = ulab_workspace.top;
+        ulab_workspace.top += required;
+        return (uint8_t *)header + ULAB_SCRATCH_HEADER_SIZE;
+    }
+    ULAB_PROFILE_ALLOC(size);
+    return m_new(uint8_t, size);
+}
+
+void *ulab_scratch_alloc0(size_t size) {
+    void *block = ulab_scratch_alloc(size);
+    memset(block, 0, size);
+    return block;
+}
+
+void ulab_scratch_free(void *ptr, size_t size) {
+    uint8_t *block = (uint8_t *)ptr;
+    if(ulab_workspace_is_set() && (block >= ulab_workspace.base) && (block < ulab_workspace.base + ulab_workspace.size)) {
+        ulab_scratch_header_t *header = (ulab_scratch_header_t *)(block - ULAB_SCRATCH_HEADER_SIZE);
+        header->used = 0;
+        while(ulab_workspace.last != ULAB_SCRATCH_NONE) {
+            header = (ulab_scratch_header_t *)(ulab_workspace.base + ulab_workspace.last);
+            if(header->used) {
+                break;
+            }
+            ulab_workspace.top = ulab_workspace.last;
+            ulab_workspace.last = header->previous;
+        }
+    } else if(!ulab_workspace.heap_is_shared) {
+        m_del(uint8_t, block, size);
+    }
+}
+
+//| def set_workspace(buffer: Optional[bytearray]) -> None:
+//|     """
+//|     :param buffer: a writable buffer, or None
+//|
+//|     Set the buffer, from which the kernels take their scratch memory, or release the buffer, if None."""
+//|     ...
+//|
+
+static mp_obj_t ulab_memory_set_workspace(mp_obj_t buffer) {
+    ULAB_STATE_CHECK();
+    ulab_workspace_reset();
+    ulab_workspace.heap_is_shared = true;
+    if(buffer != mp_const_none) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_RW);
+        uint8_t *base = (uint8_t *)bufinfo.buf;
+        size_t offset = ULAB_SCRATCH_ALIGN((uintptr_t)base) - (uintptr_t)base;
+        if(bufinfo.len > offset) {
+            ulab_workspace.base = base + offset;
+            ulab_workspace.size = (bufinfo.len - offset) & ~(size_t)(ULAB_SCRATCH_ALIGNMENT - 1);
+            MP_STATE_VM(ulab_workspace) = buffer;
+        }
+    }
+    return mp_const_none;
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(ulab_memory_set_workspace_obj, ulab_memory_set_workspace);
+
+void ulab_memory_init(void) {
+    // the root pointers survive a soft reset, but the heap does not
+    ulab_workspace_reset();
+    ulab_workspace.heap_is_shared = false;
+}
+#endif /* ULAB_HAS_WORKSPACE */
+
+#if ULAB_HAS_STATE
+void ulab_state_reset(void) {
+    // drops everything that refers to the heap of the previous session
+    #if ULAB_HAS_WORKSPACE
+    ulab_memory_init();
+    #endif
+    #if ULAB_HAS_PROFILING
+    ulab_profile_reset();
+    #endif
+    #if ULAB_SCIPY_SIGNAL_HAS_WELCH | ULAB_SCIPY_SIGNAL_HAS_STFT
+    signal_spectral_reset();
+    #endif
+}
+
+#if !MICROPY_MODULE_BUILTIN_INIT && MICROPY_ENABLE_FINALISER
+MP_REGISTER_ROOT_POINTER(mp_obj_t ulab_state);
+
+static mp_obj_t ulab_state_del(mp_obj_t self_in) {
+    (void)self_in;
+    ulab_state_reset();
+    MP_STATE_VM(ulab_state) = MP_OBJ_NULL;
+    return mp_const_none;
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_1(ulab_state_del_obj, ulab_state_del);
+
+static const mp_rom_map_elem_t ulab_state_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&ulab_state_del_obj) },
+};
+
+static MP_DEFINE_CONST_DICT(ulab_state_locals_dict, ulab_state_locals_dict_table);
+
+#if defined(MP_DEFINE_CONST_OBJ_TYPE)
+static MP_DEFINE_CONST_OBJ_TYPE(
+    ulab_state_type,
+    MP_QSTR_,
+    MP_TYPE_FLAG_NONE,
+    locals_dict, &ulab_state_locals_dict
+);
+#else
+static const mp_obj_type_t ulab_state_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_,
+    .locals_dict = (mp_obj_dict_t*)&ulab_state_locals_dict,
+};
+#endif
+
+void ulab_state_check(void) {
+    if(MP_STATE_VM(ulab_state) == MP_OBJ_NULL) {
+        // this is the first call of the session, and the states might have been left over
+        // by a previous one, whose heap was not swept
+        ulab_state_reset();
+        mp_obj_base_t *state = m_new_obj_with_finaliser(mp_obj_base_t);
+        state->type = &ulab_state_type;
+        MP_STATE_VM(ulab_state) = MP_OBJ_FROM_PTR(state);
+    }
+}
+#endif
+#endif /* ULAB_HAS_STATE */
@@ -0,0 +1,71 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#ifndef _ULAB_MEMORY_
+#define _ULAB_MEMORY_
+
+#include "py/obj.h"
+#include "ulab.h"
+
+enum ULAB_MEMORY {
+    ULAB_MEMORY_AUTO,
+    ULAB_MEMORY_GC,
+    ULAB_MEMORY_EXTERNAL,
+};
+
+uint8_t ulab_memory_get_policy(mp_obj_t );
+
+// Returns a zeroed buffer of the requested size. origin is the pointer that the GC has to see,
+// in order to keep the buffer alive: for GC memory, this is the buffer itself, while for
+// external memory, a small heap object, whose finaliser releases the buffer.
+void *ulab_memory_calloc(size_t , uint8_t , void **);
+
+
+// Scratch buffers of the kernels. If a workspace has been set, they are taken from it, otherwise
+// (or, if there is not enough room in the workspace), from the heap. Buffers can be released in
+// any order, but the space is reclaimed only from the top of the workspace, hence buffers should,
+// preferably, be released in the reverse order of their allocation.
+#if ULAB_HAS_WORKSPACE
+void *ulab_scratch_alloc(size_t );
+void *ulab_scratch_alloc0(size_t );
+void ulab_scratch_free(void *, size_t );
+
+#define ulab_scratch_new(type, num)         ((type *)ulab_scratch_alloc(sizeof(type) * (num)))
+#define ulab_scratch_new0(type, num)        ((type *)ulab_scratch_alloc0(sizeof(type) * (num)))
+#define ulab_scratch_del(type, ptr, num)    ulab_scratch_free((ptr), sizeof(type) * (num))
+
+MP_DECLARE_CONST_FUN_OBJ_1(ulab_memory_set_workspace_obj);
+void ulab_memory_init(void);
+#else
+#define ulab_scratch_new(type, num)         m_new(type, num)
+#define ulab_scratch_new0(type, num)        m_new0(type, num)
+#define ulab_scratch_del(type, ptr, num)    m_del(type, ptr, num)
+#endif /* ULAB_HAS_WORKSPACE */
+
+// The workspace, the cache of the spectral functions of scipy.signal, and the statistics of the
+// profiler are kept between calls, and have to be dropped at a soft reset. This is done by
+// ulab.__init__, or, if the port does not call it, by the finaliser of an object that is reachable
+// through a root pointer only, and is, therefore, collected only, when the heap is swept at the
+// soft reset. ULAB_STATE_CHECK() must be called, before any of the states is accessed.
+#define ULAB_HAS_STATE                      (ULAB_HAS_WORKSPACE | ULAB_HAS_PROFILING | ULAB_SCIPY_SIGNAL_HAS_WELCH | ULAB_SCIPY_SIGNAL_HAS_STFT)
+
+#if ULAB_HAS_STATE
+void ulab_state_reset(void);
+#if !MICROPY_MODULE_BUILTIN_INIT && MICROPY_ENABLE_FINALISER
+void ulab_state_check(void);
+#define ULAB_STATE_CHECK()                  ulab_state_check()
+#endif
+#endif /* ULAB_HAS_STATE */
+
+#ifndef ULAB_STATE_CHECK
+#define ULAB_STATE_CHECK()
+#endif
+
+#endif
@@ -0,0 +1,189 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#include <stdbool.h>
+#include "py/mpconfig.h"
+
+#include "ulab.h"
+#include "ulab_parallel.h"
+
+#if ULAB_HAS_PARALLEL
+
+// A port can supply its own secondary core by defining
+//
+//     bool ULAB_PARALLEL_LAUNCH(ulab_parallel_job_t *job)
+//     void ULAB_PARALLEL_WAIT(ulab_parallel_job_t *job)
+//
+// The first one should call ulab_parallel_run_job(job) on the secondary core, and return
+// true, or return false, if the core is not available; the second one should block, until
+// the job has been completed. Otherwise, the hooks below are used on the rp2, and esp32 ports.
+
+#if !defined(ULAB_PARALLEL_LAUNCH) && defined(ESP_PLATFORM)
+#include "sdkconfig.h"
+#ifndef CONFIG_FREERTOS_UNICORE
+#define ULAB_PARALLEL_FREERTOS
+#endif
+#endif
+
+// with _thread, the second core of the RP2040/RP2350 belongs to the threads of the interpreter
+#if !defined(ULAB_PARALLEL_LAUNCH) && (defined(PICO_RP2040) || defined(PICO_RP2350)) && !MICROPY_PY_THREAD
+#define ULAB_PARALLEL_PICO
+#endif
+
+#if defined(ULAB_PARALLEL_FREERTOS)
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#ifndef ULAB_PARALLEL_STACK_SIZE
+#define ULAB_PARALLEL_STACK_SIZE            (2048)
+#endif
+
+// the worker task, and its semaphores are created on first use, and are never deleted;
+// since they are not on the heap of the interpreter, they survive a soft reset
+static TaskHandle_t ulab_parallel_task = NULL;
+static SemaphoreHandle_t ulab_parallel_start = NULL;
+static SemaphoreHandle_t ulab_parallel_done = NULL;
+static ulab_parallel_job_t *volatile ulab_parallel_job = NULL;
+
+static void ulab_parallel_worker(void *arg) {
+    (void)arg;
+    for(;;) {
+        xSemaphoreTake(ulab_parallel_start, portMAX_DELAY);
+        ulab_parallel_run_job(ulab_parallel_job);
+        xSemaphoreGive(ulab_parallel_done);
+    }
+}
+
+static bool ulab_parallel_launch(ulab_parallel_job_t *job) {
+    if(ulab_parallel_task == NULL) {
+        if(ulab_parallel_start == NULL) {
+            ulab_parallel_start = xSemaphoreCreateBinary();
+        }
+        if(ulab_parallel_done == NULL) {
+            ulab_parallel_done = xSemaphoreCreateBinary();
+        }
+        if((ulab_parallel_start == NULL) || (ulab_parallel_done == NULL)) {
+            return false;
+        }
+        // the worker is pinned to the core that does not run the interpreter
+        if(xTaskCreatePinnedToCore(ulab_parallel_worker, "ulab", ULAB_PARALLEL_STACK_SIZE, NULL,
+                        uxTaskPriorityGet(NULL), &ulab_parallel_task, 1 - xPortGetCoreID()) != pdPASS) {
+            ulab_parallel_task = NULL;
+            return false;
+        }
+    }
+    ulab_parallel_job = job;
+    xSemaphoreGive(ulab_parallel_start);
+    return true;
+}
+
+static void ulab_parallel_wait(ulab_parallel_job_t *job) {
+    (void)job;
+    xSemaphoreTake(ulab_parallel_done, portMAX_DELAY);
+}
+
+#define ULAB_PARALLEL_LAUNCH(job)           ulab_parallel_launch(job)
+#define ULAB_PARALLEL_WAIT(job)             ulab_parallel_wait(job)
+
+#elif defined(ULAB_PARALLEL_PICO)
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+
+// core 1 is started on first use, and then waits for jobs; the pointer to the job is the only
+// shared state, it is set by core 0, and cleared by core 1, when the job has been completed
+static bool ulab_parallel_core1_running = false;
+static ulab_parallel_job_t *volatile ulab_parallel_job = NULL;
+
+static void ulab_parallel_core1_entry(void) {
+    // flash writes on core 0, e.g., by the file system, must be able to pause core 1
+    multicore_lockout_victim_init();
+    for(;;) {
+        while(ulab_parallel_job == NULL) {
+            __wfe();
+        }
+        ulab_parallel_run_job(ulab_parallel_job);
+        __dmb();
+        ulab_parallel_job = NULL;
+        __sev();
+    }
+}
+
+static bool ulab_parallel_launch(ulab_parallel_job_t *job) {
+    if(!ulab_parallel_core1_running) {
+        multicore_reset_core1();
+        multicore_launch_core1(ulab_parallel_core1_entry);
+        ulab_parallel_core1_running = true;
+    }
+    __dmb();
+    ulab_parallel_job = job;
+    __sev();
+    return true;
+}
+
+static void ulab_parallel_wait(ulab_parallel_job_t *job) {
+    (void)job;
+    while(ulab_parallel_job != NULL) {
+        __wfe();
+    }
+    __dmb();
+}
+
+#define ULAB_PARALLEL_LAUNCH(job)           ulab_parallel_launch(job)
+#define ULAB_PARALLEL_WAIT(job)             ulab_parallel_wait(job)
+#endif /* ULAB_PARALLEL_PICO */
+
+void ulab_parallel_run_job(ulab_parallel_job_t *job) {
+    job->kernel(job->context, job->start, job->end, 1);
+}
+
+#if defined(ULAB_PARALLEL_LAUNCH)
+// there is a single secondary core, hence nested calls run on the calling core only; the
+// interpreter threads are serialised by the GIL, but without one, two threads could claim
+// the core at the same time, so that the flag has to be taken atomically
+static volatile bool ulab_parallel_busy = false;
+
+#if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+#define ULAB_PARALLEL_CLAIM()               (!__atomic_test_and_set(&ulab_parallel_busy, __ATOMIC_ACQUIRE))
+#define ULAB_PARALLEL_RELEASE()             __atomic_clear(&ulab_parallel_busy, __ATOMIC_RELEASE)
+#else
+#define ULAB_PARALLEL_CLAIM()               (ulab_parallel_busy ? false : (ulab_parallel_busy = true))
+#define ULAB_PARALLEL_RELEASE()             (ulab_parallel_busy = false)
+#endif
+#endif
+
+bool ulab_parallel_is_running(void) {
+    #if defined(ULAB_PARALLEL_LAUNCH)
+    return ulab_parallel_busy;
+    #else
+    return false;
+    #endif
+}
+
+void ulab_parallel_for(ulab_parallel_kernel_t kernel, void *context, size_t len, size_t cost) {
+    #if defined(ULAB_PARALLEL_LAUNCH)
+    if((len > 1) && (cost > 0) && (len >= (ULAB_PARALLEL_THRESHOLD + cost - 1) / cost) && ULAB_PARALLEL_CLAIM()) {
+        // the halves are of equal size, so that neither core has to wait for long
+        ulab_parallel_job_t job = { .kernel = kernel, .context = context, .start = len / 2, .end = len };
+        if(ULAB_PARALLEL_LAUNCH(&job)) {
+            kernel(context, 0, len / 2, 0);
+            ULAB_PARALLEL_WAIT(&job);
+            ULAB_PARALLEL_RELEASE();
+            return;
+        }
+        ULAB_PARALLEL_RELEASE();
+    }
+    #else
+    (void)cost;
+    #endif
+    kernel(context, 0, len, 0);
+}
+
+#endif /* ULAB_HAS_PARALLEL */
@@ -0,0 +1,57 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#ifndef _ULAB_PARALLEL_
+#define _ULAB_PARALLEL_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ulab.h"
+
+// A kernel processes the items start...end - 1 of its context. core is 0 on the calling core,
+// and 1 on the secondary one, so that the kernel can select its own partial result, or scratch
+// buffer. Since the secondary core runs outside of the interpreter, a kernel must not allocate
+// on the heap, raise exceptions, or call python functions.
+typedef void (*ulab_parallel_kernel_t)(void *, size_t , size_t , uint8_t );
+
+#if ULAB_HAS_PARALLEL
+
+#define ULAB_PARALLEL_CORES                 (2)
+
+typedef struct _ulab_parallel_job_t {
+    ulab_parallel_kernel_t kernel;
+    void *context;
+    size_t start;
+    size_t end;
+} ulab_parallel_job_t;
+
+// Runs kernel on len items. If len * cost, i.e., the number of elements touched, is at least
+// ULAB_PARALLEL_THRESHOLD, and the secondary core is available, the upper half of the items is
+// processed on the secondary core, while the lower half is processed on the calling one. A cost
+// of 0 keeps the work on the calling core.
+void ulab_parallel_for(ulab_parallel_kernel_t , void *, size_t , size_t );
+
+// Called by the hooks of the port on the secondary core
+void ulab_parallel_run_job(ulab_parallel_job_t *);
+
+// Returns true, while a kernel is being shared between the cores
+bool ulab_parallel_is_running(void);
+
+#else
+
+#define ULAB_PARALLEL_CORES                 (1)
+
+#define ulab_parallel_for(kernel, context, len, cost)   (kernel)((context), 0, (len), 0)
+#define ulab_parallel_is_running()                      (false)
+
+#endif /* ULAB_HAS_PARALLEL */
+
+#endif /* _ULAB_PARALLEL_ */
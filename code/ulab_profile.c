@@ -0,0 +1,178 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#include <string.h>
+#include "py/runtime.h"
+#include "py/mphal.h"
+
+#include "ulab.h"
+#include "ulab_memory.h"
+#include "ulab_profile.h"
+
+#if ULAB_HAS_PROFILING
+
+// the counter, whose ticks are accumulated; it can be replaced by a port-specific cycle counter
+#ifndef ULAB_PROFILE_CYCLES
+#define ULAB_PROFILE_CYCLES()               ((uint32_t)mp_hal_ticks_cpu())
+#endif
+
+typedef struct _ulab_profile_entry_t {
+    qstr module;
+    qstr name;
+    size_t calls;
+    size_t bytes;
+    uint64_t cycles;
+} ulab_profile_entry_t;
+
+// the entries hold no pointers to the heap, so that they can live outside of it
+static ulab_profile_entry_t ulab_profile_entries[ULAB_PROFILE_MAX_FUNCTIONS];
+static size_t ulab_profile_count = 0;
+static size_t ulab_profile_allocated = 0;
+
+void ulab_profile_alloc(size_t bytes) {
+    ulab_profile_allocated += bytes;
+}
+
+static size_t ulab_profile_bytes(void) {
+    // with memory statistics, every allocation of the heap is seen, otherwise, only ulab's own
+    #if MICROPY_MEM_STATS
+    return m_get_total_bytes_allocated();
+    #else
+    return ulab_profile_allocated;
+    #endif
+}
+
+void ulab_profile_reset(void) {
+    ulab_profile_count = 0;
+}
+
+static ulab_profile_entry_t *ulab_profile_get_entry(qstr module, qstr name) {
+    // returns NULL, if the table is full
+    for(size_t i = 0; i < ulab_profile_count; i++) {
+        if((ulab_profile_entries[i].name == name) && (ulab_profile_entries[i].module == module)) {
+            return &ulab_profile_entries[i];
+        }
+    }
+    if(ulab_profile_count == ULAB_PROFILE_MAX_FUNCTIONS) {
+        return NULL;
+    }
+    ulab_profile_entry_t *entry = &ulab_profile_entries[ulab_profile_count++];
+    memset(entry, 0, sizeof(ulab_profile_entry_t));
+    entry->module = module;
+    entry->name = name;
+    return entry;
+}
+
+static void ulab_profile_update(ulab_profile_entry_t *entry, uint32_t start, size_t bytes) {
+    if(entry != NULL) {
+        entry->calls++;
+        entry->cycles += (uint32_t)(ULAB_PROFILE_CYCLES() - start);
+        entry->bytes += ulab_profile_bytes() - bytes;
+    }
+}
+
+static mp_obj_t ulab_profile_fun_call(mp_obj_t self_in, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    // the statistics are inclusive: if the function calls back into ulab, e.g., from the
+    // objective function of an optimiser, the nested calls are also accounted for here
+    ULAB_STATE_CHECK();
+    ulab_profile_fun_t *self = MP_OBJ_TO_PTR(self_in);
+    ulab_profile_entry_t *entry = ulab_profile_get_entry(self->module, self->name);
+    size_t bytes = ulab_profile_bytes();
+    uint32_t start = ULAB_PROFILE_CYCLES();
+
+    nlr_buf_t nlr;
+    if(nlr_push(&nlr) == 0) {
+        mp_obj_t result = mp_call_function_n_kw(MP_OBJ_FROM_PTR(self->fun), n_args, n_kw, args);
+        nlr_pop();
+        ulab_profile_update(entry, start, bytes);
+        return result;
+    }
+    // calls that raise an exception are counted, too
+    ulab_profile_update(entry, start, bytes);
+    nlr_jump(nlr.ret_val);
+}
+
+static void ulab_profile_fun_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    (void)kind;
+    ulab_profile_fun_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_printf(print, "<function %q>", self->name);
+}
+
+#if defined(MP_DEFINE_CONST_OBJ_TYPE)
+MP_DEFINE_CONST_OBJ_TYPE(
+    ulab_profile_fun_type,
+    MP_QSTR_function,
+    MP_TYPE_FLAG_NONE,
+    print, ulab_profile_fun_print,
+    call, ulab_profile_fun_call
+);
+#else
+const mp_obj_type_t ulab_profile_fun_type = {
+    { &mp_type_type },
+    .flags = MP_TYPE_FLAG_EXTENDED,
+    .name = MP_QSTR_function,
+    .print = ulab_profile_fun_print,
+    MP_TYPE_EXTENDED_FIELDS(
+    .call = ulab_profile_fun_call,
+    )
+};
+#endif
+
+//| def stats() -> dict:
+//|     """
+//|     Return a dictionary, whose keys are the names of the functions that have been called since
+//|     the last call to `stats_reset`, e.g., ``numpy.sort``, and whose values are the tuples
+//|     ``(calls, bytes, cycles)``. ``bytes`` is the number of bytes allocated on the heap (only by
+//|     ndarrays and scratch buffers, unless the firmware was compiled with ``MICROPY_MEM_STATS``),
+//|     and ``cycles`` is the number of ticks of ``time.ticks_cpu`` spent in the function.
+//|     The figures include nested calls into ulab.
+//|
+//|     Defined only, if the firmware was compiled with ``ULAB_HAS_PROFILING``."""
+//|     ...
+//|
+
+static mp_obj_t ulab_profile_stats(void) {
+    ULAB_STATE_CHECK();
+    mp_obj_t stats = mp_obj_new_dict(ulab_profile_count);
+    for(size_t i = 0; i < ulab_profile_count; i++) {
+        ulab_profile_entry_t *entry = &ulab_profile_entries[i];
+        // the key is the qualified name of the function
+        vstr_t vstr;
+        vstr_init(&vstr, 32);
+        vstr_add_str(&vstr, qstr_str(entry->module));
+        vstr_add_char(&vstr, '.');
+        vstr_add_str(&vstr, qstr_str(entry->name));
+        mp_obj_t key = mp_obj_new_str(vstr.buf, vstr.len);
+        vstr_clear(&vstr);
+
+        mp_obj_t tuple[3];
+        tuple[0] = mp_obj_new_int_from_uint(entry->calls);
+        tuple[1] = mp_obj_new_int_from_uint(entry->bytes);
+        tuple[2] = mp_obj_new_int_from_ull(entry->cycles);
+        mp_obj_dict_store(stats, key, mp_obj_new_tuple(3, tuple));
+    }
+    return stats;
+}
+
+MP_DEFINE_CONST_FUN_OBJ_0(ulab_profile_stats_obj, ulab_profile_stats);
+
+//| def stats_reset() -> None:
+//|     """Clear the statistics collected by `stats`."""
+//|     ...
+//|
+
+static mp_obj_t ulab_profile_stats_reset(void) {
+    ulab_profile_reset();
+    return mp_const_none;
+}
+
+MP_DEFINE_CONST_FUN_OBJ_0(ulab_profile_stats_reset_obj, ulab_profile_stats_reset);
+
+#endif /* ULAB_HAS_PROFILING */
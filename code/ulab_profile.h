@@ -0,0 +1,45 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#ifndef _ULAB_PROFILE_
+#define _ULAB_PROFILE_
+
+#include "py/obj.h"
+#include "ulab.h"
+
+#if ULAB_HAS_PROFILING
+// A function of a module table is wrapped in a constant profile object, whose call slot
+// counts the calls, the bytes allocated, and the cycles spent in the function, and then
+// hands over to the original function object.
+typedef struct _ulab_profile_fun_t {
+    mp_obj_base_t base;
+    qstr module;
+    qstr name;
+    const void *fun;
+} ulab_profile_fun_t;
+
+extern const mp_obj_type_t ulab_profile_fun_type;
+
+#define ULAB_PROFILE_PTR(module, name, obj) \
+    MP_ROM_PTR(&((const ulab_profile_fun_t){ { &ulab_profile_fun_type }, (module), (name), &(obj) }))
+
+#define ULAB_PROFILE_ALLOC(bytes)           ulab_profile_alloc(bytes)
+
+void ulab_profile_alloc(size_t );
+void ulab_profile_reset(void);
+
+MP_DECLARE_CONST_FUN_OBJ_0(ulab_profile_stats_obj);
+MP_DECLARE_CONST_FUN_OBJ_0(ulab_profile_stats_reset_obj);
+#else
+#define ULAB_PROFILE_PTR(module, name, obj) MP_ROM_PTR(&(obj))
+#define ULAB_PROFILE_ALLOC(bytes)
+#endif /* ULAB_HAS_PROFILING */
+
+#endif
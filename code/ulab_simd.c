@@ -0,0 +1,299 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#include <math.h>
+
+#include "py/runtime.h"
+
+#include "ulab.h"
+#include "ndarray.h"
+#include "ulab_simd.h"
+
+#if ULAB_SIMD_HAS_INT16 || ULAB_SIMD_HAS_FLOAT
+
+#if defined(ULAB_SIMD_MVE)
+#include <arm_mve.h>
+#elif defined(ULAB_SIMD_NEON)
+#include <arm_neon.h>
+#elif defined(ULAB_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+
+// The vector types, and operations are abstracted away by the following macros, so that
+// the kernels are identical on all architectures. The comparisons return a mask, which
+// is turned into Booleans by the MASK_STORE macros. MAX(a, b), and MIN(a, b) must be
+// a > b ? a : b, and a < b ? a : b, respectively, so that NaNs are treated as in the
+// scalar loops of compare.c.
+
+#if defined(ULAB_SIMD_SSE2)
+
+#define SIMD_I16_T                          __m128i
+#define SIMD_I16_LANES                      (8)
+#define SIMD_I16_LOAD(p)                    _mm_loadu_si128((const __m128i *)(p))
+#define SIMD_I16_STORE(p, v)                _mm_storeu_si128((__m128i *)(p), (v))
+#define SIMD_I16_SPLAT(x)                   _mm_set1_epi16((x))
+#define SIMD_I16_ADD(a, b)                  _mm_add_epi16((a), (b))
+#define SIMD_I16_SUBTRACT(a, b)             _mm_sub_epi16((a), (b))
+#define SIMD_I16_MULTIPLY(a, b)             _mm_mullo_epi16((a), (b))
+#define SIMD_I16_MAXIMUM(a, b)              _mm_max_epi16((a), (b))
+#define SIMD_I16_MINIMUM(a, b)              _mm_min_epi16((a), (b))
+#define SIMD_I16_MORE(a, b)                 _mm_cmpgt_epi16((a), (b))
+#define SIMD_I16_MORE_EQUAL(a, b)           _mm_or_si128(_mm_cmpgt_epi16((a), (b)), _mm_cmpeq_epi16((a), (b)))
+#define SIMD_I16_EQUAL(a, b)                _mm_cmpeq_epi16((a), (b))
+#define SIMD_I16_NOT_EQUAL(a, b)            _mm_xor_si128(_mm_cmpeq_epi16((a), (b)), _mm_set1_epi16(-1))
+#define SIMD_I16_MASK_STORE(p, m)           _mm_storel_epi64((__m128i *)(p), _mm_and_si128(_mm_packs_epi16((m), (m)), _mm_set1_epi8(1)))
+
+#if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_DOUBLE
+#define SIMD_FLOAT_T                        __m128d
+#define SIMD_FLOAT_LANES                    (2)
+#define SIMD_FLOAT_LOAD(p)                  _mm_loadu_pd((p))
+#define SIMD_FLOAT_STORE(p, v)              _mm_storeu_pd((p), (v))
+#define SIMD_FLOAT_SPLAT(x)                 _mm_set1_pd((x))
+#define SIMD_FLOAT_ADD(a, b)                _mm_add_pd((a), (b))
+#define SIMD_FLOAT_SUBTRACT(a, b)           _mm_sub_pd((a), (b))
+#define SIMD_FLOAT_MULTIPLY(a, b)           _mm_mul_pd((a), (b))
+#define SIMD_FLOAT_MAXIMUM(a, b)            _mm_max_pd((a), (b))
+#define SIMD_FLOAT_MINIMUM(a, b)            _mm_min_pd((a), (b))
+#define SIMD_FLOAT_SQRT(a)                  _mm_sqrt_pd((a))
+#define SIMD_FLOAT_MORE(a, b)               _mm_cmpgt_pd((a), (b))
+#define SIMD_FLOAT_MORE_EQUAL(a, b)         _mm_cmpge_pd((a), (b))
+#define SIMD_FLOAT_EQUAL(a, b)              _mm_cmpeq_pd((a), (b))
+#define SIMD_FLOAT_NOT_EQUAL(a, b)          _mm_cmpneq_pd((a), (b))
+#define SIMD_FLOAT_MASK_STORE(p, m) do {\
+    int _bits = _mm_movemask_pd((m));\
+    (p)[0] = _bits & 1;\
+    (p)[1] = (_bits >> 1) & 1;\
+} while(0)
+#else
+#define SIMD_FLOAT_T                        __m128
+#define SIMD_FLOAT_LANES                    (4)
+#define SIMD_FLOAT_LOAD(p)                  _mm_loadu_ps((p))
+#define SIMD_FLOAT_STORE(p, v)              _mm_storeu_ps((p), (v))
+#define SIMD_FLOAT_SPLAT(x)                 _mm_set1_ps((x))
+#define SIMD_FLOAT_ADD(a, b)                _mm_add_ps((a), (b))
+#define SIMD_FLOAT_SUBTRACT(a, b)           _mm_sub_ps((a), (b))
+#define SIMD_FLOAT_MULTIPLY(a, b)           _mm_mul_ps((a), (b))
+#define SIMD_FLOAT_MAXIMUM(a, b)            _mm_max_ps((a), (b))
+#define SIMD_FLOAT_MINIMUM(a, b)            _mm_min_ps((a), (b))
+#define SIMD_FLOAT_SQRT(a)                  _mm_sqrt_ps((a))
+#define SIMD_FLOAT_MORE(a, b)               _mm_cmpgt_ps((a), (b))
+#define SIMD_FLOAT_MORE_EQUAL(a, b)         _mm_cmpge_ps((a), (b))
+#define SIMD_FLOAT_EQUAL(a, b)              _mm_cmpeq_ps((a), (b))
+#define SIMD_FLOAT_NOT_EQUAL(a, b)          _mm_cmpneq_ps((a), (b))
+#define SIMD_FLOAT_MASK_STORE(p, m) do {\
+    int _bits = _mm_movemask_ps((m));\
+    for(uint8_t _i = 0; _i < 4; _i++) {\
+        (p)[_i] = (_bits >> _i) & 1;\
+    }\
+} while(0)
+#endif /* MICROPY_FLOAT_IMPL */
+
+#elif defined(ULAB_SIMD_NEON)
+
+#define SIMD_I16_T                          int16x8_t
+#define SIMD_I16_LANES                      (8)
+#define SIMD_I16_LOAD(p)                    vld1q_s16((p))
+#define SIMD_I16_STORE(p, v)                vst1q_s16((p), (v))
+#define SIMD_I16_SPLAT(x)                   vdupq_n_s16((x))
+#define SIMD_I16_ADD(a, b)                  vaddq_s16((a), (b))
+#define SIMD_I16_SUBTRACT(a, b)             vsubq_s16((a), (b))
+#define SIMD_I16_MULTIPLY(a, b)             vmulq_s16((a), (b))
+#define SIMD_I16_MAXIMUM(a, b)              vmaxq_s16((a), (b))
+#define SIMD_I16_MINIMUM(a, b)              vminq_s16((a), (b))
+#define SIMD_I16_MORE(a, b)                 vcgtq_s16((a), (b))
+#define SIMD_I16_MORE_EQUAL(a, b)           vcgeq_s16((a), (b))
+#define SIMD_I16_EQUAL(a, b)                vceqq_s16((a), (b))
+#define SIMD_I16_NOT_EQUAL(a, b)            vmvnq_u16(vceqq_s16((a), (b)))
+#define SIMD_I16_MASK_STORE(p, m)           vst1_u8((p), vand_u8(vmovn_u16((m)), vdup_n_u8(1)))
+
+#if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_DOUBLE
+// this branch is taken on aarch64 only
+#define SIMD_FLOAT_T                        float64x2_t
+#define SIMD_FLOAT_LANES                    (2)
+#define SIMD_FLOAT_LOAD(p)                  vld1q_f64((p))
+#define SIMD_FLOAT_STORE(p, v)              vst1q_f64((p), (v))
+#define SIMD_FLOAT_SPLAT(x)                 vdupq_n_f64((x))
+#define SIMD_FLOAT_ADD(a, b)                vaddq_f64((a), (b))
+#define SIMD_FLOAT_SUBTRACT(a, b)           vsubq_f64((a), (b))
+#define SIMD_FLOAT_MULTIPLY(a, b)           vmulq_f64((a), (b))
+#define SIMD_FLOAT_MAXIMUM(a, b)            vbslq_f64(vcgtq_f64((a), (b)), (a), (b))
+#define SIMD_FLOAT_MINIMUM(a, b)            vbslq_f64(vcltq_f64((a), (b)), (a), (b))
+#define SIMD_FLOAT_SQRT(a)                  vsqrtq_f64((a))
+#define SIMD_FLOAT_MORE(a, b)               vcgtq_f64((a), (b))
+#define SIMD_FLOAT_MORE_EQUAL(a, b)         vcgeq_f64((a), (b))
+#define SIMD_FLOAT_EQUAL(a, b)              vceqq_f64((a), (b))
+#define SIMD_FLOAT_NOT_EQUAL(a, b)          vreinterpretq_u64_u32(vmvnq_u32(vreinterpretq_u32_u64(vceqq_f64((a), (b)))))
+#define SIMD_FLOAT_MASK_STORE(p, m) do {\
+    (p)[0] = vgetq_lane_u64((m), 0) & 1;\
+    (p)[1] = vgetq_lane_u64((m), 1) & 1;\
+} while(0)
+#else
+#define SIMD_FLOAT_T                        float32x4_t
+#define SIMD_FLOAT_LANES                    (4)
+#define SIMD_FLOAT_LOAD(p)                  vld1q_f32((p))
+#define SIMD_FLOAT_STORE(p, v)              vst1q_f32((p), (v))
+#define SIMD_FLOAT_SPLAT(x)                 vdupq_n_f32((x))
+#define SIMD_FLOAT_ADD(a, b)                vaddq_f32((a), (b))
+#define SIMD_FLOAT_SUBTRACT(a, b)           vsubq_f32((a), (b))
+#define SIMD_FLOAT_MULTIPLY(a, b)           vmulq_f32((a), (b))
+#define SIMD_FLOAT_MAXIMUM(a, b)            vbslq_f32(vcgtq_f32((a), (b)), (a), (b))
+#define SIMD_FLOAT_MINIMUM(a, b)            vbslq_f32(vcltq_f32((a), (b)), (a), (b))
+#if defined(__aarch64__)
+#define SIMD_FLOAT_SQRT(a)                  vsqrtq_f32((a))
+#endif
+#define SIMD_FLOAT_MORE(a, b)               vcgtq_f32((a), (b))
+#define SIMD_FLOAT_MORE_EQUAL(a, b)         vcgeq_f32((a), (b))
+#define SIMD_FLOAT_EQUAL(a, b)              vceqq_f32((a), (b))
+#define SIMD_FLOAT_NOT_EQUAL(a, b)          vmvnq_u32(vceqq_f32((a), (b)))
+#define SIMD_FLOAT_MASK_STORE(p, m) do {\
+    uint16x4_t _m = vmovn_u32((m));\
+    (p)[0] = vget_lane_u16(_m, 0) & 1;\
+    (p)[1] = vget_lane_u16(_m, 1) & 1;\
+    (p)[2] = vget_lane_u16(_m, 2) & 1;\
+    (p)[3] = vget_lane_u16(_m, 3) & 1;\
+} while(0)
+#endif /* MICROPY_FLOAT_IMPL */
+
+#elif defined(ULAB_SIMD_MVE)
+
+// the comparisons of MVE return predicates, and the selection is done by vpselq
+#define SIMD_I16_T                          int16x8_t
+#define SIMD_I16_LANES                      (8)
+#define SIMD_I16_LOAD(p)                    vld1q_s16((p))
+#define SIMD_I16_STORE(p, v)                vst1q_s16((p), (v))
+#define SIMD_I16_SPLAT(x)                   vdupq_n_s16((x))
+#define SIMD_I16_ADD(a, b)                  vaddq_s16((a), (b))
+#define SIMD_I16_SUBTRACT(a, b)             vsubq_s16((a), (b))
+#define SIMD_I16_MULTIPLY(a, b)             vmulq_s16((a), (b))
+#define SIMD_I16_MAXIMUM(a, b)              vmaxq_s16((a), (b))
+#define SIMD_I16_MINIMUM(a, b)              vminq_s16((a), (b))
+#define SIMD_I16_MORE(a, b)                 vcmpgtq_s16((a), (b))
+#define SIMD_I16_MORE_EQUAL(a, b)           vcmpgeq_s16((a), (b))
+#define SIMD_I16_EQUAL(a, b)                vcmpeqq_s16((a), (b))
+#define SIMD_I16_NOT_EQUAL(a, b)            vcmpneq_s16((a), (b))
+#define SIMD_I16_MASK_STORE(p, m)           vstrbq_u16((p), vpselq_u16(vdupq_n_u16(1), vdupq_n_u16(0), (m)))
+
+#define SIMD_FLOAT_T                        float32x4_t
+#define SIMD_FLOAT_LANES                    (4)
+#define SIMD_FLOAT_LOAD(p)                  vld1q_f32((p))
+#define SIMD_FLOAT_STORE(p, v)              vst1q_f32((p), (v))
+#define SIMD_FLOAT_SPLAT(x)                 vdupq_n_f32((x))
+#define SIMD_FLOAT_ADD(a, b)                vaddq_f32((a), (b))
+#define SIMD_FLOAT_SUBTRACT(a, b)           vsubq_f32((a), (b))
+#define SIMD_FLOAT_MULTIPLY(a, b)           vmulq_f32((a), (b))
+#define SIMD_FLOAT_MAXIMUM(a, b)            vpselq_f32((a), (b), vcmpgtq_f32((a), (b)))
+#define SIMD_FLOAT_MINIMUM(a, b)            vpselq_f32((a), (b), vcmpltq_f32((a), (b)))
+#define SIMD_FLOAT_MORE(a, b)               vcmpgtq_f32((a), (b))
+#define SIMD_FLOAT_MORE_EQUAL(a, b)         vcmpgeq_f32((a), (b))
+#define SIMD_FLOAT_EQUAL(a, b)              vcmpeqq_f32((a), (b))
+#define SIMD_FLOAT_NOT_EQUAL(a, b)          vcmpneq_f32((a), (b))
+#define SIMD_FLOAT_MASK_STORE(p, m)         vstrbq_u32((p), vpselq_u32(vdupq_n_u32(1), vdupq_n_u32(0), (m)))
+
+#endif /* ULAB_SIMD_SSE2, ULAB_SIMD_NEON, ULAB_SIMD_MVE */
+
+// the scalar equivalents of the vector operations, these are used for the tail
+#define SIMD_SCALAR_ADD(a, b)               ((a) + (b))
+#define SIMD_SCALAR_SUBTRACT(a, b)          ((a) - (b))
+#define SIMD_SCALAR_MULTIPLY(a, b)          ((a) * (b))
+#define SIMD_SCALAR_MAXIMUM(a, b)           ((a) > (b) ? (a) : (b))
+#define SIMD_SCALAR_MINIMUM(a, b)           ((a) < (b) ? (a) : (b))
+#define SIMD_SCALAR_MORE(a, b)              ((a) > (b) ? 1 : 0)
+#define SIMD_SCALAR_MORE_EQUAL(a, b)        ((a) >= (b) ? 1 : 0)
+#define SIMD_SCALAR_EQUAL(a, b)             ((a) == (b) ? 1 : 0)
+#define SIMD_SCALAR_NOT_EQUAL(a, b)         ((a) != (b) ? 1 : 0)
+
+// The loop-invariant layout test is hoisted by the compiler. A scalar operand is splat
+// into a register, and its pointer is not advanced.
+#define SIMD_BINARY_LOOP(PREFIX, type, results, larray, rarray, len, layout, OPERATION) do {\
+    PREFIX ## _T _lscalar = PREFIX ## _SPLAT(*(larray));\
+    PREFIX ## _T _rscalar = PREFIX ## _SPLAT(*(rarray));\
+    size_t _n = 0;\
+    for(; _n + PREFIX ## _LANES <= (len); _n += PREFIX ## _LANES) {\
+        PREFIX ## _T _a = (layout) == ULAB_SIMD_LSCALAR ? _lscalar : PREFIX ## _LOAD((larray) + _n);\
+        PREFIX ## _T _b = (layout) == ULAB_SIMD_RSCALAR ? _rscalar : PREFIX ## _LOAD((rarray) + _n);\
+        PREFIX ## _STORE((results) + _n, PREFIX ## _ ## OPERATION(_a, _b));\
+    }\
+    for(; _n < (len); _n++) {\
+        type _a = (layout) == ULAB_SIMD_LSCALAR ? *(larray) : (larray)[_n];\
+        type _b = (layout) == ULAB_SIMD_RSCALAR ? *(rarray) : (rarray)[_n];\
+        (results)[_n] = (type)SIMD_SCALAR_ ## OPERATION(_a, _b);\
+    }\
+} while(0)
+
+// the same as SIMD_BINARY_LOOP, but the results are Booleans
+#define SIMD_COMPARE_LOOP(PREFIX, type, results, larray, rarray, len, layout, OPERATION) do {\
+    PREFIX ## _T _lscalar = PREFIX ## _SPLAT(*(larray));\
+    PREFIX ## _T _rscalar = PREFIX ## _SPLAT(*(rarray));\
+    size_t _n = 0;\
+    for(; _n + PREFIX ## _LANES <= (len); _n += PREFIX ## _LANES) {\
+        PREFIX ## _T _a = (layout) == ULAB_SIMD_LSCALAR ? _lscalar : PREFIX ## _LOAD((larray) + _n);\
+        PREFIX ## _T _b = (layout) == ULAB_SIMD_RSCALAR ? _rscalar : PREFIX ## _LOAD((rarray) + _n);\
+        PREFIX ## _MASK_STORE((results) + _n, PREFIX ## _ ## OPERATION(_a, _b));\
+    }\
+    for(; _n < (len); _n++) {\
+        type _a = (layout) == ULAB_SIMD_LSCALAR ? *(larray) : (larray)[_n];\
+        type _b = (layout) == ULAB_SIMD_RSCALAR ? *(rarray) : (rarray)[_n];\
+        (results)[_n] = SIMD_SCALAR_ ## OPERATION(_a, _b);\
+    }\
+} while(0)
+
+#define SIMD_UNWRAP_OPERATION(PREFIX, type, op, results, larray, rarray, len, layout) do {\
+    type *_larray = (type *)(larray);\
+    type *_rarray = (type *)(rarray);\
+    if((op) == ULAB_SIMD_ADD) {\
+        SIMD_BINARY_LOOP(PREFIX, type, (type *)(results), _larray, _rarray, (len), (layout), ADD);\
+    } else if((op) == ULAB_SIMD_SUBTRACT) {\
+        SIMD_BINARY_LOOP(PREFIX, type, (type *)(results), _larray, _rarray, (len), (layout), SUBTRACT);\
+    } else if((op) == ULAB_SIMD_MULTIPLY) {\
+        SIMD_BINARY_LOOP(PREFIX, type, (type *)(results), _larray, _rarray, (len), (layout), MULTIPLY);\
+    } else if((op) == ULAB_SIMD_MAXIMUM) {\
+        SIMD_BINARY_LOOP(PREFIX, type, (type *)(results), _larray, _rarray, (len), (layout), MAXIMUM);\
+    } else if((op) == ULAB_SIMD_MINIMUM) {\
+        SIMD_BINARY_LOOP(PREFIX, type, (type *)(results), _larray, _rarray, (len), (layout), MINIMUM);\
+    } else if((op) == ULAB_SIMD_MORE) {\
+        SIMD_COMPARE_LOOP(PREFIX, type, (uint8_t *)(results), _larray, _rarray, (len), (layout), MORE);\
+    } else if((op) == ULAB_SIMD_MORE_EQUAL) {\
+        SIMD_COMPARE_LOOP(PREFIX, type, (uint8_t *)(results), _larray, _rarray, (len), (layout), MORE_EQUAL);\
+    } else if((op) == ULAB_SIMD_EQUAL) {\
+        SIMD_COMPARE_LOOP(PREFIX, type, (uint8_t *)(results), _larray, _rarray, (len), (layout), EQUAL);\
+    } else { /* ULAB_SIMD_NOT_EQUAL */\
+        SIMD_COMPARE_LOOP(PREFIX, type, (uint8_t *)(results), _larray, _rarray, (len), (layout), NOT_EQUAL);\
+    }\
+} while(0)
+
+bool ulab_simd_binary(uint8_t dtype, uint8_t op, uint8_t layout, void *results, void *larray, void *rarray, size_t len) {
+    #if ULAB_SIMD_HAS_INT16
+    if(ULAB_DTYPE_IS(dtype, INT16)) {
+        SIMD_UNWRAP_OPERATION(SIMD_I16, int16_t, op, results, larray, rarray, len, layout);
+        return true;
+    }
+    #endif
+    #if ULAB_SIMD_HAS_FLOAT
+    if(dtype == NDARRAY_FLOAT) {
+        SIMD_UNWRAP_OPERATION(SIMD_FLOAT, mp_float_t, op, results, larray, rarray, len, layout);
+        return true;
+    }
+    #endif
+    return false;
+}
+
+#if ULAB_SIMD_HAS_SQRT
+void ulab_simd_sqrt(mp_float_t *results, mp_float_t *array, size_t len) {
+    size_t n = 0;
+    for(; n + SIMD_FLOAT_LANES <= len; n += SIMD_FLOAT_LANES) {
+        SIMD_FLOAT_STORE(results + n, SIMD_FLOAT_SQRT(SIMD_FLOAT_LOAD(array + n)));
+    }
+    for(; n < len; n++) {
+        results[n] = MICROPY_FLOAT_C_FUN(sqrt)(array[n]);
+    }
+}
+#endif /* ULAB_SIMD_HAS_SQRT */
+
+#endif /* ULAB_SIMD_HAS_INT16 || ULAB_SIMD_HAS_FLOAT */
@@ -0,0 +1,95 @@
+/*
+ * This file is part of the micropython-ulab project,
+ *
+ * https://github.com/v923z/micropython-ulab
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Zoltán Vörös
+*/
+
+#ifndef _ULAB_SIMD_
+#define _ULAB_SIMD_
+
+#include "ulab.h"
+#include "ndarray.h"
+
+#if ULAB_HAS_SIMD
+#if defined(__ARM_FEATURE_MVE)
+#define ULAB_SIMD_MVE
+#elif defined(__ARM_NEON)
+#define ULAB_SIMD_NEON
+#elif defined(__SSE2__)
+#define ULAB_SIMD_SSE2
+#endif
+#endif /* ULAB_HAS_SIMD */
+
+// integer MVE is bit 0 of __ARM_FEATURE_MVE, floating point MVE is bit 1
+#if defined(ULAB_SIMD_SSE2) || defined(ULAB_SIMD_NEON) || (defined(ULAB_SIMD_MVE) && (__ARM_FEATURE_MVE & 1))
+#define ULAB_SIMD_HAS_INT16                 (1)
+#else
+#define ULAB_SIMD_HAS_INT16                 (0)
+#endif
+
+#if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_DOUBLE
+#if defined(ULAB_SIMD_SSE2) || (defined(ULAB_SIMD_NEON) && defined(__aarch64__))
+#define ULAB_SIMD_HAS_FLOAT                 (1)
+#define ULAB_SIMD_HAS_SQRT                  (1)
+#endif
+#else
+#if defined(ULAB_SIMD_SSE2) || defined(ULAB_SIMD_NEON) || (defined(ULAB_SIMD_MVE) && (__ARM_FEATURE_MVE & 2))
+#define ULAB_SIMD_HAS_FLOAT                 (1)
+#endif
+// 32-bit ARM has no vectorised square root
+#if defined(ULAB_SIMD_SSE2) || (defined(ULAB_SIMD_NEON) && defined(__aarch64__))
+#define ULAB_SIMD_HAS_SQRT                  (1)
+#endif
+#endif /* MICROPY_FLOAT_IMPL */
+
+#ifndef ULAB_SIMD_HAS_FLOAT
+#define ULAB_SIMD_HAS_FLOAT                 (0)
+#endif
+
+#ifndef ULAB_SIMD_HAS_SQRT
+#define ULAB_SIMD_HAS_SQRT                  (0)
+#endif
+
+enum ULAB_SIMD_OPERATION {
+    ULAB_SIMD_ADD,
+    ULAB_SIMD_SUBTRACT,
+    ULAB_SIMD_MULTIPLY,
+    ULAB_SIMD_MAXIMUM,
+    ULAB_SIMD_MINIMUM,
+    ULAB_SIMD_MORE,
+    ULAB_SIMD_MORE_EQUAL,
+    ULAB_SIMD_EQUAL,
+    ULAB_SIMD_NOT_EQUAL,
+};
+
+// the operands of a binary kernel are either dense arrays of the length of the result,
+// or one of them is a single-element array, i.e., a scalar
+enum ULAB_SIMD_LAYOUT {
+    ULAB_SIMD_DENSE,
+    ULAB_SIMD_LSCALAR,
+    ULAB_SIMD_RSCALAR,
+};
+
+#define ULAB_SIMD_LAYOUT(lhs, rhs)          ((rhs)->len == 1 ? ULAB_SIMD_RSCALAR : ((lhs)->len == 1 ? ULAB_SIMD_LSCALAR : ULAB_SIMD_DENSE))
+
+#define ULAB_SIMD_SUPPORTS_DTYPE(dtype)     ((ULAB_SIMD_HAS_INT16 && ((dtype) == NDARRAY_INT16)) ||\
+                                                (ULAB_SIMD_HAS_FLOAT && ((dtype) == NDARRAY_FLOAT)))
+
+#if ULAB_SIMD_HAS_INT16 || ULAB_SIMD_HAS_FLOAT
+// Evaluates op on two operands of the same dtype, and returns true, if the dtype is
+// supported. The results are of the same dtype for the arithmetic operators, and
+// for maximum, and minimum, while for the comparisons, they are Booleans (uint8).
+bool ulab_simd_binary(uint8_t , uint8_t , uint8_t , void *, void *, void *, size_t );
+#else
+#define ulab_simd_binary(dtype, op, layout, results, larray, rarray, len)  (false)
+#endif
+
+#if ULAB_SIMD_HAS_SQRT
+void ulab_simd_sqrt(mp_float_t *, mp_float_t *, size_t );
+#endif
+
+#endif /* _ULAB_SIMD_ */
@@ -9,12 +9,14 @@
  */
 
 
+#include <stddef.h>
 #include <string.h>
 #include "py/runtime.h"
 
 #include "ulab.h"
 #include "ndarray.h"
 #include "ulab_tools.h"
+#include "ulab_parallel.h"
 
 // The following five functions return a float from a void type
 // The value in question is supposed to be located at the head of the pointer
@@ -45,17 +47,49 @@ mp_float_t ndarray_get_float_float(void *data) {
     return *((mp_float_t *)data);
 }
 
+#if ULAB_SUPPORTS_INT32
+mp_float_t ndarray_get_float_int32(void *data) {
+    // Returns a float value from an int32_t type
+    return (mp_float_t)(*(int32_t *)data);
+}
+
+mp_float_t ndarray_get_float_uint32(void *data) {
+    // Returns a float value from an uint32_t type
+    return (mp_float_t)(*(uint32_t *)data);
+}
+#endif
+
+#if ULAB_SUPPORTS_FLOAT16
+mp_float_t ndarray_get_float_float16(void *data) {
+    // Returns a float value from a half-precision float
+    return ulab_float16_to_float(*(uint16_t *)data);
+}
+#endif
+
 // returns a single function pointer, depending on the dtype
 void *ndarray_get_float_function(uint8_t dtype) {
     if(dtype == NDARRAY_UINT8) {
         return ndarray_get_float_uint8;
-    } else if(dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {
         return ndarray_get_float_int8;
     } else if(dtype == NDARRAY_UINT16) {
         return ndarray_get_float_uint16;
-    } else if(dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {
         return ndarray_get_float_int16;
-    } else {
+    }
+    #if ULAB_SUPPORTS_INT32
+    else if(dtype == NDARRAY_INT32) {
+        return ndarray_get_float_int32;
+    } else if(dtype == NDARRAY_UINT32) {
+        return ndarray_get_float_uint32;
+    }
+    #endif
+    #if ULAB_SUPPORTS_FLOAT16
+    else if(dtype == NDARRAY_FLOAT16) {
+        return ndarray_get_float_float16;
+    }
+    #endif
+    else {
         return ndarray_get_float_float;
     }
 }
@@ -64,13 +98,26 @@ mp_float_t ndarray_get_float_index(void *data, uint8_t dtype, size_t index) {
     // returns a single float value from an array located at index
     if(dtype == NDARRAY_UINT8) {
         return (mp_float_t)((uint8_t *)data)[index];
-    } else if(dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {
         return (mp_float_t)((int8_t *)data)[index];
     } else if(dtype == NDARRAY_UINT16) {
         return (mp_float_t)((uint16_t *)data)[index];
-    } else if(dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {
         return (mp_float_t)((int16_t *)data)[index];
-    } else {
+    }
+    #if ULAB_SUPPORTS_INT32
+    else if(dtype == NDARRAY_INT32) {
+        return (mp_float_t)((int32_t *)data)[index];
+    } else if(dtype == NDARRAY_UINT32) {
+        return (mp_float_t)((uint32_t *)data)[index];
+    }
+    #endif
+    #if ULAB_SUPPORTS_FLOAT16
+    else if(dtype == NDARRAY_FLOAT16) {
+        return ulab_float16_to_float(((uint16_t *)data)[index]);
+    }
+    #endif
+    else {
         return (mp_float_t)((mp_float_t *)data)[index];
     }
 }
@@ -80,18 +127,89 @@ mp_float_t ndarray_get_float_value(void *data, uint8_t dtype) {
     // The value in question is supposed to be located at the head of the pointer
     if(dtype == NDARRAY_UINT8) {
         return (mp_float_t)(*(uint8_t *)data);
-    } else if(dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {
         return (mp_float_t)(*(int8_t *)data);
     } else if(dtype == NDARRAY_UINT16) {
         return (mp_float_t)(*(uint16_t *)data);
-    } else if(dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {
         return (mp_float_t)(*(int16_t *)data);
-    } else {
+    }
+    #if ULAB_SUPPORTS_INT32
+    else if(dtype == NDARRAY_INT32) {
+        return (mp_float_t)(*(int32_t *)data);
+    } else if(dtype == NDARRAY_UINT32) {
+        return (mp_float_t)(*(uint32_t *)data);
+    }
+    #endif
+    #if ULAB_SUPPORTS_FLOAT16
+    else if(dtype == NDARRAY_FLOAT16) {
+        return ulab_float16_to_float(*(uint16_t *)data);
+    }
+    #endif
+    else {
         return *((mp_float_t *)data);
     }
 }
 
-#if NDARRAY_BINARY_USES_FUN_POINTER | ULAB_NUMPY_HAS_WHERE
+// the row, and column of the real dtypes in the promotion table
+static uint8_t ndarray_dtype_index(uint8_t dtype) {
+    switch(dtype) {
+        case NDARRAY_UINT8:
+            return 0;
+        #if ULAB_SUPPORTS_INT8
+        case NDARRAY_INT8:
+            return 1;
+        #endif
+        case NDARRAY_UINT16:
+            return 2;
+        #if ULAB_SUPPORTS_INT16
+        case NDARRAY_INT16:
+            return 3;
+        #endif
+        #if ULAB_SUPPORTS_INT32
+        case NDARRAY_INT32:
+            return 5;
+        case NDARRAY_UINT32:
+            return 6;
+        #endif
+        #if ULAB_SUPPORTS_FLOAT16
+        case NDARRAY_FLOAT16:
+            return 7;
+        #endif
+        default:
+            return 4;
+    }
+}
+
+#if ULAB_HAS_GENERIC_DTYPES
+#define NDARRAY_UPCAST_TYPES                (8)
+#else
+#define NDARRAY_UPCAST_TYPES                (5)
+#endif
+
+// the dtype of the result of a binary operation, indexed by the dtypes of the operands;
+// the mixed signed, and unsigned 32-bit cases would require int64, hence they are promoted to float
+static const uint8_t ndarray_upcast_table[NDARRAY_UPCAST_TYPES][NDARRAY_UPCAST_TYPES] = {
+    #if ULAB_HAS_GENERIC_DTYPES
+    //  uint8              int8               uint16             int16              float              int32              uint32             float16
+    { NDARRAY_UINT8,     NDARRAY_INT16,     NDARRAY_UINT16,    NDARRAY_INT16,     NDARRAY_FLOAT,     NDARRAY_INT32,     NDARRAY_UINT32,    NDARRAY_FLOAT16 },  // uint8
+    { NDARRAY_INT16,     NDARRAY_INT8,      NDARRAY_UINT16,    NDARRAY_INT16,     NDARRAY_FLOAT,     NDARRAY_INT32,     NDARRAY_FLOAT,     NDARRAY_FLOAT16 },  // int8
+    { NDARRAY_UINT16,    NDARRAY_UINT16,    NDARRAY_UINT16,    NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_INT32,     NDARRAY_UINT32,    NDARRAY_FLOAT },    // uint16
+    { NDARRAY_INT16,     NDARRAY_INT16,     NDARRAY_FLOAT,     NDARRAY_INT16,     NDARRAY_FLOAT,     NDARRAY_INT32,     NDARRAY_FLOAT,     NDARRAY_FLOAT },    // int16
+    { NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_FLOAT },    // float
+    { NDARRAY_INT32,     NDARRAY_INT32,     NDARRAY_INT32,     NDARRAY_INT32,     NDARRAY_FLOAT,     NDARRAY_INT32,     NDARRAY_FLOAT,     NDARRAY_FLOAT },    // int32
+    { NDARRAY_UINT32,    NDARRAY_FLOAT,     NDARRAY_UINT32,    NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_UINT32,    NDARRAY_FLOAT },    // uint32
+    { NDARRAY_FLOAT16,   NDARRAY_FLOAT16,   NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_FLOAT16 },  // float16
+    #else
+    //  uint8              int8               uint16             int16              float
+    { NDARRAY_UINT8,     NDARRAY_INT16,     NDARRAY_UINT16,    NDARRAY_INT16,     NDARRAY_FLOAT },  // uint8
+    { NDARRAY_INT16,     NDARRAY_INT8,      NDARRAY_UINT16,    NDARRAY_INT16,     NDARRAY_FLOAT },  // int8
+    { NDARRAY_UINT16,    NDARRAY_UINT16,    NDARRAY_UINT16,    NDARRAY_FLOAT,     NDARRAY_FLOAT },  // uint16
+    { NDARRAY_INT16,     NDARRAY_INT16,     NDARRAY_FLOAT,     NDARRAY_INT16,     NDARRAY_FLOAT },  // int16
+    { NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_FLOAT,     NDARRAY_FLOAT },  // float
+    #endif
+};
+
 uint8_t ndarray_upcast_dtype(uint8_t ldtype, uint8_t rdtype) {
     // returns a single character that corresponds to the broadcasting rules
     // - if one of the operarands is a float, the result is always float
@@ -103,26 +221,18 @@ uint8_t ndarray_upcast_dtype(uint8_t ldtype, uint8_t rdtype) {
     // int8 + int16 => int16
     // int8 + uint16 => uint16
     // uint16 + int16 => float
+    // int32 + any integer, but uint32 => int32
+    // uint32 + any unsigned integer => uint32
+    // float16 + uint8, or int8 => float16
 
     if(ldtype == rdtype) {
         // if the two dtypes are equal, the result is also of that type
         return ldtype;
-    } else if(((ldtype == NDARRAY_UINT8) && (rdtype == NDARRAY_INT8)) ||
-            ((ldtype == NDARRAY_INT8) && (rdtype == NDARRAY_UINT8)) ||
-            ((ldtype == NDARRAY_UINT8) && (rdtype == NDARRAY_INT16)) ||
-            ((ldtype == NDARRAY_INT16) && (rdtype == NDARRAY_UINT8)) ||
-            ((ldtype == NDARRAY_INT8) && (rdtype == NDARRAY_INT16)) ||
-            ((ldtype == NDARRAY_INT16) && (rdtype == NDARRAY_INT8))) {
-        return NDARRAY_INT16;
-    } else if(((ldtype == NDARRAY_UINT8) && (rdtype == NDARRAY_UINT16)) ||
-            ((ldtype == NDARRAY_UINT16) && (rdtype == NDARRAY_UINT8)) ||
-            ((ldtype == NDARRAY_INT8) && (rdtype == NDARRAY_UINT16)) ||
-            ((ldtype == NDARRAY_UINT16) && (rdtype == NDARRAY_INT8))) {
-        return NDARRAY_UINT16;
-    }
-    return NDARRAY_FLOAT;
+    }
+    return ndarray_upcast_table[ndarray_dtype_index(ldtype)][ndarray_dtype_index(rdtype)];
 }
 
+#if NDARRAY_BINARY_USES_FUN_POINTER | ULAB_NUMPY_HAS_WHERE | ULAB_HAS_GENERIC_DTYPES
 // The following five functions are the inverse of the ndarray_get_... functions,
 // and write a floating point datum into a void pointer
 
@@ -146,22 +256,210 @@ void ndarray_set_float_float(void *data, mp_float_t datum) {
     *((mp_float_t *)data) = datum;
 }
 
+#if ULAB_SUPPORTS_INT32
+// a float outside the range of the target type can't be converted directly, hence the
+// detour through int64_t, which wraps negative values around, as in numpy
+void ndarray_set_float_int32(void *data, mp_float_t datum) {
+    *((int32_t *)data) = (int32_t)(int64_t)datum;
+}
+
+void ndarray_set_float_uint32(void *data, mp_float_t datum) {
+    *((uint32_t *)data) = (uint32_t)(int64_t)datum;
+}
+#endif
+
+#if ULAB_SUPPORTS_FLOAT16
+void ndarray_set_float_float16(void *data, mp_float_t datum) {
+    *((uint16_t *)data) = ulab_float_to_float16(datum);
+}
+#endif
+
 // returns a single function pointer, depending on the dtype
 void *ndarray_set_float_function(uint8_t dtype) {
     if(dtype == NDARRAY_UINT8) {
         return ndarray_set_float_uint8;
-    } else if(dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {
         return ndarray_set_float_int8;
     } else if(dtype == NDARRAY_UINT16) {
         return ndarray_set_float_uint16;
-    } else if(dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {
         return ndarray_set_float_int16;
-    } else {
+    }
+    #if ULAB_SUPPORTS_INT32
+    else if(dtype == NDARRAY_INT32) {
+        return ndarray_set_float_int32;
+    } else if(dtype == NDARRAY_UINT32) {
+        return ndarray_set_float_uint32;
+    }
+    #endif
+    #if ULAB_SUPPORTS_FLOAT16
+    else if(dtype == NDARRAY_FLOAT16) {
+        return ndarray_set_float_float16;
+    }
+    #endif
+    else {
         return ndarray_set_float_float;
     }
 }
 #endif /* NDARRAY_BINARY_USES_FUN_POINTER */
 
+#if ULAB_SUPPORTS_INT32
+// The integer dtypes can also be read, and written as int32_t, so that the generic kernels
+// don't have to go through floats. uint32 is passed on as the bit pattern of an int32_t.
+
+int32_t ndarray_get_int32_uint8(void *data) {
+    return (int32_t)(*(uint8_t *)data);
+}
+
+int32_t ndarray_get_int32_int8(void *data) {
+    return (int32_t)(*(int8_t *)data);
+}
+
+int32_t ndarray_get_int32_uint16(void *data) {
+    return (int32_t)(*(uint16_t *)data);
+}
+
+int32_t ndarray_get_int32_int16(void *data) {
+    return (int32_t)(*(int16_t *)data);
+}
+
+int32_t ndarray_get_int32_int32(void *data) {
+    return *((int32_t *)data);
+}
+
+// returns a single function pointer, depending on the dtype, which must be an integer type
+void *ndarray_get_int32_function(uint8_t dtype) {
+    if(dtype == NDARRAY_UINT8) {
+        return ndarray_get_int32_uint8;
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {
+        return ndarray_get_int32_int8;
+    } else if(dtype == NDARRAY_UINT16) {
+        return ndarray_get_int32_uint16;
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {
+        return ndarray_get_int32_int16;
+    } else {
+        return ndarray_get_int32_int32;
+    }
+}
+
+void ndarray_set_int32_uint8(void *data, int32_t datum) {
+    *((uint8_t *)data) = (uint8_t)datum;
+}
+
+void ndarray_set_int32_int8(void *data, int32_t datum) {
+    *((int8_t *)data) = (int8_t)datum;
+}
+
+void ndarray_set_int32_uint16(void *data, int32_t datum) {
+    *((uint16_t *)data) = (uint16_t)datum;
+}
+
+void ndarray_set_int32_int16(void *data, int32_t datum) {
+    *((int16_t *)data) = (int16_t)datum;
+}
+
+void ndarray_set_int32_int32(void *data, int32_t datum) {
+    *((int32_t *)data) = datum;
+}
+
+// returns a single function pointer, depending on the dtype, which must be an integer type
+void *ndarray_set_int32_function(uint8_t dtype) {
+    if(dtype == NDARRAY_UINT8) {
+        return ndarray_set_int32_uint8;
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {
+        return ndarray_set_int32_int8;
+    } else if(dtype == NDARRAY_UINT16) {
+        return ndarray_set_int32_uint16;
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {
+        return ndarray_set_int32_int16;
+    } else {
+        return ndarray_set_int32_int32;
+    }
+}
+#endif /* ULAB_SUPPORTS_INT32 */
+
+#if ULAB_SUPPORTS_FLOAT16
+// The half-precision conversions work on the bit patterns, since not all compilers
+// support _Float16. Values are rounded to the nearest, ties to even, and values that
+// are too large for a half-precision float become infinite.
+typedef union {
+    float f;
+    uint32_t u;
+} tools_float_bits_t;
+
+mp_float_t ulab_float16_to_float(uint16_t half) {
+    uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1f;
+    uint32_t mantissa = half & 0x3ff;
+    tools_float_bits_t bits;
+    if(exponent == 0) {
+        // zero, or a subnormal number, whose value is mantissa * 2^-24
+        mp_float_t value = (mp_float_t)mantissa * MICROPY_FLOAT_CONST(5.9604644775390625e-8);
+        return sign ? -value : value;
+    } else if(exponent == 0x1f) {
+        // infinity, or nan
+        bits.u = sign | 0x7f800000 | (mantissa << 13);
+    } else {
+        bits.u = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    return (mp_float_t)bits.f;
+}
+
+uint16_t ulab_float_to_float16(mp_float_t value) {
+    tools_float_bits_t bits;
+    bits.f = (float)value;
+    uint16_t sign = (bits.u >> 16) & 0x8000;
+    uint32_t magnitude = bits.u & 0x7fffffff;
+    if(magnitude >= 0x7f800000) {
+        // infinity, or nan; the nan remains a nan
+        return sign | 0x7c00 | (magnitude > 0x7f800000 ? 0x200 : 0);
+    }
+    if(magnitude >= 0x477ff000) {
+        // 65520, and everything above it rounds to infinity
+        return sign | 0x7c00;
+    }
+    uint32_t half, remainder, tie;
+    if(magnitude < 0x38800000) {
+        // below 2^-14, the result is subnormal, or zero
+        if(magnitude < 0x33000000) {
+            return sign;
+        }
+        uint32_t mantissa = (magnitude & 0x7fffff) | 0x800000;
+        uint8_t shift = 126 - (magnitude >> 23);
+        half = mantissa >> shift;
+        remainder = mantissa & ((1UL << shift) - 1);
+        tie = 1UL << (shift - 1);
+    } else {
+        half = (magnitude - 0x38000000) >> 13;
+        remainder = magnitude & 0x1fff;
+        tie = 0x1000;
+    }
+    if((remainder > tie) || ((remainder == tie) && (half & 1))) {
+        // a carry into the exponent yields the correct result
+        half++;
+    }
+    return sign | (uint16_t)half;
+}
+#endif /* ULAB_SUPPORTS_FLOAT16 */
+
+#if ULAB_HAS_GENERIC_DTYPES
+void tools_convert_value(void *target, uint8_t tdtype, void *source, uint8_t sdtype) {
+    // copies a single real value from source to target, and converts it to the dtype of the target
+    #if ULAB_SUPPORTS_INT32
+    if(!ULAB_DTYPE_IS_FLOAT(tdtype) && !ULAB_DTYPE_IS_FLOAT(sdtype)) {
+        // integers are converted without loss, and without floating point arithmetic
+        int32_t (*get)(void *) = ndarray_get_int32_function(sdtype);
+        void (*set)(void *, int32_t) = ndarray_set_int32_function(tdtype);
+        set(target, get(source));
+        return;
+    }
+    #endif
+    mp_float_t (*get)(void *) = ndarray_get_float_function(sdtype);
+    void (*set)(void *, mp_float_t) = ndarray_set_float_function(tdtype);
+    set(target, get(source));
+}
+#endif /* ULAB_HAS_GENERIC_DTYPES */
+
 shape_strides tools_reduce_axes(ndarray_obj_t *ndarray, mp_obj_t axis) {
     // TODO: replace numerical_reduce_axes with this function, wherever applicable
     // This function should be used, whenever a tensor is contracted;
@@ -225,6 +523,27 @@ int8_t tools_get_axis(mp_obj_t axis, uint8_t ndim) {
     return ax;
 }
 
+ndarray_obj_t *tools_get_out_array(mp_obj_t out, uint8_t ndim, size_t *shape, uint8_t dtype) {
+    // Returns out as an ndarray, if it can hold the results of an operation
+    // with the given shape, and dtype, raises the appropriate exception otherwise
+    if(!mp_obj_is_type(out, &ulab_ndarray_type)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("out must be an ndarray"));
+    }
+    ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(out);
+    if(ndarray->dtype != dtype) {
+        mp_raise_ValueError(MP_ERROR_TEXT("out has wrong dtype"));
+    }
+    if(ndarray->ndim != ndim) {
+        mp_raise_ValueError(MP_ERROR_TEXT("input and output dimensions differ"));
+    }
+    for(uint8_t i = ULAB_MAX_DIMS; i > ULAB_MAX_DIMS - ndim; i--) {
+        if(ndarray->shape[i - 1] != shape[i - 1]) {
+            mp_raise_ValueError(MP_ERROR_TEXT("input and output shapes differ"));
+        }
+    }
+    return ndarray;
+}
+
 #if ULAB_MAX_DIMS > 1
 ndarray_obj_t *tools_object_is_square(mp_obj_t obj) {
     // Returns an ndarray, if the object is a square ndarray,
@@ -238,6 +557,112 @@ ndarray_obj_t *tools_object_is_square(mp_obj_t obj) {
     }
     return ndarray;
 }
+
+ndarray_obj_t *tools_object_is_square_stack(mp_obj_t obj) {
+    // Returns an ndarray, if the object is an ndarray of shape (..., N, N),
+    // raises the appropriate exception otherwise
+    if(!mp_obj_is_type(obj, &ulab_ndarray_type)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("size is defined for ndarrays only"));
+    }
+    ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(obj);
+    if((ndarray->shape[ULAB_MAX_DIMS - 1] != ndarray->shape[ULAB_MAX_DIMS - 2]) || (ndarray->ndim < 2)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("input must be square matrix"));
+    }
+    return ndarray;
+}
+
+size_t tools_stack_count(ndarray_obj_t *ndarray, uint8_t core) {
+    // returns the number of sub-arrays spanned by the last core axes
+    size_t count = 1;
+    for(uint8_t i = ULAB_MAX_DIMS - core; i > ULAB_MAX_DIMS - ndarray->ndim; i--) {
+        count *= ndarray->shape[i - 1];
+    }
+    return count;
+}
+
+uint8_t *tools_stack_pointer(ndarray_obj_t *ndarray, uint8_t core, size_t index) {
+    // returns a pointer to the index-th sub-array spanned by the last core axes,
+    // with the leading axes traversed in C order
+    uint8_t *array = (uint8_t *)ndarray->array;
+    for(uint8_t i = ULAB_MAX_DIMS - core; i > ULAB_MAX_DIMS - ndarray->ndim; i--) {
+        array += (index % ndarray->shape[i - 1]) * ndarray->strides[i - 1];
+        index /= ndarray->shape[i - 1];
+    }
+    return array;
+}
+#endif
+
+// Copies n elements of the given dtype, separated by sstride bytes, to target, whose
+// elements are separated by tstride items. The dtype is resolved once, and each
+// of the loops is straight-line typed code.
+#define TOOLS_LOAD_LOOP(type_out, type_in, target, tstride, source, sstride, n) do {\
+    type_out *_target = (target);\
+    uint8_t *_source = (source);\
+    for(size_t _i = 0; _i < (n); _i++) {\
+        *_target = (type_out)(*((type_in *)_source));\
+        _target += (tstride);\
+        _source += (sstride);\
+    }\
+} while(0)
+
+#if ULAB_SUPPORTS_FLOAT16
+#define TOOLS_LOAD_FLOAT16_LOOP(type_out, target, tstride, source, sstride, n) do {\
+    type_out *_target = (target);\
+    uint8_t *_source = (source);\
+    for(size_t _i = 0; _i < (n); _i++) {\
+        *_target = (type_out)ulab_float16_to_float(*((uint16_t *)_source));\
+        _target += (tstride);\
+        _source += (sstride);\
+    }\
+} while(0)
+#else
+#define TOOLS_LOAD_FLOAT16_LOOP(type_out, target, tstride, source, sstride, n) do { } while(0)
+#endif
+
+#define TOOLS_LOAD(type_out, target, tstride, source, sstride, dtype, n) do {\
+    if((dtype) == NDARRAY_UINT8) {\
+        TOOLS_LOAD_LOOP(type_out, uint8_t, (target), (tstride), (source), (sstride), (n));\
+    } else if(ULAB_DTYPE_IS(dtype, INT8)) {\
+        TOOLS_LOAD_LOOP(type_out, int8_t, (target), (tstride), (source), (sstride), (n));\
+    } else if((dtype) == NDARRAY_UINT16) {\
+        TOOLS_LOAD_LOOP(type_out, uint16_t, (target), (tstride), (source), (sstride), (n));\
+    } else if(ULAB_DTYPE_IS(dtype, INT16)) {\
+        TOOLS_LOAD_LOOP(type_out, int16_t, (target), (tstride), (source), (sstride), (n));\
+    } else if(ULAB_DTYPE_IS(dtype, INT32)) {\
+        TOOLS_LOAD_LOOP(type_out, int32_t, (target), (tstride), (source), (sstride), (n));\
+    } else if(ULAB_DTYPE_IS(dtype, UINT32)) {\
+        TOOLS_LOAD_LOOP(type_out, uint32_t, (target), (tstride), (source), (sstride), (n));\
+    } else if(ULAB_DTYPE_IS(dtype, FLOAT16)) {\
+        TOOLS_LOAD_FLOAT16_LOOP(type_out, (target), (tstride), (source), (sstride), (n));\
+    } else {\
+        TOOLS_LOAD_LOOP(type_out, mp_float_t, (target), (tstride), (source), (sstride), (n));\
+    }\
+} while(0)
+
+void tools_load_float(mp_float_t *target, int32_t tstride, uint8_t *source, int32_t sstride, uint8_t dtype, size_t n) {
+    TOOLS_LOAD(mp_float_t, target, tstride, source, sstride, dtype, n);
+}
+
+void tools_load_int32(int32_t *target, int32_t tstride, uint8_t *source, int32_t sstride, uint8_t dtype, size_t n) {
+    TOOLS_LOAD(int32_t, target, tstride, source, sstride, dtype, n);
+}
+
+#if ULAB_SUPPORTS_COMPLEX
+void tools_load_complex(mp_float_t *target, uint8_t *source, int32_t sstride, uint8_t dtype, size_t n) {
+    // loads n elements as interleaved complex numbers; real values get a vanishing imaginary part
+    if(dtype == NDARRAY_COMPLEX) {
+        for(size_t i = 0; i < n; i++) {
+            memcpy(target, source, 2 * sizeof(mp_float_t));
+            target += 2;
+            source += sstride;
+        }
+    } else {
+        tools_load_float(target, 2, source, sstride, dtype, n);
+        for(size_t i = 0; i < n; i++) {
+            target[2 * i + 1] = MICROPY_FLOAT_CONST(0.0);
+        }
+    }
+}
 #endif
 
 uint8_t ulab_binary_get_size(uint8_t dtype) {
@@ -246,6 +671,11 @@ uint8_t ulab_binary_get_size(uint8_t dtype) {
         return 2 * (uint8_t)sizeof(mp_float_t);
     }
     #endif
+    #if ULAB_SUPPORTS_FLOAT16
+    if(dtype == NDARRAY_FLOAT16) {
+        return 2;
+    }
+    #endif
     return dtype == NDARRAY_BOOL ? 1 : mp_binary_get_size('@', dtype, NULL);
 }
 
@@ -274,3 +704,72 @@ bool ulab_tools_mp_obj_is_scalar(mp_obj_t obj) {
     }
     #endif
 }
+
+// Boolean masks are stored one byte per item, since that is what all other functions,
+// and the buffer protocol expect. Contiguous masks are, however, scanned four bytes at a
+// time, so that long runs of False cost very little.
+size_t tools_count_true(const uint8_t *mask, int32_t stride, size_t len) {
+    // returns the number of non-zero bytes in the mask
+    size_t count = 0;
+    size_t i = 0;
+    if(stride == 1) {
+        for(; (i < len) && ((uintptr_t)(mask + i) & 3); i++) {
+            count += mask[i] != 0;
+        }
+        for(; i + 4 <= len; i += 4) {
+            uint32_t word;
+            memcpy(&word, mask + i, sizeof(uint32_t));
+            if(word != 0) {
+                // set the most significant bit of each non-zero byte, and count those bits
+                word = (((word & 0x7f7f7f7f) + 0x7f7f7f7f) | word) & 0x80808080;
+                count += __builtin_popcount(word);
+            }
+        }
+    }
+    for(; i < len; i++) {
+        count += mask[(ptrdiff_t)i * stride] != 0;
+    }
+    return count;
+}
+
+size_t tools_next_true(const uint8_t *mask, int32_t stride, size_t i, size_t len) {
+    // returns the index of the first non-zero byte of the mask at, or after i, or len, if there is none
+    if(stride == 1) {
+        for(; (i < len) && ((uintptr_t)(mask + i) & 3); i++) {
+            if(mask[i] != 0) {
+                return i;
+            }
+        }
+        for(; i + 4 <= len; i += 4) {
+            uint32_t word;
+            memcpy(&word, mask + i, sizeof(uint32_t));
+            if(word != 0) {
+                break;
+            }
+        }
+    }
+    for(; i < len; i++) {
+        if(mask[(ptrdiff_t)i * stride] != 0) {
+            return i;
+        }
+    }
+    return len;
+}
+
+#if ULAB_RELEASES_GIL && MICROPY_PY_THREAD && MICROPY_PY_THREAD_GIL
+bool ulab_gil_exit(size_t work) {
+    // while the cores share a kernel, the GIL is held by the calling thread, because
+    // the secondary core cannot release it on behalf of the interpreter
+    if((work < ULAB_GIL_THRESHOLD) || ulab_parallel_is_running()) {
+        return false;
+    }
+    MP_THREAD_GIL_EXIT();
+    return true;
+}
+
+void ulab_gil_enter(bool released) {
+    if(released) {
+        MP_THREAD_GIL_ENTER();
+    }
+}
+#endif /* ULAB_RELEASES_GIL */
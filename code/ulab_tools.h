@@ -15,6 +15,9 @@
 
 #define SWAP(t, a, b) { t tmp = a; a = b; b = tmp; }
 
+// clips a wider integer to the range of int16_t, as required by Q15 arithmetic
+#define TOOLS_Q15_SATURATE(x) ((x) > INT16_MAX ? INT16_MAX : ((x) < INT16_MIN ? INT16_MIN : (int16_t)(x)))
+
 typedef struct _shape_strides_t {
     uint8_t increment;
     uint8_t ndim;
@@ -32,9 +35,33 @@ void *ndarray_get_float_function(uint8_t );
 uint8_t ndarray_upcast_dtype(uint8_t , uint8_t );
 void *ndarray_set_float_function(uint8_t );
 
+#if ULAB_SUPPORTS_INT32
+void *ndarray_get_int32_function(uint8_t );
+void *ndarray_set_int32_function(uint8_t );
+#endif
+
+#if ULAB_SUPPORTS_FLOAT16
+mp_float_t ulab_float16_to_float(uint16_t );
+uint16_t ulab_float_to_float16(mp_float_t );
+#endif
+
+#if ULAB_HAS_GENERIC_DTYPES
+void tools_convert_value(void *, uint8_t , void *, uint8_t );
+#endif
+
 shape_strides tools_reduce_axes(ndarray_obj_t *, mp_obj_t );
 int8_t tools_get_axis(mp_obj_t , uint8_t );
+ndarray_obj_t *tools_get_out_array(mp_obj_t , uint8_t , size_t *, uint8_t );
 ndarray_obj_t *tools_object_is_square(mp_obj_t );
+ndarray_obj_t *tools_object_is_square_stack(mp_obj_t );
+size_t tools_stack_count(ndarray_obj_t *, uint8_t );
+uint8_t *tools_stack_pointer(ndarray_obj_t *, uint8_t , size_t );
+
+void tools_load_float(mp_float_t *, int32_t , uint8_t *, int32_t , uint8_t , size_t );
+void tools_load_int32(int32_t *, int32_t , uint8_t *, int32_t , uint8_t , size_t );
+#if ULAB_SUPPORTS_COMPLEX
+void tools_load_complex(mp_float_t *, uint8_t *, int32_t , uint8_t , size_t );
+#endif
 
 uint8_t ulab_binary_get_size(uint8_t );
 
@@ -43,4 +70,18 @@ void ulab_rescale_float_strides(int32_t *);
 #endif
 
 bool ulab_tools_mp_obj_is_scalar(mp_obj_t );
+
+size_t tools_count_true(const uint8_t *, int32_t , size_t );
+size_t tools_next_true(const uint8_t *, int32_t , size_t , size_t );
+
+// ulab_gil_exit releases the GIL, if the kernel that follows touches at least ULAB_GIL_THRESHOLD
+// elements, and returns true, if it did. Until ulab_gil_enter re-acquires the GIL, the kernel
+// must not allocate, raise exceptions, or access python objects.
+#if ULAB_RELEASES_GIL && MICROPY_PY_THREAD && MICROPY_PY_THREAD_GIL
+bool ulab_gil_exit(size_t );
+void ulab_gil_enter(bool );
+#else
+#define ulab_gil_exit(work)                 (false)
+#define ulab_gil_enter(released)            ((void)(released))
+#endif
 #endif
@@ -16,6 +16,7 @@
 #include "py/runtime.h"
 #include "py/misc.h"
 #include "user.h"
+#include "../ulab_api.h"
 
 #if ULAB_HAS_USER_MODULE
 
@@ -49,7 +50,7 @@ static mp_obj_t user_square(mp_obj_t arg) {
         for(size_t i=0; i < ndarray->len; i++, array++) {
             *rarray++ = (*array) * (*array);
         }
-    } else if(ndarray->dtype == NDARRAY_INT8) {
+    } else if(ULAB_DTYPE_IS(ndarray->dtype, INT8)) {
         int8_t *array = (int8_t *)ndarray->array;
         int8_t *rarray = (int8_t *)results->array;
         for(size_t i=0; i < ndarray->len; i++, array++) {
@@ -61,7 +62,7 @@ static mp_obj_t user_square(mp_obj_t arg) {
         for(size_t i=0; i < ndarray->len; i++, array++) {
             *rarray++ = (*array) * (*array);
         }
-    } else if(ndarray->dtype == NDARRAY_INT16) {
+    } else if(ULAB_DTYPE_IS(ndarray->dtype, INT16)) {
         int16_t *array = (int16_t *)ndarray->array;
         int16_t *rarray = (int16_t *)results->array;
         for(size_t i=0; i < ndarray->len; i++, array++) {
@@ -80,9 +81,52 @@ static mp_obj_t user_square(mp_obj_t arg) {
 
 MP_DEFINE_CONST_FUN_OBJ_1(user_square_obj, user_square);
 
+static mp_obj_t user_array_info(mp_obj_t arg) {
+    // native modules that are compiled separately should use the interface in ulab_api.h,
+    // which does not depend on the layout of ndarray_obj_t; this function returns
+    // the tuple (dtype, shape, strides, dense) of an ndarray
+
+    ulab_array_info_t info;
+    if(!ulab_api_get_array_info(arg, &info)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("input must be an ndarray"));
+    }
+    mp_obj_t shape[ULAB_MAX_DIMS];
+    mp_obj_t strides[ULAB_MAX_DIMS];
+    for(uint8_t i = 0; i < info.ndim; i++) {
+        shape[i] = mp_obj_new_int_from_uint(info.shape[i]);
+        strides[i] = mp_obj_new_int(info.strides[i]);
+    }
+    mp_obj_t tuple[4];
+    tuple[0] = MP_OBJ_NEW_SMALL_INT(info.dtype);
+    tuple[1] = mp_obj_new_tuple(info.ndim, shape);
+    tuple[2] = mp_obj_new_tuple(info.ndim, strides);
+    tuple[3] = mp_obj_new_bool(info.dense);
+    return mp_obj_new_tuple(4, tuple);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(user_array_info_obj, user_array_info);
+
+static mp_obj_t user_new_array(mp_obj_t shape_in, mp_obj_t dtype) {
+    // creates a zeroed array through ulab_api.h; the shape is a tuple, and the dtype a typecode
+    if(!mp_obj_is_type(shape_in, &mp_type_tuple)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("shape must be a tuple"));
+    }
+    mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(shape_in);
+    size_t shape[ULAB_MAX_DIMS];
+    for(size_t i = 0; (i < tuple->len) && (i < ULAB_MAX_DIMS); i++) {
+        shape[i] = (size_t)mp_obj_get_int(tuple->items[i]);
+    }
+    // the number of dimensions is checked by ulab_api_new_array
+    return ulab_api_new_array(tuple->len > ULAB_MAX_DIMS ? ULAB_MAX_DIMS + 1 : (uint8_t)tuple->len, shape, (uint8_t)mp_obj_get_int(dtype));
+}
+
+MP_DEFINE_CONST_FUN_OBJ_2(user_new_array_obj, user_new_array);
+
 static const mp_rom_map_elem_t ulab_user_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR___name__), MP_OBJ_NEW_QSTR(MP_QSTR_user) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_square), (mp_obj_t)&user_square_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_array_info), (mp_obj_t)&user_array_info_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_new_array), (mp_obj_t)&user_new_array_obj },
 };
 
 static MP_DEFINE_CONST_DICT(mp_module_ulab_user_globals, ulab_user_globals_table);
@@ -16,7 +16,11 @@
 #include "py/misc.h"
 #include "utils.h"
 
+#include "../ulab_tools.h"
+#include "../numpy/carray/carray_tools.h"
+#include "../ulab_profile.h"
 #include "../numpy/fft/fft_tools.h"
+#include "../numpy/numerical.h"
 
 #if ULAB_HAS_UTILS_MODULE
 
@@ -43,6 +47,9 @@ static mp_obj_t utils_from_intbuffer_helper(size_t n_args, const mp_obj_t *pos_a
     ndarray_obj_t *ndarray = NULL;
 
     if(args[3].u_obj != mp_const_none) {
+        if(!mp_obj_is_type(args[3].u_obj, &ulab_ndarray_type)) {
+            mp_raise_TypeError(MP_ERROR_TEXT("out must be a float dense array"));
+        }
         ndarray = MP_OBJ_TO_PTR(args[3].u_obj);
         if((ndarray->dtype != NDARRAY_FLOAT) || !ndarray_is_dense(ndarray)) {
             mp_raise_TypeError(MP_ERROR_TEXT("out must be a float dense array"));
@@ -82,76 +89,46 @@ static mp_obj_t utils_from_intbuffer_helper(size_t n_args, const mp_obj_t *pos_a
                 mp_raise_ValueError(MP_ERROR_TEXT("out array is too small"));
             }
         }
-        uint8_t *buffer = bufinfo.buf;
-
+        uint8_t *buffer = (uint8_t *)bufinfo.buf + offset;
         mp_float_t *array = (mp_float_t *)ndarray->array;
-        if(args[4].u_obj == mp_const_true) {
-            // swap the bytes before conversion
-            uint8_t *tmpbuff = m_new(uint8_t, sz);
-            #if ULAB_UTILS_HAS_FROM_INT16_BUFFER | ULAB_UTILS_HAS_FROM_UINT16_BUFFER
-            if((buffer_type == UTILS_INT16_BUFFER) || (buffer_type == UTILS_UINT16_BUFFER)) {
-                for(size_t i = 0; i < len; i++) {
-                    tmpbuff += sz;
-                    for(uint8_t j = 0; j < sz; j++) {
-                        memcpy(--tmpbuff, buffer++, 1);
-                    }
-                    if(buffer_type == UTILS_INT16_BUFFER) {
-                        *array++ = (mp_float_t)(*(int16_t *)tmpbuff);
-                    } else {
-                        *array++ = (mp_float_t)(*(uint16_t *)tmpbuff);
-                    }
-                }
-            }
-            #endif
-            #if ULAB_UTILS_HAS_FROM_INT32_BUFFER | ULAB_UTILS_HAS_FROM_UINT32_BUFFER
-            if((buffer_type == UTILS_INT32_BUFFER) || (buffer_type == UTILS_UINT32_BUFFER)) {
-                for(size_t i = 0; i < len; i++) {
-                    tmpbuff += sz;
-                    for(uint8_t j = 0; j < sz; j++) {
-                        memcpy(--tmpbuff, buffer++, 1);
-                    }
-                    if(buffer_type == UTILS_INT32_BUFFER) {
-                        *array++ = (mp_float_t)(*(int32_t *)tmpbuff);
-                    } else {
-                        *array++ = (mp_float_t)(*(uint32_t *)tmpbuff);
-                    }
-                }
-            }
-            #endif
-        } else {
-            #if ULAB_UTILS_HAS_FROM_INT16_BUFFER
-            if(buffer_type == UTILS_INT16_BUFFER) {
-                for(size_t i = 0; i < len; i++) {
-                    *array++ = (mp_float_t)(*(int16_t *)buffer);
-                    buffer += sz;
+        bool byteswap = mp_obj_is_true(args[4].u_obj);
+
+        // the buffer need not be aligned, so the items are fetched with memcpy; with out,
+        // the conversion doesn't allocate anything, so that it can be run on every DMA cycle
+        #if ULAB_UTILS_HAS_FROM_INT16_BUFFER | ULAB_UTILS_HAS_FROM_UINT16_BUFFER
+        if((buffer_type == UTILS_INT16_BUFFER) || (buffer_type == UTILS_UINT16_BUFFER)) {
+            for(size_t i = 0; i < len; i++) {
+                uint16_t value;
+                memcpy(&value, buffer, sizeof(uint16_t));
+                if(byteswap) {
+                    value = (uint16_t)((value >> 8) | (value << 8));
                 }
-            }
-            #endif
-            #if ULAB_UTILS_HAS_FROM_UINT16_BUFFER
-            if(buffer_type == UTILS_UINT16_BUFFER) {
-                for(size_t i = 0; i < len; i++) {
-                    *array++ = (mp_float_t)(*(uint16_t *)buffer);
-                    buffer += sz;
+                if(buffer_type == UTILS_INT16_BUFFER) {
+                    *array++ = (mp_float_t)(int16_t)value;
+                } else {
+                    *array++ = (mp_float_t)value;
                 }
+                buffer += sz;
             }
-            #endif
-            #if ULAB_UTILS_HAS_FROM_INT32_BUFFER
-            if(buffer_type == UTILS_INT32_BUFFER) {
-                for(size_t i = 0; i < len; i++) {
-                    *array++ = (mp_float_t)(*(int32_t *)buffer);
-                    buffer += sz;
+        }
+        #endif
+        #if ULAB_UTILS_HAS_FROM_INT32_BUFFER | ULAB_UTILS_HAS_FROM_UINT32_BUFFER
+        if((buffer_type == UTILS_INT32_BUFFER) || (buffer_type == UTILS_UINT32_BUFFER)) {
+            for(size_t i = 0; i < len; i++) {
+                uint32_t value;
+                memcpy(&value, buffer, sizeof(uint32_t));
+                if(byteswap) {
+                    value = (value >> 24) | ((value >> 8) & 0xff00) | ((value << 8) & 0xff0000) | (value << 24);
                 }
-            }
-            #endif
-            #if ULAB_UTILS_HAS_FROM_UINT32_BUFFER
-            if(buffer_type == UTILS_UINT32_BUFFER) {
-                for(size_t i = 0; i < len; i++) {
-                    *array++ = (mp_float_t)(*(uint32_t *)buffer);
-                    buffer += sz;
+                if(buffer_type == UTILS_INT32_BUFFER) {
+                    *array++ = (mp_float_t)(int32_t)value;
+                } else {
+                    *array++ = (mp_float_t)value;
                 }
+                buffer += sz;
             }
-            #endif
         }
+        #endif
         return MP_OBJ_FROM_PTR(ndarray);
     }
     return mp_const_none;
@@ -196,21 +173,22 @@ MP_DEFINE_CONST_FUN_OBJ_KW(utils_from_uint32_buffer_obj, 1, utils_from_uint32_bu
 //|
 //| def spectrogram(r: ulab.numpy.ndarray) -> ulab.numpy.ndarray:
 //|     """
-//|     :param ulab.numpy.ndarray r: A 1-dimension array of values whose size is a power of 2
+//|     :param ulab.numpy.ndarray r: A 1-dimension array of values
 //|
 //|     Computes the spectrum of the input signal.  This is the absolute value of the (complex-valued) fft of the signal.
+//|     If the input is real, the spectrum is calculated through the half-length transform of `ulab.numpy.fft.rfft`.
 //|     This function is similar to scipy's ``scipy.signal.welch`` https://docs.scipy.org/doc/scipy/reference/generated/scipy.signal.welch.html."""
 //|     ...
 //|
 
 mp_obj_t utils_spectrogram(size_t n_args, const mp_obj_t *args) {
     #if ULAB_SUPPORTS_COMPLEX & ULAB_FFT_IS_NUMPY_COMPATIBLE
-        return fft_fft_ifft_spectrogram(args[0], FFT_SPECTROGRAM);
+        return fft_fft_ifft_spectrogram(args[0], FFT_SPECTROGRAM, mp_const_none, mp_const_none);
     #else
     if(n_args == 2) {
-        return fft_fft_ifft_spectrogram(n_args, args[0], args[1], FFT_SPECTROGRAM);
+        return fft_fft_ifft_spectrogram(n_args, args[0], args[1], FFT_SPECTROGRAM, mp_const_none, mp_const_none);
     } else {
-        return fft_fft_ifft_spectrogram(n_args, args[0], mp_const_none, FFT_SPECTROGRAM);
+        return fft_fft_ifft_spectrogram(n_args, args[0], mp_const_none, FFT_SPECTROGRAM, mp_const_none, mp_const_none);
     }
     #endif
 }
@@ -223,23 +201,1151 @@ MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(utils_spectrogram_obj, 1, 2, utils_spectrogr
 
 #endif /* ULAB_UTILS_HAS_SPECTROGRAM */
 
+#if ULAB_UTILS_HAS_ROLLING
+
+enum UTILS_ROLLING_TYPE {
+    UTILS_ROLLING_SUM,
+    UTILS_ROLLING_MEAN,
+    UTILS_ROLLING_STD,
+    UTILS_ROLLING_MIN,
+    UTILS_ROLLING_MAX,
+};
+
+static void utils_rolling_lane(mp_float_t (*func)(void *), uint8_t *array, int32_t stride, size_t len, size_t window,
+                                uint8_t *rarray, int32_t rstride, uint8_t itemsize, uint8_t optype, size_t ddof, size_t *deque) {
+    // processes a single lane of length len, and writes len - window + 1 values into rarray
+
+    if((optype == UTILS_ROLLING_SUM) || (optype == UTILS_ROLLING_MEAN)) {
+        // running sum with Kahan compensation: each step adds the incoming,
+        // and subtracts the outgoing sample, so that the rounding errors can't accumulate
+        mp_float_t sum = MICROPY_FLOAT_CONST(0.0), c = MICROPY_FLOAT_CONST(0.0);
+        for(size_t i = 0; i < len; i++) {
+            mp_float_t delta = func(array + i * stride);
+            if(i >= window) {
+                delta -= func(array + (i - window) * stride);
+            }
+            mp_float_t y = delta - c;
+            mp_float_t t = sum + y;
+            c = (t - sum) - y;
+            sum = t;
+            if(i + 1 >= window) {
+                *(mp_float_t *)rarray = optype == UTILS_ROLLING_SUM ? sum : sum / (mp_float_t)window;
+                rarray += rstride;
+            }
+        }
+    } else if(optype == UTILS_ROLLING_STD) {
+        // Welford's algorithm for the first window, and its sliding update afterwards
+        mp_float_t M = MICROPY_FLOAT_CONST(0.0), m, S = MICROPY_FLOAT_CONST(0.0);
+        mp_float_t div = window > ddof ? (mp_float_t)(window - ddof) : MICROPY_FLOAT_CONST(0.0);
+        for(size_t i = 0; i < len; i++) {
+            mp_float_t value = func(array + i * stride);
+            if(i < window) {
+                m = M + (value - M) / (mp_float_t)(i + 1);
+                S += (value - M) * (value - m);
+            } else {
+                mp_float_t old = func(array + (i - window) * stride);
+                m = M + (value - old) / (mp_float_t)window;
+                S += (value - old) * (value - m + old - M);
+            }
+            M = m;
+            if(i + 1 >= window) {
+                // S can become slightly negative through cancellation
+                *(mp_float_t *)rarray = (S > MICROPY_FLOAT_CONST(0.0)) && (div > MICROPY_FLOAT_CONST(0.0)) ?
+                                            MICROPY_FLOAT_C_FUN(sqrt)(S / div) : MICROPY_FLOAT_CONST(0.0);
+                rarray += rstride;
+            }
+        }
+    } else {
+        // monotonic deque of indices: the values belonging to the indices are sorted,
+        // so that the extremum of the window is always at the front;
+        // the deque is a ring buffer of length window
+        size_t head = 0, count = 0;
+        for(size_t i = 0; i < len; i++) {
+            if(count && (deque[head] + window <= i)) {
+                head = head + 1 == window ? 0 : head + 1;
+                count--;
+            }
+            mp_float_t value = func(array + i * stride);
+            while(count) {
+                size_t back = head + count - 1;
+                if(back >= window) back -= window;
+                mp_float_t last = func(array + deque[back] * stride);
+                if((optype == UTILS_ROLLING_MAX) ? (last > value) : (last < value)) {
+                    break;
+                }
+                count--;
+            }
+            size_t tail = head + count;
+            if(tail >= window) tail -= window;
+            deque[tail] = i;
+            count++;
+            if(i + 1 >= window) {
+                memcpy(rarray, array + deque[head] * stride, itemsize);
+                rarray += rstride;
+            }
+        }
+    }
+}
+
+//| def rolling(
+//|     a: ulab.numpy.ndarray,
+//|     window: int,
+//|     op: str = "mean",
+//|     *,
+//|     axis: int = -1,
+//|     ddof: int = 0
+//| ) -> ulab.numpy.ndarray:
+//|     """
+//|     :param ulab.numpy.ndarray a: the input array
+//|     :param int window: the length of the sliding window
+//|     :param str op: the reduction, one of 'sum', 'mean', 'std', 'min', or 'max'
+//|     :param int axis: the axis along which the window slides
+//|     :param int ddof: the degrees of freedom, if op is 'std'
+//|
+//|     Applies a reduction to each full window of length ``window`` along ``axis``.
+//|     The length of the result along ``axis`` is ``a.shape[axis] - window + 1``,
+//|     and each value is computed in constant time. 'min', and 'max' retain the
+//|     dtype of the input, all other reductions return a float array."""
+//|     ...
+//|
+
+static mp_obj_t utils_rolling(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_window, MP_ARG_REQUIRED | MP_ARG_INT, { .u_int = 0 } },
+        { MP_QSTR_op, MP_ARG_OBJ, { .u_rom_obj = MP_ROM_QSTR(MP_QSTR_mean) } },
+        { MP_QSTR_axis, MP_ARG_KW_ONLY | MP_ARG_INT, { .u_int = -1 } },
+        { MP_QSTR_ddof, MP_ARG_KW_ONLY | MP_ARG_INT, { .u_int = 0 } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if(!mp_obj_is_type(args[0].u_obj, &ulab_ndarray_type)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("input must be an ndarray"));
+    }
+    ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(args[0].u_obj);
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+
+    if(!mp_obj_is_str(args[2].u_obj)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("op must be a string"));
+    }
+    size_t oplen;
+    const char *opstr = mp_obj_str_get_data(args[2].u_obj, &oplen);
+    uint8_t optype;
+    if((oplen == 3) && (memcmp(opstr, "sum", 3) == 0)) {
+        optype = UTILS_ROLLING_SUM;
+    } else if((oplen == 4) && (memcmp(opstr, "mean", 4) == 0)) {
+        optype = UTILS_ROLLING_MEAN;
+    } else if((oplen == 3) && (memcmp(opstr, "std", 3) == 0)) {
+        optype = UTILS_ROLLING_STD;
+    } else if((oplen == 3) && (memcmp(opstr, "min", 3) == 0)) {
+        optype = UTILS_ROLLING_MIN;
+    } else if((oplen == 3) && (memcmp(opstr, "max", 3) == 0)) {
+        optype = UTILS_ROLLING_MAX;
+    } else {
+        mp_raise_ValueError(MP_ERROR_TEXT("op must be one of 'sum', 'mean', 'std', 'min', or 'max'"));
+    }
+
+    if(args[4].u_int < 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("ddof must not be negative"));
+    }
+
+    int8_t ax = tools_get_axis(mp_obj_new_int(args[3].u_int), ndarray->ndim);
+    uint8_t index = ULAB_MAX_DIMS - ndarray->ndim + ax;
+    mp_int_t window = args[1].u_int;
+    if((window < 1) || ((size_t)window > ndarray->shape[index])) {
+        mp_raise_ValueError(MP_ERROR_TEXT("window must be between 1, and the length of the axis"));
+    }
+
+    size_t *shape = m_new(size_t, ULAB_MAX_DIMS);
+    memcpy(shape, ndarray->shape, sizeof(size_t) * ULAB_MAX_DIMS);
+    shape[index] = ndarray->shape[index] - window + 1;
+    uint8_t dtype = (optype == UTILS_ROLLING_MIN) || (optype == UTILS_ROLLING_MAX) ? ndarray->dtype : NDARRAY_FLOAT;
+    ndarray_obj_t *results = ndarray_new_dense_ndarray(ndarray->ndim, shape, dtype);
+    m_del(size_t, shape, ULAB_MAX_DIMS);
+
+    mp_obj_t axis = mp_obj_new_int(ax);
+    shape_strides _shape_strides = tools_reduce_axes(ndarray, axis);
+    shape_strides _rshape_strides = tools_reduce_axes(results, axis);
+
+    size_t *deque = NULL;
+    if((optype == UTILS_ROLLING_MIN) || (optype == UTILS_ROLLING_MAX)) {
+        deque = m_new(size_t, window);
+    }
+
+    mp_float_t (*func)(void *) = ndarray_get_float_function(ndarray->dtype);
+    uint8_t *array = (uint8_t *)ndarray->array;
+    uint8_t *rarray = (uint8_t *)results->array;
+
+    #if ULAB_MAX_DIMS > 3
+    size_t i = 0;
+    do {
+    #endif
+        #if ULAB_MAX_DIMS > 2
+        size_t j = 0;
+        do {
+        #endif
+            #if ULAB_MAX_DIMS > 1
+            size_t k = 0;
+            do {
+            #endif
+                utils_rolling_lane(func, array, _shape_strides.strides[0], _shape_strides.shape[0], window,
+                                rarray, _rshape_strides.strides[0], results->itemsize, optype, args[4].u_int, deque);
+            #if ULAB_MAX_DIMS > 1
+                array += _shape_strides.strides[ULAB_MAX_DIMS - 1];
+                rarray += _rshape_strides.strides[ULAB_MAX_DIMS - 1];
+                k++;
+            } while(k < _shape_strides.shape[ULAB_MAX_DIMS - 1]);
+            #endif
+        #if ULAB_MAX_DIMS > 2
+            array -= _shape_strides.strides[ULAB_MAX_DIMS - 1] * _shape_strides.shape[ULAB_MAX_DIMS - 1];
+            array += _shape_strides.strides[ULAB_MAX_DIMS - 2];
+            rarray -= _rshape_strides.strides[ULAB_MAX_DIMS - 1] * _rshape_strides.shape[ULAB_MAX_DIMS - 1];
+            rarray += _rshape_strides.strides[ULAB_MAX_DIMS - 2];
+            j++;
+        } while(j < _shape_strides.shape[ULAB_MAX_DIMS - 2]);
+        #endif
+    #if ULAB_MAX_DIMS > 3
+        array -= _shape_strides.strides[ULAB_MAX_DIMS - 2] * _shape_strides.shape[ULAB_MAX_DIMS - 2];
+        array += _shape_strides.strides[ULAB_MAX_DIMS - 3];
+        rarray -= _rshape_strides.strides[ULAB_MAX_DIMS - 2] * _rshape_strides.shape[ULAB_MAX_DIMS - 2];
+        rarray += _rshape_strides.strides[ULAB_MAX_DIMS - 3];
+        i++;
+    } while(i < _shape_strides.shape[ULAB_MAX_DIMS - 3]);
+    #endif
+
+    if(deque != NULL) {
+        m_del(size_t, deque, window);
+    }
+    return MP_OBJ_FROM_PTR(results);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(utils_rolling_obj, 2, utils_rolling);
+
+#endif /* ULAB_UTILS_HAS_ROLLING */
+
+#if ULAB_UTILS_HAS_DESCRIBE
+
+typedef struct _utils_describe_t {
+    size_t count;
+    size_t imin;
+    size_t imax;
+    uint8_t *pmin;
+    uint8_t *pmax;
+    mp_float_t vmin;
+    mp_float_t vmax;
+    mp_float_t sum;
+    mp_float_t M;
+    mp_float_t S;
+} utils_describe_t;
+
+static void utils_describe_reset(utils_describe_t *d) {
+    d->count = 0;
+    d->sum = MICROPY_FLOAT_CONST(0.0);
+    d->M = MICROPY_FLOAT_CONST(0.0);
+    d->S = MICROPY_FLOAT_CONST(0.0);
+}
+
+static void utils_describe_update(utils_describe_t *d, mp_float_t value, uint8_t *array) {
+    // updates all statistics with a single sample; the mean, and the variance with Welford's algorithm
+    if(d->count == 0) {
+        d->vmin = d->vmax = value;
+        d->pmin = d->pmax = array;
+        d->imin = d->imax = 0;
+    } else if(value < d->vmin) {
+        d->vmin = value;
+        d->pmin = array;
+        d->imin = d->count;
+    } else if(value > d->vmax) {
+        d->vmax = value;
+        d->pmax = array;
+        d->imax = d->count;
+    }
+    d->count++;
+    d->sum += value;
+    mp_float_t m = d->M + (value - d->M) / (mp_float_t)d->count;
+    d->S += (value - d->M) * (value - m);
+    d->M = m;
+}
+
+static mp_float_t utils_describe_var(utils_describe_t *d, size_t ddof) {
+    // as in numpy, the variance is undefined, if there are not more samples than degrees of freedom
+    return d->count > ddof ? d->S / (mp_float_t)(d->count - ddof) : MICROPY_FLOAT_C_FUN(nan)("");
+}
+
+static mp_obj_t utils_describe_dict(mp_obj_t min, mp_obj_t max, mp_obj_t argmin, mp_obj_t argmax,
+                                    mp_obj_t sum, mp_obj_t mean, mp_obj_t var) {
+    mp_obj_t dict = mp_obj_new_dict(7);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_min), min);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_max), max);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_argmin), argmin);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_argmax), argmax);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_sum), sum);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_mean), mean);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_var), var);
+    return dict;
+}
+
+//| def describe(a: ulab.numpy.ndarray, *, axis: Optional[int] = None, ddof: int = 0) -> dict:
+//|     """
+//|     :param ulab.numpy.ndarray a: the input array
+//|     :param int axis: the axis along which the statistics are calculated. If None, the flattened array is used
+//|     :param int ddof: the degrees of freedom of the variance
+//|
+//|     Returns a dictionary with the keys ``min``, ``max``, ``argmin``, ``argmax``, ``sum``,
+//|     ``mean``, and ``var``, all calculated in a single pass over ``a``. ``min``, and ``max``
+//|     retain the dtype of the input, ``sum``, ``mean``, and ``var`` are always floats."""
+//|     ...
+//|
+
+static mp_obj_t utils_describe(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_axis, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_ddof, MP_ARG_KW_ONLY | MP_ARG_INT, { .u_int = 0 } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if(!mp_obj_is_type(args[0].u_obj, &ulab_ndarray_type)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("input must be an ndarray"));
+    }
+    ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(args[0].u_obj);
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+    GENERIC_DTYPE_NOT_IMPLEMENTED(ndarray->dtype)
+    if(ndarray->len == 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("attempt to describe an empty sequence"));
+    }
+    if(args[2].u_int < 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("ddof must not be negative"));
+    }
+    size_t ddof = args[2].u_int;
+
+    mp_obj_t axis = args[1].u_obj;
+    if(axis != mp_const_none) {
+        axis = mp_obj_new_int(tools_get_axis(axis, ndarray->ndim));
+    }
+    shape_strides _shape_strides = tools_reduce_axes(ndarray, axis);
+
+    mp_float_t (*func)(void *) = ndarray_get_float_function(ndarray->dtype);
+    uint8_t *array = (uint8_t *)ndarray->array;
+    utils_describe_t d;
+    utils_describe_reset(&d);
+
+    if(axis == mp_const_none) {
+        #if ULAB_MAX_DIMS > 3
+        size_t i = 0;
+        do {
+        #endif
+            #if ULAB_MAX_DIMS > 2
+            size_t j = 0;
+            do {
+            #endif
+                #if ULAB_MAX_DIMS > 1
+                size_t k = 0;
+                do {
+                #endif
+                    size_t l = 0;
+                    do {
+                        utils_describe_update(&d, func(array), array);
+                        array += _shape_strides.strides[ULAB_MAX_DIMS - 1];
+                        l++;
+                    } while(l < _shape_strides.shape[ULAB_MAX_DIMS - 1]);
+                #if ULAB_MAX_DIMS > 1
+                    array -= _shape_strides.strides[ULAB_MAX_DIMS - 1] * _shape_strides.shape[ULAB_MAX_DIMS - 1];
+                    array += _shape_strides.strides[ULAB_MAX_DIMS - 2];
+                    k++;
+                } while(k < _shape_strides.shape[ULAB_MAX_DIMS - 2]);
+                #endif
+            #if ULAB_MAX_DIMS > 2
+                array -= _shape_strides.strides[ULAB_MAX_DIMS - 2] * _shape_strides.shape[ULAB_MAX_DIMS - 2];
+                array += _shape_strides.strides[ULAB_MAX_DIMS - 3];
+                j++;
+            } while(j < _shape_strides.shape[ULAB_MAX_DIMS - 3]);
+            #endif
+        #if ULAB_MAX_DIMS > 3
+            array -= _shape_strides.strides[ULAB_MAX_DIMS - 3] * _shape_strides.shape[ULAB_MAX_DIMS - 3];
+            array += _shape_strides.strides[ULAB_MAX_DIMS - 4];
+            i++;
+        } while(i < _shape_strides.shape[ULAB_MAX_DIMS - 4]);
+        #endif
+
+        return utils_describe_dict(ndarray_get_value(ndarray->dtype, d.pmin, 0),
+                                    ndarray_get_value(ndarray->dtype, d.pmax, 0),
+                                    mp_obj_new_int(d.imin), mp_obj_new_int(d.imax),
+                                    mp_obj_new_float(d.sum), mp_obj_new_float(d.M),
+                                    mp_obj_new_float(utils_describe_var(&d, ddof)));
+    }
+
+    uint8_t ndim = _shape_strides.ndim;
+    ndarray_obj_t *min = ndarray_new_dense_ndarray(ndim, _shape_strides.shape, ndarray->dtype);
+    ndarray_obj_t *max = ndarray_new_dense_ndarray(ndim, _shape_strides.shape, ndarray->dtype);
+    ndarray_obj_t *argmin = ndarray_new_dense_ndarray(ndim, _shape_strides.shape, NDARRAY_UINT16);
+    ndarray_obj_t *argmax = ndarray_new_dense_ndarray(ndim, _shape_strides.shape, NDARRAY_UINT16);
+    ndarray_obj_t *sum = ndarray_new_dense_ndarray(ndim, _shape_strides.shape, NDARRAY_FLOAT);
+    ndarray_obj_t *mean = ndarray_new_dense_ndarray(ndim, _shape_strides.shape, NDARRAY_FLOAT);
+    ndarray_obj_t *var = ndarray_new_dense_ndarray(ndim, _shape_strides.shape, NDARRAY_FLOAT);
+
+    uint8_t *minarray = (uint8_t *)min->array;
+    uint8_t *maxarray = (uint8_t *)max->array;
+    uint16_t *argminarray = (uint16_t *)argmin->array;
+    uint16_t *argmaxarray = (uint16_t *)argmax->array;
+    mp_float_t *sumarray = (mp_float_t *)sum->array;
+    mp_float_t *meanarray = (mp_float_t *)mean->array;
+    mp_float_t *vararray = (mp_float_t *)var->array;
+
+    #if ULAB_MAX_DIMS > 3
+    size_t i = 0;
+    do {
+    #endif
+        #if ULAB_MAX_DIMS > 2
+        size_t j = 0;
+        do {
+        #endif
+            #if ULAB_MAX_DIMS > 1
+            size_t k = 0;
+            do {
+            #endif
+                utils_describe_reset(&d);
+                for(size_t l = 0; l < _shape_strides.shape[0]; l++) {
+                    utils_describe_update(&d, func(array), array);
+                    array += _shape_strides.strides[0];
+                }
+                array -= _shape_strides.strides[0] * _shape_strides.shape[0];
+                memcpy(minarray, d.pmin, ndarray->itemsize);
+                minarray += ndarray->itemsize;
+                memcpy(maxarray, d.pmax, ndarray->itemsize);
+                maxarray += ndarray->itemsize;
+                *argminarray++ = (uint16_t)d.imin;
+                *argmaxarray++ = (uint16_t)d.imax;
+                *sumarray++ = d.sum;
+                *meanarray++ = d.M;
+                *vararray++ = utils_describe_var(&d, ddof);
+            #if ULAB_MAX_DIMS > 1
+                array += _shape_strides.strides[ULAB_MAX_DIMS - 1];
+                k++;
+            } while(k < _shape_strides.shape[ULAB_MAX_DIMS - 1]);
+            #endif
+        #if ULAB_MAX_DIMS > 2
+            array -= _shape_strides.strides[ULAB_MAX_DIMS - 1] * _shape_strides.shape[ULAB_MAX_DIMS - 1];
+            array += _shape_strides.strides[ULAB_MAX_DIMS - 2];
+            j++;
+        } while(j < _shape_strides.shape[ULAB_MAX_DIMS - 2]);
+        #endif
+    #if ULAB_MAX_DIMS > 3
+        array -= _shape_strides.strides[ULAB_MAX_DIMS - 2] * _shape_strides.shape[ULAB_MAX_DIMS - 2];
+        array += _shape_strides.strides[ULAB_MAX_DIMS - 3];
+        i++;
+    } while(i < _shape_strides.shape[ULAB_MAX_DIMS - 3]);
+    #endif
+
+    if(ndim == 0) {
+        // a one-dimensional input was reduced, return scalars
+        return utils_describe_dict(ndarray_get_value(ndarray->dtype, d.pmin, 0),
+                                    ndarray_get_value(ndarray->dtype, d.pmax, 0),
+                                    mp_obj_new_int(d.imin), mp_obj_new_int(d.imax),
+                                    mp_obj_new_float(d.sum), mp_obj_new_float(d.M),
+                                    mp_obj_new_float(utils_describe_var(&d, ddof)));
+    }
+    return utils_describe_dict(MP_OBJ_FROM_PTR(min), MP_OBJ_FROM_PTR(max), MP_OBJ_FROM_PTR(argmin), MP_OBJ_FROM_PTR(argmax),
+                                MP_OBJ_FROM_PTR(sum), MP_OBJ_FROM_PTR(mean), MP_OBJ_FROM_PTR(var));
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(utils_describe_obj, 1, utils_describe);
+
+#endif /* ULAB_UTILS_HAS_DESCRIBE */
+
+#if ULAB_UTILS_HAS_LUT
+
+#define UTILS_LUT_LOOP(type_in, type_out, rarray, rstride, array, stride, len, table, index)\
+    for(size_t l = 0; l < (len); l++) {\
+        type_in value = *((type_in *)(array));\
+        *((type_out *)(rarray)) = ((type_out *)(table))[(index)];\
+        (array) += (stride);\
+        (rarray) += (rstride);\
+    }
+
+// the table entries are moved as unsigned integers of the same width, hence, the loops
+// depend on the size of the entries only, and not on the dtype of the table
+#define UTILS_LUT_DISPATCH(type_in, rarray, rstride, array, stride, len, table, itemsize, index)\
+    if((itemsize) == 1) {\
+        UTILS_LUT_LOOP(type_in, uint8_t, (rarray), (rstride), (array), (stride), (len), (table), (index));\
+    } else if((itemsize) == 2) {\
+        UTILS_LUT_LOOP(type_in, uint16_t, (rarray), (rstride), (array), (stride), (len), (table), (index));\
+    } else if((itemsize) == 4) {\
+        UTILS_LUT_LOOP(type_in, uint32_t, (rarray), (rstride), (array), (stride), (len), (table), (index));\
+    } else if((itemsize) == 8) {\
+        UTILS_LUT_LOOP(type_in, uint64_t, (rarray), (rstride), (array), (stride), (len), (table), (index));\
+    } else {\
+        for(size_t l = 0; l < (len); l++) {\
+            type_in value = *((type_in *)(array));\
+            memcpy((rarray), (table) + (size_t)(index) * (itemsize), (itemsize));\
+            (array) += (stride);\
+            (rarray) += (rstride);\
+        }\
+    }
+
+static void utils_lut_row(uint8_t *rarray, int32_t rstride, uint8_t *array, int32_t stride, size_t len,
+                            uint8_t dtype, uint8_t *table, size_t tlen, uint8_t itemsize) {
+    // maps a single row through the table; if the table covers all values of
+    // the dtype, the look-up is unchecked, otherwise, the values are clipped to its end
+    if(dtype == NDARRAY_UINT8) {
+        if(tlen > UINT8_MAX) {
+            UTILS_LUT_DISPATCH(uint8_t, rarray, rstride, array, stride, len, table, itemsize, value);
+        } else {
+            UTILS_LUT_DISPATCH(uint8_t, rarray, rstride, array, stride, len, table, itemsize, value < tlen ? value : tlen - 1);
+        }
+    } else {
+        if(tlen > UINT16_MAX) {
+            UTILS_LUT_DISPATCH(uint16_t, rarray, rstride, array, stride, len, table, itemsize, value);
+        } else {
+            UTILS_LUT_DISPATCH(uint16_t, rarray, rstride, array, stride, len, table, itemsize, value < tlen ? value : tlen - 1);
+        }
+    }
+}
+
+//| def lut(
+//|     table: ulab.numpy.ndarray,
+//|     a: ulab.numpy.ndarray,
+//|     *,
+//|     out: Optional[ulab.numpy.ndarray] = None
+//| ) -> ulab.numpy.ndarray:
+//|     """
+//|     :param ulab.numpy.ndarray table: the one-dimensional look-up table
+//|     :param ulab.numpy.ndarray a: the uint8, or uint16 array of indices
+//|     :param ulab.numpy.ndarray out: the array of the shape of a, and the dtype of table, into which the result is written
+//|
+//|     Replaces each value v of ``a`` by ``table[v]``. Values beyond the end of
+//|     the table are mapped to its last entry. The result has the shape of ``a``,
+//|     and the dtype of ``table``. If ``out`` is ``a`` itself, the mapping is done in place."""
+//|     ...
+//|
+
+static mp_obj_t utils_lut(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_out, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if(!mp_obj_is_type(args[1].u_obj, &ulab_ndarray_type)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("input must be an ndarray"));
+    }
+    ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(args[1].u_obj);
+    if((ndarray->dtype != NDARRAY_UINT8) && (ndarray->dtype != NDARRAY_UINT16)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("input must be of type uint8, or uint16"));
+    }
+
+    ndarray_obj_t *table = ndarray_from_mp_obj(args[0].u_obj, 0);
+    if(table->ndim != 1) {
+        mp_raise_ValueError(MP_ERROR_TEXT("table must be one-dimensional"));
+    }
+    if(table->len == 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("table must not be empty"));
+    }
+    if(!ndarray_is_contiguous(table)) {
+        table = ndarray_copy_view(table);
+    }
+
+    ndarray_obj_t *results;
+    if(args[2].u_obj == mp_const_none) {
+        results = ndarray_new_dense_ndarray(ndarray->ndim, ndarray->shape, table->dtype);
+    } else {
+        if(!mp_obj_is_type(args[2].u_obj, &ulab_ndarray_type)) {
+            mp_raise_TypeError(MP_ERROR_TEXT("out must be an ndarray"));
+        }
+        results = MP_OBJ_TO_PTR(args[2].u_obj);
+        if(results->dtype != table->dtype) {
+            mp_raise_TypeError(MP_ERROR_TEXT("out must be of the dtype of the table"));
+        }
+        if((results->ndim != ndarray->ndim) || memcmp(results->shape, ndarray->shape, ULAB_MAX_DIMS * sizeof(size_t))) {
+            mp_raise_ValueError(MP_ERROR_TEXT("out must be of the shape of the input"));
+        }
+    }
+    if(ndarray->len == 0) {
+        return MP_OBJ_FROM_PTR(results);
+    }
+
+    uint8_t *array = (uint8_t *)ndarray->array;
+    uint8_t *rarray = (uint8_t *)results->array;
+    uint8_t *tarray = (uint8_t *)table->array;
+
+    if(ndarray_is_contiguous(ndarray) && ndarray_is_contiguous(results)) {
+        // a frame is mapped in a single run
+        utils_lut_row(rarray, results->itemsize, array, ndarray->itemsize, ndarray->len,
+                        ndarray->dtype, tarray, table->len, table->itemsize);
+        return MP_OBJ_FROM_PTR(results);
+    }
+
+    size_t *shape = ndarray->shape;
+    int32_t *strides = ndarray->strides;
+    int32_t *rstrides = results->strides;
+
+    #if ULAB_MAX_DIMS > 3
+    size_t i = 0;
+    do {
+    #endif
+        #if ULAB_MAX_DIMS > 2
+        size_t j = 0;
+        do {
+        #endif
+            #if ULAB_MAX_DIMS > 1
+            size_t k = 0;
+            do {
+            #endif
+                utils_lut_row(rarray, rstrides[ULAB_MAX_DIMS - 1], array, strides[ULAB_MAX_DIMS - 1], shape[ULAB_MAX_DIMS - 1],
+                                ndarray->dtype, tarray, table->len, table->itemsize);
+            #if ULAB_MAX_DIMS > 1
+                array += strides[ULAB_MAX_DIMS - 2];
+                rarray += rstrides[ULAB_MAX_DIMS - 2];
+                k++;
+            } while(k < shape[ULAB_MAX_DIMS - 2]);
+            #endif
+        #if ULAB_MAX_DIMS > 2
+            array -= strides[ULAB_MAX_DIMS - 2] * shape[ULAB_MAX_DIMS - 2];
+            array += strides[ULAB_MAX_DIMS - 3];
+            rarray -= rstrides[ULAB_MAX_DIMS - 2] * shape[ULAB_MAX_DIMS - 2];
+            rarray += rstrides[ULAB_MAX_DIMS - 3];
+            j++;
+        } while(j < shape[ULAB_MAX_DIMS - 3]);
+        #endif
+    #if ULAB_MAX_DIMS > 3
+        array -= strides[ULAB_MAX_DIMS - 3] * shape[ULAB_MAX_DIMS - 3];
+        array += strides[ULAB_MAX_DIMS - 4];
+        rarray -= rstrides[ULAB_MAX_DIMS - 3] * shape[ULAB_MAX_DIMS - 3];
+        rarray += rstrides[ULAB_MAX_DIMS - 4];
+        i++;
+    } while(i < shape[ULAB_MAX_DIMS - 4]);
+    #endif
+
+    return MP_OBJ_FROM_PTR(results);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_KW(utils_lut_obj, 2, utils_lut);
+
+#endif /* ULAB_UTILS_HAS_LUT */
+
+#if ULAB_UTILS_HAS_RUNNING_STATS | ULAB_UTILS_HAS_RING
+static uint8_t utils_get_shape(mp_obj_t oshape, size_t *shape) {
+    // parses an integer, or a tuple of positive integers into shape, which is right-aligned,
+    // and returns the number of dimensions
+    size_t ndim = 1;
+    mp_obj_t *items = &oshape;
+    if(mp_obj_is_type(oshape, &mp_type_tuple)) {
+        mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(oshape);
+        ndim = tuple->len;
+        items = tuple->items;
+    } else if(!mp_obj_is_int(oshape)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("shape must be an integer, or a tuple of integers"));
+    }
+    if((ndim == 0) || (ndim > ULAB_MAX_DIMS)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("maximum number of dimensions is " MP_STRINGIFY(ULAB_MAX_DIMS)));
+    }
+    for(uint8_t i = 0; i < ndim; i++) {
+        mp_int_t length = mp_obj_get_int(items[i]);
+        if(length <= 0) {
+            mp_raise_ValueError(MP_ERROR_TEXT("shape must consist of positive integers"));
+        }
+        shape[ULAB_MAX_DIMS - ndim + i] = (size_t)length;
+    }
+    return (uint8_t)ndim;
+}
+#endif
+
+#if ULAB_UTILS_HAS_RUNNING_STATS
+
+//| class RunningStats:
+//|     def __init__(self, shape: Optional[Union[int, Tuple[int, ...]]] = None) -> None:
+//|         """
+//|         :param shape: the shape of a single sample. If None, the samples are scalars
+//|
+//|         Accumulates the mean, the variance, the minimum, and the maximum of a stream of
+//|         samples, without retaining the samples themselves."""
+//|         ...
+//|
+//|     def update(self, block: _ArrayLike) -> None:
+//|         """Add a block of samples to the statistics. With scalar samples, all elements of
+//|         ``block`` are samples, otherwise, ``block`` is either a single sample, or a stack of
+//|         samples along its first axis."""
+//|         ...
+//|
+//|     def reset(self) -> None:
+//|         """Discard all samples"""
+//|         ...
+//|
+//|     count: int
+//|     """The number of samples"""
+//|     mean: Union[_float, ulab.numpy.ndarray]
+//|     """The mean of the samples"""
+//|     var: Union[_float, ulab.numpy.ndarray]
+//|     """The variance of the samples"""
+//|     min: Union[_float, ulab.numpy.ndarray]
+//|     """The smallest sample"""
+//|     max: Union[_float, ulab.numpy.ndarray]
+//|     """The largest sample"""
+//|
+
+static void utils_running_stats_clear(utils_running_stats_obj_t *self) {
+    self->count = 0;
+    for(size_t j = 0; j < self->len; j++) {
+        self->mean[j] = MICROPY_FLOAT_CONST(0.0);
+        self->m2[j] = MICROPY_FLOAT_CONST(0.0);
+        self->min[j] = INFINITY;
+        self->max[j] = -INFINITY;
+    }
+}
+
+static mp_obj_t utils_running_stats_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    (void) type;
+    mp_arg_check_num(n_args, n_kw, 0, 1, true);
+    mp_map_t kw_args;
+    mp_map_init_fixed_table(&kw_args, n_kw, args + n_args);
+
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_shape, MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+    };
+    mp_arg_val_t _args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, args, &kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, _args);
+
+    utils_running_stats_obj_t *self = m_new_obj(utils_running_stats_obj_t);
+    self->base.type = &utils_running_stats_type;
+    self->ndim = 0;
+    self->len = 1;
+    memset(self->shape, 0, sizeof(size_t) * ULAB_MAX_DIMS);
+
+    if(_args[0].u_obj != mp_const_none) {
+        self->ndim = utils_get_shape(_args[0].u_obj, self->shape);
+        for(uint8_t i = ULAB_MAX_DIMS - self->ndim; i < ULAB_MAX_DIMS; i++) {
+            self->len *= self->shape[i];
+        }
+    }
+
+    // all statistics are held in a single allocation, so that the updates need not allocate
+    mp_float_t *buffer = m_new(mp_float_t, 6 * self->len);
+    self->mean = buffer;
+    self->m2 = buffer + self->len;
+    self->min = buffer + 2 * self->len;
+    self->max = buffer + 3 * self->len;
+    self->bmean = buffer + 4 * self->len;
+    self->bm2 = buffer + 5 * self->len;
+    utils_running_stats_clear(self);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+static size_t utils_running_stats_block_length(utils_running_stats_obj_t *self, ndarray_obj_t *block) {
+    // returns the number of samples in block
+    if(self->ndim == 0) {
+        return block->len;
+    }
+    uint8_t offset = 0;
+    if(block->ndim == self->ndim + 1) {
+        offset = 1;
+    } else if(block->ndim != self->ndim) {
+        mp_raise_ValueError(MP_ERROR_TEXT("block does not match the shape of the samples"));
+    }
+    for(uint8_t i = ULAB_MAX_DIMS - self->ndim; i < ULAB_MAX_DIMS; i++) {
+        if(block->shape[i] != self->shape[i]) {
+            mp_raise_ValueError(MP_ERROR_TEXT("block does not match the shape of the samples"));
+        }
+    }
+    return offset ? block->shape[ULAB_MAX_DIMS - block->ndim] : 1;
+}
+
+static mp_obj_t utils_running_stats_update(mp_obj_t self_in, mp_obj_t block_in) {
+    utils_running_stats_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    ndarray_obj_t *block = ndarray_from_mp_obj(block_in, 0);
+    COMPLEX_DTYPE_NOT_IMPLEMENTED(block->dtype)
+    size_t k = utils_running_stats_block_length(self, block);
+    if(k == 0) {
+        return mp_const_none;
+    }
+    // a dense block is read in place; views, and half-precision floats have to be copied first
+    if(!ndarray_is_contiguous(block)) {
+        block = ndarray_copy_view(block);
+    }
+    #if ULAB_SUPPORTS_FLOAT16
+    if(block->dtype == NDARRAY_FLOAT16) {
+        block = ndarray_copy_view_convert_type(block, NDARRAY_FLOAT);
+    }
+    #endif
+
+    memset(self->bmean, 0, 2 * self->len * sizeof(mp_float_t));
+    uint8_t *array = (uint8_t *)block->array;
+    size_t m = self->len;
+    if(block->dtype == NDARRAY_UINT8) {
+        RUN_BLOCK_STATS(uint8_t, array, k, m, self->bmean, self->bm2, self->min, self->max);
+    } else if(ULAB_DTYPE_IS(block->dtype, INT8)) {
+        RUN_BLOCK_STATS(int8_t, array, k, m, self->bmean, self->bm2, self->min, self->max);
+    } else if(block->dtype == NDARRAY_UINT16) {
+        RUN_BLOCK_STATS(uint16_t, array, k, m, self->bmean, self->bm2, self->min, self->max);
+    } else if(ULAB_DTYPE_IS(block->dtype, INT16)) {
+        RUN_BLOCK_STATS(int16_t, array, k, m, self->bmean, self->bm2, self->min, self->max);
+    }
+    #if ULAB_SUPPORTS_INT32
+    else if(block->dtype == NDARRAY_INT32) {
+        RUN_BLOCK_STATS(int32_t, array, k, m, self->bmean, self->bm2, self->min, self->max);
+    } else if(block->dtype == NDARRAY_UINT32) {
+        RUN_BLOCK_STATS(uint32_t, array, k, m, self->bmean, self->bm2, self->min, self->max);
+    }
+    #endif
+    else {
+        RUN_BLOCK_STATS(mp_float_t, array, k, m, self->bmean, self->bm2, self->min, self->max);
+    }
+
+    // merge the statistics of the block into the running statistics
+    mp_float_t na = (mp_float_t)self->count;
+    mp_float_t nb = (mp_float_t)k;
+    mp_float_t n = na + nb;
+    for(size_t j = 0; j < m; j++) {
+        mp_float_t delta = self->bmean[j] - self->mean[j];
+        self->mean[j] += delta * nb / n;
+        self->m2[j] += self->bm2[j] + delta * delta * na * nb / n;
+    }
+    self->count += k;
+    return mp_const_none;
+}
+
+MP_DEFINE_CONST_FUN_OBJ_2(utils_running_stats_update_obj, utils_running_stats_update);
+
+static mp_obj_t utils_running_stats_reset(mp_obj_t self_in) {
+    utils_running_stats_clear(MP_OBJ_TO_PTR(self_in));
+    return mp_const_none;
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(utils_running_stats_reset_obj, utils_running_stats_reset);
+
+static mp_obj_t utils_running_stats_value(utils_running_stats_obj_t *self, mp_float_t *values, mp_float_t scale) {
+    // returns the statistics multiplied by scale as a float, or an array of the shape of the samples
+    if(self->ndim == 0) {
+        return mp_obj_new_float(values[0] * scale);
+    }
+    ndarray_obj_t *results = ndarray_new_dense_ndarray(self->ndim, self->shape, NDARRAY_FLOAT);
+    mp_float_t *rarray = (mp_float_t *)results->array;
+    for(size_t j = 0; j < self->len; j++) {
+        rarray[j] = values[j] * scale;
+    }
+    return MP_OBJ_FROM_PTR(results);
+}
+
+static void utils_running_stats_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
+    if(dest[0] != MP_OBJ_NULL) {
+        // the attributes are read-only
+        return;
+    }
+    utils_running_stats_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    // without samples, the mean, and the variance are undefined
+    mp_float_t norm = self->count > 0 ? MICROPY_FLOAT_CONST(1.0) / (mp_float_t)self->count : (mp_float_t)NAN;
+    switch(attr) {
+        case MP_QSTR_count:
+            dest[0] = mp_obj_new_int_from_uint(self->count);
+            break;
+        case MP_QSTR_mean:
+            dest[0] = utils_running_stats_value(self, self->mean, self->count > 0 ? MICROPY_FLOAT_CONST(1.0) : norm);
+            break;
+        case MP_QSTR_var:
+            dest[0] = utils_running_stats_value(self, self->m2, norm);
+            break;
+        case MP_QSTR_min:
+            dest[0] = utils_running_stats_value(self, self->min, MICROPY_FLOAT_CONST(1.0));
+            break;
+        case MP_QSTR_max:
+            dest[0] = utils_running_stats_value(self, self->max, MICROPY_FLOAT_CONST(1.0));
+            break;
+        default:
+            // forward to locals dict
+            dest[1] = MP_OBJ_SENTINEL;
+            break;
+    }
+}
+
+static void utils_running_stats_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    (void)kind;
+    utils_running_stats_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_printf(print, "RunningStats(count=%lu)", (unsigned long)self->count);
+}
+
+static const mp_rom_map_elem_t utils_running_stats_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_update), MP_ROM_PTR(&utils_running_stats_update_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&utils_running_stats_reset_obj) },
+};
+
+static MP_DEFINE_CONST_DICT(utils_running_stats_locals_dict, utils_running_stats_locals_dict_table);
+
+#if defined(MP_DEFINE_CONST_OBJ_TYPE)
+MP_DEFINE_CONST_OBJ_TYPE(
+    utils_running_stats_type,
+    MP_QSTR_RunningStats,
+    MP_TYPE_FLAG_NONE,
+    make_new, utils_running_stats_make_new,
+    print, utils_running_stats_print,
+    attr, utils_running_stats_attr,
+    locals_dict, &utils_running_stats_locals_dict
+);
+#else
+const mp_obj_type_t utils_running_stats_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_RunningStats,
+    .make_new = utils_running_stats_make_new,
+    .print = utils_running_stats_print,
+    .attr = utils_running_stats_attr,
+    .locals_dict = (mp_obj_dict_t*)&utils_running_stats_locals_dict,
+};
+#endif
+#endif /* ULAB_UTILS_HAS_RUNNING_STATS */
+
+#if ULAB_UTILS_HAS_RING
+
+//| class ring:
+//|     def __init__(self, shape: Union[int, Tuple[int, ...]], dtype: _DType = ulab.numpy.float) -> None:
+//|         """
+//|         :param shape: the shape of the buffer; the length of the first axis is the number of slots
+//|         :param dtype: the dtype of the buffer
+//|
+//|         A circular buffer of the most recent samples along the first axis of ``shape``.
+//|         Pushing a sample overwrites the oldest one, once all slots are used."""
+//|         ...
+//|
+//|     def push(self, block: _ArrayLike) -> None:
+//|         """Append a single sample, or a stack of samples along the first axis"""
+//|         ...
+//|
+//|     def views(self) -> Tuple[ulab.numpy.ndarray, ...]:
+//|         """Return the samples, oldest first, as at most two views of the buffer. The views
+//|         are overwritten by subsequent pushes."""
+//|         ...
+//|
+//|     def unroll(self) -> ulab.numpy.ndarray:
+//|         """Return a copy of the samples, oldest first, as a single array"""
+//|         ...
+//|
+
+static mp_obj_t utils_ring_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    (void) type;
+    mp_arg_check_num(n_args, n_kw, 1, 2, true);
+    mp_map_t kw_args;
+    mp_map_init_fixed_table(&kw_args, n_kw, args + n_args);
+
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_shape, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_dtype, MP_ARG_OBJ, { .u_rom_obj = MP_ROM_INT(NDARRAY_FLOAT) } },
+    };
+    mp_arg_val_t _args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, args, &kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, _args);
+
+    uint8_t dtype;
+    #if ULAB_HAS_DTYPE_OBJECT
+    if(mp_obj_is_type(_args[1].u_obj, &ulab_dtype_type)) {
+        dtype = ((dtype_obj_t *)MP_OBJ_TO_PTR(_args[1].u_obj))->dtype;
+    } else {
+        dtype = mp_obj_get_int(_args[1].u_obj);
+    }
+    #else
+    dtype = mp_obj_get_int(_args[1].u_obj);
+    #endif
+    // the same dtypes as in the constructor of ndarray are accepted
+    if(((dtype != NDARRAY_BOOL) && (dtype != NDARRAY_UINT8) && (dtype != NDARRAY_INT8) &&
+        (dtype != NDARRAY_UINT16) && (dtype != NDARRAY_INT16) && (dtype != NDARRAY_FLOAT) &&
+        (dtype != NDARRAY_INT32) && (dtype != NDARRAY_UINT32) && (dtype != NDARRAY_FLOAT16)
+        #if ULAB_SUPPORTS_COMPLEX
+        && (dtype != NDARRAY_COMPLEX)
+        #endif
+        ) || !ULAB_DTYPE_IS_SUPPORTED(dtype)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("data type not understood"));
+    }
+
+    size_t shape[ULAB_MAX_DIMS] = { 0 };
+    uint8_t ndim = utils_get_shape(_args[0].u_obj, shape);
+
+    utils_ring_obj_t *self = m_new_obj(utils_ring_obj_t);
+    self->base.type = &utils_ring_type;
+    self->buffer = ndarray_new_dense_ndarray(ndim, shape, dtype);
+    self->start = 0;
+    self->count = 0;
+    return MP_OBJ_FROM_PTR(self);
+}
+
+static mp_obj_t utils_ring_push(mp_obj_t self_in, mp_obj_t block_in) {
+    utils_ring_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    ndarray_obj_t *buffer = self->buffer;
+    ndarray_obj_t *block = ndarray_from_mp_obj(block_in, 0);
+
+    // a block is either a single sample, or a stack of samples along its first axis
+    uint8_t first = ULAB_MAX_DIMS - buffer->ndim;
+    size_t k = 1;
+    if(block->ndim == buffer->ndim) {
+        k = block->shape[first];
+    } else if(block->ndim + 1 != buffer->ndim) {
+        mp_raise_ValueError(MP_ERROR_TEXT("block does not match the shape of the ring"));
+    }
+    for(uint8_t i = first + 1; i < ULAB_MAX_DIMS; i++) {
+        if(block->shape[i] != buffer->shape[i]) {
+            mp_raise_ValueError(MP_ERROR_TEXT("block does not match the shape of the ring"));
+        }
+    }
+    if(k == 0) {
+        return mp_const_none;
+    }
+    if((block->dtype != buffer->dtype) || !ndarray_is_contiguous(block)) {
+        block = ndarray_copy_view_convert_type(block, buffer->dtype);
+    }
+
+    size_t capacity = buffer->shape[first];
+    size_t row = buffer->strides[first];
+    uint8_t *barray = (uint8_t *)buffer->array;
+    uint8_t *array = (uint8_t *)block->array;
+    if(k >= capacity) {
+        // only the most recent samples survive
+        memcpy(barray, array + (k - capacity) * row, capacity * row);
+        self->start = 0;
+        self->count = capacity;
+        return mp_const_none;
+    }
+    // the samples are written in at most two pieces, after the newest sample, and at the beginning
+    size_t end = (self->start + self->count) % capacity;
+    size_t head = MIN(k, capacity - end);
+    memcpy(barray + end * row, array, head * row);
+    memcpy(barray, array + head * row, (k - head) * row);
+    self->count += k;
+    if(self->count > capacity) {
+        self->start = (self->start + self->count - capacity) % capacity;
+        self->count = capacity;
+    }
+    return mp_const_none;
+}
+
+MP_DEFINE_CONST_FUN_OBJ_2(utils_ring_push_obj, utils_ring_push);
+
+static mp_obj_t utils_ring_views(mp_obj_t self_in) {
+    utils_ring_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    ndarray_obj_t *buffer = self->buffer;
+    uint8_t first = ULAB_MAX_DIMS - buffer->ndim;
+    size_t capacity = buffer->shape[first];
+
+    size_t shape[ULAB_MAX_DIMS];
+    memcpy(shape, buffer->shape, ULAB_MAX_DIMS * sizeof(size_t));
+    mp_obj_t views[2];
+    size_t head = MIN(self->count, capacity - self->start);
+    size_t n = 0;
+    if(head > 0) {
+        shape[first] = head;
+        views[n++] = MP_OBJ_FROM_PTR(ndarray_new_view(buffer, buffer->ndim, shape, buffer->strides, self->start * buffer->strides[first]));
+    }
+    if(self->count > head) {
+        shape[first] = self->count - head;
+        views[n++] = MP_OBJ_FROM_PTR(ndarray_new_view(buffer, buffer->ndim, shape, buffer->strides, 0));
+    }
+    return mp_obj_new_tuple(n, views);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(utils_ring_views_obj, utils_ring_views);
+
+static mp_obj_t utils_ring_unroll(mp_obj_t self_in) {
+    utils_ring_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    ndarray_obj_t *buffer = self->buffer;
+    uint8_t first = ULAB_MAX_DIMS - buffer->ndim;
+    size_t capacity = buffer->shape[first];
+    size_t row = buffer->strides[first];
+
+    size_t shape[ULAB_MAX_DIMS];
+    memcpy(shape, buffer->shape, ULAB_MAX_DIMS * sizeof(size_t));
+    shape[first] = self->count;
+    ndarray_obj_t *results = ndarray_new_dense_ndarray(buffer->ndim, shape, buffer->dtype);
+    uint8_t *barray = (uint8_t *)buffer->array;
+    uint8_t *rarray = (uint8_t *)results->array;
+    size_t head = MIN(self->count, capacity - self->start);
+    memcpy(rarray, barray + self->start * row, head * row);
+    memcpy(rarray + head * row, barray, (self->count - head) * row);
+    return MP_OBJ_FROM_PTR(results);
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(utils_ring_unroll_obj, utils_ring_unroll);
+
+static mp_obj_t utils_ring_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
+    utils_ring_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    switch(op) {
+        case MP_UNARY_OP_LEN:
+            return mp_obj_new_int_from_uint(self->count);
+        case MP_UNARY_OP_BOOL:
+            return mp_obj_new_bool(self->count != 0);
+        default:
+            return MP_OBJ_NULL; // operator not supported
+    }
+}
+
+static void utils_ring_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    (void)kind;
+    utils_ring_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_printf(print, "ring(count=%lu, capacity=%lu)", (unsigned long)self->count,
+                (unsigned long)self->buffer->shape[ULAB_MAX_DIMS - self->buffer->ndim]);
+}
+
+static const mp_rom_map_elem_t utils_ring_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_push), MP_ROM_PTR(&utils_ring_push_obj) },
+    { MP_ROM_QSTR(MP_QSTR_views), MP_ROM_PTR(&utils_ring_views_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unroll), MP_ROM_PTR(&utils_ring_unroll_obj) },
+};
+
+static MP_DEFINE_CONST_DICT(utils_ring_locals_dict, utils_ring_locals_dict_table);
+
+#if defined(MP_DEFINE_CONST_OBJ_TYPE)
+MP_DEFINE_CONST_OBJ_TYPE(
+    utils_ring_type,
+    MP_QSTR_ring,
+    MP_TYPE_FLAG_NONE,
+    make_new, utils_ring_make_new,
+    print, utils_ring_print,
+    unary_op, utils_ring_unary_op,
+    locals_dict, &utils_ring_locals_dict
+);
+#else
+const mp_obj_type_t utils_ring_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_ring,
+    .make_new = utils_ring_make_new,
+    .print = utils_ring_print,
+    .unary_op = utils_ring_unary_op,
+    .locals_dict = (mp_obj_dict_t*)&utils_ring_locals_dict,
+};
+#endif
+#endif /* ULAB_UTILS_HAS_RING */
+
 
 static const mp_rom_map_elem_t ulab_utils_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_utils) },
     #if ULAB_UTILS_HAS_FROM_INT16_BUFFER
-        { MP_ROM_QSTR(MP_QSTR_from_int16_buffer), MP_ROM_PTR(&utils_from_int16_buffer_obj) },
+        { MP_ROM_QSTR(MP_QSTR_from_int16_buffer), ULAB_PROFILE_PTR(MP_QSTR_utils, MP_QSTR_from_int16_buffer, utils_from_int16_buffer_obj) },
     #endif
     #if ULAB_UTILS_HAS_FROM_UINT16_BUFFER
-        { MP_ROM_QSTR(MP_QSTR_from_uint16_buffer), MP_ROM_PTR(&utils_from_uint16_buffer_obj) },
+        { MP_ROM_QSTR(MP_QSTR_from_uint16_buffer), ULAB_PROFILE_PTR(MP_QSTR_utils, MP_QSTR_from_uint16_buffer, utils_from_uint16_buffer_obj) },
     #endif
     #if ULAB_UTILS_HAS_FROM_INT32_BUFFER
-        { MP_ROM_QSTR(MP_QSTR_from_int32_buffer), MP_ROM_PTR(&utils_from_int32_buffer_obj) },
+        { MP_ROM_QSTR(MP_QSTR_from_int32_buffer), ULAB_PROFILE_PTR(MP_QSTR_utils, MP_QSTR_from_int32_buffer, utils_from_int32_buffer_obj) },
     #endif
     #if ULAB_UTILS_HAS_FROM_UINT32_BUFFER
-        { MP_ROM_QSTR(MP_QSTR_from_uint32_buffer), MP_ROM_PTR(&utils_from_uint32_buffer_obj) },
+        { MP_ROM_QSTR(MP_QSTR_from_uint32_buffer), ULAB_PROFILE_PTR(MP_QSTR_utils, MP_QSTR_from_uint32_buffer, utils_from_uint32_buffer_obj) },
     #endif
     #if ULAB_UTILS_HAS_SPECTROGRAM
-        { MP_ROM_QSTR(MP_QSTR_spectrogram), MP_ROM_PTR(&utils_spectrogram_obj) },
+        { MP_ROM_QSTR(MP_QSTR_spectrogram), ULAB_PROFILE_PTR(MP_QSTR_utils, MP_QSTR_spectrogram, utils_spectrogram_obj) },
+    #endif
+    #if ULAB_UTILS_HAS_ROLLING
+        { MP_ROM_QSTR(MP_QSTR_rolling), ULAB_PROFILE_PTR(MP_QSTR_utils, MP_QSTR_rolling, utils_rolling_obj) },
+    #endif
+    #if ULAB_UTILS_HAS_DESCRIBE
+        { MP_ROM_QSTR(MP_QSTR_describe), ULAB_PROFILE_PTR(MP_QSTR_utils, MP_QSTR_describe, utils_describe_obj) },
+    #endif
+    #if ULAB_UTILS_HAS_LUT
+        { MP_ROM_QSTR(MP_QSTR_lut), ULAB_PROFILE_PTR(MP_QSTR_utils, MP_QSTR_lut, utils_lut_obj) },
+    #endif
+    #if ULAB_UTILS_HAS_RUNNING_STATS
+        { MP_ROM_QSTR(MP_QSTR_RunningStats), MP_ROM_PTR(&utils_running_stats_type) },
+    #endif
+    #if ULAB_UTILS_HAS_RING
+        { MP_ROM_QSTR(MP_QSTR_ring), MP_ROM_PTR(&utils_ring_type) },
     #endif
 };
 
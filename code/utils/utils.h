@@ -14,6 +14,37 @@
 #include "../ulab.h"
 #include "../ndarray.h"
 
+#if ULAB_UTILS_HAS_RUNNING_STATS
+typedef struct _utils_running_stats_obj_t {
+    mp_obj_base_t base;
+    uint8_t ndim;
+    size_t shape[ULAB_MAX_DIMS];
+    size_t len;
+    size_t count;
+    // mean, and m2 hold the running statistics, bmean, and bm2 those of the current block
+    mp_float_t *mean;
+    mp_float_t *m2;
+    mp_float_t *min;
+    mp_float_t *max;
+    mp_float_t *bmean;
+    mp_float_t *bm2;
+} utils_running_stats_obj_t;
+
+extern const mp_obj_type_t utils_running_stats_type;
+#endif
+
+#if ULAB_UTILS_HAS_RING
+typedef struct _utils_ring_obj_t {
+    mp_obj_base_t base;
+    // the rows of buffer along the first axis are the slots of the ring
+    ndarray_obj_t *buffer;
+    size_t start;
+    size_t count;
+} utils_ring_obj_t;
+
+extern const mp_obj_type_t utils_ring_type;
+#endif
+
 extern const mp_obj_module_t ulab_utils_module;
 
 #endif
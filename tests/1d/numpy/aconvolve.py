@@ -0,0 +1,36 @@
+import math
+from ulab import numpy as np
+
+def isclose(u, v):
+    return all([math.isclose(p, q, rel_tol=1e-04, abs_tol=1e-04) for p, q in zip(list(u), list(v))])
+
+def run(job):
+    steps = 1
+    while not job.step():
+        steps += 1
+    return steps, job.result()
+
+x = np.array([math.sin(0.1 * i * i) for i in range(300)])
+y = np.array([math.cos(0.3 * i) for i in range(40)])
+
+for method in ('direct', 'fft'):
+    for mode in ('full', 'same', 'valid'):
+        job = np.aconvolve(x, y, mode=mode, method=method)
+        steps, result = run(job)
+        expected = np.convolve(x, y, mode=mode, method=method)
+        print(method, mode, steps > 1, len(result) == len(expected), isclose(result, expected))
+
+# short inputs are convolved in a single step
+job = np.aconvolve(np.array((1, 2, 3)), np.array((1, 10, 100, 1000)))
+print(job.step(), job.result())
+
+# a generous budget completes the job at once
+job = np.aconvolve(x, y, method='direct')
+print(job.step(10000000), isclose(job.result(), np.convolve(x, y)))
+print(job.step())
+
+job = np.aconvolve(x, y)
+try:
+    job.result()
+except RuntimeError as err:
+    print(err)
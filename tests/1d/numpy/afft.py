@@ -0,0 +1,26 @@
+import math
+from ulab import numpy as np
+
+def isclose(u, v):
+    return all([math.isclose(p, q, rel_tol=1e-06, abs_tol=1e-06) for p, q in zip(list(u), list(v))])
+
+def run(job):
+    steps = 1
+    while not job.step():
+        steps += 1
+    return steps, job.result()
+
+for n in (256, 128, 12):
+    x = np.linspace(-np.pi, np.pi, num=n)
+    y = np.sin(x) + 0.25 * x
+    a, b = np.fft.fft(y)
+    steps, (re, im) = run(np.fft.afft(y))
+    print(n, steps, isclose(a, re), isclose(b, im))
+    steps, (re, im) = run(np.fft.afft(re, im, inverse=True))
+    print(n, steps, isclose(y, re), isclose(np.zeros(n), im))
+
+p = np.fft.plan(64)
+x = np.linspace(0, 1, num=64)
+a, b = np.fft.fft(x, plan=p)
+steps, (re, im) = run(np.fft.afft(x, plan=p))
+print(steps, isclose(a, re), isclose(b, im))
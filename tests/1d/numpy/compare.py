@@ -11,3 +11,26 @@ print(np.clip(a, 3, 7))
 
 b = 3 * np.ones(len(a), dtype=np.float)
 print(np.clip(a, b, 7))
+
+a = np.array([1, 2, 3, 4, 5], dtype=np.uint8)
+b = np.array([5, 4, 3, 2, 1], dtype=np.float)
+c = np.zeros(5)
+np.minimum(a, b, out=c)
+print(c)
+np.maximum(a, b, out=c)
+print(c)
+
+a = np.array(range(9), dtype=np.uint8)
+d = np.zeros(9, dtype=np.uint8)
+np.clip(a, 3, 7, out=d)
+print(d)
+
+b = 3 * np.ones(len(a), dtype=np.float)
+e = np.zeros(9)
+np.clip(a, b, 7, out=e)
+print(e)
+
+try:
+    np.maximum(a, b, out=d)
+except ValueError as err:
+    print(err)
@@ -0,0 +1,26 @@
+import math
+from ulab import numpy as np
+
+x = np.array([math.sin(0.1 * i * i) for i in range(300)])
+y = np.array([math.cos(0.3 * i) for i in range(40)])
+
+direct = np.convolve(x, y, method='direct')
+for method in ('fft', 'auto'):
+    for a, b in ((x, y), (y, x)):
+        result = np.convolve(a, b, method=method)
+        cmp_result = []
+        for p, q in zip(list(result), list(direct)):
+            cmp_result.append(math.isclose(p, q, rel_tol=1e-04, abs_tol=1e-04))
+        print(method, len(result), all(cmp_result))
+
+# integer inputs, and a single block
+x = np.array([1, 2, 3], dtype=np.uint8)
+y = np.array([1, 10, 100, 1000], dtype=np.int16)
+result = np.convolve(x, y, method='fft')
+ref_result = [1, 12, 123, 1230, 2300, 3000]
+print([math.isclose(p, q, rel_tol=1e-04, abs_tol=1e-04) for p, q in zip(list(result), ref_result)])
+
+try:
+    np.convolve(x, y, method='slow')
+except ValueError as err:
+    print(err)
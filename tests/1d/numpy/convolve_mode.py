@@ -0,0 +1,35 @@
+import math
+from ulab import numpy as np
+
+x = np.array((1, 2, 3))
+y = np.array((1, 10, 100, 1000))
+for mode in ('full', 'same', 'valid'):
+    print(mode, np.convolve(x, y, mode=mode), np.convolve(y, x, mode=mode))
+
+# typed inputs
+for dtype_a in (np.uint8, np.int8, np.uint16, np.int16, np.float):
+    for dtype_c in (np.uint8, np.int8, np.uint16, np.int16, np.float):
+        a = np.array((1, 2, 3), dtype=dtype_a)
+        c = np.array((1, 10, 100), dtype=dtype_c)
+        print(np.convolve(a, c, mode='same'))
+
+a = np.array((-1, 2, -3), dtype=np.int8)
+c = np.array((1, 10, 100, 1000), dtype=np.uint16)
+print(np.convolve(a, c))
+print(np.convolve(a[::-1], c[::2], mode='valid'))
+
+# the FFT method returns the same window
+x = np.array([math.sin(0.1 * i * i) for i in range(300)])
+y = np.array([math.cos(0.3 * i) for i in range(40)])
+for mode in ('same', 'valid'):
+    direct = np.convolve(x, y, mode=mode, method='direct')
+    result = np.convolve(y, x, mode=mode, method='fft')
+    cmp_result = []
+    for p, q in zip(list(result), list(direct)):
+        cmp_result.append(math.isclose(p, q, rel_tol=1e-04, abs_tol=1e-04))
+    print(mode, len(result), all(cmp_result))
+
+try:
+    np.convolve(x, y, mode='left')
+except ValueError as err:
+    print(err)
@@ -0,0 +1,55 @@
+import math
+from ulab import numpy as np
+
+def isclose(u, v):
+    return all([math.isclose(p, q, rel_tol=1e-06, abs_tol=1e-06) for p, q in zip(list(u), list(v))])
+
+for n in (16, 12):
+    x = np.linspace(-np.pi, np.pi, num=n)
+    y = np.sin(x) + 0.25 * x
+    a, b = np.fft.fft(y)
+
+    # the results are written into the arrays of the caller
+    re = np.zeros(n)
+    im = np.zeros(n)
+    c, d = np.fft.fft(y, out=(re, im))
+    print(c is re, d is im, isclose(a, re), isclose(b, im))
+
+    # the input can be overwritten by its own transform
+    re = y.copy()
+    im = np.zeros(n)
+    np.fft.fft(re, im, out=(re, im))
+    print(isclose(a, re), isclose(b, im))
+
+    re = y.copy()
+    im = np.zeros(n)
+    print(np.fft.fft_inplace(re, im))
+    print(isclose(a, re), isclose(b, im))
+    np.fft.fft_inplace(re, im, inverse=True)
+    print(isclose(y, re), isclose(np.zeros(n), im))
+
+p = np.fft.plan(16)
+re = np.ones(16)
+im = np.zeros(16)
+np.fft.fft_inplace(re, im, plan=p)
+print(re[0], abs(re[1]) < 1e-6, abs(im[0]) < 1e-6)
+
+try:
+    np.fft.fft_inplace(re, re)
+except ValueError as err:
+    print(err)
+
+try:
+    np.fft.fft_inplace(re, np.zeros(8))
+except ValueError as err:
+    print(err)
+
+try:
+    np.fft.fft_inplace(np.ones(32)[::2], np.zeros(16))
+except ValueError as err:
+    print(err)
+
+try:
+    np.fft.fft(re, out=(np.zeros(16), np.zeros(16, dtype=np.int16)))
+except ValueError as err:
+    print(err)
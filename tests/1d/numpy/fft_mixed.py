@@ -0,0 +1,33 @@
+import math
+from ulab import numpy as np
+
+def dft(re, im):
+    n = len(re)
+    a, b = [], []
+    for k in range(n):
+        sr = si = 0.0
+        for j in range(n):
+            c = math.cos(2 * math.pi * j * k / n)
+            s = math.sin(2 * math.pi * j * k / n)
+            sr += re[j] * c + im[j] * s
+            si += im[j] * c - re[j] * s
+        a.append(sr)
+        b.append(si)
+    return a, b
+
+# mixed-radix, and Bluestein lengths
+for n in (6, 12, 15, 20, 7, 11):
+    x = np.array([math.sin(0.3 * i * i) + 0.1 * i for i in range(n)])
+    y = np.array([math.cos(0.7 * i) for i in range(n)])
+    a, b = np.fft.fft(x, y)
+    c, d = dft(x, y)
+    cmp_result = []
+    for i in range(n):
+        cmp_result.append(math.isclose(a[i], c[i], rel_tol=1e-06, abs_tol=1e-06))
+        cmp_result.append(math.isclose(b[i], d[i], rel_tol=1e-06, abs_tol=1e-06))
+    # the inverse should restore the input
+    e, f = np.fft.ifft(a, b)
+    for i in range(n):
+        cmp_result.append(math.isclose(e[i], x[i], rel_tol=1e-06, abs_tol=1e-06))
+        cmp_result.append(math.isclose(f[i], y[i], rel_tol=1e-06, abs_tol=1e-06))
+    print(n, all(cmp_result))
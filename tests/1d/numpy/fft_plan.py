@@ -0,0 +1,33 @@
+import math
+from ulab import numpy as np
+
+x = np.linspace(-np.pi, np.pi, num=16)
+y = np.sin(x) + 0.25 * x
+
+p = np.fft.plan(16)
+print(p)
+
+a, b = np.fft.fft(y)
+c, d = np.fft.fft(y, plan=p)
+cmp_result = []
+for i in range(len(y)):
+    cmp_result.append(math.isclose(a[i], c[i], rel_tol=1e-06, abs_tol=1e-06))
+    cmp_result.append(math.isclose(b[i], d[i], rel_tol=1e-06, abs_tol=1e-06))
+print(all(cmp_result))
+
+# the same plan can be used for the inverse
+e, f = np.fft.ifft(c, d, plan=p)
+cmp_result = []
+for q, r in zip(list(y), list(e)):
+    cmp_result.append(math.isclose(q, r, rel_tol=1e-06, abs_tol=1e-06))
+print(all(cmp_result))
+
+try:
+    np.fft.fft(np.zeros(8), plan=p)
+except ValueError as err:
+    print(err)
+
+try:
+    np.fft.plan(12)
+except ValueError as err:
+    print(err)
@@ -0,0 +1,23 @@
+try:
+    from ulab import numpy as np
+except ImportError:
+    import numpy as np
+
+xp = np.array([0.0, 1.0, 2.0, 4.0, 8.0])
+fp = np.array([0.0, 2.0, 3.0, 2.0, -2.0])
+
+# sorted queries, with points outside the range, on the nodes, and repeated
+x = np.array([-1.0, 0.0, 0.5, 1.0, 1.0, 1.5, 3.0, 4.0, 6.0, 8.0, 9.0])
+print(np.interp(x, xp, fp).tolist())
+print(np.interp(x, xp, fp, assume_sorted=True).tolist())
+# the same queries in a different order
+x = np.array([9.0, 1.5, -1.0, 6.0, 0.0, 8.0, 1.0, 3.0, 0.5, 4.0, 1.0])
+print(np.interp(x, xp, fp, left=-10.0, right=10.0).tolist())
+# integer queries, and a strided array
+print(np.interp(np.array([8, 6, 4, 2, 0], dtype=np.uint8)[::-1], xp, fp).tolist())
+
+f = np.interpolator(xp, fp, right=100.0)
+print(f)
+print(f([0.5, 3.0, 10.0]).tolist())
+print(f(np.array([6.0, 1.5]), assume_sorted=False).tolist())
+print(f(np.array([-5.0])).tolist())
@@ -0,0 +1,19 @@
+try:
+    from ulab import numpy as np
+except:
+    import numpy as np
+
+def write_npy(name, descr, shape, payload):
+    header = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': (" + shape + "), }"
+    header = header + ' ' * (117 - len(header)) + '\n'
+    with open(name, 'wb') as f:
+        f.write(b'\x93NUMPY\x01\x00\x76\x00')
+        f.write(header.encode())
+        f.write(payload)
+
+write_npy('out.npy', '>i2', '4,', b'\x00\x01\x01\x00\xff\xff\x80\x00')
+print(np.load('out.npy'))
+print(np.load('out.npy', offset=1, count=2))
+
+write_npy('out.npy', '>u2', '3,', b'\x12\x34\x00\xff\xff\x00')
+print(np.load('out.npy'))
@@ -0,0 +1,11 @@
+from ulab import numpy as np
+
+print(np.zeros(3, dtype=np.uint8, memory='gc'))
+print(np.ones(3, dtype=np.int16, memory='gc'))
+print(np.full(3, 7, dtype=np.uint8, memory='gc'))
+print(np.empty(3, memory='gc'))
+
+try:
+    np.zeros(3, memory='sram')
+except ValueError:
+    print('ValueError')
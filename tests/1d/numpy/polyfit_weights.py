@@ -0,0 +1,37 @@
+import math
+
+try:
+    from ulab import numpy as np
+except ImportError:
+    import numpy as np
+
+def isclose(result, reference):
+    return [math.isclose(r, f, rel_tol=1E-6, abs_tol=1E-6) for r, f in zip(result, reference)]
+
+# the outlier carries no weight
+x = np.array([0, 1, 2, 3])
+y = np.array([1, 3, 5, 100])
+print(isclose(np.polyfit(x, y, 1, w=np.array([1, 1, 1, 0])), [2.0, 1.0]))
+print(isclose(np.polyfit(x, y, 1, w=[1.0, 1.0, 1.0, 0.0]), [2.0, 1.0]))
+print(isclose(np.polyfit(y[:3], 1, w=[1, 1, 1]), [2.0, 1.0]))
+
+# weighted quadratic fit through non-polynomial data
+x = [0, 1, 2, 3, 4]
+y = [1, 3, 6, 10, 15]
+print(isclose(np.polyfit(x, y, 2, w=[1, 2, 1, 2, 1]), [0.5, 1.5, 1.0]))
+
+# sixth degree fit from non-contiguous data
+x = np.linspace(-1, 1, 99)[::2]
+coefficients = [0.5, -1.0, 2.0, 0.25, -3.0, 1.0, 0.75]
+y = np.polyval(coefficients, x)
+print(isclose(np.polyfit(x, y, 6), coefficients))
+
+try:
+    np.polyfit([0, 1, 2], [1, 2, 3], 1, w=[1, 2])
+except ValueError as e:
+    print('ValueError')
+
+try:
+    np.polyfit([1, 1, 1], [1, 2, 3], 1)
+except ValueError as e:
+    print('ValueError')
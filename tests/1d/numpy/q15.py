@@ -0,0 +1,31 @@
+from ulab import numpy as np
+
+# fixed-point transforms return the tuple (real, imag, exponent)
+x = np.array([1000, 0, 0, 0, 0, 0, 0, 0], dtype=np.int16)
+
+# block floating point: no stage has to be scaled
+re, im, exponent = np.fft.fft(x, dtype=np.int16)
+print(re, im, exponent)
+
+# each stage is scaled by 1/2
+re, im, exponent = np.fft.fft(x, dtype=np.int16, block=False)
+print(re, im, exponent)
+
+# the inverse transform is normalised
+x = np.array([1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000], dtype=np.int16)
+re, im, exponent = np.fft.ifft(x, dtype=np.int16)
+print(re, im, exponent)
+
+# Q15 convolution
+a = np.array([16384, 16384], dtype=np.int16)
+v = np.array([16384, -16384], dtype=np.int16)
+print(np.convolve(a, v, dtype=np.int16))
+
+# the results are saturated
+a = np.array([32767, 32767], dtype=np.int16)
+print(np.convolve(a, a, dtype=np.int16))
+
+try:
+    np.convolve(np.array([1, 2]), a, dtype=np.int16)
+except TypeError as e:
+    print(e)
@@ -0,0 +1,40 @@
+import math
+from ulab import numpy as np
+from ulab import utils
+
+x = np.linspace(-np.pi, np.pi, num=16)
+y = np.sin(x) + 0.25 * x
+
+a, b = np.fft.fft(y)
+c, d = np.fft.rfft(y)
+print(len(c), len(d))
+
+# the half spectrum should be equal to the first half of the full spectrum
+cmp_result = []
+for i in range(len(c)):
+    cmp_result.append(math.isclose(a[i], c[i], rel_tol=1e-06, abs_tol=1e-06))
+    cmp_result.append(math.isclose(b[i], d[i], rel_tol=1e-06, abs_tol=1e-06))
+print(all(cmp_result))
+
+# the inverse transform should restore the signal
+z = np.fft.irfft(c, d)
+print(len(z))
+cmp_result = []
+for p, q in zip(list(y), list(z)):
+    cmp_result.append(math.isclose(p, q, rel_tol=1e-06, abs_tol=1e-06))
+print(all(cmp_result))
+
+# the spectrogram of a real signal is computed from the half spectrum
+s = utils.spectrogram(y)
+cmp_result = []
+for i in range(len(y)):
+    cmp_result.append(math.isclose(s[i], math.sqrt(a[i]**2 + b[i]**2), rel_tol=1e-06, abs_tol=1e-06))
+print(all(cmp_result))
+
+print(np.fft.rfft(np.array([1, 2], dtype=np.uint8)))
+print(np.fft.irfft(np.array([3.0, -1.0])))
+
+try:
+    np.fft.irfft(np.array([1, 2, 3, 4]))
+except ValueError as err:
+    print(err)
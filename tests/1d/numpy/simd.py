@@ -0,0 +1,32 @@
+import math
+from ulab import numpy as np
+
+# the lengths are not multiples of the vector width, so that the tails are exercised, too
+for dtype in (np.int16, np.float):
+    a = np.array([(3 * i) % 17 - 8 for i in range(19)], dtype=dtype)
+    b = np.array([(5 * i) % 13 - 6 for i in range(19)], dtype=dtype)
+    # a single-element array of the same dtype is a scalar for the vector kernels
+    s = np.array([3], dtype=dtype)
+    t = np.array([7], dtype=dtype)
+    la = list(a)
+    lb = list(b)
+    print(list(a + b) == [x + y for x, y in zip(la, lb)])
+    print(list(a - b) == [x - y for x, y in zip(la, lb)])
+    print(list(a * b) == [x * y for x, y in zip(la, lb)])
+    print(list(a * s) == [x * 3 for x in la])
+    print(list(s - a) == [3 - x for x in la])
+    print(list(a > b) == [x > y for x, y in zip(la, lb)])
+    print(list(a >= b) == [x >= y for x, y in zip(la, lb)])
+    print(list(a < b) == [x < y for x, y in zip(la, lb)])
+    print(list(a == b) == [x == y for x, y in zip(la, lb)])
+    print(list(a != b) == [x != y for x, y in zip(la, lb)])
+    print(list(np.maximum(a, b)) == [max(x, y) for x, y in zip(la, lb)])
+    print(list(np.minimum(a, b)) == [min(x, y) for x, y in zip(la, lb)])
+    print(list(np.clip(a, b, t)) == [min(max(x, y), 7) for x, y in zip(la, lb)])
+
+# int16 arithmetic wraps around
+a = np.array([32767] * 9, dtype=np.int16)
+print(a + a)
+
+a = np.array([i * i for i in range(11)])
+print(all([math.isclose(x, i) for i, x in enumerate(np.sqrt(a))]))
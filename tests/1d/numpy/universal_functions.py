@@ -146,3 +146,18 @@ cmp_result = []
 for i in range(len(ref_result)):
 	cmp_result.append(math.isinf(result[i]))
 print(cmp_result)
+
+x = np.array([-1, +1, +1, -1])
+y = np.array([-1, -1, +1, +1])
+result = np.zeros(4)
+np.arctan2(y, x, out=result)
+result = result * 180 / np.pi
+ref_result = np.array([-135.0, -45.0, 45.0, 135.0], dtype=np.float)
+cmp_result = []
+for i in range(len(x)):
+    cmp_result.append(math.isclose(result[i], ref_result[i], rel_tol=1E-9, abs_tol=1E-9))
+print(cmp_result)
+
+result = np.zeros(4)
+np.around(np.array([1.24, 2.5, -0.76, 4.0]), decimals=1, out=result)
+print(result)
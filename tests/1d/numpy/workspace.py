@@ -0,0 +1,18 @@
+import ulab
+from ulab import numpy as np
+
+a = np.array([5, 3, 1, 4, 2], dtype=np.uint8)
+
+workspace = bytearray(256)
+ulab.set_workspace(workspace)
+print(np.median(a))
+print(np.sort(a))
+print(list(np.argsort(a)))
+print(np.quantile(a, [0.25, 0.75]))
+
+# the workspace is too small, and the heap is used
+ulab.set_workspace(bytearray(16))
+print(np.median(np.array(range(100))))
+
+ulab.set_workspace(None)
+print(np.median(a))
@@ -0,0 +1,32 @@
+try:
+    from ulab import numpy as np
+except:
+    import numpy as np
+
+a = np.array([[1, 2j], [3 + 1j, -1]], dtype=np.complex)
+b = np.array([[2, 1], [1j, 1 - 1j]], dtype=np.complex)
+f = np.array([[1, 2], [3, 4]], dtype=np.float)
+
+for x, y in ((a, b), (a, f), (f, a)):
+    c = np.dot(x, y)
+    print(np.real(c).tolist(), np.imag(c).tolist())
+
+v = np.array([1 + 1j, 2, -1j], dtype=np.complex)
+w = np.array([1, 1j, 2], dtype=np.complex)
+z = np.dot(v, w)
+print(z.real, z.imag)
+
+# the dense fast paths and the broadcasting loops of the binary operators
+d = np.array([[1 + 1j, 2 - 2j], [1 - 1j, 2j]], dtype=np.complex)
+for c in (a + b, a - b, a * b, a / d, a * f, a - f, f / d, a * (1 + 2j), a[:, 1] * b[1]):
+    print(np.real(c).tolist(), np.imag(c).tolist())
+
+z = np.sum(a)
+print(z.real, z.imag)
+z = np.mean(v)
+print(z.real, z.imag)
+for axis in (0, 1):
+    c = np.sum(a, axis=axis)
+    print(np.real(c).tolist(), np.imag(c).tolist())
+    c = np.mean(a, axis=axis)
+    print(np.real(c).tolist(), np.imag(c).tolist())
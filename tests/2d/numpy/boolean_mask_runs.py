@@ -0,0 +1,34 @@
+try:
+    from ulab import numpy as np
+except:
+    import numpy as np
+
+# long runs of False, with lengths that are not multiples of the word size
+for n in (1, 3, 4, 5, 17, 64, 67):
+    a = np.array(range(n), dtype=np.int16)
+    mask = np.array([i % 13 == 12 for i in range(n)], dtype=np.bool)
+    print(n, list(a[mask]))
+    print(n, list(a[a > n - 3]))
+
+a = np.array(range(40), dtype=np.uint16)
+print(list(a[a > 100]))
+print(list(a[a < 100])[-3:])
+
+# a strided mask
+b = np.array([i % 7 == 0 for i in range(80)], dtype=np.bool)
+print(list(a[b[::2]]))
+
+# assignment
+a = np.zeros(37, dtype=np.uint8)
+a[np.array([i % 9 == 8 for i in range(37)], dtype=np.bool)] = 1
+print(list(a))
+a[a == 1] = np.array([10, 20, 30, 40], dtype=np.uint8)
+print(list(a))
+
+# compress with a list, an ndarray, a strided ndarray, and with an axis
+a = np.array(range(12), dtype=np.int8).reshape((3, 4))
+print(list(np.compress([0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1], a)))
+c = np.array([0, 0, 1, 1, 0, 0, 0, 1], dtype=np.uint8)
+print(list(np.compress(c[::2], a, axis=1).flatten()))
+print(list(np.compress(np.array([True, False, True]), a, axis=0).flatten()))
+print(list(np.compress([False, False, False], a, axis=0).flatten()))
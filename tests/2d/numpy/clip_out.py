@@ -0,0 +1,18 @@
+from ulab import numpy as np
+
+a = np.array([1.0, 5.0, 9.0])
+
+o = np.zeros(3)
+np.clip(a, 2, 7, out=o)
+print(o)
+
+# the lower bound extends the shape of the operands
+lo = np.array([[2.0], [6.0]])
+o = np.zeros((2, 3))
+np.clip(a, lo, 7, out=o)
+print(o)
+
+b = np.array([[1, 5, 9], [0, 4, 8]], dtype=np.uint8)
+o = np.zeros((2, 3), dtype=np.uint8)
+np.clip(b, np.array([3], dtype=np.uint8), np.array([7], dtype=np.uint8), out=o)
+print(o)
@@ -28,3 +28,7 @@ print(np.concatenate((a,b), axis=0))
 print(np.concatenate((a,b), axis=1))
 print(np.concatenate((b,a), axis=0))
 print(np.concatenate((b,a), axis=1))
+
+# a strided, and a dense input
+print(np.concatenate((a[::2], b), axis=0).tolist())
+print(np.concatenate((b, a[:, ::2]), axis=1).tolist())
@@ -0,0 +1,15 @@
+from ulab import numpy as np
+
+a = np.array([[0, 1, 2], [3, 0, 0]], dtype=np.uint8)
+print(np.count_nonzero(a), np.flatnonzero(a))
+print(np.count_nonzero(a[:, ::2]), np.flatnonzero(a[:, ::2]))
+print(np.count_nonzero([0.0, -0.0, 1.5]), np.flatnonzero(np.array([0.0, -2.0, 0.0, 3.0])))
+print(np.count_nonzero(np.zeros((2, 2))), np.flatnonzero(np.zeros(3)))
+print(np.nonzero(a[:, 1:]))
+
+# the threshold of a frame, and typed rows with strided, and broadcast operands
+frame = np.array([[1, 200, 30], [150, 5, 255]], dtype=np.uint8)
+print(np.where(frame > 100, frame, 0))
+print(np.where(frame[:, ::2] > 100, 1, frame[:, ::2]))
+print(np.where(frame > 100, np.array([7, 8, 9], dtype=np.uint8), frame))
+print(np.where(np.array([1.0, 0.0, 2.0]), 1, -1))
@@ -0,0 +1,23 @@
+from ulab import numpy as np
+
+a = np.array([[1, 2, 3], [4, 5, 6]], dtype=np.uint8)
+print(np.cumsum(a).tolist())
+print(np.cumsum(a, axis=0).tolist())
+print(np.cumsum(a, axis=1).tolist())
+print(np.cumprod(a, axis=-1).tolist())
+print(np.cumprod([1, 2, 3, 4]).tolist())
+
+# strided views
+b = np.array(range(12), dtype=np.int16).reshape((3, 4))
+print(np.cumsum(b[:, ::2], axis=0).tolist())
+print(np.cumsum(b[::2, 1:]).tolist())
+
+# the accumulation happens in float, if out is a float array
+c = np.full(4, 100, dtype=np.uint8)
+out = np.zeros(4)
+np.cumsum(c, out=out)
+print(out.tolist())
+print(np.cumsum(c).tolist())
+
+print(np.cumsum(np.array([0.5, 0.25, 0.125])).tolist())
+print(np.cumsum(np.zeros(0)).tolist())
@@ -0,0 +1,25 @@
+from ulab import numpy as np
+
+a = np.array([[1, 2, 3], [4, 5, 6]])
+b = np.array([[1, 0], [0, 1], [2, 2]])
+print(np.dot(a, b))
+print(np.dot(b, a))
+print(np.dot(a, np.array([1, 1, 1])))
+print(np.dot(np.array([1, 2, 3]), np.array([4, 5, 6])))
+
+# views with non-unit strides
+print(np.dot(a.transpose(), a))
+print(np.dot(a[:, ::2], b[::2, :]))
+
+# integers are accumulated exactly
+c = np.array([[32767, 32767, -32768]], dtype=np.int16)
+d = np.array([[32767], [32767], [-32768]], dtype=np.int16)
+print(np.dot(c, d))
+e = np.array([[255, 255]], dtype=np.uint8)
+f = np.array([[65535], [65535]], dtype=np.uint16)
+print(np.dot(e, f))
+
+# matrices that span more than one panel
+m = np.ones((40, 40))
+print(np.dot(m, m)[0, :4])
+print(np.sum(np.dot(m, m)))
@@ -0,0 +1,62 @@
+import math
+from ulab import numpy as np
+from ulab import scipy as spy
+
+# the kernels that can be delegated to a DSP library (ULAB_DSP_BACKEND) are checked against
+# references, and against the arguments that always run in the portable code
+
+def close(x, y, tol=1e-4):
+    return all([abs(p - q) < tol for p, q in zip(x, y)])
+
+def flat(x):
+    return [v for row in x.tolist() for v in row]
+
+# complex fft of a power of 2
+n = 16
+x = np.array([math.sin(2 * math.pi * k / n) + 0.5 * math.cos(6 * math.pi * k / n) for k in range(n)])
+result = np.fft.fft(x)
+if type(result) is tuple:
+    re, im = result
+else:
+    re, im = np.real(result), np.imag(result)
+ref_re = [sum([x[k] * math.cos(2 * math.pi * j * k / n) for k in range(n)]) for j in range(n)]
+ref_im = [-sum([x[k] * math.sin(2 * math.pi * j * k / n) for k in range(n)]) for j in range(n)]
+print(close(re, ref_re), close(im, ref_im))
+
+# dense float matrices, and views that are not dense
+a = np.array(range(12), dtype=np.float).reshape((3, 4))
+b = np.array(range(8), dtype=np.float).reshape((4, 2))
+print(np.dot(a, b).tolist())
+print(close(flat(np.dot(a, b)), flat(np.dot(a[:, ::-1], b[::-1]))))
+print(np.dot(a[1], b).tolist())
+
+# full convolution of dense float arrays, of views, and of integers
+x = np.array([1, 2, 3, 4, 5], dtype=np.float)
+h = np.array([1, -1, 2], dtype=np.float)
+print(np.convolve(x, h).tolist())
+xs = np.array([1, 0, 2, 0, 3, 0, 4, 0, 5], dtype=np.float)[::2]
+print(close(np.convolve(x, h), np.convolve(xs, h)))
+print(close(np.convolve(x, h), np.convolve(np.array([1, 2, 3, 4, 5], dtype=np.int16), np.array([1, -1, 2], dtype=np.int16))))
+
+# second-order sections from rest, with an initial state, and on a strided input
+def sosfilt_ref(sos, x, zi):
+    y = list(x)
+    z = [list(s) for s in zi]
+    for i, (b0, b1, b2, a0, a1, a2) in enumerate(sos):
+        for k in range(len(y)):
+            v = y[k]
+            y[k] = b0 * v + z[i][0]
+            z[i][0] = b1 * v - a1 * y[k] + z[i][1]
+            z[i][1] = b2 * v - a2 * y[k]
+    return y, [value for s in z for value in s]
+
+sos = [[1, 2, 1, 1, -0.5, 0.25], [0.5, 0, -0.5, 1, 0.1, 0.2]]
+x = np.array([1, 0, 0, 0, 2, 0, 0, -1], dtype=np.float)
+y = spy.signal.sosfilt(sos, x)
+print(close(y, sosfilt_ref(sos, x, [[0, 0], [0, 0]])[0]))
+zi = np.array([[0.5, -0.25], [1, 2]], dtype=np.float)
+y, zf = spy.signal.sosfilt(sos, x, zi=zi)
+ref_y, ref_zf = sosfilt_ref(sos, x, [[0.5, -0.25], [1, 2]])
+print(close(y, ref_y), close(flat(zf), ref_zf))
+xs = np.array([1, 9, 0, 9, 0, 9, 0, 9, 2, 9, 0, 9, 0, 9, -1, 9], dtype=np.float)[::2]
+print(close(spy.signal.sosfilt(sos, xs), spy.signal.sosfilt(sos, x)))
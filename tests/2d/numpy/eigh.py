@@ -0,0 +1,35 @@
+import math
+
+try:
+    from ulab import numpy as np
+except ImportError:
+    import numpy as np
+
+a = np.array([[2, 1, 0, 0], [1, 2, 1, 0], [0, 1, 2, 1], [0, 0, 1, 2]])
+# the eigenvalues are 2 - 2cos(k pi / 5), k = 1, 2, 3, 4
+ref_result = [2 - 2 * math.cos(k * math.pi / 5) for k in range(1, 5)]
+
+w = np.linalg.eigvalsh(a)
+for i in range(4):
+    print(math.isclose(w[i], ref_result[i], rel_tol=1E-9, abs_tol=1E-9))
+
+w, v = np.linalg.eigh(a)
+for i in range(4):
+    print(math.isclose(w[i], ref_result[i], rel_tol=1E-9, abs_tol=1E-9))
+
+# the columns of v are the eigenvectors
+av = np.dot(a, v)
+for i in range(4):
+    for j in range(4):
+        print(math.isclose(av[i][j], w[j] * v[i][j], rel_tol=1E-9, abs_tol=1E-9))
+
+# the eigenvectors are orthonormal
+vv = np.dot(v.transpose(), v)
+for i in range(4):
+    for j in range(4):
+        print(math.isclose(vv[i][j], 1.0 if i == j else 0.0, rel_tol=1E-9, abs_tol=1E-9))
+
+try:
+    np.linalg.eigvalsh(np.array([[1, 2], [3, 4]]))
+except ValueError as e:
+    print(e)
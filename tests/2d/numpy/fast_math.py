@@ -0,0 +1,29 @@
+import math
+
+try:
+    from ulab import numpy as np
+    # the polynomial approximations of ULAB_VECTOR_FAST_MATH are available in single precision only
+    if np.array([1.0]).itemsize != 4:
+        raise ImportError
+except (ImportError, AttributeError):
+    print('SKIP')
+    raise SystemExit
+
+def check(f, ref, x):
+    return all([math.isclose(p, ref(q), rel_tol=1e-5, abs_tol=1e-6) for p, q in zip(f(x), x)])
+
+x = np.linspace(-10, 10, num=101)
+y = np.linspace(0.001, 1000, num=101)
+for f, ref in ((np.sin, math.sin), (np.cos, math.cos), (np.exp, math.exp)):
+    # dense arrays go through the flat loop, views through the generic iteration
+    print(check(f, ref, x), check(f, ref, x[::3]))
+print(check(np.log, math.log, y), check(np.log, math.log, y[::3]))
+
+# integer arguments, and large arguments, for which the reduction falls back to libm
+print(check(np.sin, math.sin, np.array(range(-20, 20), dtype=np.int16)))
+print(check(np.cos, math.cos, np.array([8191.5, 8192.0, 10000.0, -12345.0])))
+
+# the arguments outside of the range of the polynomials
+print(np.exp(np.array([-200.0, 100.0])).tolist())
+print(np.log(np.array([0.0, 1.0])).tolist())
+print(math.isnan(np.log(np.array([-1.0]))[0]))
@@ -0,0 +1,77 @@
+from ulab import numpy as np
+
+# the int32, uint32, and float16 dtypes are available only in builds with
+# ULAB_SUPPORTS_INT32, and ULAB_SUPPORTS_FLOAT16
+try:
+    np.int32, np.uint32, np.float16
+except AttributeError:
+    print('SKIP')
+    raise SystemExit
+
+a = np.array([1, -2, 3], dtype=np.int32)
+b = np.array([4, 5, 6], dtype=np.uint32)
+c = np.array([0.5, 1.5, -2.0], dtype=np.float16)
+u = np.array([1, 2, 3], dtype=np.uint8)
+
+print(a)
+print(b)
+print(c)
+
+# conversions
+print(np.array(a, dtype=np.float))
+print(np.array(np.array([1.25, -3.75], dtype=np.float16), dtype=np.int32))
+print(np.linspace(-2, 2, num=5, dtype=np.uint32))
+
+# upcasting, and the binary operators
+print(a + u)
+print(a - u)
+print(a * a)
+print(b + u)
+print(u - b)
+print(a // np.array([2, 2, 2], dtype=np.int32))
+print(b // u)
+print(a / u)
+print(a ** u)
+print(a & u)
+print(a | u)
+print(a ^ u)
+print((a < u).tolist())
+print((b > u).tolist())
+print((a == np.array([1, 2, 3], dtype=np.int32)).tolist())
+print(c + u)
+print(c * c)
+print(c + a)
+
+try:
+    a & c
+except TypeError as err:
+    print(err)
+
+# in-place operators
+x = np.array([1, 2, 3], dtype=np.int32)
+x += u
+print(x)
+x -= b
+print(x)
+
+y = np.array([0.5, 1.5, -2.0], dtype=np.float16)
+y += u
+print(y)
+y /= np.array([2, 2, 2], dtype=np.uint8)
+print(y)
+
+try:
+    x /= u
+except TypeError as err:
+    print(err)
+
+try:
+    x += c
+except TypeError as err:
+    print(err)
+
+# dot
+print(np.dot(c, c))
+print(np.dot(np.array([3000000000, 1], dtype=np.uint32), np.array([1, 2], dtype=np.uint8)))
+m = np.array([[1, 2], [3, 4]], dtype=np.int32)
+print(np.dot(m, m))
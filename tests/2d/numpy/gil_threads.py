@@ -0,0 +1,48 @@
+try:
+    import _thread
+    import time
+    from ulab import numpy as np
+except ImportError:
+    print('SKIP')
+    raise SystemExit
+
+# the large kernels release the GIL, while the other threads keep on running
+# in the interpreter, and in ulab; the results must not be affected by that
+
+n = 40
+m = np.eye(n) * n + np.ones((n, n))
+# 7919 is coprime to 5003, hence, a is a permutation of range(5003)
+a = np.array([(i * 7919) % 5003 for i in range(5003)])
+
+def check_inv():
+    inv = np.linalg.inv(m)
+    return np.max(abs(np.dot(inv, m) - np.eye(n))) < 1e-6
+
+def check_sort():
+    s = np.sort(a)
+    return (s[0] == 0) and (s[-1] == 5002) and np.all(np.diff(s) == 1)
+
+lock = _thread.allocate_lock()
+finished = 0
+results = []
+
+def worker(check):
+    global finished
+    ok = True
+    for _ in range(3):
+        ok = ok and check()
+    with lock:
+        results.append(ok)
+        finished += 1
+
+for check in (check_inv, check_sort, check_inv, check_sort):
+    _thread.start_new_thread(worker, (check,))
+
+# the main thread keeps on polling in the meantime
+while True:
+    with lock:
+        if finished == 4:
+            break
+    time.sleep_ms(1)
+
+print(results, check_inv(), check_sort())
@@ -0,0 +1,28 @@
+from ulab import numpy as np
+
+a = np.array(range(12), dtype=np.int16).reshape((3, 4))
+print(np.sum(a, axis=0).tolist())
+print(np.sum(a, axis=0, keepdims=True).tolist())
+print(np.sum(a, axis=1, keepdims=True).tolist())
+print(np.sum(a, keepdims=True).shape)
+print(np.mean(a, axis=0, keepdims=True).tolist())
+print(np.max(a, axis=0, keepdims=True).tolist())
+print(np.min(a, axis=0).tolist())
+print(np.argmin(a, axis=0, keepdims=True).tolist())
+print(np.argmax(a, axis=1, keepdims=True).tolist())
+
+b = np.array([[1.0, 2.0], [3.0, 6.0]])
+print(np.std(b, axis=0, keepdims=True).tolist())
+print(np.mean(b, axis=0).tolist())
+print(np.sum(b, axis=0).tolist())
+
+# the result broadcasts against the input
+print((b - np.mean(b, axis=0, keepdims=True)).tolist())
+print((b / np.sum(b, axis=0, keepdims=True)).tolist())
+
+# strided views are reduced lane by lane
+print(np.sum(a[:, ::2], axis=0, keepdims=True).tolist())
+print(np.argmax(a[::-1, :], axis=0).tolist())
+
+# the sum of all elements does not wrap around in the dtype of the input
+print(np.sum(np.full(1000, 100, dtype=np.int16), keepdims=True).tolist())
@@ -0,0 +1,38 @@
+from ulab import numpy as np
+
+a = np.array([1, 2, 3], dtype=np.uint8)
+b = np.array([[1.0], [2.0]])
+c = np.array([4, 5, 6], dtype=np.int16)
+
+print((np.lazy(a) * b + c - 0.5).evaluate())
+print((2 * np.lazy(a) - a).evaluate())
+print((-np.lazy(a) / 2).evaluate())
+print((np.lazy(a) ** 2).evaluate())
+print((a + np.lazy(c)).evaluate())
+print((np.lazy(2) * 3).evaluate())
+
+out = np.zeros(3)
+(np.lazy(a) + 1).evaluate(out=out)
+print(out)
+
+try:
+    (np.lazy(a) + np.array([1, 2])).evaluate()
+except ValueError as err:
+    print(err)
+
+try:
+    (np.lazy(a) + 1).evaluate(out=np.zeros(3, dtype=np.uint8))
+except ValueError as err:
+    print(err)
+
+# negations add instructions, but no operands
+x = np.lazy(a)
+for i in range(10):
+    x = -x
+print(x.evaluate())
+
+try:
+    for i in range(100):
+        x = -x
+except ValueError as err:
+    print(err)
@@ -0,0 +1,25 @@
+try:
+    from ulab import numpy as np
+except:
+    import numpy as np
+
+a = np.array(range(20), dtype=np.int16).reshape((5, 4))
+np.save('out.npy', a)
+for offset in (0, 2, 4, 5):
+    print(np.load('out.npy', offset=offset, count=2))
+print(np.load('out.npy', offset=3))
+
+np.save('out.npy', a[::2, ::-1])
+print(np.load('out.npy', count=1))
+
+# the first stride of this view is that of a dense array, but the data are still reversed
+np.save('out.npy', a[:, ::-1])
+print(np.load('out.npy', offset=3))
+
+np.save('out.npy', np.array(range(10), dtype=np.uint8))
+print(np.load('out.npy', offset=7, count=100))
+
+try:
+    np.load('out.npy', offset=11)
+except ValueError as e:
+    print('ValueError:', e)
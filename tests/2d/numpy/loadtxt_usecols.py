@@ -0,0 +1,37 @@
+try:
+    from ulab import numpy as np
+except:
+    import numpy as np
+
+with open('loadtxt.dat', 'w') as f:
+    f.write('# time, x, y, z\n')
+    f.write('0.5, -1.25e1, 3, 7\n')
+    f.write('1.5,2.5E-1, -3 ,8 # trailing comment\r\n')
+    f.write('\n')
+    f.write('2.5, 1e2, 0.125, 9')
+
+print(np.loadtxt('loadtxt.dat', delimiter=','))
+print(np.loadtxt('loadtxt.dat', delimiter=',', usecols=(3, 0)))
+print(np.loadtxt('loadtxt.dat', delimiter=',', usecols=1, dtype=np.int16))
+
+with open('loadtxt.dat', 'w') as f:
+    f.write('1 2 3\n4 5\n')
+
+try:
+    np.loadtxt('loadtxt.dat')
+except ValueError as e:
+    print('ValueError:', e)
+
+# fields that are not stored can be of any length, numbers must fit into the clipboard
+with open('loadtxt.dat', 'w') as f:
+    f.write('1, ' + 'x' * 256 + ', 2\n')
+
+print(np.loadtxt('loadtxt.dat', delimiter=',', usecols=(0, 2)))
+
+with open('loadtxt.dat', 'w') as f:
+    f.write('1, ' + '1' * 40 + ', 2\n')
+
+try:
+    np.loadtxt('loadtxt.dat', delimiter=',')
+except ValueError as e:
+    print('ValueError:', e)
@@ -0,0 +1,30 @@
+from ulab import numpy as np
+
+# only for firmware compiled with ULAB_SUPPORTS_INT8 = ULAB_SUPPORTS_INT16 = 0
+if hasattr(np, 'int8') or hasattr(np, 'int16'):
+    print('SKIP')
+    raise SystemExit
+
+# the excluded dtypes are not understood
+try:
+    np.array([1, 2], dtype=ord('h'))
+except TypeError:
+    print('TypeError')
+
+# negative scalars are promoted to float, the unsigned types are preserved
+a = np.array([1, 2, 3], dtype=np.uint8)
+print(a - 1)
+print(a + (-1))
+print(a * np.array([1, 256, 2], dtype=np.uint16))
+print(np.array([-1, 2, -3]) < a)
+
+# integer ranges fall back to float
+print(np.arange(5))
+print(np.arange(2, 8, 3))
+print(np.arange(3, dtype=np.uint8))
+
+# the indices along an axis are unsigned
+b = np.array([[3, 1, 2], [0, 5, 4]], dtype=np.uint8)
+print(np.argmax(b, axis=1))
+print(np.argmin(b, axis=0))
+print(np.argmax(b), np.argmin(b))
@@ -0,0 +1,35 @@
+from ulab import numpy as np
+
+# the flat loops can't be used for views, whose axes are not laid out in C order, even if the
+# first stride is that of a dense array
+a = np.array(range(20), dtype=np.int16).reshape((5, 4))
+b = a[:, ::-1]
+c = a[::2, ::2]
+
+print((b + a).tolist())
+print((b - a).tolist())
+print((b * b).tolist())
+print((c + c).tolist())
+print((b < a).tolist())
+print((b == a[:, ::-1]).tolist())
+print(np.maximum(b, a).tolist())
+
+# scalar operands, on either side, of dense, and strided operands
+d = a[1:3]
+f = np.array(range(8), dtype=np.float).reshape((2, 4))
+print((a + 1).tolist())
+print((1 + a).tolist())
+print((b + 1).tolist())
+print((1 + b).tolist())
+print((d - 1).tolist())
+print((1 - d).tolist())
+print((c * 2).tolist())
+print((f / 2.0).tolist())
+print((2.0 / f[:, 1:]).tolist())
+print((d & 1).tolist())
+print((b | 1).tolist())
+print((d > 5).tolist())
+print((1 < c).tolist())
+print((b >= 17).tolist())
+print((d == 6).tolist())
+print((f != 1).tolist())
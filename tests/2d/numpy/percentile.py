@@ -0,0 +1,23 @@
+from ulab import numpy as np
+
+a = np.array([[10, 7, 4], [3, 2, 1]])
+print(np.percentile(a, 50))
+print(np.percentile(a, 50, axis=0))
+print(np.percentile(a, 50, axis=1))
+print(np.percentile(a, [25, 75]))
+print(np.percentile(a, [0, 100], axis=1))
+print(np.quantile(a, 0.5))
+print(np.quantile(a, 0.25, axis=0))
+print(np.median(a), np.median(a, axis=1))
+
+b = np.array([5, 1, 4, 2, 3], dtype=np.int8)
+print(np.median(b), np.quantile(b, 0.1), np.percentile(b[::2], 50))
+
+try:
+    np.percentile(a, 101)
+except ValueError as err:
+    print(err)
+try:
+    np.quantile(a, -0.5)
+except ValueError as err:
+    print(err)
@@ -0,0 +1,22 @@
+from ulab import numpy as np
+
+x = np.array([0, 1, 2, 3], dtype=np.uint8)
+print(np.polyval([1, 1, 1, 0], x).tolist())
+print(np.polyval(np.array([1, 1, 1, 0], dtype=np.int8), 2))
+print(np.polyval([], 3))
+
+# non-contiguous input
+y = np.array([[0, 1, 2], [3, 4, 5]], dtype=np.int16)
+print(np.polyval([2, -1], y[:, ::2]).tolist())
+
+# longer than a block
+x = np.arange(40, dtype=np.int16)
+reference = [(v - 2) * v + 3 for v in range(40)]
+print(np.polyval([1, -2, 3], x).tolist() == reference)
+
+# each column is a polynomial
+p = np.array([[1, 0], [0, 1], [-1, 2]])
+print(np.polyval(p, 2).tolist())
+print(np.polyval(p, [0, 1, 2, 3]).tolist())
+print(np.polyval(p, y[:, ::2]).tolist())
+print(np.polyval(p[:, 1:], np.array([1, 2])).tolist())
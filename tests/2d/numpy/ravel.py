@@ -0,0 +1,56 @@
+try:
+    from ulab import numpy as np
+except:
+    import numpy as np
+
+a = np.array(range(12), dtype=np.uint8).reshape((3, 4))
+print(a.ravel().tolist())
+
+# views
+b = a.ravel()
+b[0] = 100
+print(a[0, 0])
+
+c = a[1:, :].ravel()
+c[0] = 200
+print(a[1, 0])
+
+d = a[:, ::2].ravel()
+print(d.tolist())
+d[1] = 50
+print(a[0, 2])
+
+# copies
+e = a[:, :2].ravel()
+print(e.tolist())
+e[1] = 0
+print(a[0, 1])
+
+print(a.T.ravel().tolist())
+print(a.ravel(order='F').tolist())
+
+x = np.array([1, 2, 3, 4, 5, 6], dtype=np.int16)[::2]
+r = x.ravel(order='F')
+r[0] = 9
+print(x)
+
+# reshape of strided arrays
+f = a[:, ::2].reshape((2, 3))
+f[0, 0] = 1
+print(a[0, 0])
+print(f)
+
+g = a[:, :2].reshape((2, 3))
+print(g)
+g[0, 0] = 77
+print(a[0, 0])
+
+h = a[:, ::2]
+h.shape = (6,)
+print(h)
+
+try:
+    k = a[:, :2]
+    k.shape = (6,)
+except ValueError:
+    print('ValueError')
@@ -0,0 +1,30 @@
+try:
+    from ulab import numpy as np
+except:
+    import numpy as np
+
+for dtype in (np.uint8, np.int8, np.uint16, np.int16):
+    a = np.array([0, 1, 3, 2, 2, 2, 100, -100, 127], dtype=dtype)
+    np.save_packed('out.bin', a)
+    print(np.load_packed('out.bin'))
+
+a = np.array(range(12), dtype=np.int16).reshape((3, 4))
+np.save_packed('out.bin', np.array(range(0, 12000, 1000), dtype=np.int16).reshape((3, 4)))
+np.save_packed('out.bin', -a[:2], append=True)
+np.save_packed('out.bin', np.zeros((1, 4), dtype=np.int16) + 7, append=True)
+print(np.load_packed('out.bin'))
+
+np.save_packed('out.bin', a[:, ::2], append=True)
+try:
+    np.load_packed('out.bin')
+except ValueError as e:
+    print('ValueError:', e)
+
+try:
+    np.save_packed('out.bin', np.array([1.0, 2.0]))
+except TypeError as e:
+    print('TypeError:', e)
+
+# a reversed view is packed in the order of its items
+np.save_packed('out.bin', a[:, ::-1])
+print(np.load_packed('out.bin'))
@@ -0,0 +1,23 @@
+try:
+    from ulab import numpy as np
+except:
+    import numpy as np
+
+a = np.array(range(12), dtype=np.int16).reshape((3, 4))
+rows = [a[i] for i in range(3)]
+print(rows[0], rows[2])
+print(a[1, 2])
+print(a[-1, ::2])
+print(a[1:, 1][1])
+b = a[:, 1:3]
+print(b[2])
+
+a[0] = 7
+print(a[0])
+a[1, 1:3] = np.array([-1, -2], dtype=np.int16)
+print(a[1])
+a[2, 0] = 100
+print(a[2, 0])
+print(rows[0])
+print(list(a[:, 0]))
+print([row.shape for row in a])
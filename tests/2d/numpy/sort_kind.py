@@ -0,0 +1,32 @@
+from ulab import numpy as np
+
+dtypes = (np.uint8, np.int8, np.uint16, np.int16, np.float)
+kinds = ('quicksort', 'heapsort', 'stable', 'mergesort')
+
+# long enough for the counting, radix, and introsort paths
+values = [(7 * i) % 23 for i in range(40)]
+for dtype in dtypes:
+    offset = 11 if dtype in (np.int8, np.int16) else 0
+    data = [v - offset for v in values]
+    a = np.array(data, dtype=dtype)
+    print([list(np.sort(a, kind=kind)) == sorted(data) for kind in kinds])
+    print([list(np.sort(a[::-3], kind=kind)) == sorted(data[::-3]) for kind in kinds])
+    print([[data[i] for i in np.argsort(a, axis=0, kind=kind)] == sorted(data) for kind in kinds])
+
+# the stable argsort keeps the order of equal values
+data = [3, 1, 2, 1, 3, 2, 1] * 4
+a = np.array(data, dtype=np.int16)
+print(list(np.argsort(a, axis=0, kind='stable')))
+a = np.array(data, dtype=np.float)
+print(list(np.argsort(a, axis=0, kind='mergesort')))
+
+b = np.array([[5, -1, 3], [2, 4, -6]], dtype=np.int8)
+print(np.sort(b, axis=0, kind='heapsort'))
+print(np.sort(b, axis=1))
+b.sort(kind='stable')
+print(b)
+
+try:
+    np.sort(b, kind='bubblesort')
+except ValueError as err:
+    print(err)
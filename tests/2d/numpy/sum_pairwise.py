@@ -0,0 +1,21 @@
+import math
+from ulab import numpy as np
+
+# the naive running sum would be off by about 2e-12 in relative terms
+a = np.full(100000, 0.1)
+print(math.isclose(np.sum(a), 10000.0, rel_tol=1e-14, abs_tol=0.0))
+print(math.isclose(np.mean(a), 0.1, rel_tol=1e-14, abs_tol=0.0))
+
+b = a.reshape((1000, 100))
+print(math.isclose(np.sum(np.sum(b, axis=0)), 10000.0, rel_tol=1e-14, abs_tol=0.0))
+print(math.isclose(np.mean(b, axis=0)[0], 0.1, rel_tol=1e-14, abs_tol=0.0))
+
+# a large offset must not spoil the standard deviation
+c = np.zeros(100000) + 1e8
+c[::2] = c[::2] + 1.0
+print(np.std(c))
+print(np.std(c.reshape((100, 1000)), axis=1)[:3])
+
+# integer sums with long axes
+d = np.ones(70000, dtype=np.uint8)
+print(np.sum(d))
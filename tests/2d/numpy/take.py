@@ -0,0 +1,64 @@
+try:
+    from ulab import numpy as np
+except:
+    import numpy as np
+
+a = np.array(range(12), dtype=np.int16).reshape((3, 4))
+
+# fancy indexing along the first axis
+print(a[[2, 0]].tolist())
+print(a[np.array([1, -1, 1], dtype=np.int8)].tolist())
+print(a[:, ::-1][[0, 2]].tolist())
+b = np.array(range(8), dtype=np.uint16)
+print(b[[7, 0, 3]].tolist())
+print(b[np.array([[0, 1], [6, 7]], dtype=np.uint8)].tolist())
+try:
+    b[[8]]
+except IndexError:
+    print('IndexError')
+
+# take along an axis, and from the flattened array
+print(np.take(a, [3, 0], axis=1).tolist())
+print(np.take(a, np.array([11, 0, 5], dtype=np.uint8)).tolist())
+print(np.take(a, 1, axis=0).tolist())
+print(np.take(a, 2, axis=1).tolist())
+print(np.take(a, [5, -1], mode='clip', axis=1).tolist())
+print(np.take(a, [5, -1], mode='wrap', axis=1).tolist())
+print(np.take(a[::2, ::-1], [0, 3, 4]).tolist())
+print(np.take(b, 5))
+c = np.array([30, 10, 20], dtype=np.uint8)
+print(np.take(c, np.argsort(c)).tolist())
+print(np.take(np.array([1.5, 2.5]), [1, 1, 0]).tolist())
+
+# assignment
+b[[0, 2, 2]] = np.array([100, 200, 300], dtype=np.uint16)
+print(b.tolist())
+b[np.array([1, 3], dtype=np.uint8)] = 9
+print(b.tolist())
+a[[0, 2]] = np.array([[-1, -2, -3, -4], [-5, -6, -7, -8]], dtype=np.int16)
+print(a.tolist())
+a[[1]] = 0
+print(a.tolist())
+
+# put
+d = np.zeros(6, dtype=np.uint8)
+np.put(d, [0, 2, -1], [10, 20, 30])
+print(d.tolist())
+np.put(d, [7, 8, 9], 5, mode='wrap')
+print(d.tolist())
+np.put(d, [100], 1, mode='clip')
+print(d.tolist())
+e = np.zeros((2, 3), dtype=np.float)
+np.put(e[:, ::-1], [0, 4], [1, 2])
+print(e.tolist())
+try:
+    np.put(d, [6], 1)
+except IndexError:
+    print('IndexError')
+
+# a Boolean mask is not taken for integer indices
+f = np.array([1, 2, 3, 4, 5], dtype=np.uint8)
+f[f > 2] = 0
+print(f.tolist())
+f[f == 0] = np.array([7, 8, 9], dtype=np.uint8)
+print(f.tolist())
@@ -0,0 +1,22 @@
+try:
+    from ulab import numpy as np
+except:
+    import numpy as np
+import io
+
+a = np.array(range(12), dtype=np.uint8).reshape((3, 4))
+
+print(a.tobytes(copy=True))
+print(a[:, ::-1].tobytes(copy=True))
+print(a[::2, 1:3].tobytes(copy=True))
+print(a.transpose().tobytes(copy=True))
+
+for b in (a, a[1:], a[:, ::2], a[::-1, ::-1]):
+    stream = io.BytesIO()
+    b.tofile(stream)
+    print(stream.getvalue())
+
+a = np.array([1, -2, 3], dtype=np.int16)
+a.tofile('out.bin')
+with open('out.bin', 'rb') as f:
+    print(np.frombuffer(f.read(), dtype=np.int16))
@@ -0,0 +1,32 @@
+try:
+    from ulab import numpy as np
+except:
+    import numpy as np
+
+
+def double(x):
+    for i in range(len(x)):
+        x[i] = x[i] * 2
+    return None
+
+a = np.array(range(6), dtype=np.int16).reshape((2, 3))
+
+vf = np.vectorize(double, otypes=np.int16, signature='(n)->(n)')
+print(vf(a))
+print(a)
+print(vf(a[:, 1:]))
+
+reverse = np.vectorize(lambda x: x[::-1], signature='( n ) -> ( n )')
+print(reverse(a))
+
+increment = np.vectorize(lambda x: [v + 1 for v in x], otypes=np.uint8, signature='(n)->(n)')
+print(increment(a))
+
+total = np.vectorize(lambda x: np.sum(x), signature='(n)->()')
+print(total(a))
+print(total([1, 2, 3]))
+
+try:
+    np.vectorize(double, signature='(n)->(m)')
+except ValueError:
+    print('ValueError')
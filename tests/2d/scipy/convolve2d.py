@@ -0,0 +1,31 @@
+from ulab import numpy as np
+from ulab import scipy as spy
+
+image = np.array([[0, 10, 20, 30], [40, 50, 60, 70], [80, 90, 100, 110], [120, 130, 140, 150]], dtype=np.uint8)
+
+# a separable integer kernel: the horizontal Sobel operator
+sobel = np.array([[1, 0, -1], [2, 0, -2], [1, 0, -1]], dtype=np.int8)
+print(spy.signal.convolve2d(image, sobel, mode='same', dtype=np.int16).tolist())
+print(spy.signal.correlate2d(image, sobel, mode='valid').tolist())
+
+# a non-separable kernel
+laplace = np.array([[0, 1, 0], [1, -4, 1], [0, 1, 0]], dtype=np.int16)
+print(spy.signal.convolve2d(image, laplace, mode='valid').tolist())
+
+# float kernels, and the full output
+blur = np.array([[0.25, 0.25], [0.25, 0.25]])
+print(spy.signal.convolve2d(np.array([[4, 8], [12, 16]], dtype=np.uint16), blur).tolist())
+print(spy.signal.convolve2d(np.array([[1.0, 2.0, 3.0]]), np.array([[1.0], [2.0]])).tolist())
+print(spy.signal.correlate2d(np.array([[1, 2], [3, 4]], dtype=np.int16), np.array([[1, 2], [3, 5]], dtype=np.int16)).tolist())
+
+# saturation of the int16 output
+print(spy.signal.convolve2d(np.full((2, 2), 200, dtype=np.uint8), np.full((2, 2), 100, dtype=np.int16), mode='valid', dtype=np.int16).tolist())
+
+try:
+    spy.signal.convolve2d(sobel, image, mode='valid')
+except ValueError:
+    print('ValueError')
+try:
+    spy.signal.convolve2d(image, sobel, mode='wrong')
+except ValueError:
+    print('ValueError')
@@ -0,0 +1,20 @@
+import math
+from ulab import numpy as np
+from ulab import scipy as spy
+
+acc = np.array([0, 2, 4, 6, 8], dtype=np.int16)
+print(spy.integrate.cumulative_trapezoid(acc).tolist())
+print(spy.integrate.cumulative_trapezoid(acc, dx=0.5, initial=0).tolist())
+
+y = np.array([[1, 2, 3], [4, 5, 6]])
+print(spy.integrate.cumulative_trapezoid(y, x=[0, 1, 3]).tolist())
+print(spy.integrate.cumulative_trapezoid(y, axis=0).tolist())
+print(spy.integrate.cumulative_trapezoid(y[:, ::2], initial=1.0).tolist())
+
+out = np.zeros((2, 2))
+spy.integrate.cumulative_trapezoid(y, out=out)
+print(out.tolist())
+
+# the total is that of trapz
+z = np.array([1, 4, 9, 16, 25])
+print(math.isclose(spy.integrate.cumulative_trapezoid(z)[-1], np.trapz(z), rel_tol=1e-9))
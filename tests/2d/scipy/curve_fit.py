@@ -0,0 +1,37 @@
+from ulab import numpy as np
+from ulab import scipy as spy
+
+def model(x, a, b, c):
+    return a * np.exp(x * (-b)) + c
+
+def jacobian(x, a, b, c):
+    e = np.exp(x * (-b))
+    return np.array([[v, -a * u * v, 1.0] for u, v in zip(x, e)])
+
+x = np.linspace(0, 4.75, 20)
+y = model(x, 2.5, 1.3, 0.5)
+
+popt, pcov = spy.optimize.curve_fit(model, x, y, [1.0, 1.0, 0.0])
+print([round(p, 6) for p in popt], pcov.shape)
+
+popt, pcov = spy.optimize.curve_fit(model, x, y, [1.0, 1.0, 0.0], jac=jacobian)
+print([round(p, 6) for p in popt])
+
+# the Jacobian can also be returned as a list of rows
+popt, pcov = spy.optimize.curve_fit(model, x, y, [1.0, 1.0, 0.0], jac=lambda x, a, b, c: jacobian(x, a, b, c).tolist())
+print([round(p, 6) for p in popt])
+
+# a linear model with residuals, and a standard iterable as the independent variable
+popt, pcov = spy.optimize.curve_fit(lambda x, a, b: x * a + b, [0, 1, 2, 3], [1, 3, 5, 7.5], [0, 0])
+print([round(p, 6) for p in popt])
+print([[round(c, 6) for c in row] for row in pcov.tolist()])
+
+try:
+    spy.optimize.curve_fit(lambda x, a: x[:2] * a, x, y, [1.0])
+except ValueError:
+    print('ValueError')
+
+try:
+    spy.optimize.curve_fit(model, x, y[:5], [1.0, 1.0, 0.0])
+except ValueError:
+    print('ValueError')
@@ -0,0 +1,34 @@
+try:
+    from ulab import numpy as np
+    from ulab import scipy as spy
+except:
+    import numpy as np
+    import scipy as spy
+
+# FIR filter, the delay line is kept between the blocks
+fir = spy.signal.lfilter_stream([1, 2, 3])
+print(fir)
+print(fir.filter([0, 1, 2, 3]))
+print(fir.filter(np.array([4, 5, 6, 7, 8, 9], dtype=np.uint8)))
+
+# IIR filter, float arrays are filtered in place
+iir = spy.signal.lfilter_stream([1, 2, 3], [1, 0.5, -0.25])
+print(iir)
+x = np.array(range(10), dtype=np.float)
+block = x[:4]
+print(iir.filter(block) is block)
+iir.filter(x[4:])
+print(x)
+
+# the same filter in a single call, and after a reset
+iir.reset()
+print(iir.filter(np.array(range(10), dtype=np.float)))
+
+# the coefficients are normalised by a[0]
+iir = spy.signal.lfilter_stream([2, 4, 6], [2, 1, -0.5])
+print(iir.filter(range(10)))
+
+try:
+    spy.signal.lfilter_stream([1, 2, 3], [0, 1])
+except ValueError as err:
+    print(err)
@@ -0,0 +1,39 @@
+import math
+
+try:
+    from ulab import scipy, numpy as np
+except ImportError:
+    import scipy
+    import numpy as np
+
+## test the factorisation itself
+A = np.array([[0, 2], [4, 2]])
+lu, piv = scipy.linalg.lu_factor(A)
+print(lu)
+print(piv)
+
+## test lu_factor and lu_solve together, the factors are re-used
+A = np.array([[2, 1, 1], [4, 3, 3], [8, 7, 9]])
+factors = scipy.linalg.lu_factor(A)
+
+b = np.array([4, 10, 24])
+result = scipy.linalg.lu_solve(factors, b)
+for i in range(3):
+        print(math.isclose(result[i], 1.0, rel_tol=1E-6, abs_tol=1E-6))
+
+# right hand side with multiple columns returns the inverse
+result = scipy.linalg.lu_solve(factors, np.eye(3))
+ref_result = np.linalg.inv(A)
+for i in range(3):
+    for j in range(3):
+        print(math.isclose(result[i][j], ref_result[i][j], rel_tol=1E-6, abs_tol=1E-6))
+
+## numpy.linalg.solve goes through the same factorisation
+result = np.linalg.solve(A, b)
+for i in range(3):
+        print(math.isclose(result[i], 1.0, rel_tol=1E-6, abs_tol=1E-6))
+
+try:
+    scipy.linalg.lu_factor(np.array([[1, 2], [2, 4]]))
+except ValueError as e:
+    print(e)
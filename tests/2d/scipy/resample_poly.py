@@ -0,0 +1,36 @@
+import math
+from ulab import numpy as np
+from ulab import scipy as spy
+
+x = np.sin(2 * math.pi * np.arange(48) / 24)
+
+# the outputs are aligned with the input, and only the edges feel the zero padding
+y = spy.signal.resample_poly(x, 1, 3)
+print(len(y), np.max(abs(y[4:12] - np.sin(2 * math.pi * 3 * np.arange(4, 12) / 24))) < 0.01)
+y = spy.signal.resample_poly(x, 4, 6)
+print(len(y), np.max(abs(y[8:24] - np.sin(2 * math.pi * 1.5 * np.arange(8, 24) / 24))) < 0.01)
+y = spy.signal.resample_poly(np.ones(60, dtype=np.uint8), 1, 3, window='hamming')
+print(np.max(abs(y[5:15] - 1.0)) < 0.02)
+print(spy.signal.resample_poly([1, 2, 3], 2, 2).tolist())
+
+# explicit filter coefficients are scaled by up
+print(spy.signal.resample_poly(np.arange(6), 1, 2, window=[1, 1, 1]).tolist())
+
+y = spy.signal.decimate(x, 3)
+print(len(y), np.max(abs(y[4:12] - np.sin(2 * math.pi * 3 * np.arange(4, 12) / 24))) < 0.01)
+print(len(spy.signal.decimate(x, 4, zero_phase=False)))
+
+# the stream carries the history between blocks, and returns the outputs of upfirdn
+h = [1, 2, 3, 4, 5]
+s = spy.signal.resample_poly_stream(1, 3, window=h)
+print(s)
+z = np.arange(24)
+blocks = [s.filter(z[:7]), s.filter(z[7:12]), s.filter(z[12:])]
+print([len(b) for b in blocks])
+print(np.concatenate(blocks).tolist())
+print(np.convolve(z, np.array(h))[::3][:8].tolist())
+
+s = spy.signal.resample_poly_stream(2, 1, window=[1, 1, 1])
+print(s.filter([1]).tolist(), s.filter([2, 3]).tolist())
+s.reset()
+print(s.filter([1, 2, 3]).tolist())
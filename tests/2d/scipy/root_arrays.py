@@ -0,0 +1,32 @@
+from ulab import numpy as np
+from ulab import scipy as spy
+
+c = np.array([2.0, 3.0, 5.0])
+
+# the problems are solved in lockstep, with one call per iteration
+calls = [0]
+def f(x):
+    calls[0] += 1
+    return x * x - c
+
+roots = spy.optimize.bisect(f, np.zeros(3), 3)
+print([round(r, 5) for r in roots.tolist()], calls[0] < 30)
+print([round(r, 5) for r in spy.optimize.bisect(f, [0, 1, 2], 3.0).tolist()])
+print([round(r, 5) for r in spy.optimize.bisect(f, np.array([0, 1, 2]), np.array([2, 2, 3])).tolist()])
+
+# problems with a root at either end of the interval are returned as they are
+g = lambda x: x * x - 4
+print([round(r, 5) for r in spy.optimize.bisect(g, [2, 0, 0], [3, 3, 2]).tolist()])
+
+roots = spy.optimize.newton(lambda x: x * x * x - c, np.array([1, 2, 3]))
+print([round(r, 5) for r in roots.tolist()])
+
+try:
+    spy.optimize.bisect(f, [0, 0, 0], [1, 3, 3])
+except ValueError:
+    print('ValueError')
+
+try:
+    spy.optimize.bisect(f, [0, 0], [3, 3, 3])
+except ValueError:
+    print('ValueError')
@@ -0,0 +1,24 @@
+try:
+    from ulab import numpy as np
+    from ulab import scipy as spy
+except:
+    import numpy as np
+    import scipy as spy
+
+sos = [[1, 2, 3, 1, 5, 6], [1, 2, 3, 1, 5, 6]]
+x = np.array([list(range(10)), list(range(9, -1, -1))])
+
+# each row is filtered independently
+print(spy.signal.sosfilt(sos, x))
+print(spy.signal.sosfilt(sos, x[1]))
+print(spy.signal.sosfilt(sos, x.transpose(), axis=0))
+
+# results can be written into an existing array
+y = np.zeros((2, 10))
+print(spy.signal.sosfilt(sos, x, out=y) is y)
+print(y)
+
+# or filtered in place
+x = np.array(range(10), dtype=np.float)
+print(spy.signal.sosfilt(sos, x, out=x) is x)
+print(x)
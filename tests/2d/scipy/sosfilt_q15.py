@@ -0,0 +1,22 @@
+from ulab import numpy as np
+from ulab import scipy as spy
+
+x = np.array([1000, -2000, 3, 0], dtype=np.int16)
+
+# a pure gain of 0.5
+sos = [[0.5, 0, 0, 1, 0, 0]]
+print(spy.signal.sosfilt(sos, x, dtype=np.int16))
+
+# y[n] = x[n] + 0.5 * y[n-1]; the coefficients are stored in Q14
+sos = [[1, 0, 0, 1, -0.5, 0]]
+x = np.array([1000, 0, 0, 0], dtype=np.int16)
+print(spy.signal.sosfilt(sos, x, dtype=np.int16))
+
+# the channels of a two-dimensional input are filtered separately
+x = np.array([[1000, 0, 0, 0], [2000, 0, 0, 0]], dtype=np.int16)
+print(spy.signal.sosfilt(sos, x, dtype=np.int16))
+
+# the output saturates, instead of wrapping around
+sos = [[1, 0, 0, 1, -1, 0]]
+x = np.array([20000, 20000, 0], dtype=np.int16)
+print(spy.signal.sosfilt(sos, x, dtype=np.int16))
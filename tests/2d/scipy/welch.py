@@ -0,0 +1,51 @@
+import math
+from ulab import numpy as np
+from ulab import scipy as spy
+
+# an explicit window is loaded, even if it is the first one of its length, and
+# a different array of the same length replaces it
+f, p = spy.signal.welch(np.ones(64), window=np.ones(16), detrend=False)
+print(len(f), p[0])
+f, p = spy.signal.welch(np.ones(64), window=np.array([1, 0] * 8), detrend=False)
+print(p[0])
+
+fs = 1000.0
+x = 2.0 * np.sin(2 * math.pi * 125 * np.arange(256) / fs)
+
+f, p = spy.signal.welch(x, fs=fs, nperseg=64)
+print(len(f), f[1], f[np.argmax(p)])
+# the integral of the density is the mean power of the signal
+print(math.isclose(np.sum(p) * f[1], 2.0, rel_tol=1e-9))
+
+f, p = spy.signal.welch(x, fs=fs, nperseg=64, scaling='spectrum')
+print(math.isclose(np.max(p), 2.0, rel_tol=1e-9))
+
+# the window, and the plan are re-used, if only the signal changes
+f, q = spy.signal.welch(x, fs=fs, nperseg=64, scaling='spectrum')
+print(np.max(abs(p - q)))
+
+# the mean is removed from the segments
+f, p = spy.signal.welch(np.ones(128), nperseg=32)
+print(np.max(p))
+f, p = spy.signal.welch(np.ones(128), nperseg=32, detrend=False, window='boxcar', scaling='spectrum')
+print(p[0], np.max(p[1:]) < 1e-20)
+
+# an explicit window
+f, p = spy.signal.welch(np.ones(128, dtype=np.int16), window=np.ones(32), detrend=False, scaling='spectrum')
+print(len(f), p[0])
+
+f, t, z = spy.signal.stft(x, fs=fs, nperseg=64)
+print(z.shape, t[:3].tolist())
+print([round(v, 6) for v in abs(z[8]).tolist()])
+
+f, t, z = spy.signal.stft(range(10), nperseg=8, noverlap=4)
+print(t.tolist())
+print([round(v, 6) for v in abs(z[:, 0]).tolist()])
+
+f, t, z = spy.signal.stft(range(10), nperseg=8, noverlap=6, boundary=None, padded=False)
+print(t.tolist())
+
+try:
+    spy.signal.welch(x, nperseg=48)
+except ValueError as e:
+    print('ValueError')
@@ -0,0 +1,37 @@
+from ulab import numpy as np
+from ulab import utils
+
+keys = ('min', 'max', 'argmin', 'argmax', 'sum', 'mean', 'var')
+
+a = np.array([4, 2, 4, 4, 5, 5, 7, 9], dtype=np.uint8)
+d = utils.describe(a)
+for key in keys:
+    print(key, d[key])
+
+a = np.array([1.0, 3.0, 5.0, 7.0])
+d = utils.describe(a, ddof=1)
+for key in keys:
+    print(key, d[key])
+
+b = np.array([[1, 8, 3], [4, 2, 6]], dtype=np.int16)
+d = utils.describe(b)
+for key in keys:
+    print(key, d[key])
+
+d = utils.describe(b, axis=0)
+for key in keys:
+    print(key, d[key])
+
+d = utils.describe(b, axis=1)
+for key in keys:
+    print(key, d[key])
+
+# the sum is accumulated directly, and not recovered from the mean
+d = utils.describe(np.array([0.1, 0.2, 0.3, 0.4, 0.7]))
+print('sum', d['sum'])
+
+# the variance is undefined without more samples than degrees of freedom
+d = utils.describe(np.array([3.0]), ddof=1)
+print('var', d['var'])
+d = utils.describe(b, axis=0, ddof=2)
+print('var', d['var'])
@@ -0,0 +1,26 @@
+from ulab import numpy as np
+from ulab import utils
+
+# two capture buffers, and their persistent views, as in double-buffered DMA
+buffers = (bytearray(8), bytearray(8))
+views = (np.frombuffer(buffers[0], dtype=np.int16), np.frombuffer(buffers[1], dtype=np.int16))
+out = np.zeros(4)
+
+for i in range(4):
+    buffer = buffers[i % 2]
+    for j in range(8):
+        buffer[j] = (i + j) % 3
+    print(views[i % 2])
+    utils.from_int16_buffer(buffer, out=out)
+    print(out)
+
+# offset skips the leading bytes, also when the result is unaligned
+a = bytearray([0xff, 1, 0, 2, 0, 0, 3])
+print(utils.from_uint16_buffer(a, offset=1))
+print(utils.from_uint16_buffer(a, offset=1, byteswap=True))
+print(utils.from_int32_buffer(a, offset=3, byteswap=True, out=out))
+
+try:
+    utils.from_int16_buffer(a, out=[1, 2, 3])
+except TypeError as e:
+    print('TypeError:', e)
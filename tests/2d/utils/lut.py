@@ -0,0 +1,34 @@
+from ulab import numpy as np
+from ulab import utils
+
+table = np.array(range(255, -1, -1), dtype=np.uint8)
+frame = np.array([[0, 10, 20, 30], [250, 255, 128, 1]], dtype=np.uint8)
+print(utils.lut(table, frame).tolist())
+
+# in place
+utils.lut(table, frame, out=frame)
+print(frame.tolist())
+
+# strided input, and a table of a wider dtype
+square = np.array([i * i for i in range(256)], dtype=np.uint16)
+print(utils.lut(square, frame[:, ::2]).tolist())
+
+# a short table clips
+short = np.array([-1, -2, -3], dtype=np.int16)
+print(utils.lut(short, np.array([0, 1, 2, 3, 60000], dtype=np.uint16)).tolist())
+print(utils.lut(np.array([0.5, 1.5]), np.array([1, 0, 9], dtype=np.uint8)).tolist())
+
+# strided output
+out = np.zeros((2, 8), dtype=np.uint8)
+utils.lut(table, np.array([[1, 2, 3, 4], [5, 6, 7, 8]], dtype=np.uint8), out=out[:, 1::2])
+print(out.tolist())
+
+for args in ((table, np.array([1.0, 2.0])), (np.zeros(0, dtype=np.uint8), frame)):
+    try:
+        utils.lut(*args)
+    except (TypeError, ValueError):
+        print('error')
+try:
+    utils.lut(table, frame, out=np.zeros((2, 4), dtype=np.uint16))
+except TypeError:
+    print('TypeError')
@@ -0,0 +1,29 @@
+try:
+    import ulab
+    from ulab import numpy as np
+    ulab.stats
+except (ImportError, AttributeError):
+    print('SKIP')
+    raise SystemExit
+
+ulab.stats_reset()
+print(ulab.stats())
+
+a = np.array(range(10))
+np.sort(a)
+np.sort(a)
+# the calls that raise an exception are counted, too
+try:
+    np.sort([1, 2])
+except TypeError:
+    pass
+np.linalg.inv(np.eye(2))
+
+s = ulab.stats()
+print(sorted(s.keys()))
+print(s['numpy.sort'][0], s['numpy.array'][0], s['linalg.inv'][0])
+# a sorted copy is allocated in each successful call
+print(s['numpy.sort'][1] > 0, s['numpy.sort'][2] >= 0)
+
+ulab.stats_reset()
+print(ulab.stats())
@@ -0,0 +1,37 @@
+from ulab import numpy as np
+from ulab import utils
+
+r = utils.ring(4, dtype=np.int16)
+print(r, len(r), r.views())
+r.push(1)
+r.push([2, 3])
+print(r, r.unroll())
+# wraps around, and overwrites the oldest samples
+r.push(np.array([4, 5, 6], dtype=np.uint8))
+print(r)
+print(r.views())
+print(r.unroll())
+# only the most recent samples of a long block survive
+r.push(np.array(range(10, 16)))
+print(r.unroll())
+
+# a ring of vectors
+r = utils.ring((3, 2), dtype=np.uint8)
+r.push([1, 2])
+r.push(np.array([[3, 4], [5, 6]]))
+r.push([7, 8])
+print(len(r), r.unroll().tolist())
+print([v.tolist() for v in r.views()])
+a = np.array([[9, 99, 10], [11, 111, 12]], dtype=np.uint8)
+r.push(a[:, ::2])
+print(r.unroll().tolist())
+
+try:
+    r.push([1, 2, 3])
+except ValueError:
+    print('ValueError')
+
+try:
+    utils.ring(8, dtype=3)
+except TypeError:
+    print('TypeError')
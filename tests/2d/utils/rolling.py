@@ -0,0 +1,33 @@
+from ulab import numpy as np
+from ulab import utils
+
+a = np.array([1, 5, 2, 8, 3, 9, 4, 7])
+print(utils.rolling(a, 3, 'sum'))
+print(utils.rolling(a, 4))
+print(utils.rolling(a, 3, 'min'))
+print(utils.rolling(a, 3, 'max'))
+
+a = np.array([1, 5, 2, 8, 3, 9, 4, 7], dtype=np.uint8)
+print(utils.rolling(a, 3, 'max'))
+a = np.array([1, 5, 2, 8, 3, 9, 4, 7], dtype=np.int16)
+print(utils.rolling(a, 4, 'min'))
+
+a = np.array([1, 3, 5, 3, 1, 1])
+print(utils.rolling(a, 2, 'std'))
+a = np.array([0, 2, 4, 6, 8, 10])
+print(utils.rolling(a, 3, 'std', ddof=1))
+
+b = np.array([[1, 2, 3, 4], [4, 3, 2, 1], [0, 2, 0, 2]])
+print(utils.rolling(b, 2))
+print(utils.rolling(b, 2, 'max', axis=0))
+print(utils.rolling(b, 4, 'sum'))
+
+try:
+    utils.rolling(a, 7)
+except ValueError:
+    print('ValueError')
+
+try:
+    utils.rolling(a, 2, 'median')
+except ValueError:
+    print('ValueError')
@@ -0,0 +1,35 @@
+from ulab import numpy as np
+from ulab import utils
+
+# scalar samples, every element of a block is a sample
+rs = utils.RunningStats()
+print(rs.count, rs.mean)
+rs.update(np.array([1, 2, 3, 4], dtype=np.uint8))
+rs.update([5, 6, 7, 8])
+print(rs)
+print(rs.count, rs.mean, rs.var, rs.min, rs.max)
+
+# per-element statistics of a stream of vectors
+rs = utils.RunningStats(3)
+rs.update(np.array([[1, 2, 3], [3, 4, 5]], dtype=np.int16))
+rs.update(np.array([5, 6, 7], dtype=np.int8))
+rs.update(np.array([7.0, 8.0, 9.0]))
+print(rs.count)
+print(rs.mean)
+print(rs.var)
+print(rs.min)
+print(rs.max)
+
+# a strided block
+rs = utils.RunningStats((2,))
+a = np.array([[0, 1, 2, 3], [4, 5, 6, 7]], dtype=np.uint16)
+rs.update(a[:, ::2])
+print(rs.mean, rs.var)
+
+rs.reset()
+print(rs.count, rs.min)
+
+try:
+    rs.update(np.array([1, 2, 3]))
+except ValueError:
+    print('ValueError')
@@ -0,0 +1,23 @@
+from ulab import numpy as np
+
+try:
+    from ulab import user
+    user.array_info
+except (ImportError, AttributeError):
+    print('SKIP')
+    raise SystemExit
+
+# the C interface of ulab_api.h, as seen from the user module
+a = np.array(range(12), dtype=np.int16).reshape((3, 4))
+print(user.array_info(a))
+print(user.array_info(a[::2, :]))
+print(user.array_info(a[:, ::-1]))
+
+print(user.new_array((2, 3), ord('B')))
+
+# unknown typecodes, and the dtypes excluded from the firmware are rejected
+for code in 'xi':
+    try:
+        user.new_array((2,), ord(code))
+    except TypeError:
+        print('TypeError')
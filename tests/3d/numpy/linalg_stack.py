@@ -0,0 +1,32 @@
+from ulab import numpy as np
+
+a = np.array([[[2, 0], [0, 4]], [[1, 1], [0, 1]], [[0, 1], [1, 0]]])
+print(np.linalg.det(a))
+b = np.linalg.inv(a)
+print(b.shape)
+for i in range(3):
+    print(b[i])
+
+c = np.array([[[4, 0], [0, 9]], [[4, 2], [2, 2]]])
+L = np.linalg.cholesky(c)
+for i in range(2):
+    print(L[i])
+
+# a stack times a matrix, or a vector
+d = np.dot(a, np.array([[1, 2], [3, 4]]))
+print(d.shape)
+print(d[1])
+print(np.dot(a, np.array([1, 2])))
+for i in range(3):
+    print(np.dot(a[i], b[i]))
+
+# numpy.dot does not multiply two stacks pairwise
+try:
+    np.dot(a, b)
+except NotImplementedError:
+    print('NotImplementedError')
+
+try:
+    np.linalg.inv(np.array([[[1, 1], [1, 1]]]))
+except ValueError:
+    print('ValueError')
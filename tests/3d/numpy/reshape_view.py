@@ -0,0 +1,15 @@
+try:
+    from ulab import numpy as np
+except:
+    import numpy as np
+
+a = np.array(range(16), dtype=np.uint8).reshape((4, 4))
+b = a[::2, :].reshape((2, 2, 2))
+b[1, 0, 0] = 100
+print(a[2, 0])
+print(b.shape)
+print(b[1].tolist())
+
+c = np.array(range(24), dtype=np.uint8).reshape((2, 3, 4))
+print(c.transpose().shape)
+print(c.transpose().ravel().tolist())